@@ -0,0 +1,114 @@
+from __future__ import absolute_import, division, print_function
+
+from .common import Benchmark
+
+import timeit
+
+import numpy as np
+
+# transform lengths: a power of two, a smooth composite and a prime, so
+# the pure radix, mixed-radix and Bluestein code paths are all tracked
+SIZES_1D = [4096, 4860, 4099]
+SIZES_2D = [(256, 256), (270, 270), (251, 251)]
+
+
+def _complex_flops(shape):
+    # the usual 5 N log2(N) estimate per transformed axis
+    flops = 0.
+    n = 1
+    for dim in shape:
+        n *= dim
+    for dim in shape:
+        flops += 5. * n * np.log2(dim)
+    return flops
+
+
+def _gflops_per_sec(func, flops):
+    # one warm-up call, then as many timed calls as fit a modest budget
+    func()
+    number = 1
+    while True:
+        elapsed = timeit.timeit(func, number=number)
+        if elapsed > 0.2:
+            break
+        number *= 4
+    return flops * number / elapsed / 1e9
+
+
+class FFT1D(Benchmark):
+    params = [SIZES_1D, ['complex64', 'complex128'], [1, 64]]
+    param_names = ['size', 'dtype', 'batch']
+
+    def setup(self, size, dtype, batch):
+        self.x = (np.random.random((batch, size)) +
+                  1j*np.random.random((batch, size))).astype(dtype)
+        # warm the plan cache so steady-state performance is measured
+        np.fft.fft(self.x)
+
+    def time_fft(self, size, dtype, batch):
+        np.fft.fft(self.x)
+
+    def time_ifft(self, size, dtype, batch):
+        np.fft.ifft(self.x)
+
+    def track_fft_gflops(self, size, dtype, batch):
+        flops = batch * _complex_flops((size,))
+        return _gflops_per_sec(lambda: np.fft.fft(self.x), flops)
+
+    track_fft_gflops.unit = "GFLOP/s"
+
+
+class RFFT1D(Benchmark):
+    params = [SIZES_1D, ['float32', 'float64'], [1, 64]]
+    param_names = ['size', 'dtype', 'batch']
+
+    def setup(self, size, dtype, batch):
+        self.x = np.random.random((batch, size)).astype(dtype)
+        self.spec = np.fft.rfft(self.x)
+
+    def time_rfft(self, size, dtype, batch):
+        np.fft.rfft(self.x)
+
+    def time_irfft(self, size, dtype, batch):
+        np.fft.irfft(self.spec, size)
+
+    def track_rfft_gflops(self, size, dtype, batch):
+        # a real transform does roughly half the work of a complex one
+        flops = 0.5 * batch * _complex_flops((size,))
+        return _gflops_per_sec(lambda: np.fft.rfft(self.x), flops)
+
+    track_rfft_gflops.unit = "GFLOP/s"
+
+
+class FFT2D(Benchmark):
+    params = [SIZES_2D, ['complex64', 'complex128']]
+    param_names = ['shape', 'dtype']
+
+    def setup(self, shape, dtype):
+        self.x = (np.random.random(shape) +
+                  1j*np.random.random(shape)).astype(dtype)
+        np.fft.fft2(self.x)
+
+    def time_fft2(self, shape, dtype):
+        np.fft.fft2(self.x)
+
+    def time_ifft2(self, shape, dtype):
+        np.fft.ifft2(self.x)
+
+    def track_fft2_gflops(self, shape, dtype):
+        return _gflops_per_sec(lambda: np.fft.fft2(self.x),
+                               _complex_flops(shape))
+
+    track_fft2_gflops.unit = "GFLOP/s"
+
+
+class RFFT2D(Benchmark):
+    params = [SIZES_2D, ['float32', 'float64']]
+    param_names = ['shape', 'dtype']
+
+    def setup(self, shape, dtype):
+        self.x = np.random.random(shape).astype(dtype)
+        np.fft.rfft2(self.x)
+
+    def time_rfft2(self, shape, dtype):
+        np.fft.rfft2(self.x)
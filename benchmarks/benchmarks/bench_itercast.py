@@ -0,0 +1,71 @@
+from __future__ import absolute_import, division, print_function
+
+from .common import Benchmark
+
+import numpy as np
+
+
+class IterConstruction(Benchmark):
+    # construction cost of the iterator machinery, independent of the
+    # work done per element
+    params = [[1, 2, 4, 8]]
+    param_names = ['nop']
+
+    def setup(self, nop):
+        self.arrays = [np.ones(16) for _ in range(nop)]
+        self.arrays_2d = [np.ones((16, 16)) for _ in range(nop)]
+
+    def time_construct(self, nop):
+        np.nditer(self.arrays)
+
+    def time_construct_buffered(self, nop):
+        np.nditer(self.arrays, flags=['buffered'])
+
+    def time_construct_external_loop(self, nop):
+        np.nditer(self.arrays, flags=['external_loop'])
+
+    def time_construct_multi_index_2d(self, nop):
+        np.nditer(self.arrays_2d, flags=['multi_index'])
+
+
+class CastBandwidth(Benchmark):
+    # throughput of the dtype_transfer cast loops on contiguous data
+    params = [['int16', 'int64', 'float32', 'float64', 'complex128'],
+              ['int16', 'int64', 'float32', 'float64', 'complex128']]
+    param_names = ['from_dtype', 'to_dtype']
+
+    def setup(self, from_dtype, to_dtype):
+        self.a = np.ones(1000000, dtype=from_dtype)
+        self.out = np.empty(1000000, dtype=to_dtype)
+
+    def time_astype(self, from_dtype, to_dtype):
+        self.a.astype(to_dtype)
+
+    def time_cast_into_out(self, from_dtype, to_dtype):
+        np.copyto(self.out, self.a, casting='unsafe')
+
+
+class SmallArrayLatency(Benchmark):
+    # at the small end these times are pure call overhead, at the large
+    # end loop throughput; regressions show up as a shift of the curve
+    params = [[1, 10, 100, 1000, 10000]]
+    param_names = ['size']
+
+    def setup(self, size):
+        self.a = np.ones(size)
+        self.b = np.ones(size)
+        self.out = np.empty(size)
+        self.one_int = np.ones(1, dtype=np.int64)
+
+    def time_add(self, size):
+        np.add(self.a, self.b)
+
+    def time_add_out(self, size):
+        np.add(self.a, self.b, out=self.out)
+
+    def time_add_scalar(self, size):
+        self.a + 1.0
+
+    def time_add_cast_operand(self, size):
+        # forces a buffered cast of the integer operand
+        self.a + self.one_int
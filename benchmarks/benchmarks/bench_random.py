@@ -66,6 +66,100 @@ class Randint_dtype(Benchmark):
         np.random.randint(0, high + 1, size=10**5, dtype=name)
 
 
+class BulkFill(Benchmark):
+    # In-place fills through np.random.fill, swept from 1K buffers up
+    # to 256M; larger sizes mostly measure the memory system and would
+    # need multi-GB buffers in setup.
+    param_names = ['size']
+    params = [[2**10, 2**14, 2**18, 2**22, 2**26, 2**28]]
+
+    def setup(self, size):
+        if not hasattr(np.random, 'fill'):
+            raise NotImplementedError
+        self.buf = bytearray(size)
+        self.out = np.empty(size // 8)
+
+    def time_bytes(self, size):
+        np.random.fill(self.buf)
+
+    def time_uniform(self, size):
+        np.random.fill(self.out, 'uniform')
+
+    def time_normal(self, size):
+        np.random.fill(self.out, 'normal')
+
+
+class FillRate(Benchmark):
+    # Same fills at one large size, reported as GB/s so generator
+    # backend changes show up as absolute throughput.
+    unit = 'GB/s'
+    size = 2**26
+
+    def setup(self):
+        if not hasattr(np.random, 'fill'):
+            raise NotImplementedError
+        self.buf = bytearray(self.size)
+        self.out = np.empty(self.size // 8)
+
+    def _gbps(self, func):
+        import timeit
+        number = 3
+        best = min(timeit.repeat(func, number=number, repeat=3))
+        return self.size * number / best / 2**30
+
+    def track_bytes_gbps(self):
+        return self._gbps(lambda: np.random.fill(self.buf))
+
+    def track_uniform_gbps(self):
+        return self._gbps(lambda: np.random.fill(self.out, 'uniform'))
+
+    def track_normal_gbps(self):
+        return self._gbps(lambda: np.random.fill(self.out, 'normal'))
+
+
+class RandintThroughput(Benchmark):
+    # Bounded integer generation across output sizes, separating the
+    # masked power-of-two path from the rejection path.
+    high = {
+        'uint32': 2**31,
+        'uint64': 2**63,
+        }
+
+    param_names = ['dtype', 'size']
+    params = [['uint32', 'uint64'], [10**3, 10**5, 10**7]]
+
+    def time_randint_pow2(self, dtype, size):
+        np.random.randint(0, self.high[dtype], size=size, dtype=dtype)
+
+    def time_randint_bounded(self, dtype, size):
+        np.random.randint(0, self.high[dtype] + 1, size=size, dtype=dtype)
+
+
+class DistributionFill(Benchmark):
+    # Allocating array draws with constant parameters across sizes;
+    # covers the bulk fill paths of the continuous generators and the
+    # cached-setup paths of the discrete ones.
+    dist_args = {
+        'random_sample': (),
+        'standard_normal': (),
+        'standard_exponential': (),
+        'uniform': (0.0, 10.0),
+        'normal': (0.0, 1.0),
+        'binomial': (100, 0.25),
+        'poisson': (10.0,),
+        }
+
+    param_names = ['dist', 'size']
+    params = [sorted(dist_args.keys()), [10**3, 10**5, 10**7]]
+
+    def setup(self, dist, size):
+        self.func = getattr(np.random, dist)
+        self.args = self.dist_args[dist]
+
+    def time_fill(self, dist, size):
+        self.func(*self.args, size=size)
+
+
 class Permutation(Benchmark):
     def setup(self):
         self.n = 10000
@@ -144,16 +144,39 @@ else:
     from . import compat
     from . import lib
     from .lib import *
-    from . import linalg
-    from . import fft
-    from . import polynomial
-    from . import random
-    from . import ctypeslib
-    from . import ma
     from . import matrixlib as _mat
     from .matrixlib import *
     from .compat import long
 
+    # These submodules are comparatively costly to import and are not
+    # needed by short-lived processes that only use the core array
+    # machinery.  On Python 3.7+ they are loaded on first attribute
+    # access (PEP 562) instead of eagerly; ``import numpy.fft`` and
+    # ``from numpy import fft`` keep working either way.  Note that
+    # numpy.linalg is usually pulled in anyway through numpy.lib.
+    _lazy_submodules = {'linalg', 'fft', 'polynomial', 'random',
+                        'ctypeslib', 'ma', 'testing'}
+    if sys.version_info >= (3, 7):
+        def __getattr__(attr):
+            if attr in _lazy_submodules:
+                import importlib
+                return importlib.import_module('numpy.' + attr)
+            if attr == 'Tester':
+                from .testing import Tester
+                return Tester
+            raise AttributeError("module {!r} has no attribute "
+                                 "{!r}".format(__name__, attr))
+
+        def __dir__():
+            return sorted(set(globals()) | _lazy_submodules | {'Tester'})
+    else:
+        from . import linalg
+        from . import fft
+        from . import polynomial
+        from . import random
+        from . import ctypeslib
+        from . import ma
+
     # Make these accessible from numpy name-space
     # but not imported in from numpy import *
     if sys.version_info[0] >= 3:
@@ -183,8 +206,10 @@ else:
     numarray = 'removed'
 
     # We don't actually use this ourselves anymore, but I'm not 100% sure that
-    # no-one else in the world is using it (though I hope not)
-    from .testing import Tester
+    # no-one else in the world is using it (though I hope not); on 3.7+
+    # it is provided lazily through the module __getattr__ above.
+    if sys.version_info < (3, 7):
+        from .testing import Tester
 
     # Pytest testing
     from numpy._pytesttester import PytestTester
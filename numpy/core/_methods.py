@@ -41,20 +41,36 @@ def _prod(a, axis=None, dtype=None, out=None, keepdims=False,
     return umr_prod(a, axis, dtype, out, keepdims, initial, where)
 
 def _any(a, axis=None, dtype=None, out=None, keepdims=False):
+    if axis is None and dtype is None and out is None and not keepdims:
+        # early-exit scan, stops at the first true element
+        res = mu._decide_all_any(a, 1)
+        if res is not NotImplemented:
+            return res
     return umr_any(a, axis, dtype, out, keepdims)
 
 def _all(a, axis=None, dtype=None, out=None, keepdims=False):
+    if axis is None and dtype is None and out is None and not keepdims:
+        # early-exit scan, stops at the first false element
+        res = mu._decide_all_any(a, 0)
+        if res is not NotImplemented:
+            return res
     return umr_all(a, axis, dtype, out, keepdims)
 
-def _count_reduce_items(arr, axis):
-    if axis is None:
-        axis = tuple(range(arr.ndim))
-    if not isinstance(axis, tuple):
-        axis = (axis,)
-    items = 1
-    for ax in axis:
-        items *= arr.shape[ax]
-    return items
+def _count_reduce_items(arr, axis, keepdims=False, where=True):
+    # fast-path for the default case
+    if where is True:
+        if axis is None:
+            axis = tuple(range(arr.ndim))
+        if not isinstance(axis, tuple):
+            axis = (axis,)
+        items = 1
+        for ax in axis:
+            items *= arr.shape[ax]
+        return items
+    # count True values in (potentially broadcast) boolean mask
+    from numpy.lib.stride_tricks import broadcast_to
+    return umr_sum(broadcast_to(where, arr.shape), axis, nt.intp, None,
+                   keepdims)
 
 # Numpy 1.17.0, 2019-02-24
 # Various clip behavior deprecations, marked with _clip_dep as a prefix.
@@ -130,13 +146,14 @@ def _clip(a, min=None, max=None, out=None, *, casting=None, **kwargs):
         return _clip_dep_invoke_with_casting(
             um.clip, a, min, max, out=out, casting=casting, **kwargs)
 
-def _mean(a, axis=None, dtype=None, out=None, keepdims=False):
+def _mean(a, axis=None, dtype=None, out=None, keepdims=False, where=True):
     arr = asanyarray(a)
 
     is_float16_result = False
-    rcount = _count_reduce_items(arr, axis)
+    rcount = _count_reduce_items(arr, axis, keepdims=keepdims, where=where)
     # Make this warning show up first
-    if rcount == 0:
+    if (rcount == 0 if where is True else
+            umr_any(rcount == 0, None, None, None, False)):
         warnings.warn("Mean of empty slice.", RuntimeWarning, stacklevel=2)
 
     # Cast bool, unsigned int, and int to float64 by default
@@ -147,7 +164,7 @@ def _mean(a, axis=None, dtype=None, out=None, keepdims=False):
             dtype = mu.dtype('f4')
             is_float16_result = True
 
-    ret = umr_sum(arr, axis, dtype, out, keepdims)
+    ret = umr_sum(arr, axis, dtype, out, keepdims, _NoValue, where)
     if isinstance(ret, mu.ndarray):
         ret = um.true_divide(
                 ret, rcount, out=ret, casting='unsafe', subok=False)
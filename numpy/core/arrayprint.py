@@ -884,9 +884,9 @@ class FloatingFormat(object):
             trim, unique = '.', True
             if self.floatmode == 'fixed' or self._legacy == '1.13':
                 trim, unique = 'k', False
-            strs = (dragon4_scientific(x, precision=self.precision,
+            # passing the array formats all elements in one C-level call
+            strs = dragon4_scientific(finite_vals, precision=self.precision,
                                unique=unique, trim=trim, sign=self.sign == '+')
-                    for x in finite_vals)
             frac_strs, _, exp_strs = zip(*(s.partition('e') for s in strs))
             int_part, frac_part = zip(*(s.split('.') for s in frac_strs))
             self.exp_size = max(len(s) for s in exp_strs) - 1
@@ -909,11 +909,11 @@ class FloatingFormat(object):
             trim, unique = '.', True
             if self.floatmode == 'fixed':
                 trim, unique = 'k', False
-            strs = (dragon4_positional(x, precision=self.precision,
-                                       fractional=True,
-                                       unique=unique, trim=trim,
-                                       sign=self.sign == '+')
-                    for x in finite_vals)
+            # passing the array formats all elements in one C-level call
+            strs = dragon4_positional(finite_vals, precision=self.precision,
+                                      fractional=True,
+                                      unique=unique, trim=trim,
+                                      sign=self.sign == '+')
             int_part, frac_part = zip(*(s.split('.') for s in strs))
             if self._legacy == '1.13':
                 self.pad_left = 1 + max(len(s.lstrip('-+')) for s in int_part)
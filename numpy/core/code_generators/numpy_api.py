@@ -350,6 +350,9 @@ multiarray_funcs_api = {
     'PyArray_ResolveWritebackIfCopy':       (302,),
     'PyArray_SetWritebackIfCopyBase':       (303,),
     # End 1.14 API
+    'PyDataMem_SetHandler':                 (304,),
+    'PyDataMem_GetHandler':                 (305,),
+    # End 1.17 API
 }
 
 ufunc_types_api = {
@@ -404,6 +407,8 @@ ufunc_funcs_api = {
     # End 1.8 API
     'PyUFunc_FromFuncAndDataAndSignatureAndIdentity': (42,),
     # End 1.16 API
+    'PyUFunc_RegisterLoopForTypeTiered':        (43,),
+    # End 1.17 API
 }
 
 # List of all the dicts which define the C API
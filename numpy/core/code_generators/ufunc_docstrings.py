@@ -45,8 +45,9 @@ def add_newdoc(place, name, doc):
     skip = (
         # gufuncs do not use the OUT_SCALAR replacement strings
         'matmul',
-        # clip has 3 inputs, which is not handled by this
+        # clip and fma have 3 inputs, which is not handled by this
         'clip',
+        'fma',
     )
     if name[0] != '_' and name not in skip:
         if '\nx :' in doc:
@@ -1360,6 +1361,44 @@ add_newdoc('numpy.core.umath', 'floor_divide',
 
     """)
 
+add_newdoc('numpy.core.umath', 'fma',
+    """
+    Compute ``x1*x2 + x3``, element-wise, in a single pass.
+
+    The multiply and add are fused: the intermediate product is not
+    rounded and no temporary array for ``x1*x2`` is allocated, so the
+    compound expression runs with a single rounding per element and half
+    the memory traffic of ``x1*x2 + x3``.
+
+    Parameters
+    ----------
+    x1 : array_like
+        First multiplicand.
+    x2 : array_like
+        Second multiplicand.
+    x3 : array_like
+        Addend.
+    out : ndarray, optional
+        A location into which the result is stored. If provided, it must
+        have a shape that the inputs broadcast to. If not provided or
+        `None`, a freshly-allocated array is returned.
+    $PARAMS
+
+    Returns
+    -------
+    y : ndarray
+        The fused multiply-add of `x1`, `x2` and `x3`, element-wise.
+
+    See Also
+    --------
+    multiply, add
+
+    Examples
+    --------
+    >>> np.core.umath.fma([1., 2.], [3., 4.], [5., 6.])
+    array([  8.,  14.])
+    """)
+
 add_newdoc('numpy.core.umath', 'fmod',
     """
     Return the element-wise remainder of division.
@@ -22,7 +22,7 @@ import sys
 from .numerictypes import string_, unicode_, integer, object_, bool_, character
 from .numeric import ndarray, compare_chararrays
 from .numeric import array as narray
-from numpy.core.multiarray import _vec_string
+from numpy.core.multiarray import _vec_string, _bytes_transform
 from numpy.core.overrides import set_module
 from numpy.core import overrides
 from numpy.compat import asbytes, long
@@ -91,6 +91,13 @@ def _clean_args(*args):
         newargs.append(chk)
     return newargs
 
+def _is_bytes_array(arr):
+    """
+    Helper function deciding whether the C byte-string transform kernels
+    apply: a fixed-width bytes array of nonzero width.
+    """
+    return arr.dtype.char == 'S' and arr.dtype.itemsize > 0
+
 def _get_num_chars(a):
     """
     Helper function that returns the number of characters per field in
@@ -1039,6 +1046,8 @@ def lower(a):
 
     """
     a_arr = numpy.asarray(a)
+    if _is_bytes_array(a_arr):
+        return _bytes_transform(a_arr, 'lower')
     return _vec_string(a_arr, a_arr.dtype, 'lower')
 
 
@@ -1098,6 +1107,8 @@ def lstrip(a, chars=None):
 
     """
     a_arr = numpy.asarray(a)
+    if chars is None and _is_bytes_array(a_arr):
+        return _bytes_transform(a_arr, 'lstrip')
     return _vec_string(a_arr, a_arr.dtype, 'lstrip', (chars,))
 
 
@@ -1173,6 +1184,13 @@ def replace(a, old, new, count=None):
     str.replace
 
     """
+    a_arr = numpy.asarray(a)
+    if (count is None and _is_bytes_array(a_arr) and
+            isinstance(old, bytes) and isinstance(new, bytes) and
+            len(old) == 1 and len(new) == 1):
+        # same-width single-byte replacement never changes the value
+        # lengths, so it can run over the packed buffer
+        return _bytes_transform(a_arr, 'replace', old, new)
     return _to_string_or_unicode_array(
         _vec_string(
             a, object_, 'replace', [old, new] + _clean_args(count)))
@@ -1401,6 +1419,8 @@ def rstrip(a, chars=None):
 
     """
     a_arr = numpy.asarray(a)
+    if chars is None and _is_bytes_array(a_arr):
+        return _bytes_transform(a_arr, 'rstrip')
     return _vec_string(a_arr, a_arr.dtype, 'rstrip', (chars,))
 
 
@@ -1551,6 +1571,8 @@ def strip(a, chars=None):
 
     """
     a_arr = numpy.asarray(a)
+    if chars is None and _is_bytes_array(a_arr):
+        return _bytes_transform(a_arr, 'strip')
     return _vec_string(a_arr, a_arr.dtype, 'strip', _clean_args(chars))
 
 
@@ -1705,6 +1727,8 @@ def upper(a):
 
     """
     a_arr = numpy.asarray(a)
+    if _is_bytes_array(a_arr):
+        return _bytes_transform(a_arr, 'upper')
     return _vec_string(a_arr, a_arr.dtype, 'upper')
 
 
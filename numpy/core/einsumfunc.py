@@ -16,6 +16,12 @@ __all__ = ['einsum', 'einsum_path']
 einsum_symbols = 'abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ'
 einsum_symbols_set = set(einsum_symbols)
 
+# Contraction plans only depend on the subscripts, the operand shapes and
+# the path options, never on the operand values, so previously computed
+# paths are kept here and reused when the same contraction comes up again.
+_einsum_path_cache = {}
+_MAX_PATH_CACHE_SIZE = 128
+
 
 def _flop_count(idx_contraction, inner, num_terms, size_dictionary):
     """
@@ -903,61 +909,82 @@ def einsum_path(*operands, **kwargs):
     inner_product = (sum(len(x) for x in input_sets) - len(indices)) > 0
     naive_cost = _flop_count(indices, inner_product, len(input_list), dimension_dict)
 
-    # Compute the path
-    if (path_type is False) or (len(input_list) in [1, 2]) or (indices == output_set):
-        # Nothing to be optimized, leave it to einsum
-        path = [tuple(range(len(input_list)))]
-    elif path_type == "greedy":
-        path = _greedy_path(input_sets, output_set, dimension_dict, memory_arg)
-    elif path_type == "optimal":
-        path = _optimal_path(input_sets, output_set, dimension_dict, memory_arg)
-    elif path_type[0] == 'einsum_path':
-        path = path_type[1:]
+    # Searching for a path, especially an 'optimal' one, can dominate small
+    # contractions that are executed many times, so reuse a previous plan
+    # when the same subscripts and shapes come up again
+    if isinstance(path_type, basestring):
+        cache_key = (input_subscripts, output_subscript,
+                     tuple(op.shape for op in operands),
+                     path_type, memory_limit)
+        cached_plan = _einsum_path_cache.get(cache_key)
     else:
-        raise KeyError("Path name %s not found", path_type)
+        cache_key = None
+        cached_plan = None
 
-    cost_list, scale_list, size_list, contraction_list = [], [], [], []
+    if cached_plan is not None:
+        path, cost_list, scale_list, size_list, contraction_list = cached_plan
+    else:
+        # Compute the path
+        if (path_type is False) or (len(input_list) in [1, 2]) or (indices == output_set):
+            # Nothing to be optimized, leave it to einsum
+            path = [tuple(range(len(input_list)))]
+        elif path_type == "greedy":
+            path = _greedy_path(input_sets, output_set, dimension_dict, memory_arg)
+        elif path_type == "optimal":
+            path = _optimal_path(input_sets, output_set, dimension_dict, memory_arg)
+        elif path_type[0] == 'einsum_path':
+            path = path_type[1:]
+        else:
+            raise KeyError("Path name %s not found", path_type)
 
-    # Build contraction tuple (positions, gemm, einsum_str, remaining)
-    for cnum, contract_inds in enumerate(path):
-        # Make sure we remove inds from right to left
-        contract_inds = tuple(sorted(list(contract_inds), reverse=True))
+        cost_list, scale_list, size_list, contraction_list = [], [], [], []
 
-        contract = _find_contraction(contract_inds, input_sets, output_set)
-        out_inds, input_sets, idx_removed, idx_contract = contract
+        # Build contraction tuple (positions, gemm, einsum_str, remaining)
+        for cnum, contract_inds in enumerate(path):
+            # Make sure we remove inds from right to left
+            contract_inds = tuple(sorted(list(contract_inds), reverse=True))
 
-        cost = _flop_count(idx_contract, idx_removed, len(contract_inds), dimension_dict)
-        cost_list.append(cost)
-        scale_list.append(len(idx_contract))
-        size_list.append(_compute_size_by_dict(out_inds, dimension_dict))
+            contract = _find_contraction(contract_inds, input_sets, output_set)
+            out_inds, input_sets, idx_removed, idx_contract = contract
 
-        bcast = set()
-        tmp_inputs = []
-        for x in contract_inds:
-            tmp_inputs.append(input_list.pop(x))
-            bcast |= broadcast_indices.pop(x)
+            cost = _flop_count(idx_contract, idx_removed, len(contract_inds), dimension_dict)
+            cost_list.append(cost)
+            scale_list.append(len(idx_contract))
+            size_list.append(_compute_size_by_dict(out_inds, dimension_dict))
 
-        new_bcast_inds = bcast - idx_removed
+            bcast = set()
+            tmp_inputs = []
+            for x in contract_inds:
+                tmp_inputs.append(input_list.pop(x))
+                bcast |= broadcast_indices.pop(x)
 
-        # If we're broadcasting, nix blas
-        if not len(idx_removed & bcast):
-            do_blas = _can_dot(tmp_inputs, out_inds, idx_removed)
-        else:
-            do_blas = False
+            new_bcast_inds = bcast - idx_removed
 
-        # Last contraction
-        if (cnum - len(path)) == -1:
-            idx_result = output_subscript
-        else:
-            sort_result = [(dimension_dict[ind], ind) for ind in out_inds]
-            idx_result = "".join([x[1] for x in sorted(sort_result)])
+            # If we're broadcasting, nix blas
+            if not len(idx_removed & bcast):
+                do_blas = _can_dot(tmp_inputs, out_inds, idx_removed)
+            else:
+                do_blas = False
+
+            # Last contraction
+            if (cnum - len(path)) == -1:
+                idx_result = output_subscript
+            else:
+                sort_result = [(dimension_dict[ind], ind) for ind in out_inds]
+                idx_result = "".join([x[1] for x in sorted(sort_result)])
+
+            input_list.append(idx_result)
+            broadcast_indices.append(new_bcast_inds)
+            einsum_str = ",".join(tmp_inputs) + "->" + idx_result
 
-        input_list.append(idx_result)
-        broadcast_indices.append(new_bcast_inds)
-        einsum_str = ",".join(tmp_inputs) + "->" + idx_result
+            contraction = (contract_inds, idx_removed, einsum_str, input_list[:], do_blas)
+            contraction_list.append(contraction)
 
-        contraction = (contract_inds, idx_removed, einsum_str, input_list[:], do_blas)
-        contraction_list.append(contraction)
+        if cache_key is not None:
+            if len(_einsum_path_cache) >= _MAX_PATH_CACHE_SIZE:
+                _einsum_path_cache.clear()
+            _einsum_path_cache[cache_key] = (path, cost_list, scale_list,
+                                             size_list, contraction_list)
 
     opt_cost = sum(cost_list) + 1
 
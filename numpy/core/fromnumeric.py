@@ -3121,12 +3121,14 @@ def around(a, decimals=0, out=None):
     return _wrapfunc(a, 'round', decimals=decimals, out=out)
 
 
-def _mean_dispatcher(a, axis=None, dtype=None, out=None, keepdims=None):
-    return (a, out)
+def _mean_dispatcher(a, axis=None, dtype=None, out=None, keepdims=None,
+                     where=None):
+    return (a, out, where)
 
 
 @array_function_dispatch(_mean_dispatcher)
-def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
+def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
+         where=np._NoValue):
     """
     Compute the arithmetic mean along the specified axis.
 
@@ -3167,6 +3169,10 @@ def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
         `ndarray`, however any non-default value will be.  If the
         sub-class' method does not implement `keepdims` any
         exceptions will be raised.
+    where : array_like of bool, optional
+        Elements to include in the mean. The mask is broadcast against
+        the array, and the divisor counts only the included elements,
+        so no compressed temporary is materialized.
 
     Returns
     -------
@@ -3220,6 +3226,8 @@ def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
     kwargs = {}
     if keepdims is not np._NoValue:
         kwargs['keepdims'] = keepdims
+    if where is not np._NoValue:
+        kwargs['where'] = where
     if type(a) is not mu.ndarray:
         try:
             mean = a.mean
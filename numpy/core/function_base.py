@@ -7,7 +7,7 @@ import operator
 from . import numeric as _nx
 from .numeric import (result_type, NaN, shares_memory, MAY_SHARE_BOUNDS,
                       TooHardError, asanyarray, ndim)
-from numpy.core.multiarray import add_docstring
+from numpy.core.multiarray import add_docstring, _linspace
 from numpy.core import overrides
 
 __all__ = ['logspace', 'linspace', 'geomspace']
@@ -130,6 +130,14 @@ def linspace(start, stop, num=50, endpoint=True, retstep=False, dtype=None,
         raise ValueError("Number of samples, %s, must be non-negative." % num)
     div = (num - 1) if endpoint else num
 
+    # Plain double scalars on the default axis fill the samples in a
+    # single C pass with the same arithmetic as the general path below.
+    if (not retstep and axis == 0
+            and isinstance(start, (int, float))
+            and isinstance(stop, (int, float))
+            and (dtype is None or _nx.dtype(dtype) == _nx.dtype(float))):
+        return _linspace(float(start), float(stop), num, endpoint)
+
     # Convert float/complex array scalars to float, gh-3504
     # and make sure one can use variables that have an __array_interface__, gh-6634
     start = asanyarray(start) * 1.0
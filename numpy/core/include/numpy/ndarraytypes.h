@@ -1046,6 +1046,11 @@ typedef void (NpyIter_GetMultiIndexFunc)(NpyIter *iter,
  * eliminate overlap.
  */
 #define NPY_ITER_COPY_IF_OVERLAP            0x00002000
+/*
+ * When buffering is enabled and no explicit buffersize was given, size
+ * the buffers from the CPU data cache instead of using NPY_BUFSIZE.
+ */
+#define NPY_ITER_AUTO_BUFSIZE               0x00004000
 
 /*** Per-operand flags that may be passed to the iterator constructors ***/
 
@@ -1817,6 +1822,21 @@ typedef struct {
 typedef void (PyDataMem_EventHookFunc)(void *inp, void *outp, size_t size,
                                        void *user_data);
 
+/*
+ * A set of allocation routines for array data, installable at runtime
+ * with PyDataMem_SetHandler.  The 'ctx' pointer is passed through to
+ * every function unchanged, for allocators that carry state (memory
+ * pools, NUMA nodes, ...).  See the documentation for
+ * PyDataMem_SetHandler for the lifetime requirements.
+ */
+typedef struct {
+    void *ctx;
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*zeroed_alloc)(void *ctx, size_t nelems, size_t elsize);
+    void *(*realloc)(void *ctx, void *ptr, size_t new_size);
+    void (*free)(void *ctx, void *ptr);
+} PyDataMem_Handler;
+
 /*
  * Use the keyword NPY_DEPRECATED_INCLUDES to ensure that the header files
  * npy_*_*_deprecated_api.h are only included from here and nowhere else.
@@ -60,6 +60,13 @@
 #define NPY_GCC_TARGET_AVX512F
 #endif
 
+/* avx is needed for the 256 bit register half<->float conversions */
+#if defined HAVE_ATTRIBUTE_TARGET_F16C_WITH_INTRINSICS
+#define NPY_GCC_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#define NPY_GCC_TARGET_F16C
+#endif
+
 /*
  * mark an argument (starting from 1) that must not be NULL and is not checked
  * DO NOT USE IF FUNCTION CHECKS FOR NULL!! the compiler will remove the check
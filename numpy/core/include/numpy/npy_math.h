@@ -129,8 +129,25 @@ NPY_INLINE static float __npy_nzerof(void)
 #define NPY_COEFF_Q1_EXPf -2.742335390411667452936e-01f                                
 #define NPY_COEFF_Q2_EXPf 2.159509375685829852307e-02f  
 
-/* 
- * Constants used in vector implementation of log(x) 
+/*
+ * Constants used in vector implementation of sinf/cosf(x)
+ */
+#define NPY_TWO_O_PIf 0x1.45f306p-1f
+#define NPY_CODY_WAITE_PI_O_2_HIGHf -0x1.921fb0p+00f
+#define NPY_CODY_WAITE_PI_O_2_MEDf -0x1.5110b4p-22f
+#define NPY_CODY_WAITE_PI_O_2_LOWf -0x1.846988p-48f
+#define NPY_COEFF_INVF0_COSINEf 0x1.fffffcp-1f
+#define NPY_COEFF_INVF2_COSINEf -0x1.ff5501p-2f
+#define NPY_COEFF_INVF4_COSINEf 0x1.55326ap-5f
+#define NPY_COEFF_INVF6_COSINEf -0x1.4e44a6p-10f
+#define NPY_COEFF_INVF8_COSINEf 0x1.829338p-16f
+#define NPY_COEFF_INVF3_SINEf -0x1.555554p-3f
+#define NPY_COEFF_INVF5_SINEf 0x1.11119ap-7f
+#define NPY_COEFF_INVF7_SINEf -0x1.a06bbap-13f
+#define NPY_COEFF_INVF9_SINEf 0x1.7d3bbcp-19f
+
+/*
+ * Constants used in vector implementation of log(x)
  */
 #define NPY_COEFF_P0_LOGf 0.000000000000000000000e+00f                          
 #define NPY_COEFF_P1_LOGf 9.999999999999998702752e-01f                          
@@ -164,6 +181,7 @@ NPY_INPLACE double npy_log10(double x);
 NPY_INPLACE double npy_exp(double x);
 NPY_INPLACE double npy_sqrt(double x);
 NPY_INPLACE double npy_cbrt(double x);
+NPY_INPLACE double npy_fma(double x, double y, double z);
 
 NPY_INPLACE double npy_fabs(double x);
 NPY_INPLACE double npy_ceil(double x);
@@ -270,6 +288,7 @@ NPY_INPLACE float npy_rintf(float x);
 NPY_INPLACE float npy_truncf(float x);
 NPY_INPLACE float npy_sqrtf(float x);
 NPY_INPLACE float npy_cbrtf(float x);
+NPY_INPLACE float npy_fmaf(float x, float y, float z);
 NPY_INPLACE float npy_log10f(float x);
 NPY_INPLACE float npy_logf(float x);
 NPY_INPLACE float npy_expf(float x);
@@ -313,6 +332,7 @@ NPY_INPLACE npy_longdouble npy_rintl(npy_longdouble x);
 NPY_INPLACE npy_longdouble npy_truncl(npy_longdouble x);
 NPY_INPLACE npy_longdouble npy_sqrtl(npy_longdouble x);
 NPY_INPLACE npy_longdouble npy_cbrtl(npy_longdouble x);
+NPY_INPLACE npy_longdouble npy_fmal(npy_longdouble x, npy_longdouble y, npy_longdouble z);
 NPY_INPLACE npy_longdouble npy_log10l(npy_longdouble x);
 NPY_INPLACE npy_longdouble npy_logl(npy_longdouble x);
 NPY_INPLACE npy_longdouble npy_expl(npy_longdouble x);
@@ -6,9 +6,13 @@ from numpy.compat import (
     long, basestring, os_fspath, contextlib_nullcontext, is_pathlib_path
 )
 from numpy.core.overrides import set_module
+from numpy.core.multiarray import _madvise_range
 
 __all__ = ['memmap']
 
+# target bytes per block for the chunked drivers below
+_CHUNK_TARGET_BYTES = 1 << 26
+
 dtypedescr = dtype
 valid_filemodes = ["r", "c", "r+", "w+"]
 writeable_filemodes = ["r+", "w+"]
@@ -332,3 +336,96 @@ class memmap(ndarray):
         if type(res) is memmap and res._mmap is None:
             return res.view(type=ndarray)
         return res
+
+
+def _chunk_blocksize(arrays, blocksize):
+    """Rows per block so the widest operand slab is ~_CHUNK_TARGET_BYTES."""
+    if blocksize is not None:
+        if blocksize < 1:
+            raise ValueError("blocksize must be at least 1")
+        return blocksize
+    rowbytes = max(a.nbytes // max(a.shape[0], 1) for a in arrays)
+    return max(1, _CHUNK_TARGET_BYTES // max(rowbytes, 1))
+
+
+def chunked_apply(op, args, out=None, blocksize=None):
+    """
+    Apply an elementwise callable over equal-shape operands in blocks.
+
+    Iterates along the first axis in block-sized slabs, prefetching the
+    next slab of every memory-mapped operand and dropping completed
+    slabs of read-only memory-mapped operands, so expressions over
+    arrays far larger than memory stream through the page cache instead
+    of faulting with no lookahead and evicting with no hints.  Operands
+    that are not memory mapped are processed identically, just without
+    the paging hints.
+
+    `op` is called once per block with one slab per operand; a ufunc is
+    additionally given the output slab as ``out=`` to avoid a block
+    temporary.  All operands must share one shape.
+    """
+    arrays = [np.asanyarray(a) for a in args]
+    if not arrays:
+        raise ValueError("chunked_apply needs at least one operand")
+    shape = arrays[0].shape
+    for a in arrays[1:]:
+        if a.shape != shape:
+            raise ValueError(
+                "operands of chunked_apply must have the same shape")
+    if arrays[0].ndim == 0:
+        res = op(*arrays)
+        if out is not None:
+            out[...] = res
+            return out
+        return res
+
+    n = shape[0]
+    blocksize = _chunk_blocksize(arrays, blocksize)
+    for a in arrays:
+        _madvise_range(a, 'sequential')
+    if out is None:
+        out = np.empty(shape, dtype=op(*[a[:0] for a in arrays]).dtype)
+
+    for start in range(0, n, blocksize):
+        stop = min(start + blocksize, n)
+        for a in arrays:
+            _madvise_range(a[stop:min(stop + blocksize, n)], 'willneed')
+        blocks = [a[start:stop] for a in arrays]
+        if isinstance(op, np.ufunc):
+            op(*blocks, out=out[start:stop])
+        else:
+            out[start:stop] = op(*blocks)
+        for a in arrays:
+            _madvise_range(a[start:stop], 'dontneed')
+    return out
+
+
+def chunked_reduce(op, a, blocksize=None):
+    """
+    Reduce an array with a ufunc in blocks along the first axis.
+
+    Same paging discipline as `chunked_apply`.  The result is `op`
+    reduced over the per-block partial reductions, so `op` must be an
+    associative ufunc (np.add, np.maximum, ...); for inexact dtypes the
+    changed association can differ from ``op.reduce(a, axis=None)`` by
+    rounding.
+    """
+    arr = np.asanyarray(a)
+    if not isinstance(op, np.ufunc):
+        raise TypeError("chunked_reduce requires a ufunc")
+    if arr.ndim == 0 or arr.shape[0] == 0:
+        return op.reduce(arr, axis=None)
+
+    n = arr.shape[0]
+    blocksize = _chunk_blocksize([arr], blocksize)
+    _madvise_range(arr, 'sequential')
+
+    partials = []
+    for start in range(0, n, blocksize):
+        stop = min(start + blocksize, n)
+        _madvise_range(arr[stop:min(stop + blocksize, n)], 'willneed')
+        partials.append(op.reduce(arr[start:stop], axis=None))
+        _madvise_range(arr[start:stop], 'dontneed')
+    if len(partials) == 1:
+        return partials[0]
+    return op.reduce(np.array(partials))
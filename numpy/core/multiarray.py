@@ -16,7 +16,13 @@ import numpy as np
 from numpy.core._multiarray_umath import *
 from numpy.core._multiarray_umath import (
     _fastCopyAndTranspose, _flagdict, _insert, _reconstruct, _vec_string,
-    _ARRAY_API, _monotonicity
+    _ARRAY_API, _monotonicity, _histogram_uniform, _topk, _SortIndex,
+    _InterpTable, _LazyExpr, _bytes_transform, _set_num_threads,
+    _set_thread_limit, _get_num_threads, _set_deterministic, _madvise_range,
+    _block_assemble, _outer_multiply, _roll_contiguous,
+    _sliding_window_view, _pad_engine, _linspace, _ravel_view,
+    _expand_dims_view, _polyval, _decide_all_any, _GrowableArray,
+    _count_nonfinite, _unique_hash, _in1d_hash
     )
 
 __all__ = [
@@ -25,6 +31,14 @@ __all__ = [
     'MAY_SHARE_BOUNDS', 'MAY_SHARE_EXACT', 'NEEDS_INIT', 'NEEDS_PYAPI',
     'RAISE', 'USE_GETITEM', 'USE_SETITEM', 'WRAP', '_fastCopyAndTranspose',
     '_flagdict', '_insert', '_reconstruct', '_vec_string', '_monotonicity',
+    '_histogram_uniform', '_topk', '_SortIndex', '_InterpTable',
+    '_LazyExpr',
+    '_bytes_transform', '_set_num_threads', '_set_thread_limit',
+    '_get_num_threads', '_set_deterministic', '_madvise_range',
+    '_block_assemble', '_outer_multiply', '_roll_contiguous',
+    '_sliding_window_view', '_pad_engine', '_linspace', '_ravel_view',
+    '_expand_dims_view', '_polyval', '_decide_all_any', '_GrowableArray',
+    '_count_nonfinite', '_unique_hash', '_in1d_hash',
     'add_docstring', 'arange', 'array', 'bincount', 'broadcast',
     'busday_count', 'busday_offset', 'busdaycalendar', 'can_cast',
     'compare_chararrays', 'concatenate', 'copyto', 'correlate', 'correlate2',
@@ -20,7 +20,7 @@ from .multiarray import (
     inner, int_asbuffer, lexsort, matmul, may_share_memory,
     min_scalar_type, ndarray, nditer, nested_iters, promote_types,
     putmask, result_type, set_numeric_ops, shares_memory, vdot, where,
-    zeros, normalize_axis_index)
+    zeros, normalize_axis_index, _outer_multiply, _roll_contiguous)
 if sys.version_info[0] < 3:
     from .multiarray import newbuffer, getbuffer
 
@@ -897,6 +897,23 @@ def outer(a, b, out=None):
     """
     a = asarray(a)
     b = asarray(b)
+    # Contiguous float vectors take the tiled rank-1 kernel, which skips
+    # the broadcasting iterator that multiply.outer would set up.  The
+    # out= case additionally requires a plain matching ndarray so the raw
+    # row writes are valid.
+    if (type(a) is ndarray and type(b) is ndarray and
+            a.dtype == b.dtype and a.dtype.char in 'fd'):
+        af = a.ravel()
+        bf = b.ravel()
+        if af.flags.carray and bf.flags.carray:
+            if out is None:
+                return _outer_multiply(af, bf)
+            if (type(out) is ndarray and out.dtype == a.dtype and
+                    out.shape == (af.size, bf.size) and
+                    out.flags.carray and
+                    not may_share_memory(out, af) and
+                    not may_share_memory(out, bf)):
+                return _outer_multiply(af, bf, out)
     return multiply(a.ravel()[:, newaxis], b.ravel()[newaxis, :], out)
 
 
@@ -1065,6 +1082,42 @@ def tensordot(a, b, axes=2):
     if not equal:
         raise ValueError("shape-mismatch for sum")
 
+    # Jointly reorder the contracted axes to follow the operands' memory
+    # layout when that lets the 2-d reshapes below be views instead of
+    # copies; the contraction does not depend on the order in which the
+    # summed axes are walked.  Only numeric dtypes are reordered, so that
+    # e.g. object addition keeps its documented term order.
+    if na > 1 and a.dtype.kind in 'buifc' and b.dtype.kind in 'buifc':
+        notin_a = [k for k in range(nda) if k not in axes_a]
+        notin_b = [k for k in range(ndb) if k not in axes_b]
+
+        def _collapses(arr, axes):
+            # True if the axes merge into one strided dimension, i.e.
+            # transpose + reshape will not copy
+            last = None
+            for ax in axes:
+                if arr.shape[ax] == 1:
+                    continue
+                if last is not None and last != arr.strides[ax] * arr.shape[ax]:
+                    return False
+                last = arr.strides[ax]
+            return True
+
+        def _score(pairs):
+            return ((_collapses(a, notin_a) and
+                     _collapses(a, [p[0] for p in pairs])) +
+                    (_collapses(b, [p[1] for p in pairs]) and
+                     _collapses(b, notin_b)))
+
+        pairs = list(zip(axes_a, axes_b))
+        candidates = [pairs,
+                      sorted(pairs, key=lambda p: -abs(a.strides[p[0]])),
+                      sorted(pairs, key=lambda p: -abs(b.strides[p[1]]))]
+        # max is stable, so the original order wins any tie
+        best = max(candidates, key=_score)
+        axes_a = [p[0] for p in best]
+        axes_b = [p[1] for p in best]
+
     # Move the axes to sum over to the end of "a"
     # and to the front of "b"
     notin = [k for k in range(nda) if k not in axes_a]
@@ -1178,6 +1231,15 @@ def roll(a, shift, axis=None):
         for sh, ax in broadcasted:
             shifts[ax] += sh
 
+        # A roll along the last axis of a C-contiguous array is two
+        # block copies per row; take the C path instead of the sliced
+        # gather below.  Reference dtypes and subclasses keep the
+        # general path.
+        if (type(a) is ndarray and a.flags.carray and
+                not a.dtype.hasobject and
+                all(shifts[ax] == 0 for ax in range(a.ndim - 1))):
+            return _roll_contiguous(a, shifts[a.ndim - 1])
+
         rolls = [((slice(None), slice(None)),)] * a.ndim
         for ax, offset in shifts.items():
             offset %= a.shape[ax] or 1  # If `a` is empty, nothing matters.
@@ -1606,7 +1668,7 @@ little_endian = (sys.byteorder == 'little')
 
 
 @set_module('numpy')
-def indices(dimensions, dtype=int):
+def indices(dimensions, dtype=int, sparse=False):
     """
     Return an array representing the indices of a grid.
 
@@ -1619,28 +1681,38 @@ def indices(dimensions, dtype=int):
         The shape of the grid.
     dtype : dtype, optional
         Data type of the result.
+    sparse : boolean, optional
+        Return a sparse representation of the grid instead of a dense
+        representation. Default is False.
+
+        .. versionadded:: 1.17
 
     Returns
     -------
-    grid : ndarray
-        The array of grid indices,
-        ``grid.shape = (len(dimensions),) + tuple(dimensions)``.
+    grid : one ndarray or tuple of ndarrays
+        If sparse is False:
+            Returns one array of grid indices,
+            ``grid.shape = (len(dimensions),) + tuple(dimensions)``.
+        If sparse is True:
+            Returns a tuple of arrays, with
+            ``grid[i].shape = (1, ..., 1, dimensions[i], 1, ..., 1)`` with
+            dimensions[i] in the ith place
 
     See Also
     --------
-    mgrid, meshgrid
+    mgrid, ogrid, meshgrid
 
     Notes
     -----
-    The output shape is obtained by prepending the number of dimensions
-    in front of the tuple of dimensions, i.e. if `dimensions` is a tuple
-    ``(r0, ..., rN-1)`` of length ``N``, the output shape is
-    ``(N,r0,...,rN-1)``.
+    The output shape in the dense case is obtained by prepending the number
+    of dimensions in front of the tuple of dimensions, i.e. if `dimensions`
+    is a tuple ``(r0, ..., rN-1)`` of length ``N``, the output shape is
+    ``(N, r0, ..., rN-1)``.
 
     The subarrays ``grid[k]`` contains the N-D array of indices along the
     ``k-th`` axis. Explicitly::
 
-        grid[k,i0,i1,...,iN-1] = ik
+        grid[k, i0, i1, ..., iN-1] = ik
 
     Examples
     --------
@@ -1665,15 +1737,41 @@ def indices(dimensions, dtype=int):
     Note that it would be more straightforward in the above example to
     extract the required elements directly with ``x[:2, :3]``.
 
+    If sparse is set to true, the grid will be returned in a sparse
+    representation.
+
+    >>> i, j = np.indices((2, 3), sparse=True)
+    >>> i.shape
+    (2, 1)
+    >>> j.shape
+    (1, 3)
+    >>> i        # row indices
+    array([[0],
+           [1]])
+    >>> j        # column indices
+    array([[0, 1, 2]])
+
+    The sparse arrays broadcast against each other, so an expression
+    like ``f(i, j)`` evaluates over the whole grid while the iterator
+    reads each coordinate vector once instead of a dense matrix per
+    axis.
+
     """
     dimensions = tuple(dimensions)
     N = len(dimensions)
     shape = (1,)*N
-    res = empty((N,)+dimensions, dtype=dtype)
+    if sparse:
+        res = tuple()
+    else:
+        res = empty((N,)+dimensions, dtype=dtype)
     for i, dim in enumerate(dimensions):
-        res[i] = arange(dim, dtype=dtype).reshape(
+        idx = arange(dim, dtype=dtype).reshape(
             shape[:i] + (dim,) + shape[i+1:]
         )
+        if sparse:
+            res = res + (idx,)
+        else:
+            res[i] = idx
     return res
 
 
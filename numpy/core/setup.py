@@ -711,6 +711,7 @@ def configuration(parent_package='',top_path=None):
                        join('src', 'npysort', 'timsort.c.src'),
                        join('src', 'npysort', 'heapsort.c.src'),
                        join('src', 'npysort', 'radixsort.c.src'),
+                       join('src', 'npysort', 'countingsort.c.src'),
                        join('src', 'common', 'npy_partition.h.src'),
                        join('src', 'npysort', 'selection.c.src'),
                        join('src', 'common', 'npy_binsearch.h.src'),
@@ -741,12 +742,14 @@ def configuration(parent_package='',top_path=None):
             join('src', 'common', 'cblasfuncs.h'),
             join('src', 'common', 'lowlevel_strided_loops.h'),
             join('src', 'common', 'mem_overlap.h'),
+            join('src', 'common', 'npy_arena.h'),
             join('src', 'common', 'npy_cblas.h'),
             join('src', 'common', 'npy_config.h'),
             join('src', 'common', 'npy_ctypes.h'),
             join('src', 'common', 'npy_extint128.h'),
             join('src', 'common', 'npy_import.h'),
             join('src', 'common', 'npy_longdouble.h'),
+            join('src', 'common', 'npy_workpool.h'),
             join('src', 'common', 'templ_common.h.src'),
             join('src', 'common', 'ucsnarrow.h'),
             join('src', 'common', 'ufunc_override.h'),
@@ -757,7 +760,9 @@ def configuration(parent_package='',top_path=None):
     common_src = [
             join('src', 'common', 'array_assign.c'),
             join('src', 'common', 'mem_overlap.c'),
+            join('src', 'common', 'npy_arena.c'),
             join('src', 'common', 'npy_longdouble.c'),
+            join('src', 'common', 'npy_workpool.c'),
             join('src', 'common', 'templ_common.h.src'),
             join('src', 'common', 'ucsnarrow.c'),
             join('src', 'common', 'ufunc_override.c'),
@@ -787,6 +792,7 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'arrayfunction_override.h'),
             join('src', 'multiarray', 'buffer.h'),
             join('src', 'multiarray', 'calculation.h'),
+            join('src', 'multiarray', 'chunked_io.h'),
             join('src', 'multiarray', 'common.h'),
             join('src', 'multiarray', 'convert_datatype.h'),
             join('src', 'multiarray', 'convert.h'),
@@ -806,8 +812,14 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'scalartypes.h'),
             join('src', 'multiarray', 'sequence.h'),
             join('src', 'multiarray', 'shape.h'),
+            join('src', 'multiarray', 'sort_parallel.h'),
+            join('src', 'multiarray', 'sortindex.h'),
+            join('src', 'multiarray', 'interptable.h'),
+            join('src', 'multiarray', 'lazyexpr.h'),
+            join('src', 'multiarray', 'growable.h'),
             join('src', 'multiarray', 'strfuncs.h'),
             join('src', 'multiarray', 'typeinfo.h'),
+            join('src', 'multiarray', 'unicode_codec.h'),
             join('src', 'multiarray', 'usertypes.h'),
             join('src', 'multiarray', 'vdot.h'),
             join('include', 'numpy', 'arrayobject.h'),
@@ -840,6 +852,7 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'arrayfunction_override.c'),
             join('src', 'multiarray', 'buffer.c'),
             join('src', 'multiarray', 'calculation.c'),
+            join('src', 'multiarray', 'chunked_io.c'),
             join('src', 'multiarray', 'compiled_base.c'),
             join('src', 'multiarray', 'common.c'),
             join('src', 'multiarray', 'convert.c'),
@@ -873,9 +886,15 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'shape.c'),
             join('src', 'multiarray', 'scalarapi.c'),
             join('src', 'multiarray', 'scalartypes.c.src'),
+            join('src', 'multiarray', 'sort_parallel.c'),
+            join('src', 'multiarray', 'sortindex.c'),
+            join('src', 'multiarray', 'interptable.c'),
+            join('src', 'multiarray', 'lazyexpr.c'),
+            join('src', 'multiarray', 'growable.c'),
             join('src', 'multiarray', 'strfuncs.c'),
             join('src', 'multiarray', 'temp_elide.c'),
             join('src', 'multiarray', 'typeinfo.c'),
+            join('src', 'multiarray', 'unicode_codec.c'),
             join('src', 'multiarray', 'usertypes.c'),
             join('src', 'multiarray', 'vdot.c'),
             ]
@@ -909,6 +928,8 @@ def configuration(parent_package='',top_path=None):
             join('src', 'umath', 'clip.h.src'),
             join('src', 'umath', 'clip.c.src'),
             join('src', 'umath', 'ufunc_object.c'),
+            join('src', 'umath', 'ufunc_parallel.c'),
+            join('src', 'umath', 'ufunc_stats.c'),
             join('src', 'umath', 'extobj.c'),
             join('src', 'umath', 'cpuid.c'),
             join('src', 'umath', 'scalarmath.c.src'),
@@ -925,6 +946,7 @@ def configuration(parent_package='',top_path=None):
             join('src', 'common', 'templ_common.h.src'),
             join('src', 'umath', 'simd.inc.src'),
             join('src', 'umath', 'override.h'),
+            join('src', 'umath', 'ufunc_stats.h'),
             join(codegen_dir, 'generate_ufunc_api.py'),
             ]
 
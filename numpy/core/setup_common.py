@@ -42,7 +42,8 @@ C_ABI_VERSION = 0x01000009
 # 0x0000000c - 1.14.x
 # 0x0000000c - 1.15.x
 # 0x0000000d - 1.16.x
-C_API_VERSION = 0x0000000d
+# 0x0000000e - 1.17.x
+C_API_VERSION = 0x0000000e
 
 class MismatchCAPIWarning(Warning):
     pass
@@ -170,6 +171,8 @@ OPTIONAL_FUNCTION_ATTRIBUTES = [('__attribute__((optimize("unroll-loops")))',
                                  'attribute_target_avx2'),
                                 ('__attribute__((target ("avx512f")))',
                                  'attribute_target_avx512f'),
+                                ('__attribute__((target ("avx,f16c")))',
+                                 'attribute_target_f16c'),
                                 ]
 
 # function attributes with intrinsics
@@ -185,6 +188,10 @@ OPTIONAL_FUNCTION_ATTRIBUTES_WITH_INTRINSICS = [('__attribute__((target("avx2"))
                                 'attribute_target_avx512f_with_intrinsics',
                                 '__m512 temp = _mm512_set1_ps(1.0)',
                                 'immintrin.h'),
+                                ('__attribute__((target("avx,f16c")))',
+                                'attribute_target_f16c_with_intrinsics',
+                                '__m256 temp = _mm256_cvtph_ps(_mm_set1_epi16(1))',
+                                'immintrin.h'),
                                 ]
 
 # variable attributes tested via "int %s a" % attribute
@@ -202,7 +209,7 @@ C99_FUNCS = [
     "rint", "trunc", "sqrt", "log10", "log", "log1p", "exp", "expm1",
     "asin", "acos", "atan", "asinh", "acosh", "atanh", "hypot", "atan2",
     "pow", "fmod", "modf", 'frexp', 'ldexp', "exp2", "log2", "copysign",
-    "nextafter", "cbrt"
+    "nextafter", "cbrt", "fma"
     ]
 C99_FUNCS_SINGLE = [f + 'f' for f in C99_FUNCS]
 C99_FUNCS_EXTENDED = [f + 'l' for f in C99_FUNCS]
@@ -10,7 +10,7 @@ import warnings
 from . import numeric as _nx
 from . import overrides
 from .numeric import array, asanyarray, newaxis
-from .multiarray import normalize_axis_index
+from .multiarray import normalize_axis_index, _block_assemble
 
 
 array_function_dispatch = functools.partial(
@@ -810,21 +810,12 @@ def block(arrays):
     """
     arrays, list_ndim, result_ndim, final_size = _block_setup(arrays)
 
-    # It was found through benchmarking that making an array of final size
-    # around 256x256 was faster by straight concatenation on a
-    # i7-7700HQ processor and dual channel ram 2400MHz.
-    # It didn't seem to matter heavily on the dtype used.
-    #
-    # A 2D array using repeated concatenation requires 2 copies of the array.
-    #
-    # The fastest algorithm will depend on the ratio of CPU power to memory
-    # speed.
-    # One can monitor the results of the benchmark
-    # https://pv.github.io/numpy-bench/#bench_shape_base.Block2D.time_block2d
-    # to tune this parameter until a C version of the `_block_info_recursion`
-    # algorithm is implemented which would likely be faster than the python
-    # version.
-    if list_ndim * final_size > (2 * 512 * 512):
+    # The slicing path plans the final shape once and copies every
+    # input straight into its destination slice through a single C
+    # call, touching each byte once; repeated concatenation copies the
+    # data once per nesting level.  Only trivially small problems,
+    # where the planning itself dominates, still concatenate.
+    if list_ndim * final_size > 512:
         return _block_slicing(arrays, list_ndim, result_ndim)
     else:
         return _block_concatenate(arrays, list_ndim, result_ndim)
@@ -865,8 +856,17 @@ def _block_slicing(arrays, list_ndim, result_ndim):
     # PyArray_CreateMultiSortedStridePerm could be used for more advanced
     # guessing of the desired order.
 
-    for the_slice, arr in zip(slices, arrays):
-        result[(Ellipsis,) + the_slice] = arr
+    # A basic slice view shares the parent's strides, so each
+    # destination is fully described by a flat byte offset; the copies
+    # themselves run in one C call without indexing or temporaries.
+    offsets = []
+    for the_slice in slices:
+        lead = result.ndim - len(the_slice)
+        offset = 0
+        for j, sl in enumerate(the_slice):
+            offset += sl.start * result.strides[lead + j]
+        offsets.append(offset)
+    _block_assemble(result, offsets, arrays)
     return result
 
 
@@ -114,5 +114,21 @@ IsUintAligned(PyArrayObject *ap);
 NPY_NO_EXPORT int
 arrays_overlap(PyArrayObject *arr1, PyArrayObject *arr2);
 
+/* One destination block of a multi-block copy */
+typedef struct {
+    char *dst;
+    const char *src;
+    npy_uintp nbytes;
+} npy_block_copy_spec;
+
+/*
+ * Copy independent (dst, src, nbytes) blocks, distributing the blocks
+ * over the assignment worker threads (NPY_ASSIGN_THREADS).  The blocks
+ * must not overlap one another or their sources; they complete in
+ * arbitrary order.  Small totals and the serial configuration run a
+ * plain memcpy loop.  The GIL may be held; the copies release it.
+ */
+NPY_NO_EXPORT void
+npy_parallel_block_copy(npy_block_copy_spec *blocks, npy_intp nblocks);
 
 #endif
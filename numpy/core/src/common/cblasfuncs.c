@@ -10,6 +10,7 @@
 #include <assert.h>
 #include <numpy/arrayobject.h>
 #include "npy_cblas.h"
+#include "cblasfuncs.h"
 #include "arraytypes.h"
 #include "common.h"
 
@@ -205,6 +206,47 @@ _bad_strides(PyArrayObject *ap)
     return 0;
 }
 
+/*
+ * Determine whether a 2-d operand can be passed to BLAS as-is and how.
+ *
+ * BLAS accepts any matrix with one contiguous axis whose stride along
+ * the other axis, counted in elements, is at least the length of the
+ * contiguous axis: such a view is described by a transpose flag and a
+ * leading dimension, no copy needed. On success, set *trans and *lda
+ * and return 1; return 0 if the operand is strided along both axes and
+ * has to be copied. _bad_strides() has already rejected negative
+ * strides and strides that are not multiples of the itemsize.
+ */
+static int
+_select_blas_layout(PyArrayObject *ap, enum CBLAS_TRANSPOSE *trans, int *lda)
+{
+    npy_intp m = PyArray_DIM(ap, 0), n = PyArray_DIM(ap, 1);
+    npy_intp s0 = PyArray_STRIDE(ap, 0), s1 = PyArray_STRIDE(ap, 1);
+    npy_intp itemsize = PyArray_ITEMSIZE(ap);
+
+    if (PyArray_IS_C_CONTIGUOUS(ap)) {
+        *trans = CblasNoTrans;
+        *lda = (int)(n > 1 ? n : 1);
+        return 1;
+    }
+    if (PyArray_IS_F_CONTIGUOUS(ap)) {
+        *trans = CblasTrans;
+        *lda = (int)(m > 1 ? m : 1);
+        return 1;
+    }
+    if (s1 == itemsize && s0 >= n * itemsize && s0 / itemsize <= NPY_MAX_INT) {
+        *trans = CblasNoTrans;
+        *lda = (int)(s0 / itemsize);
+        return 1;
+    }
+    if (s0 == itemsize && s1 >= m * itemsize && s1 / itemsize <= NPY_MAX_INT) {
+        *trans = CblasTrans;
+        *lda = (int)(s1 / itemsize);
+        return 1;
+    }
+    return 0;
+}
+
 /*
  * dot(a,b)
  * Returns the dot product of a and b for arrays of floating point types.
@@ -537,9 +579,10 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
         /* Matrix vector multiplication -- Level 2 BLAS */
         /* lda must be MAX(M,1) */
         enum CBLAS_ORDER Order;
+        enum CBLAS_TRANSPOSE Trans1;
         int ap2s;
 
-        if (!PyArray_ISONESEGMENT(ap1)) {
+        if (!_select_blas_layout(ap1, &Trans1, &lda)) {
             PyObject *new;
             new = PyArray_Copy(ap1);
             Py_DECREF(ap1);
@@ -547,16 +590,11 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
             if (new == NULL) {
                 goto fail;
             }
+            /* a fresh copy is C contiguous */
+            _select_blas_layout(ap1, &Trans1, &lda);
         }
         NPY_BEGIN_ALLOW_THREADS
-        if (PyArray_ISCONTIGUOUS(ap1)) {
-            Order = CblasRowMajor;
-            lda = (PyArray_DIM(ap1, 1) > 1 ? PyArray_DIM(ap1, 1) : 1);
-        }
-        else {
-            Order = CblasColMajor;
-            lda = (PyArray_DIM(ap1, 0) > 1 ? PyArray_DIM(ap1, 0) : 1);
-        }
+        Order = (Trans1 == CblasNoTrans) ? CblasRowMajor : CblasColMajor;
         ap2s = PyArray_STRIDE(ap2, 0) / PyArray_ITEMSIZE(ap2);
         gemv(typenum, Order, CblasNoTrans, ap1, lda, ap2, ap2s, out_buf);
         NPY_END_ALLOW_THREADS;
@@ -564,9 +602,10 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
     else if (ap1shape != _matrix && ap2shape == _matrix) {
         /* Vector matrix multiplication -- Level 2 BLAS */
         enum CBLAS_ORDER Order;
+        enum CBLAS_TRANSPOSE Trans2;
         int ap1s;
 
-        if (!PyArray_ISONESEGMENT(ap2)) {
+        if (!_select_blas_layout(ap2, &Trans2, &lda)) {
             PyObject *new;
             new = PyArray_Copy(ap2);
             Py_DECREF(ap2);
@@ -574,16 +613,11 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
             if (new == NULL) {
                 goto fail;
             }
+            /* a fresh copy is C contiguous */
+            _select_blas_layout(ap2, &Trans2, &lda);
         }
         NPY_BEGIN_ALLOW_THREADS
-        if (PyArray_ISCONTIGUOUS(ap2)) {
-            Order = CblasRowMajor;
-            lda = (PyArray_DIM(ap2, 1) > 1 ? PyArray_DIM(ap2, 1) : 1);
-        }
-        else {
-            Order = CblasColMajor;
-            lda = (PyArray_DIM(ap2, 0) > 1 ? PyArray_DIM(ap2, 0) : 1);
-        }
+        Order = (Trans2 == CblasNoTrans) ? CblasRowMajor : CblasColMajor;
         if (ap1shape == _row) {
             ap1s = PyArray_STRIDE(ap1, 1) / PyArray_ITEMSIZE(ap1);
         }
@@ -603,12 +637,13 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
         enum CBLAS_TRANSPOSE Trans1, Trans2;
         int M, N, L;
 
-        /* Optimization possible: */
         /*
-         * We may be able to handle single-segment arrays here
-         * using appropriate values of Order, Trans1, and Trans2.
+         * Avoid temporary copies for transposed and single-axis-strided
+         * views: anything with one contiguous axis is expressed through
+         * the transpose flags and leading dimensions, and only operands
+         * strided along both axes are copied.
          */
-        if (!PyArray_IS_C_CONTIGUOUS(ap2) && !PyArray_IS_F_CONTIGUOUS(ap2)) {
+        if (!_select_blas_layout(ap2, &Trans2, &ldb)) {
             PyObject *new = PyArray_Copy(ap2);
 
             Py_DECREF(ap2);
@@ -616,8 +651,10 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
             if (new == NULL) {
                 goto fail;
             }
+            /* a fresh copy is C contiguous */
+            _select_blas_layout(ap2, &Trans2, &ldb);
         }
-        if (!PyArray_IS_C_CONTIGUOUS(ap1) && !PyArray_IS_F_CONTIGUOUS(ap1)) {
+        if (!_select_blas_layout(ap1, &Trans1, &lda)) {
             PyObject *new = PyArray_Copy(ap1);
 
             Py_DECREF(ap1);
@@ -625,30 +662,15 @@ cblas_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
             if (new == NULL) {
                 goto fail;
             }
+            _select_blas_layout(ap1, &Trans1, &lda);
         }
 
         NPY_BEGIN_ALLOW_THREADS;
 
         Order = CblasRowMajor;
-        Trans1 = CblasNoTrans;
-        Trans2 = CblasNoTrans;
         L = PyArray_DIM(ap1, 0);
         N = PyArray_DIM(ap2, 1);
         M = PyArray_DIM(ap2, 0);
-        lda = (PyArray_DIM(ap1, 1) > 1 ? PyArray_DIM(ap1, 1) : 1);
-        ldb = (PyArray_DIM(ap2, 1) > 1 ? PyArray_DIM(ap2, 1) : 1);
-
-        /*
-         * Avoid temporary copies for arrays in Fortran order
-         */
-        if (PyArray_IS_F_CONTIGUOUS(ap1)) {
-            Trans1 = CblasTrans;
-            lda = (PyArray_DIM(ap1, 0) > 1 ? PyArray_DIM(ap1, 0) : 1);
-        }
-        if (PyArray_IS_F_CONTIGUOUS(ap2)) {
-            Trans2 = CblasTrans;
-            ldb = (PyArray_DIM(ap2, 0) > 1 ? PyArray_DIM(ap2, 0) : 1);
-        }
 
         /*
          * Use syrk if we have a case of a matrix times its transpose.
@@ -694,3 +716,180 @@ fail:
     Py_XDECREF(result);
     return NULL;
 }
+
+
+/*
+ * Block size, in output rows, for the fused product below. gemm is
+ * issued one block at a time and the epilogue runs over each block
+ * right away, while it is still cache resident, instead of making one
+ * more full pass over the output per follow-up operation.
+ */
+#define FUSED_BLOCK_ROWS 128
+
+/*
+ * out = activation(dot(a, b) + bias)
+ *
+ * Fused dense-layer product. It is assumed on entry that ap1 and ap2
+ * are 2-d arrays of the type given by typenum, which is float or
+ * double, and that bias is either NULL or a contiguous 1-d array of
+ * the same type. activation is one of the NPY_FUSED_ACT_* constants.
+ * Like cblas_matrixproduct, references to ap1, ap2 and bias are
+ * consumed.
+ */
+NPY_NO_EXPORT PyObject *
+cblas_fused_matrixproduct(int typenum, PyArrayObject *ap1, PyArrayObject *ap2,
+                          PyArrayObject *bias, int activation)
+{
+    PyArrayObject *result = NULL, *out_buf = NULL;
+    enum CBLAS_TRANSPOSE Trans1, Trans2;
+    npy_intp dimensions[2], i0, i, j;
+    int lda, ldb, ldc, L, N, M;
+
+    assert(typenum == NPY_FLOAT || typenum == NPY_DOUBLE);
+
+    if (_bad_strides(ap1)) {
+            PyObject *op1 = PyArray_NewCopy(ap1, NPY_ANYORDER);
+
+            Py_DECREF(ap1);
+            ap1 = (PyArrayObject *)op1;
+            if (ap1 == NULL) {
+                goto fail;
+            }
+    }
+    if (_bad_strides(ap2)) {
+            PyObject *op2 = PyArray_NewCopy(ap2, NPY_ANYORDER);
+
+            Py_DECREF(ap2);
+            ap2 = (PyArrayObject *)op2;
+            if (ap2 == NULL) {
+                goto fail;
+            }
+    }
+
+    if (PyArray_DIM(ap2, 0) != PyArray_DIM(ap1, 1)) {
+        dot_alignment_error(ap1, 1, ap2, 0);
+        goto fail;
+    }
+    if (bias != NULL && PyArray_DIM(bias, 0) != PyArray_DIM(ap2, 1)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "bias must have one entry per output column");
+        goto fail;
+    }
+
+    dimensions[0] = PyArray_DIM(ap1, 0);
+    dimensions[1] = PyArray_DIM(ap2, 1);
+    out_buf = new_array_for_sum(ap1, ap2, NULL, 2, dimensions, typenum,
+                                &result);
+    if (out_buf == NULL) {
+        goto fail;
+    }
+    memset(PyArray_DATA(out_buf), 0, PyArray_NBYTES(out_buf));
+    if (PyArray_SIZE(out_buf) == 0) {
+        Py_DECREF(ap1);
+        Py_DECREF(ap2);
+        Py_XDECREF(bias);
+        Py_DECREF(out_buf);
+        return PyArray_Return(result);
+    }
+
+    if (!_select_blas_layout(ap2, &Trans2, &ldb)) {
+        PyObject *new = PyArray_Copy(ap2);
+
+        Py_DECREF(ap2);
+        ap2 = (PyArrayObject *)new;
+        if (new == NULL) {
+            goto fail;
+        }
+        /* a fresh copy is C contiguous */
+        _select_blas_layout(ap2, &Trans2, &ldb);
+    }
+    if (!_select_blas_layout(ap1, &Trans1, &lda)) {
+        PyObject *new = PyArray_Copy(ap1);
+
+        Py_DECREF(ap1);
+        ap1 = (PyArrayObject *)new;
+        if (new == NULL) {
+            goto fail;
+        }
+        _select_blas_layout(ap1, &Trans1, &lda);
+    }
+
+    L = (int)dimensions[0];
+    N = (int)dimensions[1];
+    M = (int)PyArray_DIM(ap2, 0);
+    ldc = N > 1 ? N : 1;
+
+    NPY_BEGIN_ALLOW_THREADS;
+    for (i0 = 0; i0 < L; i0 += FUSED_BLOCK_ROWS) {
+        int bl = (int)(L - i0 > FUSED_BLOCK_ROWS ? FUSED_BLOCK_ROWS : L - i0);
+        /* row i0 of a is i0*lda elements in, or i0 if a is transposed */
+        npy_intp a_off = (Trans1 == CblasNoTrans) ? i0 * (npy_intp)lda : i0;
+
+        if (typenum == NPY_DOUBLE) {
+            double *c = (double *)PyArray_DATA(out_buf) + i0 * ldc;
+            const double *bv =
+                    bias ? (const double *)PyArray_DATA(bias) : NULL;
+
+            if (M > 0) {
+                cblas_dgemm(CblasRowMajor, Trans1, Trans2, bl, N, M, 1.,
+                            (double *)PyArray_DATA(ap1) + a_off, lda,
+                            (double *)PyArray_DATA(ap2), ldb, 0., c, ldc);
+            }
+            for (i = 0; i < bl; i++, c += ldc) {
+                if (bv != NULL) {
+                    for (j = 0; j < N; j++) {
+                        c[j] += bv[j];
+                    }
+                }
+                if (activation == NPY_FUSED_ACT_RELU) {
+                    for (j = 0; j < N; j++) {
+                        if (c[j] < 0.) {
+                            c[j] = 0.;
+                        }
+                    }
+                }
+            }
+        }
+        else {
+            float *c = (float *)PyArray_DATA(out_buf) + i0 * ldc;
+            const float *bv =
+                    bias ? (const float *)PyArray_DATA(bias) : NULL;
+
+            if (M > 0) {
+                cblas_sgemm(CblasRowMajor, Trans1, Trans2, bl, N, M, 1.f,
+                            (float *)PyArray_DATA(ap1) + a_off, lda,
+                            (float *)PyArray_DATA(ap2), ldb, 0.f, c, ldc);
+            }
+            for (i = 0; i < bl; i++, c += ldc) {
+                if (bv != NULL) {
+                    for (j = 0; j < N; j++) {
+                        c[j] += bv[j];
+                    }
+                }
+                if (activation == NPY_FUSED_ACT_RELU) {
+                    for (j = 0; j < N; j++) {
+                        if (c[j] < 0.f) {
+                            c[j] = 0.f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    NPY_END_ALLOW_THREADS;
+
+    Py_DECREF(ap1);
+    Py_DECREF(ap2);
+    Py_XDECREF(bias);
+    Py_DECREF(out_buf);
+
+    return PyArray_Return(result);
+
+fail:
+    Py_XDECREF(ap1);
+    Py_XDECREF(ap2);
+    Py_XDECREF(bias);
+    Py_XDECREF(out_buf);
+    Py_XDECREF(result);
+    return NULL;
+}
@@ -4,4 +4,14 @@
 NPY_NO_EXPORT PyObject *
 cblas_matrixproduct(int, PyArrayObject *, PyArrayObject *, PyArrayObject *);
 
+/* epilogue activations understood by cblas_fused_matrixproduct */
+enum {
+    NPY_FUSED_ACT_NONE = 0,
+    NPY_FUSED_ACT_RELU = 1
+};
+
+NPY_NO_EXPORT PyObject *
+cblas_fused_matrixproduct(int, PyArrayObject *, PyArrayObject *,
+                          PyArrayObject *, int);
+
 #endif
@@ -847,4 +847,50 @@ PyArray_EQUIVALENTLY_ITERABLE_OVERLAP_OK(PyArrayObject *arr1, PyArrayObject *arr
                     stride3 = PyArray_TRIVIAL_PAIR_ITERATION_STRIDE(size3, arr3); \
                 }
 
+/*
+ * The quad variant builds on the triple check for the first three arrays
+ * and only needs to verify that the fourth one iterates equivalently to
+ * the first non-0-d array of the three (or is itself 0-d/trivial).
+ */
+#define PyArray_TRIVIALLY_ITERABLE_QUAD(arr1, arr2, arr3, arr4, arr1_read, arr2_read, arr3_read, arr4_read) ( \
+                PyArray_TRIVIALLY_ITERABLE_TRIPLE(arr1, arr2, arr3, arr1_read, arr2_read, arr3_read) && \
+                    (PyArray_NDIM(arr4) == 0 || \
+                     (PyArray_NDIM(arr1) != 0 && \
+                        PyArray_EQUIVALENTLY_ITERABLE_BASE(arr1, arr4) \
+                     ) || \
+                     (PyArray_NDIM(arr1) == 0 && \
+                        PyArray_NDIM(arr2) != 0 && \
+                        PyArray_EQUIVALENTLY_ITERABLE_BASE(arr2, arr4) \
+                     ) || \
+                     (PyArray_NDIM(arr1) == 0 && \
+                        PyArray_NDIM(arr2) == 0 && \
+                        PyArray_TRIVIALLY_ITERABLE(arr4) \
+                     ) \
+                    ) && \
+                    PyArray_EQUIVALENTLY_ITERABLE_OVERLAP_OK(arr1, arr4, arr1_read, arr4_read) && \
+                    PyArray_EQUIVALENTLY_ITERABLE_OVERLAP_OK(arr2, arr4, arr2_read, arr4_read) && \
+                    PyArray_EQUIVALENTLY_ITERABLE_OVERLAP_OK(arr3, arr4, arr3_read, arr4_read) \
+                )
+
+#define PyArray_PREPARE_TRIVIAL_QUAD_ITERATION(arr1, arr2, arr3, arr4, \
+                                        count, \
+                                        data1, data2, data3, data4, \
+                                        stride1, stride2, stride3, stride4) { \
+                    npy_intp size1 = PyArray_SIZE(arr1); \
+                    npy_intp size2 = PyArray_SIZE(arr2); \
+                    npy_intp size3 = PyArray_SIZE(arr3); \
+                    npy_intp size4 = PyArray_SIZE(arr4); \
+                    count = ((size1 > size2) || size1 == 0) ? size1 : size2; \
+                    count = ((size3 > count) || size3 == 0) ? size3 : count; \
+                    count = ((size4 > count) || size4 == 0) ? size4 : count; \
+                    data1 = PyArray_BYTES(arr1); \
+                    data2 = PyArray_BYTES(arr2); \
+                    data3 = PyArray_BYTES(arr3); \
+                    data4 = PyArray_BYTES(arr4); \
+                    stride1 = PyArray_TRIVIAL_PAIR_ITERATION_STRIDE(size1, arr1); \
+                    stride2 = PyArray_TRIVIAL_PAIR_ITERATION_STRIDE(size2, arr2); \
+                    stride3 = PyArray_TRIVIAL_PAIR_ITERATION_STRIDE(size3, arr3); \
+                    stride4 = PyArray_TRIVIAL_PAIR_ITERATION_STRIDE(size4, arr4); \
+                }
+
 #endif
@@ -695,16 +695,28 @@ get_array_memory_extents(PyArrayObject *arr,
 {
     npy_intp low, upper;
     int j;
-    offset_bounds_from_strides(PyArray_ITEMSIZE(arr), PyArray_NDIM(arr),
-                               PyArray_DIMS(arr), PyArray_STRIDES(arr),
-                               &low, &upper);
-    *out_start = (npy_uintp)PyArray_DATA(arr) + (npy_uintp)low;
-    *out_end = (npy_uintp)PyArray_DATA(arr) + (npy_uintp)upper;
 
     *num_bytes = PyArray_ITEMSIZE(arr);
     for (j = 0; j < PyArray_NDIM(arr); ++j) {
         *num_bytes *= PyArray_DIM(arr, j);
     }
+
+    /*
+     * A contiguous array occupies exactly [data, data + num_bytes);
+     * skip the per-stride bounds scan for this common case.
+     */
+    if (PyArray_CHKFLAGS(arr, NPY_ARRAY_C_CONTIGUOUS) ||
+            PyArray_CHKFLAGS(arr, NPY_ARRAY_F_CONTIGUOUS)) {
+        *out_start = (npy_uintp)PyArray_DATA(arr);
+        *out_end = *out_start + *num_bytes;
+        return;
+    }
+
+    offset_bounds_from_strides(PyArray_ITEMSIZE(arr), PyArray_NDIM(arr),
+                               PyArray_DIMS(arr), PyArray_STRIDES(arr),
+                               &low, &upper);
+    *out_start = (npy_uintp)PyArray_DATA(arr) + (npy_uintp)low;
+    *out_end = (npy_uintp)PyArray_DATA(arr) + (npy_uintp)upper;
 }
 
 
@@ -772,6 +784,29 @@ solve_may_share_memory(PyArrayObject *a, PyArrayObject *b,
         return MEM_OVERLAP_NO;
     }
 
+    /*
+     * Identical layouts trivially share every element; answering here
+     * keeps self-pairs and duplicate views out of the solver.  The
+     * extents above are nonempty, so both arrays have elements.
+     */
+    if (a == b) {
+        return MEM_OVERLAP_YES;
+    }
+    if (PyArray_DATA(a) == PyArray_DATA(b) &&
+            PyArray_NDIM(a) == PyArray_NDIM(b)) {
+        int j;
+
+        for (j = 0; j < PyArray_NDIM(a); ++j) {
+            if (PyArray_DIM(a, j) != PyArray_DIM(b, j) ||
+                    PyArray_STRIDE(a, j) != PyArray_STRIDE(b, j)) {
+                break;
+            }
+        }
+        if (j == PyArray_NDIM(a)) {
+            return MEM_OVERLAP_YES;
+        }
+    }
+
     if (max_work == 0) {
         /* Too much work required, give up */
         return MEM_OVERLAP_TOO_HARD;
@@ -0,0 +1,95 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include <numpy/ndarraytypes.h>
+#include "npy_config.h"
+
+#include "npy_arena.h"
+
+/* only use the cache when real thread-local storage is available */
+#if defined(HAVE___THREAD) || defined(HAVE___DECLSPEC_THREAD_)
+#define NPY_SCRATCH_CACHE 1
+#endif
+
+#define NPY_SCRATCH_SLOTS 4 /* blocks kept per thread */
+#define NPY_SCRATCH_MAX_BYTES 0x100000 /* largest block kept per slot */
+
+/*
+ * Every scratch block is allocated with a 16 byte header recording its
+ * capacity, so a freed block can be matched against later requests.
+ * 16 bytes keeps the payload aligned as strongly as the allocator did.
+ */
+typedef struct {
+    npy_uintp capacity;
+    npy_uintp reserved;
+} scratch_header;
+
+#ifdef NPY_SCRATCH_CACHE
+static NPY_TLS void *scratch_slots[NPY_SCRATCH_SLOTS];
+#endif
+
+NPY_NO_EXPORT void *
+npy_scratch_alloc(npy_uintp size)
+{
+    scratch_header *h;
+
+#ifdef NPY_SCRATCH_CACHE
+    {
+        int i;
+        /* take the smallest cached block which covers the request */
+        int best = -1;
+        npy_uintp best_capacity = 0;
+        for (i = 0; i < NPY_SCRATCH_SLOTS; i++) {
+            if (scratch_slots[i] != NULL) {
+                npy_uintp capacity =
+                        ((scratch_header *)scratch_slots[i])->capacity;
+                if (capacity >= size &&
+                        (best < 0 || capacity < best_capacity)) {
+                    best = i;
+                    best_capacity = capacity;
+                }
+            }
+        }
+        if (best >= 0) {
+            h = (scratch_header *)scratch_slots[best];
+            scratch_slots[best] = NULL;
+            return (char *)h + sizeof(scratch_header);
+        }
+    }
+#endif
+
+    h = PyArray_malloc(sizeof(scratch_header) + size);
+    if (h == NULL) {
+        return NULL;
+    }
+    h->capacity = size;
+    h->reserved = 0;
+    return (char *)h + sizeof(scratch_header);
+}
+
+NPY_NO_EXPORT void
+npy_scratch_free(void *p)
+{
+    scratch_header *h;
+
+    if (p == NULL) {
+        return;
+    }
+    h = (scratch_header *)((char *)p - sizeof(scratch_header));
+
+#ifdef NPY_SCRATCH_CACHE
+    if (h->capacity <= NPY_SCRATCH_MAX_BYTES) {
+        int i;
+        for (i = 0; i < NPY_SCRATCH_SLOTS; i++) {
+            if (scratch_slots[i] == NULL) {
+                scratch_slots[i] = h;
+                return;
+            }
+        }
+    }
+#endif
+
+    PyArray_free(h);
+}
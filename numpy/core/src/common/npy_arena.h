@@ -0,0 +1,25 @@
+#ifndef NPY_ARENA_H
+#define NPY_ARENA_H
+
+#include <numpy/npy_common.h>
+
+/*
+ * Thread-local recycling of iterator-internal scratch blocks.
+ *
+ * Buffered iterators allocate and free their working buffers at a very
+ * high rate, and these blocks are too short-lived for the heap to keep
+ * tidy.  Each thread keeps the last few freed scratch blocks and hands
+ * them back out instead of calling malloc again.  Both functions are
+ * safe to call without the GIL; the cache is purely thread-local.
+ *
+ * On platforms without thread-local storage support the functions
+ * degrade to plain PyArray_malloc/PyArray_free.
+ */
+
+NPY_NO_EXPORT void *
+npy_scratch_alloc(npy_uintp size);
+
+NPY_NO_EXPORT void
+npy_scratch_free(void *p);
+
+#endif
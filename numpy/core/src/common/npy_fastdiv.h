@@ -0,0 +1,117 @@
+#ifndef NPY_FASTDIV_H
+#define NPY_FASTDIV_H
+
+#include <assert.h>
+
+#include <numpy/npy_common.h>
+
+/*
+ * Division of an unsigned value by a runtime-constant divisor through a
+ * precomputed multiply-shift reciprocal (Granlund & Montgomery, as used
+ * by libdivide).  Hot loops that repeatedly divide by the same value,
+ * like the flat-index unraveling in PyArray_ITER_GOTO1D, can hoist the
+ * reciprocal computation out of the loop and replace the hardware
+ * divide per element with a high multiply and a shift.
+ */
+
+typedef struct {
+    npy_uintp mul;      /* magic multiplier, 0 for a power of two */
+    npy_uint8 shift;    /* final right shift */
+    npy_uint8 add;      /* whether the n-q fixup step is needed */
+} npy_fastdiv;
+
+/* The high half of the NPY_BITSOF_INTP-bit product of 'a' and 'b' */
+static NPY_INLINE npy_uintp
+npy_fastdiv_mulhi(npy_uintp a, npy_uintp b)
+{
+#if defined(__SIZEOF_INT128__) && NPY_SIZEOF_INTP == 8
+    return (npy_uintp)(((unsigned __int128)a * b) >> 64);
+#elif NPY_SIZEOF_INTP == 4
+    return (npy_uintp)(((npy_uint64)a * b) >> 32);
+#else
+    const npy_uintp half = NPY_BITSOF_INTP / 2;
+    const npy_uintp mask = ((npy_uintp)1 << half) - 1;
+    npy_uintp alo = a & mask, ahi = a >> half;
+    npy_uintp blo = b & mask, bhi = b >> half;
+    npy_uintp mid = ahi*blo + ((alo*blo) >> half);
+    npy_uintp mid2 = alo*bhi + (mid & mask);
+
+    return ahi*bhi + (mid >> half) + (mid2 >> half);
+#endif
+}
+
+/*
+ * Precompute the reciprocal for dividing by 'd', which must be > 0.
+ * Valid for any dividend that fits in an npy_uintp.
+ */
+static NPY_INLINE void
+npy_fastdiv_init(npy_fastdiv *fd, npy_uintp d)
+{
+    npy_uintp q = 0, r = 0, twice_r;
+    int L = 0, i, qbit, carry;
+
+    assert(d > 0);
+
+    if ((d & (d - 1)) == 0) {
+        /* power of two, a plain shift */
+        fd->mul = 0;
+        fd->add = 0;
+        fd->shift = 0;
+        while (d > 1) {
+            fd->shift++;
+            d >>= 1;
+        }
+        return;
+    }
+
+    while (((npy_uintp)1 << (L + 1)) < d) {
+        L++;
+    }
+
+    /*
+     * Long division of 2^(NPY_BITSOF_INTP + L) by d, bit by bit from
+     * the top; the remainder doubling is kept exact by treating a
+     * carried-out bit as making the remainder bigger than d.
+     */
+    for (i = NPY_BITSOF_INTP + L; i >= 0; i--) {
+        carry = (int)(r >> (NPY_BITSOF_INTP - 1));
+        r = (r << 1) | (i == NPY_BITSOF_INTP + L);
+        qbit = 0;
+        if (carry || r >= d) {
+            r -= d;
+            qbit = 1;
+        }
+        q = (q << 1) | qbit;
+    }
+
+    if (d - r < ((npy_uintp)1 << L)) {
+        /* rounding the reciprocal up covers every dividend */
+        fd->mul = q + 1;
+        fd->add = 0;
+    }
+    else {
+        /* doubled-precision reciprocal with the n-q fixup */
+        twice_r = 2*r;
+        fd->mul = 2*q + 1 + (twice_r >= d || twice_r < r);
+        fd->add = 1;
+    }
+    fd->shift = (npy_uint8)L;
+}
+
+/* Computes n / d for the divisor 'fd' was initialized with */
+static NPY_INLINE npy_uintp
+npy_fastdiv_divide(npy_uintp n, const npy_fastdiv *fd)
+{
+    npy_uintp q;
+
+    if (fd->mul == 0) {
+        return n >> fd->shift;
+    }
+    q = npy_fastdiv_mulhi(fd->mul, n);
+    if (fd->add) {
+        q += (n - q) >> 1;
+    }
+    return q >> fd->shift;
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef NPY_NONTEMPORAL_H
+#define NPY_NONTEMPORAL_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <numpy/npy_common.h>
+
+#if defined(NPY_HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Non-temporal (streaming) stores for huge contiguous copies and fills.
+ * Destinations much larger than the last-level cache will not be read
+ * back from cache anyway, so writing them with regular stores only
+ * evicts useful data.  Above the threshold the helpers below write
+ * through movntdq instead, bypassing the cache entirely.
+ */
+
+/*
+ * Returns the destination size in bytes above which streaming stores
+ * are used, from NPY_NONTEMPORAL_THRESHOLD.  A value <= 0 (and the
+ * default of 32MB when the variable is unset, a size safely beyond
+ * typical last-level caches, can be lowered or raised to match the
+ * machine) disables them when set to 0 or less.
+ */
+static NPY_INLINE npy_intp
+npy_nontemporal_threshold(void)
+{
+    static npy_intp threshold = -2;
+
+    if (threshold == -2) {
+        char *env = getenv("NPY_NONTEMPORAL_THRESHOLD");
+        threshold = 0x2000000;
+        if (env != NULL && env[0] != '\0') {
+            threshold = (npy_intp)strtol(env, NULL, 10);
+        }
+    }
+    return threshold;
+}
+
+/*
+ * Copies 'n' bytes from 'src' to 'dst' with streaming stores if the
+ * copy is large enough and the platform supports them.  Returns 1 if
+ * the copy was done, 0 if the caller should copy normally (too small,
+ * overlapping, or no streaming stores available).
+ */
+static NPY_INLINE int
+npy_try_nontemporal_memcpy(char *dst, const char *src, npy_intp n)
+{
+#if defined(NPY_HAVE_SSE2_INTRINSICS)
+    npy_intp threshold = npy_nontemporal_threshold();
+    npy_intp head;
+
+    if (threshold <= 0 || n < threshold) {
+        return 0;
+    }
+    /* streaming stores go forward, overlap needs memmove semantics */
+    if ((src < dst && src + n > dst) || (dst < src && dst + n > src)) {
+        return 0;
+    }
+
+    /* align the destination for movntdq */
+    head = (npy_intp)(-(npy_uintp)dst & 0xf);
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    n -= head;
+
+    while (n >= 64) {
+        __m128i a = _mm_loadu_si128((const __m128i *)src);
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+        _mm_stream_si128((__m128i *)dst, a);
+        _mm_stream_si128((__m128i *)(dst + 16), b);
+        _mm_stream_si128((__m128i *)(dst + 32), c);
+        _mm_stream_si128((__m128i *)(dst + 48), d);
+        src += 64;
+        dst += 64;
+        n -= 64;
+    }
+    /* make the streamed data globally visible before returning */
+    _mm_sfence();
+    memcpy(dst, src, n);
+
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Fills 'N' elements of size 'elsize' at 'dst' with the single element
+ * at 'src', using streaming stores.  Returns 1 if the fill was done,
+ * 0 if the caller should fill normally.  Requires an element size
+ * dividing 16 and a destination offset by a whole number of elements
+ * from 16-byte alignment.
+ */
+static NPY_INLINE int
+npy_try_nontemporal_fill(char *dst, const char *src,
+                         npy_intp elsize, npy_intp N)
+{
+#if defined(NPY_HAVE_SSE2_INTRINSICS)
+    npy_intp threshold = npy_nontemporal_threshold();
+    npy_intp n = N*elsize, head, i;
+    char pattern[16];
+    __m128i p;
+
+    if (threshold <= 0 || n < threshold) {
+        return 0;
+    }
+    if (elsize <= 0 || elsize > 16 || (16 % elsize) != 0) {
+        return 0;
+    }
+    head = (npy_intp)(-(npy_uintp)dst & 0xf);
+    if ((head % elsize) != 0) {
+        return 0;
+    }
+
+    /*
+     * Every elsize-wide slot of the vector holds the same value, so
+     * the store phase does not matter once the destination is aligned.
+     */
+    for (i = 0; i < 16; i += elsize) {
+        memcpy(pattern + i, src, elsize);
+    }
+
+    memcpy(dst, pattern, head);
+    dst += head;
+    n -= head;
+
+    p = _mm_loadu_si128((const __m128i *)pattern);
+    while (n >= 64) {
+        _mm_stream_si128((__m128i *)dst, p);
+        _mm_stream_si128((__m128i *)(dst + 16), p);
+        _mm_stream_si128((__m128i *)(dst + 32), p);
+        _mm_stream_si128((__m128i *)(dst + 48), p);
+        dst += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        _mm_stream_si128((__m128i *)dst, p);
+        dst += 16;
+        n -= 16;
+    }
+    _mm_sfence();
+    memcpy(dst, pattern, n);
+
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+#endif
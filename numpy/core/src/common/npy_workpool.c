@@ -0,0 +1,351 @@
+/*
+ * Shared worker pool for the parallel engines.
+ *
+ * The threaded sort, ufunc, assignment and file I/O engines each used
+ * to start native threads per call with the same start-or-run-inline
+ * pattern.  This module centralizes that into one lazily started pool
+ * of persistent workers with a single parallel_for entry point, so the
+ * engines share threads instead of layering their own on top of each
+ * other, and thread startup is paid once per process instead of once
+ * per call.
+ *
+ * The scheduling is deliberately simple: one region runs at a time
+ * (guarded by a pool lock), and its tasks are pulled from a shared
+ * counter by every participating thread, which balances uneven tasks
+ * the way a work-stealing scheduler would for this one-level workload.
+ * A region that arrives while another runs, or that is issued from
+ * inside a worker, detects the busy pool with a non-blocking lock
+ * probe and runs inline, so nesting cannot deadlock and cannot
+ * oversubscribe.
+ *
+ * Workers are plain pythread threads and never touch the Python API;
+ * callers must ensure the task bodies cannot call back into Python.
+ */
+#include <Python.h>
+#include "pythread.h"
+
+#include <stdlib.h>
+
+#include "npy_config.h"
+#include "numpy/ndarraytypes.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+#ifndef _WIN32
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+#include "npy_workpool.h"
+
+/* upper bound for the pool, matching the per-engine thread caps */
+#define NPY_WORKPOOL_MAX_THREADS 128
+
+typedef struct {
+    /* released by the dispatcher to start a round */
+    PyThread_type_lock go;
+    /* released by the worker when its round is finished */
+    PyThread_type_lock done;
+} npy_workpool_worker;
+
+static npy_workpool_worker workers[NPY_WORKPOOL_MAX_THREADS];
+static int nworkers_started = 0;
+
+/* serializes parallel regions; busy probe doubles as nesting detection */
+static PyThread_type_lock pool_lock = NULL;
+/* protects the shared task counter of the running region */
+static PyThread_type_lock task_lock = NULL;
+
+/* the running region; valid while pool_lock is held */
+static npy_parallel_func *job_func;
+static void *job_arg;
+static npy_intp job_next;
+static npy_intp job_ntasks;
+
+/* process-wide thread cap; <= 0 means no cap */
+static int global_max_threads = 0;
+/* per-thread cap; <= 0 means no cap */
+static NPY_TLS int thread_max_threads = 0;
+/* set while the calling thread executes the body of a region */
+static NPY_TLS int in_parallel_region = 0;
+/* -1 until the NPY_DETERMINISTIC environment variable was consulted */
+static int deterministic_mode = -1;
+
+#ifndef _WIN32
+static void
+workpool_atfork_child(void);
+#endif
+
+NPY_NO_EXPORT int
+npy_workpool_init(void)
+{
+#ifndef _WIN32
+    static int atfork_registered = 0;
+#endif
+
+    pool_lock = PyThread_allocate_lock();
+    task_lock = PyThread_allocate_lock();
+    if (pool_lock == NULL || task_lock == NULL) {
+        if (pool_lock != NULL) {
+            PyThread_free_lock(pool_lock);
+        }
+        if (task_lock != NULL) {
+            PyThread_free_lock(task_lock);
+        }
+        pool_lock = NULL;
+        task_lock = NULL;
+        return -1;
+    }
+#ifndef _WIN32
+    if (!atfork_registered) {
+        /* failure only means a forked child keeps running inline */
+        (void)pthread_atfork(NULL, NULL, workpool_atfork_child);
+        atfork_registered = 1;
+    }
+#endif
+    return 0;
+}
+
+#ifndef _WIN32
+/*
+ * After fork() the child inherits the pool's bookkeeping but none of
+ * its worker threads, and the inherited locks may be held by threads
+ * that no longer exist: the first parallel region in the child would
+ * release the go locks to nobody and block forever on done.  Reset the
+ * pool so the child lazily starts its own workers.  The stale lock
+ * objects are abandoned rather than freed, since freeing a lock that
+ * was held at fork time is not portable.
+ */
+static void
+workpool_atfork_child(void)
+{
+    int i;
+
+    for (i = 0; i < nworkers_started; i++) {
+        workers[i].go = NULL;
+        workers[i].done = NULL;
+    }
+    nworkers_started = 0;
+    pool_lock = NULL;
+    task_lock = NULL;
+    /* on failure pool_lock stays NULL and regions run inline */
+    (void)npy_workpool_init();
+}
+#endif
+
+NPY_NO_EXPORT int
+npy_workpool_size(void)
+{
+    static int size = -1;
+
+    if (size < 0) {
+        char *env = getenv("NPY_NUM_THREADS");
+        long val = 0;
+
+        if (env != NULL && env[0] != '\0') {
+            val = strtol(env, NULL, 10);
+        }
+        if (val <= 0) {
+#ifdef __linux__
+            cpu_set_t set;
+
+            if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+                val = CPU_COUNT(&set);
+            }
+#endif
+#ifdef _SC_NPROCESSORS_ONLN
+            if (val <= 0) {
+                val = (long)sysconf(_SC_NPROCESSORS_ONLN);
+            }
+#endif
+        }
+        if (val < 1) {
+            val = 1;
+        }
+        if (val > NPY_WORKPOOL_MAX_THREADS) {
+            val = NPY_WORKPOOL_MAX_THREADS;
+        }
+        size = (int)val;
+    }
+    return size;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_get_max_threads(void)
+{
+    int limit = npy_workpool_size();
+
+    if (global_max_threads > 0 && global_max_threads < limit) {
+        limit = global_max_threads;
+    }
+    if (thread_max_threads > 0 && thread_max_threads < limit) {
+        limit = thread_max_threads;
+    }
+    return limit;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_set_max_threads(int nthreads)
+{
+    int prev = global_max_threads;
+
+    global_max_threads = (nthreads > 0) ? nthreads : 0;
+    return prev;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_set_thread_limit(int nthreads)
+{
+    int prev = thread_max_threads;
+
+    thread_max_threads = (nthreads > 0) ? nthreads : 0;
+    return prev;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_deterministic(void)
+{
+    if (deterministic_mode < 0) {
+        char *env = getenv("NPY_DETERMINISTIC");
+
+        deterministic_mode = (env != NULL && env[0] != '\0' &&
+                              strcmp(env, "0") != 0);
+    }
+    return deterministic_mode;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_set_deterministic(int enable)
+{
+    int prev = npy_workpool_deterministic();
+
+    deterministic_mode = (enable != 0);
+    return prev;
+}
+
+NPY_NO_EXPORT int
+npy_workpool_in_parallel(void)
+{
+    return in_parallel_region;
+}
+
+/* Pull tasks from the shared counter until the region is drained */
+static void
+workpool_run_tasks(void)
+{
+    in_parallel_region = 1;
+    for (;;) {
+        npy_intp t;
+
+        PyThread_acquire_lock(task_lock, 1);
+        t = (job_next < job_ntasks) ? job_next++ : -1;
+        PyThread_release_lock(task_lock);
+        if (t < 0) {
+            break;
+        }
+        job_func(t, job_arg);
+    }
+    in_parallel_region = 0;
+}
+
+static void
+workpool_worker_main(void *arg)
+{
+    npy_workpool_worker *w = (npy_workpool_worker *)arg;
+
+    for (;;) {
+        PyThread_acquire_lock(w->go, 1);
+        workpool_run_tasks();
+        PyThread_release_lock(w->done);
+    }
+}
+
+/*
+ * Start workers until nworkers_started covers 'wanted', stopping early
+ * if a lock or thread cannot be created.  Called with pool_lock held.
+ */
+static void
+workpool_start_workers(int wanted)
+{
+    while (nworkers_started < wanted) {
+        npy_workpool_worker *w = &workers[nworkers_started];
+
+        w->go = PyThread_allocate_lock();
+        w->done = PyThread_allocate_lock();
+        if (w->go == NULL || w->done == NULL) {
+            goto fail;
+        }
+        /* both locks start held, the dispatcher releases go per round */
+        PyThread_acquire_lock(w->go, 1);
+        PyThread_acquire_lock(w->done, 1);
+        if (PyThread_start_new_thread(workpool_worker_main, w) == -1) {
+            PyThread_release_lock(w->go);
+            PyThread_release_lock(w->done);
+            goto fail;
+        }
+        nworkers_started++;
+    }
+    return;
+
+fail:
+    if (workers[nworkers_started].go != NULL) {
+        PyThread_free_lock(workers[nworkers_started].go);
+        workers[nworkers_started].go = NULL;
+    }
+    if (workers[nworkers_started].done != NULL) {
+        PyThread_free_lock(workers[nworkers_started].done);
+        workers[nworkers_started].done = NULL;
+    }
+}
+
+NPY_NO_EXPORT int
+npy_parallel_for(npy_intp ntasks, npy_parallel_func *func, void *arg,
+                 int max_workers)
+{
+    npy_intp t;
+    int nhelpers, i;
+
+    if (ntasks <= 0) {
+        return 1;
+    }
+    if (max_workers > npy_workpool_get_max_threads()) {
+        max_workers = npy_workpool_get_max_threads();
+    }
+    if (max_workers > ntasks) {
+        max_workers = (int)ntasks;
+    }
+    if (max_workers <= 1 || in_parallel_region || pool_lock == NULL ||
+            !PyThread_acquire_lock(pool_lock, NOWAIT_LOCK)) {
+        int saved = in_parallel_region;
+
+        in_parallel_region = 1;
+        for (t = 0; t < ntasks; t++) {
+            func(t, arg);
+        }
+        in_parallel_region = saved;
+        return 1;
+    }
+
+    workpool_start_workers(max_workers - 1);
+    nhelpers = max_workers - 1;
+    if (nhelpers > nworkers_started) {
+        nhelpers = nworkers_started;
+    }
+
+    job_func = func;
+    job_arg = arg;
+    job_next = 0;
+    job_ntasks = ntasks;
+
+    for (i = 0; i < nhelpers; i++) {
+        PyThread_release_lock(workers[i].go);
+    }
+    workpool_run_tasks();
+    for (i = 0; i < nhelpers; i++) {
+        PyThread_acquire_lock(workers[i].done, 1);
+    }
+
+    PyThread_release_lock(pool_lock);
+    return nhelpers + 1;
+}
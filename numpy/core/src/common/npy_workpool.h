@@ -0,0 +1,94 @@
+#ifndef _NPY_COMMON_WORKPOOL_H_
+#define _NPY_COMMON_WORKPOOL_H_
+
+#include <numpy/ndarraytypes.h>
+
+/*
+ * A shared pool of native worker threads for the parallel engines
+ * (threaded sorts, ufunc loops, assignment and file I/O).  The pool is
+ * started lazily on first use and the workers persist, so engines no
+ * longer spawn and tear down threads per call, and they all draw from
+ * one set of threads instead of oversubscribing each other.
+ */
+
+/* A parallel_for body; called once per task index, without the GIL. */
+typedef void (npy_parallel_func)(npy_intp task, void *arg);
+
+/*
+ * Allocate the pool bookkeeping locks.  Called once from module
+ * initialization; on failure the pool stays disabled and parallel_for
+ * runs everything inline, so the error can be ignored.
+ */
+NPY_NO_EXPORT int
+npy_workpool_init(void);
+
+/*
+ * The maximum number of threads a parallel region may use, from
+ * NPY_NUM_THREADS when set and otherwise from the processor affinity
+ * mask.  Always at least 1.
+ */
+NPY_NO_EXPORT int
+npy_workpool_size(void);
+
+/*
+ * The effective thread limit for a region issued from the calling
+ * thread: the pool size further clamped by the process-wide and
+ * per-thread caps below.  Always at least 1.
+ */
+NPY_NO_EXPORT int
+npy_workpool_get_max_threads(void);
+
+/*
+ * Cap the number of threads any parallel region may use, process wide.
+ * A value <= 0 removes the cap.  Returns the previous cap (0 if none
+ * was set).
+ */
+NPY_NO_EXPORT int
+npy_workpool_set_max_threads(int nthreads);
+
+/*
+ * Cap the number of threads for regions issued from the calling thread
+ * only; the cap is thread-local, so pinning one thread to 1 does not
+ * affect the others.  A value <= 0 removes the cap.  Returns the
+ * previous cap (0 if none was set).
+ */
+NPY_NO_EXPORT int
+npy_workpool_set_thread_limit(int nthreads);
+
+/*
+ * Nonzero when deterministic mode is on, from NPY_DETERMINISTIC or the
+ * setter below.  In this mode the parallel engines must plan their
+ * chunking from the problem size alone, never from the thread count,
+ * so that reruns are bit identical whatever the machine's parallelism.
+ */
+NPY_NO_EXPORT int
+npy_workpool_deterministic(void);
+
+/* Set or clear deterministic mode; returns the previous setting. */
+NPY_NO_EXPORT int
+npy_workpool_set_deterministic(int enable);
+
+/*
+ * Nonzero while the calling thread is executing the body of a parallel
+ * region, in which case a new region would run inline.
+ */
+NPY_NO_EXPORT int
+npy_workpool_in_parallel(void);
+
+/*
+ * Run func(task, arg) for every task in [0, ntasks), distributing the
+ * tasks over up to max_workers threads including the calling thread.
+ * Tasks are handed out through a shared counter, so uneven tasks
+ * balance across the workers.  Nested or concurrent regions, and any
+ * pool failure, degrade to running every task inline on the calling
+ * thread.  Returns the number of threads that participated (>= 1).
+ *
+ * The GIL is not held in the workers: func must not touch the Python
+ * API, and the caller is responsible for having released the GIL if
+ * the tasks take long enough to matter.
+ */
+NPY_NO_EXPORT int
+npy_parallel_for(npy_intp ntasks, npy_parallel_func *func, void *arg,
+                 int max_workers);
+
+#endif
@@ -32,16 +32,20 @@
 #endif
 #endif
 
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+/* raw mbind syscall, to not depend on libnuma for placement policies */
+#ifdef SYS_mbind
+#define HAVE_NPY_MBIND
+#define NPY_MPOL_BIND 2
+#define NPY_MPOL_INTERLEAVE 3
+#endif
+#endif
+
 #define NBUCKETS 1024 /* number of buckets for data*/
-#define NBUCKETS_DIM 16 /* number of buckets for dimensions/strides */
-#define NCACHE 7 /* number of cache entries per bucket */
-/* this structure fits neatly into a cacheline */
-typedef struct {
-    npy_uintp available; /* number of cached pointers */
-    void * ptrs[NCACHE];
-} cache_bucket;
 static cache_bucket datacache[NBUCKETS];
-static cache_bucket dimcache[NBUCKETS_DIM];
+NPY_NO_EXPORT cache_bucket npy_dimcache[NBUCKETS_DIM];
 
 /* as the cache is managed in global variables verify the GIL is held */
 #if defined(NPY_PY3K)
@@ -50,6 +54,228 @@ static cache_bucket dimcache[NBUCKETS_DIM];
 #define NPY_CHECK_GIL_HELD() 1
 #endif
 
+/*
+ * Allocation telemetry, kept at the cache layer where both the alloc
+ * and the free paths know the block size.  Live and peak bytes cover
+ * blocks obtained through npy_alloc_cache/npy_alloc_cache_zero and
+ * returned through npy_free_cache; the dimension cache is excluded.
+ * The counters are plain integers updated under the GIL, so keeping
+ * them always on costs a handful of increments per allocation.
+ */
+NPY_NO_EXPORT npy_alloc_stats npy_alloc_telemetry;
+
+/* account one successful allocation of sz bytes */
+static NPY_INLINE void
+_npy_stats_count_alloc(npy_uintp sz)
+{
+    npy_uintp s = sz;
+    int b = 0;
+
+    while (s > 1 && b < NPY_ALLOC_STATS_BINS - 1) {
+        s >>= 1;
+        b++;
+    }
+    npy_alloc_telemetry.hist[b]++;
+    npy_alloc_telemetry.live_bytes += sz;
+    if (npy_alloc_telemetry.live_bytes > npy_alloc_telemetry.peak_bytes) {
+        npy_alloc_telemetry.peak_bytes = npy_alloc_telemetry.live_bytes;
+    }
+}
+
+/* account the release of a block of sz bytes */
+static NPY_INLINE void
+_npy_stats_count_free(npy_uintp sz)
+{
+    /*
+     * PyDataMem_RENEW bypasses this layer, so a resized block comes
+     * back with a size different from the one it was requested with;
+     * clamp rather than let the counter wrap around.
+     */
+    if (npy_alloc_telemetry.live_bytes >= sz) {
+        npy_alloc_telemetry.live_bytes -= sz;
+    }
+    else {
+        npy_alloc_telemetry.live_bytes = 0;
+    }
+}
+
+#ifdef HAVE_MADV_HUGEPAGE
+#define NPY_HUGEPAGE_SIZE (1u << 21)
+
+/*
+ * Returns the allocation size in bytes from which blocks are advised
+ * to be backed by transparent huge pages, to cut dTLB misses on large
+ * arrays.  Settable through NPY_HUGEPAGE_THRESHOLD; a value of 0 or
+ * less disables the advice, unset keeps the 4MB default.
+ */
+static NPY_INLINE npy_intp
+npy_hugepage_threshold(void)
+{
+    static npy_intp threshold = -2;
+
+    if (threshold == -2) {
+        char *env = getenv("NPY_HUGEPAGE_THRESHOLD");
+        threshold = 1u << 22u;
+        if (env != NULL && env[0] != '\0') {
+            threshold = (npy_intp)strtol(env, NULL, 10);
+        }
+    }
+    return threshold;
+}
+
+/* allow kernel allocating huge pages for large blocks */
+static NPY_INLINE void
+npy_hugepage_advise(void *p, npy_uintp n)
+{
+    npy_intp threshold = npy_hugepage_threshold();
+    if (NPY_UNLIKELY(threshold > 0 && n >= (npy_uintp)threshold)) {
+        /*
+         * advise only the whole huge pages inside the block;
+         * the kernel can only use 2MB-aligned 2MB extents
+         */
+        npy_uintp start = ((npy_uintp)p + NPY_HUGEPAGE_SIZE - 1) &
+                          ~((npy_uintp)NPY_HUGEPAGE_SIZE - 1);
+        npy_uintp end = ((npy_uintp)p + n) &
+                        ~((npy_uintp)NPY_HUGEPAGE_SIZE - 1);
+        if (end > start) {
+            madvise((void*)start, end - start, MADV_HUGEPAGE);
+        }
+    }
+}
+#endif
+
+#ifdef HAVE_NPY_MBIND
+#define NPY_NUMA_NONE 0
+#define NPY_NUMA_INTERLEAVE 1
+#define NPY_NUMA_BIND 2
+
+/* target node of the "bind:<node>" policy */
+static int npy_numa_node = -1;
+
+/*
+ * Returns the NUMA placement policy for fresh large data blocks, from
+ * NPY_NUMA_POLICY: "interleave" stripes the pages across all online
+ * nodes, "bind:<node>" places them on one node, unset leaves placement
+ * to the kernel (first touch).
+ */
+static NPY_INLINE int
+npy_numa_policy(void)
+{
+    static int policy = -1;
+
+    if (policy == -1) {
+        char *env = getenv("NPY_NUMA_POLICY");
+        policy = NPY_NUMA_NONE;
+        if (env != NULL) {
+            if (strcmp(env, "interleave") == 0) {
+                policy = NPY_NUMA_INTERLEAVE;
+            }
+            else if (strncmp(env, "bind:", 5) == 0) {
+                npy_numa_node = (int)strtol(env + 5, NULL, 10);
+                policy = NPY_NUMA_BIND;
+            }
+        }
+    }
+    return policy;
+}
+
+/*
+ * Returns the allocation size in bytes from which the placement policy
+ * is applied, from NPY_NUMA_THRESHOLD (default 16MB, 0 or less
+ * disables it).
+ */
+static NPY_INLINE npy_intp
+npy_numa_threshold(void)
+{
+    static npy_intp threshold = -2;
+
+    if (threshold == -2) {
+        char *env = getenv("NPY_NUMA_THRESHOLD");
+        threshold = 1 << 24;
+        if (env != NULL && env[0] != '\0') {
+            threshold = (npy_intp)strtol(env, NULL, 10);
+        }
+    }
+    return threshold;
+}
+
+/* highest online node id from sysfs, -1 when it cannot be determined */
+static int
+npy_numa_highest_node(void)
+{
+    static int highest = -2;
+
+    if (highest == -2) {
+        FILE *f = fopen("/sys/devices/system/node/online", "r");
+        highest = -1;
+        if (f != NULL) {
+            /* the file holds a range list such as "0-3" or "0,2-3" */
+            int node = 0, c;
+            while ((c = fgetc(f)) != EOF) {
+                if (c >= '0' && c <= '9') {
+                    node = 10*node + (c - '0');
+                }
+                else {
+                    if (node > highest) {
+                        highest = node;
+                    }
+                    node = 0;
+                }
+            }
+            if (node > highest) {
+                highest = node;
+            }
+            fclose(f);
+        }
+    }
+    return highest;
+}
+
+/*
+ * Applies the configured placement policy to a freshly allocated block
+ * whose pages have not been faulted in yet.  Placement failures are
+ * ignored; the block then simply keeps the kernel's default policy.
+ */
+static void
+npy_numa_place(void *p, npy_uintp n)
+{
+    npy_intp threshold = npy_numa_threshold();
+    int policy = npy_numa_policy();
+    int highest;
+    unsigned long mask;
+    npy_uintp start, end;
+
+    if (policy == NPY_NUMA_NONE ||
+            threshold <= 0 || n < (npy_uintp)threshold) {
+        return;
+    }
+    highest = npy_numa_highest_node();
+    if (highest < 1 || highest >= (int)(8*sizeof(mask) - 1)) {
+        /* unknown topology, a single node, or too many to mask */
+        return;
+    }
+
+    /* the policy can only apply to whole pages inside the block */
+    start = ((npy_uintp)p + 4095u) & ~((npy_uintp)4095u);
+    end = ((npy_uintp)p + n) & ~((npy_uintp)4095u);
+    if (end <= start) {
+        return;
+    }
+
+    if (policy == NPY_NUMA_INTERLEAVE) {
+        mask = (1ul << (highest + 1)) - 1ul;
+        syscall(SYS_mbind, start, end - start, NPY_MPOL_INTERLEAVE,
+                &mask, (unsigned long)(highest + 2), 0);
+    }
+    else if (npy_numa_node >= 0 && npy_numa_node <= highest) {
+        mask = 1ul << npy_numa_node;
+        syscall(SYS_mbind, start, end - start, NPY_MPOL_BIND,
+                &mask, (unsigned long)(highest + 2), 0);
+    }
+}
+#endif
+
+
 /*
  * very simplistic small memory block cache to avoid more expensive libc
  * allocations
@@ -62,12 +288,18 @@ _npy_alloc_cache(npy_uintp nelem, npy_uintp esz, npy_uint msz,
 {
     void * p;
     assert((esz == 1 && cache == datacache) ||
-           (esz == sizeof(npy_intp) && cache == dimcache));
+           (esz == sizeof(npy_intp) && cache == npy_dimcache));
     assert(NPY_CHECK_GIL_HELD());
     if (nelem < msz) {
         if (cache[nelem].available > 0) {
+            if (cache == datacache) {
+                npy_alloc_telemetry.data_hits++;
+            }
             return cache[nelem].ptrs[--(cache[nelem].available)];
         }
+        if (cache == datacache) {
+            npy_alloc_telemetry.data_misses++;
+        }
     }
     p = alloc(nelem * esz);
     if (p) {
@@ -75,12 +307,10 @@ _npy_alloc_cache(npy_uintp nelem, npy_uintp esz, npy_uint msz,
         _PyPyPyGC_AddMemoryPressure(nelem * esz);
 #endif
 #ifdef HAVE_MADV_HUGEPAGE
-        /* allow kernel allocating huge pages for large arrays */
-        if (NPY_UNLIKELY(nelem * esz >= ((1u<<22u)))) {
-            npy_uintp offset = 4096u - (npy_uintp)p % (4096u);
-            npy_uintp length = nelem * esz - offset;
-            madvise((void*)((npy_uintp)p + offset), length, MADV_HUGEPAGE);
-        }
+        npy_hugepage_advise(p, nelem * esz);
+#endif
+#ifdef HAVE_NPY_MBIND
+        npy_numa_place(p, nelem * esz);
 #endif
     }
     return p;
@@ -105,13 +335,258 @@ _npy_free_cache(void * p, npy_uintp nelem, npy_uint msz,
 }
 
 
+/*
+ * power-of-two size-class cache for mid-sized data blocks, sitting
+ * between the exact-size cache above and allocations large enough that
+ * the libc allocator defers to the kernel anyway.
+ *
+ * Blocks may reach npy_free_cache after a PyDataMem_RENEW shrunk or
+ * grew them to an exact size, so the freed size is only a lower bound
+ * on the usable size.  A freed block is therefore filed under the
+ * largest class that fits inside it, while allocations are served from
+ * the smallest class that covers them; a cached block is thus always at
+ * least as large as any request it is handed out for.
+ *
+ * Retention is bounded by a global byte budget, and classes that go
+ * unused for several sweeps are trimmed back one block at a time.
+ */
+#define NBIGCLASS 11 /* 1KB to 1MB in power of two classes */
+#define BIGCLASS_FIRST_SHIFT 10 /* log2 of the smallest class */
+#define BIGCLASS_SIZE(c) ((npy_uintp)1 << (BIGCLASS_FIRST_SHIFT + (c)))
+#define BIGCACHE_MAX_BYTES ((npy_uintp)1 << 24) /* total retention budget */
+#define BIGCACHE_DECAY_OPS 256 /* cache operations between decay sweeps */
+#define BIGCACHE_DECAY_AGE 4 /* unused sweeps before a class is trimmed */
+
+typedef struct {
+    npy_uintp available; /* number of cached pointers */
+    npy_uintp age; /* decay sweeps since the last hit */
+    void * ptrs[NCACHE];
+} bigcache_bucket;
+static bigcache_bucket bigcache[NBIGCLASS];
+static npy_uintp bigcache_bytes = 0;
+static npy_uintp bigcache_ops = 0;
+
+/* smallest class covering sz bytes, or -1 when sz is out of range */
+static NPY_INLINE int
+_npy_big_class_up(npy_uintp sz)
+{
+    int c = 0;
+    if (sz < NBUCKETS || sz > BIGCLASS_SIZE(NBIGCLASS - 1)) {
+        return -1;
+    }
+    while (BIGCLASS_SIZE(c) < sz) {
+        c++;
+    }
+    return c;
+}
+
+/* largest class fitting inside sz bytes, or -1 when sz is out of range */
+static NPY_INLINE int
+_npy_big_class_down(npy_uintp sz)
+{
+    int c = _npy_big_class_up(sz);
+    if (c > 0 && BIGCLASS_SIZE(c) != sz) {
+        c--;
+    }
+    return c;
+}
+
+/* release one block from every class which has gone unused */
+static void
+_npy_big_cache_decay(void)
+{
+    int c;
+    for (c = 0; c < NBIGCLASS; c++) {
+        if (bigcache[c].available == 0) {
+            continue;
+        }
+        if (++(bigcache[c].age) > BIGCACHE_DECAY_AGE) {
+            bigcache_bytes -= BIGCLASS_SIZE(c);
+            PyDataMem_FREE(bigcache[c].ptrs[--(bigcache[c].available)]);
+        }
+    }
+}
+
+static NPY_INLINE void
+_npy_big_cache_tick(void)
+{
+    if (++bigcache_ops >= BIGCACHE_DECAY_OPS) {
+        bigcache_ops = 0;
+        _npy_big_cache_decay();
+    }
+}
+
+/* returns a cached block of at least sz bytes, or NULL on a miss */
+static NPY_INLINE void *
+_npy_big_cache_pop(npy_uintp sz)
+{
+    int c = _npy_big_class_up(sz);
+
+    assert(NPY_CHECK_GIL_HELD());
+    if (c < 0) {
+        return NULL;
+    }
+    _npy_big_cache_tick();
+    if (bigcache[c].available > 0) {
+        bigcache[c].age = 0;
+        bigcache_bytes -= BIGCLASS_SIZE(c);
+        npy_alloc_telemetry.big_hits++;
+        return bigcache[c].ptrs[--(bigcache[c].available)];
+    }
+    npy_alloc_telemetry.big_misses++;
+    return NULL;
+}
+
+/* returns 1 if the block of sz bytes at p was taken into the cache */
+static NPY_INLINE int
+_npy_big_free_cache(void * p, npy_uintp sz)
+{
+    int c = _npy_big_class_down(sz);
+
+    assert(NPY_CHECK_GIL_HELD());
+    if (p == NULL || c < 0) {
+        return 0;
+    }
+    _npy_big_cache_tick();
+    if (bigcache[c].available < NCACHE &&
+            bigcache_bytes + BIGCLASS_SIZE(c) <= BIGCACHE_MAX_BYTES) {
+        bigcache[c].ptrs[bigcache[c].available++] = p;
+        bigcache_bytes += BIGCLASS_SIZE(c);
+        return 1;
+    }
+    return 0;
+}
+
+#if defined(HAVE_SYS_MMAN_H) && defined(MAP_ANONYMOUS)
+#define HAVE_NPY_LAZY_ZERO
+
+/*
+ * Lazily zeroed allocations for large zero-filled arrays.  Anonymous
+ * mmap pages are already zero and only materialize when touched, so
+ * np.zeros of a multi-GB array costs nothing until its pages are
+ * actually written.  The blocks are recorded here so that
+ * PyDataMem_FREE/RENEW can recognize them; they must be released with
+ * munmap, not through the allocator handler.
+ */
+typedef struct {
+    void *p;
+    npy_uintp len;
+} lazy_zero_block;
+static lazy_zero_block *lazy_zero_blocks = NULL;
+static npy_uintp lazy_zero_n = 0;
+static npy_uintp lazy_zero_cap = 0;
+
+/*
+ * Returns the zeroed-allocation size in bytes from which anonymous
+ * mmap pages are used, from NPY_LAZY_ZERO_THRESHOLD (default 4MB,
+ * 0 or less disables it).  Never below the size-class cache range,
+ * so mmap blocks cannot be recycled as heap blocks.
+ */
+static NPY_INLINE npy_intp
+npy_lazy_zero_threshold(void)
+{
+    static npy_intp threshold = -2;
+
+    if (threshold == -2) {
+        char *env = getenv("NPY_LAZY_ZERO_THRESHOLD");
+        threshold = 1 << 22;
+        if (env != NULL && env[0] != '\0') {
+            threshold = (npy_intp)strtol(env, NULL, 10);
+        }
+        if (threshold > 0 &&
+                threshold <= (npy_intp)BIGCLASS_SIZE(NBIGCLASS - 1)) {
+            threshold = (npy_intp)BIGCLASS_SIZE(NBIGCLASS - 1) + 1;
+        }
+    }
+    return threshold;
+}
+
+/* returns a zero-filled mapping of sz bytes, or NULL on failure */
+static void *
+npy_lazy_zero_alloc(npy_uintp sz)
+{
+    void *p;
+
+    assert(NPY_CHECK_GIL_HELD());
+    if (lazy_zero_n == lazy_zero_cap) {
+        npy_uintp cap = (lazy_zero_cap == 0) ? 16 : 2*lazy_zero_cap;
+        lazy_zero_block *blocks = realloc(lazy_zero_blocks,
+                                          cap * sizeof(lazy_zero_block));
+        if (blocks == NULL) {
+            return NULL;
+        }
+        lazy_zero_blocks = blocks;
+        lazy_zero_cap = cap;
+    }
+    p = mmap(NULL, sz, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+    lazy_zero_blocks[lazy_zero_n].p = p;
+    lazy_zero_blocks[lazy_zero_n].len = sz;
+    lazy_zero_n++;
+#ifdef HAVE_MADV_HUGEPAGE
+    npy_hugepage_advise(p, sz);
+#endif
+#ifdef HAVE_NPY_MBIND
+    npy_numa_place(p, sz);
+#endif
+    PyTraceMalloc_Track(NPY_TRACE_DOMAIN, (npy_uintp)p, sz);
+    return p;
+}
+
+/* returns the mapping length of p, or 0 if it is not a lazy block */
+static NPY_INLINE npy_uintp
+npy_lazy_zero_lookup(void *p)
+{
+    npy_uintp i;
+    for (i = 0; i < lazy_zero_n; i++) {
+        if (lazy_zero_blocks[i].p == p) {
+            return lazy_zero_blocks[i].len;
+        }
+    }
+    return 0;
+}
+
+/* unmaps p if it is a lazy block, returns 1 when it was */
+static int
+npy_lazy_zero_free(void *p)
+{
+    npy_uintp i;
+
+    assert(NPY_CHECK_GIL_HELD());
+    for (i = 0; i < lazy_zero_n; i++) {
+        if (lazy_zero_blocks[i].p == p) {
+            munmap(p, lazy_zero_blocks[i].len);
+            lazy_zero_blocks[i] = lazy_zero_blocks[--lazy_zero_n];
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+
 /*
  * array data cache, sz is number of bytes to allocate
  */
 NPY_NO_EXPORT void *
 npy_alloc_cache(npy_uintp sz)
 {
-    return _npy_alloc_cache(sz, 1, NBUCKETS, datacache, &PyDataMem_NEW);
+    void * p;
+    if (sz >= NBUCKETS) {
+        p = _npy_big_cache_pop(sz);
+        if (p != NULL) {
+            _npy_stats_count_alloc(sz);
+            return p;
+        }
+    }
+    p = _npy_alloc_cache(sz, 1, NBUCKETS, datacache, &PyDataMem_NEW);
+    if (p != NULL) {
+        _npy_stats_count_alloc(sz);
+    }
+    return p;
 }
 
 /* zero initialized data, sz is number of bytes to allocate */
@@ -124,55 +599,234 @@ npy_alloc_cache_zero(npy_uintp sz)
         p = _npy_alloc_cache(sz, 1, NBUCKETS, datacache, &PyDataMem_NEW);
         if (p) {
             memset(p, 0, sz);
+            _npy_stats_count_alloc(sz);
         }
         return p;
     }
+#ifdef HAVE_NPY_LAZY_ZERO
+    {
+        npy_intp lazy_threshold = npy_lazy_zero_threshold();
+        if (lazy_threshold > 0 && sz >= (npy_uintp)lazy_threshold) {
+            p = npy_lazy_zero_alloc(sz);
+            if (p != NULL) {
+                _npy_stats_count_alloc(sz);
+                return p;
+            }
+        }
+    }
+#endif
+    p = _npy_big_cache_pop(sz);
+    if (p != NULL) {
+        NPY_BEGIN_THREADS;
+        memset(p, 0, sz);
+        NPY_END_THREADS;
+        _npy_stats_count_alloc(sz);
+        return p;
+    }
     NPY_BEGIN_THREADS;
     p = PyDataMem_NEW_ZEROED(sz, 1);
     NPY_END_THREADS;
+#ifdef HAVE_NPY_MBIND
+    if (p != NULL) {
+        /* calloc pages fault lazily, so the policy still applies */
+        npy_numa_place(p, sz);
+    }
+#endif
+    if (p != NULL) {
+        _npy_stats_count_alloc(sz);
+    }
     return p;
 }
 
 NPY_NO_EXPORT void
 npy_free_cache(void * p, npy_uintp sz)
 {
+    if (p != NULL) {
+        _npy_stats_count_free(sz);
+    }
+    if (sz >= NBUCKETS) {
+        if (!_npy_big_free_cache(p, sz)) {
+            PyDataMem_FREE(p);
+        }
+        return;
+    }
     _npy_free_cache(p, sz, NBUCKETS, datacache, &PyDataMem_FREE);
 }
 
 /*
  * dimension/stride cache, uses a different allocator and is always a multiple
- * of npy_intp
+ * of npy_intp.  The bucket hit itself lives inline in alloc.h; these are
+ * the refill/spill paths, called with sz already clamped to >= 2.
  */
 NPY_NO_EXPORT void *
-npy_alloc_cache_dim(npy_uintp sz)
+npy_alloc_cache_dim_slow(npy_uintp sz)
 {
-    /*
-     * make sure any temporary allocation can be used for array metadata which
-     * uses one memory block for both dimensions and strides
-     */
-    if (sz < 2) {
-        sz = 2;
-    }
-    return _npy_alloc_cache(sz, sizeof(npy_intp), NBUCKETS_DIM, dimcache,
+    return _npy_alloc_cache(sz, sizeof(npy_intp), NBUCKETS_DIM, npy_dimcache,
                             &PyArray_malloc);
 }
 
 NPY_NO_EXPORT void
-npy_free_cache_dim(void * p, npy_uintp sz)
+npy_free_cache_dim_slow(void * p, npy_uintp sz)
 {
-    /* see npy_alloc_cache_dim */
-    if (sz < 2) {
-        sz = 2;
-    }
-    _npy_free_cache(p, sz, NBUCKETS_DIM, dimcache,
+    _npy_free_cache(p, sz, NBUCKETS_DIM, npy_dimcache,
                     &PyArray_free);
 }
 
+/* store an unsigned counter under key in dict, returns -1 on failure */
+static int
+_alloc_stats_set_item(PyObject *dict, const char *key, npy_uint64 value)
+{
+    PyObject *num = PyLong_FromUnsignedLongLong((unsigned long long)value);
+    int res;
+
+    if (num == NULL) {
+        return -1;
+    }
+    res = PyDict_SetItemString(dict, key, num);
+    Py_DECREF(num);
+    return res;
+}
+
+/*
+ * _get_alloc_stats(clear=False) -> dict with the telemetry counters:
+ * live_bytes, peak_bytes, data_cache_hits/misses, big_cache_hits/
+ * misses and a power-of-two size histogram (entry i counts requests of
+ * [2**i, 2**(i+1)) bytes).  clear resets the cache counters and the
+ * histogram and restarts the peak from the current live bytes; the
+ * live byte count itself always reflects outstanding blocks.
+ */
+NPY_NO_EXPORT PyObject *
+alloc_stats_get(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"clear", NULL};
+    int clear = 0;
+    PyObject *dict, *hist;
+    int i;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i:_get_alloc_stats",
+                                     kwlist, &clear)) {
+        return NULL;
+    }
+    dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+    if (_alloc_stats_set_item(dict, "live_bytes",
+                              npy_alloc_telemetry.live_bytes) < 0 ||
+            _alloc_stats_set_item(dict, "peak_bytes",
+                                  npy_alloc_telemetry.peak_bytes) < 0 ||
+            _alloc_stats_set_item(dict, "data_cache_hits",
+                                  npy_alloc_telemetry.data_hits) < 0 ||
+            _alloc_stats_set_item(dict, "data_cache_misses",
+                                  npy_alloc_telemetry.data_misses) < 0 ||
+            _alloc_stats_set_item(dict, "big_cache_hits",
+                                  npy_alloc_telemetry.big_hits) < 0 ||
+            _alloc_stats_set_item(dict, "big_cache_misses",
+                                  npy_alloc_telemetry.big_misses) < 0) {
+        Py_DECREF(dict);
+        return NULL;
+    }
+    hist = PyList_New(NPY_ALLOC_STATS_BINS);
+    if (hist == NULL) {
+        Py_DECREF(dict);
+        return NULL;
+    }
+    for (i = 0; i < NPY_ALLOC_STATS_BINS; i++) {
+        PyObject *num = PyLong_FromUnsignedLongLong(
+                (unsigned long long)npy_alloc_telemetry.hist[i]);
+        if (num == NULL) {
+            Py_DECREF(hist);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        PyList_SET_ITEM(hist, i, num);
+    }
+    if (PyDict_SetItemString(dict, "histogram", hist) < 0) {
+        Py_DECREF(hist);
+        Py_DECREF(dict);
+        return NULL;
+    }
+    Py_DECREF(hist);
+    if (clear) {
+        npy_alloc_telemetry.peak_bytes = npy_alloc_telemetry.live_bytes;
+        npy_alloc_telemetry.data_hits = 0;
+        npy_alloc_telemetry.data_misses = 0;
+        npy_alloc_telemetry.big_hits = 0;
+        npy_alloc_telemetry.big_misses = 0;
+        memset(npy_alloc_telemetry.hist, 0,
+               sizeof(npy_alloc_telemetry.hist));
+    }
+    return dict;
+}
+
 
 /* malloc/free/realloc hook */
 NPY_NO_EXPORT PyDataMem_EventHookFunc *_PyDataMem_eventhook;
 NPY_NO_EXPORT void *_PyDataMem_eventhook_user_data;
 
+/* default data allocator handler, backed by the libc allocator */
+static void *
+_default_alloc(void *NPY_UNUSED(ctx), size_t size)
+{
+    return malloc(size);
+}
+
+static void *
+_default_zeroed_alloc(void *NPY_UNUSED(ctx), size_t nelems, size_t elsize)
+{
+    return calloc(nelems, elsize);
+}
+
+static void *
+_default_realloc(void *NPY_UNUSED(ctx), void *ptr, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+static void
+_default_free(void *NPY_UNUSED(ctx), void *ptr)
+{
+    free(ptr);
+}
+
+static PyDataMem_Handler _default_handler = {
+    NULL,
+    _default_alloc,
+    _default_zeroed_alloc,
+    _default_realloc,
+    _default_free,
+};
+static PyDataMem_Handler *_current_handler = &_default_handler;
+
+/*NUMPY_API
+ * Sets the allocation handler for numpy array data and returns a
+ * pointer to the previous one.  A NULL handler restores the default,
+ * which allocates with malloc/calloc/realloc/free.
+ *
+ * The handler structure and everything it references must stay valid,
+ * and its free function must remain able to release blocks allocated
+ * through it, for as long as any such block is alive; installing a new
+ * handler does not migrate existing allocations (data blocks do not
+ * record which handler created them).  The GIL must be held.
+ */
+NPY_NO_EXPORT PyDataMem_Handler *
+PyDataMem_SetHandler(PyDataMem_Handler *handler)
+{
+    PyDataMem_Handler *temp = _current_handler;
+    _current_handler = (handler != NULL) ? handler : &_default_handler;
+    return temp;
+}
+
+/*NUMPY_API
+ * Returns a pointer to the current allocation handler for numpy array
+ * data.  The GIL must be held.
+ */
+NPY_NO_EXPORT PyDataMem_Handler *
+PyDataMem_GetHandler(void)
+{
+    return _current_handler;
+}
+
 /*NUMPY_API
  * Sets the allocation event hook for numpy array data.
  * Takes a PyDataMem_EventHookFunc *, which has the signature:
@@ -218,7 +872,7 @@ PyDataMem_NEW(size_t size)
 {
     void *result;
 
-    result = malloc(size);
+    result = _current_handler->alloc(_current_handler->ctx, size);
     if (_PyDataMem_eventhook != NULL) {
         NPY_ALLOW_C_API_DEF
         NPY_ALLOW_C_API
@@ -240,7 +894,8 @@ PyDataMem_NEW_ZEROED(size_t size, size_t elsize)
 {
     void *result;
 
-    result = calloc(size, elsize);
+    result = _current_handler->zeroed_alloc(_current_handler->ctx,
+                                            size, elsize);
     if (_PyDataMem_eventhook != NULL) {
         NPY_ALLOW_C_API_DEF
         NPY_ALLOW_C_API
@@ -261,7 +916,12 @@ NPY_NO_EXPORT void
 PyDataMem_FREE(void *ptr)
 {
     PyTraceMalloc_Untrack(NPY_TRACE_DOMAIN, (npy_uintp)ptr);
-    free(ptr);
+#ifdef HAVE_NPY_LAZY_ZERO
+    if (!npy_lazy_zero_free(ptr))
+#endif
+    {
+        _current_handler->free(_current_handler->ctx, ptr);
+    }
     if (_PyDataMem_eventhook != NULL) {
         NPY_ALLOW_C_API_DEF
         NPY_ALLOW_C_API
@@ -281,7 +941,26 @@ PyDataMem_RENEW(void *ptr, size_t size)
 {
     void *result;
 
-    result = realloc(ptr, size);
+#ifdef HAVE_NPY_LAZY_ZERO
+    {
+        npy_uintp lazy_len = npy_lazy_zero_lookup(ptr);
+        if (lazy_len != 0) {
+            /* mmap blocks cannot go through the handler's realloc */
+            result = _current_handler->alloc(_current_handler->ctx, size);
+            if (result != NULL) {
+                memcpy(result, ptr,
+                       (lazy_len < (npy_uintp)size) ? lazy_len : size);
+                npy_lazy_zero_free(ptr);
+            }
+        }
+        else {
+            result = _current_handler->realloc(_current_handler->ctx,
+                                               ptr, size);
+        }
+    }
+#else
+    result = _current_handler->realloc(_current_handler->ctx, ptr, size);
+#endif
     if (result != ptr) {
         PyTraceMalloc_Untrack(NPY_TRACE_DOMAIN, (npy_uintp)ptr);
     }
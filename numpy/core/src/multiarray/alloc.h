@@ -6,6 +6,44 @@
 
 #define NPY_TRACE_DOMAIN 389047
 
+#define NBUCKETS_DIM 16 /* number of buckets for dimensions/strides */
+#define NCACHE 7 /* number of cache entries per bucket */
+/* this structure fits neatly into a cacheline */
+typedef struct {
+    npy_uintp available; /* number of cached pointers */
+    void * ptrs[NCACHE];
+} cache_bucket;
+
+/*
+ * dimension/stride cache buckets, exposed so the common bucket hit can
+ * be inlined into the array constructors and destructor below
+ */
+NPY_NO_EXPORT extern cache_bucket npy_dimcache[NBUCKETS_DIM];
+
+/* power-of-two histogram; bin i counts requests of [2^i, 2^(i+1)) bytes */
+#define NPY_ALLOC_STATS_BINS 48
+
+/*
+ * Telemetry for the array-data cache layer, serialized by the GIL like
+ * the caches themselves.  Cheap enough to keep always on, unlike the
+ * per-call PyDataMem_SetEventHook callbacks.
+ */
+typedef struct {
+    npy_uint64 live_bytes;  /* bytes currently handed out */
+    npy_uint64 peak_bytes;  /* high-water mark of live_bytes */
+    npy_uint64 data_hits;   /* exact-size data cache hits */
+    npy_uint64 data_misses;
+    npy_uint64 big_hits;    /* size-class cache hits */
+    npy_uint64 big_misses;
+    npy_uint64 hist[NPY_ALLOC_STATS_BINS];
+} npy_alloc_stats;
+
+NPY_NO_EXPORT extern npy_alloc_stats npy_alloc_telemetry;
+
+/* _get_alloc_stats(clear=False) -> dict of the allocation telemetry */
+NPY_NO_EXPORT PyObject *
+alloc_stats_get(PyObject *dummy, PyObject *args, PyObject *kwds);
+
 NPY_NO_EXPORT void *
 npy_alloc_cache(npy_uintp sz);
 
@@ -16,10 +54,46 @@ NPY_NO_EXPORT void
 npy_free_cache(void * p, npy_uintp sd);
 
 NPY_NO_EXPORT void *
-npy_alloc_cache_dim(npy_uintp sz);
+npy_alloc_cache_dim_slow(npy_uintp sz);
 
 NPY_NO_EXPORT void
-npy_free_cache_dim(void * p, npy_uintp sd);
+npy_free_cache_dim_slow(void * p, npy_uintp sd);
+
+/*
+ * allocate sz npy_intp for dimensions/strides, sz in units of npy_intp.
+ * Every array creation goes through here, so the bucket hit is inlined
+ * and only refills and oversized requests pay for a function call.
+ */
+static NPY_INLINE void *
+npy_alloc_cache_dim(npy_uintp sz)
+{
+    /*
+     * make sure any temporary allocation can be used for array metadata which
+     * uses one memory block for both dimensions and strides
+     */
+    if (sz < 2) {
+        sz = 2;
+    }
+    if (sz < NBUCKETS_DIM && npy_dimcache[sz].available > 0) {
+        return npy_dimcache[sz].ptrs[--(npy_dimcache[sz].available)];
+    }
+    return npy_alloc_cache_dim_slow(sz);
+}
+
+static NPY_INLINE void
+npy_free_cache_dim(void * p, npy_uintp sz)
+{
+    /* see npy_alloc_cache_dim */
+    if (sz < 2) {
+        sz = 2;
+    }
+    if (p != NULL && sz < NBUCKETS_DIM &&
+            npy_dimcache[sz].available < NCACHE) {
+        npy_dimcache[sz].ptrs[npy_dimcache[sz].available++] = p;
+        return;
+    }
+    npy_free_cache_dim_slow(p, sz);
+}
 
 static NPY_INLINE void
 npy_free_cache_dim_obj(PyArray_Dims dims)
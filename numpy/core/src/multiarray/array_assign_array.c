@@ -10,6 +10,8 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#include <stdlib.h>
+
 #define NPY_NO_DEPRECATED_API NPY_API_VERSION
 #define _MULTIARRAYMODULE
 #include <numpy/ndarraytypes.h>
@@ -23,6 +25,7 @@
 #include "lowlevel_strided_loops.h"
 
 #include "array_assign.h"
+#include "npy_workpool.h"
 
 /*
  * Check that array data is both uint-aligned and true-aligned for all array
@@ -65,6 +68,280 @@ copycast_isaligned(int ndim, npy_intp *shape,
     return aligned;
 }
 
+/* do not bother threading assignments below this many elements */
+#define NPY_ASSIGN_PARALLEL_THRESHOLD 0x100000
+/* never hand a worker less than this many elements */
+#define NPY_ASSIGN_PARALLEL_MIN_CHUNK 0x40000
+/* upper bound for NPY_ASSIGN_THREADS */
+#define NPY_ASSIGN_MAX_THREADS 128
+
+static int
+npy_assign_nthreads(void)
+{
+    static int nthreads = -1;
+
+    if (nthreads < 0) {
+        char *env = getenv("NPY_ASSIGN_THREADS");
+        nthreads = 1;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > NPY_ASSIGN_MAX_THREADS) {
+                val = NPY_ASSIGN_MAX_THREADS;
+            }
+            if (val > 1) {
+                nthreads = (int)val;
+            }
+        }
+    }
+    return nthreads;
+}
+
+typedef struct {
+    PyArray_StridedUnaryOp *stransfer;
+    char *dst_data;
+    char *src_data;
+    npy_intp dst_stride;
+    npy_intp src_stride;
+    npy_intp count;
+    npy_intp src_itemsize;
+} assign_chunk_task;
+
+static void
+assign_chunk_run(npy_intp t, void *arg)
+{
+    assign_chunk_task *task = (assign_chunk_task *)arg + t;
+
+    task->stransfer(task->dst_data, task->dst_stride,
+                    task->src_data, task->src_stride,
+                    task->count, task->src_itemsize, NULL);
+}
+
+/*
+ * Run a large 1-d assignment with a stateless transfer function (no aux
+ * data, no Python API) on the shared worker pool, like the threaded
+ * ufunc loops enabled by setting NPY_ASSIGN_THREADS to N > 1.  The
+ * chunks complete in arbitrary order, so any overlap between the source
+ * and destination ranges falls back to the serial loop.  Returns 1 if
+ * the parallel engine ran and 0 if the caller should run serially.
+ * Called with the GIL already released.
+ */
+static int
+npy_assign_parallel(PyArray_StridedUnaryOp *stransfer,
+                    char *dst_data, npy_intp dst_stride, npy_intp dst_itemsize,
+                    char *src_data, npy_intp src_stride, npy_intp src_itemsize,
+                    npy_intp N)
+{
+    assign_chunk_task chunks[NPY_ASSIGN_MAX_THREADS];
+    char *src_lo, *src_hi, *dst_lo, *dst_hi;
+    npy_intp chunksize, start;
+    int i, nchunks;
+    int nthreads = npy_assign_nthreads();
+
+    if (nthreads <= 1 || N < NPY_ASSIGN_PARALLEL_THRESHOLD) {
+        return 0;
+    }
+
+    /* byte extents of both operands; strides may point either way */
+    src_lo = src_data + (src_stride < 0 ? (N - 1)*src_stride : 0);
+    src_hi = src_data + (src_stride > 0 ? (N - 1)*src_stride : 0)
+                                                            + src_itemsize;
+    dst_lo = dst_data + (dst_stride < 0 ? (N - 1)*dst_stride : 0);
+    dst_hi = dst_data + (dst_stride > 0 ? (N - 1)*dst_stride : 0)
+                                                            + dst_itemsize;
+    if (src_lo < dst_hi && dst_lo < src_hi) {
+        return 0;
+    }
+
+    nchunks = nthreads;
+    if (N / nchunks < NPY_ASSIGN_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(N / NPY_ASSIGN_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1) {
+        return 0;
+    }
+    chunksize = N / nchunks;
+
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].stransfer = stransfer;
+        chunks[i].dst_data = dst_data + start*dst_stride;
+        chunks[i].src_data = src_data + start*src_stride;
+        chunks[i].dst_stride = dst_stride;
+        chunks[i].src_stride = src_stride;
+        chunks[i].count = (i == nchunks - 1) ? N - start : chunksize;
+        chunks[i].src_itemsize = src_itemsize;
+        start += chunksize;
+    }
+    npy_parallel_for(nchunks, assign_chunk_run, chunks, nthreads);
+
+    return 1;
+}
+
+static void
+block_copy_run(npy_intp t, void *arg)
+{
+    npy_block_copy_spec *block = (npy_block_copy_spec *)arg + t;
+
+    if (block->nbytes > 0) {
+        memcpy(block->dst, block->src, block->nbytes);
+    }
+}
+
+/*
+ * Multi-block raw copy driver, used by concatenation to push many
+ * already-validated shard copies through the worker pool at once
+ * instead of assigning them one after another.  See the prototype in
+ * array_assign.h for the contract.
+ */
+NPY_NO_EXPORT void
+npy_parallel_block_copy(npy_block_copy_spec *blocks, npy_intp nblocks)
+{
+    npy_uintp total = 0;
+    npy_intp i;
+    int nthreads = npy_assign_nthreads();
+    NPY_BEGIN_THREADS_DEF;
+
+    for (i = 0; i < nblocks; i++) {
+        total += blocks[i].nbytes;
+    }
+    if (nthreads <= 1 || nblocks <= 1 ||
+            total < NPY_ASSIGN_PARALLEL_THRESHOLD) {
+        for (i = 0; i < nblocks; i++) {
+            if (blocks[i].nbytes > 0) {
+                memcpy(blocks[i].dst, blocks[i].src, blocks[i].nbytes);
+            }
+        }
+        return;
+    }
+    NPY_BEGIN_THREADS;
+    npy_parallel_for(nblocks, block_copy_run, blocks, nthreads);
+    NPY_END_THREADS;
+}
+
+/* Tile edge of the blocked transpose copy, in elements */
+#define NPY_TRANSPOSE_TILE 16
+
+/*
+ * Tiled kernels of the transpose copy engine: dst is rows x cols and
+ * C-contiguous, src is its pure transpose (column index contiguous),
+ * and the kernel handles dst rows [r0, r1).  The 16x16 element tiles
+ * keep one stretch of source columns and destination rows resident
+ * while both are traversed, instead of striding over the full matrix
+ * per inner loop as the generic transfer does.
+ */
+/**begin-like repeated kernels for the power-of-two element sizes */
+#define TRANSPOSE_TILE_KERNEL(name, type)                                  \
+static void                                                                \
+name(char *dstc, const char *srcc, npy_intp r0, npy_intp r1,               \
+     npy_intp rows, npy_intp cols)                                         \
+{                                                                          \
+    type *dst = (type *)dstc;                                              \
+    const type *src = (const type *)srcc;                                  \
+    npy_intp i, j, ib, jb, iend, jend;                                     \
+                                                                           \
+    for (jb = 0; jb < cols; jb += NPY_TRANSPOSE_TILE) {                    \
+        jend = jb + NPY_TRANSPOSE_TILE > cols ? cols                       \
+                                              : jb + NPY_TRANSPOSE_TILE;   \
+        for (ib = r0; ib < r1; ib += NPY_TRANSPOSE_TILE) {                 \
+            iend = ib + NPY_TRANSPOSE_TILE > r1 ? r1                       \
+                                                : ib + NPY_TRANSPOSE_TILE; \
+            for (i = ib; i < iend; i++) {                                  \
+                for (j = jb; j < jend; j++) {                              \
+                    dst[i*cols + j] = src[j*rows + i];                     \
+                }                                                          \
+            }                                                              \
+        }                                                                  \
+    }                                                                      \
+}
+
+typedef struct { npy_uint64 lo, hi; } npy_transpose_pair128;
+
+TRANSPOSE_TILE_KERNEL(transpose_tile_1, npy_uint8)
+TRANSPOSE_TILE_KERNEL(transpose_tile_2, npy_uint16)
+TRANSPOSE_TILE_KERNEL(transpose_tile_4, npy_uint32)
+TRANSPOSE_TILE_KERNEL(transpose_tile_8, npy_uint64)
+TRANSPOSE_TILE_KERNEL(transpose_tile_16, npy_transpose_pair128)
+
+#undef TRANSPOSE_TILE_KERNEL
+
+typedef struct {
+    char *dst;
+    const char *src;
+    npy_intp rows;
+    npy_intp cols;
+    npy_intp rows_per_task;
+    void (*kernel)(char *, const char *, npy_intp, npy_intp,
+                   npy_intp, npy_intp);
+} transpose_copy_job;
+
+static void
+transpose_copy_run(npy_intp t, void *arg)
+{
+    transpose_copy_job *job = (transpose_copy_job *)arg;
+    npy_intp r0 = t * job->rows_per_task;
+    npy_intp r1 = r0 + job->rows_per_task;
+
+    if (r1 > job->rows) {
+        r1 = job->rows;
+    }
+    job->kernel(job->dst, job->src, r0, r1, job->rows, job->cols);
+}
+
+/*
+ * Blocked transpose copy for a C-contiguous rows x cols destination
+ * whose source is a pure transpose of a contiguous block.  Splits the
+ * destination rows over the assignment worker threads.  Called with
+ * the GIL released.
+ */
+static void
+npy_blocked_transpose_copy(char *dst, const char *src,
+                           npy_intp rows, npy_intp cols, npy_intp elsize)
+{
+    transpose_copy_job job;
+    npy_intp ntasks;
+    int nthreads = npy_assign_nthreads();
+
+    job.dst = dst;
+    job.src = src;
+    job.rows = rows;
+    job.cols = cols;
+    switch (elsize) {
+        case 1:
+            job.kernel = transpose_tile_1;
+            break;
+        case 2:
+            job.kernel = transpose_tile_2;
+            break;
+        case 4:
+            job.kernel = transpose_tile_4;
+            break;
+        case 8:
+            job.kernel = transpose_tile_8;
+            break;
+        default:
+            job.kernel = transpose_tile_16;
+            break;
+    }
+    if (nthreads <= 1 ||
+            rows * cols * elsize < NPY_ASSIGN_PARALLEL_THRESHOLD) {
+        job.kernel(dst, src, 0, rows, rows, cols);
+        return;
+    }
+    ntasks = nthreads;
+    if (rows / ntasks < NPY_TRANSPOSE_TILE) {
+        ntasks = rows / NPY_TRANSPOSE_TILE;
+    }
+    if (ntasks <= 1) {
+        job.kernel(dst, src, 0, rows, rows, cols);
+        return;
+    }
+    /* round up to tile multiples so tasks do not split a tile row */
+    job.rows_per_task = ((rows + ntasks - 1) / ntasks +
+                         NPY_TRANSPOSE_TILE - 1) &
+                        ~(npy_intp)(NPY_TRANSPOSE_TILE - 1);
+    npy_parallel_for(ntasks, transpose_copy_run, &job, nthreads);
+}
+
 /*
  * Assigns the array from 'src' to 'dst'. The strides must already have
  * been broadcast.
@@ -116,6 +393,81 @@ raw_array_assign_array(int ndim, npy_intp *shape,
         dst_strides_it[0] = -dst_strides_it[0];
     }
 
+    /*
+     * The raw iteration preparation above has already coalesced all the
+     * compatible axes.  When the dtypes match trivially and the merged
+     * inner dimension is contiguous in both operands, issue one large
+     * memmove per inner block directly instead of constructing a
+     * transfer function and paying an indirect call per block.  The
+     * 1-d case is left to the transfer path so it can engage the
+     * parallel engine below.
+     */
+    if (ndim > 1 &&
+            src_dtype->elsize == dst_dtype->elsize &&
+            src_strides_it[0] == src_dtype->elsize &&
+            dst_strides_it[0] == dst_dtype->elsize &&
+            src_dtype->type_num < NPY_NTYPES &&
+            dst_dtype->type_num < NPY_NTYPES &&
+            PyArray_ISNBO(src_dtype->byteorder) ==
+                                PyArray_ISNBO(dst_dtype->byteorder) &&
+            !PyDataType_REFCHK(src_dtype) &&
+            !PyDataType_REFCHK(dst_dtype) &&
+            !PyDataType_HASFIELDS(src_dtype) &&
+            !PyDataType_HASFIELDS(dst_dtype) &&
+            PyArray_EquivTypes(src_dtype, dst_dtype)) {
+        npy_intp blocksize = shape_it[0] * dst_dtype->elsize;
+
+        NPY_BEGIN_THREADS;
+        NPY_RAW_ITER_START(idim, ndim, coord, shape_it) {
+            memmove(dst_data, src_data, blocksize);
+        } NPY_RAW_ITER_TWO_NEXT(idim, ndim, coord, shape_it,
+                                dst_data, dst_strides_it,
+                                src_data, src_strides_it);
+        NPY_END_THREADS;
+
+        return 0;
+    }
+
+    /*
+     * A contiguous destination fed by a pure transpose of a contiguous
+     * block — the C<->F order conversion — is TLB-hostile under the
+     * generic transfer, which walks a full source column per inner
+     * loop.  Run the blocked transpose engine instead.  The operands
+     * cannot overlap (higher-dimensional overlap was copied away
+     * before getting here), but check their extents to stay safe for
+     * raw callers.
+     */
+    if (ndim == 2 && aligned &&
+            src_dtype->elsize == dst_dtype->elsize &&
+            (dst_dtype->elsize == 1 || dst_dtype->elsize == 2 ||
+             dst_dtype->elsize == 4 || dst_dtype->elsize == 8 ||
+             dst_dtype->elsize == 16) &&
+            dst_strides_it[0] == dst_dtype->elsize &&
+            dst_strides_it[1] == shape_it[0] * dst_dtype->elsize &&
+            src_strides_it[1] == src_dtype->elsize &&
+            src_strides_it[0] == shape_it[1] * src_dtype->elsize &&
+            src_dtype->type_num < NPY_NTYPES &&
+            dst_dtype->type_num < NPY_NTYPES &&
+            PyArray_ISNBO(src_dtype->byteorder) ==
+                                PyArray_ISNBO(dst_dtype->byteorder) &&
+            !PyDataType_REFCHK(src_dtype) &&
+            !PyDataType_REFCHK(dst_dtype) &&
+            !PyDataType_HASFIELDS(src_dtype) &&
+            !PyDataType_HASFIELDS(dst_dtype) &&
+            PyArray_EquivTypes(src_dtype, dst_dtype)) {
+        npy_intp nbytes = shape_it[0] * shape_it[1] * dst_dtype->elsize;
+
+        if (src_data + nbytes <= dst_data || dst_data + nbytes <= src_data) {
+            NPY_BEGIN_THREADS;
+            npy_blocked_transpose_copy(dst_data, src_data,
+                                       shape_it[1], shape_it[0],
+                                       dst_dtype->elsize);
+            NPY_END_THREADS;
+
+            return 0;
+        }
+    }
+
     /* Get the function to do the casting */
     if (PyArray_GetDTypeTransferFunction(aligned,
                         src_strides_it[0], dst_strides_it[0],
@@ -130,13 +482,28 @@ raw_array_assign_array(int ndim, npy_intp *shape,
         NPY_BEGIN_THREADS;
     }
 
-    NPY_RAW_ITER_START(idim, ndim, coord, shape_it) {
-        /* Process the innermost dimension */
-        stransfer(dst_data, dst_strides_it[0], src_data, src_strides_it[0],
-                    shape_it[0], src_itemsize, transferdata);
-    } NPY_RAW_ITER_TWO_NEXT(idim, ndim, coord, shape_it,
-                            dst_data, dst_strides_it,
-                            src_data, src_strides_it);
+    /*
+     * A transfer function without aux data keeps no state between calls,
+     * so a large coalesced 1-d assignment can be chunked across threads.
+     */
+    if (ndim == 1 && !needs_api && transferdata == NULL &&
+            npy_assign_parallel(stransfer,
+                                dst_data, dst_strides_it[0],
+                                dst_dtype->elsize,
+                                src_data, src_strides_it[0], src_itemsize,
+                                shape_it[0])) {
+        /* the parallel engine did the whole assignment */
+    }
+    else {
+        NPY_RAW_ITER_START(idim, ndim, coord, shape_it) {
+            /* Process the innermost dimension */
+            stransfer(dst_data, dst_strides_it[0],
+                        src_data, src_strides_it[0],
+                        shape_it[0], src_itemsize, transferdata);
+        } NPY_RAW_ITER_TWO_NEXT(idim, ndim, coord, shape_it,
+                                dst_data, dst_strides_it,
+                                src_data, src_strides_it);
+    }
 
     NPY_END_THREADS;
 
@@ -203,6 +570,61 @@ raw_array_wheremasked_assign_array(int ndim, npy_intp *shape,
         wheremask_strides_it[0] = -wheremask_strides_it[0];
     }
 
+    /*
+     * When no conversion is needed and the inner dimension is
+     * contiguous in all three operands, scan the boolean mask for
+     * runs of True and copy each run with one memcpy, skipping the
+     * False runs entirely.  Clustered masks — long stretches of
+     * selected or unselected elements — then move at plain copy
+     * speed instead of paying the per-element masked transfer.
+     */
+    if (dst_strides_it[0] == dst_dtype->elsize &&
+            src_strides_it[0] == src_dtype->elsize &&
+            wheremask_strides_it[0] == 1 &&
+            src_dtype->elsize == dst_dtype->elsize &&
+            src_dtype->type_num < NPY_NTYPES &&
+            dst_dtype->type_num < NPY_NTYPES &&
+            PyArray_ISNBO(src_dtype->byteorder) ==
+                                PyArray_ISNBO(dst_dtype->byteorder) &&
+            !PyDataType_REFCHK(src_dtype) &&
+            !PyDataType_REFCHK(dst_dtype) &&
+            !PyDataType_HASFIELDS(src_dtype) &&
+            !PyDataType_HASFIELDS(dst_dtype) &&
+            PyArray_EquivTypes(src_dtype, dst_dtype)) {
+        npy_intp elsize = dst_dtype->elsize;
+
+        NPY_BEGIN_THREADS;
+        NPY_RAW_ITER_START(idim, ndim, coord, shape_it) {
+            const npy_bool *mask = (const npy_bool *)wheremask_data;
+            npy_intp i = 0, n = shape_it[0];
+
+            while (i < n) {
+                npy_intp run;
+
+                /* skip the False run */
+                while (i < n && !mask[i]) {
+                    ++i;
+                }
+                run = i;
+                while (run < n && mask[run]) {
+                    ++run;
+                }
+                if (run > i) {
+                    /* memmove: 1-d forward-overlapping views reach here */
+                    memmove(dst_data + i * elsize, src_data + i * elsize,
+                            (run - i) * elsize);
+                }
+                i = run;
+            }
+        } NPY_RAW_ITER_THREE_NEXT(idim, ndim, coord, shape_it,
+                                dst_data, dst_strides_it,
+                                src_data, src_strides_it,
+                                wheremask_data, wheremask_strides_it);
+        NPY_END_THREADS;
+
+        return 0;
+    }
+
     /* Get the function to do the casting */
     if (PyArray_GetMaskedDTypeTransferFunction(aligned,
                         src_strides_it[0],
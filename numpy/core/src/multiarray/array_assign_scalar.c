@@ -21,6 +21,7 @@
 #include "methods.h"
 #include "shape.h"
 #include "lowlevel_strided_loops.h"
+#include "npy_nontemporal.h"
 
 #include "array_assign.h"
 
@@ -62,6 +63,33 @@ raw_array_assign_scalar(int ndim, npy_intp *shape,
         return -1;
     }
 
+    /*
+     * Huge contiguous fills of a trivially copyable scalar go through
+     * streaming stores, bypassing the cache which a destination this
+     * large would only pollute.
+     */
+    if (ndim == 1 && dst_strides_it[0] == dst_dtype->elsize &&
+            src_dtype->elsize == dst_dtype->elsize &&
+            src_dtype->type_num < NPY_NTYPES &&
+            dst_dtype->type_num < NPY_NTYPES &&
+            PyArray_ISNBO(src_dtype->byteorder) ==
+                                PyArray_ISNBO(dst_dtype->byteorder) &&
+            !PyDataType_REFCHK(src_dtype) &&
+            !PyDataType_REFCHK(dst_dtype) &&
+            !PyDataType_HASFIELDS(src_dtype) &&
+            !PyDataType_HASFIELDS(dst_dtype) &&
+            PyArray_EquivTypes(src_dtype, dst_dtype)) {
+        int filled;
+
+        NPY_BEGIN_THREADS;
+        filled = npy_try_nontemporal_fill(dst_data, src_data,
+                                          dst_dtype->elsize, shape_it[0]);
+        NPY_END_THREADS;
+        if (filled) {
+            return 0;
+        }
+    }
+
     /* Get the function to do the casting */
     if (PyArray_GetDTypeTransferFunction(aligned,
                         0, dst_strides_it[0],
@@ -619,10 +619,15 @@ PyArray_SetDatetimeParseFunction(PyObject *op)
 NPY_NO_EXPORT int
 PyArray_CompareUCS4(npy_ucs4 *s1, npy_ucs4 *s2, size_t len)
 {
-    npy_ucs4 c1, c2;
-    while(len-- > 0) {
-        c1 = *s1++;
-        c2 = *s2++;
+    size_t i = 0;
+
+    /* skip equal 16-byte blocks before looking at single characters */
+    while (i + 4 <= len && memcmp(s1 + i, s2 + i, 4 * sizeof(npy_ucs4)) == 0) {
+        i += 4;
+    }
+    for (; i < len; i++) {
+        npy_ucs4 c1 = s1[i];
+        npy_ucs4 c2 = s2[i];
         if (c1 != c2) {
             return (c1 < c2) ? -1 : 1;
         }
@@ -635,14 +640,11 @@ PyArray_CompareUCS4(npy_ucs4 *s1, npy_ucs4 *s2, size_t len)
 NPY_NO_EXPORT int
 PyArray_CompareString(char *s1, char *s2, size_t len)
 {
-    const unsigned char *c1 = (unsigned char *)s1;
-    const unsigned char *c2 = (unsigned char *)s2;
-    size_t i;
+    /* memcmp compares as unsigned bytes and is vectorized by libc */
+    int ret = memcmp(s1, s2, len);
 
-    for(i = 0; i < len; ++i) {
-        if (c1[i] != c2[i]) {
-            return (c1[i] > c2[i]) ? 1 : -1;
-        }
+    if (ret != 0) {
+        return ret < 0 ? -1 : 1;
     }
     return 0;
 }
@@ -1348,6 +1350,50 @@ fail:
     return NULL;
 }
 
+/*
+ * Returns 1 if 'self' and 'other' are an integer or boolean array
+ * compared against itself, either as the same object or as views with
+ * identical memory layout.  Elementwise comparison results for such a
+ * pair do not depend on the stored values, so the caller can answer
+ * without running the comparison loop.  Kinds where an element may
+ * not equal itself (float/complex NaN, datetime NaT) and object
+ * arrays with custom __eq__ never qualify.
+ */
+static int
+_self_comparison_trivial(PyArrayObject *self, PyObject *other)
+{
+    PyArrayObject *aother;
+    int type_num = PyArray_TYPE(self);
+
+    if (!PyArray_CheckExact((PyObject *)self)) {
+        return 0;
+    }
+    if (!PyTypeNum_ISBOOL(type_num) && !PyTypeNum_ISINTEGER(type_num)) {
+        return 0;
+    }
+    if ((PyObject *)self == other) {
+        return 1;
+    }
+    if (!PyArray_CheckExact(other)) {
+        return 0;
+    }
+    aother = (PyArrayObject *)other;
+    if (PyArray_TYPE(aother) != type_num ||
+            PyArray_ISNBO(PyArray_DESCR(self)->byteorder) !=
+                    PyArray_ISNBO(PyArray_DESCR(aother)->byteorder)) {
+        return 0;
+    }
+    if (PyArray_DATA(aother) != PyArray_DATA(self) ||
+            PyArray_NDIM(aother) != PyArray_NDIM(self)) {
+        return 0;
+    }
+    return PyArray_CompareLists(PyArray_DIMS(self), PyArray_DIMS(aother),
+                                PyArray_NDIM(self)) &&
+           PyArray_CompareLists(PyArray_STRIDES(self),
+                                PyArray_STRIDES(aother),
+                                PyArray_NDIM(self));
+}
+
 NPY_NO_EXPORT PyObject *
 array_richcompare(PyArrayObject *self, PyObject *other, int cmp_op)
 {
@@ -1355,6 +1401,27 @@ array_richcompare(PyArrayObject *self, PyObject *other, int cmp_op)
     PyObject *obj_self = (PyObject *)self;
     PyObject *result = NULL;
 
+    /*
+     * Self-comparison of integer/boolean arrays has a constant
+     * answer; fill it directly instead of launching the ufunc.
+     */
+    if (_self_comparison_trivial(self, other)) {
+        npy_bool value = (cmp_op == Py_EQ || cmp_op == Py_LE ||
+                          cmp_op == Py_GE);
+        PyArrayObject *res;
+
+        res = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+                        PyArray_DescrFromType(NPY_BOOL),
+                        PyArray_NDIM(self), PyArray_DIMS(self),
+                        NULL, NULL, 0, NULL);
+        if (res == NULL) {
+            return NULL;
+        }
+        memset(PyArray_DATA(res), value, PyArray_SIZE(res));
+        /* 0-d comparisons give scalars, like the ufunc would */
+        return PyArray_Return(res);
+    }
+
     /* Special case for string arrays (which don't and currently can't have
      * ufunc loops defined, so there's no point in trying).
      */
@@ -1760,11 +1827,35 @@ array_iter(PyArrayObject *arr)
     return PySeqIter_New((PyObject *)arr);
 }
 
+/*
+ * Free-list of recycled array headers, in the style of CPython's float
+ * free-list.  View and slice heavy code allocates and frees these
+ * structs at a very high rate while the data they point at is shared,
+ * so recycling the headers keeps such loops off the allocator.  The
+ * list only holds exact PyArray_Type instances -- subclasses may have a
+ * larger tp_basicsize -- and since headers are only allocated and freed
+ * with the GIL held, a single list needs no further locking.  The first
+ * word of a dead header links to the next entry.
+ */
+#define NPY_ARRAY_FREELIST_SIZE 256
+
+static PyObject *array_freelist = NULL;
+static int array_freelist_num = 0;
+
 static PyObject *
 array_alloc(PyTypeObject *type, Py_ssize_t NPY_UNUSED(nitems))
 {
+    PyObject *obj;
+
     /* nitems will always be 0 */
-    PyObject *obj = PyObject_Malloc(type->tp_basicsize);
+    if (type == &PyArray_Type && array_freelist != NULL) {
+        obj = array_freelist;
+        array_freelist = *(PyObject **)obj;
+        array_freelist_num--;
+    }
+    else {
+        obj = PyObject_Malloc(type->tp_basicsize);
+    }
     PyObject_Init(obj, type);
     return obj;
 }
@@ -1772,6 +1863,13 @@ array_alloc(PyTypeObject *type, Py_ssize_t NPY_UNUSED(nitems))
 static void
 array_free(PyObject * v)
 {
+    if (Py_TYPE(v) == &PyArray_Type &&
+            array_freelist_num < NPY_ARRAY_FREELIST_SIZE) {
+        *(PyObject **)v = array_freelist;
+        array_freelist = v;
+        array_freelist_num++;
+        return;
+    }
     /* avoid same deallocator as PyBaseObject, see gentype_free */
     PyObject_Free(v);
 }
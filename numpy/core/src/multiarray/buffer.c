@@ -485,6 +485,15 @@ typedef struct {
     int ndim;
     Py_ssize_t *strides;
     Py_ssize_t *shape;
+    /*
+     * The descr (owned reference) and data pointer the info was built
+     * from, recorded so a re-export can detect that nothing relevant
+     * changed without rebuilding the format string.  The format depends
+     * only on the descr and on the alignment of the data pointer.
+     * NULL descr for the datetime64 scalar special case.
+     */
+    PyArray_Descr *descr;
+    char *data;
 } _buffer_info_t;
 
 /*
@@ -543,6 +552,8 @@ _buffer_info_new(PyObject *obj)
         info->shape[0] = 8;
         info->strides[0] = 1;
         info->format = fmt.s;
+        info->descr = NULL;
+        info->data = NULL;
         return info;
     }
     else if (PyArray_IsScalar(obj, Generic)) {
@@ -553,10 +564,12 @@ _buffer_info_new(PyObject *obj)
         info->ndim = 0;
         info->shape = NULL;
         info->strides = NULL;
+        info->data = NULL;
     }
     else {
         PyArrayObject * arr = (PyArrayObject *)obj;
         descr = PyArray_DESCR(arr);
+        info->data = PyArray_DATA(arr);
         /* Fill in shape and strides */
         info->ndim = PyArray_NDIM(arr);
 
@@ -581,16 +594,19 @@ _buffer_info_new(PyObject *obj)
 
     /* Fill in format */
     err = _buffer_format_string(descr, &fmt, obj, NULL, NULL);
-    Py_DECREF(descr);
     if (err != 0) {
+        Py_DECREF(descr);
         free(info->shape);
         goto fail;
     }
     if (_append_char(&fmt, '\0') < 0) {
+        Py_DECREF(descr);
         free(info->shape);
         goto fail;
     }
     info->format = fmt.s;
+    /* keep the reference, for the fast re-export check */
+    info->descr = descr;
 
     return info;
 
@@ -632,15 +648,42 @@ _buffer_info_free(_buffer_info_t *info)
     if (info->shape) {
         free(info->shape);
     }
+    Py_XDECREF(info->descr);
     free(info);
 }
 
+/*
+ * Check whether a cached info still describes the array exactly, without
+ * rebuilding the format string.  Requires the very same descr object and
+ * data pointer the info was built from, because the format string also
+ * encodes the alignment of the data.
+ */
+static int
+_buffer_info_matches_array(_buffer_info_t *info, PyArrayObject *arr)
+{
+    int k;
+
+    if (info->descr != PyArray_DESCR(arr)
+            || info->data != PyArray_DATA(arr)
+            || info->ndim != PyArray_NDIM(arr)) {
+        return 0;
+    }
+    for (k = 0; k < info->ndim; ++k) {
+        if (info->shape[k] != PyArray_DIMS(arr)[k]
+                || info->strides[k] != PyArray_STRIDES(arr)[k]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /* Get buffer info from the global dictionary */
 static _buffer_info_t*
 _buffer_get_info(PyObject *obj)
 {
     PyObject *key = NULL, *item_list = NULL, *item = NULL;
     _buffer_info_t *info = NULL, *old_info = NULL;
+    Py_ssize_t k, size = 0;
 
     if (_buffer_info_cache == NULL) {
         _buffer_info_cache = PyDict_New();
@@ -649,29 +692,29 @@ _buffer_get_info(PyObject *obj)
         }
     }
 
-    /* Compute information */
-    info = _buffer_info_new(obj);
-    if (info == NULL) {
-        return NULL;
-    }
-
-    /* Check if it is identical with an old one; reuse old one, if yes */
     key = PyLong_FromVoidPtr((void*)obj);
     if (key == NULL) {
-        goto fail;
+        return NULL;
     }
     item_list = PyDict_GetItem(_buffer_info_cache, key);
 
     if (item_list != NULL) {
         Py_INCREF(item_list);
-        if (PyList_GET_SIZE(item_list) > 0) {
-            item = PyList_GetItem(item_list, PyList_GET_SIZE(item_list) - 1);
+        size = PyList_GET_SIZE(item_list);
+        if (size > 0 && PyArray_Check(obj)) {
+            /*
+             * Fast re-export: when the newest cached info still matches
+             * the array there is no need to rebuild the format string
+             * and shape/strides copies only to compare and discard them.
+             */
+            item = PyList_GET_ITEM(item_list, size - 1);
             old_info = (_buffer_info_t*)PyLong_AsVoidPtr(item);
-
-            if (_buffer_info_cmp(info, old_info) == 0) {
-                _buffer_info_free(info);
-                info = old_info;
+            if (_buffer_info_matches_array(old_info, (PyArrayObject *)obj)) {
+                Py_DECREF(item_list);
+                Py_DECREF(key);
+                return old_info;
             }
+            old_info = NULL;
         }
     }
     else {
@@ -684,13 +727,64 @@ _buffer_get_info(PyObject *obj)
         }
     }
 
+    /* Compute information */
+    info = _buffer_info_new(obj);
+    if (info == NULL) {
+        goto fail;
+    }
+
+    /*
+     * Check against all cached infos, newest first: an array that was
+     * re-exported after a shape or stride change may match an entry
+     * older than the newest one, and reusing it keeps the cache from
+     * accumulating duplicates when exports alternate between layouts.
+     */
+    for (k = size - 1; k >= 0; --k) {
+        item = PyList_GET_ITEM(item_list, k);
+        old_info = (_buffer_info_t*)PyLong_AsVoidPtr(item);
+        if (_buffer_info_cmp(info, old_info) == 0) {
+            /*
+             * Refresh the identity fields the fast path checks: the
+             * format can be unchanged even when the descr object or
+             * data pointer is not (the swap hands the old reference to
+             * _buffer_info_free below).
+             */
+            if (old_info->descr != info->descr) {
+                PyArray_Descr *tmp = old_info->descr;
+                old_info->descr = info->descr;
+                info->descr = tmp;
+            }
+            old_info->data = info->data;
+            _buffer_info_free(info);
+            info = old_info;
+            if (k != size - 1) {
+                /*
+                 * Move the match to the end, where both the fast path
+                 * and the first comparison above will find it.  Append
+                 * first so the entry stays referenced throughout.
+                 */
+                if (PyList_Append(item_list, item) != 0) {
+                    goto fail;
+                }
+                if (PySequence_DelItem(item_list, k) != 0) {
+                    goto fail;
+                }
+            }
+            break;
+        }
+        old_info = NULL;
+    }
+
     if (info != old_info) {
         /* Needs insertion */
         item = PyLong_FromVoidPtr((void*)info);
         if (item == NULL) {
             goto fail;
         }
-        PyList_Append(item_list, item);
+        if (PyList_Append(item_list, item) != 0) {
+            Py_DECREF(item);
+            goto fail;
+        }
         Py_DECREF(item);
     }
 
@@ -5,6 +5,9 @@
 #define NPY_NO_DEPRECATED_API NPY_API_VERSION
 #define _MULTIARRAYMODULE
 #include "numpy/arrayobject.h"
+#include "numpy/arrayscalars.h"
+#include "numpy/npy_math.h"
+#include "numpy/halffloat.h"
 #include "lowlevel_strided_loops.h"
 
 #include "npy_config.h"
@@ -304,6 +307,49 @@ PyArray_Min(PyArrayObject *ap, int axis, PyArrayObject *out)
     return ret;
 }
 
+/*
+ * Peak-to-peak of a contiguous lane: both extremes are found in a single
+ * traversal instead of separate max() and min() passes over the data. The
+ * compare-and-select pairs are branch-free so the loop vectorizes; NANCHECK
+ * lets the float variants propagate nans the way maximum()/minimum() do.
+ */
+#define PTP_LANE(type, suffix, NANCHECK, nanval)                        \
+static void                                                             \
+ptp_lane_##suffix(const char *data, npy_intp n, char *out_ptp)          \
+{                                                                       \
+    const type *p = (const type *)data;                                 \
+    type mn = p[0], mx = p[0];                                          \
+    int has_nan = NANCHECK(p[0]);                                       \
+    npy_intp i;                                                         \
+                                                                        \
+    for (i = 1; i < n; i++) {                                           \
+        type x = p[i];                                                  \
+        mn = x < mn ? x : mn;                                           \
+        mx = x > mx ? x : mx;                                           \
+        has_nan |= NANCHECK(x);                                         \
+    }                                                                   \
+    if (has_nan) {                                                      \
+        mn = nanval;                                                    \
+        mx = nanval;                                                    \
+    }                                                                   \
+    *(type *)out_ptp = mx - mn;                                         \
+}
+
+#define PTP_NO_NAN(x) 0
+
+PTP_LANE(npy_byte, byte, PTP_NO_NAN, 0)
+PTP_LANE(npy_ubyte, ubyte, PTP_NO_NAN, 0)
+PTP_LANE(npy_short, short, PTP_NO_NAN, 0)
+PTP_LANE(npy_ushort, ushort, PTP_NO_NAN, 0)
+PTP_LANE(npy_int, int, PTP_NO_NAN, 0)
+PTP_LANE(npy_uint, uint, PTP_NO_NAN, 0)
+PTP_LANE(npy_long, long, PTP_NO_NAN, 0)
+PTP_LANE(npy_ulong, ulong, PTP_NO_NAN, 0)
+PTP_LANE(npy_longlong, longlong, PTP_NO_NAN, 0)
+PTP_LANE(npy_ulonglong, ulonglong, PTP_NO_NAN, 0)
+PTP_LANE(npy_float, float, npy_isnan, NPY_NANF)
+PTP_LANE(npy_double, double, npy_isnan, NPY_NAN)
+
 /*NUMPY_API
  * Ptp
  */
@@ -318,6 +364,53 @@ PyArray_Ptp(PyArrayObject *ap, int axis, PyArrayObject *out)
     if (arr == NULL) {
         return NULL;
     }
+    if (out == NULL && PyArray_CheckExact(arr) &&
+            PyArray_NDIM(arr) > 0 && axis == PyArray_NDIM(arr) - 1 &&
+            PyArray_ISCONTIGUOUS(arr) && PyArray_DIM(arr, axis) > 0) {
+        void (*lanefunc)(const char *, npy_intp, char *) = NULL;
+
+        switch (PyArray_TYPE(arr)) {
+            case NPY_BYTE:      lanefunc = ptp_lane_byte;      break;
+            case NPY_UBYTE:     lanefunc = ptp_lane_ubyte;     break;
+            case NPY_SHORT:     lanefunc = ptp_lane_short;     break;
+            case NPY_USHORT:    lanefunc = ptp_lane_ushort;    break;
+            case NPY_INT:       lanefunc = ptp_lane_int;       break;
+            case NPY_UINT:      lanefunc = ptp_lane_uint;      break;
+            case NPY_LONG:      lanefunc = ptp_lane_long;      break;
+            case NPY_ULONG:     lanefunc = ptp_lane_ulong;     break;
+            case NPY_LONGLONG:  lanefunc = ptp_lane_longlong;  break;
+            case NPY_ULONGLONG: lanefunc = ptp_lane_ulonglong; break;
+            case NPY_FLOAT:     lanefunc = ptp_lane_float;     break;
+            case NPY_DOUBLE:    lanefunc = ptp_lane_double;    break;
+        }
+        if (lanefunc != NULL) {
+            PyArrayObject *res;
+            npy_intp lane = PyArray_DIM(arr, axis);
+            npy_intp nlanes = PyArray_SIZE(arr) / lane;
+            npy_intp elsize = PyArray_DESCR(arr)->elsize;
+            const char *src = PyArray_BYTES(arr);
+            char *dst;
+            npy_intp k;
+            NPY_BEGIN_THREADS_DEF;
+
+            res = (PyArrayObject *)PyArray_NewFromDescr(
+                    &PyArray_Type, PyArray_DescrFromType(PyArray_TYPE(arr)),
+                    PyArray_NDIM(arr) - 1, PyArray_DIMS(arr),
+                    NULL, NULL, 0, NULL);
+            if (res == NULL) {
+                Py_DECREF(arr);
+                return NULL;
+            }
+            dst = PyArray_BYTES(res);
+            NPY_BEGIN_THREADS_THRESHOLDED(PyArray_SIZE(arr));
+            for (k = 0; k < nlanes; k++) {
+                lanefunc(src + k * lane * elsize, lane, dst + k * elsize);
+            }
+            NPY_END_THREADS;
+            Py_DECREF(arr);
+            return PyArray_Return(res);
+        }
+    }
     obj1 = PyArray_Max(arr, axis, out);
     if (obj1 == NULL) {
         goto fail;
@@ -346,6 +439,62 @@ PyArray_Ptp(PyArrayObject *ap, int axis, PyArrayObject *out)
 
 
 
+/* block size (elements) for the cache-resident two-pass inner step */
+#define NPY_WELFORD_BLOCK 1024
+
+/*
+ * Mean and sum of squared deviations of a contiguous lane in a single
+ * traversal of memory. Each cache-resident block is reduced with a
+ * local two-pass (block mean, then squared deviations from it, both of
+ * which vectorize), and the block moments are merged into the running
+ * ones with the parallel Welford combination, giving two-pass accuracy
+ * without re-reading the data.
+ */
+#define WELFORD_LANE(type, suffix)                                      \
+static void                                                             \
+welford_lane_##suffix(const type *p, npy_intp n, type *out_mean,        \
+                      type *out_m2)                                     \
+{                                                                       \
+    npy_intp i = 0, j, blen;                                            \
+    type mean = 0, m2 = 0, count = 0;                                   \
+                                                                        \
+    while (i < n) {                                                     \
+        type bsum = 0, bmean, bm2 = 0, bn, delta, tot;                  \
+        blen = n - i;                                                   \
+        if (blen > NPY_WELFORD_BLOCK) {                                 \
+            blen = NPY_WELFORD_BLOCK;                                   \
+        }                                                               \
+        bn = (type)blen;                                                \
+        for (j = 0; j < blen; j++) {                                    \
+            bsum += p[i + j];                                           \
+        }                                                               \
+        bmean = bsum / bn;                                              \
+        for (j = 0; j < blen; j++) {                                    \
+            type d = p[i + j] - bmean;                                  \
+            bm2 += d * d;                                               \
+        }                                                               \
+        if (count == 0) {                                               \
+            mean = bmean;                                               \
+            m2 = bm2;                                                   \
+            count = bn;                                                 \
+        }                                                               \
+        else {                                                          \
+            delta = bmean - mean;                                       \
+            tot = count + bn;                                           \
+            mean += delta * (bn / tot);                                 \
+            m2 += bm2 + delta * delta * (count * (bn / tot));           \
+            count = tot;                                                \
+        }                                                               \
+        i += blen;                                                      \
+    }                                                                   \
+    *out_mean = mean;                                                   \
+    *out_m2 = m2;                                                       \
+}
+
+WELFORD_LANE(npy_float, float)
+WELFORD_LANE(npy_double, double)
+#undef WELFORD_LANE
+
 /*NUMPY_API
  * Set variance to 1 to by-pass square-root calculation and return variance
  * Std
@@ -371,6 +520,80 @@ __New_PyArray_Std(PyArrayObject *self, int axis, int rtype, PyArrayObject *out,
     if (arrnew == NULL) {
         return NULL;
     }
+
+    /*
+     * Single-traversal fast path: float/double data reduced over a
+     * contiguous last axis with matching accumulation type. Each output
+     * lane gets its mean and variance from one pass of the blocked
+     * Welford kernel instead of the mean/subtract/square/sum chain,
+     * which reads the data four times and materializes two temporaries.
+     */
+    if (!PyArray_ISCOMPLEX(arrnew) &&
+            (PyArray_TYPE(arrnew) == NPY_FLOAT ||
+             PyArray_TYPE(arrnew) == NPY_DOUBLE) &&
+            rtype == PyArray_TYPE(arrnew) &&
+            axis == PyArray_NDIM(arrnew) - 1 &&
+            PyArray_ISCONTIGUOUS(arrnew) &&
+            PyArray_DIM(arrnew, axis) > 0) {
+        PyArrayObject *res;
+        npy_intp lane = PyArray_DIM(arrnew, axis);
+        npy_intp nlanes = PyArray_SIZE(arrnew) / lane;
+        npy_intp k, ddiv;
+
+        ddiv = lane - num;
+        if (ddiv == 0) {
+            ddiv = 1;
+        }
+        res = (PyArrayObject *)PyArray_NewFromDescr(
+                &PyArray_Type, PyArray_DescrFromType(rtype),
+                PyArray_NDIM(arrnew) - 1, PyArray_DIMS(arrnew),
+                NULL, NULL, 0, NULL);
+        if (res == NULL) {
+            Py_DECREF(arrnew);
+            return NULL;
+        }
+        {
+            NPY_BEGIN_THREADS_DEF;
+            NPY_BEGIN_THREADS_THRESHOLDED(PyArray_SIZE(arrnew));
+            if (rtype == NPY_DOUBLE) {
+                const npy_double *src = (const npy_double *)PyArray_DATA(arrnew);
+                npy_double *dst = (npy_double *)PyArray_DATA(res);
+
+                for (k = 0; k < nlanes; k++) {
+                    npy_double m, m2;
+
+                    welford_lane_double(src + k * lane, lane, &m, &m2);
+                    dst[k] = m2 / (npy_double)ddiv;
+                    if (!variance) {
+                        dst[k] = npy_sqrt(dst[k]);
+                    }
+                }
+            }
+            else {
+                const npy_float *src = (const npy_float *)PyArray_DATA(arrnew);
+                npy_float *dst = (npy_float *)PyArray_DATA(res);
+
+                for (k = 0; k < nlanes; k++) {
+                    npy_float m, m2;
+
+                    welford_lane_float(src + k * lane, lane, &m, &m2);
+                    dst[k] = m2 / (npy_float)ddiv;
+                    if (!variance) {
+                        dst[k] = npy_sqrtf(dst[k]);
+                    }
+                }
+            }
+            NPY_END_THREADS;
+        }
+        Py_DECREF(arrnew);
+        /* match the generic path, which collapses 0-d results to scalars */
+        ret = PyArray_Return(res);
+        if (ret == NULL) {
+            return NULL;
+        }
+        goto wrap_result;
+    }
+
     /* Compute and reshape mean */
     arr1 = (PyArrayObject *)PyArray_EnsureAnyArray(
                     PyArray_Mean(arrnew, axis, rtype, NULL));
@@ -485,6 +708,8 @@ __New_PyArray_Std(PyArrayObject *self, int axis, int rtype, PyArrayObject *out,
     if (ret == NULL) {
         return NULL;
     }
+
+wrap_result:
     if (PyArray_CheckExact(self)) {
         goto finish;
     }
@@ -786,6 +1011,147 @@ PyArray_Mean(PyArrayObject *self, int axis, int rtype, PyArrayObject *out)
     return ret;
 }
 
+/*
+ * Scans a contiguous block of booleans for a byte with truth value
+ * `target`, testing 64 byte blocks at a time.  Returns the index of the
+ * first hit, or n when there is none.
+ */
+static NPY_INLINE npy_intp
+_scan_bool_block(const char *data, npy_intp n, int target)
+{
+    const char *d = data;
+
+    if (!target) {
+        const char *hit = memchr(data, 0, n);
+        return (hit == NULL) ? n : hit - data;
+    }
+    else {
+        const char *blocked_end = data + (n - (n % 64));
+
+        for (; d < blocked_end; d += 64) {
+            npy_uint64 w[8];
+
+            memcpy(w, d, sizeof(w));
+            if ((w[0] | w[1] | w[2] | w[3] |
+                 w[4] | w[5] | w[6] | w[7]) != 0) {
+                break;
+            }
+        }
+        for (; d < data + n; d++) {
+            if (*d != 0) {
+                break;
+            }
+        }
+        return d - data;
+    }
+}
+
+/*
+ * Early-exit engine for All/Any over the flattened array: walk the
+ * operand with the dtype's nonzero test and stop at the first decisive
+ * element (first false for all(), first true for any()).  The generic
+ * reduction instead ravels the operand (copying it when it is not
+ * contiguous) and casts every element to boolean, which wastes the whole
+ * scan when the verdict falls in the first few blocks.
+ *
+ * stop_on_true is 1 for any() and 0 for all(); the verdict is written to
+ * *result.  Returns 0 on success, -1 on error.
+ */
+NPY_NO_EXPORT int
+_decisive_all_any(PyArrayObject *self, int stop_on_true, npy_bool *result)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(self);
+    PyArray_NonzeroFunc *nonzero = dtype->f->nonzero;
+    int is_bool = (dtype->type_num == NPY_BOOL);
+    char *data;
+    npy_intp stride, count, i;
+    int decided = 0;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    /* If it's a trivial one-dimensional loop, don't use an iterator */
+    if (PyArray_TRIVIALLY_ITERABLE(self)) {
+        PyArray_PREPARE_TRIVIAL_ITERATION(self, count, data, stride);
+
+        NPY_BEGIN_THREADS_THRESHOLDED(count);
+        if (is_bool && stride == 1) {
+            decided = (_scan_bool_block(data, count, stop_on_true) < count);
+        }
+        else {
+            for (i = 0; i < count; i++, data += stride) {
+                if ((nonzero(data, self) != 0) == stop_on_true) {
+                    decided = 1;
+                    break;
+                }
+            }
+        }
+        NPY_END_THREADS;
+    }
+    else if (PyArray_SIZE(self) == 0) {
+        /* the iterator rejects size zero arrays */
+        decided = 0;
+    }
+    else {
+        NpyIter *iter;
+        NpyIter_IterNextFunc *iternext;
+        char **dataptr;
+        npy_intp *strideptr, *innersizeptr;
+
+        iter = NpyIter_New(self, NPY_ITER_READONLY |
+                                 NPY_ITER_EXTERNAL_LOOP,
+                           NPY_KEEPORDER, NPY_NO_CASTING, NULL);
+        if (iter == NULL) {
+            return -1;
+        }
+        iternext = NpyIter_GetIterNext(iter, NULL);
+        if (iternext == NULL) {
+            NpyIter_Deallocate(iter);
+            return -1;
+        }
+        dataptr = NpyIter_GetDataPtrArray(iter);
+        strideptr = NpyIter_GetInnerStrideArray(iter);
+        innersizeptr = NpyIter_GetInnerLoopSizePtr(iter);
+
+        NPY_BEGIN_THREADS_NDITER(iter);
+        do {
+            data = *dataptr;
+            stride = *strideptr;
+            count = *innersizeptr;
+
+            if (is_bool && stride == 1) {
+                decided = (_scan_bool_block(data, count, stop_on_true)
+                           < count);
+            }
+            else {
+                for (i = 0; i < count; i++, data += stride) {
+                    if ((nonzero(data, self) != 0) == stop_on_true) {
+                        decided = 1;
+                        break;
+                    }
+                }
+            }
+        } while (!decided && iternext(iter));
+        NPY_END_THREADS;
+        NpyIter_Deallocate(iter);
+    }
+
+    *result = (npy_bool)(decided ? stop_on_true : !stop_on_true);
+    return 0;
+}
+
+/*
+ * The early-exit engine only covers the dtypes whose truth test matches
+ * what the boolean cast in the reduction would produce; anything else
+ * (including swapped data, where the raw nonzero test is wrong for
+ * floats) keeps going through the reduction machinery.
+ */
+NPY_NO_EXPORT int
+_decisive_all_any_applies(PyArrayObject *arr)
+{
+    return ((PyArray_ISBOOL(arr) || PyArray_ISNUMBER(arr)) &&
+            PyArray_ISNOTSWAPPED(arr));
+}
+
 /*NUMPY_API
  * Any
  */
@@ -794,6 +1160,19 @@ PyArray_Any(PyArrayObject *self, int axis, PyArrayObject *out)
 {
     PyObject *arr, *ret;
 
+    if (out == NULL && axis == NPY_MAXDIMS &&
+            _decisive_all_any_applies(self)) {
+        npy_bool result;
+
+        if (_decisive_all_any(self, 1, &result) < 0) {
+            return NULL;
+        }
+        if (result) {
+            PyArrayScalar_RETURN_TRUE;
+        }
+        PyArrayScalar_RETURN_FALSE;
+    }
+
     arr = PyArray_CheckAxis(self, &axis, 0);
     if (arr == NULL) {
         return NULL;
@@ -813,6 +1192,19 @@ PyArray_All(PyArrayObject *self, int axis, PyArrayObject *out)
 {
     PyObject *arr, *ret;
 
+    if (out == NULL && axis == NPY_MAXDIMS &&
+            _decisive_all_any_applies(self)) {
+        npy_bool result;
+
+        if (_decisive_all_any(self, 0, &result) < 0) {
+            return NULL;
+        }
+        if (result) {
+            PyArrayScalar_RETURN_TRUE;
+        }
+        PyArrayScalar_RETURN_FALSE;
+    }
+
     arr = PyArray_CheckAxis(self, &axis, 0);
     if (arr == NULL) {
         return NULL;
@@ -825,6 +1217,277 @@ PyArray_All(PyArrayObject *self, int axis, PyArrayObject *out)
 }
 
 
+#if defined NPY_HAVE_SSE2_INTRINSICS
+#include <emmintrin.h>
+#include <float.h>
+#endif
+
+/*
+ * Count the non-finite values in a contiguous block and record the
+ * index of the first one (relative to data) in *first when it is still
+ * -1.  A value is non-finite exactly when !(|x| <= MAX), which catches
+ * both infinities and nans in a single compare.
+ */
+static npy_intp
+_scan_nonfinite_float(const npy_float *data, npy_intp n, npy_intp *first)
+{
+    npy_intp i = 0, count = 0;
+
+#if defined NPY_HAVE_SSE2_INTRINSICS
+    if (n >= 16) {
+        const __m128 absmask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const __m128 fltmax = _mm_set1_ps(FLT_MAX);
+        static const npy_uint8 popcnt4[16] = {
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+        for (; i < n && !npy_is_aligned(data + i, 16); i++) {
+            if (!npy_isfinite(data[i])) {
+                count++;
+                if (*first < 0) {
+                    *first = i;
+                }
+            }
+        }
+        for (; i + 4 <= n; i += 4) {
+            __m128 a = _mm_load_ps(data + i);
+            __m128 r = _mm_cmpnle_ps(_mm_and_ps(a, absmask), fltmax);
+            int m = _mm_movemask_ps(r);
+
+            if (m != 0) {
+                if (*first < 0) {
+                    int j = 0;
+
+                    while (((m >> j) & 1) == 0) {
+                        j++;
+                    }
+                    *first = i + j;
+                }
+                count += popcnt4[m];
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (!npy_isfinite(data[i])) {
+            count++;
+            if (*first < 0) {
+                *first = i;
+            }
+        }
+    }
+    return count;
+}
+
+static npy_intp
+_scan_nonfinite_double(const npy_double *data, npy_intp n, npy_intp *first)
+{
+    npy_intp i = 0, count = 0;
+
+#if defined NPY_HAVE_SSE2_INTRINSICS
+    if (n >= 8) {
+        const __m128d absmask = _mm_castsi128_pd(
+                _mm_set_epi32(0x7fffffff, 0xffffffff,
+                              0x7fffffff, 0xffffffff));
+        const __m128d fltmax = _mm_set1_pd(DBL_MAX);
+
+        for (; i < n && !npy_is_aligned(data + i, 16); i++) {
+            if (!npy_isfinite(data[i])) {
+                count++;
+                if (*first < 0) {
+                    *first = i;
+                }
+            }
+        }
+        for (; i + 2 <= n; i += 2) {
+            __m128d a = _mm_load_pd(data + i);
+            __m128d r = _mm_cmpnle_pd(_mm_and_pd(a, absmask), fltmax);
+            int m = _mm_movemask_pd(r);
+
+            if (m != 0) {
+                if (*first < 0) {
+                    *first = i + ((m & 1) ? 0 : 1);
+                }
+                count += (m & 1) + (m >> 1);
+            }
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        if (!npy_isfinite(data[i])) {
+            count++;
+            if (*first < 0) {
+                *first = i;
+            }
+        }
+    }
+    return count;
+}
+
+/*
+ * Strided scalar scan for the remaining float and complex dtypes; base
+ * is the C-order flat index of the first element of the chunk.
+ */
+static npy_intp
+_scan_nonfinite_strided(int typenum, const char *data, npy_intp stride,
+                        npy_intp n, npy_intp base, npy_intp *first)
+{
+    npy_intp i, count = 0;
+
+#define NONFINITE_SCAN(test)                        \
+        for (i = 0; i < n; i++, data += stride) {   \
+            if (test) {                             \
+                count++;                            \
+                if (*first < 0) {                   \
+                    *first = base + i;              \
+                }                                   \
+            }                                       \
+        }                                           \
+        break;
+
+    switch (typenum) {
+        case NPY_HALF:
+            NONFINITE_SCAN(!npy_half_isfinite(*(npy_half *)data));
+        case NPY_FLOAT:
+            NONFINITE_SCAN(!npy_isfinite(*(npy_float *)data));
+        case NPY_DOUBLE:
+            NONFINITE_SCAN(!npy_isfinite(*(npy_double *)data));
+        case NPY_LONGDOUBLE:
+            NONFINITE_SCAN(!npy_isfinite(*(npy_longdouble *)data));
+        case NPY_CFLOAT:
+            NONFINITE_SCAN(
+                !(npy_isfinite(npy_crealf(*(npy_cfloat *)data)) &&
+                  npy_isfinite(npy_cimagf(*(npy_cfloat *)data))));
+        case NPY_CDOUBLE:
+            NONFINITE_SCAN(
+                !(npy_isfinite(npy_creal(*(npy_cdouble *)data)) &&
+                  npy_isfinite(npy_cimag(*(npy_cdouble *)data))));
+        case NPY_CLONGDOUBLE:
+            NONFINITE_SCAN(
+                !(npy_isfinite(npy_creall(*(npy_clongdouble *)data)) &&
+                  npy_isfinite(npy_cimagl(*(npy_clongdouble *)data))));
+    }
+
+#undef NONFINITE_SCAN
+
+    return count;
+}
+
+/*
+ * Fused validation scan: counts the non-finite values of a float or
+ * complex array and records the C-order flat index of the first one in
+ * a single pass over the data, instead of the two passes (plus a
+ * boolean temporary) that isfinite() followed by a reduction costs.
+ * Bool and integer arrays are always finite and report (0, -1).
+ *
+ * On success *count holds the number of non-finite elements and *first
+ * the flat index of the first one, or -1 when there is none.  Returns
+ * 0 on success, -1 on error (non-numeric dtypes raise TypeError).
+ */
+NPY_NO_EXPORT int
+_count_nonfinite(PyArrayObject *self, npy_intp *count, npy_intp *first)
+{
+    int typenum = PyArray_TYPE(self);
+    npy_intp n = PyArray_SIZE(self);
+
+    NPY_BEGIN_THREADS_DEF;
+
+    *count = 0;
+    *first = -1;
+
+    if (PyArray_ISBOOL(self) || PyArray_ISINTEGER(self)) {
+        return 0;
+    }
+    if (!PyArray_ISFLOAT(self) && !PyArray_ISCOMPLEX(self)) {
+        PyErr_Format(PyExc_TypeError,
+                "cannot classify elements of an array with type %s",
+                PyArray_DESCR(self)->typeobj->tp_name);
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    if (PyArray_IS_C_CONTIGUOUS(self) && PyArray_ISNOTSWAPPED(self) &&
+            PyArray_ISALIGNED(self) &&
+            (typenum == NPY_FLOAT || typenum == NPY_DOUBLE)) {
+        NPY_BEGIN_THREADS_THRESHOLDED(n);
+        if (typenum == NPY_FLOAT) {
+            *count = _scan_nonfinite_float(
+                    (const npy_float *)PyArray_DATA(self), n, first);
+        }
+        else {
+            *count = _scan_nonfinite_double(
+                    (const npy_double *)PyArray_DATA(self), n, first);
+        }
+        NPY_END_THREADS;
+    }
+    else {
+        /*
+         * Buffering delivers native, aligned, contiguous chunks in C
+         * order, so swapped or strided operands take the same kernels.
+         */
+        NpyIter *iter;
+        NpyIter_IterNextFunc *iternext;
+        char **dataptr;
+        npy_intp *strideptr, *innersizeptr;
+        npy_intp idx = 0;
+
+        iter = NpyIter_New(self, NPY_ITER_READONLY |
+                                 NPY_ITER_EXTERNAL_LOOP |
+                                 NPY_ITER_BUFFERED |
+                                 NPY_ITER_NBO |
+                                 NPY_ITER_ALIGNED,
+                           NPY_CORDER, NPY_SAFE_CASTING, NULL);
+        if (iter == NULL) {
+            return -1;
+        }
+        iternext = NpyIter_GetIterNext(iter, NULL);
+        if (iternext == NULL) {
+            NpyIter_Deallocate(iter);
+            return -1;
+        }
+        dataptr = NpyIter_GetDataPtrArray(iter);
+        strideptr = NpyIter_GetInnerStrideArray(iter);
+        innersizeptr = NpyIter_GetInnerLoopSizePtr(iter);
+
+        NPY_BEGIN_THREADS_NDITER(iter);
+        do {
+            char *data = *dataptr;
+            npy_intp stride = *strideptr;
+            npy_intp size = *innersizeptr;
+
+            if (typenum == NPY_FLOAT && stride == sizeof(npy_float)) {
+                npy_intp sub = -1;
+
+                *count += _scan_nonfinite_float(
+                        (const npy_float *)data, size, &sub);
+                if (*first < 0 && sub >= 0) {
+                    *first = idx + sub;
+                }
+            }
+            else if (typenum == NPY_DOUBLE &&
+                     stride == sizeof(npy_double)) {
+                npy_intp sub = -1;
+
+                *count += _scan_nonfinite_double(
+                        (const npy_double *)data, size, &sub);
+                if (*first < 0 && sub >= 0) {
+                    *first = idx + sub;
+                }
+            }
+            else {
+                *count += _scan_nonfinite_strided(typenum, data, stride,
+                                                  size, idx, first);
+            }
+            idx += size;
+        } while (iternext(iter));
+        NPY_END_THREADS;
+        NpyIter_Deallocate(iter);
+    }
+    return 0;
+}
+
+
 static PyObject *
 _GenericBinaryOutFunction(PyArrayObject *m1, PyObject *m2, PyArrayObject *out,
                           PyObject *op)
@@ -1244,6 +1907,192 @@ PyArray_Conjugate(PyArrayObject *self, PyArrayObject *out)
     }
 }
 
+/* base case size for the pairwise summation below, matches PW_BLOCKSIZE */
+#define TRACE_PW_BLOCKSIZE 128
+
+/*
+ * Strided pairwise summation. The blocking and accumulation order are
+ * the same as in pairwise_sum_@TYPE@ in the add loops, so the trace
+ * fast path below returns results bit-identical to add.reduce over the
+ * diagonal view.
+ */
+#define TRACE_PAIRWISE_SUM(name, type)                                  \
+static type                                                             \
+trace_pairwise_##name(char *a, npy_intp n, npy_intp stride)             \
+{                                                                       \
+    if (n < 8) {                                                        \
+        npy_intp i;                                                     \
+        type res = 0;                                                   \
+                                                                        \
+        for (i = 0; i < n; i++) {                                       \
+            res += *(type *)(a + i * stride);                           \
+        }                                                               \
+        return res;                                                     \
+    }                                                                   \
+    else if (n <= TRACE_PW_BLOCKSIZE) {                                 \
+        npy_intp i;                                                     \
+        type r[8], res;                                                 \
+                                                                        \
+        r[0] = *(type *)(a + 0 * stride);                               \
+        r[1] = *(type *)(a + 1 * stride);                               \
+        r[2] = *(type *)(a + 2 * stride);                               \
+        r[3] = *(type *)(a + 3 * stride);                               \
+        r[4] = *(type *)(a + 4 * stride);                               \
+        r[5] = *(type *)(a + 5 * stride);                               \
+        r[6] = *(type *)(a + 6 * stride);                               \
+        r[7] = *(type *)(a + 7 * stride);                               \
+                                                                        \
+        for (i = 8; i < n - (n % 8); i += 8) {                          \
+            r[0] += *(type *)(a + (i + 0) * stride);                    \
+            r[1] += *(type *)(a + (i + 1) * stride);                    \
+            r[2] += *(type *)(a + (i + 2) * stride);                    \
+            r[3] += *(type *)(a + (i + 3) * stride);                    \
+            r[4] += *(type *)(a + (i + 4) * stride);                    \
+            r[5] += *(type *)(a + (i + 5) * stride);                    \
+            r[6] += *(type *)(a + (i + 6) * stride);                    \
+            r[7] += *(type *)(a + (i + 7) * stride);                    \
+        }                                                               \
+                                                                        \
+        res = ((r[0] + r[1]) + (r[2] + r[3])) +                         \
+              ((r[4] + r[5]) + (r[6] + r[7]));                          \
+                                                                        \
+        for (; i < n; i++) {                                            \
+            res += *(type *)(a + i * stride);                           \
+        }                                                               \
+        return res;                                                     \
+    }                                                                   \
+    else {                                                              \
+        npy_intp n2 = n / 2;                                            \
+                                                                        \
+        n2 -= n2 % 8;                                                   \
+        return trace_pairwise_##name(a, n2, stride) +                   \
+               trace_pairwise_##name(a + n2 * stride, n - n2, stride);  \
+    }                                                                   \
+}
+
+TRACE_PAIRWISE_SUM(float, npy_float)
+TRACE_PAIRWISE_SUM(double, npy_double)
+
+#undef TRACE_PAIRWISE_SUM
+
+/*
+ * Fast path for the common trace call: sum the diagonal of an aligned,
+ * native-endian 2-d array of a simple numeric type directly, without
+ * materializing the diagonal view or paying the ufunc reduction setup.
+ * Returns NULL, with no error set, when the case is not handled and
+ * the generic path should run.
+ */
+static PyObject *
+_fast_2d_trace(PyArrayObject *self, int offset, int axis1, int axis2,
+               int rtype, PyArrayObject *out)
+{
+    int typenum;
+    npy_intp n1, n2, s1, s2, count, stride, i;
+    char *data;
+    npy_cdouble value_buf;
+    void *value = &value_buf;
+    PyArray_Descr *descr;
+    PyObject *ret;
+
+    if (out != NULL || !PyArray_CheckExact(self) ||
+            PyArray_NDIM(self) != 2 ||
+            !PyArray_ISALIGNED(self) || !PyArray_ISNOTSWAPPED(self)) {
+        return NULL;
+    }
+    typenum = PyArray_TYPE(self);
+    if (rtype != NPY_NOTYPE && rtype != typenum) {
+        return NULL;
+    }
+    switch (typenum) {
+        case NPY_FLOAT:
+        case NPY_DOUBLE:
+        case NPY_CFLOAT:
+        case NPY_CDOUBLE:
+        case NPY_LONG:
+        case NPY_LONGLONG:
+            break;
+        default:
+            return NULL;
+    }
+    if (axis1 < 0) {
+        axis1 += 2;
+    }
+    if (axis2 < 0) {
+        axis2 += 2;
+    }
+    if ((axis1 != 0 && axis1 != 1) || (axis2 != 0 && axis2 != 1) ||
+            axis1 == axis2) {
+        /* let the generic path raise */
+        return NULL;
+    }
+
+    n1 = PyArray_DIM(self, axis1);
+    n2 = PyArray_DIM(self, axis2);
+    s1 = PyArray_STRIDE(self, axis1);
+    s2 = PyArray_STRIDE(self, axis2);
+    data = PyArray_BYTES(self);
+    if (offset >= 0) {
+        count = n2 - offset < n1 ? n2 - offset : n1;
+        data += offset * s2;
+    }
+    else {
+        count = n1 + offset < n2 ? n1 + offset : n2;
+        data += (npy_intp)(-offset) * s1;
+    }
+    if (count < 0) {
+        count = 0;
+    }
+    stride = s1 + s2;
+
+    switch (typenum) {
+        case NPY_FLOAT:
+            *(npy_float *)value = trace_pairwise_float(data, count, stride);
+            break;
+        case NPY_DOUBLE:
+            *(npy_double *)value = trace_pairwise_double(data, count, stride);
+            break;
+        case NPY_CFLOAT: {
+            npy_cfloat *v = (npy_cfloat *)value;
+            v->real = trace_pairwise_float(data, count, stride);
+            v->imag = trace_pairwise_float(data + sizeof(npy_float),
+                                           count, stride);
+            break;
+        }
+        case NPY_CDOUBLE: {
+            npy_cdouble *v = (npy_cdouble *)value;
+            v->real = trace_pairwise_double(data, count, stride);
+            v->imag = trace_pairwise_double(data + sizeof(npy_double),
+                                            count, stride);
+            break;
+        }
+        case NPY_LONG: {
+            npy_long v = 0;
+            for (i = 0; i < count; i++) {
+                v += *(npy_long *)(data + i * stride);
+            }
+            *(npy_long *)value = v;
+            break;
+        }
+        default: {
+            npy_longlong v = 0;
+            for (i = 0; i < count; i++) {
+                v += *(npy_longlong *)(data + i * stride);
+            }
+            *(npy_longlong *)value = v;
+            break;
+        }
+    }
+
+    descr = PyArray_DescrFromType(typenum);
+    if (descr == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    ret = PyArray_Scalar(value, descr, NULL);
+    Py_DECREF(descr);
+    return ret;
+}
+
 /*NUMPY_API
  * Trace
  */
@@ -1253,6 +2102,11 @@ PyArray_Trace(PyArrayObject *self, int offset, int axis1, int axis2,
 {
     PyObject *diag = NULL, *ret = NULL;
 
+    ret = _fast_2d_trace(self, offset, axis1, axis2, rtype, out);
+    if (ret != NULL) {
+        return ret;
+    }
+
     diag = PyArray_Diagonal(self, offset, axis1, axis2);
     if (diag == NULL) {
         return NULL;
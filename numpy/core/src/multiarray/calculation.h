@@ -61,4 +61,13 @@ PyArray_All(PyArrayObject* self, int axis, PyArrayObject* out);
 NPY_NO_EXPORT PyObject*
 PyArray_Any(PyArrayObject* self, int axis, PyArrayObject* out);
 
+NPY_NO_EXPORT int
+_decisive_all_any(PyArrayObject *self, int stop_on_true, npy_bool *result);
+
+NPY_NO_EXPORT int
+_decisive_all_any_applies(PyArrayObject *arr);
+
+NPY_NO_EXPORT int
+_count_nonfinite(PyArrayObject *self, npy_intp *count, npy_intp *first);
+
 #endif
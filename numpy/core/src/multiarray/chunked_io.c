@@ -0,0 +1,303 @@
+/*
+ * Chunked binary file transfers for contiguous arrays.
+ *
+ * The stdio based tofile/fromfile paths move the whole array through a
+ * single fread/fwrite on one thread, which on fast NVMe devices leaves
+ * most of the device bandwidth unused.  For large transfers to regular
+ * files this module issues positioned reads and writes (pread/pwrite)
+ * directly on the descriptor in chunks of a configurable size, split
+ * across the shared worker pool like the threaded sort engine.
+ * Positioned I/O keeps the workers independent:
+ * no shared file offset is updated, so the chunks can land in any order.
+ *
+ * When NPY_FILE_IO_DIRECT is set the aligned body of the transfer is
+ * additionally done with O_DIRECT where the OS provides it, bypassing
+ * the page cache for data that is typically far too large to be read
+ * back from it anyway.  The flag is restored and any unaligned tail is
+ * transferred through the cache as usual, and file systems that refuse
+ * O_DIRECT simply fall back to cached positioned I/O.
+ *
+ * The engine declines (returns 0) for pipes, sockets, append mode
+ * descriptors and small transfers, so the stdio paths remain the ones
+ * actually exercised in those cases.
+ */
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+
+#include <Python.h>
+
+#include <stdlib.h>
+
+#include "npy_config.h"
+#include "numpy/ndarraytypes.h"
+#include "npy_workpool.h"
+#include "chunked_io.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <errno.h>
+
+/* do not bother bypassing stdio below this many bytes */
+#define NPY_CHUNKED_IO_THRESHOLD (16 * 1024 * 1024)
+/* default bytes per system call */
+#define NPY_CHUNKED_IO_BUFSIZE (16 * 1024 * 1024)
+/* upper bound for NPY_FILE_IO_THREADS */
+#define NPY_CHUNKED_IO_MAX_THREADS 128
+/* O_DIRECT wants the offset, address and length aligned to this */
+#define NPY_CHUNKED_IO_ALIGN 4096
+
+static int
+chunked_io_nthreads(void)
+{
+    static int nthreads = -1;
+
+    if (nthreads < 0) {
+        char *env = getenv("NPY_FILE_IO_THREADS");
+        nthreads = 1;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > NPY_CHUNKED_IO_MAX_THREADS) {
+                val = NPY_CHUNKED_IO_MAX_THREADS;
+            }
+            if (val > 1) {
+                nthreads = (int)val;
+            }
+        }
+    }
+    return nthreads;
+}
+
+static npy_intp
+chunked_io_bufsize(void)
+{
+    static npy_intp bufsize = -1;
+
+    if (bufsize < 0) {
+        char *env = getenv("NPY_FILE_IO_BUFSIZE");
+        bufsize = NPY_CHUNKED_IO_BUFSIZE;
+        if (env != NULL && env[0] != '\0') {
+            long long val = strtoll(env, NULL, 10);
+            /* round down to the direct I/O granularity */
+            val -= val % NPY_CHUNKED_IO_ALIGN;
+            if (val >= NPY_CHUNKED_IO_ALIGN && val <= NPY_MAX_INTP) {
+                bufsize = (npy_intp)val;
+            }
+        }
+    }
+    return bufsize;
+}
+
+static int
+chunked_io_want_direct(void)
+{
+    static int want = -1;
+
+    if (want < 0) {
+        char *env = getenv("NPY_FILE_IO_DIRECT");
+        want = (env != NULL && env[0] != '\0' && env[0] != '0');
+    }
+    return want;
+}
+
+typedef struct {
+    int fd;
+    int is_write;
+    char *data;
+    npy_off_t offset;
+    npy_intp nbytes;
+    npy_intp bufsize;
+    /* bytes actually transferred, from the start of the chunk */
+    npy_intp transferred;
+} chunked_io_task;
+
+static void
+chunked_io_run(npy_intp t, void *arg)
+{
+    chunked_io_task *task = (chunked_io_task *)arg + t;
+    npy_intp pos = 0;
+
+    while (pos < task->nbytes) {
+        size_t todo = (size_t)task->bufsize;
+        ssize_t r;
+
+        if ((npy_intp)todo > task->nbytes - pos) {
+            todo = (size_t)(task->nbytes - pos);
+        }
+        if (task->is_write) {
+            r = pwrite(task->fd, task->data + pos, todo, task->offset + pos);
+        }
+        else {
+            r = pread(task->fd, task->data + pos, todo, task->offset + pos);
+        }
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (r == 0) {
+            /* end of file on read, or no progress on write */
+            break;
+        }
+        pos += (npy_intp)r;
+    }
+    task->transferred = pos;
+}
+
+/*
+ * Transfer nbytes between data and fd starting at offset, split across
+ * the worker pool.  Returns the length of the contiguous prefix that was
+ * transferred; a failed chunk truncates the result at its own position
+ * so a short count never hides a hole left by a later chunk.
+ */
+static npy_intp
+chunked_io_transfer(int fd, int is_write, char *data, npy_off_t offset,
+                    npy_intp nbytes)
+{
+    chunked_io_task tasks[NPY_CHUNKED_IO_MAX_THREADS];
+    npy_intp bufsize = chunked_io_bufsize();
+    npy_intp chunksize, start, total;
+    int i, nchunks;
+
+    nchunks = chunked_io_nthreads();
+    if (nbytes / nchunks < bufsize) {
+        nchunks = (int)(nbytes / bufsize);
+    }
+    if (nchunks < 1) {
+        nchunks = 1;
+    }
+    chunksize = nbytes / nchunks;
+    /* keep every chunk boundary aligned for O_DIRECT */
+    chunksize -= chunksize % NPY_CHUNKED_IO_ALIGN;
+    if (chunksize < 1) {
+        chunksize = nbytes;
+        nchunks = 1;
+    }
+
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        tasks[i].fd = fd;
+        tasks[i].is_write = is_write;
+        tasks[i].data = data + start;
+        tasks[i].offset = offset + start;
+        tasks[i].nbytes = (i == nchunks - 1) ? (nbytes - start) : chunksize;
+        tasks[i].bufsize = bufsize;
+        tasks[i].transferred = 0;
+        start += chunksize;
+    }
+    npy_parallel_for(nchunks, chunked_io_run, tasks, chunked_io_nthreads());
+
+    total = 0;
+    for (i = 0; i < nchunks; i++) {
+        total += tasks[i].transferred;
+        if (tasks[i].transferred < tasks[i].nbytes) {
+            break;
+        }
+    }
+    return total;
+}
+
+static int
+npy_chunked_transfer(FILE *fp, char *data, npy_intp nbytes, int is_write,
+                     npy_intp *ntransferred)
+{
+    struct stat st;
+    npy_off_t offset;
+    npy_intp total, body;
+    int fd, flags, direct = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (nbytes < NPY_CHUNKED_IO_THRESHOLD) {
+        return 0;
+    }
+    fd = fileno(fp);
+    if (fd < 0) {
+        return 0;
+    }
+    /* positioned I/O needs a seekable regular file */
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        return 0;
+    }
+    flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || (flags & O_APPEND)) {
+        /*
+         * pwrite appends regardless of the offset on O_APPEND
+         * descriptors (on Linux), which would scramble the chunks
+         */
+        return 0;
+    }
+    if (is_write && fflush(fp) != 0) {
+        return 0;
+    }
+    offset = npy_ftell(fp);
+    if (offset < 0) {
+        return 0;
+    }
+
+    body = nbytes;
+#ifdef O_DIRECT
+    if (chunked_io_want_direct()
+            && offset % NPY_CHUNKED_IO_ALIGN == 0
+            && (size_t)data % NPY_CHUNKED_IO_ALIGN == 0
+            && nbytes >= 2 * NPY_CHUNKED_IO_ALIGN
+            && fcntl(fd, F_SETFL, flags | O_DIRECT) == 0) {
+        /* the unaligned tail goes through the cache afterwards */
+        body = nbytes - nbytes % NPY_CHUNKED_IO_ALIGN;
+        direct = 1;
+    }
+#endif
+
+    NPY_BEGIN_THREADS;
+    total = chunked_io_transfer(fd, is_write, data, offset, body);
+#ifdef O_DIRECT
+    if (direct) {
+        fcntl(fd, F_SETFL, flags);
+        if (total == body && body < nbytes) {
+            total += chunked_io_transfer(fd, is_write, data + body,
+                                         offset + body, nbytes - body);
+        }
+    }
+#endif
+    NPY_END_THREADS;
+
+    /*
+     * resynchronize the stdio position with the bytes transferred; the
+     * data has already moved, so a seek failure cannot be recovered from
+     * and the short count (if any) is reported either way
+     */
+    npy_fseek(fp, offset + total, SEEK_SET);
+    *ntransferred = total;
+    return 1;
+}
+
+NPY_NO_EXPORT int
+npy_chunked_write(FILE *fp, const void *data, npy_intp nbytes,
+                  npy_intp *nwritten)
+{
+    return npy_chunked_transfer(fp, (char *)data, nbytes, 1, nwritten);
+}
+
+NPY_NO_EXPORT int
+npy_chunked_read(FILE *fp, void *data, npy_intp nbytes, npy_intp *nread)
+{
+    return npy_chunked_transfer(fp, (char *)data, nbytes, 0, nread);
+}
+
+#else
+
+NPY_NO_EXPORT int
+npy_chunked_write(FILE *fp, const void *data, npy_intp nbytes,
+                  npy_intp *nwritten)
+{
+    return 0;
+}
+
+NPY_NO_EXPORT int
+npy_chunked_read(FILE *fp, void *data, npy_intp nbytes, npy_intp *nread)
+{
+    return 0;
+}
+
+#endif
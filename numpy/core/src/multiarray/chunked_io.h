@@ -0,0 +1,35 @@
+#ifndef _NPY_PRIVATE__CHUNKED_IO_H_
+#define _NPY_PRIVATE__CHUNKED_IO_H_
+
+/*
+ * Chunked (and optionally threaded) binary file transfers for contiguous
+ * arrays, used by the tofile/fromfile fast paths.  The transfers bypass
+ * stdio and issue positioned reads/writes on the underlying descriptor,
+ * so large arrays are not squeezed through the stdio buffer one copy at
+ * a time.  Tunables, all read from the environment on first use:
+ *
+ *   NPY_FILE_IO_BUFSIZE  bytes per system call (default 16 MiB)
+ *   NPY_FILE_IO_THREADS  worker threads for one transfer (default 1)
+ *   NPY_FILE_IO_DIRECT   set to 1 to request O_DIRECT for the aligned
+ *                        part of the transfer where the OS supports it
+ */
+
+/*
+ * Write nbytes at data to fp.  Returns 1 if the chunked engine ran (with
+ * the number of bytes actually written stored in *nwritten) and 0 if the
+ * caller should use stdio instead (unsupported platform or descriptor,
+ * transfer too small).  The stream position is kept consistent with the
+ * bytes transferred.
+ */
+NPY_NO_EXPORT int
+npy_chunked_write(FILE *fp, const void *data, npy_intp nbytes,
+                  npy_intp *nwritten);
+
+/*
+ * Read nbytes from fp into data.  Same contract as npy_chunked_write;
+ * *nread may be short when the file ends before nbytes.
+ */
+NPY_NO_EXPORT int
+npy_chunked_read(FILE *fp, void *data, npy_intp nbytes, npy_intp *nread);
+
+#endif
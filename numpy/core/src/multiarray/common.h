@@ -129,6 +129,56 @@ check_and_adjust_index(npy_intp *index, npy_intp max_item, int axis,
     return 0;
 }
 
+/*
+ * Classifies a whole index array with one min/max scan, so the gather
+ * loop that follows can drop the per-element bounds check. The scan is
+ * a pair of branch-free reductions which the compiler vectorizes.
+ *
+ * Returns 0 if every index is already in [0, max_item), 1 if every
+ * index is in [-max_item, max_item) so only the negative-index
+ * adjustment is needed, and -1 if some index is out of bounds. No
+ * exception is set in the last case; the caller should fall back to
+ * its check_and_adjust_index loop to raise on the first bad index.
+ */
+static NPY_INLINE int
+check_indices_minmax(const npy_intp *indices, npy_intp n, npy_intp max_item)
+{
+    npy_intp i, min_ind, max_ind;
+
+    if (n <= 0) {
+        return 0;
+    }
+    min_ind = max_ind = indices[0];
+    for (i = 1; i < n; i++) {
+        npy_intp tmp = indices[i];
+        min_ind = tmp < min_ind ? tmp : min_ind;
+        max_ind = tmp > max_ind ? tmp : max_ind;
+    }
+    if (NPY_UNLIKELY(min_ind < -max_item || max_ind >= max_item)) {
+        return -1;
+    }
+    return min_ind < 0 ? 1 : 0;
+}
+
+/*
+ * Returns nonzero if the index array is monotonically non-decreasing.
+ * A gather with sorted indices walks the source forward, so runs of
+ * consecutive indices can be merged into single block copies and the
+ * hardware prefetcher covers the rest.
+ */
+static NPY_INLINE int
+check_indices_sorted(const npy_intp *indices, npy_intp n)
+{
+    npy_intp i;
+
+    for (i = 1; i < n; i++) {
+        if (indices[i] < indices[i - 1]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /*
  * Returns -1 and sets an exception if *axis is an invalid axis for
  * an array of dimension ndim, otherwise adjusts it in place to be
@@ -255,10 +305,23 @@ npy_memchr(char * haystack, char needle,
 
     if (!invert) {
         /*
-         * this is usually the path to determine elements to process,
-         * performance less important here.
+         * this is the path to determine elements to process,
          * memchr has large setup cost if 0 byte is close to start.
          */
+        if (NPY_CPU_HAVE_UNALIGNED_ACCESS && needle == 0 && stride == 1) {
+            /* iterate until last multiple of 4 */
+            char * block_end = haystack + size - (size % sizeof(unsigned int));
+            while (p < block_end) {
+                unsigned int v = *(unsigned int*)p;
+                /* fails when any of the four bytes is the 0 needle */
+                if ((v - 0x01010101u) & ~v & 0x80808080u) {
+                    break;
+                }
+                p += sizeof(unsigned int);
+            }
+            /* handle rest */
+            subloopsize = (p - haystack);
+        }
         while (subloopsize < size && *p != needle) {
             subloopsize++;
             p += stride;
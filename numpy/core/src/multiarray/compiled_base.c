@@ -8,11 +8,13 @@
 #include "numpy/npy_3kcompat.h"
 #include "numpy/npy_math.h"
 #include "npy_config.h"
+#include "pythread.h"
 #include "templ_common.h" /* for npy_mul_with_overflow_intp */
 #include "lowlevel_strided_loops.h" /* for npy_bswap8 */
 #include "alloc.h"
 #include "ctors.h"
 #include "common.h"
+#include "ufunc_parallel.h" /* for npy_ufunc_nthreads */
 
 
 /*
@@ -72,21 +74,171 @@ minmax(const npy_intp *data, npy_intp data_len, npy_intp *mn, npy_intp *mx)
 {
     npy_intp min = *data;
     npy_intp max = *data;
+    npy_intp i;
 
-    while (--data_len) {
-        const npy_intp val = *(++data);
-        if (val < min) {
-            min = val;
-        }
-        else if (val > max) {
-            max = val;
-        }
+    /* branch-free compare-and-select pairs, so the scan vectorizes */
+    for (i = 1; i < data_len; i++) {
+        const npy_intp val = data[i];
+        min = val < min ? val : min;
+        max = val > max ? val : max;
     }
 
     *mn = min;
     *mx = max;
 }
 
+/* do not bother threading bin fills below this many elements */
+#define NPY_HISTOGRAM_PARALLEL_THRESHOLD 0x100000
+/* never hand a worker less than this many elements */
+#define NPY_HISTOGRAM_PARALLEL_MIN_CHUNK 0x10000
+/* private per-worker accumulators are only affordable up to here */
+#define NPY_BINCOUNT_PARALLEL_MAX_BINS 0x10000
+
+typedef struct {
+    const npy_intp *numbers;
+    npy_intp n;
+    const double *weights;  /* NULL when plain counting */
+    npy_intp *icounts;      /* private counts for this worker, or */
+    double *dcounts;        /* private weight sums when weighted */
+    /* released by the worker when its chunk is binned */
+    PyThread_type_lock done;
+} bincount_chunk;
+
+static void
+bincount_chunk_exec(bincount_chunk *chunk)
+{
+    npy_intp i;
+
+    if (chunk->weights == NULL) {
+        for (i = 0; i < chunk->n; i++) {
+            chunk->icounts[chunk->numbers[i]] += 1;
+        }
+    }
+    else {
+        for (i = 0; i < chunk->n; i++) {
+            chunk->dcounts[chunk->numbers[i]] += chunk->weights[i];
+        }
+    }
+}
+
+static void
+bincount_chunk_run(void *arg)
+{
+    bincount_chunk *chunk = (bincount_chunk *)arg;
+
+    bincount_chunk_exec(chunk);
+    PyThread_release_lock(chunk->done);
+}
+
+/*
+ * Scatter `len` indices (and optional weights) into `nbins` bins,
+ * splitting across the opt-in NPY_UFUNC_THREADS workers when the input
+ * is large and the bin table small enough that every worker can afford
+ * a private copy. The private bins are merged in chunk order at the
+ * end, so the scatter loops need no synchronization and the weighted
+ * sums are deterministic for a given thread count. Called without the
+ * GIL; exactly one of icounts/dcounts is non-NULL, matching weights.
+ */
+static void
+bincount_run(const npy_intp *numbers, npy_intp len, const double *weights,
+             npy_intp nbins, npy_intp *icounts, double *dcounts)
+{
+    bincount_chunk chunks[NPY_UFUNC_MAX_THREADS];
+    char *private_bins = NULL;
+    size_t binsize = (weights == NULL) ? sizeof(npy_intp) : sizeof(double);
+    npy_intp chunksize, start, j;
+    int i, nchunks;
+    int nthreads = npy_ufunc_nthreads();
+
+    nchunks = 1;
+    if (nthreads > 1 && len >= NPY_HISTOGRAM_PARALLEL_THRESHOLD &&
+            nbins <= NPY_BINCOUNT_PARALLEL_MAX_BINS) {
+        nchunks = nthreads;
+        if (len / nchunks < NPY_HISTOGRAM_PARALLEL_MIN_CHUNK) {
+            nchunks = (int)(len / NPY_HISTOGRAM_PARALLEL_MIN_CHUNK);
+        }
+    }
+    if (nchunks > 1) {
+        private_bins = calloc((size_t)(nchunks - 1) * nbins, binsize);
+    }
+    if (private_bins == NULL) {
+        /* threading disabled, not worthwhile, or no memory */
+        bincount_chunk chunk;
+
+        chunk.numbers = numbers;
+        chunk.n = len;
+        chunk.weights = weights;
+        chunk.icounts = icounts;
+        chunk.dcounts = dcounts;
+        bincount_chunk_exec(&chunk);
+        return;
+    }
+
+    chunksize = len / nchunks;
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].numbers = numbers + start;
+        chunks[i].n = (i == nchunks - 1) ? (len - start) : chunksize;
+        chunks[i].weights = (weights == NULL) ? NULL : weights + start;
+        if (i == 0) {
+            chunks[i].icounts = icounts;
+            chunks[i].dcounts = dcounts;
+        }
+        else if (weights == NULL) {
+            chunks[i].icounts = (npy_intp *)private_bins + (i - 1) * nbins;
+            chunks[i].dcounts = NULL;
+        }
+        else {
+            chunks[i].icounts = NULL;
+            chunks[i].dcounts = (double *)private_bins + (i - 1) * nbins;
+        }
+        chunks[i].done = NULL;
+        start += chunksize;
+    }
+
+    /* chunk 0 runs on the calling thread, the rest on workers */
+    for (i = 1; i < nchunks; i++) {
+        chunks[i].done = PyThread_allocate_lock();
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            if (PyThread_start_new_thread(bincount_chunk_run,
+                                          &chunks[i]) == -1) {
+                PyThread_release_lock(chunks[i].done);
+                PyThread_free_lock(chunks[i].done);
+                chunks[i].done = NULL;
+            }
+        }
+        if (chunks[i].done == NULL) {
+            /* could not start a worker, bin the chunk inline */
+            bincount_chunk_exec(&chunks[i]);
+        }
+    }
+
+    bincount_chunk_exec(&chunks[0]);
+
+    for (i = 1; i < nchunks; i++) {
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            PyThread_free_lock(chunks[i].done);
+        }
+    }
+
+    /* merge the private bins, in chunk order */
+    for (i = 1; i < nchunks; i++) {
+        if (weights == NULL) {
+            for (j = 0; j < nbins; j++) {
+                icounts[j] += chunks[i].icounts[j];
+            }
+        }
+        else {
+            for (j = 0; j < nbins; j++) {
+                dcounts[j] += chunks[i].dcounts[j];
+            }
+        }
+    }
+    free(private_bins);
+}
+
 /*
  * arr_bincount is registered as bincount.
  *
@@ -107,7 +259,6 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     PyArrayObject *lst = NULL, *ans = NULL, *wts = NULL;
     npy_intp *numbers, *ians, len, mx, mn, ans_size;
     npy_intp minlength = 0;
-    npy_intp i;
     double *weights , *dans;
     static char *kwlist[] = {"list", "weights", "minlength", NULL};
 
@@ -176,8 +327,7 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
         }
         ians = (npy_intp *)PyArray_DATA(ans);
         NPY_BEGIN_ALLOW_THREADS;
-        for (i = 0; i < len; i++)
-            ians[numbers[i]] += 1;
+        bincount_run(numbers, len, NULL, ans_size, ians, NULL);
         NPY_END_ALLOW_THREADS;
         Py_DECREF(lst);
     }
@@ -199,9 +349,7 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
         }
         dans = (double *)PyArray_DATA(ans);
         NPY_BEGIN_ALLOW_THREADS;
-        for (i = 0; i < len; i++) {
-            dans[numbers[i]] += weights[i];
-        }
+        bincount_run(numbers, len, weights, ans_size, NULL, dans);
         NPY_END_ALLOW_THREADS;
         Py_DECREF(lst);
         Py_DECREF(wts);
@@ -215,6 +363,787 @@ fail:
     return NULL;
 }
 
+/* Stafford's mix13 finalizer; avalanches all bits of a 64 bit key. */
+static NPY_INLINE npy_uint64
+unique_hash_int(npy_uint64 key)
+{
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+/* FNV-1a over the raw bytes of a fixed-width element */
+static NPY_INLINE npy_uint64
+unique_hash_bytes(const char *data, npy_intp len)
+{
+    npy_uint64 h = 0xcbf29ce484222325ULL;
+    npy_intp i;
+
+    for (i = 0; i < len; i++) {
+        h = (h ^ (npy_uint8)data[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/*
+ * Single pass over the data filling an open addressing table with linear
+ * probing. table maps hash slots to unique ids, first maps unique ids to
+ * the index of their first occurrence, which is what element comparisons
+ * run against. counts and inverse are filled when non-NULL. Returns the
+ * number of distinct elements.
+ */
+static npy_intp
+unique_hash_run(const char *data, npy_intp n, npy_intp itemsize,
+                npy_intp *table, npy_uintp mask, npy_intp *first,
+                npy_intp *counts, npy_intp *inverse)
+{
+    npy_intp i, nuniq = 0;
+
+    for (i = 0; i < n; i++) {
+        const char *elem = data + i * itemsize;
+        npy_uint64 h;
+        npy_uintp j;
+
+        if (itemsize <= (npy_intp)sizeof(npy_uint64)) {
+            npy_uint64 key = 0;
+            memcpy(&key, elem, itemsize);
+            h = unique_hash_int(key);
+        }
+        else {
+            h = unique_hash_bytes(elem, itemsize);
+        }
+        j = (npy_uintp)h & mask;
+        for (;;) {
+            npy_intp u = table[j];
+
+            if (u == -1) {
+                table[j] = nuniq;
+                first[nuniq] = i;
+                if (counts != NULL) {
+                    counts[nuniq] = 1;
+                }
+                if (inverse != NULL) {
+                    inverse[i] = nuniq;
+                }
+                nuniq++;
+                break;
+            }
+            if (memcmp(elem, data + first[u] * itemsize, itemsize) == 0) {
+                if (counts != NULL) {
+                    counts[u]++;
+                }
+                if (inverse != NULL) {
+                    inverse[i] = u;
+                }
+                break;
+            }
+            j = (j + 1) & mask;
+        }
+    }
+    return nuniq;
+}
+
+/*
+ * arr_unique_hash is registered as _unique_hash.
+ *
+ * Hash-set unique for 1-d arrays of integer, boolean, or byte-string
+ * dtype, O(n) instead of the sort-based O(n log n) path. Returns a tuple
+ * (unique, inverse, counts) where unique holds the distinct values in
+ * order of first appearance and inverse/counts are None unless requested.
+ * Elements are hashed and compared by their raw bytes, which matches
+ * value equality for these dtypes regardless of byte order. Producing
+ * the sorted order np.unique documents is left to the Python caller,
+ * which then only has the (typically small) set of distinct values to
+ * sort.
+ */
+NPY_NO_EXPORT PyObject *
+arr_unique_hash(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    PyObject *values = NULL, *ret = NULL;
+    PyArrayObject *arr = NULL, *uniq = NULL, *inv = NULL, *cnt = NULL;
+    PyArray_Descr *descr;
+    char *data, *uniq_data;
+    npy_intp *table = NULL, *first = NULL;
+    npy_intp *counts = NULL, *inv_data = NULL, *cnt_data;
+    npy_intp n, i, nuniq, itemsize;
+    npy_uintp msize, mask;
+    int return_inverse = 0, return_counts = 0;
+    static char *kwlist[] = {"values", "return_inverse", "return_counts",
+                             NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ii:_unique_hash", kwlist,
+                &values, &return_inverse, &return_counts)) {
+        return NULL;
+    }
+
+    arr = (PyArrayObject *)PyArray_FromAny(values, NULL, 1, 1,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+    if (arr == NULL) {
+        return NULL;
+    }
+    descr = PyArray_DESCR(arr);
+    if (!PyTypeNum_ISINTEGER(descr->type_num) &&
+            !PyTypeNum_ISBOOL(descr->type_num) &&
+            descr->type_num != NPY_STRING) {
+        PyErr_SetString(PyExc_TypeError,
+                "_unique_hash only supports integer, boolean and "
+                "byte-string arrays");
+        goto fail;
+    }
+
+    n = PyArray_SIZE(arr);
+    itemsize = descr->elsize;
+    data = PyArray_DATA(arr);
+
+    if (n > NPY_MAX_INTP / 4) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    msize = 16;
+    while (msize < (npy_uintp)n * 2) {
+        msize <<= 1;
+    }
+    mask = msize - 1;
+
+    table = PyArray_malloc(msize * sizeof(npy_intp));
+    first = PyArray_malloc((n > 0 ? n : 1) * sizeof(npy_intp));
+    if (table == NULL || first == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    memset(table, -1, msize * sizeof(npy_intp));
+
+    if (return_counts) {
+        counts = PyArray_malloc((n > 0 ? n : 1) * sizeof(npy_intp));
+        if (counts == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+    }
+    if (return_inverse) {
+        inv = (PyArrayObject *)PyArray_SimpleNew(1, &n, NPY_INTP);
+        if (inv == NULL) {
+            goto fail;
+        }
+        inv_data = (npy_intp *)PyArray_DATA(inv);
+    }
+
+    NPY_BEGIN_ALLOW_THREADS;
+    nuniq = unique_hash_run(data, n, itemsize, table, mask, first,
+                            counts, inv_data);
+    NPY_END_ALLOW_THREADS;
+
+    Py_INCREF(descr);
+    uniq = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type, descr,
+                1, &nuniq, NULL, NULL, 0, NULL);
+    if (uniq == NULL) {
+        goto fail;
+    }
+    uniq_data = PyArray_DATA(uniq);
+    for (i = 0; i < nuniq; i++) {
+        memcpy(uniq_data + i * itemsize, data + first[i] * itemsize,
+               itemsize);
+    }
+
+    if (return_counts) {
+        cnt = (PyArrayObject *)PyArray_SimpleNew(1, &nuniq, NPY_INTP);
+        if (cnt == NULL) {
+            goto fail;
+        }
+        cnt_data = (npy_intp *)PyArray_DATA(cnt);
+        memcpy(cnt_data, counts, nuniq * sizeof(npy_intp));
+    }
+
+    ret = PyTuple_New(3);
+    if (ret == NULL) {
+        goto fail;
+    }
+    PyTuple_SET_ITEM(ret, 0, (PyObject *)uniq);
+    if (return_inverse) {
+        PyTuple_SET_ITEM(ret, 1, (PyObject *)inv);
+    }
+    else {
+        Py_INCREF(Py_None);
+        PyTuple_SET_ITEM(ret, 1, Py_None);
+    }
+    if (return_counts) {
+        PyTuple_SET_ITEM(ret, 2, (PyObject *)cnt);
+    }
+    else {
+        Py_INCREF(Py_None);
+        PyTuple_SET_ITEM(ret, 2, Py_None);
+    }
+    PyArray_free(table);
+    PyArray_free(first);
+    PyArray_free(counts);
+    Py_DECREF(arr);
+    return ret;
+
+fail:
+    PyArray_free(table);
+    PyArray_free(first);
+    PyArray_free(counts);
+    Py_XDECREF(arr);
+    Py_XDECREF(uniq);
+    Py_XDECREF(inv);
+    Py_XDECREF(cnt);
+    return NULL;
+}
+
+/*
+ * Probe each element of data against a table built over keys by
+ * unique_hash_run, writing the membership flag (xor invert) per element.
+ */
+static void
+in1d_hash_probe(const char *data, npy_intp n, npy_intp itemsize,
+                const char *keys, const npy_intp *table, npy_uintp mask,
+                const npy_intp *first, int invert, npy_bool *out)
+{
+    npy_intp i;
+
+    for (i = 0; i < n; i++) {
+        const char *elem = data + i * itemsize;
+        npy_uint64 h;
+        npy_uintp j;
+        npy_bool found = NPY_FALSE;
+
+        if (itemsize <= (npy_intp)sizeof(npy_uint64)) {
+            npy_uint64 key = 0;
+            memcpy(&key, elem, itemsize);
+            h = unique_hash_int(key);
+        }
+        else {
+            h = unique_hash_bytes(elem, itemsize);
+        }
+        for (j = (npy_uintp)h & mask; table[j] != -1; j = (j + 1) & mask) {
+            if (memcmp(elem, keys + first[table[j]] * itemsize,
+                       itemsize) == 0) {
+                found = NPY_TRUE;
+                break;
+            }
+        }
+        out[i] = invert ? !found : found;
+    }
+}
+
+/*
+ * arr_in1d_hash is registered as _in1d_hash.
+ *
+ * Membership test of each element of values against the set of elements
+ * of keys, for 1-d arrays sharing one integer, boolean, or byte-string
+ * dtype. Builds a hash table over keys and streams values through it,
+ * one pass each, instead of the sort-merge the Python fallback does.
+ * Returns a boolean array of the same length as values; invert flips
+ * the flags.
+ */
+NPY_NO_EXPORT PyObject *
+arr_in1d_hash(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    PyObject *values = NULL, *keys = NULL;
+    PyArrayObject *arr1 = NULL, *arr2 = NULL, *out = NULL;
+    PyArray_Descr *descr;
+    npy_intp *table = NULL, *first = NULL;
+    npy_intp n1, n2, itemsize;
+    npy_uintp msize, mask;
+    int invert = 0;
+    static char *kwlist[] = {"values", "keys", "invert", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|i:_in1d_hash", kwlist,
+                &values, &keys, &invert)) {
+        return NULL;
+    }
+
+    arr1 = (PyArrayObject *)PyArray_FromAny(values, NULL, 1, 1,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+    if (arr1 == NULL) {
+        goto fail;
+    }
+    arr2 = (PyArrayObject *)PyArray_FromAny(keys, NULL, 1, 1,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+    if (arr2 == NULL) {
+        goto fail;
+    }
+    descr = PyArray_DESCR(arr1);
+    if (!PyTypeNum_ISINTEGER(descr->type_num) &&
+            !PyTypeNum_ISBOOL(descr->type_num) &&
+            descr->type_num != NPY_STRING) {
+        PyErr_SetString(PyExc_TypeError,
+                "_in1d_hash only supports integer, boolean and "
+                "byte-string arrays");
+        goto fail;
+    }
+    if (!PyArray_EquivArrTypes(arr1, arr2)) {
+        PyErr_SetString(PyExc_TypeError,
+                "_in1d_hash requires both arrays to have the same dtype");
+        goto fail;
+    }
+
+    n1 = PyArray_SIZE(arr1);
+    n2 = PyArray_SIZE(arr2);
+    itemsize = descr->elsize;
+
+    if (n2 > NPY_MAX_INTP / 4) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    msize = 16;
+    while (msize < (npy_uintp)n2 * 2) {
+        msize <<= 1;
+    }
+    mask = msize - 1;
+
+    table = PyArray_malloc(msize * sizeof(npy_intp));
+    first = PyArray_malloc((n2 > 0 ? n2 : 1) * sizeof(npy_intp));
+    if (table == NULL || first == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    memset(table, -1, msize * sizeof(npy_intp));
+
+    out = (PyArrayObject *)PyArray_SimpleNew(1, &n1, NPY_BOOL);
+    if (out == NULL) {
+        goto fail;
+    }
+
+    NPY_BEGIN_ALLOW_THREADS;
+    unique_hash_run(PyArray_DATA(arr2), n2, itemsize, table, mask, first,
+                    NULL, NULL);
+    in1d_hash_probe(PyArray_DATA(arr1), n1, itemsize, PyArray_DATA(arr2),
+                    table, mask, first, invert,
+                    (npy_bool *)PyArray_DATA(out));
+    NPY_END_ALLOW_THREADS;
+
+    PyArray_free(table);
+    PyArray_free(first);
+    Py_DECREF(arr1);
+    Py_DECREF(arr2);
+    return (PyObject *)out;
+
+fail:
+    PyArray_free(table);
+    PyArray_free(first);
+    Py_XDECREF(arr1);
+    Py_XDECREF(arr2);
+    Py_XDECREF(out);
+    return NULL;
+}
+
+enum bytes_transform_op {
+    BYTES_OP_UPPER,
+    BYTES_OP_LOWER,
+    BYTES_OP_LSTRIP,
+    BYTES_OP_RSTRIP,
+    BYTES_OP_STRIP,
+    BYTES_OP_REPLACE
+};
+
+/* The whitespace bytes.strip removes: space and '\t' through '\r' */
+static NPY_INLINE int
+bytes_isspace(char c)
+{
+    return c == ' ' || ('\t' <= c && c <= '\r');
+}
+
+/*
+ * Transform 'n' fixed-width byte strings of width 'elsize' in place.
+ * Elements are NUL padded, so upper and lower sweep the whole packed
+ * buffer; the strips and replace work on the value with trailing NULs
+ * trimmed, exactly the region the bytes methods see through getitem.
+ */
+static void
+bytes_transform_run(char *data, npy_intp n, npy_intp elsize, int op,
+                    char old, char new)
+{
+    npy_intp i, j;
+
+    if (op == BYTES_OP_UPPER || op == BYTES_OP_LOWER) {
+        char base = (op == BYTES_OP_UPPER) ? 'a' : 'A';
+        char delta = (op == BYTES_OP_UPPER) ? -32 : 32;
+
+        for (i = 0; i < n * elsize; i++) {
+            if ((unsigned char)(data[i] - base) < 26) {
+                data[i] += delta;
+            }
+        }
+        return;
+    }
+
+    for (i = 0; i < n; i++, data += elsize) {
+        npy_intp start = 0, end = elsize;
+
+        while (end > 0 && data[end - 1] == '\0') {
+            end--;
+        }
+        switch (op) {
+            case BYTES_OP_REPLACE:
+                for (j = 0; j < end; j++) {
+                    if (data[j] == old) {
+                        data[j] = new;
+                    }
+                }
+                continue;
+            case BYTES_OP_LSTRIP:
+                while (start < end && bytes_isspace(data[start])) {
+                    start++;
+                }
+                break;
+            case BYTES_OP_RSTRIP:
+                while (end > 0 && bytes_isspace(data[end - 1])) {
+                    end--;
+                }
+                break;
+            default:
+                while (start < end && bytes_isspace(data[start])) {
+                    start++;
+                }
+                while (end > start && bytes_isspace(data[end - 1])) {
+                    end--;
+                }
+                break;
+        }
+        if (start > 0) {
+            memmove(data, data + start, end - start);
+        }
+        memset(data + (end - start), 0, elsize - (end - start));
+    }
+}
+
+/*
+ * arr_bytes_transform is registered as _bytes_transform.
+ *
+ * Applies one of the in-place byte-string transforms (upper, lower,
+ * lstrip, rstrip, strip, or single-character replace) to a copy of a
+ * fixed-width bytes array, sweeping the packed buffer directly instead
+ * of boxing every element the way _vec_string does.
+ */
+NPY_NO_EXPORT PyObject *
+arr_bytes_transform(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    PyObject *obj = NULL;
+    PyArrayObject *arr = NULL, *out = NULL;
+    char *opname = NULL;
+    char old = 0, new = 0;
+    int op;
+    npy_intp n, elsize;
+    static char *kwlist[] = {"a", "op", "old", "new", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Os|cc:_bytes_transform",
+                kwlist, &obj, &opname, &old, &new)) {
+        return NULL;
+    }
+
+    if (strcmp(opname, "upper") == 0) {
+        op = BYTES_OP_UPPER;
+    }
+    else if (strcmp(opname, "lower") == 0) {
+        op = BYTES_OP_LOWER;
+    }
+    else if (strcmp(opname, "lstrip") == 0) {
+        op = BYTES_OP_LSTRIP;
+    }
+    else if (strcmp(opname, "rstrip") == 0) {
+        op = BYTES_OP_RSTRIP;
+    }
+    else if (strcmp(opname, "strip") == 0) {
+        op = BYTES_OP_STRIP;
+    }
+    else if (strcmp(opname, "replace") == 0) {
+        op = BYTES_OP_REPLACE;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                "unknown byte-string transform '%s'", opname);
+        return NULL;
+    }
+
+    arr = (PyArrayObject *)PyArray_FromAny(obj, NULL, 0, 0,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+    if (arr == NULL) {
+        return NULL;
+    }
+    if (PyArray_TYPE(arr) != NPY_STRING || PyArray_ITEMSIZE(arr) == 0) {
+        PyErr_SetString(PyExc_TypeError,
+                "_bytes_transform only supports byte-string arrays");
+        goto fail;
+    }
+
+    out = (PyArrayObject *)PyArray_NewLikeArray(arr, NPY_CORDER, NULL, 0);
+    if (out == NULL) {
+        goto fail;
+    }
+
+    n = PyArray_SIZE(arr);
+    elsize = PyArray_ITEMSIZE(arr);
+    memcpy(PyArray_DATA(out), PyArray_DATA(arr), n * elsize);
+
+    NPY_BEGIN_ALLOW_THREADS;
+    bytes_transform_run(PyArray_DATA(out), n, elsize, op, old, new);
+    NPY_END_ALLOW_THREADS;
+
+    Py_DECREF(arr);
+    return (PyObject *)out;
+
+fail:
+    Py_XDECREF(arr);
+    Py_XDECREF(out);
+    return NULL;
+}
+
+typedef void (*hist_fill_func)(const char *, npy_intp, const char *,
+                               npy_intp, double, double, double, npy_intp *);
+
+/*
+ * Count the elements of a contiguous lane into uniform bins. The bin is
+ * found with a single multiply by the precomputed reciprocal bin width,
+ * which is only reliable to ~1 ulp near a bin edge, so ambiguous values
+ * are resolved against the actual edges (see gh-8123 and gh-10322),
+ * keeping the counts identical to a searchsorted binning. Values outside
+ * [first, last], including nans, are dropped.
+ */
+#define HISTOGRAM_FILL(type, suffix)                                    \
+static void                                                             \
+histogram_fill_##suffix(const char *data, npy_intp n,                   \
+                        const char *edges_arg, npy_intp nbins,          \
+                        double first_arg, double last_arg,              \
+                        double norm_arg, npy_intp *counts)              \
+{                                                                       \
+    const type *p = (const type *)data;                                 \
+    const type *edges = (const type *)edges_arg;                        \
+    const type first = (type)first_arg;                                 \
+    const type last = (type)last_arg;                                   \
+    const type norm = (type)norm_arg;                                   \
+    npy_intp i;                                                         \
+                                                                        \
+    for (i = 0; i < n; i++) {                                           \
+        const type x = p[i];                                            \
+        npy_intp bin;                                                   \
+                                                                        \
+        if (!(x >= first && x <= last)) {                               \
+            continue;                                                   \
+        }                                                               \
+        bin = (npy_intp)((x - first) * norm);                           \
+        /* the last bin includes the right edge */                      \
+        if (bin == nbins) {                                             \
+            bin--;                                                      \
+        }                                                               \
+        if (x < edges[bin]) {                                           \
+            bin--;                                                      \
+        }                                                               \
+        else if (bin != nbins - 1 && x >= edges[bin + 1]) {             \
+            bin++;                                                      \
+        }                                                               \
+        counts[bin]++;                                                  \
+    }                                                                   \
+}
+
+HISTOGRAM_FILL(npy_float, float)
+HISTOGRAM_FILL(npy_double, double)
+
+typedef struct {
+    hist_fill_func fill;
+    const char *data;
+    npy_intp n;
+    const char *edges;
+    npy_intp nbins;
+    double first, last, norm;
+    npy_intp *counts;       /* private bins for this worker */
+    /* released by the worker when its chunk is counted */
+    PyThread_type_lock done;
+} hist_chunk;
+
+static void
+hist_chunk_run(void *arg)
+{
+    hist_chunk *chunk = (hist_chunk *)arg;
+
+    chunk->fill(chunk->data, chunk->n, chunk->edges, chunk->nbins,
+                chunk->first, chunk->last, chunk->norm, chunk->counts);
+    PyThread_release_lock(chunk->done);
+}
+
+/*
+ * Fill `counts` from `n` elements of `data`, splitting across the opt-in
+ * NPY_UFUNC_THREADS workers when the input is large enough. Each worker
+ * counts into a private bin array which is summed into `counts` once all
+ * chunks are done, so the counting loops need no synchronization and the
+ * result does not depend on the chunking. Called without the GIL.
+ */
+static void
+histogram_fill_run(hist_fill_func fill, const char *data, npy_intp n,
+                   npy_intp elsize, const char *edges, npy_intp nbins,
+                   double first, double last, double norm, npy_intp *counts)
+{
+    hist_chunk chunks[NPY_UFUNC_MAX_THREADS];
+    npy_intp *private_bins = NULL;
+    npy_intp chunksize, start, j;
+    int i, nchunks;
+    int nthreads = npy_ufunc_nthreads();
+
+    nchunks = 1;
+    if (nthreads > 1 && n >= NPY_HISTOGRAM_PARALLEL_THRESHOLD) {
+        nchunks = nthreads;
+        if (n / nchunks < NPY_HISTOGRAM_PARALLEL_MIN_CHUNK) {
+            nchunks = (int)(n / NPY_HISTOGRAM_PARALLEL_MIN_CHUNK);
+        }
+    }
+    if (nchunks > 1) {
+        private_bins = calloc((size_t)(nchunks - 1) * nbins,
+                              sizeof(npy_intp));
+    }
+    if (private_bins == NULL) {
+        /* threading disabled, not worthwhile, or no memory */
+        fill(data, n, edges, nbins, first, last, norm, counts);
+        return;
+    }
+
+    chunksize = n / nchunks;
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].fill = fill;
+        chunks[i].data = data + start * elsize;
+        chunks[i].n = (i == nchunks - 1) ? (n - start) : chunksize;
+        chunks[i].edges = edges;
+        chunks[i].nbins = nbins;
+        chunks[i].first = first;
+        chunks[i].last = last;
+        chunks[i].norm = norm;
+        chunks[i].counts = (i == 0) ? counts
+                                    : private_bins + (i - 1) * nbins;
+        chunks[i].done = NULL;
+        start += chunksize;
+    }
+
+    /* chunk 0 runs on the calling thread, the rest on workers */
+    for (i = 1; i < nchunks; i++) {
+        chunks[i].done = PyThread_allocate_lock();
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            if (PyThread_start_new_thread(hist_chunk_run,
+                                          &chunks[i]) == -1) {
+                PyThread_release_lock(chunks[i].done);
+                PyThread_free_lock(chunks[i].done);
+                chunks[i].done = NULL;
+            }
+        }
+        if (chunks[i].done == NULL) {
+            /* could not start a worker, count the chunk inline */
+            chunks[i].fill(chunks[i].data, chunks[i].n, edges, nbins,
+                           first, last, norm, chunks[i].counts);
+        }
+    }
+
+    chunks[0].fill(chunks[0].data, chunks[0].n, edges, nbins,
+                   first, last, norm, chunks[0].counts);
+
+    for (i = 1; i < nchunks; i++) {
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            PyThread_free_lock(chunks[i].done);
+        }
+    }
+
+    /* merge the private bins */
+    for (i = 1; i < nchunks; i++) {
+        for (j = 0; j < nbins; j++) {
+            counts[j] += chunks[i].counts[j];
+        }
+    }
+    free(private_bins);
+}
+
+/*
+ * arr_histogram_uniform is registered as _histogram_uniform.
+ *
+ * Counts the elements of a float32 or float64 array into
+ * len(bin_edges) - 1 equal-width bins spanning [first_edge, last_edge];
+ * values outside the range (and nans) are ignored, and the last bin
+ * includes the right edge. Backs the equal-bin fast path of
+ * np.histogram: the edges must match the array's dtype and are still
+ * consulted for values within rounding error of a bin boundary, so the
+ * counts agree with the searchsorted definition of the bins.
+ */
+NPY_NO_EXPORT PyObject *
+arr_histogram_uniform(PyObject *NPY_UNUSED(self), PyObject *args,
+                      PyObject *kwds)
+{
+    PyObject *a = NULL, *bin_edges = NULL;
+    PyArrayObject *arr = NULL, *edges = NULL, *ans = NULL;
+    double first_edge, last_edge, norm;
+    npy_intp len, nbins;
+    int typenum;
+    hist_fill_func fill;
+    static char *kwlist[] = {"a", "bin_edges", "first_edge", "last_edge",
+                             NULL};
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOdd:_histogram_uniform",
+                kwlist, &a, &bin_edges, &first_edge, &last_edge)) {
+        return NULL;
+    }
+
+    arr = (PyArrayObject *)PyArray_FROM_OF(a, NPY_ARRAY_CARRAY_RO);
+    if (arr == NULL) {
+        goto fail;
+    }
+    typenum = PyArray_TYPE(arr);
+    if ((typenum != NPY_FLOAT && typenum != NPY_DOUBLE) ||
+            PyArray_NDIM(arr) != 1 || !PyArray_ISNOTSWAPPED(arr)) {
+        PyErr_SetString(PyExc_TypeError,
+                "_histogram_uniform requires a 1-d native "
+                "float32 or float64 array");
+        goto fail;
+    }
+    fill = (typenum == NPY_FLOAT) ? histogram_fill_float
+                                  : histogram_fill_double;
+
+    edges = (PyArrayObject *)PyArray_ContiguousFromAny(bin_edges,
+                                                       typenum, 1, 1);
+    if (edges == NULL) {
+        goto fail;
+    }
+    nbins = PyArray_SIZE(edges) - 1;
+    if (nbins < 1) {
+        PyErr_SetString(PyExc_ValueError,
+                "bin_edges must hold at least two edges");
+        goto fail;
+    }
+    if (!(last_edge > first_edge)) {
+        PyErr_SetString(PyExc_ValueError,
+                "last_edge must be larger than first_edge");
+        goto fail;
+    }
+
+    ans = (PyArrayObject *)PyArray_ZEROS(1, &nbins, NPY_INTP, 0);
+    if (ans == NULL) {
+        goto fail;
+    }
+
+    len = PyArray_SIZE(arr);
+    norm = nbins / (last_edge - first_edge);
+    if (len > 0) {
+        NPY_BEGIN_THREADS_THRESHOLDED(len);
+        histogram_fill_run(fill, PyArray_DATA(arr), len,
+                           PyArray_DESCR(arr)->elsize,
+                           PyArray_DATA(edges), nbins,
+                           first_edge, last_edge, norm,
+                           (npy_intp *)PyArray_DATA(ans));
+        NPY_END_THREADS;
+    }
+
+    Py_DECREF(arr);
+    Py_DECREF(edges);
+    return (PyObject *)ans;
+
+fail:
+    Py_XDECREF(arr);
+    Py_XDECREF(edges);
+    Py_XDECREF(ans);
+    return NULL;
+}
+
 /* Internal function to expose check_array_monotonic to python */
 NPY_NO_EXPORT PyObject *
 arr__monotonicity(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
@@ -832,6 +1761,109 @@ fail:
     return NULL;
 }
 
+/*
+ * _polyval(x, c)
+ *
+ * Evaluate the 1-D real polynomial c[0] + c[1]*x + ... + c[n]*x**n at
+ * every element of x in a single pass, instead of the one full array
+ * pass per coefficient that Horner iteration from Python makes.  The
+ * coefficients are combined with Estrin's scheme: groups of four are
+ * evaluated as (c0 + c1*x) + x^2*(c2 + c3*x), whose four products are
+ * independent, and the groups are chained by a Horner step in x^4, so
+ * the serial dependency is a quarter as long and the element loop
+ * vectorizes.
+ */
+NPY_NO_EXPORT PyObject *
+arr_polyval(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
+{
+    PyObject *x, *c;
+    PyArrayObject *ac = NULL, *ax = NULL, *ay = NULL;
+    const npy_double *dc, *dx;
+    npy_double *dy;
+    npy_intp nc, nx, ngroups, rem, i, g;
+
+    static char *kwlist[] = {"x", "c", NULL};
+
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwdict, "OO:_polyval", kwlist,
+                                     &x, &c)) {
+        return NULL;
+    }
+
+    ac = (PyArrayObject *)PyArray_ContiguousFromAny(c, NPY_DOUBLE, 1, 1);
+    if (ac == NULL) {
+        return NULL;
+    }
+    nc = PyArray_SIZE(ac);
+    if (nc == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "coefficient array is empty");
+        goto fail;
+    }
+    ax = (PyArrayObject *)PyArray_ContiguousFromAny(x, NPY_DOUBLE, 0, 0);
+    if (ax == NULL) {
+        goto fail;
+    }
+    ay = (PyArrayObject *)PyArray_SimpleNew(PyArray_NDIM(ax),
+                                            PyArray_DIMS(ax), NPY_DOUBLE);
+    if (ay == NULL) {
+        goto fail;
+    }
+    nx = PyArray_SIZE(ax);
+
+    dc = (const npy_double *)PyArray_DATA(ac);
+    dx = (const npy_double *)PyArray_DATA(ax);
+    dy = (npy_double *)PyArray_DATA(ay);
+
+    /* number of complete groups of four and size of the leading group */
+    ngroups = (nc + 3) / 4;
+    rem = nc - 4 * (ngroups - 1);
+
+    NPY_BEGIN_THREADS_THRESHOLDED(nx * nc);
+    for (i = 0; i < nx; i++) {
+        const npy_double xv = dx[i];
+        const npy_double x2 = xv * xv;
+        const npy_double x4 = x2 * x2;
+        const npy_double *top = dc + 4 * (ngroups - 1);
+        npy_double acc;
+
+        switch (rem) {
+            case 1:
+                acc = top[0];
+                break;
+            case 2:
+                acc = top[0] + top[1] * xv;
+                break;
+            case 3:
+                acc = (top[0] + top[1] * xv) + x2 * top[2];
+                break;
+            default:
+                acc = (top[0] + top[1] * xv) +
+                      x2 * (top[2] + top[3] * xv);
+                break;
+        }
+        for (g = ngroups - 2; g >= 0; g--) {
+            const npy_double *cg = dc + 4 * g;
+            acc = acc * x4 +
+                  ((cg[0] + cg[1] * xv) + x2 * (cg[2] + cg[3] * xv));
+        }
+        dy[i] = acc;
+    }
+    NPY_END_THREADS;
+
+    Py_DECREF(ac);
+    Py_DECREF(ax);
+    /* always an array, 0-d x included, like the Horner fallback */
+    return (PyObject *)ay;
+
+fail:
+    Py_XDECREF(ac);
+    Py_XDECREF(ax);
+    Py_XDECREF(ay);
+    return NULL;
+}
+
 static const char *EMPTY_SEQUENCE_ERR_MSG = "indices must be integral: the provided " \
     "empty sequence was inferred as float. Wrap it with " \
     "'np.array(indices, dtype=np.intp)'";
@@ -1498,6 +2530,9 @@ arr_add_docstring(PyObject *NPY_UNUSED(dummy), PyObject *args)
 #if defined NPY_HAVE_SSE2_INTRINSICS
 #include <emmintrin.h>
 #endif
+#if defined __BMI2__
+#include <immintrin.h>
+#endif
 
 /*
  * This function packs boolean values in the input array into the bits of a
@@ -1553,6 +2588,33 @@ pack_inner(const char *inptr,
             inptr += 16;
         }
     }
+#else
+    /*
+     * Plain 64-bit kernel for builds without the SSE2 path above: gather
+     * the most significant bit of eight bytes with one multiply instead
+     * of looping bit by bit.
+     */
+    if (in_stride == 1 && element_size == 1 && n_out > 1) {
+        /* don't handle non-full 8-byte remainder */
+        npy_intp vn_out = n_out - (remain ? 1 : 0);
+        for (index = 0; index < vn_out; index++) {
+            npy_uint64 a;
+            memcpy(&a, inptr, 8);
+#if NPY_BYTE_ORDER == NPY_BIG_ENDIAN
+            a = npy_bswap8(a);
+#endif
+            if (order == 'b') {
+                a = npy_bswap8(a);
+            }
+            /* set the msb of every nonzero byte */
+            a = (((a & 0x7f7f7f7f7f7f7f7fULL) + 0x7f7f7f7f7f7f7f7fULL) | a)
+                    & 0x8080808080808080ULL;
+            /* gather the eight msbs into the top byte */
+            *outptr = (char)((a * 0x0002040810204081ULL) >> 56);
+            outptr += out_stride;
+            inptr += 8;
+        }
+    }
 #endif
 
     if (remain == 0) {                  /* assumes n_in > 0 */
@@ -1700,6 +2762,37 @@ fail:
     return NULL;
 }
 
+/*
+ * This function expands the bits of a single byte into eight bytes of
+ * zero or one, most significant bit first for order 'b'.
+ */
+static NPY_INLINE void
+unpack_one_byte(unsigned char byte, char *outptr, char order)
+{
+    npy_uint64 a;
+#if defined __BMI2__
+    /* scatter the bits directly, least significant bit to the first byte */
+    a = _pdep_u64(byte, 0x0101010101010101ULL);
+    if (order == 'b') {
+        a = npy_bswap8(a);
+    }
+#else
+    /*
+     * One multiply broadcasts the byte to every lane, the mask picks a
+     * different bit per lane and the add/shift reduces each lane to
+     * zero or one.
+     */
+    a = byte * 0x0101010101010101ULL;
+#if NPY_BYTE_ORDER == NPY_BIG_ENDIAN
+    a &= (order == 'b') ? 0x8040201008040201ULL : 0x0102040810204080ULL;
+#else
+    a &= (order == 'b') ? 0x0102040810204080ULL : 0x8040201008040201ULL;
+#endif
+    a = ((a + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;
+#endif
+    memcpy(outptr, &a, 8);
+}
+
 static PyObject *
 unpack_bits(PyObject *input, int axis, PyObject *count_obj, char order)
 {
@@ -1810,7 +2903,23 @@ unpack_bits(PyObject *input, int axis, PyObject *count_obj, char order)
         unsigned const char *inptr = PyArray_ITER_DATA(it);
         char *outptr = PyArray_ITER_DATA(ot);
 
-        if (order == 'b') {
+        if (in_stride == 1 && out_stride == 1) {
+            /* contiguous axis: expand whole bytes with the 64-bit kernel */
+            for (index = 0; index < in_n; index++) {
+                unpack_one_byte(*inptr, outptr, order);
+                inptr++;
+                outptr += 8;
+            }
+            /* Clean up the tail portion */
+            if (in_tail) {
+                char tail[8];
+
+                unpack_one_byte(*inptr, tail, order);
+                memcpy(outptr, tail, in_tail);
+                outptr += in_tail;
+            }
+        }
+        else if (order == 'b') {
             for (index = 0; index < in_n; index++) {
                 for (i = 0; i < 8; i++) {
                     *outptr = ((*inptr & (128 >> i)) != 0);
@@ -7,12 +7,22 @@ arr_insert(PyObject *, PyObject *, PyObject *);
 NPY_NO_EXPORT PyObject *
 arr_bincount(PyObject *, PyObject *, PyObject *);
 NPY_NO_EXPORT PyObject *
+arr_unique_hash(PyObject *, PyObject *, PyObject *);
+NPY_NO_EXPORT PyObject *
+arr_in1d_hash(PyObject *, PyObject *, PyObject *);
+NPY_NO_EXPORT PyObject *
+arr_bytes_transform(PyObject *, PyObject *, PyObject *);
+NPY_NO_EXPORT PyObject *
+arr_histogram_uniform(PyObject *, PyObject *, PyObject *);
+NPY_NO_EXPORT PyObject *
 arr__monotonicity(PyObject *, PyObject *, PyObject *kwds);
 NPY_NO_EXPORT PyObject *
 arr_interp(PyObject *, PyObject *, PyObject *);
 NPY_NO_EXPORT PyObject *
 arr_interp_complex(PyObject *, PyObject *, PyObject *);
 NPY_NO_EXPORT PyObject *
+arr_polyval(PyObject *, PyObject *, PyObject *);
+NPY_NO_EXPORT PyObject *
 arr_ravel_multi_index(PyObject *, PyObject *, PyObject *);
 NPY_NO_EXPORT PyObject *
 arr_unravel_index(PyObject *, PyObject *, PyObject *);
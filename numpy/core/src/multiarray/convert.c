@@ -20,6 +20,7 @@
 #include "lowlevel_strided_loops.h"
 #include "scalartypes.h"
 #include "array_assign.h"
+#include "chunked_io.h"
 
 #include "convert.h"
 
@@ -154,7 +155,20 @@ PyArray_ToFile(PyArrayObject *self, FILE *fp, char *sep, char *format)
         }
 
         if (PyArray_ISCONTIGUOUS(self)) {
+            npy_intp nwritten;
+
             size = PyArray_SIZE(self);
+            if (npy_chunked_write(fp, PyArray_DATA(self),
+                                  PyArray_NBYTES(self), &nwritten)) {
+                n = nwritten / PyArray_DESCR(self)->elsize;
+                if (n < size) {
+                    PyErr_Format(PyExc_IOError,
+                            "%ld requested and %ld written",
+                            (long) size, (long) n);
+                    return -1;
+                }
+                return 0;
+            }
             NPY_BEGIN_ALLOW_THREADS;
 
 #if defined (_MSC_VER) && defined(_WIN64)
@@ -671,6 +671,70 @@ can_cast_fields(PyObject *field1, PyObject *field2, NPY_CASTING casting)
     return 1;
 }
 
+/*
+ * Precomputed casting answers for pairs of builtin type numbers whose
+ * result depends only on the type numbers.  Bit 'casting' of an entry
+ * answers PyArray_CanCastTypeTo for that casting level, and the high
+ * bit marks the entry as filled in.  Entries stay zero (unfilled) for
+ * string/unicode/void/datetime/timedelta, whose answers depend on the
+ * itemsize or metadata, so those pairs always take the full logic
+ * below.  The table is filled once at module initialization, after
+ * which builtin-pair queries are a single load.
+ */
+#define NPY_CAN_CAST_TABLE_FILLED 0x80
+static npy_uint8 can_cast_builtin_table[NPY_NTYPES][NPY_NTYPES];
+
+/*
+ * Returns true if the type number's casting behavior is fully
+ * determined by the type number itself (no itemsize or metadata).
+ */
+static NPY_INLINE int
+simple_builtin_typenum(int type_num)
+{
+    return (type_num >= 0 && type_num < NPY_NTYPES &&
+            type_num != NPY_STRING && type_num != NPY_UNICODE &&
+            type_num != NPY_VOID && type_num != NPY_DATETIME &&
+            type_num != NPY_TIMEDELTA);
+}
+
+NPY_NO_EXPORT void
+initialize_can_cast_table(void)
+{
+    int from_num, to_num;
+    int casting;
+
+    for (from_num = 0; from_num < NPY_NTYPES; ++from_num) {
+        PyArray_Descr *from;
+
+        if (!simple_builtin_typenum(from_num)) {
+            continue;
+        }
+        from = PyArray_DescrFromType(from_num);
+        for (to_num = 0; to_num < NPY_NTYPES; ++to_num) {
+            PyArray_Descr *to;
+            npy_uint8 entry = NPY_CAN_CAST_TABLE_FILLED;
+
+            if (!simple_builtin_typenum(to_num)) {
+                continue;
+            }
+            to = PyArray_DescrFromType(to_num);
+            /*
+             * The unfilled table falls through to the full logic, so
+             * querying while populating gives the untabled answers.
+             */
+            for (casting = NPY_NO_CASTING;
+                        casting <= NPY_UNSAFE_CASTING; ++casting) {
+                if (PyArray_CanCastTypeTo(from, to, casting)) {
+                    entry |= (npy_uint8)(1 << casting);
+                }
+            }
+            can_cast_builtin_table[from_num][to_num] = entry;
+            Py_DECREF(to);
+        }
+        Py_DECREF(from);
+    }
+}
+
 /*NUMPY_API
  * Returns true if data of type 'from' may be cast to data of type
  * 'to' according to the rule 'casting'.
@@ -679,6 +743,25 @@ NPY_NO_EXPORT npy_bool
 PyArray_CanCastTypeTo(PyArray_Descr *from, PyArray_Descr *to,
                                                     NPY_CASTING casting)
 {
+    /*
+     * One-load answer for builtin pairs without itemsize or metadata
+     * dependence.  Byte order only matters under NPY_NO_CASTING,
+     * where PyArray_EquivTypes rejects mismatched orders; the looser
+     * rules for these types compare itemsizes and kinds only.
+     */
+    if ((unsigned int)casting <= NPY_UNSAFE_CASTING &&
+            (unsigned int)from->type_num < NPY_NTYPES &&
+            (unsigned int)to->type_num < NPY_NTYPES &&
+            (casting != NPY_NO_CASTING ||
+             PyArray_ISNBO(from->byteorder) ==
+                    PyArray_ISNBO(to->byteorder))) {
+        npy_uint8 entry = can_cast_builtin_table[from->type_num]
+                                                [to->type_num];
+
+        if (entry & NPY_CAN_CAST_TABLE_FILLED) {
+            return (entry >> casting) & 1;
+        }
+    }
     /* Fast path for unsafe casts or basic types */
     if (casting == NPY_UNSAFE_CASTING ||
             (NPY_LIKELY(from->type_num < NPY_OBJECT) &&
@@ -994,6 +1077,18 @@ ensure_dtype_nbo(PyArray_Descr *type)
     }
 }
 
+/*
+ * Interned promotion results for pairs of built-in type numbers whose
+ * result comes straight from the promotion table.  Entries are the
+ * immortal builtin descr singletons, stored once with their own
+ * reference; reads are plain pointer loads, and the (GIL-serialized)
+ * first-use store is idempotent, so lookups never need a lock.  Pairs
+ * the table cannot answer (string/unicode/void/datetime/timedelta)
+ * stay NULL and take the full resolution below, since their result
+ * depends on more than the type numbers.
+ */
+static PyArray_Descr *promotion_pair_cache[NPY_NTYPES][NPY_NTYPES];
+
 /*NUMPY_API
  * Produces the smallest size and lowest kind type to which both
  * input types can be cast.
@@ -1019,13 +1114,26 @@ PyArray_PromoteTypes(PyArray_Descr *type1, PyArray_Descr *type2)
 
     /* If they're built-in types, use the promotion table */
     if (type_num1 < NPY_NTYPES && type_num2 < NPY_NTYPES) {
+        PyArray_Descr *cached = promotion_pair_cache[type_num1][type_num2];
+
+        if (cached != NULL) {
+            Py_INCREF(cached);
+            return cached;
+        }
         ret_type_num = _npy_type_promotion_table[type_num1][type_num2];
         /*
          * The table doesn't handle string/unicode/void/datetime/timedelta,
          * so check the result
          */
         if (ret_type_num >= 0) {
-            return PyArray_DescrFromType(ret_type_num);
+            PyArray_Descr *res = PyArray_DescrFromType(ret_type_num);
+
+            if (res != NULL) {
+                /* intern the pair: one reference belongs to the cache */
+                Py_INCREF(res);
+                promotion_pair_cache[type_num1][type_num2] = res;
+            }
+            return res;
         }
     }
     /* If one or both are user defined, calculate it */
@@ -1785,13 +1893,20 @@ PyArray_ResultType(npy_intp narrs, PyArrayObject **arr,
     /* Loop through all the types, promoting them */
     if (!use_min_scalar) {
         PyArray_Descr *ret;
+        PyArray_Descr *stack_dtypes[NPY_MAXARGS];
+        PyArray_Descr **all_dtypes = stack_dtypes;
 
-        /* Build a single array of all the dtypes */
-        PyArray_Descr **all_dtypes = PyArray_malloc(
-            sizeof(*all_dtypes) * (narrs + ndtypes));
-        if (all_dtypes == NULL) {
-            PyErr_NoMemory();
-            return NULL;
+        /*
+         * Build a single array of all the dtypes.  The common case of a
+         * handful of operands avoids a heap allocation per call.
+         */
+        if (narrs + ndtypes > NPY_MAXARGS) {
+            all_dtypes = PyArray_malloc(
+                sizeof(*all_dtypes) * (narrs + ndtypes));
+            if (all_dtypes == NULL) {
+                PyErr_NoMemory();
+                return NULL;
+            }
         }
         for (i = 0; i < narrs; ++i) {
             all_dtypes[i] = PyArray_DESCR(arr[i]);
@@ -1800,7 +1915,9 @@ PyArray_ResultType(npy_intp narrs, PyArrayObject **arr,
             all_dtypes[narrs + i] = dtypes[i];
         }
         ret = PyArray_PromoteTypeSequence(all_dtypes, narrs + ndtypes);
-        PyArray_free(all_dtypes);
+        if (all_dtypes != stack_dtypes) {
+            PyArray_free(all_dtypes);
+        }
         return ret;
     }
     else {
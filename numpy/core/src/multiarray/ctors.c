@@ -28,6 +28,7 @@
 #include "mapping.h" /* for array_item_asarray */
 #include "templ_common.h" /* for npy_mul_with_overflow_intp */
 #include "alloc.h"
+#include "chunked_io.h"
 #include <assert.h>
 
 #include "get_attr_string.h"
@@ -230,6 +231,144 @@ fromfile_skip_separator(FILE **fp, const char *sep, void *NPY_UNUSED(stream_data
     return result;
 }
 
+/*
+ * Block-buffered text parsing from a file.
+ *
+ * The scanf based fromfile_next_element above reads one element per call
+ * through stdio, which makes parsing large text files dominated by per
+ * element locking and character pushback instead of the actual number
+ * conversion.  The stream below reads the file in large blocks and runs
+ * the string based parsers (dtype->f->fromstr via fromstr_next_element)
+ * over the buffer, so fromfile text mode parses at fromstring speed and
+ * with identical number handling.
+ *
+ * A token or separator that stops at the end of the buffered block may
+ * continue in the next block, so the block is refilled (keeping the
+ * unconsumed tail) and the element reparsed from its start whenever that
+ * is possible.  A single token longer than a whole block cannot be
+ * resumed and stops the parse there.
+ */
+#define NPY_TEXT_BLOCK_SIZE 65536
+/* refill before parsing into the last bytes of a block */
+#define NPY_TEXT_LOOKAHEAD 1024
+
+typedef struct {
+    FILE *fp;
+    char *buf;    /* NPY_TEXT_BLOCK_SIZE + 1 bytes, NUL terminated */
+    char *pos;    /* next unconsumed byte */
+    char *end;    /* end of the buffered data */
+    int eof;
+} textfile_stream;
+
+static int
+textfile_stream_init(textfile_stream *ts, FILE *fp)
+{
+    ts->buf = malloc(NPY_TEXT_BLOCK_SIZE + 1);
+    if (ts->buf == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    ts->fp = fp;
+    ts->pos = ts->buf;
+    ts->end = ts->buf;
+    ts->eof = 0;
+    ts->buf[0] = '\0';
+    return 0;
+}
+
+/*
+ * Push the unconsumed bytes back to the (seekable) stream and release
+ * the buffer, so the file position ends up just after the parsed text
+ * like it does for the scanf based path.
+ */
+static void
+textfile_stream_close(textfile_stream *ts)
+{
+    if (ts->end > ts->pos) {
+        npy_fseek(ts->fp, -(npy_off_t)(ts->end - ts->pos), SEEK_CUR);
+    }
+    free(ts->buf);
+}
+
+/* move the unconsumed tail to the front of the buffer and read more */
+static void
+textfile_refill(textfile_stream *ts)
+{
+    npy_intp keep = ts->end - ts->pos;
+    size_t nread, space;
+
+    if (ts->pos > ts->buf) {
+        memmove(ts->buf, ts->pos, keep);
+        ts->pos = ts->buf;
+        ts->end = ts->buf + keep;
+    }
+    space = (size_t)(NPY_TEXT_BLOCK_SIZE - keep);
+    if (space == 0) {
+        return;
+    }
+    nread = fread(ts->end, 1, space, ts->fp);
+    if (nread < space) {
+        /* end of file, or a read error nothing here can recover from */
+        ts->eof = 1;
+    }
+    ts->end += nread;
+    *ts->end = '\0';
+}
+
+/* a block that spans the whole buffer cannot be refilled any further */
+static int
+textfile_block_is_full(textfile_stream *ts)
+{
+    return ts->pos == ts->buf && ts->end - ts->buf == NPY_TEXT_BLOCK_SIZE;
+}
+
+static int
+textfile_next_element(textfile_stream **sp, void *dptr, PyArray_Descr *dtype,
+                      void *NPY_UNUSED(stream_data))
+{
+    textfile_stream *ts = *sp;
+
+    for (;;) {
+        char *p = ts->pos;
+        int r = fromstr_next_element(&p, dptr, dtype, ts->end);
+
+        if (!ts->eof && ts->end - p < NPY_TEXT_LOOKAHEAD
+                && !textfile_block_is_full(ts)) {
+            /* the token may continue in the next block; reparse it */
+            textfile_refill(ts);
+            continue;
+        }
+        if (r < 0) {
+            return -1;
+        }
+        ts->pos = p;
+        return r;
+    }
+}
+
+static int
+textfile_skip_separator(textfile_stream **sp, const char *sep,
+                        void *NPY_UNUSED(stream_data))
+{
+    textfile_stream *ts = *sp;
+
+    for (;;) {
+        char *p = ts->pos;
+        int r = fromstr_skip_separator(&p, sep, ts->end);
+
+        if (r == -1 && !ts->eof && !textfile_block_is_full(ts)) {
+            /* ran out of buffered data mid separator; rematch it */
+            textfile_refill(ts);
+            continue;
+        }
+        if (r != 0) {
+            return r;
+        }
+        ts->pos = p;
+        return 0;
+    }
+}
+
 /*
  * Change a sub-array field to the base descriptor
  * and update the dimensions and strides
@@ -1205,6 +1344,121 @@ PyArray_NewFromDescrAndBase(
                                     flags, obj, base, 0, 0);
 }
 
+/*
+ * Fast constructor for views derived by basic slicing.
+ *
+ * Creates a base-class view of 'base' with the given shape, strides and
+ * data pointer, all of which the caller must have derived from 'base'
+ * itself.  Since the geometry describes memory the parent already
+ * validated, the dimension and overflow checks of
+ * PyArray_NewFromDescr_int are skipped, no data is ever allocated, and
+ * the flags start from the parent's with only the layout-dependent bits
+ * recomputed.  Callers creating subclass instances must use the general
+ * constructor instead, which runs __array_finalize__.
+ *
+ * Returns a new reference; the reference to 'base' is not stolen.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_NewViewFromBase(PyArrayObject *base, int nd, npy_intp *dims,
+                        npy_intp *strides, void *data)
+{
+    PyArrayObject_fields *fa;
+
+    fa = (PyArrayObject_fields *)PyArray_Type.tp_alloc(&PyArray_Type, 0);
+    if (fa == NULL) {
+        return NULL;
+    }
+    fa->nd = nd;
+    fa->flags = PyArray_FLAGS(base) &
+                ~(NPY_ARRAY_OWNDATA | NPY_ARRAY_WRITEBACKIFCOPY |
+                  NPY_ARRAY_UPDATEIFCOPY);
+    Py_INCREF(PyArray_DESCR(base));
+    fa->descr = PyArray_DESCR(base);
+    fa->base = (PyObject *)NULL;
+    fa->weakreflist = (PyObject *)NULL;
+    fa->data = data;
+    if (nd > 0) {
+        fa->dimensions = npy_alloc_cache_dim(2 * nd);
+        if (fa->dimensions == NULL) {
+            Py_DECREF(fa);
+            return PyErr_NoMemory();
+        }
+        fa->strides = fa->dimensions + nd;
+        memcpy(fa->dimensions, dims, sizeof(npy_intp)*nd);
+        memcpy(fa->strides, strides, sizeof(npy_intp)*nd);
+    }
+    else {
+        fa->dimensions = fa->strides = NULL;
+        fa->flags |= NPY_ARRAY_F_CONTIGUOUS;
+    }
+
+    /* only the layout dependent flags differ from the parent's */
+    PyArray_UpdateFlags((PyArrayObject *)fa, NPY_ARRAY_UPDATE_ALL);
+
+    Py_INCREF(base);
+    if (PyArray_SetBaseObject((PyArrayObject *)fa, (PyObject *)base) < 0) {
+        Py_DECREF(fa);
+        return NULL;
+    }
+    return (PyObject *)fa;
+}
+
+/*
+ * Builds the sliding-window view of 'ap': one window of 'window[k]'
+ * elements slides over axis 'axes[k]' for each of the 'nwin' entries,
+ * and the window axes are appended in that order after the array axes.
+ * Axis k of the result has length dim[k] - window[k] + 1 and keeps
+ * stride[k]; window axis k has length window[k] and reuses the stride
+ * of axes[k].  The view is therefore bounded by the parent: the largest
+ * reachable offset along any axis pair is
+ * (dim - w)*stride + (w - 1)*stride = (dim - 1)*stride, exactly the
+ * parent's own extent, so no per-element bounds checks are needed and
+ * the view is built with the fast slice-view constructor.  Windows
+ * overlap in memory, so the caller normally clears WRITEABLE on the
+ * result.  Each window must fit its axis; duplicate axes are allowed
+ * and windows of zero length are permitted.
+ *
+ * Returns a base-class view, or NULL with an exception set.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_SlidingWindowView(PyArrayObject *ap, npy_intp const *window,
+                          int const *axes, int nwin)
+{
+    npy_intp dims[NPY_MAXDIMS], strides[NPY_MAXDIMS];
+    int ndim = PyArray_NDIM(ap);
+    int k;
+
+    if (ndim + nwin > NPY_MAXDIMS) {
+        PyErr_Format(PyExc_ValueError,
+                "sliding window view would have %d dimensions, "
+                "the maximum is %d", ndim + nwin, NPY_MAXDIMS);
+        return NULL;
+    }
+    memcpy(dims, PyArray_DIMS(ap), ndim * sizeof(npy_intp));
+    memcpy(strides, PyArray_STRIDES(ap), ndim * sizeof(npy_intp));
+    for (k = 0; k < nwin; k++) {
+        int ax = axes[k];
+
+        if (window[k] < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "window lengths cannot be negative");
+            return NULL;
+        }
+        /* dims[ax] shrinks as earlier windows claim the same axis */
+        if (window[k] > dims[ax]) {
+            PyErr_Format(PyExc_ValueError,
+                    "window length %" NPY_INTP_FMT " is larger than "
+                    "the remaining length of axis %d", window[k], ax);
+            return NULL;
+        }
+        dims[ax] -= window[k] - 1;
+        dims[ndim + k] = window[k];
+        strides[ndim + k] = PyArray_STRIDE(ap, ax);
+    }
+    return PyArray_NewViewFromBase(ap, ndim + nwin, dims, strides,
+                                   PyArray_DATA(ap));
+}
+
 /*
  * Creates a new array with the same shape as the provided one,
  * with possible memory layout order, data type and shape changes.
@@ -1855,6 +2109,76 @@ PyArray_FromAny(PyObject *op, PyArray_Descr *newtype, int min_depth,
     int ndim = 0;
     npy_intp dims[NPY_MAXDIMS];
 
+    /*
+     * Fast lane for exact Python number scalars with no requested
+     * dtype: allocate the 0-d carrier directly and store the value,
+     * skipping parameter discovery and the generic setitem.  The
+     * exact builtin types cannot provide __array__ or the array
+     * interfaces, and the depth/writebackifcopy validation below is
+     * preserved by the guards here.  This path runs for every scalar
+     * operand of a ufunc, e.g. 'arr + 3.5'.
+     */
+    if (newtype == NULL && context == NULL && min_depth <= 0 &&
+            !(flags & (NPY_ARRAY_WRITEBACKIFCOPY |
+                       NPY_ARRAY_UPDATEIFCOPY))) {
+        int type_num = -1;
+        npy_double fval = 0.0;
+        npy_long lval = 0;
+
+        if (PyFloat_CheckExact(op)) {
+            type_num = NPY_DOUBLE;
+            fval = PyFloat_AS_DOUBLE(op);
+        }
+        else if (PyBool_Check(op)) {
+            type_num = NPY_BOOL;
+            lval = (op == Py_True);
+        }
+#if defined(NPY_PY3K)
+        else if (PyLong_CheckExact(op)) {
+            int overflow = 0;
+
+            lval = PyLong_AsLongAndOverflow(op, &overflow);
+            if (overflow == 0) {
+                /* matches _array_find_python_scalar_type: ints that
+                 * fit in a C long become NPY_LONG, larger ones take
+                 * the general path */
+                type_num = NPY_LONG;
+            }
+        }
+#endif
+        else if (PyComplex_CheckExact(op)) {
+            type_num = NPY_CDOUBLE;
+        }
+
+        if (type_num != -1) {
+            ret = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+                                        PyArray_DescrFromType(type_num),
+                                        0, NULL, NULL, NULL, 0, NULL);
+            if (ret == NULL) {
+                return NULL;
+            }
+            switch (type_num) {
+                case NPY_DOUBLE:
+                    *(npy_double *)PyArray_DATA(ret) = fval;
+                    break;
+                case NPY_BOOL:
+                    *(npy_bool *)PyArray_DATA(ret) = (npy_bool)lval;
+                    break;
+                case NPY_LONG:
+                    *(npy_long *)PyArray_DATA(ret) = lval;
+                    break;
+                case NPY_CDOUBLE: {
+                    Py_complex cval = PyComplex_AsCComplex(op);
+
+                    ((npy_cdouble *)PyArray_DATA(ret))->real = cval.real;
+                    ((npy_cdouble *)PyArray_DATA(ret))->imag = cval.imag;
+                    break;
+                }
+            }
+            return (PyObject *)ret;
+        }
+    }
+
     /* Get either the array or its parameters if it isn't an array */
     if (PyArray_GetArrayParamsFromObject(op, newtype,
                         0, &dtype,
@@ -3547,9 +3871,19 @@ array_fromfile_binary(FILE *fp, PyArray_Descr *dtype, npy_intp num, size_t *nrea
         Py_DECREF(dtype);
         return NULL;
     }
-    NPY_BEGIN_ALLOW_THREADS;
-    *nread = fread(PyArray_DATA(r), dtype->elsize, num, fp);
-    NPY_END_ALLOW_THREADS;
+    {
+        npy_intp nbytesread;
+
+        if (npy_chunked_read(fp, PyArray_DATA(r), num * dtype->elsize,
+                             &nbytesread)) {
+            *nread = nbytesread / dtype->elsize;
+        }
+        else {
+            NPY_BEGIN_ALLOW_THREADS;
+            *nread = fread(PyArray_DATA(r), dtype->elsize, num, fp);
+            NPY_END_ALLOW_THREADS;
+        }
+    }
     Py_DECREF(dtype);
     return r;
 }
@@ -3694,9 +4028,27 @@ PyArray_FromFile(FILE *fp, PyArray_Descr *dtype, npy_intp num, char *sep)
             Py_DECREF(dtype);
             return NULL;
         }
-        ret = array_from_text(dtype, num, sep, &nread, fp,
-                (next_element) fromfile_next_element,
-                (skip_separator) fromfile_skip_separator, NULL);
+        if (dtype->f->fromstr != NULL && npy_ftell(fp) >= 0) {
+            /*
+             * seekable stream: parse in large blocks through the string
+             * based parsers instead of one scanf call per element
+             */
+            textfile_stream ts;
+
+            if (textfile_stream_init(&ts, fp) < 0) {
+                Py_DECREF(dtype);
+                return NULL;
+            }
+            ret = array_from_text(dtype, num, sep, &nread, &ts,
+                    (next_element) textfile_next_element,
+                    (skip_separator) textfile_skip_separator, NULL);
+            textfile_stream_close(&ts);
+        }
+        else {
+            ret = array_from_text(dtype, num, sep, &nread, fp,
+                    (next_element) fromfile_next_element,
+                    (skip_separator) fromfile_skip_separator, NULL);
+        }
     }
     if (ret == NULL) {
         Py_DECREF(dtype);
@@ -12,6 +12,14 @@ PyArray_NewFromDescrAndBase(
         int nd, npy_intp *dims, npy_intp *strides, void *data,
         int flags, PyObject *obj, PyObject *base);
 
+NPY_NO_EXPORT PyObject *
+PyArray_NewViewFromBase(PyArrayObject *base, int nd, npy_intp *dims,
+                        npy_intp *strides, void *data);
+
+NPY_NO_EXPORT PyObject *
+PyArray_SlidingWindowView(PyArrayObject *ap, npy_intp const *window,
+                          int const *axes, int nwin);
+
 NPY_NO_EXPORT PyObject *
 PyArray_NewFromDescr_int(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
                          npy_intp *dims, npy_intp *strides, void *data,
@@ -38,6 +38,33 @@ get_day_of_week(npy_datetime date)
     return day_of_week;
 }
 
+/*
+ * Cumulative business-day index tables for one weekmask, precomputed
+ * once per calendar so applying an offset or counting a partial week
+ * costs O(1) instead of stepping day by day. partial[d] is the number
+ * of business days strictly before day 'd' of the week, and nth_day[k]
+ * is the day of the week of the k-th business day.
+ */
+typedef struct {
+    int partial[8];
+    int nth_day[7];
+} npy_busday_weektable;
+
+static void
+fill_busday_weektable(npy_bool *weekmask, npy_busday_weektable *weektable)
+{
+    int i, n = 0;
+
+    for (i = 0; i < 7; ++i) {
+        weektable->partial[i] = n;
+        if (weekmask[i]) {
+            weektable->nth_day[n] = i;
+            ++n;
+        }
+    }
+    weektable->partial[7] = n;
+}
+
 /*
  * Returns 1 if the date is a holiday (contained in the sorted
  * list of dates), 0 otherwise.
@@ -273,6 +300,7 @@ apply_business_day_offset(npy_datetime date, npy_int64 offset,
                     npy_datetime *out,
                     NPY_BUSDAY_ROLL roll,
                     npy_bool *weekmask, int busdays_in_weekmask,
+                    const npy_busday_weektable *weektable,
                     npy_datetime *holidays_begin, npy_datetime *holidays_end)
 {
     int day_of_week = 0;
@@ -292,32 +320,32 @@ apply_business_day_offset(npy_datetime date, npy_int64 offset,
         return 0;
     }
 
-    /* Now we're on a valid business day */
+    /*
+     * Now we're on a valid business day. The weekmask tables take us
+     * straight to the date holding the remaining offset; the holidays
+     * crossed on the way are folded back into the offset, repeating
+     * until no new holidays are crossed (the holiday list only holds
+     * dates on weekmask days, so each one costs exactly one step).
+     */
     if (offset > 0) {
         /* Remove any earlier holidays */
         holidays_begin = find_earliest_holiday_on_or_after(date,
                                             holidays_begin, holidays_end);
 
-        /* Jump by as many weeks as we can */
-        date += (offset / busdays_in_weekmask) * 7;
-        offset = offset % busdays_in_weekmask;
-
-        /* Adjust based on the number of holidays we crossed */
-        holidays_temp = find_earliest_holiday_after(date,
-                                            holidays_begin, holidays_end);
-        offset += holidays_temp - holidays_begin;
-        holidays_begin = holidays_temp;
-
-        /* Step until we use up the rest of the offset */
         while (offset > 0) {
-            ++date;
-            if (++day_of_week == 7) {
-                day_of_week = 0;
-            }
-            if (weekmask[day_of_week] && !is_holiday(date,
-                                            holidays_begin, holidays_end)) {
-                offset--;
-            }
+            npy_int64 total = weektable->partial[day_of_week] + offset;
+            int new_day_of_week = weektable->nth_day[total %
+                                                     busdays_in_weekmask];
+
+            date += (total / busdays_in_weekmask) * 7 +
+                    (new_day_of_week - day_of_week);
+            day_of_week = new_day_of_week;
+
+            /* Make up for the holidays we crossed */
+            holidays_temp = find_earliest_holiday_after(date,
+                                                holidays_begin, holidays_end);
+            offset = holidays_temp - holidays_begin;
+            holidays_begin = holidays_temp;
         }
     }
     else if (offset < 0) {
@@ -325,26 +353,26 @@ apply_business_day_offset(npy_datetime date, npy_int64 offset,
         holidays_end = find_earliest_holiday_after(date,
                                             holidays_begin, holidays_end);
 
-        /* Jump by as many weeks as we can */
-        date += (offset / busdays_in_weekmask) * 7;
-        offset = offset % busdays_in_weekmask;
-
-        /* Adjust based on the number of holidays we crossed */
-        holidays_temp = find_earliest_holiday_on_or_after(date,
-                                            holidays_begin, holidays_end);
-        offset -= holidays_end - holidays_temp;
-        holidays_end = holidays_temp;
-
-        /* Step until we use up the rest of the offset */
         while (offset < 0) {
-            --date;
-            if (--day_of_week == -1) {
-                day_of_week = 6;
-            }
-            if (weekmask[day_of_week] && !is_holiday(date,
-                                            holidays_begin, holidays_end)) {
-                offset++;
+            npy_int64 total = weektable->partial[day_of_week] + offset;
+            npy_int64 weeks = total / busdays_in_weekmask;
+            int rem = (int)(total % busdays_in_weekmask);
+            int new_day_of_week;
+
+            /* Floor division, so rem indexes into the week */
+            if (rem < 0) {
+                --weeks;
+                rem += busdays_in_weekmask;
             }
+            new_day_of_week = weektable->nth_day[rem];
+            date += weeks * 7 + (new_day_of_week - day_of_week);
+            day_of_week = new_day_of_week;
+
+            /* Make up for the holidays we crossed */
+            holidays_temp = find_earliest_holiday_on_or_after(date,
+                                                holidays_begin, holidays_end);
+            offset = -(holidays_end - holidays_temp);
+            holidays_end = holidays_temp;
         }
     }
 
@@ -361,7 +389,8 @@ apply_business_day_offset(npy_datetime date, npy_int64 offset,
 static int
 apply_business_day_count(npy_datetime date_begin, npy_datetime date_end,
                     npy_int64 *out,
-                    npy_bool *weekmask, int busdays_in_weekmask,
+                    int busdays_in_weekmask,
+                    const npy_busday_weektable *weektable,
                     npy_datetime *holidays_begin, npy_datetime *holidays_end)
 {
     npy_int64 count, whole_weeks;
@@ -404,18 +433,19 @@ apply_business_day_count(npy_datetime date_begin, npy_datetime date_end,
     date_begin += whole_weeks * 7;
 
     if (date_begin < date_end) {
+        int wrap;
+
         /* Get the day of the week for 'date_begin' */
         day_of_week = get_day_of_week(date_begin);
 
-        /* Count the remaining days one by one */
-        while (date_begin < date_end) {
-            if (weekmask[day_of_week]) {
-                count++;
-            }
-            ++date_begin;
-            if (++day_of_week == 7) {
-                day_of_week = 0;
-            }
+        /* Count the remaining partial week from the cumulative table */
+        wrap = day_of_week + (int)(date_end - date_begin);
+        if (wrap > 7) {
+            count += weektable->partial[7] - weektable->partial[day_of_week] +
+                     weektable->partial[wrap - 7];
+        }
+        else {
+            count += weektable->partial[wrap] - weektable->partial[day_of_week];
         }
     }
 
@@ -465,6 +495,7 @@ business_day_offset(PyArrayObject *dates, PyArrayObject *offsets,
     NpyIter *iter = NULL;
     PyArrayObject *op[3] = {NULL, NULL, NULL};
     npy_uint32 op_flags[3], flags;
+    npy_busday_weektable weektable;
 
     PyArrayObject *ret = NULL;
 
@@ -475,6 +506,9 @@ business_day_offset(PyArrayObject *dates, PyArrayObject *offsets,
         return NULL;
     }
 
+    /* Precompute the cumulative index tables for the weekmask */
+    fill_busday_weektable(weekmask, &weektable);
+
     /* First create the data types for dates and offsets */
     temp_meta.base = NPY_FR_D;
     temp_meta.num = 1;
@@ -536,6 +570,7 @@ business_day_offset(PyArrayObject *dates, PyArrayObject *offsets,
                                        (npy_int64 *)data_out,
                                        roll,
                                        weekmask, busdays_in_weekmask,
+                                       &weektable,
                                        holidays_begin, holidays_end) < 0) {
                     goto fail;
                 }
@@ -601,6 +636,7 @@ business_day_count(PyArrayObject *dates_begin, PyArrayObject *dates_end,
     NpyIter *iter = NULL;
     PyArrayObject *op[3] = {NULL, NULL, NULL};
     npy_uint32 op_flags[3], flags;
+    npy_busday_weektable weektable;
 
     PyArrayObject *ret = NULL;
 
@@ -611,6 +647,9 @@ business_day_count(PyArrayObject *dates_begin, PyArrayObject *dates_end,
         return NULL;
     }
 
+    /* Precompute the cumulative index tables for the weekmask */
+    fill_busday_weektable(weekmask, &weektable);
+
     /* First create the data types for the dates and the int64 output */
     temp_meta.base = NPY_FR_D;
     temp_meta.num = 1;
@@ -670,7 +709,7 @@ business_day_count(PyArrayObject *dates_begin, PyArrayObject *dates_end,
                 if (apply_business_day_count(*(npy_int64 *)data_dates_begin,
                                        *(npy_int64 *)data_dates_end,
                                        (npy_int64 *)data_out,
-                                       weekmask, busdays_in_weekmask,
+                                       busdays_in_weekmask, &weektable,
                                        holidays_begin, holidays_end) < 0) {
                     goto fail;
                 }
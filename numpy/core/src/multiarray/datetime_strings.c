@@ -186,6 +186,124 @@ convert_datetimestruct_utc_to_local(npy_datetimestruct *out_dts_local,
     return 0;
 }
 
+/*
+ * Branch-reduced parser for the fixed-width layouts that bulk data
+ * overwhelmingly uses: "YYYY-MM-DD", optionally followed by
+ * "[T ]hh:mm:ss" and a ".f{1,18}" fraction, with no timezone suffix.
+ * Digit positions are validated with unsigned range checks OR-ed into
+ * one flag, so the hot path is almost branch free.
+ *
+ * Returns 0 and fills 'out' and 'out_bestunit' on success.  Returns -1
+ * WITHOUT setting an exception when the string does not match this
+ * layout (including out-of-range fields), in which case the caller must
+ * run the general parser, which produces the detailed errors.
+ */
+static int
+parse_fixed_iso_8601(const char *str, Py_ssize_t len,
+                     npy_datetimestruct *out, NPY_DATETIMEUNIT *out_bestunit)
+{
+#define FIXED_DIGIT(i) (npy_uint32)(str[i] - '0')
+    npy_uint32 bad, year, month, day, hour = 0, min = 0, sec = 0;
+    int year_leap;
+    NPY_DATETIMEUNIT bestunit;
+
+    if (len < 10 || str[4] != '-' || str[7] != '-') {
+        return -1;
+    }
+    bad = (FIXED_DIGIT(0) > 9) | (FIXED_DIGIT(1) > 9) |
+          (FIXED_DIGIT(2) > 9) | (FIXED_DIGIT(3) > 9) |
+          (FIXED_DIGIT(5) > 9) | (FIXED_DIGIT(6) > 9) |
+          (FIXED_DIGIT(8) > 9) | (FIXED_DIGIT(9) > 9);
+    if (bad) {
+        return -1;
+    }
+    year = ((FIXED_DIGIT(0) * 10 + FIXED_DIGIT(1)) * 10 +
+            FIXED_DIGIT(2)) * 10 + FIXED_DIGIT(3);
+    month = FIXED_DIGIT(5) * 10 + FIXED_DIGIT(6);
+    day = FIXED_DIGIT(8) * 10 + FIXED_DIGIT(9);
+    year_leap = is_leapyear(year);
+    if (month - 1 > 11 || day - 1 >
+            (npy_uint32)(_days_per_month_table[year_leap][month - 1] - 1)) {
+        return -1;
+    }
+
+    if (len == 10) {
+        bestunit = NPY_FR_D;
+    }
+    else {
+        if (len < 19 || (str[10] != 'T' && str[10] != ' ') ||
+                str[13] != ':' || str[16] != ':') {
+            return -1;
+        }
+        bad = (FIXED_DIGIT(11) > 9) | (FIXED_DIGIT(12) > 9) |
+              (FIXED_DIGIT(14) > 9) | (FIXED_DIGIT(15) > 9) |
+              (FIXED_DIGIT(17) > 9) | (FIXED_DIGIT(18) > 9);
+        if (bad) {
+            return -1;
+        }
+        hour = FIXED_DIGIT(11) * 10 + FIXED_DIGIT(12);
+        min = FIXED_DIGIT(14) * 10 + FIXED_DIGIT(15);
+        sec = FIXED_DIGIT(17) * 10 + FIXED_DIGIT(18);
+        if (hour > 23 || min > 59 || sec > 59) {
+            return -1;
+        }
+
+        if (len == 19) {
+            bestunit = NPY_FR_s;
+        }
+        else {
+            /* FRACTION (1 to 18 digits after a '.', then the end) */
+            Py_ssize_t i = 20, ndigits;
+            int group, numdigits;
+            npy_uint32 frac[3] = {0, 0, 0};
+
+            if (str[19] != '.' || len == 20 || len > 20 + 18) {
+                return -1;
+            }
+            for (group = 0; group < 3; group++) {
+                for (numdigits = 0; numdigits < 6; numdigits++) {
+                    frac[group] *= 10;
+                    if (i < len) {
+                        npy_uint32 d = FIXED_DIGIT(i);
+
+                        if (d > 9) {
+                            return -1;
+                        }
+                        frac[group] += d;
+                        i++;
+                    }
+                }
+                if (i >= len) {
+                    break;
+                }
+            }
+            ndigits = len - 20;
+            if (ndigits <= 6) {
+                bestunit = ndigits > 3 ? NPY_FR_us : NPY_FR_ms;
+            }
+            else if (ndigits <= 12) {
+                bestunit = ndigits > 9 ? NPY_FR_ps : NPY_FR_ns;
+            }
+            else {
+                bestunit = ndigits > 15 ? NPY_FR_as : NPY_FR_fs;
+            }
+            out->us = frac[0];
+            out->ps = frac[1];
+            out->as = frac[2];
+        }
+    }
+
+    out->year = year;
+    out->month = month;
+    out->day = day;
+    out->hour = hour;
+    out->min = min;
+    out->sec = sec;
+    *out_bestunit = bestunit;
+    return 0;
+#undef FIXED_DIGIT
+}
+
 /*
  * Parses (almost) standard ISO 8601 date strings. The differences are:
  *
@@ -364,6 +482,15 @@ parse_iso_8601_datetime(char *str, Py_ssize_t len,
         *out_special = 0;
     }
 
+    /*
+     * Try the fixed-width fast path first; anything it cannot handle
+     * (unusual layouts, timezones, out-of-range fields) falls through
+     * to the general parser below.
+     */
+    if (parse_fixed_iso_8601(str, len, out, &bestunit) == 0) {
+        goto finish;
+    }
+
     substr = str;
     sublen = len;
 
@@ -1003,22 +1130,42 @@ make_iso_8601_datetime(npy_datetimestruct *dts, char *outstr, npy_intp outlen,
     }
 
     /* YEAR */
-    /*
-     * Can't use PyOS_snprintf, because it always produces a '\0'
-     * character at the end, and NumPy string types are permitted
-     * to have data all the way to the end of the buffer.
-     */
+    if (dts->year >= 0 && dts->year <= 9999) {
+        /* The overwhelmingly common case is four digits; emit them
+         * directly instead of paying for snprintf on every element. */
+        npy_int32 year = (npy_int32)dts->year;
+
+        if (sublen < 4) {
+            goto string_too_short;
+        }
+        substr[3] = (char)(year % 10 + '0');
+        year /= 10;
+        substr[2] = (char)(year % 10 + '0');
+        year /= 10;
+        substr[1] = (char)(year % 10 + '0');
+        substr[0] = (char)(year / 10 + '0');
+        substr += 4;
+        sublen -= 4;
+    }
+    else {
+        /*
+         * Can't use PyOS_snprintf, because it always produces a '\0'
+         * character at the end, and NumPy string types are permitted
+         * to have data all the way to the end of the buffer.
+         */
 #ifdef _WIN32
-    tmplen = _snprintf(substr, sublen, "%04" NPY_INT64_FMT, dts->year);
+        tmplen = _snprintf(substr, sublen, "%04" NPY_INT64_FMT, dts->year);
 #else
-    tmplen = snprintf(substr, sublen, "%04" NPY_INT64_FMT, dts->year);
+        tmplen = snprintf(substr, sublen, "%04" NPY_INT64_FMT, dts->year);
 #endif
-    /* If it ran out of space or there isn't space for the NULL terminator */
-    if (tmplen < 0 || tmplen > sublen) {
-        goto string_too_short;
+        /* If it ran out of space or there isn't space for the NULL
+         * terminator */
+        if (tmplen < 0 || tmplen > sublen) {
+            goto string_too_short;
+        }
+        substr += tmplen;
+        sublen -= tmplen;
     }
-    substr += tmplen;
-    sublen -= tmplen;
 
     /* Stop if the unit is years */
     if (base == NPY_FR_Y) {
@@ -1074,6 +1074,594 @@ BigInt_ShiftLeft(BigInt *result, npy_uint32 shift)
 }
 
 
+/*
+ * Grisu fast path
+ *
+ * The arbitrary-precision loop in Dragon4() below is correct for every
+ * format and cutoff combination, but it is expensive: each digit costs
+ * several BigInt operations. The overwhelming majority of half, float and
+ * double values can instead be converted with pure 64 bit arithmetic using
+ * the Grisu3 algorithm, falling back to the BigInt loop only when Grisu
+ * cannot prove its digits correct (less than 1% of inputs).
+ *
+ * See "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers", Florian Loitsch, PLDI 2010. The code below follows the
+ * structure of the reference implementation in the double-conversion
+ * library, adapted to the conventions of this file.
+ *
+ * The core idea is to scale the value by a precomputed power of ten so
+ * that it has a binary exponent in a small fixed range, then read decimal
+ * digits directly off the 64 bit fixed-point representation. Because the
+ * scaled value carries a rounding error of +/- 1 unit in the last place,
+ * every result is checked against the error bound before it is accepted.
+ */
+
+typedef struct GrisuFp {
+    npy_uint64 f;  /* significand */
+    npy_int32 e;   /* binary exponent */
+} GrisuFp;
+
+/* digit generation requires the scaled binary exponent to be in this range */
+#define c_GrisuMinTargetExponent (-60)
+#define c_GrisuMaxTargetExponent (-32)
+
+/* round the 128 bit product of two 64 bit significands back to 64 bits */
+static GrisuFp
+GrisuFp_Multiply(GrisuFp x, GrisuFp y)
+{
+    GrisuFp result;
+    npy_uint64 a = x.f >> 32;
+    npy_uint64 b = x.f & bitmask_u64(32);
+    npy_uint64 c = y.f >> 32;
+    npy_uint64 d = y.f & bitmask_u64(32);
+    npy_uint64 ac = a*c, ad = a*d, bc = b*c, bd = b*d;
+    /* the 2^31 term rounds the discarded low half to nearest */
+    npy_uint64 mid = (ad & bitmask_u64(32)) + (bc & bitmask_u64(32)) +
+                     (bd >> 32) + ((npy_uint64)1 << 31);
+
+    result.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+    result.e = x.e + y.e + 64;
+    return result;
+}
+
+/*
+ * Powers of ten rounded to 64 bit significands, for every eighth decimal
+ * exponent from 10^-348 to 10^340. The eight-exponent spacing (~26.6 bits)
+ * is close enough that for any binary exponent some entry scales the value
+ * into the 28 bit target exponent window above.
+ */
+static const struct {
+    npy_uint64 significand;
+    npy_int16 binExponent;
+    npy_int16 decExponent;
+} g_GrisuCachedPowers[] = {
+    {0xfa8fd5a0081c0288ULL, -1220, -348},
+    {0xbaaee17fa23ebf76ULL, -1193, -340},
+    {0x8b16fb203055ac76ULL, -1166, -332},
+    {0xcf42894a5dce35eaULL, -1140, -324},
+    {0x9a6bb0aa55653b2dULL, -1113, -316},
+    {0xe61acf033d1a45dfULL, -1087, -308},
+    {0xab70fe17c79ac6caULL, -1060, -300},
+    {0xff77b1fcbebcdc4fULL, -1034, -292},
+    {0xbe5691ef416bd60cULL, -1007, -284},
+    {0x8dd01fad907ffc3cULL,  -980, -276},
+    {0xd3515c2831559a83ULL,  -954, -268},
+    {0x9d71ac8fada6c9b5ULL,  -927, -260},
+    {0xea9c227723ee8bcbULL,  -901, -252},
+    {0xaecc49914078536dULL,  -874, -244},
+    {0x823c12795db6ce57ULL,  -847, -236},
+    {0xc21094364dfb5637ULL,  -821, -228},
+    {0x9096ea6f3848984fULL,  -794, -220},
+    {0xd77485cb25823ac7ULL,  -768, -212},
+    {0xa086cfcd97bf97f4ULL,  -741, -204},
+    {0xef340a98172aace5ULL,  -715, -196},
+    {0xb23867fb2a35b28eULL,  -688, -188},
+    {0x84c8d4dfd2c63f3bULL,  -661, -180},
+    {0xc5dd44271ad3cdbaULL,  -635, -172},
+    {0x936b9fcebb25c996ULL,  -608, -164},
+    {0xdbac6c247d62a584ULL,  -582, -156},
+    {0xa3ab66580d5fdaf6ULL,  -555, -148},
+    {0xf3e2f893dec3f126ULL,  -529, -140},
+    {0xb5b5ada8aaff80b8ULL,  -502, -132},
+    {0x87625f056c7c4a8bULL,  -475, -124},
+    {0xc9bcff6034c13053ULL,  -449, -116},
+    {0x964e858c91ba2655ULL,  -422, -108},
+    {0xdff9772470297ebdULL,  -396, -100},
+    {0xa6dfbd9fb8e5b88fULL,  -369,  -92},
+    {0xf8a95fcf88747d94ULL,  -343,  -84},
+    {0xb94470938fa89bcfULL,  -316,  -76},
+    {0x8a08f0f8bf0f156bULL,  -289,  -68},
+    {0xcdb02555653131b6ULL,  -263,  -60},
+    {0x993fe2c6d07b7facULL,  -236,  -52},
+    {0xe45c10c42a2b3b06ULL,  -210,  -44},
+    {0xaa242499697392d3ULL,  -183,  -36},
+    {0xfd87b5f28300ca0eULL,  -157,  -28},
+    {0xbce5086492111aebULL,  -130,  -20},
+    {0x8cbccc096f5088ccULL,  -103,  -12},
+    {0xd1b71758e219652cULL,   -77,   -4},
+    {0x9c40000000000000ULL,   -50,    4},
+    {0xe8d4a51000000000ULL,   -24,   12},
+    {0xad78ebc5ac620000ULL,     3,   20},
+    {0x813f3978f8940984ULL,    30,   28},
+    {0xc097ce7bc90715b3ULL,    56,   36},
+    {0x8f7e32ce7bea5c70ULL,    83,   44},
+    {0xd5d238a4abe98068ULL,   109,   52},
+    {0x9f4f2726179a2245ULL,   136,   60},
+    {0xed63a231d4c4fb27ULL,   162,   68},
+    {0xb0de65388cc8ada8ULL,   189,   76},
+    {0x83c7088e1aab65dbULL,   216,   84},
+    {0xc45d1df942711d9aULL,   242,   92},
+    {0x924d692ca61be758ULL,   269,  100},
+    {0xda01ee641a708deaULL,   295,  108},
+    {0xa26da3999aef774aULL,   322,  116},
+    {0xf209787bb47d6b85ULL,   348,  124},
+    {0xb454e4a179dd1877ULL,   375,  132},
+    {0x865b86925b9bc5c2ULL,   402,  140},
+    {0xc83553c5c8965d3dULL,   428,  148},
+    {0x952ab45cfa97a0b3ULL,   455,  156},
+    {0xde469fbd99a05fe3ULL,   481,  164},
+    {0xa59bc234db398c25ULL,   508,  172},
+    {0xf6c69a72a3989f5cULL,   534,  180},
+    {0xb7dcbf5354e9beceULL,   561,  188},
+    {0x88fcf317f22241e2ULL,   588,  196},
+    {0xcc20ce9bd35c78a5ULL,   614,  204},
+    {0x98165af37b2153dfULL,   641,  212},
+    {0xe2a0b5dc971f303aULL,   667,  220},
+    {0xa8d9d1535ce3b396ULL,   694,  228},
+    {0xfb9b7cd9a4a7443cULL,   720,  236},
+    {0xbb764c4ca7a44410ULL,   747,  244},
+    {0x8bab8eefb6409c1aULL,   774,  252},
+    {0xd01fef10a657842cULL,   800,  260},
+    {0x9b10a4e5e9913129ULL,   827,  268},
+    {0xe7109bfba19c0c9dULL,   853,  276},
+    {0xac2820d9623bf429ULL,   880,  284},
+    {0x80444b5e7aa7cf85ULL,   907,  292},
+    {0xbf21e44003acdd2dULL,   933,  300},
+    {0x8e679c2f5e44ff8fULL,   960,  308},
+    {0xd433179d9c8cb841ULL,   986,  316},
+    {0x9e19db92b4e31ba9ULL,  1013,  324},
+    {0xeb96bf6ebadf77d9ULL,  1039,  332},
+    {0xaf87023b9bf0ee6bULL,  1066,  340},
+};
+
+/*
+ * Pick the cached power of ten whose product with a significand of binary
+ * exponent `exponent` lands in the target exponent window. Returns the
+ * power and stores its decimal exponent in *decExponent.
+ */
+static GrisuFp
+Grisu_CachedPower(npy_int32 exponent, npy_int32 *decExponent)
+{
+    /* 1/log2(10), rounded down so the estimate errs on the small side */
+    const npy_float64 log10_2 = 0.30102999566398114;
+    npy_int32 minExponent = c_GrisuMinTargetExponent - (exponent + 64);
+    npy_int32 k = (npy_int32)ceil((minExponent + 63) * log10_2);
+    npy_int32 index = (348 + k - 1) / 8 + 1;
+    GrisuFp power;
+
+    DEBUG_ASSERT(index >= 0 &&
+                 (size_t)index < sizeof(g_GrisuCachedPowers) /
+                                 sizeof(g_GrisuCachedPowers[0]));
+    power.f = g_GrisuCachedPowers[index].significand;
+    power.e = g_GrisuCachedPowers[index].binExponent;
+    *decExponent = g_GrisuCachedPowers[index].decExponent;
+    DEBUG_ASSERT(minExponent <= power.e);
+    DEBUG_ASSERT(power.e <= c_GrisuMaxTargetExponent - (exponent + 64));
+    return power;
+}
+
+/*
+ * Largest power of ten less than or equal to `number`, where `number` has
+ * at most `numberBits` significant bits. Stores the power in *power and
+ * returns its exponent plus one.
+ */
+static npy_int32
+Grisu_BiggestPowerTen(npy_uint32 number, npy_int32 numberBits,
+                      npy_uint32 *power)
+{
+    /* powersOfTen[i] = 10^(i-1), with a dummy leading entry */
+    static const npy_uint32 powersOfTen[] = {
+        0, 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000,
+    };
+    /* 1233/4096 is a good enough approximation of log10(2) */
+    npy_int32 guess = ((numberBits + 1) * 1233 >> 12) + 1;
+
+    /* the estimate only ever overshoots by one */
+    if (number < powersOfTen[guess]) {
+        guess--;
+    }
+    *power = powersOfTen[guess];
+    return guess;
+}
+
+/*
+ * Decide whether the candidate digits, which represent a value just below
+ * the upper boundary of the rounding interval, can be weeded down to the
+ * digits closest to the actual value, given the accumulated error `unit`.
+ * Returns false when the error bounds make the answer ambiguous.
+ */
+static npy_bool
+Grisu_RoundWeed(char *digits, npy_int32 length, npy_uint64 distanceTooHighW,
+                npy_uint64 unsafeInterval, npy_uint64 rest,
+                npy_uint64 tenKappa, npy_uint64 unit)
+{
+    npy_uint64 smallDistance = distanceTooHighW - unit;
+    npy_uint64 bigDistance = distanceTooHighW + unit;
+
+    /* move the last digit towards the value while it provably gets closer */
+    while (rest < smallDistance &&
+           unsafeInterval - rest >= tenKappa &&
+           (rest + tenKappa < smallDistance ||
+            smallDistance - rest >= rest + tenKappa - smallDistance)) {
+        digits[length - 1]--;
+        rest += tenKappa;
+    }
+
+    /* reject if the neighbor on the other side would be just as close */
+    if (rest < bigDistance &&
+        unsafeInterval - rest >= tenKappa &&
+        (rest + tenKappa < bigDistance ||
+         bigDistance - rest > rest + tenKappa - bigDistance)) {
+        return NPY_FALSE;
+    }
+
+    /* accept only comfortably inside the safe interval */
+    return (2 * unit <= rest) && (rest <= unsafeInterval - 4 * unit);
+}
+
+/*
+ * Round a fixed-length digit string to the nearest value. Returns false
+ * when the remainder is too close to a tie for the error bound `unit` --
+ * the BigInt loop then resolves the tie with IEEE half-even rounding.
+ * Rounding up out of a 9 is also left to the BigInt loop: depending on
+ * the exact digits it represents such a result either with a truncated
+ * carry or with an explicit trailing zero, which cannot be told apart
+ * from the approximation used here.
+ */
+static npy_bool
+Grisu_RoundWeedCounted(char *digits, npy_int32 length, npy_uint64 rest,
+                       npy_uint64 tenKappa, npy_uint64 unit)
+{
+    DEBUG_ASSERT(rest < tenKappa);
+    if (unit >= tenKappa || tenKappa - unit <= unit) {
+        return NPY_FALSE;
+    }
+    /* provably rounds down */
+    if ((tenKappa - rest > rest) && (tenKappa - 2 * rest >= 2 * unit)) {
+        return NPY_TRUE;
+    }
+    /* provably rounds up */
+    if ((rest > unit) && (tenKappa - (rest - unit) <= rest - unit)) {
+        if (digits[length - 1] == '9') {
+            return NPY_FALSE;
+        }
+        digits[length - 1]++;
+        return NPY_TRUE;
+    }
+    return NPY_FALSE;
+}
+
+/*
+ * Generate the shortest digit string that falls inside the rounding
+ * interval (low, high), reading digits off the fixed-point representation
+ * of the scaled upper boundary. All three inputs share the same exponent,
+ * which must be in the target range.
+ */
+static npy_bool
+Grisu_DigitGen(GrisuFp low, GrisuFp w, GrisuFp high,
+               char *digits, npy_int32 *length, npy_int32 *kappa)
+{
+    npy_uint64 unit = 1;
+    GrisuFp tooLow, tooHigh, unsafeInterval, one;
+    npy_uint32 integrals, divisor;
+    npy_uint64 fractionals;
+
+    DEBUG_ASSERT(low.e == w.e && w.e == high.e);
+    DEBUG_ASSERT(low.f + 1 <= high.f - 1);
+    DEBUG_ASSERT(c_GrisuMinTargetExponent <= w.e &&
+                 w.e <= c_GrisuMaxTargetExponent);
+
+    /*
+     * low and high are off by at most one unit each; widen the interval so
+     * that anything we cannot prove inside it is rejected by RoundWeed.
+     */
+    tooLow.f = low.f - unit;
+    tooLow.e = low.e;
+    tooHigh.f = high.f + unit;
+    tooHigh.e = high.e;
+    unsafeInterval.f = tooHigh.f - tooLow.f;
+    unsafeInterval.e = tooHigh.e;
+
+    /* fixed-point split of the upper boundary at the binary point */
+    one.f = (npy_uint64)1 << -w.e;
+    one.e = w.e;
+    integrals = (npy_uint32)(tooHigh.f >> -one.e);
+    fractionals = tooHigh.f & (one.f - 1);
+
+    *kappa = Grisu_BiggestPowerTen(integrals, 64 + one.e, &divisor);
+    *length = 0;
+
+    /* digits of the integral part */
+    while (*kappa > 0) {
+        npy_uint32 digit = integrals / divisor;
+        npy_uint64 rest;
+
+        DEBUG_ASSERT(digit <= 9);
+        digits[*length] = (char)('0' + digit);
+        (*length)++;
+        integrals %= divisor;
+        (*kappa)--;
+        rest = ((npy_uint64)integrals << -one.e) + fractionals;
+        if (rest < unsafeInterval.f) {
+            return Grisu_RoundWeed(digits, *length, tooHigh.f - w.f,
+                                   unsafeInterval.f, rest,
+                                   (npy_uint64)divisor << -one.e, unit);
+        }
+        divisor /= 10;
+    }
+
+    /* digits of the fractional part, scaling everything up by ten */
+    for (;;) {
+        npy_uint32 digit;
+
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval.f *= 10;
+        digit = (npy_uint32)(fractionals >> -one.e);
+        DEBUG_ASSERT(digit <= 9);
+        digits[*length] = (char)('0' + digit);
+        (*length)++;
+        fractionals &= one.f - 1;
+        (*kappa)--;
+        if (fractionals < unsafeInterval.f) {
+            return Grisu_RoundWeed(digits, *length,
+                                   (tooHigh.f - w.f) * unit,
+                                   unsafeInterval.f, fractionals, one.f,
+                                   unit);
+        }
+    }
+}
+
+/*
+ * Generate exactly `requestedDigits` digits of w, correctly rounded.
+ * Returns false when the accumulated error makes the last digit uncertain.
+ */
+static npy_bool
+Grisu_DigitGenCounted(GrisuFp w, npy_int32 requestedDigits,
+                      char *digits, npy_int32 *length, npy_int32 *kappa)
+{
+    npy_uint64 wError = 1;
+    GrisuFp one;
+    npy_uint32 integrals, divisor;
+    npy_uint64 fractionals;
+
+    DEBUG_ASSERT(c_GrisuMinTargetExponent <= w.e &&
+                 w.e <= c_GrisuMaxTargetExponent);
+
+    one.f = (npy_uint64)1 << -w.e;
+    one.e = w.e;
+    integrals = (npy_uint32)(w.f >> -one.e);
+    fractionals = w.f & (one.f - 1);
+
+    *kappa = Grisu_BiggestPowerTen(integrals, 64 + one.e, &divisor);
+    *length = 0;
+
+    while (*kappa > 0) {
+        npy_uint32 digit = integrals / divisor;
+
+        DEBUG_ASSERT(digit <= 9);
+        digits[*length] = (char)('0' + digit);
+        (*length)++;
+        integrals %= divisor;
+        (*kappa)--;
+        requestedDigits--;
+        if (requestedDigits == 0) {
+            break;
+        }
+        divisor /= 10;
+    }
+
+    if (requestedDigits == 0) {
+        npy_uint64 rest = ((npy_uint64)integrals << -one.e) + fractionals;
+        return Grisu_RoundWeedCounted(digits, *length, rest,
+                                      (npy_uint64)divisor << -one.e, wError);
+    }
+
+    /* each fractional digit multiplies the error by ten */
+    while (requestedDigits > 0 && fractionals > wError) {
+        npy_uint32 digit;
+
+        fractionals *= 10;
+        wError *= 10;
+        digit = (npy_uint32)(fractionals >> -one.e);
+        DEBUG_ASSERT(digit <= 9);
+        digits[*length] = (char)('0' + digit);
+        (*length)++;
+        fractionals &= one.f - 1;
+        (*kappa)--;
+        requestedDigits--;
+    }
+    if (requestedDigits != 0) {
+        return NPY_FALSE;
+    }
+    return Grisu_RoundWeedCounted(digits, *length, fractionals, one.f,
+                                  wError);
+}
+
+/*
+ * Shortest uniquely identifying digits of mantissa * 2^exponent. The
+ * margin layout mirrors the BigInt loop: the upper margin is a full half
+ * unit in the last place, the lower margin is half of that when the value
+ * sits on a power-of-two boundary (hasUnequalMargins).
+ */
+static npy_bool
+Grisu_Shortest(npy_uint64 mantissa, npy_int32 exponent,
+               npy_uint32 mantissaBit, npy_bool hasUnequalMargins,
+               char *digits, npy_int32 *length, npy_int32 *firstExponent)
+{
+    GrisuFp w, plus, minus, tenMk, scaledW, scaledPlus, scaledMinus;
+    npy_int32 decExponent, kappa;
+    npy_uint32 shift;
+
+    /* boundaries of the rounding interval, on a common exponent */
+    plus.f = (mantissa << 1) + 1;
+    plus.e = exponent - 1;
+    shift = 63 - LogBase2_64(plus.f);
+    plus.f <<= shift;
+    plus.e -= shift;
+    if (hasUnequalMargins) {
+        minus.f = (mantissa << 2) - 1;
+        minus.e = exponent - 2;
+    }
+    else {
+        minus.f = (mantissa << 1) - 1;
+        minus.e = exponent - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    /* the value itself, normalized */
+    w.f = mantissa << (63 - mantissaBit);
+    w.e = exponent - (63 - (npy_int32)mantissaBit);
+    DEBUG_ASSERT(w.e == plus.e);
+
+    tenMk = Grisu_CachedPower(w.e, &decExponent);
+    scaledW = GrisuFp_Multiply(w, tenMk);
+    scaledPlus = GrisuFp_Multiply(plus, tenMk);
+    scaledMinus = GrisuFp_Multiply(minus, tenMk);
+
+    if (!Grisu_DigitGen(scaledMinus, scaledW, scaledPlus,
+                        digits, length, &kappa)) {
+        return NPY_FALSE;
+    }
+    /* the scaling by 10^decExponent is undone in the decimal exponent */
+    *firstExponent = *length - decExponent + kappa - 1;
+    return NPY_TRUE;
+}
+
+/* Correctly rounded `requestedDigits` leading digits of mantissa * 2^exponent */
+static npy_bool
+Grisu_Counted(npy_uint64 mantissa, npy_int32 exponent, npy_uint32 mantissaBit,
+              npy_int32 requestedDigits, char *digits, npy_int32 *length,
+              npy_int32 *firstExponent)
+{
+    GrisuFp w, tenMk, scaledW;
+    npy_int32 decExponent, kappa;
+
+    w.f = mantissa << (63 - mantissaBit);
+    w.e = exponent - (63 - (npy_int32)mantissaBit);
+
+    tenMk = Grisu_CachedPower(w.e, &decExponent);
+    scaledW = GrisuFp_Multiply(w, tenMk);
+
+    if (!Grisu_DigitGenCounted(scaledW, requestedDigits,
+                               digits, length, &kappa)) {
+        return NPY_FALSE;
+    }
+    *firstExponent = *length - decExponent + kappa - 1;
+    return NPY_TRUE;
+}
+
+/*
+ * Fast-path front end for Dragon4(). Returns the number of digits written
+ * to pOutBuffer, or 0 when the fast path cannot guarantee the exact same
+ * digits as the BigInt loop, in which case the caller falls through to it.
+ *
+ * The mapping onto Dragon4's modes:
+ *   - unique, no cutoff: the shortest digits directly.
+ *   - unique with cutoff: the shortest digits if they fit, otherwise the
+ *     correctly rounded prefix of the value (which is what the BigInt loop
+ *     produces once the cutoff lands before the uniqueness stop).
+ *   - exact with a total-length cutoff: the correctly rounded prefix. If
+ *     the digits end in a zero we cannot tell whether the BigInt loop
+ *     would have stopped early on an exact remainder, so we fall back.
+ * Fractional cutoffs that cut above the first digit, and exact mode with
+ * fractional cutoffs, are left entirely to the BigInt loop.
+ */
+static npy_uint32
+Dragon4_TryFastPath(npy_uint64 mantissa, npy_int32 exponent,
+                    npy_uint32 mantissaBit, npy_bool hasUnequalMargins,
+                    DigitMode digitMode, CutoffMode cutoffMode,
+                    npy_int32 cutoffNumber, char *pOutBuffer,
+                    npy_uint32 bufferSize, npy_int32 *pOutExponent)
+{
+    char digits[20];
+    npy_int32 length, firstExponent, allowed, i;
+
+    /*
+     * The boundary computations need two spare bits above the mantissa
+     * (this excludes 64 bit extended-precision mantissas), and the digit
+     * buffer above holds at most 20 digits.
+     */
+    if (mantissaBit > 61 || bufferSize < 21) {
+        return 0;
+    }
+
+    if (digitMode == DigitMode_Unique) {
+        if (!Grisu_Shortest(mantissa, exponent, mantissaBit,
+                            hasUnequalMargins, digits, &length,
+                            &firstExponent)) {
+            return 0;
+        }
+        /*
+         * Significant digits permitted by the cutoff. A total-length
+         * cutoff of zero never triggers in the BigInt loop, so it is
+         * treated as unbounded there as well.
+         */
+        allowed = length;
+        if (cutoffNumber >= 0) {
+            if (cutoffMode == CutoffMode_TotalLength) {
+                if (cutoffNumber > 0) {
+                    allowed = cutoffNumber;
+                }
+            }
+            else {
+                allowed = firstExponent + 1 + cutoffNumber;
+            }
+        }
+        if (length > allowed) {
+            /*
+             * The cutoff lands before the uniqueness stop; round the
+             * value itself at the cutoff digit. Deeper cutoffs would
+             * overflow the unit counter in the counted generator.
+             */
+            if (allowed <= 0 || allowed > 17) {
+                return 0;
+            }
+            if (!Grisu_Counted(mantissa, exponent, mantissaBit, allowed,
+                               digits, &length, &firstExponent)) {
+                return 0;
+            }
+        }
+    }
+    else {
+        if (cutoffMode != CutoffMode_TotalLength ||
+                cutoffNumber <= 0 || cutoffNumber > 17) {
+            return 0;
+        }
+        if (!Grisu_Counted(mantissa, exponent, mantissaBit, cutoffNumber,
+                           digits, &length, &firstExponent)) {
+            return 0;
+        }
+        /*
+         * The BigInt loop stops as soon as the remaining value is exactly
+         * zero, omitting trailing zeros; from the rounded digits alone we
+         * cannot tell whether it would have done so here.
+         */
+        if (digits[length - 1] == '0') {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < length; i++) {
+        pOutBuffer[i] = digits[i];
+    }
+    *pOutExponent = firstExponent;
+    return (npy_uint32)length;
+}
+
+
 /*
  * This is an implementation the Dragon4 algorithm to convert a binary number in
  * floating point format to a decimal number in string format. The function
@@ -1185,6 +1773,27 @@ Dragon4(BigInt *bigints, const npy_int32 exponent,
         return 1;
     }
 
+    /*
+     * Mantissas that fit in 64 bits can usually be converted with the
+     * Grisu fast path above, avoiding the BigInt arithmetic entirely.
+     */
+    if (mantissa->length <= 2) {
+        npy_uint64 mantissa64 = mantissa->blocks[0];
+        npy_uint32 fastLength;
+
+        if (mantissa->length == 2) {
+            mantissa64 |= (npy_uint64)mantissa->blocks[1] << 32;
+        }
+        fastLength = Dragon4_TryFastPath(mantissa64, exponent, mantissaBit,
+                                         hasUnequalMargins, digitMode,
+                                         cutoffMode, cutoffNumber,
+                                         pOutBuffer, bufferSize,
+                                         pOutExponent);
+        if (fastLength > 0) {
+            return fastLength;
+        }
+    }
+
     BigInt_Copy(scaledValue, mantissa);
 
     if (hasUnequalMargins) {
@@ -3162,6 +3771,85 @@ make_dragon4_typefuncs(LongDouble, npy_longdouble, NPY_LONGDOUBLE_BINFMT_NAME)
 #undef make_dragon4_typefuncs
 #undef make_dragon4_typefuncs_inner
 
+/*
+ * Format every element of a floating-point array in a single C-level pass,
+ * returning a list of str. This is what arrayprint.py uses to size and fill
+ * the output of an array, and avoids constructing an array scalar and
+ * re-entering this module once per element.
+ */
+static PyObject *
+Dragon4_FormatArray(PyObject *obj, Dragon4_Options *opt)
+{
+    PyArrayObject *arr;
+    PyObject *list;
+    char *data;
+    npy_intp i, size, itemsize;
+    int typenum;
+
+    arr = (PyArrayObject *)PyArray_FromAny(obj, NULL, 0, 0,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+    if (arr == NULL) {
+        return NULL;
+    }
+
+    typenum = PyArray_TYPE(arr);
+    if (typenum != NPY_HALF && typenum != NPY_FLOAT &&
+            typenum != NPY_DOUBLE && typenum != NPY_LONGDOUBLE) {
+        PyErr_SetString(PyExc_TypeError,
+                "array must be of a floating point type");
+        Py_DECREF(arr);
+        return NULL;
+    }
+
+    size = PyArray_SIZE(arr);
+    itemsize = PyArray_ITEMSIZE(arr);
+    data = PyArray_BYTES(arr);
+
+    list = PyList_New(size);
+    if (list == NULL) {
+        Py_DECREF(arr);
+        return NULL;
+    }
+
+    for (i = 0; i < size; i++, data += itemsize) {
+        PyObject *str;
+
+        switch (typenum) {
+            case NPY_HALF:
+                str = opt->scientific ?
+                    Dragon4_Scientific_Half_opt((npy_half *)data, opt) :
+                    Dragon4_Positional_Half_opt((npy_half *)data, opt);
+                break;
+            case NPY_FLOAT:
+                str = opt->scientific ?
+                    Dragon4_Scientific_Float_opt((npy_float *)data, opt) :
+                    Dragon4_Positional_Float_opt((npy_float *)data, opt);
+                break;
+            case NPY_DOUBLE:
+                str = opt->scientific ?
+                    Dragon4_Scientific_Double_opt((npy_double *)data, opt) :
+                    Dragon4_Positional_Double_opt((npy_double *)data, opt);
+                break;
+            default:
+                str = opt->scientific ?
+                    Dragon4_Scientific_LongDouble_opt(
+                            (npy_longdouble *)data, opt) :
+                    Dragon4_Positional_LongDouble_opt(
+                            (npy_longdouble *)data, opt);
+                break;
+        }
+        if (str == NULL) {
+            Py_DECREF(list);
+            Py_DECREF(arr);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, str);
+    }
+
+    Py_DECREF(arr);
+    return list;
+}
+
 PyObject *
 Dragon4_Positional(PyObject *obj, DigitMode digit_mode, CutoffMode cutoff_mode,
                    int precision, int sign, TrimMode trim, int pad_left,
@@ -3196,6 +3884,9 @@ Dragon4_Positional(PyObject *obj, DigitMode digit_mode, CutoffMode cutoff_mode,
         npy_longdouble x = ((PyLongDoubleScalarObject *)obj)->obval;
         return Dragon4_Positional_LongDouble_opt(&x, &opt);
     }
+    else if (PyArray_Check(obj)) {
+        return Dragon4_FormatArray(obj, &opt);
+    }
 
     val = PyFloat_AsDouble(obj);
     if (PyErr_Occurred()) {
@@ -3237,6 +3928,9 @@ Dragon4_Scientific(PyObject *obj, DigitMode digit_mode, int precision,
         npy_longdouble x = ((PyLongDoubleScalarObject *)obj)->obval;
         return Dragon4_Scientific_LongDouble_opt(&x, &opt);
     }
+    else if (PyArray_Check(obj)) {
+        return Dragon4_FormatArray(obj, &opt);
+    }
 
     val = PyFloat_AsDouble(obj);
     if (PyErr_Occurred()) {
@@ -2563,6 +2563,28 @@ _strided_to_strided_field_transfer(char *dst, npy_intp dst_stride,
     }
 }
 
+/*
+ * Specialization of the above for a single field.  With one field there
+ * is no cache locality to gain from processing blocks, so the offsets
+ * are applied once and the field's own transfer function gets the whole
+ * count, making single-field extraction a single tight copy loop.
+ */
+static void
+_strided_to_strided_one_field_transfer(char *dst, npy_intp dst_stride,
+                        char *src, npy_intp src_stride,
+                        npy_intp N, npy_intp NPY_UNUSED(src_itemsize),
+                        NpyAuxData *data)
+{
+    _field_transfer_data *d = (_field_transfer_data *)data;
+    _single_field_transfer *field = &d->fields;
+
+    field->stransfer(dst + field->dst_offset, dst_stride,
+                     src + field->src_offset, src_stride,
+                     N,
+                     field->src_itemsize,
+                     field->data);
+}
+
 /*
  * Handles fields transfer.  To call this, at least one of the dtypes
  * must have fields. Does not take care of object<->structure conversion
@@ -2655,7 +2677,12 @@ get_fields_transfer_function(int aligned,
         }
         data->field_count = field_count;
 
-        *out_stransfer = &_strided_to_strided_field_transfer;
+        if (field_count == 1) {
+            *out_stransfer = &_strided_to_strided_one_field_transfer;
+        }
+        else {
+            *out_stransfer = &_strided_to_strided_field_transfer;
+        }
         *out_transferdata = (NpyAuxData *)data;
 
         return NPY_SUCCEED;
@@ -2705,7 +2732,7 @@ get_fields_transfer_function(int aligned,
 
         data->field_count = 1;
 
-        *out_stransfer = &_strided_to_strided_field_transfer;
+        *out_stransfer = &_strided_to_strided_one_field_transfer;
         *out_transferdata = (NpyAuxData *)data;
 
         return NPY_SUCCEED;
@@ -2774,7 +2801,12 @@ get_fields_transfer_function(int aligned,
 
     data->field_count = field_count;
 
-    *out_stransfer = &_strided_to_strided_field_transfer;
+    if (field_count == 1) {
+        *out_stransfer = &_strided_to_strided_one_field_transfer;
+    }
+    else {
+        *out_stransfer = &_strided_to_strided_field_transfer;
+    }
     *out_transferdata = (NpyAuxData *)data;
 
     return NPY_SUCCEED;
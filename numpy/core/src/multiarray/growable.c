@@ -0,0 +1,346 @@
+/*
+ * A growable one dimensional array for append-heavy ingestion.
+ *
+ * Streaming collectors that emulate append with np.concatenate copy the
+ * whole accumulated array on every batch, which is quadratic overall.  A
+ * _GrowableArray keeps a private 1-d buffer whose capacity doubles when
+ * it fills, so appending n elements in any number of batches costs O(n)
+ * amortized.  While the builder is the sole owner of its buffer the
+ * growth happens in place through PyArray_Resize, i.e. a PyDataMem_RENEW
+ * of the data without copying; once view() has handed out a zero-copy
+ * ndarray of the valid prefix the old buffer is pinned by that view and
+ * the next growth moves to a fresh buffer instead, leaving earlier views
+ * valid as snapshots of the builder at the time they were taken.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include "numpy/arrayobject.h"
+
+#include "npy_config.h"
+
+#include "npy_pycompat.h"
+
+#include "common.h"
+#include "growable.h"
+
+typedef struct {
+    PyObject_HEAD
+    PyArrayObject *buffer;  /* 1-d, owns its data, length == capacity */
+    npy_intp length;        /* number of valid leading elements */
+} PyGrowableArrayObject;
+
+/*
+ * Wrap n elements of buffer starting at element offset in a writeable
+ * ndarray whose base keeps the buffer alive.
+ */
+static PyArrayObject *
+growable_wrap(PyArrayObject *buffer, npy_intp offset, npy_intp n)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(buffer);
+    PyArrayObject *ret;
+
+    Py_INCREF(dtype);
+    ret = (PyArrayObject *)PyArray_NewFromDescr(
+            &PyArray_Type, dtype, 1, &n, NULL,
+            PyArray_BYTES(buffer) + offset * dtype->elsize,
+            NPY_ARRAY_CARRAY, NULL);
+    if (ret == NULL) {
+        return NULL;
+    }
+    Py_INCREF(buffer);
+    if (PyArray_SetBaseObject(ret, (PyObject *)buffer) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return ret;
+}
+
+/*
+ * Make room for at least need elements, doubling the capacity so the
+ * per-element growth cost stays amortized constant.
+ */
+static int
+growable_ensure(PyGrowableArrayObject *self, npy_intp need)
+{
+    npy_intp cap = PyArray_DIM(self->buffer, 0);
+    npy_intp newcap;
+
+    if (need <= cap) {
+        return 0;
+    }
+    newcap = cap > 0 ? cap : 1;
+    while (newcap < need) {
+        if (newcap > NPY_MAX_INTP / 2) {
+            newcap = need;
+            break;
+        }
+        newcap *= 2;
+    }
+
+    if (Py_REFCNT(self->buffer) == 1) {
+        /*
+         * Sole owner: grow in place.  PyArray_Resize reallocates the
+         * data with PyDataMem_RENEW, so nothing is copied when the
+         * allocator can extend the block.
+         */
+        PyArray_Dims newshape = {&newcap, 1};
+        PyObject *res = PyArray_Resize(self->buffer, &newshape, 1,
+                                       NPY_CORDER);
+        if (res == NULL) {
+            return -1;
+        }
+        Py_DECREF(res);
+    }
+    else {
+        /*
+         * Exported views pin the current buffer, so move to a fresh one
+         * and let the old buffer live on underneath those views.
+         */
+        PyArray_Descr *dtype = PyArray_DESCR(self->buffer);
+        PyArrayObject *newbuf;
+
+        Py_INCREF(dtype);
+        newbuf = (PyArrayObject *)PyArray_NewFromDescr(
+                &PyArray_Type, dtype, 1, &newcap, NULL, NULL, 0, NULL);
+        if (newbuf == NULL) {
+            return -1;
+        }
+        if (self->length > 0) {
+            PyArrayObject *dst = growable_wrap(newbuf, 0, self->length);
+            PyArrayObject *src;
+
+            if (dst == NULL) {
+                Py_DECREF(newbuf);
+                return -1;
+            }
+            src = growable_wrap(self->buffer, 0, self->length);
+            if (src == NULL) {
+                Py_DECREF(dst);
+                Py_DECREF(newbuf);
+                return -1;
+            }
+            if (PyArray_CopyInto(dst, src) < 0) {
+                Py_DECREF(src);
+                Py_DECREF(dst);
+                Py_DECREF(newbuf);
+                return -1;
+            }
+            Py_DECREF(src);
+            Py_DECREF(dst);
+        }
+        Py_DECREF(self->buffer);
+        self->buffer = newbuf;
+    }
+    return 0;
+}
+
+static PyObject *
+growable_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    PyGrowableArrayObject *self;
+    PyArray_Descr *dtype = NULL;
+    PyArrayObject *buffer;
+    Py_ssize_t capacity = 16;
+    npy_intp cap;
+    static char *kwlist[] = {"dtype", "capacity", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|n:_GrowableArray",
+                                     kwlist,
+                                     PyArray_DescrConverter, &dtype,
+                                     &capacity)) {
+        return NULL;
+    }
+    if (capacity < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "capacity must be non-negative");
+        Py_DECREF(dtype);
+        return NULL;
+    }
+
+    cap = (npy_intp)capacity;
+    /* Steals the dtype reference, even on failure. */
+    buffer = (PyArrayObject *)PyArray_NewFromDescr(
+            &PyArray_Type, dtype, 1, &cap, NULL, NULL, 0, NULL);
+    if (buffer == NULL) {
+        return NULL;
+    }
+
+    self = (PyGrowableArrayObject *)subtype->tp_alloc(subtype, 0);
+    if (self == NULL) {
+        Py_DECREF(buffer);
+        return NULL;
+    }
+    self->buffer = buffer;
+    self->length = 0;
+    return (PyObject *)self;
+}
+
+static void
+growable_dealloc(PyGrowableArrayObject *self)
+{
+    Py_XDECREF(self->buffer);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+growable_append(PyGrowableArrayObject *self, PyObject *obj)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(self->buffer);
+    PyArrayObject *batch, *dst;
+    npy_intp n;
+
+    Py_INCREF(dtype);
+    batch = (PyArrayObject *)PyArray_FromAny(obj, dtype, 0, 0,
+                                             NPY_ARRAY_FORCECAST, NULL);
+    if (batch == NULL) {
+        return NULL;
+    }
+    n = PyArray_SIZE(batch);
+    if (n == 0) {
+        Py_DECREF(batch);
+        Py_RETURN_NONE;
+    }
+    if (growable_ensure(self, self->length + n) < 0) {
+        Py_DECREF(batch);
+        return NULL;
+    }
+    dst = growable_wrap(self->buffer, self->length, n);
+    if (dst == NULL) {
+        Py_DECREF(batch);
+        return NULL;
+    }
+    /* Flatten the batch in C order into the tail of the buffer. */
+    if (PyArray_CopyAnyInto(dst, batch) < 0) {
+        Py_DECREF(dst);
+        Py_DECREF(batch);
+        return NULL;
+    }
+    Py_DECREF(dst);
+    Py_DECREF(batch);
+    self->length += n;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+growable_view(PyGrowableArrayObject *self, PyObject *NPY_UNUSED(args))
+{
+    return (PyObject *)growable_wrap(self->buffer, 0, self->length);
+}
+
+static Py_ssize_t
+growable_length(PyGrowableArrayObject *self)
+{
+    return (Py_ssize_t)self->length;
+}
+
+static PyObject *
+growable_dtype_get(PyGrowableArrayObject *self)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(self->buffer);
+
+    Py_INCREF(dtype);
+    return (PyObject *)dtype;
+}
+
+static PyObject *
+growable_capacity_get(PyGrowableArrayObject *self)
+{
+    return PyLong_FromSsize_t((Py_ssize_t)PyArray_DIM(self->buffer, 0));
+}
+
+static PyMethodDef growable_methods[] = {
+    {"append",
+        (PyCFunction)growable_append,
+        METH_O, NULL},
+    {"view",
+        (PyCFunction)growable_view,
+        METH_NOARGS, NULL},
+    {NULL, NULL, 0, NULL}           /* sentinel */
+};
+
+static PyGetSetDef growable_getsets[] = {
+    {"dtype",
+        (getter)growable_dtype_get,
+        NULL, NULL, NULL},
+    {"capacity",
+        (getter)growable_capacity_get,
+        NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* sentinel */
+};
+
+static PySequenceMethods growable_as_sequence = {
+    (lenfunc)growable_length,                   /* sq_length */
+    (binaryfunc)NULL,                           /* sq_concat */
+    (ssizeargfunc)NULL,                         /* sq_repeat */
+    (ssizeargfunc)NULL,                         /* sq_item */
+    (ssizessizeargfunc)NULL,                    /* sq_slice */
+    (ssizeobjargproc)NULL,                      /* sq_ass_item */
+    (ssizessizeobjargproc)NULL,                 /* sq_ass_slice */
+    (objobjproc)NULL,                           /* sq_contains */
+    (binaryfunc)NULL,                           /* sq_inplace_concat */
+    (ssizeargfunc)NULL,                         /* sq_inplace_repeat */
+};
+
+NPY_NO_EXPORT PyTypeObject PyGrowableArray_Type = {
+#if defined(NPY_PY3K)
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,                                          /* ob_size */
+#endif
+    "numpy.core.multiarray._GrowableArray",     /* tp_name */
+    sizeof(PyGrowableArrayObject),              /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    /* methods */
+    (destructor)growable_dealloc,               /* tp_dealloc */
+    0,                                          /* tp_print */
+    0,                                          /* tp_getattr */
+    0,                                          /* tp_setattr */
+#if defined(NPY_PY3K)
+    0,                                          /* tp_reserved */
+#else
+    0,                                          /* tp_compare */
+#endif
+    0,                                          /* tp_repr */
+    0,                                          /* tp_as_number */
+    &growable_as_sequence,                      /* tp_as_sequence */
+    0,                                          /* tp_as_mapping */
+    0,                                          /* tp_hash */
+    0,                                          /* tp_call */
+    0,                                          /* tp_str */
+    0,                                          /* tp_getattro */
+    0,                                          /* tp_setattro */
+    0,                                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+    0,                                          /* tp_doc */
+    0,                                          /* tp_traverse */
+    0,                                          /* tp_clear */
+    0,                                          /* tp_richcompare */
+    0,                                          /* tp_weaklistoffset */
+    0,                                          /* tp_iter */
+    0,                                          /* tp_iternext */
+    growable_methods,                           /* tp_methods */
+    0,                                          /* tp_members */
+    growable_getsets,                           /* tp_getset */
+    0,                                          /* tp_base */
+    0,                                          /* tp_dict */
+    0,                                          /* tp_descr_get */
+    0,                                          /* tp_descr_set */
+    0,                                          /* tp_dictoffset */
+    0,                                          /* tp_init */
+    0,                                          /* tp_alloc */
+    growable_new,                               /* tp_new */
+    0,                                          /* tp_free */
+    0,                                          /* tp_is_gc */
+    0,                                          /* tp_bases */
+    0,                                          /* tp_mro */
+    0,                                          /* tp_cache */
+    0,                                          /* tp_subclasses */
+    0,                                          /* tp_weaklist */
+    0,                                          /* tp_del */
+    0,                                          /* tp_version_tag */
+};
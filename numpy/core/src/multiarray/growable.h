@@ -0,0 +1,6 @@
+#ifndef _NPY_PRIVATE__GROWABLE_H_
+#define _NPY_PRIVATE__GROWABLE_H_
+
+NPY_NO_EXPORT extern PyTypeObject PyGrowableArray_Type;
+
+#endif
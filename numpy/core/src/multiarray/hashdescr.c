@@ -252,6 +252,35 @@ static int _array_descr_walk(PyArray_Descr* descr, PyObject *l)
     return 0;
 }
 
+/*
+ * Hash a builtin type directly from the descriptor members, without
+ * materializing the Python list/tuple the generic walk builds.  The hash
+ * is cached on the descriptor, but dispatch code that looks dtypes up in
+ * dicts often does so through freshly created descriptors whose cache is
+ * cold, so the first computation matters too.
+ */
+static npy_hash_t _array_descr_builtin_hash(PyArray_Descr *descr)
+{
+    char nbyteorder = _normalize_byteorder(descr->byteorder);
+    npy_uint64 h;
+
+    /* Same members the generic walk hashes in _array_descr_builtin */
+    h = ((npy_uint64)(npy_ubyte)descr->kind << 56) |
+        ((npy_uint64)(npy_ubyte)nbyteorder << 48) |
+        ((npy_uint64)(npy_ubyte)descr->flags << 40) |
+        ((npy_uint64)(npy_uint32)descr->elsize << 8) |
+        (npy_uint64)(npy_ubyte)descr->alignment;
+
+    /* Finalizer from MurmurHash3, mixes all bits into the low word */
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return (npy_hash_t)h;
+}
+
 /*
  * Return 0 if successful
  */
@@ -260,6 +289,15 @@ static int _PyArray_DescrHashImp(PyArray_Descr *descr, npy_hash_t *hash)
     PyObject *l, *tl;
     int st;
 
+    if (_is_array_descr_builtin(descr)) {
+        *hash = _array_descr_builtin_hash(descr);
+        if (*hash == -1) {
+            /* -1 is both the cache sentinel and the Python error value */
+            *hash = -2;
+        }
+        return 0;
+    }
+
     l = PyList_New(0);
     if (l == NULL) {
         return -1;
@@ -0,0 +1,422 @@
+/*
+ * A reusable linear interpolation table.
+ *
+ * Pipelines that interpolate many batches of points against the same
+ * knot table pay for a fresh conversion and slope computation on every
+ * np.interp call.  An _InterpTable converts its knots once, caches the
+ * per-interval slopes, and detects equally spaced knots at construction
+ * time so the per-point binary search collapses to one multiply (the
+ * scaled guess is still verified against the actual knots, so uneven
+ * rounding of the spacing cannot pick the wrong interval).
+ *
+ * interp() matches np.interp for ascending knots: nans pass through,
+ * points outside the table get the left/right fill values, and points
+ * that hit a knot exactly return the tabulated value.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include "numpy/arrayobject.h"
+#include "numpy/npy_math.h"
+
+#include "npy_config.h"
+
+#include "npy_pycompat.h"
+
+#include "common.h"
+#include "interptable.h"
+
+typedef struct {
+    PyObject_HEAD
+    PyArrayObject *xp;      /* knots, contiguous double, ascending */
+    PyArrayObject *fp;      /* tabulated values, contiguous double */
+    npy_double *slopes;     /* len(xp) - 1 cached interval slopes */
+    npy_double inv_step;    /* reciprocal knot spacing, uniform only */
+    npy_bool uniform;
+} PyInterpTableObject;
+
+/*
+ * Interval lookup by bisection: returns -1 when key is left of the
+ * table, len when it is right of it, and otherwise the largest j with
+ * dx[j] <= key.
+ */
+static npy_intp
+interptable_find(npy_double key, const npy_double *dx, npy_intp len)
+{
+    npy_intp imin = 0, imax = len;
+
+    if (key > dx[len - 1]) {
+        return len;
+    }
+    if (key < dx[0]) {
+        return -1;
+    }
+    while (imin < imax) {
+        const npy_intp imid = imin + ((imax - imin) >> 1);
+        if (key >= dx[imid]) {
+            imin = imid + 1;
+        }
+        else {
+            imax = imid;
+        }
+    }
+    return imin - 1;
+}
+
+/*
+ * The equally-spaced variant scales the key into an interval guess with
+ * one multiply and then nudges the guess against the actual knots, so
+ * it returns exactly what interptable_find would even when the spacing
+ * does not divide out evenly in floating point.
+ */
+static npy_intp
+interptable_find_uniform(npy_double key, const npy_double *dx, npy_intp len,
+                         npy_double inv_step)
+{
+    npy_intp j;
+
+    if (key > dx[len - 1]) {
+        return len;
+    }
+    if (key < dx[0]) {
+        return -1;
+    }
+    j = (npy_intp)((key - dx[0]) * inv_step);
+    if (j < 0) {
+        j = 0;
+    }
+    else if (j > len - 1) {
+        j = len - 1;
+    }
+    while (j > 0 && key < dx[j]) {
+        j--;
+    }
+    while (j < len - 1 && key >= dx[j + 1]) {
+        j++;
+    }
+    return j;
+}
+
+static PyObject *
+interptable_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    PyInterpTableObject *self;
+    PyObject *xp_obj, *fp_obj;
+    PyArrayObject *xp = NULL, *fp = NULL;
+    npy_double *slopes = NULL;
+    const npy_double *dx, *dy;
+    npy_double step = 0.0;
+    npy_bool uniform = 0;
+    npy_intp lenxp, i;
+    static char *kwlist[] = {"xp", "fp", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO:_InterpTable", kwlist,
+                                     &xp_obj, &fp_obj)) {
+        return NULL;
+    }
+
+    xp = (PyArrayObject *)PyArray_ContiguousFromAny(xp_obj, NPY_DOUBLE, 1, 1);
+    if (xp == NULL) {
+        return NULL;
+    }
+    fp = (PyArrayObject *)PyArray_ContiguousFromAny(fp_obj, NPY_DOUBLE, 1, 1);
+    if (fp == NULL) {
+        Py_DECREF(xp);
+        return NULL;
+    }
+    lenxp = PyArray_SIZE(xp);
+    if (lenxp == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "array of sample points is empty");
+        goto fail;
+    }
+    if (PyArray_SIZE(fp) != lenxp) {
+        PyErr_SetString(PyExc_ValueError,
+                "fp and xp are not of the same length.");
+        goto fail;
+    }
+
+    dx = (const npy_double *)PyArray_DATA(xp);
+    dy = (const npy_double *)PyArray_DATA(fp);
+
+    if (lenxp > 1) {
+        slopes = PyArray_malloc((lenxp - 1) * sizeof(npy_double));
+        if (slopes == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+        for (i = 0; i < lenxp - 1; ++i) {
+            slopes[i] = (dy[i+1] - dy[i]) / (dx[i+1] - dx[i]);
+        }
+
+        /*
+         * The knots count as equally spaced when none strays more than
+         * a quarter step from its nominal position, which keeps the
+         * scaled guess within one interval of the true one. This is a
+         * performance hint only; the guess is always verified.
+         */
+        step = (dx[lenxp - 1] - dx[0]) / (lenxp - 1);
+        if (npy_isfinite(step) && step > 0.0) {
+            uniform = 1;
+            for (i = 1; i < lenxp - 1; ++i) {
+                if (npy_fabs(dx[i] - (dx[0] + i*step)) > 0.25*step) {
+                    uniform = 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    self = (PyInterpTableObject *)subtype->tp_alloc(subtype, 0);
+    if (self == NULL) {
+        PyArray_free(slopes);
+        goto fail;
+    }
+    self->xp = xp;
+    self->fp = fp;
+    self->slopes = slopes;
+    self->uniform = uniform;
+    self->inv_step = uniform ? 1.0 / step : 0.0;
+    return (PyObject *)self;
+
+fail:
+    Py_XDECREF(xp);
+    Py_XDECREF(fp);
+    return NULL;
+}
+
+static void
+interptable_dealloc(PyInterpTableObject *self)
+{
+    Py_XDECREF(self->xp);
+    Py_XDECREF(self->fp);
+    PyArray_free(self->slopes);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+interptable_interp(PyInterpTableObject *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *x, *left = NULL, *right = NULL;
+    PyArrayObject *ax = NULL, *af = NULL;
+    const npy_double *dx, *dy, *dz;
+    npy_double *dres;
+    npy_double lval, rval;
+    npy_intp lenxp, lenx, i;
+    static char *kwlist[] = {"x", "left", "right", NULL};
+
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:interp", kwlist,
+                                     &x, &left, &right)) {
+        return NULL;
+    }
+
+    ax = (PyArrayObject *)PyArray_ContiguousFromAny(x, NPY_DOUBLE, 0, 0);
+    if (ax == NULL) {
+        return NULL;
+    }
+    af = (PyArrayObject *)PyArray_SimpleNew(PyArray_NDIM(ax),
+                                            PyArray_DIMS(ax), NPY_DOUBLE);
+    if (af == NULL) {
+        goto fail;
+    }
+
+    lenxp = PyArray_SIZE(self->xp);
+    lenx = PyArray_SIZE(ax);
+    dx = (const npy_double *)PyArray_DATA(self->xp);
+    dy = (const npy_double *)PyArray_DATA(self->fp);
+    dz = (const npy_double *)PyArray_DATA(ax);
+    dres = (npy_double *)PyArray_DATA(af);
+
+    /* Get left and right fill values. */
+    if ((left == NULL) || (left == Py_None)) {
+        lval = dy[0];
+    }
+    else {
+        lval = PyFloat_AsDouble(left);
+        if (error_converting(lval)) {
+            goto fail;
+        }
+    }
+    if ((right == NULL) || (right == Py_None)) {
+        rval = dy[lenxp - 1];
+    }
+    else {
+        rval = PyFloat_AsDouble(right);
+        if (error_converting(rval)) {
+            goto fail;
+        }
+    }
+
+    if (lenxp == 1) {
+        const npy_double xp_val = dx[0];
+        const npy_double fp_val = dy[0];
+
+        NPY_BEGIN_THREADS_THRESHOLDED(lenx);
+        for (i = 0; i < lenx; ++i) {
+            const npy_double x_val = dz[i];
+            dres[i] = (x_val < xp_val) ? lval :
+                                         ((x_val > xp_val) ? rval : fp_val);
+        }
+        NPY_END_THREADS;
+    }
+    else {
+        const npy_double *slopes = self->slopes;
+        const npy_bool uniform = self->uniform;
+        const npy_double inv_step = self->inv_step;
+        npy_intp j;
+
+        NPY_BEGIN_THREADS_THRESHOLDED(lenx);
+        for (i = 0; i < lenx; ++i) {
+            const npy_double x_val = dz[i];
+
+            if (npy_isnan(x_val)) {
+                dres[i] = x_val;
+                continue;
+            }
+
+            j = uniform ? interptable_find_uniform(x_val, dx, lenxp,
+                                                   inv_step)
+                        : interptable_find(x_val, dx, lenxp);
+            if (j == -1) {
+                dres[i] = lval;
+            }
+            else if (j == lenxp) {
+                dres[i] = rval;
+            }
+            else if (j == lenxp - 1) {
+                dres[i] = dy[j];
+            }
+            else if (dx[j] == x_val) {
+                /* Avoid potential non-finite interpolation */
+                dres[i] = dy[j];
+            }
+            else {
+                const npy_double slope = slopes[j];
+
+                /* If we get nan in one direction, try the other */
+                dres[i] = slope*(x_val - dx[j]) + dy[j];
+                if (NPY_UNLIKELY(npy_isnan(dres[i]))) {
+                    dres[i] = slope*(x_val - dx[j+1]) + dy[j+1];
+                    if (NPY_UNLIKELY(npy_isnan(dres[i])) &&
+                            dy[j] == dy[j+1]) {
+                        dres[i] = dy[j];
+                    }
+                }
+            }
+        }
+        NPY_END_THREADS;
+    }
+
+    Py_DECREF(ax);
+    return PyArray_Return(af);
+
+fail:
+    Py_XDECREF(ax);
+    Py_XDECREF(af);
+    return NULL;
+}
+
+static PyObject *
+interptable_xp_get(PyInterpTableObject *self)
+{
+    Py_INCREF(self->xp);
+    return (PyObject *)self->xp;
+}
+
+static PyObject *
+interptable_fp_get(PyInterpTableObject *self)
+{
+    Py_INCREF(self->fp);
+    return (PyObject *)self->fp;
+}
+
+static PyObject *
+interptable_uniform_get(PyInterpTableObject *self)
+{
+    return PyBool_FromLong(self->uniform);
+}
+
+static PyMethodDef interptable_methods[] = {
+    {"interp",
+        (PyCFunction)interptable_interp,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {NULL, NULL, 0, NULL}           /* sentinel */
+};
+
+static PyGetSetDef interptable_getsets[] = {
+    {"xp",
+        (getter)interptable_xp_get,
+        NULL, NULL, NULL},
+    {"fp",
+        (getter)interptable_fp_get,
+        NULL, NULL, NULL},
+    {"uniform",
+        (getter)interptable_uniform_get,
+        NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* sentinel */
+};
+
+NPY_NO_EXPORT PyTypeObject PyInterpTable_Type = {
+#if defined(NPY_PY3K)
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,                                          /* ob_size */
+#endif
+    "numpy.core.multiarray._InterpTable",       /* tp_name */
+    sizeof(PyInterpTableObject),                /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    /* methods */
+    (destructor)interptable_dealloc,            /* tp_dealloc */
+    0,                                          /* tp_print */
+    0,                                          /* tp_getattr */
+    0,                                          /* tp_setattr */
+#if defined(NPY_PY3K)
+    0,                                          /* tp_reserved */
+#else
+    0,                                          /* tp_compare */
+#endif
+    0,                                          /* tp_repr */
+    0,                                          /* tp_as_number */
+    0,                                          /* tp_as_sequence */
+    0,                                          /* tp_as_mapping */
+    0,                                          /* tp_hash */
+    0,                                          /* tp_call */
+    0,                                          /* tp_str */
+    0,                                          /* tp_getattro */
+    0,                                          /* tp_setattro */
+    0,                                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+    0,                                          /* tp_doc */
+    0,                                          /* tp_traverse */
+    0,                                          /* tp_clear */
+    0,                                          /* tp_richcompare */
+    0,                                          /* tp_weaklistoffset */
+    0,                                          /* tp_iter */
+    0,                                          /* tp_iternext */
+    interptable_methods,                        /* tp_methods */
+    0,                                          /* tp_members */
+    interptable_getsets,                        /* tp_getset */
+    0,                                          /* tp_base */
+    0,                                          /* tp_dict */
+    0,                                          /* tp_descr_get */
+    0,                                          /* tp_descr_set */
+    0,                                          /* tp_dictoffset */
+    0,                                          /* tp_init */
+    0,                                          /* tp_alloc */
+    interptable_new,                            /* tp_new */
+    0,                                          /* tp_free */
+    0,                                          /* tp_is_gc */
+    0,                                          /* tp_bases */
+    0,                                          /* tp_mro */
+    0,                                          /* tp_cache */
+    0,                                          /* tp_subclasses */
+    0,                                          /* tp_weaklist */
+    0,                                          /* tp_del */
+    0,                                          /* tp_version_tag */
+};
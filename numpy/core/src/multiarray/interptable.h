@@ -0,0 +1,6 @@
+#ifndef _NPY_PRIVATE__INTERPTABLE_H_
+#define _NPY_PRIVATE__INTERPTABLE_H_
+
+NPY_NO_EXPORT extern PyTypeObject PyInterpTable_Type;
+
+#endif
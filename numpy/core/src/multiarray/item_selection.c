@@ -25,6 +25,7 @@
 #include "npy_sort.h"
 #include "npy_partition.h"
 #include "npy_binsearch.h"
+#include "sort_parallel.h"
 #include "alloc.h"
 
 /*NUMPY_API
@@ -40,7 +41,7 @@ PyArray_TakeFrom(PyArrayObject *self0, PyObject *indices0, int axis,
     npy_intp nd, i, j, n, m, k, max_item, tmp, chunk, itemsize, nelem;
     npy_intp shape[NPY_MAXDIMS];
     char *src, *dest, *tmp_src;
-    int err;
+    int err, ind_class;
     npy_bool needs_refcounting;
 
     indices = NULL;
@@ -139,6 +140,65 @@ PyArray_TakeFrom(PyArrayObject *self0, PyObject *indices0, int axis,
         NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(self));
         switch(clipmode) {
         case NPY_RAISE:
+            /*
+             * A single scan of the indices proves them all in bounds and
+             * lets the copy loop skip the per-element check; out-of-bounds
+             * indices fall through to the checked loop to raise.
+             */
+            ind_class = check_indices_minmax(
+                            (npy_intp *)PyArray_DATA(indices), m, max_item);
+            if (ind_class == 0 && !needs_refcounting &&
+                    check_indices_sorted(
+                            (npy_intp *)PyArray_DATA(indices), m)) {
+                /*
+                 * Sorted non-negative indices make the gather a forward
+                 * streaming merge: runs of consecutive indices collapse
+                 * into single block copies.
+                 */
+                for (i = 0; i < n; i++) {
+                    j = 0;
+                    while (j < m) {
+                        npy_intp run = 1;
+                        tmp = ((npy_intp *)(PyArray_DATA(indices)))[j];
+                        while (j + run < m &&
+                               ((npy_intp *)(PyArray_DATA(indices)))[j + run]
+                                       == tmp + run) {
+                            run++;
+                        }
+                        memmove(dest, src + tmp * chunk, run * chunk);
+                        dest += run * chunk;
+                        j += run;
+                    }
+                    src += chunk*max_item;
+                }
+                break;
+            }
+            if (ind_class >= 0) {
+                for (i = 0; i < n; i++) {
+                    for (j = 0; j < m; j++) {
+                        tmp = ((npy_intp *)(PyArray_DATA(indices)))[j];
+                        tmp += max_item & -(npy_intp)(tmp < 0);
+                        tmp_src = src + tmp * chunk;
+                        if (needs_refcounting) {
+                            for (k=0; k < nelem; k++) {
+                                PyArray_Item_INCREF(tmp_src,
+                                                    PyArray_DESCR(self));
+                                PyArray_Item_XDECREF(dest,
+                                                     PyArray_DESCR(self));
+                                memmove(dest, tmp_src, itemsize);
+                                dest += itemsize;
+                                tmp_src += itemsize;
+                            }
+                        }
+                        else {
+                            memmove(dest, tmp_src, chunk);
+                            dest += chunk;
+                        }
+                    }
+                    src += chunk*max_item;
+                }
+                break;
+            }
             for (i = 0; i < n; i++) {
                 for (j = 0; j < m; j++) {
                     tmp = ((npy_intp *)(PyArray_DATA(indices)))[j];
@@ -254,6 +314,48 @@ PyArray_TakeFrom(PyArrayObject *self0, PyObject *indices0, int axis,
     return NULL;
 }
 
+/*
+ * A random scatter is bound by one cache miss per element; the indices
+ * are known in advance, so the destination line of a later index is
+ * prefetched each iteration.  Prefetch never faults, so the unadjusted
+ * index values are safe to use.
+ */
+#if defined(NPY_HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#define NPY_PUT_PREFETCH_DIST 16
+#define NPY_PUT_PREFETCH(addr) _mm_prefetch((const char *)(addr), _MM_HINT_T0)
+#else
+#define NPY_PUT_PREFETCH_DIST 0
+#define NPY_PUT_PREFETCH(addr)
+#endif
+
+/*
+ * Single element copy for PyArray_PutTo.  A memmove call per element is
+ * dominated by call and dispatch overhead for small items, so the
+ * {1,2,4,8} byte itemsizes get direct stores when fast_chunk is set
+ * (the caller only sets it for suitably aligned arrays).
+ */
+static NPY_INLINE void
+_putto_store(char *dst, const char *src, npy_intp fast_chunk, npy_intp chunk)
+{
+    switch (fast_chunk) {
+        case 1:
+            *dst = *src;
+            return;
+        case 2:
+            *(npy_uint16 *)dst = *(const npy_uint16 *)src;
+            return;
+        case 4:
+            *(npy_uint32 *)dst = *(const npy_uint32 *)src;
+            return;
+        case 8:
+            *(npy_uint64 *)dst = *(const npy_uint64 *)src;
+            return;
+        default:
+            memmove(dst, src, chunk);
+    }
+}
+
 /*NUMPY_API
  * Put values into an array
  */
@@ -365,23 +467,36 @@ PyArray_PutTo(PyArrayObject *self, PyObject* values0, PyObject *indices0,
         }
     }
     else {
+        const npy_intp *ind = (const npy_intp *)PyArray_DATA(indices);
+        const npy_intp fast_chunk =
+                (IsUintAligned(self) && IsUintAligned(values) &&
+                 (chunk == 1 || chunk == 2 || chunk == 4 || chunk == 8))
+                ? chunk : 0;
         NPY_BEGIN_THREADS_DEF;
         NPY_BEGIN_THREADS_THRESHOLDED(ni);
         switch(clipmode) {
         case NPY_RAISE:
             for (i = 0; i < ni; i++) {
                 src = PyArray_BYTES(values) + chunk * (i % nv);
-                tmp = ((npy_intp *)(PyArray_DATA(indices)))[i];
+                tmp = ind[i];
+                if (i + NPY_PUT_PREFETCH_DIST < ni) {
+                    NPY_PUT_PREFETCH(
+                            dest + ind[i + NPY_PUT_PREFETCH_DIST] * chunk);
+                }
                 if (check_and_adjust_index(&tmp, max_item, 0, _save) < 0) {
                     goto fail;
                 }
-                memmove(dest + tmp * chunk, src, chunk);
+                _putto_store(dest + tmp * chunk, src, fast_chunk, chunk);
             }
             break;
         case NPY_WRAP:
             for (i = 0; i < ni; i++) {
                 src = PyArray_BYTES(values) + chunk * (i % nv);
-                tmp = ((npy_intp *)(PyArray_DATA(indices)))[i];
+                tmp = ind[i];
+                if (i + NPY_PUT_PREFETCH_DIST < ni) {
+                    NPY_PUT_PREFETCH(
+                            dest + ind[i + NPY_PUT_PREFETCH_DIST] * chunk);
+                }
                 if (tmp < 0) {
                     while (tmp < 0) {
                         tmp += max_item;
@@ -392,20 +507,24 @@ PyArray_PutTo(PyArrayObject *self, PyObject* values0, PyObject *indices0,
                         tmp -= max_item;
                     }
                 }
-                memmove(dest + tmp * chunk, src, chunk);
+                _putto_store(dest + tmp * chunk, src, fast_chunk, chunk);
             }
             break;
         case NPY_CLIP:
             for (i = 0; i < ni; i++) {
                 src = PyArray_BYTES(values) + chunk * (i % nv);
-                tmp = ((npy_intp *)(PyArray_DATA(indices)))[i];
+                tmp = ind[i];
+                if (i + NPY_PUT_PREFETCH_DIST < ni) {
+                    NPY_PUT_PREFETCH(
+                            dest + ind[i + NPY_PUT_PREFETCH_DIST] * chunk);
+                }
                 if (tmp < 0) {
                     tmp = 0;
                 }
                 else if (tmp >= max_item) {
                     tmp = max_item - 1;
                 }
-                memmove(dest + tmp * chunk, src, chunk);
+                _putto_store(dest + tmp * chunk, src, fast_chunk, chunk);
             }
             break;
         }
@@ -557,6 +676,331 @@ PyArray_PutMask(PyArrayObject *self, PyObject* values0, PyObject* mask0)
     return NULL;
 }
 
+/* constant itemsize so the compiler replaces the memcpy calls */
+#define ALONG_AXIS_GATHER(size) \
+    do { \
+        npy_intp k; \
+        for (k = 0; k < ind_len; k++) { \
+            npy_intp indval = \
+                    *(npy_intp *)(ind_row + k * ind_ax_stride); \
+            if (check_and_adjust_index(&indval, axis_len, axis, \
+                                       _save) < 0) { \
+                return -1; \
+            } \
+            memcpy(res_row + k * res_ax_stride, \
+                   arr_row + indval * arr_ax_stride, size); \
+        } \
+    } while (0)
+
+#define ALONG_AXIS_SCATTER(size) \
+    do { \
+        npy_intp k; \
+        for (k = 0; k < ind_len; k++) { \
+            npy_intp indval = \
+                    *(npy_intp *)(ind_row + k * ind_ax_stride); \
+            if (check_and_adjust_index(&indval, axis_len, axis, \
+                                       _save) < 0) { \
+                return -1; \
+            } \
+            memcpy(arr_row + indval * arr_ax_stride, \
+                   res_row + k * res_ax_stride, size); \
+        } \
+    } while (0)
+
+/*
+ * Shared loop of the along-axis gather and scatter. 'arr' provides the
+ * axis being indexed, 'ind' the intp indices and 'result' the gathered
+ * values (read for a scatter, written for a gather). The caller has
+ * validated that all three have the same number of dimensions, that
+ * off-axis dimensions of 'ind' match 'arr' or are 1 (broadcast with a
+ * zero stride), and that 'result' has the off-axis shape of 'arr' with
+ * the axis length of 'ind'.
+ *
+ * When the axis is the innermost dimension and all operands are
+ * contiguous along it, the inner loop runs with a constant itemsize so
+ * that the copies compile to plain loads and stores.
+ *
+ * Returns 0 on success, -1 on failure with an exception set.
+ */
+static int
+along_axis_loop(PyArrayObject *arr, PyArrayObject *ind,
+                PyArrayObject *result, int axis, int isget)
+{
+    int idim, j, it_ndim, ndim = PyArray_NDIM(arr);
+    npy_intp raw_shape[NPY_MAXDIMS], coord[NPY_MAXDIMS];
+    npy_intp raw_arr_strides[NPY_MAXDIMS], raw_ind_strides[NPY_MAXDIMS];
+    npy_intp raw_res_strides[NPY_MAXDIMS];
+    npy_intp it_shape[NPY_MAXDIMS];
+    npy_intp arr_strides[NPY_MAXDIMS], ind_strides[NPY_MAXDIMS];
+    npy_intp res_strides[NPY_MAXDIMS];
+    npy_intp axis_len = PyArray_DIM(arr, axis);
+    npy_intp ind_len = PyArray_DIM(ind, axis);
+    npy_intp arr_ax_stride = PyArray_STRIDE(arr, axis);
+    npy_intp ind_ax_stride = PyArray_STRIDE(ind, axis);
+    npy_intp res_ax_stride = PyArray_STRIDE(result, axis);
+    npy_intp elsize = PyArray_ITEMSIZE(arr);
+    char *arr_data = PyArray_BYTES(arr);
+    char *ind_data = PyArray_BYTES(ind);
+    char *res_data = PyArray_BYTES(result);
+    int last_axis_contig;
+    NPY_BEGIN_THREADS_DEF;
+
+    /* Collect the raw iteration data for the off-axis dimensions */
+    j = 0;
+    for (idim = 0; idim < ndim; idim++) {
+        if (idim == axis) {
+            continue;
+        }
+        raw_shape[j] = PyArray_DIM(arr, idim);
+        raw_arr_strides[j] = PyArray_STRIDE(arr, idim);
+        raw_ind_strides[j] = PyArray_DIM(ind, idim) == 1 ?
+                                0 : PyArray_STRIDE(ind, idim);
+        raw_res_strides[j] = PyArray_STRIDE(result, idim);
+        j++;
+    }
+    it_ndim = j;
+    if (it_ndim == 0) {
+        /* 1-d operands iterate once over a single dummy dimension */
+        it_ndim = 1;
+        it_shape[0] = 1;
+        arr_strides[0] = 0;
+        ind_strides[0] = 0;
+        res_strides[0] = 0;
+    }
+    else if (PyArray_PrepareThreeRawArrayIter(
+                    it_ndim, raw_shape,
+                    arr_data, raw_arr_strides,
+                    ind_data, raw_ind_strides,
+                    res_data, raw_res_strides,
+                    &it_ndim, it_shape,
+                    &arr_data, arr_strides,
+                    &ind_data, ind_strides,
+                    &res_data, res_strides) < 0) {
+        return -1;
+    }
+
+    last_axis_contig = axis == ndim - 1 &&
+                       arr_ax_stride == elsize &&
+                       res_ax_stride == elsize &&
+                       (ind_ax_stride == sizeof(npy_intp) ||
+                        (ind_len == 1 && ind_ax_stride == 0));
+
+    NPY_BEGIN_THREADS_THRESHOLDED(PyArray_SIZE(result));
+
+    NPY_RAW_ITER_START(idim, it_ndim, coord, it_shape) {
+        /* Process the innermost off-axis dimension */
+        npy_intp i0;
+
+        for (i0 = 0; i0 < it_shape[0]; i0++) {
+            char *arr_row = arr_data + i0 * arr_strides[0];
+            char *ind_row = ind_data + i0 * ind_strides[0];
+            char *res_row = res_data + i0 * res_strides[0];
+
+            switch (last_axis_contig ? elsize : 0) {
+                case 1:
+                    if (isget) {
+                        ALONG_AXIS_GATHER(1);
+                    }
+                    else {
+                        ALONG_AXIS_SCATTER(1);
+                    }
+                    break;
+                case 2:
+                    if (isget) {
+                        ALONG_AXIS_GATHER(2);
+                    }
+                    else {
+                        ALONG_AXIS_SCATTER(2);
+                    }
+                    break;
+                case 4:
+                    if (isget) {
+                        ALONG_AXIS_GATHER(4);
+                    }
+                    else {
+                        ALONG_AXIS_SCATTER(4);
+                    }
+                    break;
+                case 8:
+                    if (isget) {
+                        ALONG_AXIS_GATHER(8);
+                    }
+                    else {
+                        ALONG_AXIS_SCATTER(8);
+                    }
+                    break;
+                default:
+                    if (isget) {
+                        ALONG_AXIS_GATHER(elsize);
+                    }
+                    else {
+                        ALONG_AXIS_SCATTER(elsize);
+                    }
+                    break;
+            }
+        }
+    } NPY_RAW_ITER_THREE_NEXT(idim, it_ndim, coord, it_shape,
+                              arr_data, arr_strides,
+                              ind_data, ind_strides,
+                              res_data, res_strides);
+
+    NPY_END_THREADS;
+
+    return 0;
+}
+
+/*
+ * Validates the operands of an along-axis gather or scatter: the index
+ * array must have the same number of dimensions as 'arr' and each
+ * off-axis dimension must match 'arr' or be 1.
+ *
+ * Returns 0 on success, -1 on failure with an exception set.
+ */
+static int
+check_along_axis_operands(PyArrayObject *arr, PyArrayObject *ind, int axis)
+{
+    int idim, ndim = PyArray_NDIM(arr);
+
+    if (PyDataType_REFCHK(PyArray_DESCR(arr))) {
+        PyErr_SetString(PyExc_TypeError,
+                "along-axis kernel does not support object dtypes");
+        return -1;
+    }
+    if (PyArray_NDIM(ind) != ndim) {
+        PyErr_SetString(PyExc_ValueError,
+                "`indices` and `arr` must have the same number "
+                "of dimensions");
+        return -1;
+    }
+    if (PyArray_TYPE(ind) != NPY_INTP) {
+        PyErr_SetString(PyExc_TypeError,
+                "`indices` must be an intp array");
+        return -1;
+    }
+    for (idim = 0; idim < ndim; idim++) {
+        if (idim == axis) {
+            continue;
+        }
+        if (PyArray_DIM(ind, idim) != PyArray_DIM(arr, idim) &&
+                PyArray_DIM(ind, idim) != 1) {
+            PyErr_Format(PyExc_ValueError,
+                    "`indices` dimension %d does not match `arr` "
+                    "and cannot be broadcast to it", idim);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Native along-axis gather: the C implementation behind
+ * np.take_along_axis for the common case of matching (or broadcast
+ * size-1) off-axis dimensions. The result has the off-axis shape of
+ * 'arr' and the axis length of 'indices'.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_TakeAlongAxis(PyArrayObject *arr, PyArrayObject *indices, int axis)
+{
+    PyArray_Descr *dtype;
+    PyArrayObject *result;
+    npy_intp result_shape[NPY_MAXDIMS];
+    int idim, ndim = PyArray_NDIM(arr);
+
+    if (check_and_adjust_axis(&axis, ndim) < 0 ||
+            check_along_axis_operands(arr, indices, axis) < 0) {
+        return NULL;
+    }
+
+    for (idim = 0; idim < ndim; idim++) {
+        result_shape[idim] = idim == axis ?
+                PyArray_DIM(indices, idim) : PyArray_DIM(arr, idim);
+    }
+    dtype = PyArray_DESCR(arr);
+    Py_INCREF(dtype);
+    result = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type, dtype,
+                                                   ndim, result_shape,
+                                                   NULL, NULL, 0, NULL);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    if (along_axis_loop(arr, indices, result, axis, 1) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return (PyObject *)result;
+}
+
+/*
+ * Native along-axis scatter: the C implementation behind
+ * np.put_along_axis. 'values' must already have the result shape of
+ * the matching gather and the dtype of 'arr'.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+NPY_NO_EXPORT int
+PyArray_PutAlongAxis(PyArrayObject *arr, PyArrayObject *indices,
+                     PyArrayObject *values, int axis)
+{
+    int idim, ndim = PyArray_NDIM(arr);
+
+    if (check_and_adjust_axis(&axis, ndim) < 0 ||
+            check_along_axis_operands(arr, indices, axis) < 0) {
+        return -1;
+    }
+    if (PyArray_FailUnlessWriteable(arr, "put_along_axis argument") < 0) {
+        return -1;
+    }
+    if (PyArray_NDIM(values) != ndim ||
+            !PyArray_EquivTypes(PyArray_DESCR(values), PyArray_DESCR(arr)) ||
+            PyArray_ISNOTSWAPPED(values) != PyArray_ISNOTSWAPPED(arr)) {
+        PyErr_SetString(PyExc_ValueError,
+                "`values` must have the result shape and the dtype "
+                "of `arr`");
+        return -1;
+    }
+    for (idim = 0; idim < ndim; idim++) {
+        npy_intp expected = idim == axis ?
+                PyArray_DIM(indices, idim) : PyArray_DIM(arr, idim);
+        if (PyArray_DIM(values, idim) != expected) {
+            PyErr_SetString(PyExc_ValueError,
+                    "`values` must have the result shape and the dtype "
+                    "of `arr`");
+            return -1;
+        }
+    }
+
+    return along_axis_loop(arr, indices, values, axis, 0);
+}
+
+/*
+ * Fills 'count' copies of the 'chunk'-byte element group at 'src' into
+ * 'dst' by geometric doubling: one copy seeds the destination and each
+ * following memcpy doubles the filled region, so large repeat counts
+ * run at memcpy bandwidth instead of issuing one small copy per
+ * repetition. Returns the destination pointer one past the fill.
+ */
+static NPY_INLINE char *
+_repeat_fill(char *dst, const char *src, npy_intp chunk, npy_intp count)
+{
+    npy_intp filled, copy;
+
+    if (count <= 0) {
+        return dst;
+    }
+    memcpy(dst, src, chunk);
+    filled = 1;
+    while (filled < count) {
+        copy = filled;
+        if (copy > count - filled) {
+            copy = count - filled;
+        }
+        memcpy(dst + filled * chunk, dst, copy * chunk);
+        filled += copy;
+    }
+    return dst + count * chunk;
+}
+
 /*NUMPY_API
  * Repeat the array.
  */
@@ -564,7 +1008,7 @@ NPY_NO_EXPORT PyObject *
 PyArray_Repeat(PyArrayObject *aop, PyObject *op, int axis)
 {
     npy_intp *counts;
-    npy_intp n, n_outer, i, j, k, chunk;
+    npy_intp n, n_outer, i, j, chunk;
     npy_intp total = 0;
     npy_bool broadcast = NPY_FALSE;
     PyArrayObject *repeats = NULL;
@@ -643,10 +1087,7 @@ PyArray_Repeat(PyArrayObject *aop, PyObject *op, int axis)
     for (i = 0; i < n_outer; i++) {
         for (j = 0; j < n; j++) {
             npy_intp tmp = broadcast ? counts[0] : counts[j];
-            for (k = 0; k < tmp; k++) {
-                memcpy(new_data, old_data, chunk);
-                new_data += chunk;
-            }
+            new_data = _repeat_fill(new_data, old_data, chunk, tmp);
             old_data += chunk;
         }
     }
@@ -663,6 +1104,29 @@ PyArray_Repeat(PyArrayObject *aop, PyObject *op, int axis)
     return NULL;
 }
 
+/* Selector block size and the cap on choices for the blocked path */
+#define NPY_CHOOSE_BLOCK 512
+#define NPY_CHOOSE_MAX_CHOICES 32
+
+/*
+ * One predicated pass over a selector block for one choice array:
+ * elements whose selector matches c are blended into the already
+ * initialized destination with a sign-extended mask, which vectorizes
+ * to compare+blend and removes the per-element indirect branch.
+ */
+#define NPY_CHOOSE_BLEND_PASS(itype)                                    \
+    do {                                                                \
+        const char *csrc = src_data[c] + boff;                          \
+        char *cdst = ret_data + boff;                                   \
+        for (i = 0; i < blen; i++) {                                    \
+            itype dv, sv;                                               \
+            memcpy(&dv, cdst + i * sizeof(itype), sizeof(itype));       \
+            memcpy(&sv, csrc + i * sizeof(itype), sizeof(itype));       \
+            dv ^= (dv ^ sv) & (itype)-(itype)(selbuf[i] == c);          \
+            memcpy(cdst + i * sizeof(itype), &dv, sizeof(itype));       \
+        }                                                               \
+    } while (0)
+
 /*NUMPY_API
  */
 NPY_NO_EXPORT PyObject *
@@ -671,7 +1135,7 @@ PyArray_Choose(PyArrayObject *ip, PyObject *op, PyArrayObject *out,
 {
     PyArrayObject *obj = NULL;
     PyArray_Descr *dtype;
-    int n, elsize;
+    int n, elsize, use_blocked;
     npy_intp i;
     char *ret_data;
     PyArrayObject **mps, *ap;
@@ -752,6 +1216,125 @@ PyArray_Choose(PyArrayObject *ip, PyObject *op, PyArrayObject *out,
     elsize = PyArray_DESCR(obj)->elsize;
     ret_data = PyArray_DATA(obj);
 
+    /*
+     * When no broadcasting is needed and every operand is contiguous,
+     * the choice can be made blockwise: validate a block of selectors,
+     * histogram it, bulk-copy the dominant choice and blend the others
+     * in predicated passes, instead of dereferencing the multi-iterator
+     * and branching per element.
+     */
+    use_blocked = (n <= NPY_CHOOSE_MAX_CHOICES &&
+                   PyArray_ISCONTIGUOUS(ap) &&
+                   PyArray_SIZE(ap) == multi->size);
+    for (i = 0; use_blocked && i < n; i++) {
+        if (!PyArray_ISCONTIGUOUS(mps[i]) ||
+                PyArray_SIZE(mps[i]) != multi->size) {
+            use_blocked = 0;
+        }
+    }
+    if (use_blocked) {
+        const npy_intp *sel = (const npy_intp *)PyArray_DATA(ap);
+        char *src_data[NPY_CHOOSE_MAX_CHOICES];
+        npy_intp selbuf[NPY_CHOOSE_BLOCK];
+        npy_intp hist[NPY_CHOOSE_MAX_CHOICES];
+        npy_intp total = multi->size, pos, blen, boff, c, cbase;
+
+        for (i = 0; i < n; i++) {
+            src_data[i] = PyArray_DATA(mps[i]);
+        }
+        for (pos = 0; pos < total; pos += blen) {
+            blen = total - pos;
+            if (blen > NPY_CHOOSE_BLOCK) {
+                blen = NPY_CHOOSE_BLOCK;
+            }
+            switch (clipmode) {
+            case NPY_RAISE:
+                for (i = 0; i < blen; i++) {
+                    mi = sel[pos + i];
+                    if (mi < 0 || mi >= n) {
+                        PyErr_SetString(PyExc_ValueError,
+                                "invalid entry in choice "\
+                                "array");
+                        goto fail;
+                    }
+                    selbuf[i] = mi;
+                }
+                break;
+            case NPY_WRAP:
+                for (i = 0; i < blen; i++) {
+                    mi = sel[pos + i] % n;
+                    selbuf[i] = mi + (n & -(npy_intp)(mi < 0));
+                }
+                break;
+            case NPY_CLIP:
+                for (i = 0; i < blen; i++) {
+                    mi = sel[pos + i];
+                    mi = mi < 0 ? 0 : mi;
+                    selbuf[i] = mi >= n ? n - 1 : mi;
+                }
+                break;
+            }
+
+            memset(hist, 0, n * sizeof(npy_intp));
+            for (i = 0; i < blen; i++) {
+                hist[selbuf[i]]++;
+            }
+            cbase = 0;
+            for (c = 1; c < n; c++) {
+                if (hist[c] > hist[cbase]) {
+                    cbase = c;
+                }
+            }
+
+            /* Bulk-copy the dominant choice, then fix up the others */
+            boff = pos * elsize;
+            memmove(ret_data + boff, src_data[cbase] + boff, blen * elsize);
+            if (hist[cbase] == blen) {
+                continue;
+            }
+            switch (elsize) {
+            case 1:
+                for (c = 0; c < n; c++) {
+                    if (c != cbase && hist[c] != 0) {
+                        NPY_CHOOSE_BLEND_PASS(npy_uint8);
+                    }
+                }
+                break;
+            case 2:
+                for (c = 0; c < n; c++) {
+                    if (c != cbase && hist[c] != 0) {
+                        NPY_CHOOSE_BLEND_PASS(npy_uint16);
+                    }
+                }
+                break;
+            case 4:
+                for (c = 0; c < n; c++) {
+                    if (c != cbase && hist[c] != 0) {
+                        NPY_CHOOSE_BLEND_PASS(npy_uint32);
+                    }
+                }
+                break;
+            case 8:
+                for (c = 0; c < n; c++) {
+                    if (c != cbase && hist[c] != 0) {
+                        NPY_CHOOSE_BLEND_PASS(npy_uint64);
+                    }
+                }
+                break;
+            default:
+                for (i = 0; i < blen; i++) {
+                    if (selbuf[i] != cbase) {
+                        memmove(ret_data + boff + i*elsize,
+                                src_data[selbuf[i]] + boff + i*elsize,
+                                elsize);
+                    }
+                }
+                break;
+            }
+        }
+        goto finish;
+    }
+
     while (PyArray_MultiIter_NOTDONE(multi)) {
         mi = *((npy_intp *)PyArray_MultiIter_DATA(multi, n));
         if (mi < 0 || mi >= n) {
@@ -788,6 +1371,7 @@ PyArray_Choose(PyArrayObject *ip, PyObject *op, PyArrayObject *out,
         PyArray_MultiIter_NEXT(multi);
     }
 
+ finish:
     PyArray_INCREF(obj);
     Py_DECREF(multi);
     for (i = 0; i < n; i++) {
@@ -823,6 +1407,60 @@ PyArray_Choose(PyArrayObject *ip, PyObject *op, PyArrayObject *out,
  * it to the sorting routine.  An iterator is constructed and adjusted to walk
  * over all but the desired sorting axis.
  */
+
+/* cap for the run scan; beyond this many runs the full sort is used */
+#define NPY_SORT_MAX_RUNS 16
+
+/*
+ * Cheap pre-pass counting ascending runs in a contiguous lane, giving up
+ * as soon as the data is clearly not nearly sorted.  Purely descending
+ * lanes are scanned to the end and reported through *descending, but
+ * only when strictly descending, so that reversing them cannot reorder
+ * elements that compare equal.
+ */
+static npy_intp
+_count_sort_runs(const char *bufptr, npy_intp N, npy_intp elsize,
+                 PyArray_CompareFunc *cmp, PyArrayObject *op,
+                 npy_intp maxruns, int *descending)
+{
+    npy_intp i, nruns = 1;
+    npy_intp ndesc = 0;
+
+    *descending = 0;
+    for (i = 1; i < N; i++) {
+        if (cmp(bufptr + (i - 1)*elsize, bufptr + i*elsize, op) > 0) {
+            nruns++;
+            ndesc++;
+        }
+        if (nruns > maxruns && ndesc != i) {
+            break;
+        }
+    }
+    if (i == N && ndesc == N - 1) {
+        *descending = 1;
+    }
+    return nruns;
+}
+
+static void
+_reverse_lane(char *bufptr, npy_intp N, npy_intp elsize)
+{
+    char *lo = bufptr;
+    char *hi = bufptr + (N - 1)*elsize;
+
+    while (lo < hi) {
+        npy_intp k;
+
+        for (k = 0; k < elsize; k++) {
+            const char t = lo[k];
+            lo[k] = hi[k];
+            hi[k] = t;
+        }
+        lo += elsize;
+        hi -= elsize;
+    }
+}
+
 static int
 _new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
               PyArray_PartitionFunc *part, npy_intp *kth, npy_intp nkth)
@@ -835,6 +1473,8 @@ _new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
     int hasrefs = PyDataType_REFCHK(PyArray_DESCR(op));
 
     PyArray_CopySwapNFunc *copyswapn = PyArray_DESCR(op)->f->copyswapn;
+    PyArray_CompareFunc *cmp = PyArray_DESCR(op)->f->compare;
+    PyArray_SortFunc *stable = PyArray_DESCR(op)->f->sort[NPY_STABLESORT];
     char *buffer = NULL;
 
     PyArrayIterObject *it;
@@ -844,6 +1484,10 @@ _new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
 
     NPY_BEGIN_THREADS_DEF;
 
+    if (stable == NULL && cmp != NULL) {
+        stable = npy_timsort;
+    }
+
     /* Check if there is any sorting to do */
     if (N <= 1 || PyArray_SIZE(op) == 0) {
         return 0;
@@ -899,7 +1543,49 @@ _new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
          */
 
         if (part == NULL) {
-            ret = sort(bufptr, N, op);
+            PyArray_SortFunc *lane_sort = sort;
+            int presorted = 0;
+
+            /*
+             * Append-mostly data is typically one or a few ascending
+             * runs.  A capped run scan routes such lanes around the
+             * full sort: already ascending lanes are done, strictly
+             * descending ones just get reversed, and lanes with a
+             * handful of runs go to the stable sort, which merges them
+             * in linear time.  The scan gives up quickly on unordered
+             * data, so random lanes only pay a few extra compares.
+             */
+            if (!hasrefs && cmp != NULL && N >= 16) {
+                int descending;
+                const npy_intp nruns = _count_sort_runs(bufptr, N, elsize,
+                                                        cmp, op,
+                                                        NPY_SORT_MAX_RUNS,
+                                                        &descending);
+
+                if (nruns == 1) {
+                    presorted = 1;
+                }
+                else if (descending) {
+                    _reverse_lane(bufptr, N, elsize);
+                    presorted = 1;
+                }
+                else if (nruns <= NPY_SORT_MAX_RUNS && stable != NULL) {
+                    lane_sort = stable;
+                }
+            }
+            /*
+             * Large contiguous runs of dtypes that cannot call back into
+             * Python may be sorted on multiple threads; falls through to
+             * the serial sort when threading is disabled or not worthwhile.
+             */
+            if (presorted) {
+                ret = 0;
+            }
+            else if (hasrefs ||
+                    !npy_parallel_sort(bufptr, N, elsize, lane_sort,
+                                       cmp, op, &ret)) {
+                ret = lane_sort(bufptr, N, op);
+            }
             if (hasrefs && PyErr_Occurred()) {
                 ret = -1;
             }
@@ -911,15 +1597,30 @@ _new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
             npy_intp pivots[NPY_MAX_PIVOT_STACK];
             npy_intp npiv = 0;
             npy_intp i;
-            for (i = 0; i < nkth; ++i) {
-                ret = part(bufptr, N, kth[i], pivots, &npiv, op);
-                if (hasrefs && PyErr_Occurred()) {
-                    ret = -1;
-                }
-                if (ret < 0) {
-                    goto fail;
+
+            /*
+             * Large lanes of dtypes that cannot call back into Python
+             * may be selected on multiple threads; falls through to the
+             * serial introselect when threading is disabled or not
+             * worthwhile.  kth is sorted, which the parallel engine
+             * relies on to split the requests across its recursion.
+             */
+            if (hasrefs ||
+                    !npy_parallel_partition(bufptr, N, elsize, part, cmp,
+                                            kth, nkth, op, &ret)) {
+                for (i = 0; i < nkth; ++i) {
+                    ret = part(bufptr, N, kth[i], pivots, &npiv, op);
+                    if (hasrefs && PyErr_Occurred()) {
+                        ret = -1;
+                    }
+                    if (ret < 0) {
+                        goto fail;
+                    }
                 }
             }
+            if (ret < 0) {
+                goto fail;
+            }
         }
 
         if (needcopy) {
@@ -1048,75 +1749,354 @@ _new_argsortlike(PyArrayObject *op, int axis, PyArray_ArgSortFunc *argsort,
             valptr = valbuffer;
         }
 
-        if (needidxbuffer) {
-            idxptr = idxbuffer;
-        }
+        if (needidxbuffer) {
+            idxptr = idxbuffer;
+        }
+
+        iptr = idxptr;
+        for (i = 0; i < N; ++i) {
+            *iptr++ = i;
+        }
+
+        if (argpart == NULL) {
+            ret = argsort(valptr, idxptr, N, op);
+#if defined(NPY_PY3K)
+            /* Object comparisons may raise an exception in Python 3 */
+            if (hasrefs && PyErr_Occurred()) {
+                ret = -1;
+            }
+#endif
+            if (ret < 0) {
+                goto fail;
+            }
+        }
+        else {
+            npy_intp pivots[NPY_MAX_PIVOT_STACK];
+            npy_intp npiv = 0;
+
+            for (i = 0; i < nkth; ++i) {
+                ret = argpart(valptr, idxptr, N, kth[i], pivots, &npiv, op);
+#if defined(NPY_PY3K)
+                /* Object comparisons may raise an exception in Python 3 */
+                if (hasrefs && PyErr_Occurred()) {
+                    ret = -1;
+                }
+#endif
+                if (ret < 0) {
+                    goto fail;
+                }
+            }
+        }
+
+        if (needidxbuffer) {
+            char *rptr = rit->dataptr;
+            iptr = idxbuffer;
+
+            for (i = 0; i < N; ++i) {
+                *(npy_intp *)rptr = *iptr++;
+                rptr += rstride;
+            }
+        }
+
+        PyArray_ITER_NEXT(it);
+        PyArray_ITER_NEXT(rit);
+    }
+
+fail:
+    NPY_END_THREADS_DESCR(PyArray_DESCR(op));
+    npy_free_cache(valbuffer, N * elsize);
+    npy_free_cache(idxbuffer, N * sizeof(npy_intp));
+    if (ret < 0) {
+        if (!PyErr_Occurred()) {
+            /* Out of memory during sorting or buffer creation */
+            PyErr_NoMemory();
+        }
+        Py_XDECREF(rop);
+        rop = NULL;
+    }
+    Py_XDECREF(it);
+    Py_XDECREF(rit);
+
+    return (PyObject *)rop;
+}
+
+
+/*
+ * A record whose fields are all native-endian integers totalling at most
+ * eight bytes compares exactly like one unsigned 64-bit key built by
+ * concatenating the fields in name order, most significant first, with
+ * the sign bit of signed fields flipped.  Packing the keys once and
+ * sorting those avoids VOID_compare, which redoes the whole field walk
+ * with descriptor lookups for every single comparison.
+ */
+
+typedef struct {
+    npy_intp offset;
+    int elsize;
+    int is_signed;
+} record_key_field;
+
+/*
+ * Fills 'fields' (which must have room for 8 entries) and returns the
+ * number of fields, or -1 if the dtype cannot be treated as a packed key.
+ */
+static int
+get_record_key_fields(PyArray_Descr *descr, record_key_field *fields)
+{
+    PyObject *names, *key, *tup;
+    int i, n, totalbytes = 0;
+
+    if (!PyDataType_HASFIELDS(descr)) {
+        return -1;
+    }
+    names = descr->names;
+    n = (int)PyTuple_GET_SIZE(names);
+    if (n < 1 || n > (int)sizeof(npy_uint64)) {
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        PyArray_Descr *fdescr;
+        npy_intp offset;
+
+        key = PyTuple_GET_ITEM(names, i);
+        tup = PyDict_GetItem(descr->fields, key);
+        if (tup == NULL || _unpack_field(tup, &fdescr, &offset) < 0) {
+            PyErr_Clear();
+            return -1;
+        }
+        switch (fdescr->type_num) {
+            case NPY_BYTE:
+            case NPY_SHORT:
+            case NPY_INT:
+            case NPY_LONG:
+            case NPY_LONGLONG:
+                fields[i].is_signed = 1;
+                break;
+            case NPY_UBYTE:
+            case NPY_USHORT:
+            case NPY_UINT:
+            case NPY_ULONG:
+            case NPY_ULONGLONG:
+                fields[i].is_signed = 0;
+                break;
+            default:
+                /*
+                 * Booleans are excluded as well: BOOL_compare treats any
+                 * nonzero byte as true, which a raw byte key would not.
+                 */
+                return -1;
+        }
+        if (fdescr->elsize > 1 && !PyArray_ISNBO(fdescr->byteorder)) {
+            return -1;
+        }
+        totalbytes += fdescr->elsize;
+        if (totalbytes > (int)sizeof(npy_uint64)) {
+            return -1;
+        }
+        fields[i].offset = offset;
+        fields[i].elsize = fdescr->elsize;
+    }
+    return n;
+}
+
+static NPY_INLINE npy_uint64
+pack_record_key(const char *ip, const record_key_field *fields, int nfields)
+{
+    npy_uint64 key = 0;
+    int i;
+
+    for (i = 0; i < nfields; i++) {
+        npy_uint64 v;
+
+        /* memcpy into a same-size temporary; the data may be unaligned */
+        switch (fields[i].elsize) {
+            case 1: {
+                npy_uint8 t;
+                memcpy(&t, ip + fields[i].offset, 1);
+                v = t;
+                break;
+            }
+            case 2: {
+                npy_uint16 t;
+                memcpy(&t, ip + fields[i].offset, 2);
+                v = t;
+                break;
+            }
+            case 4: {
+                npy_uint32 t;
+                memcpy(&t, ip + fields[i].offset, 4);
+                v = t;
+                break;
+            }
+            default: {
+                npy_uint64 t;
+                memcpy(&t, ip + fields[i].offset, 8);
+                v = t;
+                break;
+            }
+        }
+        if (fields[i].is_signed) {
+            v ^= (npy_uint64)1 << (fields[i].elsize * 8 - 1);
+        }
+        if (i == 0) {
+            key = v;
+        }
+        else {
+            key = (key << (fields[i].elsize * 8)) | v;
+        }
+    }
+    return key;
+}
+
+/*
+ * In-place sort of a structured array through packed scalar keys.
+ * Returns 1 if the sort was done, 0 if the dtype is not packable (the
+ * caller should fall back to the generic path), -1 on error.
+ */
+static int
+_packed_record_sort(PyArrayObject *op, int axis, NPY_SORTKIND which)
+{
+    record_key_field fields[sizeof(npy_uint64)];
+    int nfields;
+    npy_intp N = PyArray_DIM(op, axis);
+    npy_intp elsize = (npy_intp)PyArray_ITEMSIZE(op);
+    npy_intp astride = PyArray_STRIDE(op, axis);
+    PyArray_ArgSortFunc *argsort;
+    npy_uint64 *keys = NULL;
+    npy_intp *tosort = NULL;
+    char *buffer = NULL;
+    PyArrayIterObject *it;
+    npy_intp size, i;
+    int ret = 1;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    nfields = get_record_key_fields(PyArray_DESCR(op), fields);
+    if (nfields < 0) {
+        return 0;
+    }
+
+    switch (which) {
+        case NPY_QUICKSORT:
+            argsort = aquicksort_ulonglong;
+            break;
+        case NPY_HEAPSORT:
+            argsort = aheapsort_ulonglong;
+            break;
+        case NPY_STABLESORT:
+            /*
+             * Records comparing equal have equal keys (and vice versa),
+             * so a stable argsort of the keys is a stable record sort.
+             */
+            argsort = amergesort_ulonglong;
+            break;
+        default:
+            return 0;
+    }
+
+    if (N <= 1 || PyArray_SIZE(op) == 0) {
+        return 1;
+    }
+
+    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)op, &axis);
+    if (it == NULL) {
+        return -1;
+    }
+    size = it->size;
+
+    keys = npy_alloc_cache(N * sizeof(npy_uint64));
+    tosort = npy_alloc_cache(N * sizeof(npy_intp));
+    buffer = npy_alloc_cache(N * elsize);
+    if (keys == NULL || tosort == NULL || buffer == NULL) {
+        ret = -1;
+        goto fail;
+    }
 
-        iptr = idxptr;
-        for (i = 0; i < N; ++i) {
-            *iptr++ = i;
-        }
+    NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(op));
 
-        if (argpart == NULL) {
-            ret = argsort(valptr, idxptr, N, op);
-#if defined(NPY_PY3K)
-            /* Object comparisons may raise an exception in Python 3 */
-            if (hasrefs && PyErr_Occurred()) {
-                ret = -1;
-            }
-#endif
-            if (ret < 0) {
-                goto fail;
-            }
-        }
-        else {
-            npy_intp pivots[NPY_MAX_PIVOT_STACK];
-            npy_intp npiv = 0;
+    while (size--) {
+        char *lane = it->dataptr;
+        char *rp = lane;
 
-            for (i = 0; i < nkth; ++i) {
-                ret = argpart(valptr, idxptr, N, kth[i], pivots, &npiv, op);
-#if defined(NPY_PY3K)
-                /* Object comparisons may raise an exception in Python 3 */
-                if (hasrefs && PyErr_Occurred()) {
-                    ret = -1;
-                }
-#endif
-                if (ret < 0) {
-                    goto fail;
-                }
-            }
+        for (i = 0; i < N; i++, rp += astride) {
+            keys[i] = pack_record_key(rp, fields, nfields);
+            tosort[i] = i;
+        }
+        if (argsort(keys, tosort, N, NULL) < 0) {
+            ret = -1;
+            break;
         }
 
-        if (needidxbuffer) {
-            char *rptr = rit->dataptr;
-            iptr = idxbuffer;
-
-            for (i = 0; i < N; ++i) {
-                *(npy_intp *)rptr = *iptr++;
-                rptr += rstride;
-            }
+        /* Apply the permutation through a scratch copy of the lane */
+        _unaligned_strided_byte_copy(buffer, elsize, lane, astride,
+                                     N, elsize);
+        rp = lane;
+        for (i = 0; i < N; i++, rp += astride) {
+            memcpy(rp, buffer + tosort[i] * elsize, elsize);
         }
 
         PyArray_ITER_NEXT(it);
-        PyArray_ITER_NEXT(rit);
     }
 
-fail:
     NPY_END_THREADS_DESCR(PyArray_DESCR(op));
-    npy_free_cache(valbuffer, N * elsize);
-    npy_free_cache(idxbuffer, N * sizeof(npy_intp));
-    if (ret < 0) {
-        if (!PyErr_Occurred()) {
-            /* Out of memory during sorting or buffer creation */
-            PyErr_NoMemory();
-        }
-        Py_XDECREF(rop);
-        rop = NULL;
+
+fail:
+    npy_free_cache(keys, N * sizeof(npy_uint64));
+    npy_free_cache(tosort, N * sizeof(npy_intp));
+    npy_free_cache(buffer, N * elsize);
+    if (ret < 0 && !PyErr_Occurred()) {
+        /* Out of memory during sorting or buffer creation */
+        PyErr_NoMemory();
     }
-    Py_XDECREF(it);
-    Py_XDECREF(rit);
+    Py_DECREF(it);
 
-    return (PyObject *)rop;
+    return ret;
+}
+
+/*
+ * Argsort of a structured array through packed scalar keys.  Sets
+ * '*handled' to 0 and returns NULL if the dtype is not packable.
+ */
+static PyObject *
+_packed_record_argsort(PyArrayObject *op, int axis, NPY_SORTKIND which,
+                       int *handled)
+{
+    record_key_field fields[sizeof(npy_uint64)];
+    int nfields;
+    PyArrayObject *keys;
+    PyArrayIterObject *it;
+    npy_uint64 *kp;
+    PyObject *ret;
+
+    *handled = 0;
+    nfields = get_record_key_fields(PyArray_DESCR(op), fields);
+    if (nfields < 0) {
+        return NULL;
+    }
+    *handled = 1;
+
+    keys = (PyArrayObject *)PyArray_SimpleNew(PyArray_NDIM(op),
+                                              PyArray_DIMS(op), NPY_UINT64);
+    if (keys == NULL) {
+        return NULL;
+    }
+
+    /* The flat iterator visits elements in C order, matching 'keys' */
+    it = (PyArrayIterObject *)PyArray_IterNew((PyObject *)op);
+    if (it == NULL) {
+        Py_DECREF(keys);
+        return NULL;
+    }
+    kp = (npy_uint64 *)PyArray_DATA(keys);
+    while (it->index < it->size) {
+        *kp++ = pack_record_key(it->dataptr, fields, nfields);
+        PyArray_ITER_NEXT(it);
+    }
+    Py_DECREF(it);
+
+    ret = PyArray_ArgSort(keys, axis, which);
+    Py_DECREF(keys);
+    return ret;
 }
 
 
@@ -1142,6 +2122,13 @@ PyArray_Sort(PyArrayObject *op, int axis, NPY_SORTKIND which)
         return -1;
     }
 
+    if (PyArray_TYPE(op) == NPY_VOID) {
+        int packed = _packed_record_sort(op, axis, which);
+        if (packed != 0) {
+            return packed < 0 ? -1 : 0;
+        }
+    }
+
     sort = PyArray_DESCR(op)->f->sort[which];
 
     if (sort == NULL) {
@@ -1278,6 +2265,168 @@ PyArray_Partition(PyArrayObject *op, PyArrayObject * ktharray, int axis,
 }
 
 
+/*
+ * Return a new array with the k largest (or smallest) elements along the
+ * axis, in ascending order.  An introselect partition places the k
+ * extremes, then only those k elements are sorted, so the work stays
+ * O(n + k log k) instead of the full sort the equivalent
+ * partition-then-slice-then-sort does from python.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_TopK(PyArrayObject *op, npy_intp k, int axis, int largest)
+{
+    npy_intp N;
+    npy_intp elsize = (npy_intp)PyArray_ITEMSIZE(op);
+    npy_intp astride;
+    int swap = PyArray_ISBYTESWAPPED(op);
+    int hasrefs = PyDataType_REFCHK(PyArray_DESCR(op));
+
+    PyArray_CopySwapNFunc *copyswapn = PyArray_DESCR(op)->f->copyswapn;
+    PyArray_PartitionFunc *part;
+    PyArray_SortFunc *sort;
+    char *buffer = NULL;
+
+    PyArray_Descr *descr = PyArray_DESCR(op);
+    PyArrayObject *rop = NULL;
+    npy_intp rstride;
+    npy_intp shape[NPY_MAXDIMS];
+
+    PyArrayIterObject *it = NULL, *rit = NULL;
+    npy_intp size, kth, koffset;
+    int i;
+
+    int ret = 0;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    if (check_and_adjust_axis(&axis, PyArray_NDIM(op)) < 0) {
+        return NULL;
+    }
+    N = PyArray_DIM(op, axis);
+    astride = PyArray_STRIDE(op, axis);
+    if (k < 1 || k > N) {
+        PyErr_Format(PyExc_ValueError,
+                     "k(=%zd) out of bounds (%zd)", k, N);
+        return NULL;
+    }
+
+    part = get_partition_func(PyArray_TYPE(op), NPY_INTROSELECT);
+    sort = descr->f->sort[NPY_QUICKSORT];
+    if (sort == NULL) {
+        if (descr->f->compare == NULL) {
+            PyErr_SetString(PyExc_TypeError,
+                            "type does not have compare function");
+            return NULL;
+        }
+        sort = npy_quicksort;
+    }
+
+    for (i = 0; i < PyArray_NDIM(op); i++) {
+        shape[i] = PyArray_DIM(op, i);
+    }
+    shape[axis] = k;
+
+    Py_INCREF(descr);
+    rop = (PyArrayObject *)PyArray_NewFromDescr(
+            Py_TYPE(op), descr, PyArray_NDIM(op), shape, NULL, NULL,
+            0, (PyObject *)op);
+    if (rop == NULL) {
+        return NULL;
+    }
+    rstride = PyArray_STRIDE(rop, axis);
+
+    if (PyArray_SIZE(rop) == 0) {
+        return (PyObject *)rop;
+    }
+
+    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)op, &axis);
+    rit = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)rop, &axis);
+    if (it == NULL || rit == NULL) {
+        ret = -1;
+        goto fail;
+    }
+    size = it->size;
+
+    /* the selection runs on a copy, the input is left untouched */
+    buffer = npy_alloc_cache(N * elsize);
+    if (buffer == NULL) {
+        ret = -1;
+        goto fail;
+    }
+
+    kth = largest ? N - k : k - 1;
+    koffset = largest ? N - k : 0;
+
+    NPY_BEGIN_THREADS_DESCR(descr);
+
+    while (size--) {
+        if (hasrefs) {
+            /*
+             * For dtype's with objects, copyswapn Py_XINCREF's src
+             * and Py_XDECREF's dst, which would leak a reference to
+             * each object here.  So, copy with no refcounting; the
+             * buffer only ever holds borrowed references.
+             */
+            _unaligned_strided_byte_copy(buffer, elsize,
+                                         it->dataptr, astride, N, elsize);
+            if (swap) {
+                copyswapn(buffer, elsize, NULL, 0, N, swap, op);
+            }
+        }
+        else {
+            copyswapn(buffer, elsize, it->dataptr, astride, N, swap, op);
+        }
+
+        if (part != NULL) {
+            npy_intp pivots[NPY_MAX_PIVOT_STACK];
+            npy_intp npiv = 0;
+
+            ret = part(buffer, N, kth, pivots, &npiv, op);
+            if (ret == 0) {
+                /* order the selected extremes */
+                ret = sort(buffer + koffset * elsize, k, op);
+            }
+        }
+        else {
+            /* Use sorting, slower but equivalent */
+            ret = sort(buffer, N, op);
+        }
+        if (hasrefs && PyErr_Occurred()) {
+            ret = -1;
+        }
+        if (ret < 0) {
+            goto fail;
+        }
+
+        /*
+         * The output is freshly allocated (and zeroed for dtypes with
+         * objects), so copyswapn refcounts correctly here.
+         */
+        copyswapn(rit->dataptr, rstride, buffer + koffset * elsize, elsize,
+                  k, swap, op);
+
+        PyArray_ITER_NEXT(it);
+        PyArray_ITER_NEXT(rit);
+    }
+
+fail:
+    NPY_END_THREADS_DESCR(descr);
+    npy_free_cache(buffer, N * elsize);
+    if (ret < 0) {
+        if (!PyErr_Occurred()) {
+            /* Out of memory during sorting or buffer creation */
+            PyErr_NoMemory();
+        }
+        Py_XDECREF(rop);
+        rop = NULL;
+    }
+    Py_XDECREF(it);
+    Py_XDECREF(rit);
+
+    return (PyObject *)rop;
+}
+
+
 /*NUMPY_API
  * ArgSort an array
  */
@@ -1312,6 +2461,14 @@ PyArray_ArgSort(PyArrayObject *op, int axis, NPY_SORTKIND which)
         }
     }
 
+    if (PyArray_TYPE(op) == NPY_VOID) {
+        int handled;
+        PyObject *packed = _packed_record_argsort(op, axis, which, &handled);
+        if (handled) {
+            return packed;
+        }
+    }
+
     op2 = (PyArrayObject *)PyArray_CheckAxis(op, &axis, 0);
     if (op2 == NULL) {
         return NULL;
@@ -1377,6 +2534,45 @@ PyArray_ArgPartition(PyArrayObject *op, PyArrayObject *ktharray, int axis,
 }
 
 
+/*
+ * Merge one integer key into the packed composite keys, mapped so that
+ * unsigned comparison of the composite matches the key's own order.
+ * Signed values get their sign bit flipped; the caller assigns the shifts
+ * so that later (higher priority) keys land in more significant bits.
+ */
+static void
+_lexsort_pack_key(npy_ulonglong *ckeys, const char *data, npy_intp N,
+                  int elsize, int issigned, int shift)
+{
+    const npy_ulonglong flip =
+            issigned ? ((npy_ulonglong)1 << (elsize * 8 - 1)) : 0;
+    npy_intp i;
+
+    switch (elsize) {
+        case 1:
+            for (i = 0; i < N; i++) {
+                ckeys[i] |= (((const npy_ubyte *)data)[i] ^ flip) << shift;
+            }
+            break;
+        case 2:
+            for (i = 0; i < N; i++) {
+                ckeys[i] |= (((const npy_ushort *)data)[i] ^ flip) << shift;
+            }
+            break;
+        case 4:
+            for (i = 0; i < N; i++) {
+                ckeys[i] |= (((const npy_uint *)data)[i] ^ flip) << shift;
+            }
+            break;
+        case 8:
+            for (i = 0; i < N; i++) {
+                ckeys[i] |= ((const npy_ulonglong *)data)[i] ^ flip;
+            }
+            break;
+    }
+}
+
+
 /*NUMPY_API
  *LexSort an array providing indices that will sort a collection of arrays
  *lexicographically.  The first key is sorted on first, followed by the second key
@@ -1396,6 +2592,8 @@ PyArray_LexSort(PyObject *sort_keys, int axis)
     npy_intp astride, rstride, *iptr;
     int nd;
     int needcopy = 0;
+    int fuse;
+    int totalsize = 0;
     int elsize;
     int maxelsize;
     int object = 0;
@@ -1512,6 +2710,24 @@ PyArray_LexSort(PyObject *sort_keys, int axis)
         }
     }
 
+    /*
+     * Integer keys narrow enough to pack into a single 64 bit word can be
+     * fused into one composite key and argsorted in a single stable radix
+     * pass, instead of one argsort and index permutation per key.
+     */
+    fuse = !needcopy && n > 1;
+    for (j = 0; j < n && fuse; j++) {
+        int tn = PyArray_TYPE(mps[j]);
+
+        if (tn != NPY_BOOL && !PyTypeNum_ISINTEGER(tn)) {
+            fuse = 0;
+        }
+        totalsize += PyArray_DESCR(mps[j])->elsize;
+    }
+    if (totalsize > (int)sizeof(npy_ulonglong)) {
+        fuse = 0;
+    }
+
     if (needcopy) {
         char *valbuffer, *indbuffer;
         int *swaps;
@@ -1570,11 +2786,42 @@ PyArray_LexSort(PyObject *sort_keys, int axis)
         free(swaps);
     }
     else {
+        npy_ulonglong *ckeys = NULL;
+
+        if (fuse) {
+            ckeys = (npy_ulonglong *)PyDataMem_NEW(N * sizeof(npy_ulonglong));
+            if (ckeys == NULL) {
+                /* fall back to the per-key argsorts */
+                fuse = 0;
+            }
+        }
         while (size--) {
             iptr = (npy_intp *)rit->dataptr;
             for (i = 0; i < N; i++) {
                 *iptr++ = i;
             }
+            if (fuse) {
+                int rcode;
+                int shift = 0;
+
+                memset(ckeys, 0, N * sizeof(npy_ulonglong));
+                for (j = 0; j < n; j++) {
+                    elsize = PyArray_DESCR(mps[j])->elsize;
+                    _lexsort_pack_key(ckeys, its[j]->dataptr, N, elsize,
+                                      PyTypeNum_ISSIGNED(PyArray_TYPE(mps[j])),
+                                      shift);
+                    shift += elsize * 8;
+                    PyArray_ITER_NEXT(its[j]);
+                }
+                rcode = aradixsort_ulonglong(ckeys, (npy_intp *)rit->dataptr,
+                                             N, NULL);
+                if (rcode < 0) {
+                    PyDataMem_FREE(ckeys);
+                    goto fail;
+                }
+                PyArray_ITER_NEXT(rit);
+                continue;
+            }
             for (j = 0; j < n; j++) {
                 int rcode;
                 argsort = PyArray_DESCR(mps[j])->f->argsort[NPY_STABLESORT];
@@ -1595,6 +2842,7 @@ PyArray_LexSort(PyObject *sort_keys, int axis)
             }
             PyArray_ITER_NEXT(rit);
         }
+        PyDataMem_FREE(ckeys);
     }
 
     if (!object) {
@@ -2263,6 +3511,45 @@ PyArray_Nonzero(PyArrayObject *self)
                     *multi_index++ = j++;
                 }
             }
+            else if (stride == 1) {
+                /*
+                 * Word-at-a-time index emission for dense contiguous
+                 * bools: all-false words are skipped, all-true words
+                 * emit eight consecutive indices branch-free, and only
+                 * mixed words fall back to per-byte tests.
+                 */
+                npy_intp j = 0, k;
+                while (count - j >= 8) {
+                    npy_uint64 w;
+                    memcpy(&w, data + j, 8);
+                    if (w == 0) {
+                        j += 8;
+                    }
+                    else if (((((w & 0x7f7f7f7f7f7f7f7fULL) +
+                                0x7f7f7f7f7f7f7f7fULL) | w) &
+                              0x8080808080808080ULL) ==
+                             0x8080808080808080ULL) {
+                        for (k = 0; k < 8; k++) {
+                            multi_index[k] = j + k;
+                        }
+                        multi_index += 8;
+                        j += 8;
+                    }
+                    else {
+                        for (k = 0; k < 8; k++) {
+                            if (data[j + k] != 0) {
+                                *multi_index++ = j + k;
+                            }
+                        }
+                        j += 8;
+                    }
+                }
+                for (; j < count; j++) {
+                    if (data[j] != 0) {
+                        *multi_index++ = j;
+                    }
+                }
+            }
             else {
                 npy_intp j;
                 for (j = 0; j < count; ++j) {
@@ -27,4 +27,29 @@ NPY_NO_EXPORT int
 PyArray_MultiIndexSetItem(PyArrayObject *self, npy_intp *multi_index,
                                                 PyObject *obj);
 
+/*
+ * Returns a new array holding the k largest (largest != 0) or smallest
+ * elements along the axis, in ascending order.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_TopK(PyArrayObject *op, npy_intp k, int axis, int largest);
+
+/*
+ * Native along-axis gather behind np.take_along_axis. 'indices' must
+ * be an intp array with the same number of dimensions as 'arr', each
+ * off-axis dimension matching 'arr' or being 1.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_TakeAlongAxis(PyArrayObject *arr, PyArrayObject *indices, int axis);
+
+/*
+ * Native along-axis scatter behind np.put_along_axis. 'values' must
+ * have the result shape of the matching gather and the dtype of 'arr'.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+NPY_NO_EXPORT int
+PyArray_PutAlongAxis(PyArrayObject *arr, PyArrayObject *indices,
+                     PyArrayObject *values, int axis);
+
 #endif
@@ -15,6 +15,7 @@
 #include "iterators.h"
 #include "ctors.h"
 #include "common.h"
+#include "npy_fastdiv.h"
 
 #define NEWAXIS_INDEX -1
 #define ELLIPSIS_INDEX -2
@@ -462,6 +463,54 @@ iter_subscript_Bool(PyArrayIterObject *self, PyArrayObject *ind)
     return ret;
 }
 
+/*
+ * Precomputed reciprocals of an iterator's shape factors, so that loops
+ * doing many PyArray_ITER_GOTO1D jumps (flat fancy indexing, strided
+ * flat slices over non-contiguous data) unravel the flat index with
+ * multiplies and shifts instead of a hardware divide per dimension.
+ */
+static void
+iter_fastdiv_init(PyArrayIterObject *it, npy_fastdiv *factors)
+{
+    int i;
+
+    if (it->nd_m1 > 0 && !it->contiguous) {
+        for (i = 0; i <= it->nd_m1; i++) {
+            npy_fastdiv_init(&factors[i], (npy_uintp)it->factors[i]);
+        }
+    }
+}
+
+/* PyArray_ITER_GOTO1D with the divisions replaced by 'factors' */
+static NPY_INLINE void
+iter_goto1d_fastdiv(PyArrayIterObject *it, npy_intp ind,
+                    const npy_fastdiv *factors)
+{
+    int i;
+    npy_uintp n, q;
+
+    if (ind < 0) {
+        ind += it->size;
+    }
+    it->index = ind;
+    if (it->nd_m1 == 0) {
+        it->dataptr = PyArray_BYTES(it->ao) + ind * it->strides[0];
+    }
+    else if (it->contiguous) {
+        it->dataptr = PyArray_BYTES(it->ao) +
+                            ind * PyArray_DESCR(it->ao)->elsize;
+    }
+    else {
+        it->dataptr = PyArray_BYTES(it->ao);
+        n = (npy_uintp)ind;
+        for (i = 0; i <= it->nd_m1; i++) {
+            q = npy_fastdiv_divide(n, &factors[i]);
+            it->dataptr += (npy_intp)q * it->strides[i];
+            n -= q * (npy_uintp)it->factors[i];
+        }
+    }
+}
+
 static PyObject *
 iter_subscript_int(PyArrayIterObject *self, PyArrayObject *ind)
 {
@@ -473,6 +522,7 @@ iter_subscript_int(PyArrayIterObject *self, PyArrayObject *ind)
     char *optr;
     npy_intp counter;
     PyArray_CopySwapFunc *copyswap;
+    npy_fastdiv factors[NPY_MAXDIMS];
 
     itemsize = PyArray_DESCR(self->ao)->elsize;
     if (PyArray_NDIM(ind) == 0) {
@@ -509,6 +559,7 @@ iter_subscript_int(PyArrayIterObject *self, PyArrayObject *ind)
     counter = ind_it->size;
     copyswap = PyArray_DESCR(ret)->f->copyswap;
     swap = (PyArray_ISNOTSWAPPED(ret) != PyArray_ISNOTSWAPPED(self->ao));
+    iter_fastdiv_init(self, factors);
     while (counter--) {
         num = *((npy_intp *)(ind_it->dataptr));
         if (check_and_adjust_index(&num, self->size, -1, NULL) < 0) {
@@ -517,7 +568,7 @@ iter_subscript_int(PyArrayIterObject *self, PyArrayObject *ind)
             PyArray_ITER_RESET(self);
             return NULL;
         }
-        PyArray_ITER_GOTO1D(self, num);
+        iter_goto1d_fastdiv(self, num, factors);
         copyswap(optr, self->dataptr, swap, ret);
         optr += itemsize;
         PyArray_ITER_NEXT(ind_it);
@@ -541,6 +592,7 @@ iter_subscript(PyArrayIterObject *self, PyObject *ind)
     PyObject *obj = NULL;
     PyObject *new;
     PyArray_CopySwapFunc *copyswap;
+    npy_fastdiv factors[NPY_MAXDIMS];
 
     if (ind == Py_Ellipsis) {
         ind = PySlice_New(NULL, NULL, NULL);
@@ -617,10 +669,11 @@ iter_subscript(PyArrayIterObject *self, PyObject *ind)
         }
         dptr = PyArray_DATA(ret);
         copyswap = PyArray_DESCR(ret)->f->copyswap;
+        iter_fastdiv_init(self, factors);
         while (n_steps--) {
             copyswap(dptr, self->dataptr, 0, ret);
             start += step_size;
-            PyArray_ITER_GOTO1D(self, start);
+            iter_goto1d_fastdiv(self, start, factors);
             dptr += size;
         }
         PyArray_ITER_RESET(self);
@@ -732,6 +785,7 @@ iter_ass_sub_int(PyArrayIterObject *self, PyArrayObject *ind,
     PyArrayIterObject *ind_it;
     npy_intp counter;
     PyArray_CopySwapFunc *copyswap;
+    npy_fastdiv factors[NPY_MAXDIMS];
 
     copyswap = PyArray_DESCR(self->ao)->f->copyswap;
     if (PyArray_NDIM(ind) == 0) {
@@ -748,13 +802,14 @@ iter_ass_sub_int(PyArrayIterObject *self, PyArrayObject *ind,
         return -1;
     }
     counter = ind_it->size;
+    iter_fastdiv_init(self, factors);
     while (counter--) {
         num = *((npy_intp *)(ind_it->dataptr));
         if (check_and_adjust_index(&num, self->size, -1, NULL) < 0) {
             Py_DECREF(ind_it);
             return -1;
         }
-        PyArray_ITER_GOTO1D(self, num);
+        iter_goto1d_fastdiv(self, num, factors);
         copyswap(self->dataptr, val->dataptr, swap, self->ao);
         PyArray_ITER_NEXT(ind_it);
         PyArray_ITER_NEXT(val);
@@ -778,6 +833,7 @@ iter_ass_subscript(PyArrayIterObject *self, PyObject *ind, PyObject *val)
     npy_intp n_steps;
     PyObject *obj = NULL;
     PyArray_CopySwapFunc *copyswap;
+    npy_fastdiv factors[NPY_MAXDIMS];
 
 
     if (val == NULL) {
@@ -879,10 +935,11 @@ iter_ass_subscript(PyArrayIterObject *self, PyObject *ind, PyObject *val)
             retval = 0;
             goto finish;
         }
+        iter_fastdiv_init(self, factors);
         while (n_steps--) {
             copyswap(self->dataptr, val_it->dataptr, swap, arrval);
             start += step_size;
-            PyArray_ITER_GOTO1D(self, start);
+            iter_goto1d_fastdiv(self, start, factors);
             PyArray_ITER_NEXT(val_it);
             if (val_it->index == val_it->size) {
                 PyArray_ITER_RESET(val_it);
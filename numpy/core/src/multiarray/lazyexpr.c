@@ -0,0 +1,561 @@
+/*
+ * A deferred-evaluation expression graph for chained arithmetic.
+ *
+ * Every binary op in number.c allocates a full result, so a chain like
+ * (a - b) / (a + b) makes three passes over memory and two temporaries,
+ * and temp_elide.c only removes the temporaries in narrow cases.  A
+ * _LazyExpr instead records the operation as a lightweight node; the
+ * arithmetic only runs when the expression is materialized (through
+ * evaluate() or __array__), and then all the fused operations are
+ * applied block by block with cache-resident scratch buffers, so the
+ * operands stream through memory exactly once no matter how long the
+ * chain is.
+ *
+ * The mode is strictly opt-in: nothing changes unless an operand is
+ * wrapped in _LazyExpr first.  Operands are converted to contiguous
+ * doubles and must share one shape (Python numbers broadcast as
+ * constants); evaluation is plain IEEE double arithmetic and does not
+ * feed the errstate machinery, matching what the fused loop computes.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include "numpy/arrayobject.h"
+#include "numpy/npy_math.h"
+
+#include "npy_config.h"
+
+#include "npy_pycompat.h"
+
+#include "common.h"
+#include "lazyexpr.h"
+
+enum {
+    LAZY_LEAF,
+    LAZY_CONST,
+    LAZY_ADD,
+    LAZY_SUB,
+    LAZY_MUL,
+    LAZY_DIV,
+    LAZY_NEG
+};
+
+/* bounds the compiled program and with it the scratch footprint */
+#define NPY_LAZY_MAX_INSTRS 256
+/* doubles per scratch buffer; 32KiB of operand per stack slot block */
+#define NPY_LAZY_BLOCK 4096
+
+typedef struct {
+    PyObject_HEAD
+    int op;
+    /* children for the arithmetic nodes, NULL otherwise */
+    PyObject *left;
+    PyObject *right;
+    /* LAZY_LEAF only: contiguous double operand */
+    PyArrayObject *arr;
+    /* LAZY_CONST only */
+    npy_double value;
+} PyLazyExprObject;
+
+typedef struct {
+    int op;
+    /* LAZY_LEAF: index into the collected leaf arrays */
+    npy_intp leaf;
+    /* LAZY_CONST: the constant */
+    npy_double value;
+} lazy_instr;
+
+typedef struct {
+    lazy_instr instrs[NPY_LAZY_MAX_INSTRS];
+    PyArrayObject *leaves[NPY_LAZY_MAX_INSTRS];
+    int ninstrs;
+    int nleaves;
+    int nvisited;
+    int maxdepth;
+    int depth;
+} lazy_program;
+
+static PyObject *
+lazyexpr_alloc_node(int op, PyObject *left, PyObject *right,
+                    PyArrayObject *arr, npy_double value)
+{
+    PyLazyExprObject *node;
+
+    node = PyObject_New(PyLazyExprObject, &PyLazyExpr_Type);
+    if (node == NULL) {
+        Py_XDECREF(left);
+        Py_XDECREF(right);
+        Py_XDECREF(arr);
+        return NULL;
+    }
+    node->op = op;
+    node->left = left;
+    node->right = right;
+    node->arr = arr;
+    node->value = value;
+    return (PyObject *)node;
+}
+
+/* Wrap an array-like operand as a leaf node */
+static PyObject *
+lazyexpr_leaf(PyObject *obj)
+{
+    PyArrayObject *arr;
+
+    arr = (PyArrayObject *)PyArray_FROM_OTF(obj, NPY_DOUBLE,
+                            NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS);
+    if (arr == NULL) {
+        return NULL;
+    }
+    return lazyexpr_alloc_node(LAZY_LEAF, NULL, NULL, arr, 0.0);
+}
+
+/*
+ * Coerce a binary-op operand to an expression node: existing nodes
+ * pass through, Python numbers become constants, everything else goes
+ * through array conversion.  Returns a new reference, or NULL with no
+ * error set for operands that should yield NotImplemented.
+ */
+static PyObject *
+lazyexpr_coerce(PyObject *obj)
+{
+    if (PyObject_TypeCheck(obj, &PyLazyExpr_Type)) {
+        Py_INCREF(obj);
+        return obj;
+    }
+    if (PyFloat_Check(obj) || PyLong_Check(obj)
+#if !defined(NPY_PY3K)
+            || PyInt_Check(obj)
+#endif
+            ) {
+        npy_double value = PyFloat_AsDouble(obj);
+
+        if (error_converting(value)) {
+            PyErr_Clear();
+            return NULL;
+        }
+        return lazyexpr_alloc_node(LAZY_CONST, NULL, NULL, NULL, value);
+    }
+    if (PyArray_Check(obj)) {
+        PyObject *node = lazyexpr_leaf(obj);
+
+        if (node == NULL) {
+            PyErr_Clear();
+        }
+        return node;
+    }
+    return NULL;
+}
+
+static PyObject *
+lazyexpr_binop(PyObject *left, PyObject *right, int op)
+{
+    PyObject *lnode, *rnode;
+
+    lnode = lazyexpr_coerce(left);
+    if (lnode == NULL) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    rnode = lazyexpr_coerce(right);
+    if (rnode == NULL) {
+        Py_DECREF(lnode);
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    return lazyexpr_alloc_node(op, lnode, rnode, NULL, 0.0);
+}
+
+static PyObject *
+lazyexpr_add(PyObject *left, PyObject *right)
+{
+    return lazyexpr_binop(left, right, LAZY_ADD);
+}
+
+static PyObject *
+lazyexpr_subtract(PyObject *left, PyObject *right)
+{
+    return lazyexpr_binop(left, right, LAZY_SUB);
+}
+
+static PyObject *
+lazyexpr_multiply(PyObject *left, PyObject *right)
+{
+    return lazyexpr_binop(left, right, LAZY_MUL);
+}
+
+static PyObject *
+lazyexpr_divide(PyObject *left, PyObject *right)
+{
+    return lazyexpr_binop(left, right, LAZY_DIV);
+}
+
+static PyObject *
+lazyexpr_negative(PyObject *self)
+{
+    Py_INCREF(self);
+    return lazyexpr_alloc_node(LAZY_NEG, self, NULL, NULL, 0.0);
+}
+
+/*
+ * Flatten the graph into a postorder program.  The stack depth of the
+ * program is tracked so evaluation can size its scratch buffers, and
+ * shared subexpressions are simply visited again: correctness over
+ * cleverness, the instruction limit keeps the cost bounded.
+ */
+static int
+lazyexpr_compile(PyLazyExprObject *node, lazy_program *prog)
+{
+    lazy_instr *instr;
+
+    /* checked before recursing, so compilation depth is bounded too */
+    if (prog->nvisited++ >= NPY_LAZY_MAX_INSTRS) {
+        PyErr_Format(PyExc_ValueError,
+                "lazy expression exceeds %d operations",
+                NPY_LAZY_MAX_INSTRS);
+        return -1;
+    }
+    if (node->op != LAZY_LEAF && node->op != LAZY_CONST) {
+        if (lazyexpr_compile((PyLazyExprObject *)node->left, prog) < 0) {
+            return -1;
+        }
+        if (node->right != NULL &&
+                lazyexpr_compile((PyLazyExprObject *)node->right, prog) < 0) {
+            return -1;
+        }
+    }
+    instr = &prog->instrs[prog->ninstrs++];
+    instr->op = node->op;
+    instr->leaf = 0;
+    instr->value = node->value;
+    switch (node->op) {
+        case LAZY_LEAF:
+            instr->leaf = prog->nleaves;
+            prog->leaves[prog->nleaves++] = node->arr;
+            prog->depth++;
+            break;
+        case LAZY_CONST:
+            prog->depth++;
+            break;
+        case LAZY_NEG:
+            break;
+        default:
+            prog->depth--;
+            break;
+    }
+    if (prog->depth > prog->maxdepth) {
+        prog->maxdepth = prog->depth;
+    }
+    return 0;
+}
+
+/* Run the program over one block; no Python API, called without the GIL */
+static void
+lazyexpr_run_block(const lazy_program *prog, const npy_double **leafdata,
+                   npy_double *scratch, npy_double *out,
+                   npy_intp start, npy_intp blocklen)
+{
+    const npy_double *ptrs[NPY_LAZY_MAX_INSTRS];
+    int sp = 0;
+    int k;
+    npy_intp i;
+
+    for (k = 0; k < prog->ninstrs; k++) {
+        const lazy_instr *instr = &prog->instrs[k];
+        npy_double *buf;
+
+        switch (instr->op) {
+            case LAZY_LEAF:
+                ptrs[sp++] = leafdata[instr->leaf] + start;
+                break;
+            case LAZY_CONST:
+                buf = scratch + (npy_intp)sp * NPY_LAZY_BLOCK;
+                for (i = 0; i < blocklen; i++) {
+                    buf[i] = instr->value;
+                }
+                ptrs[sp++] = buf;
+                break;
+            case LAZY_NEG:
+                buf = scratch + (npy_intp)(sp - 1) * NPY_LAZY_BLOCK;
+                for (i = 0; i < blocklen; i++) {
+                    buf[i] = -ptrs[sp - 1][i];
+                }
+                ptrs[sp - 1] = buf;
+                break;
+            default:
+                buf = scratch + (npy_intp)(sp - 2) * NPY_LAZY_BLOCK;
+                switch (instr->op) {
+                    case LAZY_ADD:
+                        for (i = 0; i < blocklen; i++) {
+                            buf[i] = ptrs[sp - 2][i] + ptrs[sp - 1][i];
+                        }
+                        break;
+                    case LAZY_SUB:
+                        for (i = 0; i < blocklen; i++) {
+                            buf[i] = ptrs[sp - 2][i] - ptrs[sp - 1][i];
+                        }
+                        break;
+                    case LAZY_MUL:
+                        for (i = 0; i < blocklen; i++) {
+                            buf[i] = ptrs[sp - 2][i] * ptrs[sp - 1][i];
+                        }
+                        break;
+                    case LAZY_DIV:
+                        for (i = 0; i < blocklen; i++) {
+                            buf[i] = ptrs[sp - 2][i] / ptrs[sp - 1][i];
+                        }
+                        break;
+                }
+                ptrs[sp - 2] = buf;
+                sp--;
+                break;
+        }
+    }
+    memcpy(out + start, ptrs[0], blocklen * sizeof(npy_double));
+}
+
+static PyObject *
+lazyexpr_evaluate_impl(PyLazyExprObject *self)
+{
+    lazy_program prog;
+    const npy_double *leafdata[NPY_LAZY_MAX_INSTRS];
+    PyArrayObject *ref, *out = NULL;
+    npy_double *scratch, *outdata;
+    npy_intp size, start;
+    int k;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    memset(&prog, 0, sizeof(prog));
+    if (lazyexpr_compile(self, &prog) < 0) {
+        return NULL;
+    }
+    if (prog.nleaves == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "lazy expression has no array operand");
+        return NULL;
+    }
+
+    /* every array operand must share one shape; constants broadcast */
+    ref = prog.leaves[0];
+    for (k = 1; k < prog.nleaves; k++) {
+        PyArrayObject *leaf = prog.leaves[k];
+
+        if (PyArray_NDIM(leaf) != PyArray_NDIM(ref) ||
+                !PyArray_CompareLists(PyArray_DIMS(leaf), PyArray_DIMS(ref),
+                                      PyArray_NDIM(ref))) {
+            PyErr_SetString(PyExc_ValueError,
+                    "operands of a lazy expression must have "
+                    "the same shape");
+            return NULL;
+        }
+        leafdata[k] = (const npy_double *)PyArray_DATA(leaf);
+    }
+    leafdata[0] = (const npy_double *)PyArray_DATA(ref);
+
+    out = (PyArrayObject *)PyArray_SimpleNew(PyArray_NDIM(ref),
+                                             PyArray_DIMS(ref), NPY_DOUBLE);
+    if (out == NULL) {
+        return NULL;
+    }
+    scratch = PyArray_malloc((npy_intp)prog.maxdepth * NPY_LAZY_BLOCK
+                             * sizeof(npy_double));
+    if (scratch == NULL) {
+        Py_DECREF(out);
+        return PyErr_NoMemory();
+    }
+
+    size = PyArray_SIZE(ref);
+    outdata = (npy_double *)PyArray_DATA(out);
+
+    NPY_BEGIN_THREADS_THRESHOLDED(size);
+    for (start = 0; start < size; start += NPY_LAZY_BLOCK) {
+        npy_intp blocklen = size - start;
+
+        if (blocklen > NPY_LAZY_BLOCK) {
+            blocklen = NPY_LAZY_BLOCK;
+        }
+        lazyexpr_run_block(&prog, leafdata, scratch, outdata,
+                           start, blocklen);
+    }
+    NPY_END_THREADS;
+
+    PyArray_free(scratch);
+    return (PyObject *)out;
+}
+
+static PyObject *
+lazyexpr_evaluate(PyLazyExprObject *self, PyObject *NPY_UNUSED(args))
+{
+    return lazyexpr_evaluate_impl(self);
+}
+
+/* Materialization hook for np.asarray and mixed expressions */
+static PyObject *
+lazyexpr_array(PyLazyExprObject *self, PyObject *args)
+{
+    PyArray_Descr *dtype = NULL;
+    PyObject *res;
+
+    if (!PyArg_ParseTuple(args, "|O&:__array__",
+                          PyArray_DescrConverter2, &dtype)) {
+        return NULL;
+    }
+    res = lazyexpr_evaluate_impl(self);
+    if (res == NULL || dtype == NULL) {
+        Py_XDECREF(dtype);
+        return res;
+    }
+    /* PyArray_CastToType steals the dtype reference */
+    Py_SETREF(res, PyArray_CastToType((PyArrayObject *)res, dtype, 0));
+    return res;
+}
+
+static PyObject *
+lazyexpr_new(PyTypeObject *NPY_UNUSED(subtype), PyObject *args,
+             PyObject *kwds)
+{
+    PyObject *obj;
+    static char *kwlist[] = {"a", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:_LazyExpr", kwlist,
+                                     &obj)) {
+        return NULL;
+    }
+    if (PyObject_TypeCheck(obj, &PyLazyExpr_Type)) {
+        Py_INCREF(obj);
+        return obj;
+    }
+    return lazyexpr_leaf(obj);
+}
+
+static void
+lazyexpr_dealloc(PyLazyExprObject *self)
+{
+    Py_XDECREF(self->left);
+    Py_XDECREF(self->right);
+    Py_XDECREF(self->arr);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyMethodDef lazyexpr_methods[] = {
+    {"evaluate",
+        (PyCFunction)lazyexpr_evaluate,
+        METH_NOARGS, NULL},
+    {"__array__",
+        (PyCFunction)lazyexpr_array,
+        METH_VARARGS, NULL},
+    {NULL, NULL, 0, NULL}           /* sentinel */
+};
+
+static PyNumberMethods lazyexpr_as_number = {
+    (binaryfunc)lazyexpr_add,                   /* nb_add */
+    (binaryfunc)lazyexpr_subtract,              /* nb_subtract */
+    (binaryfunc)lazyexpr_multiply,              /* nb_multiply */
+#if !defined(NPY_PY3K)
+    (binaryfunc)lazyexpr_divide,                /* nb_divide */
+#endif
+    0,                                          /* nb_remainder */
+    0,                                          /* nb_divmod */
+    0,                                          /* nb_power */
+    (unaryfunc)lazyexpr_negative,               /* nb_negative */
+    0,                                          /* nb_positive */
+    0,                                          /* nb_absolute */
+    0,                                          /* nb_bool */
+    0,                                          /* nb_invert */
+    0,                                          /* nb_lshift */
+    0,                                          /* nb_rshift */
+    0,                                          /* nb_and */
+    0,                                          /* nb_xor */
+    0,                                          /* nb_or */
+#if !defined(NPY_PY3K)
+    0,                                          /* nb_coerce */
+#endif
+    0,                                          /* nb_int */
+    0,                                          /* nb_reserved */
+    0,                                          /* nb_float */
+#if !defined(NPY_PY3K)
+    0,                                          /* nb_oct */
+    0,                                          /* nb_hex */
+#endif
+    0,                                          /* nb_inplace_add */
+    0,                                          /* nb_inplace_subtract */
+    0,                                          /* nb_inplace_multiply */
+#if !defined(NPY_PY3K)
+    0,                                          /* nb_inplace_divide */
+#endif
+    0,                                          /* nb_inplace_remainder */
+    0,                                          /* nb_inplace_power */
+    0,                                          /* nb_inplace_lshift */
+    0,                                          /* nb_inplace_rshift */
+    0,                                          /* nb_inplace_and */
+    0,                                          /* nb_inplace_xor */
+    0,                                          /* nb_inplace_or */
+    0,                                          /* nb_floor_divide */
+    (binaryfunc)lazyexpr_divide,                /* nb_true_divide */
+    0,                                          /* nb_inplace_floor_divide */
+    0,                                          /* nb_inplace_true_divide */
+    0,                                          /* nb_index */
+};
+
+NPY_NO_EXPORT PyTypeObject PyLazyExpr_Type = {
+#if defined(NPY_PY3K)
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,                                          /* ob_size */
+#endif
+    "numpy.core.multiarray._LazyExpr",          /* tp_name */
+    sizeof(PyLazyExprObject),                   /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    /* methods */
+    (destructor)lazyexpr_dealloc,               /* tp_dealloc */
+    0,                                          /* tp_print */
+    0,                                          /* tp_getattr */
+    0,                                          /* tp_setattr */
+#if defined(NPY_PY3K)
+    0,                                          /* tp_reserved */
+#else
+    0,                                          /* tp_compare */
+#endif
+    0,                                          /* tp_repr */
+    &lazyexpr_as_number,                        /* tp_as_number */
+    0,                                          /* tp_as_sequence */
+    0,                                          /* tp_as_mapping */
+    0,                                          /* tp_hash */
+    0,                                          /* tp_call */
+    0,                                          /* tp_str */
+    0,                                          /* tp_getattro */
+    0,                                          /* tp_setattro */
+    0,                                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+    0,                                          /* tp_doc */
+    0,                                          /* tp_traverse */
+    0,                                          /* tp_clear */
+    0,                                          /* tp_richcompare */
+    0,                                          /* tp_weaklistoffset */
+    0,                                          /* tp_iter */
+    0,                                          /* tp_iternext */
+    lazyexpr_methods,                           /* tp_methods */
+    0,                                          /* tp_members */
+    0,                                          /* tp_getset */
+    0,                                          /* tp_base */
+    0,                                          /* tp_dict */
+    0,                                          /* tp_descr_get */
+    0,                                          /* tp_descr_set */
+    0,                                          /* tp_dictoffset */
+    0,                                          /* tp_init */
+    0,                                          /* tp_alloc */
+    lazyexpr_new,                               /* tp_new */
+    0,                                          /* tp_free */
+    0,                                          /* tp_is_gc */
+    0,                                          /* tp_bases */
+    0,                                          /* tp_mro */
+    0,                                          /* tp_cache */
+    0,                                          /* tp_subclasses */
+    0,                                          /* tp_weaklist */
+    0,                                          /* tp_del */
+    0,                                          /* tp_version_tag */
+};
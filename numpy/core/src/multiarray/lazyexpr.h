@@ -0,0 +1,6 @@
+#ifndef _NPY_PRIVATE__LAZYEXPR_H_
+#define _NPY_PRIVATE__LAZYEXPR_H_
+
+NPY_NO_EXPORT extern PyTypeObject PyLazyExpr_Type;
+
+#endif
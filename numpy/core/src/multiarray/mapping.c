@@ -981,14 +981,25 @@ get_view_from_index(PyArrayObject *self, PyArrayObject **view,
     }
 
     /* Create the new view and set the base array */
-    Py_INCREF(PyArray_DESCR(self));
-    *view = (PyArrayObject *)PyArray_NewFromDescrAndBase(
-            ensure_array ? &PyArray_Type : Py_TYPE(self),
-            PyArray_DESCR(self),
-            new_dim, new_shape, new_strides, data_ptr,
-            PyArray_FLAGS(self),
-            ensure_array ? NULL : (PyObject *)self,
-            (PyObject *)self);
+    if (ensure_array || PyArray_CheckExact(self)) {
+        /*
+         * The shape, strides and data pointer are all derived from
+         * self above, so the re-validation done by the general
+         * constructor can be skipped for base-class views.
+         */
+        *view = (PyArrayObject *)PyArray_NewViewFromBase(
+                self, new_dim, new_shape, new_strides, data_ptr);
+    }
+    else {
+        Py_INCREF(PyArray_DESCR(self));
+        *view = (PyArrayObject *)PyArray_NewFromDescrAndBase(
+                Py_TYPE(self),
+                PyArray_DESCR(self),
+                new_dim, new_shape, new_strides, data_ptr,
+                PyArray_FLAGS(self),
+                (PyObject *)self,
+                (PyObject *)self);
+    }
     if (*view == NULL) {
         return -1;
     }
@@ -997,6 +1008,60 @@ get_view_from_index(PyArrayObject *self, PyArrayObject **view,
 }
 
 
+/*
+ * Compacts the unmasked elements of a contiguous inner loop into 'dst'.
+ * The mask is scanned a 64-bit word at a time, mirroring the trick in
+ * count_nonzero_bytes_384: all-false words are skipped and all-true
+ * words are copied wholesale, so the per-element branch only runs for
+ * mixed words. Returns the new end of 'dst'.
+ */
+#define BOOLEAN_COMPRESS_INNER(itype) \
+static NPY_INLINE char * \
+boolean_compress_inner_##itype(char *dst, const char *src, \
+                               const char *mask, npy_intp n) \
+{ \
+    while (n >= 8) { \
+        npy_uint64 m; \
+        memcpy(&m, mask, 8); \
+        if (m != 0) { \
+            /* normalize each nonzero byte to 0x80 */ \
+            npy_uint64 v = (((m & 0x7f7f7f7f7f7f7f7fULL) + \
+                             0x7f7f7f7f7f7f7f7fULL) | m) & \
+                           0x8080808080808080ULL; \
+            if (v == 0x8080808080808080ULL) { \
+                memcpy(dst, src, 8 * sizeof(itype)); \
+                dst += 8 * sizeof(itype); \
+            } \
+            else { \
+                int i; \
+                for (i = 0; i < 8; i++) { \
+                    if (mask[i]) { \
+                        memcpy(dst, src + i * sizeof(itype), sizeof(itype)); \
+                        dst += sizeof(itype); \
+                    } \
+                } \
+            } \
+        } \
+        mask += 8; \
+        src += 8 * sizeof(itype); \
+        n -= 8; \
+    } \
+    for (; n > 0; n--, mask++, src += sizeof(itype)) { \
+        if (*mask) { \
+            memcpy(dst, src, sizeof(itype)); \
+            dst += sizeof(itype); \
+        } \
+    } \
+    return dst; \
+}
+
+BOOLEAN_COMPRESS_INNER(npy_uint8)
+BOOLEAN_COMPRESS_INNER(npy_uint16)
+BOOLEAN_COMPRESS_INNER(npy_uint32)
+BOOLEAN_COMPRESS_INNER(npy_uint64)
+
+#undef BOOLEAN_COMPRESS_INNER
+
 /*
  * Implements boolean indexing. This produces a one-dimensional
  * array which picks out all of the elements of 'self' for which
@@ -1092,6 +1157,48 @@ array_boolean_subscript(PyArrayObject *self,
 
         self_stride = innerstrides[0];
         bmask_stride = innerstrides[1];
+
+        /*
+         * Contiguous data with a fixed-width trivially copyable dtype
+         * can be compacted a mask word at a time instead of going
+         * through the transfer function for every unmasked run.
+         */
+        if (self_stride == itemsize && bmask_stride == 1 &&
+                !needs_api && !PyDataType_REFCHK(dtype) &&
+                (itemsize == 1 || itemsize == 2 ||
+                 itemsize == 4 || itemsize == 8)) {
+            do {
+                innersize = *NpyIter_GetInnerLoopSizePtr(iter);
+                self_data = dataptrs[0];
+                bmask_data = dataptrs[1];
+
+                switch (itemsize) {
+                    case 1:
+                        ret_data = boolean_compress_inner_npy_uint8(
+                                ret_data, self_data, bmask_data, innersize);
+                        break;
+                    case 2:
+                        ret_data = boolean_compress_inner_npy_uint16(
+                                ret_data, self_data, bmask_data, innersize);
+                        break;
+                    case 4:
+                        ret_data = boolean_compress_inner_npy_uint32(
+                                ret_data, self_data, bmask_data, innersize);
+                        break;
+                    default:
+                        ret_data = boolean_compress_inner_npy_uint64(
+                                ret_data, self_data, bmask_data, innersize);
+                        break;
+                }
+            } while (iternext(iter));
+
+            NPY_END_THREADS;
+
+            NpyIter_Deallocate(iter);
+            NPY_AUXDATA_FREE(transferdata);
+            goto finish;
+        }
+
         do {
             innersize = *NpyIter_GetInnerLoopSizePtr(iter);
             self_data = dataptrs[0];
@@ -1120,6 +1227,7 @@ array_boolean_subscript(PyArrayObject *self,
         NPY_AUXDATA_FREE(transferdata);
     }
 
+finish:
     if (!PyArray_CheckExact(self)) {
         PyArrayObject *tmp = ret;
 
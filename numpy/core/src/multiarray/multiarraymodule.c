@@ -52,6 +52,10 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "datetime_busday.h"
 #include "datetime_busdaycal.h"
 #include "item_selection.h"
+#include "sortindex.h"
+#include "interptable.h"
+#include "lazyexpr.h"
+#include "growable.h"
 #include "shape.h"
 #include "ctors.h"
 #include "array_assign.h"
@@ -61,7 +65,12 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "vdot.h"
 #include "templ_common.h" /* for npy_mul_with_overflow_intp */
 #include "compiled_base.h"
+#include "unicode_codec.h"
 #include "mem_overlap.h"
+#include "npy_workpool.h"
+#include "ufunc_stats.h"
+#include "ufunc_parallel.h"
+#include "cpuid.h"
 #include "alloc.h"
 #include "typeinfo.h"
 
@@ -95,6 +104,63 @@ set_legacy_print_mode(PyObject *NPY_UNUSED(self), PyObject *args)
     Py_RETURN_NONE;
 }
 
+/*
+ * Runtime controls for the internal worker pool.  The process-wide cap
+ * bounds every parallel region; the per-thread limit is thread-local
+ * like the errstate machinery, so one thread can be pinned to serial
+ * execution without affecting the others.  Both return the previous
+ * cap, where 0 means no cap was set.
+ */
+static PyObject *
+array__set_num_threads(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int nthreads;
+
+    if (!PyArg_ParseTuple(args, "i", &nthreads)) {
+        return NULL;
+    }
+    return PyLong_FromLong(npy_workpool_set_max_threads(nthreads));
+}
+
+static PyObject *
+array__set_thread_limit(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int nthreads;
+
+    if (!PyArg_ParseTuple(args, "i", &nthreads)) {
+        return NULL;
+    }
+    return PyLong_FromLong(npy_workpool_set_thread_limit(nthreads));
+}
+
+/* The effective thread limit for regions issued from this thread */
+static PyObject *
+array__get_num_threads(PyObject *NPY_UNUSED(self), PyObject *NPY_UNUSED(args))
+{
+    return PyLong_FromLong(npy_workpool_get_max_threads());
+}
+
+/*
+ * Deterministic mode for the parallel engines: chunk layouts are
+ * planned from the problem size alone, so reruns are bit identical
+ * whatever the thread count, at the price of some scheduling slack.
+ * Also settable through NPY_DETERMINISTIC.  Returns the previous
+ * setting.  Note that the engines' own enable switches still decide
+ * whether a threaded path runs at all, and the serial paths chunk
+ * differently; fleets wanting identical results must agree on those
+ * switches as well.
+ */
+static PyObject *
+array__set_deterministic(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int enable;
+
+    if (!PyArg_ParseTuple(args, "i", &enable)) {
+        return NULL;
+    }
+    return PyBool_FromLong(npy_workpool_set_deterministic(enable));
+}
+
 
 /* Only here for API compatibility */
 NPY_NO_EXPORT PyTypeObject PyBigArray_Type;
@@ -490,6 +556,49 @@ PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis,
         }
     }
 
+    /*
+     * Fast path: when every source is a plain contiguous block of the
+     * same dtype landing in a contiguous slab of 'ret', the per-source
+     * copies are independent memcpys and can run as one parallel
+     * region (NPY_ASSIGN_THREADS), so concatenating many shards into a
+     * big destination is not a single-core copy loop.
+     */
+    if (axis == 0 && narrays > 1 && PyArray_ISCARRAY(ret) &&
+            !PyDataType_REFCHK(PyArray_DESCR(ret))) {
+        int trivial = 1;
+
+        for (iarrays = 0; iarrays < narrays; ++iarrays) {
+            if (!PyArray_ISCARRAY_RO(arrays[iarrays]) ||
+                    !PyArray_EquivArrTypes(arrays[iarrays], ret) ||
+                    PyArray_ISNOTSWAPPED(arrays[iarrays]) !=
+                            PyArray_ISNOTSWAPPED(ret) ||
+                    arrays_overlap(ret, arrays[iarrays])) {
+                trivial = 0;
+                break;
+            }
+        }
+        if (trivial) {
+            npy_block_copy_spec *blocks = PyArray_malloc(
+                    narrays * sizeof(npy_block_copy_spec));
+
+            /* on allocation failure take the general path below */
+            if (blocks != NULL) {
+                char *dst = PyArray_BYTES(ret);
+
+                for (iarrays = 0; iarrays < narrays; ++iarrays) {
+                    blocks[iarrays].dst = dst;
+                    blocks[iarrays].src = PyArray_BYTES(arrays[iarrays]);
+                    blocks[iarrays].nbytes =
+                            (npy_uintp)PyArray_NBYTES(arrays[iarrays]);
+                    dst += blocks[iarrays].nbytes;
+                }
+                npy_parallel_block_copy(blocks, narrays);
+                PyArray_free(blocks);
+                return ret;
+            }
+        }
+    }
+
     /*
      * Create a view which slides through ret for assigning the
      * successive input arrays.
@@ -2025,6 +2134,29 @@ array_count_nonzero(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 #endif
 }
 
+static PyObject *
+array__topk(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *kwds)
+{
+    PyArrayObject *array;
+    PyObject *ret;
+    Py_ssize_t k;
+    int axis = -1;
+    int largest = 1;
+    static char *kwlist[] = {"a", "k", "axis", "largest", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&n|ii:_topk", kwlist,
+                                     PyArray_Converter, &array,
+                                     &k, &axis, &largest)) {
+        return NULL;
+    }
+
+    ret = PyArray_TopK(array, (npy_intp)k, axis, largest);
+
+    Py_DECREF(array);
+
+    return ret;
+}
+
 static PyObject *
 array_fromstring(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
 {
@@ -2058,165 +2190,2050 @@ array_fromstring(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds
 
 
 static PyObject *
-array_fromfile(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
+array_fromfile(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *file = NULL, *ret;
+    PyObject *err_type = NULL, *err_value = NULL, *err_traceback = NULL;
+    char *sep = "";
+    Py_ssize_t nin = -1;
+    static char *kwlist[] = {"file", "dtype", "count", "sep", NULL};
+    PyArray_Descr *type = NULL;
+    int own;
+    npy_off_t orig_pos = 0;
+    FILE *fp;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds,
+                "O|O&" NPY_SSIZE_T_PYFMT "s:fromfile", kwlist,
+                &file, PyArray_DescrConverter, &type, &nin, &sep)) {
+        Py_XDECREF(type);
+        return NULL;
+    }
+    if (PyString_Check(file) || PyUnicode_Check(file)) {
+        file = npy_PyFile_OpenFile(file, "rb");
+        if (file == NULL) {
+            return NULL;
+        }
+        own = 1;
+    }
+    else {
+        Py_INCREF(file);
+        own = 0;
+    }
+    fp = npy_PyFile_Dup2(file, "rb", &orig_pos);
+    if (fp == NULL) {
+        Py_DECREF(file);
+        return NULL;
+    }
+    if (type == NULL) {
+        type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
+    }
+    ret = PyArray_FromFile(fp, type, (npy_intp) nin, sep);
+
+    /* If an exception is thrown in the call to PyArray_FromFile
+     * we need to clear it, and restore it later to ensure that
+     * we can cleanup the duplicated file descriptor properly.
+     */
+    PyErr_Fetch(&err_type, &err_value, &err_traceback);
+    if (npy_PyFile_DupClose2(file, fp, orig_pos) < 0) {
+        npy_PyErr_ChainExceptions(err_type, err_value, err_traceback);
+        goto fail;
+    }
+    if (own && npy_PyFile_CloseFile(file) < 0) {
+        npy_PyErr_ChainExceptions(err_type, err_value, err_traceback);
+        goto fail;
+    }
+    PyErr_Restore(err_type, err_value, err_traceback);
+    Py_DECREF(file);
+    return ret;
+
+fail:
+    Py_DECREF(file);
+    Py_XDECREF(ret);
+    return NULL;
+}
+
+static PyObject *
+array_fromiter(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *iter;
+    Py_ssize_t nin = -1;
+    static char *kwlist[] = {"iter", "dtype", "count", NULL};
+    PyArray_Descr *descr = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds,
+                "OO&|" NPY_SSIZE_T_PYFMT ":fromiter", kwlist,
+                &iter, PyArray_DescrConverter, &descr, &nin)) {
+        Py_XDECREF(descr);
+        return NULL;
+    }
+    return PyArray_FromIter(iter, descr, (npy_intp)nin);
+}
+
+static PyObject *
+array_frombuffer(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
+{
+    PyObject *obj = NULL;
+    Py_ssize_t nin = -1, offset = 0;
+    static char *kwlist[] = {"buffer", "dtype", "count", "offset", NULL};
+    PyArray_Descr *type = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywds,
+                "O|O&" NPY_SSIZE_T_PYFMT NPY_SSIZE_T_PYFMT ":frombuffer", kwlist,
+                &obj, PyArray_DescrConverter, &type, &nin, &offset)) {
+        Py_XDECREF(type);
+        return NULL;
+    }
+    if (type == NULL) {
+        type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
+    }
+    return PyArray_FromBuffer(obj, type, (npy_intp)nin, (npy_intp)offset);
+}
+
+static PyObject *
+array_concatenate(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    PyObject *a0;
+    PyObject *out = NULL;
+    int axis = 0;
+    static char *kwlist[] = {"seq", "axis", "out", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&O:concatenate", kwlist,
+                &a0, PyArray_AxisConverter, &axis, &out)) {
+        return NULL;
+    }
+    if (out != NULL) {
+        if (out == Py_None) {
+            out = NULL;
+        }
+        else if (!PyArray_Check(out)) {
+            PyErr_SetString(PyExc_TypeError, "'out' must be an array");
+            return NULL;
+        }
+    }
+    return PyArray_ConcatenateInto(a0, axis, (PyArrayObject *)out);
+}
+
+static PyObject *
+array_innerproduct(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyObject *b0, *a0;
+
+    if (!PyArg_ParseTuple(args, "OO:innerproduct", &a0, &b0)) {
+        return NULL;
+    }
+    return PyArray_Return((PyArrayObject *)PyArray_InnerProduct(a0, b0));
+}
+
+static PyObject *
+array_matrixproduct(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject* kwds)
+{
+    PyObject *v, *a, *o = NULL;
+    PyArrayObject *ret;
+    char* kwlist[] = {"a", "b", "out", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O:matrixproduct",
+                                     kwlist, &a, &v, &o)) {
+        return NULL;
+    }
+    if (o != NULL) {
+        if (o == Py_None) {
+            o = NULL;
+        }
+        else if (!PyArray_Check(o)) {
+            PyErr_SetString(PyExc_TypeError, "'out' must be an array");
+            return NULL;
+        }
+    }
+    ret = (PyArrayObject *)PyArray_MatrixProduct2(a, v, (PyArrayObject *)o);
+    return PyArray_Return(ret);
+}
+
+/*
+ * _decide_all_any(a, stop_on_true)
+ *
+ * Private helper for _methods._all/_any: reduce the whole of a to a
+ * boolean scalar with the early-exit engine in calculation.c.  Returns
+ * NotImplemented when the engine does not cover the operand, so callers
+ * can fall back to logical_and/logical_or.reduce.
+ */
+static PyObject *
+array__decide_all_any(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyObject *a;
+    int stop_on_true;
+    npy_bool result;
+
+    if (!PyArg_ParseTuple(args, "Oi:_decide_all_any", &a, &stop_on_true)) {
+        return NULL;
+    }
+    if (!PyArray_CheckExact(a) ||
+            !_decisive_all_any_applies((PyArrayObject *)a)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    if (_decisive_all_any((PyArrayObject *)a, stop_on_true != 0,
+                          &result) < 0) {
+        return NULL;
+    }
+    if (result) {
+        PyArrayScalar_RETURN_TRUE;
+    }
+    PyArrayScalar_RETURN_FALSE;
+}
+
+/*
+ * _count_nonfinite(a)
+ *
+ * Fused validation scan: returns (count, first) where count is the
+ * number of non-finite elements of a and first the C-order flat index
+ * of the first one (-1 when the array is entirely finite).  One pass
+ * over the data, no boolean temporary.
+ */
+static PyObject *
+array__count_nonfinite(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyObject *obj;
+    PyArrayObject *arr;
+    npy_intp count, first;
+
+    if (!PyArg_ParseTuple(args, "O:_count_nonfinite", &obj)) {
+        return NULL;
+    }
+    arr = (PyArrayObject *)PyArray_FROM_O(obj);
+    if (arr == NULL) {
+        return NULL;
+    }
+    if (_count_nonfinite(arr, &count, &first) < 0) {
+        Py_DECREF(arr);
+        return NULL;
+    }
+    Py_DECREF(arr);
+    return Py_BuildValue("nn", (Py_ssize_t)count, (Py_ssize_t)first);
+}
+
+/*
+ * _fused_dot(a, b, bias=None, activation=None)
+ *
+ * Compute activation(dot(a, b) + bias) in a single pass over the
+ * output, applying the epilogue while each gemm block is still cache
+ * resident. Limited to 2-d float32/float64 operands; other inputs are
+ * promoted to float64, complex is rejected.
+ */
+static PyObject *
+array_fused_dot(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+#if defined(HAVE_CBLAS)
+    static char *kwlist[] = {"a", "b", "bias", "activation", NULL};
+    PyObject *a, *b, *bias_obj = Py_None;
+    char *activation_str = NULL;
+    PyArrayObject *ap1, *ap2, *bias = NULL;
+    PyArray_Descr *typec;
+    int typenum, activation = NPY_FUSED_ACT_NONE;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|Oz:_fused_dot", kwlist,
+                                     &a, &b, &bias_obj, &activation_str)) {
+        return NULL;
+    }
+    if (activation_str != NULL && strcmp(activation_str, "none") != 0) {
+        if (strcmp(activation_str, "relu") == 0) {
+            activation = NPY_FUSED_ACT_RELU;
+        }
+        else {
+            PyErr_Format(PyExc_ValueError,
+                         "unknown activation '%s'", activation_str);
+            return NULL;
+        }
+    }
+
+    typenum = PyArray_ObjectType(a, 0);
+    typenum = PyArray_ObjectType(b, typenum);
+    if (bias_obj != Py_None) {
+        typenum = PyArray_ObjectType(bias_obj, typenum);
+    }
+    if (typenum != NPY_FLOAT) {
+        if (PyTypeNum_ISCOMPLEX(typenum)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "_fused_dot does not support complex operands");
+            return NULL;
+        }
+        typenum = NPY_DOUBLE;
+    }
+    typec = PyArray_DescrFromType(typenum);
+    if (typec == NULL) {
+        return NULL;
+    }
+
+    if (bias_obj != Py_None) {
+        Py_INCREF(typec);
+        bias = (PyArrayObject *)PyArray_FromAny(bias_obj, typec, 1, 1,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS, NULL);
+        if (bias == NULL) {
+            Py_DECREF(typec);
+            return NULL;
+        }
+    }
+    Py_INCREF(typec);
+    ap1 = (PyArrayObject *)PyArray_FromAny(a, typec, 2, 2,
+                                           NPY_ARRAY_ALIGNED, NULL);
+    if (ap1 == NULL) {
+        Py_DECREF(typec);
+        Py_XDECREF(bias);
+        return NULL;
+    }
+    ap2 = (PyArrayObject *)PyArray_FromAny(b, typec, 2, 2,
+                                           NPY_ARRAY_ALIGNED, NULL);
+    if (ap2 == NULL) {
+        Py_DECREF(ap1);
+        Py_XDECREF(bias);
+        return NULL;
+    }
+
+    return cblas_fused_matrixproduct(typenum, ap1, ap2, bias, activation);
+#else
+    PyErr_SetString(PyExc_RuntimeError,
+                    "_fused_dot requires numpy to be built with CBLAS");
+    return NULL;
+#endif
+}
+
+
+/* rows per parallel task and j-tile elements of the outer engine */
+#define NPY_OUTER_ROW_BLOCK 64
+#define NPY_OUTER_JBLOCK 2048
+
+/**begin-like repeated kernels, kept in plain C as there are only two */
+static void
+outer_multiply_block_double(const npy_double *a, const npy_double *b,
+                            npy_double *out, npy_intp r0, npy_intp r1,
+                            npy_intp n)
+{
+    npy_intp i, j, j0;
+
+    /* tile over j so the slab of b stays cache resident across rows */
+    for (j0 = 0; j0 < n; j0 += NPY_OUTER_JBLOCK) {
+        npy_intp jend = (j0 + NPY_OUTER_JBLOCK > n) ? n
+                                                    : j0 + NPY_OUTER_JBLOCK;
+        for (i = r0; i < r1; i++) {
+            const npy_double ai = a[i];
+            npy_double *row = out + i * n;
+
+            for (j = j0; j < jend; j++) {
+                row[j] = ai * b[j];
+            }
+        }
+    }
+}
+
+static void
+outer_multiply_block_float(const npy_float *a, const npy_float *b,
+                           npy_float *out, npy_intp r0, npy_intp r1,
+                           npy_intp n)
+{
+    npy_intp i, j, j0;
+
+    for (j0 = 0; j0 < n; j0 += NPY_OUTER_JBLOCK) {
+        npy_intp jend = (j0 + NPY_OUTER_JBLOCK > n) ? n
+                                                    : j0 + NPY_OUTER_JBLOCK;
+        for (i = r0; i < r1; i++) {
+            const npy_float ai = a[i];
+            npy_float *row = out + i * n;
+
+            for (j = j0; j < jend; j++) {
+                row[j] = ai * b[j];
+            }
+        }
+    }
+}
+
+typedef struct {
+    const char *a;
+    const char *b;
+    char *out;
+    npy_intp m;
+    npy_intp n;
+    int typenum;
+} outer_multiply_job;
+
+static void
+outer_multiply_run(npy_intp t, void *arg)
+{
+    outer_multiply_job *job = (outer_multiply_job *)arg;
+    npy_intp r0 = t * NPY_OUTER_ROW_BLOCK;
+    npy_intp r1 = r0 + NPY_OUTER_ROW_BLOCK;
+
+    if (r1 > job->m) {
+        r1 = job->m;
+    }
+    if (job->typenum == NPY_DOUBLE) {
+        outer_multiply_block_double((const npy_double *)job->a,
+                                    (const npy_double *)job->b,
+                                    (npy_double *)job->out, r0, r1, job->n);
+    }
+    else {
+        outer_multiply_block_float((const npy_float *)job->a,
+                                   (const npy_float *)job->b,
+                                   (npy_float *)job->out, r0, r1, job->n);
+    }
+}
+
+/*
+ * _outer_multiply(a, b, out=None)
+ *
+ * Direct rank-1 product out[i, j] = a[i]*b[j] for contiguous 1-d
+ * float32/float64 operands, bypassing the broadcasting iterator that
+ * multiply.outer sets up over the virtual (m, 1) x (n,) product.  The
+ * inner loops are tiled so the active slab of b stays cache resident
+ * across rows, and the row blocks run on the worker pool when
+ * NPY_UFUNC_THREADS enables it.  np.outer calls this only after
+ * validating the operands; out, when given, must be a matching
+ * C-contiguous array not sharing memory with the operands.
+ */
+static PyObject *
+array__outer_multiply(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                      PyObject *kwds)
+{
+    static char *kwlist[] = {"a", "b", "out", NULL};
+    PyArrayObject *a, *b, *out = NULL;
+    outer_multiply_job job;
+    npy_intp dims[2], ntasks;
+    int typenum;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O!|O!:_outer_multiply",
+                                     kwlist, &PyArray_Type, &a,
+                                     &PyArray_Type, &b,
+                                     &PyArray_Type, &out)) {
+        return NULL;
+    }
+    typenum = PyArray_TYPE(a);
+    if ((typenum != NPY_FLOAT && typenum != NPY_DOUBLE) ||
+            PyArray_TYPE(b) != typenum ||
+            PyArray_NDIM(a) != 1 || PyArray_NDIM(b) != 1 ||
+            !PyArray_ISCARRAY_RO(a) || !PyArray_ISCARRAY_RO(b)) {
+        PyErr_SetString(PyExc_ValueError,
+                "_outer_multiply needs contiguous 1-d operands of a "
+                "matching float dtype");
+        return NULL;
+    }
+    dims[0] = PyArray_DIM(a, 0);
+    dims[1] = PyArray_DIM(b, 0);
+    if (out != NULL) {
+        if (PyArray_TYPE(out) != typenum || PyArray_NDIM(out) != 2 ||
+                PyArray_DIM(out, 0) != dims[0] ||
+                PyArray_DIM(out, 1) != dims[1] ||
+                !PyArray_ISCARRAY(out) ||
+                arrays_overlap(out, a) || arrays_overlap(out, b)) {
+            PyErr_SetString(PyExc_ValueError,
+                    "out must be a matching C-contiguous array not "
+                    "overlapping the operands");
+            return NULL;
+        }
+        Py_INCREF(out);
+    }
+    else {
+        out = (PyArrayObject *)PyArray_SimpleNew(2, dims, typenum);
+        if (out == NULL) {
+            return NULL;
+        }
+    }
+    if (dims[0] == 0 || dims[1] == 0) {
+        return (PyObject *)out;
+    }
+
+    job.a = PyArray_BYTES(a);
+    job.b = PyArray_BYTES(b);
+    job.out = PyArray_BYTES(out);
+    job.m = dims[0];
+    job.n = dims[1];
+    job.typenum = typenum;
+    ntasks = (job.m + NPY_OUTER_ROW_BLOCK - 1) / NPY_OUTER_ROW_BLOCK;
+
+    NPY_BEGIN_THREADS_THRESHOLDED(dims[0] * dims[1]);
+    npy_parallel_for(ntasks, outer_multiply_run, &job,
+                     npy_ufunc_nthreads());
+    NPY_END_THREADS;
+
+    return (PyObject *)out;
+}
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+typedef struct {
+    void *addr;
+    size_t len;
+} npy_mmap_info;
+
+static void
+_npy_mmap_free(PyObject *capsule)
+{
+    npy_mmap_info *minfo = NpyCapsule_AsVoidPtr(capsule);
+
+    if (minfo != NULL) {
+        munmap(minfo->addr, minfo->len);
+        PyArray_free(minfo);
+    }
+}
+
+/* memmem is not portable; the header is tiny, a naive scan is fine */
+static const char *
+_npy_header_find(const char *header, npy_intp header_len,
+                 const char *token, size_t token_len)
+{
+    const char *p = header, *end = header + header_len;
+
+    while (p + token_len <= end) {
+        if (memcmp(p, token, token_len) == 0) {
+            return p;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+/*
+ * Minimal parser for the header dict written by numpy itself:
+ * {'descr': <string>, 'fortran_order': <bool>, 'shape': <int tuple>, }
+ * Anything more exotic (structured descrs spelled as lists or dicts,
+ * unusual key order, pickled objects) raises ValueError so callers can
+ * fall back to the Python implementation in numpy.lib.format.
+ */
+static int
+_parse_npy_header(const char *header, npy_intp header_len,
+                  PyArray_Descr **out_descr, int *out_fortran,
+                  npy_intp *dims, int *out_nd)
+{
+    const char *p, *end = header + header_len, *start;
+    PyObject *descr_str;
+    int nd = 0;
+
+    p = _npy_header_find(header, header_len, "'descr':", 8);
+    if (p == NULL) {
+        goto unsupported;
+    }
+    for (p += 8; p < end && *p == ' '; p++);
+    if (p >= end || *p != '\'') {
+        goto unsupported;
+    }
+    start = ++p;
+    while (p < end && *p != '\'') {
+        p++;
+    }
+    if (p >= end) {
+        goto unsupported;
+    }
+    descr_str = PyUString_FromStringAndSize(start, p - start);
+    if (descr_str == NULL) {
+        return -1;
+    }
+    if (!PyArray_DescrConverter(descr_str, out_descr)) {
+        Py_DECREF(descr_str);
+        return -1;
+    }
+    Py_DECREF(descr_str);
+    if ((*out_descr)->elsize == 0 ||
+            PyDataType_FLAGCHK(*out_descr, NPY_ITEM_HASOBJECT)) {
+        goto unsupported;
+    }
+
+    p = _npy_header_find(header, header_len, "'fortran_order':", 16);
+    if (p == NULL) {
+        goto unsupported;
+    }
+    for (p += 16; p < end && *p == ' '; p++);
+    if (end - p >= 4 && memcmp(p, "True", 4) == 0) {
+        *out_fortran = 1;
+    }
+    else if (end - p >= 5 && memcmp(p, "False", 5) == 0) {
+        *out_fortran = 0;
+    }
+    else {
+        goto unsupported;
+    }
+
+    p = _npy_header_find(header, header_len, "'shape':", 8);
+    if (p == NULL) {
+        goto unsupported;
+    }
+    for (p += 8; p < end && *p == ' '; p++);
+    if (p >= end || *p != '(') {
+        goto unsupported;
+    }
+    p++;
+    for (;;) {
+        char *num_end;
+        long long value;
+
+        for (; p < end && (*p == ' ' || *p == ','); p++);
+        if (p >= end) {
+            goto unsupported;
+        }
+        if (*p == ')') {
+            break;
+        }
+        if (nd >= NPY_MAXDIMS || *p < '0' || *p > '9') {
+            goto unsupported;
+        }
+        value = strtoll(p, &num_end, 10);
+        if (num_end == p || value < 0 || value > NPY_MAX_INTP) {
+            goto unsupported;
+        }
+        dims[nd++] = (npy_intp)value;
+        p = num_end;
+    }
+    *out_nd = nd;
+    return 0;
+
+unsupported:
+    Py_XDECREF(*out_descr);
+    *out_descr = NULL;
+    PyErr_SetString(PyExc_ValueError,
+            "header is not understood by the fast .npy loader");
+    return -1;
+}
+#endif
+
+/*
+ * _load_npy_mmap(file, mode='r')
+ *
+ * Open a .npy file, parse its header and return an ndarray backed by a
+ * memory mapping of the data section, all in a single C call. mode is
+ * 'r' (read-only), 'r+' (writes go back to the file) or 'c'
+ * (copy-on-write). The mapping is advised MADV_SEQUENTIAL and
+ * MADV_WILLNEED and is torn down when the returned array dies. Raises
+ * ValueError for files the minimal header parser does not handle;
+ * callers are expected to fall back to numpy.lib.format then.
+ */
+static PyObject *
+array__load_npy_mmap(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                     PyObject *kwds)
+{
+#ifndef _WIN32
+    static char *kwlist[] = {"file", "mode", NULL};
+    char *path, *mode = "r";
+    int fd, open_flags, prot, map_flags, writeable, fortran = 0, nd = 0;
+    struct stat st;
+    char *addr = MAP_FAILED;
+    size_t length = 0;
+    npy_intp header_len, data_offset, nbytes, dims[NPY_MAXDIMS];
+    int i;
+    PyArray_Descr *descr = NULL;
+    npy_mmap_info *minfo;
+    PyObject *capsule, *ret;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "s|s:_load_npy_mmap",
+                                     kwlist, &path, &mode)) {
+        return NULL;
+    }
+    if (strcmp(mode, "r") == 0) {
+        open_flags = O_RDONLY;
+        prot = PROT_READ;
+        map_flags = MAP_SHARED;
+        writeable = 0;
+    }
+    else if (strcmp(mode, "r+") == 0) {
+        open_flags = O_RDWR;
+        prot = PROT_READ | PROT_WRITE;
+        map_flags = MAP_SHARED;
+        writeable = 1;
+    }
+    else if (strcmp(mode, "c") == 0) {
+        open_flags = O_RDONLY;
+        prot = PROT_READ | PROT_WRITE;
+        map_flags = MAP_PRIVATE;
+        writeable = 1;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "mode must be 'r', 'r+' or 'c' (got '%s')", mode);
+        return NULL;
+    }
+
+    fd = open(path, open_flags);
+    if (fd < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, path);
+        close(fd);
+        return NULL;
+    }
+    length = (size_t)st.st_size;
+    if (st.st_size >= 10) {
+        addr = mmap(NULL, length, prot, map_flags, fd, 0);
+    }
+    close(fd);
+    if (addr == MAP_FAILED) {
+        PyErr_Format(PyExc_ValueError,
+                     "could not map '%s' as a .npy file", path);
+        return NULL;
+    }
+
+    if (memcmp(addr, "\x93NUMPY", 6) != 0) {
+        PyErr_Format(PyExc_ValueError, "'%s' is not a .npy file", path);
+        goto fail;
+    }
+    if (addr[6] == 1) {
+        header_len = ((unsigned char *)addr)[8] |
+                     ((npy_intp)((unsigned char *)addr)[9] << 8);
+        data_offset = 10 + header_len;
+    }
+    else if (addr[6] == 2 && st.st_size >= 12) {
+        header_len = ((unsigned char *)addr)[8] |
+                     ((npy_intp)((unsigned char *)addr)[9] << 8) |
+                     ((npy_intp)((unsigned char *)addr)[10] << 16) |
+                     ((npy_intp)((unsigned char *)addr)[11] << 24);
+        data_offset = 12 + header_len;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "unsupported .npy format version in '%s'", path);
+        goto fail;
+    }
+    if (data_offset > st.st_size) {
+        PyErr_Format(PyExc_ValueError, "'%s' is truncated", path);
+        goto fail;
+    }
+
+    if (_parse_npy_header(addr + data_offset - header_len, header_len,
+                          &descr, &fortran, dims, &nd) < 0) {
+        goto fail;
+    }
+    nbytes = descr->elsize;
+    for (i = 0; i < nd; i++) {
+        if (npy_mul_with_overflow_intp(&nbytes, nbytes, dims[i])) {
+            PyErr_SetString(PyExc_ValueError, "array is too big");
+            goto fail;
+        }
+    }
+    if (data_offset + nbytes > st.st_size) {
+        PyErr_Format(PyExc_ValueError, "'%s' is truncated", path);
+        goto fail;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    madvise(addr, length, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_WILLNEED
+    madvise(addr, length, MADV_WILLNEED);
+#endif
+
+    minfo = PyArray_malloc(sizeof(npy_mmap_info));
+    if (minfo == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    minfo->addr = addr;
+    minfo->len = length;
+    capsule = NpyCapsule_FromVoidPtr(minfo, _npy_mmap_free);
+    if (capsule == NULL) {
+        PyArray_free(minfo);
+        goto fail;
+    }
+
+    /* the capsule owns the mapping from here on */
+    ret = PyArray_NewFromDescr(
+            &PyArray_Type, descr, nd, dims, NULL, addr + data_offset,
+            (fortran ? NPY_ARRAY_F_CONTIGUOUS : 0) |
+            (writeable ? NPY_ARRAY_WRITEABLE : 0), NULL);
+    if (ret == NULL) {
+        Py_DECREF(capsule);
+        return NULL;
+    }
+    if (PyArray_SetBaseObject((PyArrayObject *)ret, capsule) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    PyArray_UpdateFlags((PyArrayObject *)ret, NPY_ARRAY_UPDATE_ALL);
+    return ret;
+
+fail:
+    Py_XDECREF(descr);
+    if (addr != MAP_FAILED) {
+        munmap(addr, length);
+    }
+    return NULL;
+#else
+    PyErr_SetString(PyExc_RuntimeError,
+            "_load_npy_mmap is not available on this platform");
+    return NULL;
+#endif
+}
+
+/*
+ * _from_fd(fd, dtype, shape, offset=0, writeable=True)
+ *
+ * Return an ndarray backed by a MAP_SHARED mapping of an open file
+ * descriptor (a memfd, POSIX shm handle or plain file), for zero-copy
+ * array exchange between processes. offset is in bytes and need not be
+ * page aligned. The descriptor is not retained and may be closed once
+ * this returns; the mapping is torn down when the array dies.
+ */
+static PyObject *
+array__from_fd(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+#ifndef _WIN32
+    static char *kwlist[] = {"fd", "dtype", "shape", "offset", "writeable",
+                             NULL};
+    int fd, writeable = 1;
+    Py_ssize_t offset = 0;
+    PyArray_Descr *descr = NULL;
+    PyArray_Dims shape = {NULL, 0};
+    npy_intp nbytes, pageoff;
+    long pagesize;
+    struct stat st;
+    void *addr;
+    npy_mmap_info *minfo;
+    PyObject *capsule, *ret;
+    int i;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds,
+                "iO&O&|" NPY_SSIZE_T_PYFMT "i:_from_fd", kwlist,
+                &fd, PyArray_DescrConverter, &descr,
+                PyArray_IntpConverter, &shape, &offset, &writeable)) {
+        Py_XDECREF(descr);
+        npy_free_cache_dim_obj(shape);
+        return NULL;
+    }
+    if (descr->elsize == 0 ||
+            PyDataType_FLAGCHK(descr, NPY_ITEM_HASOBJECT)) {
+        PyErr_SetString(PyExc_ValueError,
+                "dtype must have a fixed, object-free item size");
+        goto fail;
+    }
+    if (fd < 0 || offset < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "fd and offset must be non-negative");
+        goto fail;
+    }
+    nbytes = descr->elsize;
+    for (i = 0; i < shape.len; i++) {
+        if (shape.ptr[i] < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "negative dimensions are not allowed");
+            goto fail;
+        }
+        if (npy_mul_with_overflow_intp(&nbytes, nbytes, shape.ptr[i])) {
+            PyErr_SetString(PyExc_ValueError, "array is too big");
+            goto fail;
+        }
+    }
+    if (nbytes == 0) {
+        /* nothing to map; an ordinary empty array behaves the same */
+        ret = PyArray_NewFromDescr(&PyArray_Type, descr, shape.len,
+                                   shape.ptr, NULL, NULL, 0, NULL);
+        npy_free_cache_dim_obj(shape);
+        return ret;
+    }
+    /* catch mappings running past the end before they turn into SIGBUS */
+    if (fstat(fd, &st) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto fail;
+    }
+    if (S_ISREG(st.st_mode) &&
+            (st.st_size < nbytes || (npy_off_t)offset > st.st_size - nbytes)) {
+        PyErr_Format(PyExc_ValueError,
+                "mapping of %" NPY_INTP_FMT " bytes at offset %" NPY_INTP_FMT
+                " extends past the end of the file",
+                nbytes, (npy_intp)offset);
+        goto fail;
+    }
+
+    pagesize = sysconf(_SC_PAGESIZE);
+    pageoff = (npy_intp)offset % pagesize;
+    addr = mmap(NULL, (size_t)(nbytes + pageoff),
+                writeable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                MAP_SHARED, fd, (off_t)(offset - pageoff));
+    if (addr == MAP_FAILED) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto fail;
+    }
+
+    minfo = PyArray_malloc(sizeof(npy_mmap_info));
+    if (minfo == NULL) {
+        munmap(addr, (size_t)(nbytes + pageoff));
+        PyErr_NoMemory();
+        goto fail;
+    }
+    minfo->addr = addr;
+    minfo->len = (size_t)(nbytes + pageoff);
+    capsule = NpyCapsule_FromVoidPtr(minfo, _npy_mmap_free);
+    if (capsule == NULL) {
+        munmap(addr, minfo->len);
+        PyArray_free(minfo);
+        goto fail;
+    }
+
+    /* the capsule owns the mapping from here on */
+    ret = PyArray_NewFromDescr(
+            &PyArray_Type, descr, shape.len, shape.ptr, NULL,
+            (char *)addr + pageoff,
+            writeable ? NPY_ARRAY_WRITEABLE : 0, NULL);
+    npy_free_cache_dim_obj(shape);
+    if (ret == NULL) {
+        Py_DECREF(capsule);
+        return NULL;
+    }
+    if (PyArray_SetBaseObject((PyArrayObject *)ret, capsule) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    PyArray_UpdateFlags((PyArrayObject *)ret, NPY_ARRAY_UPDATE_ALL);
+    return ret;
+
+fail:
+    Py_XDECREF(descr);
+    npy_free_cache_dim_obj(shape);
+    return NULL;
+#else
+    PyErr_SetString(PyExc_RuntimeError,
+            "_from_fd is not available on this platform");
+    return NULL;
+#endif
+}
+
+#ifndef _WIN32
+/*
+ * An array counts as backed by a memory mapping when the root of its
+ * base chain is an mmap object (np.memmap) or a mapping capsule from
+ * _load_npy_mmap/_from_fd.  Paging hints on anything else are pointless
+ * at best and, for 'dontneed' on anonymous memory, destructive.
+ */
+static int
+_array_is_mmap_backed(PyArrayObject *arr)
+{
+    PyObject *base = PyArray_BASE(arr);
+
+    if (base == NULL) {
+        return 0;
+    }
+    while (PyArray_Check(base) &&
+                PyArray_BASE((PyArrayObject *)base) != NULL) {
+        base = PyArray_BASE((PyArrayObject *)base);
+    }
+    if (NpyCapsule_Check(base)) {
+        return 1;
+    }
+    return strcmp(Py_TYPE(base)->tp_name, "mmap.mmap") == 0;
+}
+#endif
+
+/*
+ * _madvise_range(a, advice)
+ *
+ * Apply a paging hint to the pages backing an ndarray, typically a
+ * block-sized view of a memory-mapped array.  advice is 'willneed',
+ * 'sequential' or 'dontneed'.  Hints are only issued for mmap-backed
+ * arrays; 'dontneed' additionally requires a read-only array, since
+ * dropping pages of a written-to private mapping would discard the
+ * writes.  The byte range is rounded outward to page boundaries for
+ * the prefetch hints and inward for 'dontneed'.  Returns True when a
+ * hint was issued and False when it was skipped, so callers can treat
+ * the whole mechanism as best effort.
+ */
+static PyObject *
+array__madvise_range(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                     PyObject *kwds)
+{
+#ifndef _WIN32
+    static char *kwlist[] = {"a", "advice", NULL};
+    PyArrayObject *arr;
+    char *advice;
+    char *lo, *hi;
+    npy_intp pagesize, i;
+    int mode;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&s:_madvise_range",
+                                     kwlist, PyArray_Converter, &arr,
+                                     &advice)) {
+        return NULL;
+    }
+    if (strcmp(advice, "willneed") == 0) {
+#ifdef MADV_WILLNEED
+        mode = MADV_WILLNEED;
+#else
+        mode = -1;
+#endif
+    }
+    else if (strcmp(advice, "sequential") == 0) {
+#ifdef MADV_SEQUENTIAL
+        mode = MADV_SEQUENTIAL;
+#else
+        mode = -1;
+#endif
+    }
+    else if (strcmp(advice, "dontneed") == 0) {
+#ifdef MADV_DONTNEED
+        mode = PyArray_ISWRITEABLE(arr) ? -1 : MADV_DONTNEED;
+#else
+        mode = -1;
+#endif
+    }
+    else {
+        Py_DECREF(arr);
+        PyErr_Format(PyExc_ValueError,
+                "advice must be 'willneed', 'sequential' or 'dontneed' "
+                "(got '%s')", advice);
+        return NULL;
+    }
+    if (mode == -1 || PyArray_SIZE(arr) == 0 ||
+            !_array_is_mmap_backed(arr)) {
+        Py_DECREF(arr);
+        Py_RETURN_FALSE;
+    }
+
+    /* byte extent of the array; strides may point either way */
+    lo = hi = (char *)PyArray_DATA(arr);
+    for (i = 0; i < PyArray_NDIM(arr); i++) {
+        npy_intp ext = (PyArray_DIM(arr, i) - 1) * PyArray_STRIDE(arr, i);
+
+        if (ext < 0) {
+            lo += ext;
+        }
+        else {
+            hi += ext;
+        }
+    }
+    hi += PyArray_DESCR(arr)->elsize;
+    Py_DECREF(arr);
+
+    pagesize = (npy_intp)sysconf(_SC_PAGESIZE);
+#ifdef MADV_DONTNEED
+    if (mode == MADV_DONTNEED) {
+        /* inward: never touch pages shared with neighbouring data */
+        lo += (pagesize - (npy_intp)lo % pagesize) % pagesize;
+        hi -= (npy_intp)hi % pagesize;
+    }
+    else
+#endif
+    {
+        lo -= (npy_intp)lo % pagesize;
+        hi += (pagesize - (npy_intp)hi % pagesize) % pagesize;
+    }
+    if (lo >= hi) {
+        Py_RETURN_FALSE;
+    }
+    if (madvise(lo, hi - lo, mode) != 0) {
+        Py_RETURN_FALSE;
+    }
+    Py_RETURN_TRUE;
+#else
+    Py_RETURN_FALSE;
+#endif
+}
+
+/*
+ * _block_assemble(out, offsets, arrays)
+ *
+ * Assembly step of np.block: copy each source array into its
+ * destination slice of 'out' in one C pass.  The Python planner has
+ * already computed the final shape and, per source, the byte offset of
+ * its slice; a basic slice shares the parent's strides, so the
+ * destination view is reconstructed here from the offset, the source
+ * shape and out's strides, without materializing index tuples or any
+ * intermediate arrays.  Sources must already have out's dimensionality
+ * and fit inside it.
+ */
+static PyObject *
+array__block_assemble(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyArrayObject *out;
+    PyObject *offsets_obj, *arrays_obj;
+    PyObject *offsets_seq = NULL, *arrays_seq = NULL;
+    npy_intp nbytes_out, i, n;
+    int idim, ndim;
+
+    if (!PyArg_ParseTuple(args, "O!OO:_block_assemble",
+                          &PyArray_Type, &out, &offsets_obj, &arrays_obj)) {
+        return NULL;
+    }
+    offsets_seq = PySequence_Fast(offsets_obj,
+                                  "offsets must be a sequence");
+    if (offsets_seq == NULL) {
+        return NULL;
+    }
+    arrays_seq = PySequence_Fast(arrays_obj, "arrays must be a sequence");
+    if (arrays_seq == NULL) {
+        Py_DECREF(offsets_seq);
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(offsets_seq);
+    if (n != PySequence_Fast_GET_SIZE(arrays_seq)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "offsets and arrays must have the same length");
+        goto fail;
+    }
+    ndim = PyArray_NDIM(out);
+    nbytes_out = PyArray_NBYTES(out);
+
+    for (i = 0; i < n; i++) {
+        PyObject *arr_obj = PySequence_Fast_GET_ITEM(arrays_seq, i);
+        PyArrayObject *arr, *dst;
+        npy_intp offset, extent;
+        int ret;
+
+        offset = PyArray_PyIntAsIntp(
+                PySequence_Fast_GET_ITEM(offsets_seq, i));
+        if (error_converting(offset)) {
+            goto fail;
+        }
+        if (!PyArray_Check(arr_obj)) {
+            PyErr_SetString(PyExc_TypeError,
+                            "arrays must contain only ndarrays");
+            goto fail;
+        }
+        arr = (PyArrayObject *)arr_obj;
+        if (PyArray_NDIM(arr) != ndim) {
+            PyErr_SetString(PyExc_ValueError,
+                            "source dimensionality does not match out");
+            goto fail;
+        }
+
+        /* the slice must lie inside out (fresh arrays: strides >= 0) */
+        extent = PyArray_DESCR(out)->elsize;
+        for (idim = 0; idim < ndim; idim++) {
+            if (PyArray_DIM(arr, idim) > PyArray_DIM(out, idim)) {
+                PyErr_SetString(PyExc_ValueError,
+                                "source extends beyond out");
+                goto fail;
+            }
+            if (PyArray_DIM(arr, idim) > 0) {
+                extent += (PyArray_DIM(arr, idim) - 1) *
+                          PyArray_STRIDE(out, idim);
+            }
+        }
+        if (offset < 0 || (PyArray_SIZE(arr) > 0 &&
+                           offset + extent > nbytes_out)) {
+            PyErr_SetString(PyExc_ValueError,
+                            "slice offset outside of out");
+            goto fail;
+        }
+
+        Py_INCREF(PyArray_DESCR(out));
+        dst = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+                PyArray_DESCR(out), ndim, PyArray_DIMS(arr),
+                PyArray_STRIDES(out), PyArray_BYTES(out) + offset,
+                NPY_ARRAY_WRITEABLE, NULL);
+        if (dst == NULL) {
+            goto fail;
+        }
+        /* same casting behavior as result[slices] = arr */
+        ret = PyArray_AssignArray(dst, arr, NULL, NPY_UNSAFE_CASTING);
+        Py_DECREF(dst);
+        if (ret < 0) {
+            goto fail;
+        }
+    }
+    Py_DECREF(offsets_seq);
+    Py_DECREF(arrays_seq);
+    Py_RETURN_NONE;
+
+fail:
+    Py_DECREF(offsets_seq);
+    Py_DECREF(arrays_seq);
+    return NULL;
+}
+
+/*
+ * _roll_contiguous(a, shift)
+ *
+ * Roll the last axis of a C-contiguous array by 'shift' positions into
+ * a new array.  Each row is two block copies — the tail of the row to
+ * the front of the destination row and vice versa — instead of the
+ * sliced gather np.roll performs in Python, and the blocks run on the
+ * assignment copy engine.  np.roll routes here when the only nonzero
+ * shift is on the last axis and the dtype holds no references.
+ */
+static PyObject *
+array__roll_contiguous(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyArrayObject *a, *ret;
+    PyObject *shift_obj;
+    npy_block_copy_spec *blocks;
+    npy_intp shift, n, nrows, i, nblocks;
+    npy_intp rowbytes, splitbytes, shiftbytes;
+    char *src, *dst;
+
+    if (!PyArg_ParseTuple(args, "O!O:_roll_contiguous",
+                          &PyArray_Type, &a, &shift_obj)) {
+        return NULL;
+    }
+    shift = PyArray_PyIntAsIntp(shift_obj);
+    if (error_converting(shift)) {
+        return NULL;
+    }
+    if (PyArray_NDIM(a) == 0 || !PyArray_ISCARRAY_RO(a) ||
+            PyDataType_REFCHK(PyArray_DESCR(a))) {
+        PyErr_SetString(PyExc_ValueError,
+                "_roll_contiguous needs a C-contiguous array of a "
+                "dtype without references");
+        return NULL;
+    }
+    ret = (PyArrayObject *)PyArray_NewLikeArray(a, NPY_CORDER, NULL, 0);
+    if (ret == NULL) {
+        return NULL;
+    }
+    n = PyArray_DIM(a, PyArray_NDIM(a) - 1);
+    if (n == 0 || PyArray_SIZE(a) == 0) {
+        return (PyObject *)ret;
+    }
+    shift %= n;
+    if (shift < 0) {
+        shift += n;
+    }
+    nrows = PyArray_SIZE(a) / n;
+    rowbytes = n * PyArray_DESCR(a)->elsize;
+    shiftbytes = shift * PyArray_DESCR(a)->elsize;
+    splitbytes = rowbytes - shiftbytes;
+
+    blocks = PyArray_malloc(2 * nrows * sizeof(npy_block_copy_spec));
+    if (blocks == NULL) {
+        Py_DECREF(ret);
+        return PyErr_NoMemory();
+    }
+    src = PyArray_BYTES(a);
+    dst = PyArray_BYTES(ret);
+    nblocks = 0;
+    for (i = 0; i < nrows; i++) {
+        blocks[nblocks].dst = dst + shiftbytes;
+        blocks[nblocks].src = src;
+        blocks[nblocks].nbytes = splitbytes;
+        nblocks++;
+        if (shiftbytes > 0) {
+            blocks[nblocks].dst = dst;
+            blocks[nblocks].src = src + splitbytes;
+            blocks[nblocks].nbytes = shiftbytes;
+            nblocks++;
+        }
+        src += rowbytes;
+        dst += rowbytes;
+    }
+    npy_parallel_block_copy(blocks, nblocks);
+    PyArray_free(blocks);
+
+    return (PyObject *)ret;
+}
+
+/*
+ * _sliding_window_view(x, window_shape, axis=None, writeable=False)
+ *
+ * Zero-copy sliding-window view with the window axes appended after
+ * the array axes; the geometry and its bounds argument live in
+ * PyArray_SlidingWindowView.  With axis=None the window shape covers
+ * every axis in order.  The result is read-only unless 'writeable' is
+ * set, since the windows overlap in memory.
+ */
+static PyObject *
+array__sliding_window_view(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                           PyObject *kwds)
+{
+    static char *kwlist[] = {"x", "window_shape", "axis", "writeable", NULL};
+    PyArrayObject *a = NULL;
+    PyObject *axis_obj = Py_None, *ret = NULL;
+    PyArray_Dims window = {NULL, 0};
+    PyArray_Dims axis = {NULL, 0};
+    int axes[NPY_MAXDIMS];
+    int k, writeable = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds,
+                "O&O&|Oi:_sliding_window_view", kwlist,
+                PyArray_Converter, &a,
+                PyArray_IntpConverter, &window,
+                &axis_obj, &writeable)) {
+        return NULL;
+    }
+    if (axis_obj == Py_None) {
+        if (window.len != PyArray_NDIM(a)) {
+            PyErr_SetString(PyExc_ValueError,
+                    "window_shape must match the array dimensionality "
+                    "when axis is not given");
+            goto finish;
+        }
+        for (k = 0; k < window.len; k++) {
+            axes[k] = k;
+        }
+    }
+    else {
+        if (!PyArray_IntpConverter(axis_obj, &axis)) {
+            goto finish;
+        }
+        if (axis.len != window.len) {
+            PyErr_SetString(PyExc_ValueError,
+                    "window_shape and axis must have the same length");
+            goto finish;
+        }
+        for (k = 0; k < axis.len; k++) {
+            int ax = (int)axis.ptr[k];
+
+            if (check_and_adjust_axis(&ax, PyArray_NDIM(a)) < 0) {
+                goto finish;
+            }
+            axes[k] = ax;
+        }
+    }
+    ret = PyArray_SlidingWindowView(a, window.ptr, axes, (int)window.len);
+    if (ret != NULL && !writeable) {
+        PyArray_CLEARFLAGS((PyArrayObject *)ret, NPY_ARRAY_WRITEABLE);
+    }
+
+finish:
+    Py_DECREF(a);
+    npy_free_cache_dim_obj(window);
+    npy_free_cache_dim_obj(axis);
+    return ret;
+}
+
+/* Internal view into 'out' used by the pad engine below */
+static PyArrayObject *
+pad_engine_view(PyArrayObject *out, npy_intp *dims, npy_intp *strides,
+                npy_intp offset)
+{
+    return (PyArrayObject *)PyArray_NewViewFromBase(out, PyArray_NDIM(out),
+            dims, strides, PyArray_BYTES(out) + offset);
+}
+
+/*
+ * _pad_engine(a, pad_width, mode, value=None)
+ *
+ * Single-allocation pad: the destination is allocated once, the source
+ * is copied into the interior, and the border slabs of each axis are
+ * filled in place over the full extent of the other axes.  Since every
+ * pad cell lies in the slab of at least one axis and axes are processed
+ * in order, the slabs of a later axis overwrite whatever corner data an
+ * earlier axis replicated, so no intermediates are needed.  'pad_width'
+ * is the flattened (before, after) sequence, one pair per axis; 'mode'
+ * is "constant" (fills with 'value'), "edge" or "reflect".  The reflect
+ * mode handles a single reflection only — np.pad keeps its iterative
+ * path for pads longer than the axis — and mirrors without including
+ * the edge, matching reflect_type='even'.
+ */
+static PyObject *
+array__pad_engine(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                  PyObject *kwds)
+{
+    static char *kwlist[] = {"a", "pad_width", "mode", "value", NULL};
+    PyArrayObject *a, *out = NULL, *view, *src;
+    PyObject *value = NULL;
+    PyArray_Dims width = {NULL, 0};
+    const char *mode_str;
+    npy_intp dims[NPY_MAXDIMS], vdims[NPY_MAXDIMS];
+    npy_intp vstrides[NPY_MAXDIMS], offset;
+    int i, axis, ndim, mode, ret;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O&s|O:_pad_engine",
+                kwlist, &PyArray_Type, &a,
+                PyArray_IntpConverter, &width, &mode_str, &value)) {
+        return NULL;
+    }
+    if (strcmp(mode_str, "constant") == 0) {
+        mode = 0;
+    }
+    else if (strcmp(mode_str, "edge") == 0) {
+        mode = 1;
+    }
+    else if (strcmp(mode_str, "reflect") == 0) {
+        mode = 2;
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                "_pad_engine does not implement mode '%s'", mode_str);
+        goto fail;
+    }
+    ndim = PyArray_NDIM(a);
+    if (width.len != 2 * ndim || ndim == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "pad_width must hold one (before, after) pair per axis");
+        goto fail;
+    }
+    if (mode == 0 && value == NULL) {
+        PyErr_SetString(PyExc_ValueError,
+                "constant mode needs a fill value");
+        goto fail;
+    }
+    for (i = 0; i < ndim; i++) {
+        npy_intp before = width.ptr[2 * i];
+        npy_intp after = width.ptr[2 * i + 1];
+
+        if (before < 0 || after < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "pad widths cannot be negative");
+            goto fail;
+        }
+        if (mode == 2 && (before || after) &&
+                (before > PyArray_DIM(a, i) - 1 ||
+                 after > PyArray_DIM(a, i) - 1)) {
+            PyErr_SetString(PyExc_ValueError,
+                    "reflect mode of _pad_engine handles a single "
+                    "reflection only");
+            goto fail;
+        }
+        dims[i] = PyArray_DIM(a, i) + before + after;
+    }
+    out = (PyArrayObject *)PyArray_NewLikeArrayWithShape(a, NPY_CORDER,
+                                                         NULL, ndim, dims, 0);
+    if (out == NULL) {
+        goto fail;
+    }
+
+    /* the interior: source shape at the per-axis 'before' offsets */
+    offset = 0;
+    for (i = 0; i < ndim; i++) {
+        offset += width.ptr[2 * i] * PyArray_STRIDE(out, i);
+    }
+    view = pad_engine_view(out, PyArray_DIMS(a), PyArray_STRIDES(out),
+                           offset);
+    if (view == NULL) {
+        goto fail;
+    }
+    ret = PyArray_AssignArray(view, a, NULL, NPY_UNSAFE_CASTING);
+    Py_DECREF(view);
+    if (ret < 0) {
+        goto fail;
+    }
+
+    for (axis = 0; axis < ndim; axis++) {
+        npy_intp before = width.ptr[2 * axis];
+        npy_intp after = width.ptr[2 * axis + 1];
+        npy_intp stride = PyArray_STRIDE(out, axis);
+        int side;
+
+        memcpy(vdims, PyArray_DIMS(out), ndim * sizeof(npy_intp));
+        memcpy(vstrides, PyArray_STRIDES(out), ndim * sizeof(npy_intp));
+        for (side = 0; side < 2; side++) {
+            npy_intp w = side ? after : before;
+
+            if (w == 0) {
+                continue;
+            }
+            vdims[axis] = w;
+            offset = side ? (dims[axis] - after) * stride : 0;
+            view = pad_engine_view(out, vdims, vstrides, offset);
+            if (view == NULL) {
+                goto fail;
+            }
+            if (mode == 0) {
+                ret = PyArray_FillWithScalar(view, value);
+            }
+            else if (mode == 1) {
+                /* broadcast the boundary slice over the slab */
+                vdims[axis] = 1;
+                offset = side ? (dims[axis] - after - 1) * stride
+                              : before * stride;
+                src = pad_engine_view(out, vdims, vstrides, offset);
+                vdims[axis] = w;
+                if (src == NULL) {
+                    Py_DECREF(view);
+                    goto fail;
+                }
+                ret = PyArray_AssignArray(view, src, NULL,
+                                          NPY_UNSAFE_CASTING);
+                Py_DECREF(src);
+            }
+            else {
+                /*
+                 * Mirror about the boundary element without including
+                 * it: pad cell at distance d copies the valid cell at
+                 * distance d on the other side, which the width checks
+                 * above keep inside the already-filled region.
+                 */
+                vstrides[axis] = -stride;
+                offset = side ? (dims[axis] - after - 2) * stride
+                              : 2 * before * stride;
+                src = pad_engine_view(out, vdims, vstrides, offset);
+                vstrides[axis] = stride;
+                if (src == NULL) {
+                    Py_DECREF(view);
+                    goto fail;
+                }
+                ret = PyArray_AssignArray(view, src, NULL,
+                                          NPY_UNSAFE_CASTING);
+                Py_DECREF(src);
+            }
+            Py_DECREF(view);
+            if (ret < 0) {
+                goto fail;
+            }
+        }
+    }
+    npy_free_cache_dim_obj(width);
+    return (PyObject *)out;
+
+fail:
+    Py_XDECREF(out);
+    npy_free_cache_dim_obj(width);
+    return NULL;
+}
+
+/*
+ * _linspace(start, stop, num, endpoint=True)
+ *
+ * One-pass float64 linspace kernel for scalar endpoints.  Follows the
+ * arithmetic of the Python implementation exactly — i*step + start per
+ * element, the (i/div)*delta form when the step underflows to zero,
+ * and the final element pinned to 'stop' when the endpoint is included
+ * — so the fast path is a pure no-op for results.  np.linspace only
+ * routes plain double scalars on the default axis here.
+ */
+static PyObject *
+array__linspace(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"start", "stop", "num", "endpoint", NULL};
+    PyArrayObject *ret;
+    double start, stop, delta, step;
+    npy_intp num, div, i;
+    double *data;
+    int endpoint = 1;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "ddn|i:_linspace", kwlist,
+                                     &start, &stop, &num, &endpoint)) {
+        return NULL;
+    }
+    if (num < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "number of samples must be non-negative");
+        return NULL;
+    }
+    ret = (PyArrayObject *)PyArray_SimpleNew(1, &num, NPY_DOUBLE);
+    if (ret == NULL) {
+        return NULL;
+    }
+    data = (double *)PyArray_DATA(ret);
+    if (num == 0) {
+        return (PyObject *)ret;
+    }
+    if (num == 1) {
+        data[0] = start;
+        return (PyObject *)ret;
+    }
+    div = endpoint ? num - 1 : num;
+    delta = stop - start;
+    step = delta / div;
+
+    NPY_BEGIN_THREADS_THRESHOLDED(num);
+    if (step != 0) {
+        for (i = 0; i < num; i++) {
+            data[i] = start + i * step;
+        }
+    }
+    else {
+        /* denormal steps: divide first like the Python path, gh-5437 */
+        for (i = 0; i < num; i++) {
+            data[i] = start + (i / (double)div) * delta;
+        }
+    }
+    NPY_END_THREADS;
+    if (endpoint) {
+        data[num - 1] = stop;
+    }
+    return (PyObject *)ret;
+}
+
+/*
+ * _ravel_view(a, order='C')
+ *
+ * Try-view-or-None flatten probe: returns a contiguous 1-d view of 'a'
+ * when its buffer is already contiguous in the requested order, and
+ * None otherwise — never a copy and never an exception, so dispatch
+ * layers can test "is a zero-copy flat view possible" cheaply.
+ * Subclasses return None as well since the header-only constructor
+ * cannot run __array_finalize__.
+ */
+static PyObject *
+array__ravel_view(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyArrayObject *a;
+    npy_intp size, stride;
+    NPY_ORDER order = NPY_CORDER;
+
+    if (!PyArg_ParseTuple(args, "O!|O&:_ravel_view", &PyArray_Type, &a,
+                          PyArray_OrderConverter, &order)) {
+        return NULL;
+    }
+    if (Py_TYPE(a) != &PyArray_Type) {
+        Py_RETURN_NONE;
+    }
+    if (!((order == NPY_CORDER && PyArray_IS_C_CONTIGUOUS(a)) ||
+          (order == NPY_FORTRANORDER && PyArray_IS_F_CONTIGUOUS(a)) ||
+          (order == NPY_ANYORDER &&
+           (PyArray_IS_C_CONTIGUOUS(a) || PyArray_IS_F_CONTIGUOUS(a))))) {
+        Py_RETURN_NONE;
+    }
+    size = PyArray_SIZE(a);
+    stride = PyArray_ITEMSIZE(a);
+    return PyArray_NewViewFromBase(a, 1, &size, &stride, PyArray_BYTES(a));
+}
+
+/*
+ * _expand_dims_view(a, axis)
+ *
+ * Header-only expand_dims: insert one length-one axis at 'axis' and
+ * return the view, or None for subclasses (which need the general
+ * reshape so __array_finalize__ runs).  The unit axis gets the stride
+ * that keeps a C-contiguous input C-contiguous; for any input the
+ * value is cosmetic since the axis is never stepped.
+ */
+static PyObject *
+array__expand_dims_view(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyArrayObject *a;
+    npy_intp dims[NPY_MAXDIMS], strides[NPY_MAXDIMS];
+    int i, axis, ndim;
+
+    if (!PyArg_ParseTuple(args, "O!i:_expand_dims_view",
+                          &PyArray_Type, &a, &axis)) {
+        return NULL;
+    }
+    if (Py_TYPE(a) != &PyArray_Type) {
+        Py_RETURN_NONE;
+    }
+    ndim = PyArray_NDIM(a);
+    if (ndim >= NPY_MAXDIMS) {
+        /* the reshape fallback raises the usual error */
+        Py_RETURN_NONE;
+    }
+    if (check_and_adjust_axis(&axis, ndim + 1) < 0) {
+        return NULL;
+    }
+    for (i = 0; i < axis; i++) {
+        dims[i] = PyArray_DIM(a, i);
+        strides[i] = PyArray_STRIDE(a, i);
+    }
+    dims[axis] = 1;
+    strides[axis] = (axis < ndim) ?
+            PyArray_STRIDE(a, axis) * PyArray_DIM(a, axis) :
+            PyArray_ITEMSIZE(a);
+    for (i = axis; i < ndim; i++) {
+        dims[i + 1] = PyArray_DIM(a, i);
+        strides[i + 1] = PyArray_STRIDE(a, i);
+    }
+    return PyArray_NewViewFromBase(a, ndim + 1, dims, strides,
+                                   PyArray_DATA(a));
+}
+
+/*
+ * _page_residency(a, regions=32)
+ *
+ * Sample which of the pages backing an ndarray are resident, to show
+ * where an out-of-core job thrashes.  The byte extent of the array is
+ * rounded outward to page boundaries and split into at most 'regions'
+ * page-aligned regions; returns a list of (total_pages,
+ * resident_pages) pairs as reported by mincore.  Any array can be
+ * sampled, but the result is only meaningful for mmap-backed ones,
+ * where it shows which parts of the file are currently cached.
+ * Returns None on platforms without mincore.  Process-wide fault
+ * counters to correlate a run with come from _fault_counts.
+ */
+static PyObject *
+array__page_residency(PyObject *NPY_UNUSED(dummy), PyObject *args,
+                      PyObject *kwds)
+{
+#ifdef __linux__
+    static char *kwlist[] = {"a", "regions", NULL};
+    PyArrayObject *arr;
+    int regions = 32;
+    char *lo, *hi;
+    npy_intp pagesize, npages, per_region, start, i;
+    unsigned char *vec;
+    PyObject *list;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|i:_page_residency",
+                                     kwlist, PyArray_Converter, &arr,
+                                     &regions)) {
+        return NULL;
+    }
+    if (regions < 1) {
+        Py_DECREF(arr);
+        PyErr_SetString(PyExc_ValueError,
+                        "regions must be at least one");
+        return NULL;
+    }
+
+    /* byte extent of the array; strides may point either way */
+    lo = hi = (char *)PyArray_DATA(arr);
+    for (i = 0; i < PyArray_NDIM(arr); i++) {
+        npy_intp ext = (PyArray_DIM(arr, i) - 1) * PyArray_STRIDE(arr, i);
+
+        if (ext < 0) {
+            lo += ext;
+        }
+        else {
+            hi += ext;
+        }
+    }
+    hi += PyArray_DESCR(arr)->elsize;
+    if (PyArray_SIZE(arr) == 0) {
+        hi = lo;
+    }
+    Py_DECREF(arr);
+
+    pagesize = (npy_intp)sysconf(_SC_PAGESIZE);
+    lo -= (npy_intp)lo % pagesize;
+    hi += (pagesize - (npy_intp)hi % pagesize) % pagesize;
+    npages = (hi - lo) / pagesize;
+    if (npages == 0) {
+        return PyList_New(0);
+    }
+
+    vec = PyArray_malloc(npages);
+    if (vec == NULL) {
+        return PyErr_NoMemory();
+    }
+    if (mincore(lo, hi - lo, vec) != 0) {
+        PyArray_free(vec);
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+
+    list = PyList_New(0);
+    if (list == NULL) {
+        PyArray_free(vec);
+        return NULL;
+    }
+    per_region = (npages + regions - 1) / regions;
+    for (start = 0; start < npages; start += per_region) {
+        npy_intp stop = start + per_region;
+        npy_intp resident = 0;
+        PyObject *item;
+
+        if (stop > npages) {
+            stop = npages;
+        }
+        for (i = start; i < stop; i++) {
+            /* only the low bit of the mincore vector is defined */
+            resident += vec[i] & 1;
+        }
+        item = Py_BuildValue("(nn)", (Py_ssize_t)(stop - start),
+                             (Py_ssize_t)resident);
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            PyArray_free(vec);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    PyArray_free(vec);
+    return list;
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
+/*
+ * _fault_counts()
+ *
+ * Returns the process-wide (minor, major) page fault counts from
+ * getrusage.  Differencing them around an operation shows whether a
+ * slow pass over a memory-mapped array actually went to disk.
+ */
+static PyObject *
+array__fault_counts(PyObject *NPY_UNUSED(dummy), PyObject *NPY_UNUSED(args))
+{
+#ifndef _WIN32
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+    return Py_BuildValue("(ll)", usage.ru_minflt, usage.ru_majflt);
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
+/*
+ * _encode_utf8(arr)
+ *
+ * Transcode a unicode array to UTF-8 in one pass.  Returns a tuple
+ * (data, offsets): data is a bytes object holding the UTF-8 of every
+ * element concatenated in C order, with trailing NUL padding stripped
+ * like item access does; offsets is an int64 array of length n+1 so
+ * that element i is data[offsets[i]:offsets[i+1]].
+ */
+static PyObject *
+array__encode_utf8(PyObject *NPY_UNUSED(dummy), PyObject *args)
 {
-    PyObject *file = NULL, *ret;
-    PyObject *err_type = NULL, *err_value = NULL, *err_traceback = NULL;
-    char *sep = "";
-    Py_ssize_t nin = -1;
-    static char *kwlist[] = {"file", "dtype", "count", "sep", NULL};
-    PyArray_Descr *type = NULL;
-    int own;
-    npy_off_t orig_pos = 0;
-    FILE *fp;
-
-    if (!PyArg_ParseTupleAndKeywords(args, keywds,
-                "O|O&" NPY_SSIZE_T_PYFMT "s:fromfile", kwlist,
-                &file, PyArray_DescrConverter, &type, &nin, &sep)) {
-        Py_XDECREF(type);
+    PyObject *obj;
+    PyArrayObject *arr = NULL, *offsets = NULL;
+    PyObject *data = NULL;
+    const npy_ucs4 *ucs;
+    npy_int64 *off;
+    npy_intp n, maxchars, i, total, odims, bad = -1;
+    char *p;
+
+    if (!PyArg_ParseTuple(args, "O:_encode_utf8", &obj)) {
         return NULL;
     }
-    if (PyString_Check(file) || PyUnicode_Check(file)) {
-        file = npy_PyFile_OpenFile(file, "rb");
-        if (file == NULL) {
+    arr = (PyArrayObject *)PyArray_FROM_OF(obj,
+            NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS);
+    if (arr == NULL) {
+        return NULL;
+    }
+    if (PyArray_TYPE(arr) != NPY_UNICODE) {
+        PyErr_SetString(PyExc_TypeError,
+                "_encode_utf8 requires an array of unicode strings");
+        goto fail;
+    }
+    if (!PyArray_ISNOTSWAPPED(arr)) {
+        PyArray_Descr *descr = PyArray_DescrNewByteorder(
+                PyArray_DESCR(arr), NPY_NATIVE);
+        PyArrayObject *tmp;
+
+        if (descr == NULL) {
+            goto fail;
+        }
+        tmp = (PyArrayObject *)PyArray_FromArray(arr, descr,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_C_CONTIGUOUS);
+        Py_DECREF(arr);
+        arr = tmp;
+        if (arr == NULL) {
             return NULL;
         }
-        own = 1;
     }
-    else {
-        Py_INCREF(file);
-        own = 0;
+    n = PyArray_SIZE(arr);
+    maxchars = PyArray_DESCR(arr)->elsize / 4;
+    odims = n + 1;
+    offsets = (PyArrayObject *)PyArray_SimpleNew(1, &odims, NPY_INT64);
+    if (offsets == NULL) {
+        goto fail;
     }
-    fp = npy_PyFile_Dup2(file, "rb", &orig_pos);
-    if (fp == NULL) {
-        Py_DECREF(file);
-        return NULL;
+    ucs = (const npy_ucs4 *)PyArray_DATA(arr);
+    off = (npy_int64 *)PyArray_DATA(offsets);
+    off[0] = 0;
+    total = 0;
+
+    NPY_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < n; i++) {
+        const npy_ucs4 *el = ucs + i * maxchars;
+        npy_intp len = maxchars, nb;
+
+        while (len > 0 && el[len - 1] == 0) {
+            len--;
+        }
+        nb = npy_utf8_encoded_size(el, len);
+        if (nb < 0) {
+            bad = i;
+            break;
+        }
+        total += nb;
+        off[i + 1] = total;
     }
-    if (type == NULL) {
-        type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
+    NPY_END_ALLOW_THREADS;
+    if (bad >= 0) {
+        PyErr_Format(PyExc_ValueError,
+                "element %" NPY_INTP_FMT " contains a code point above "
+                "0x10FFFF that UTF-8 cannot represent", bad);
+        goto fail;
     }
-    ret = PyArray_FromFile(fp, type, (npy_intp) nin, sep);
 
-    /* If an exception is thrown in the call to PyArray_FromFile
-     * we need to clear it, and restore it later to ensure that
-     * we can cleanup the duplicated file descriptor properly.
-     */
-    PyErr_Fetch(&err_type, &err_value, &err_traceback);
-    if (npy_PyFile_DupClose2(file, fp, orig_pos) < 0) {
-        npy_PyErr_ChainExceptions(err_type, err_value, err_traceback);
+    data = PyBytes_FromStringAndSize(NULL, total);
+    if (data == NULL) {
         goto fail;
     }
-    if (own && npy_PyFile_CloseFile(file) < 0) {
-        npy_PyErr_ChainExceptions(err_type, err_value, err_traceback);
-        goto fail;
+    p = PyBytes_AS_STRING(data);
+    NPY_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < n; i++) {
+        const npy_ucs4 *el = ucs + i * maxchars;
+        npy_intp len = maxchars;
+
+        while (len > 0 && el[len - 1] == 0) {
+            len--;
+        }
+        npy_utf8_encode_ucs4(el, len, p + off[i]);
     }
-    PyErr_Restore(err_type, err_value, err_traceback);
-    Py_DECREF(file);
-    return ret;
+    NPY_END_ALLOW_THREADS;
+
+    Py_DECREF(arr);
+    return Py_BuildValue("NN", data, offsets);
 
 fail:
-    Py_DECREF(file);
-    Py_XDECREF(ret);
+    Py_XDECREF(arr);
+    Py_XDECREF(offsets);
+    Py_XDECREF(data);
     return NULL;
 }
 
+/*
+ * _decode_utf8(data, offsets, chars=0)
+ *
+ * Inverse of _encode_utf8: decode a concatenated UTF-8 buffer delimited
+ * by offsets into a 1-d unicode array.  chars fixes the element width
+ * (as in 'U<chars>'); 0 sizes it from the longest element.
+ */
 static PyObject *
-array_fromiter(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
+array__decode_utf8(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
 {
-    PyObject *iter;
-    Py_ssize_t nin = -1;
-    static char *kwlist[] = {"iter", "dtype", "count", NULL};
-    PyArray_Descr *descr = NULL;
+    static char *kwlist[] = {"data", "offsets", "chars", NULL};
+    PyObject *data_obj, *offsets_obj;
+    PyArrayObject *offsets = NULL, *ret = NULL;
+    PyArray_Descr *descr;
+    char *buf;
+    Py_ssize_t buflen;
+    npy_int64 *off;
+    npy_intp chars = 0, maxchars, n, i, bad = -1, badlen = 0;
+    npy_ucs4 *out;
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds,
-                "OO&|" NPY_SSIZE_T_PYFMT ":fromiter", kwlist,
-                &iter, PyArray_DescrConverter, &descr, &nin)) {
-        Py_XDECREF(descr);
+    if (!PyArg_ParseTupleAndKeywords(args, kwds,
+                "OO|" NPY_SSIZE_T_PYFMT ":_decode_utf8", kwlist,
+                &data_obj, &offsets_obj, &chars)) {
         return NULL;
     }
-    return PyArray_FromIter(iter, descr, (npy_intp)nin);
-}
+    if (PyBytes_AsStringAndSize(data_obj, &buf, &buflen) < 0) {
+        return NULL;
+    }
+    offsets = (PyArrayObject *)PyArray_ContiguousFromAny(
+            offsets_obj, NPY_INT64, 1, 1);
+    if (offsets == NULL) {
+        return NULL;
+    }
+    if (PyArray_SIZE(offsets) < 1) {
+        PyErr_SetString(PyExc_ValueError,
+                "offsets must hold at least one entry");
+        goto fail;
+    }
+    if (chars < 0) {
+        PyErr_SetString(PyExc_ValueError, "chars must be non-negative");
+        goto fail;
+    }
+    n = PyArray_SIZE(offsets) - 1;
+    off = (npy_int64 *)PyArray_DATA(offsets);
+    for (i = 0; i < n; i++) {
+        if (off[i] < 0 || off[i + 1] < off[i] || off[i + 1] > buflen) {
+            PyErr_Format(PyExc_ValueError,
+                    "offsets are not non-decreasing within the buffer "
+                    "at element %" NPY_INTP_FMT, i);
+            goto fail;
+        }
+    }
 
-static PyObject *
-array_frombuffer(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *keywds)
-{
-    PyObject *obj = NULL;
-    Py_ssize_t nin = -1, offset = 0;
-    static char *kwlist[] = {"buffer", "dtype", "count", "offset", NULL};
-    PyArray_Descr *type = NULL;
+    maxchars = chars;
+    if (chars == 0) {
+        /* sizing pass: validate and find the longest element */
+        NPY_BEGIN_ALLOW_THREADS;
+        for (i = 0; i < n; i++) {
+            npy_intp len = npy_utf8_decode_ucs4(buf + off[i],
+                    (npy_intp)(off[i + 1] - off[i]), NULL, -1);
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds,
-                "O|O&" NPY_SSIZE_T_PYFMT NPY_SSIZE_T_PYFMT ":frombuffer", kwlist,
-                &obj, PyArray_DescrConverter, &type, &nin, &offset)) {
-        Py_XDECREF(type);
-        return NULL;
+            if (len < 0) {
+                bad = i;
+                break;
+            }
+            if (len > maxchars) {
+                maxchars = len;
+            }
+        }
+        NPY_END_ALLOW_THREADS;
+        if (bad >= 0) {
+            PyErr_Format(PyExc_ValueError,
+                    "element %" NPY_INTP_FMT " is not valid UTF-8", bad);
+            goto fail;
+        }
+        if (maxchars == 0) {
+            /* all elements empty; 'U0' arrays are not representable */
+            maxchars = 1;
+        }
     }
-    if (type == NULL) {
-        type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
+
+    descr = PyArray_DescrNewFromType(NPY_UNICODE);
+    if (descr == NULL) {
+        goto fail;
     }
-    return PyArray_FromBuffer(obj, type, (npy_intp)nin, (npy_intp)offset);
-}
+    descr->elsize = (int)(maxchars * 4);
+    ret = (PyArrayObject *)PyArray_NewFromDescr(
+            &PyArray_Type, descr, 1, &n, NULL, NULL, 0, NULL);
+    if (ret == NULL) {
+        goto fail;
+    }
+    out = (npy_ucs4 *)PyArray_DATA(ret);
+    memset(out, 0, n * maxchars * 4);
 
-static PyObject *
-array_concatenate(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
-{
-    PyObject *a0;
-    PyObject *out = NULL;
-    int axis = 0;
-    static char *kwlist[] = {"seq", "axis", "out", NULL};
+    NPY_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < n; i++) {
+        npy_intp len = npy_utf8_decode_ucs4(buf + off[i],
+                (npy_intp)(off[i + 1] - off[i]),
+                out + i * maxchars, maxchars);
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&O:concatenate", kwlist,
-                &a0, PyArray_AxisConverter, &axis, &out)) {
-        return NULL;
+        if (len < 0) {
+            bad = i;
+            badlen = len;
+            break;
+        }
     }
-    if (out != NULL) {
-        if (out == Py_None) {
-            out = NULL;
+    NPY_END_ALLOW_THREADS;
+    if (bad >= 0) {
+        if (badlen == -2) {
+            PyErr_Format(PyExc_ValueError,
+                    "element %" NPY_INTP_FMT " does not fit in %"
+                    NPY_INTP_FMT " characters", bad, maxchars);
         }
-        else if (!PyArray_Check(out)) {
-            PyErr_SetString(PyExc_TypeError, "'out' must be an array");
-            return NULL;
+        else {
+            PyErr_Format(PyExc_ValueError,
+                    "element %" NPY_INTP_FMT " is not valid UTF-8", bad);
         }
+        goto fail;
     }
-    return PyArray_ConcatenateInto(a0, axis, (PyArrayObject *)out);
+
+    Py_DECREF(offsets);
+    return (PyObject *)ret;
+
+fail:
+    Py_DECREF(offsets);
+    Py_XDECREF(ret);
+    return NULL;
 }
 
+/*
+ * _take_along_axis(arr, indices, axis)
+ *
+ * Native along-axis gather; np.take_along_axis dispatches here when
+ * the operands fit the C kernel and falls back to fancy indexing
+ * otherwise.
+ */
 static PyObject *
-array_innerproduct(PyObject *NPY_UNUSED(dummy), PyObject *args)
+array__take_along_axis(PyObject *NPY_UNUSED(dummy), PyObject *args)
 {
-    PyObject *b0, *a0;
+    PyObject *arr, *indices;
+    int axis;
 
-    if (!PyArg_ParseTuple(args, "OO:innerproduct", &a0, &b0)) {
+    if (!PyArg_ParseTuple(args, "O!O!i:_take_along_axis",
+                          &PyArray_Type, &arr,
+                          &PyArray_Type, &indices, &axis)) {
         return NULL;
     }
-    return PyArray_Return((PyArrayObject *)PyArray_InnerProduct(a0, b0));
+    return PyArray_TakeAlongAxis((PyArrayObject *)arr,
+                                 (PyArrayObject *)indices, axis);
 }
 
+/*
+ * _put_along_axis(arr, indices, values, axis)
+ *
+ * Native along-axis scatter backing np.put_along_axis.
+ */
 static PyObject *
-array_matrixproduct(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject* kwds)
+array__put_along_axis(PyObject *NPY_UNUSED(dummy), PyObject *args)
 {
-    PyObject *v, *a, *o = NULL;
-    PyArrayObject *ret;
-    char* kwlist[] = {"a", "b", "out", NULL };
+    PyObject *arr, *indices, *values;
+    int axis;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O:matrixproduct",
-                                     kwlist, &a, &v, &o)) {
+    if (!PyArg_ParseTuple(args, "O!O!O!i:_put_along_axis",
+                          &PyArray_Type, &arr,
+                          &PyArray_Type, &indices,
+                          &PyArray_Type, &values, &axis)) {
         return NULL;
     }
-    if (o != NULL) {
-        if (o == Py_None) {
-            o = NULL;
-        }
-        else if (!PyArray_Check(o)) {
-            PyErr_SetString(PyExc_TypeError, "'out' must be an array");
-            return NULL;
-        }
+    if (PyArray_PutAlongAxis((PyArrayObject *)arr,
+                             (PyArrayObject *)indices,
+                             (PyArrayObject *)values, axis) < 0) {
+        return NULL;
     }
-    ret = (PyArrayObject *)PyArray_MatrixProduct2(a, v, (PyArrayObject *)o);
-    return PyArray_Return(ret);
+    Py_RETURN_NONE;
 }
 
-
 static PyObject *
 array_vdot(PyObject *NPY_UNUSED(dummy), PyObject *args)
 {
@@ -2917,6 +4934,28 @@ array_set_datetimeparse_function(PyObject *NPY_UNUSED(self),
         } \
     } while(0)
 
+/*
+ * branchless select for contiguous operands: each element is blended
+ * with a sign-extended mask instead of a data-dependent branch, which
+ * the compiler can turn into vector blend instructions and which does
+ * not suffer mispredictions on unpredictable conditions.
+ */
+#define INNER_WHERE_BLEND(itype) \
+    do { \
+        npy_intp i; \
+        for (i = 0; i < n; i++) { \
+            itype xv, yv; \
+            memcpy(&xv, xsrc + i * sizeof(itype), sizeof(itype)); \
+            memcpy(&yv, ysrc + i * sizeof(itype), sizeof(itype)); \
+            xv = yv ^ ((xv ^ yv) & (itype)-(itype)(csrc[i] != 0)); \
+            memcpy(dst + i * sizeof(itype), &xv, sizeof(itype)); \
+        } \
+        dst += n * sizeof(itype); \
+        xsrc += n * sizeof(itype); \
+        ysrc += n * sizeof(itype); \
+        csrc += n; \
+    } while(0)
+
 
 /*NUMPY_API
  * Where
@@ -3010,8 +5049,28 @@ PyArray_Where(PyObject *condition, PyObject *x, PyObject *y)
                 char * xsrc = dataptrarray[2];
                 char * ysrc = dataptrarray[3];
 
+                /* all-contiguous native data can use the blend loop */
+                if (native && cstride == 1 &&
+                        xstride == itemsize && ystride == itemsize &&
+                        (itemsize == 1 || itemsize == 2 ||
+                         itemsize == 4 || itemsize == 8)) {
+                    switch (itemsize) {
+                        case 1:
+                            INNER_WHERE_BLEND(npy_uint8);
+                            break;
+                        case 2:
+                            INNER_WHERE_BLEND(npy_uint16);
+                            break;
+                        case 4:
+                            INNER_WHERE_BLEND(npy_uint32);
+                            break;
+                        default:
+                            INNER_WHERE_BLEND(npy_uint64);
+                            break;
+                    }
+                }
                 /* constant sizes so compiler replaces memcpy */
-                if (native && itemsize == 16) {
+                else if (native && itemsize == 16) {
                     INNER_WHERE_LOOP(16);
                 }
                 else if (native && itemsize == 8) {
@@ -4118,6 +6177,9 @@ static struct PyMethodDef array_module_methods[] = {
     {"count_nonzero",
         (PyCFunction)array_count_nonzero,
         METH_VARARGS|METH_KEYWORDS, NULL},
+    {"_topk",
+        (PyCFunction)array__topk,
+        METH_VARARGS|METH_KEYWORDS, NULL},
     {"empty",
         (PyCFunction)array_empty,
         METH_VARARGS|METH_KEYWORDS, NULL},
@@ -4151,6 +6213,60 @@ static struct PyMethodDef array_module_methods[] = {
     {"dot",
         (PyCFunction)array_matrixproduct,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_fused_dot",
+        (PyCFunction)array_fused_dot,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_outer_multiply",
+        (PyCFunction)array__outer_multiply,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_from_fd",
+        (PyCFunction)array__from_fd,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_madvise_range",
+        (PyCFunction)array__madvise_range,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_page_residency",
+        (PyCFunction)array__page_residency,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_block_assemble",
+        (PyCFunction)array__block_assemble,
+        METH_VARARGS, NULL},
+    {"_roll_contiguous",
+        (PyCFunction)array__roll_contiguous,
+        METH_VARARGS, NULL},
+    {"_sliding_window_view",
+        (PyCFunction)array__sliding_window_view,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_pad_engine",
+        (PyCFunction)array__pad_engine,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_linspace",
+        (PyCFunction)array__linspace,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_ravel_view",
+        (PyCFunction)array__ravel_view,
+        METH_VARARGS, NULL},
+    {"_expand_dims_view",
+        (PyCFunction)array__expand_dims_view,
+        METH_VARARGS, NULL},
+    {"_fault_counts",
+        (PyCFunction)array__fault_counts,
+        METH_NOARGS, NULL},
+    {"_encode_utf8",
+        (PyCFunction)array__encode_utf8,
+        METH_VARARGS, NULL},
+    {"_decode_utf8",
+        (PyCFunction)array__decode_utf8,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_take_along_axis",
+        (PyCFunction)array__take_along_axis,
+        METH_VARARGS, NULL},
+    {"_put_along_axis",
+        (PyCFunction)array__put_along_axis,
+        METH_VARARGS, NULL},
+    {"_load_npy_mmap",
+        (PyCFunction)array__load_npy_mmap,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"vdot",
         (PyCFunction)array_vdot,
         METH_VARARGS | METH_KEYWORDS, NULL},
@@ -4242,6 +6358,14 @@ static struct PyMethodDef array_module_methods[] = {
         "indicated by mask."},
     {"bincount", (PyCFunction)arr_bincount,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_unique_hash", (PyCFunction)arr_unique_hash,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_in1d_hash", (PyCFunction)arr_in1d_hash,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_bytes_transform", (PyCFunction)arr_bytes_transform,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_histogram_uniform", (PyCFunction)arr_histogram_uniform,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"_monotonicity", (PyCFunction)arr__monotonicity,
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"implement_array_function",
@@ -4251,6 +6375,12 @@ static struct PyMethodDef array_module_methods[] = {
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"interp_complex", (PyCFunction)arr_interp_complex,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_polyval", (PyCFunction)arr_polyval,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_decide_all_any", (PyCFunction)array__decide_all_any,
+        METH_VARARGS, NULL},
+    {"_count_nonfinite", (PyCFunction)array__count_nonfinite,
+        METH_VARARGS, NULL},
     {"ravel_multi_index", (PyCFunction)arr_ravel_multi_index,
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"unravel_index", (PyCFunction)arr_unravel_index,
@@ -4265,6 +6395,14 @@ static struct PyMethodDef array_module_methods[] = {
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"set_legacy_print_mode", (PyCFunction)set_legacy_print_mode,
         METH_VARARGS, NULL},
+    {"_set_num_threads", (PyCFunction)array__set_num_threads,
+        METH_VARARGS, NULL},
+    {"_set_thread_limit", (PyCFunction)array__set_thread_limit,
+        METH_VARARGS, NULL},
+    {"_get_num_threads", (PyCFunction)array__get_num_threads,
+        METH_NOARGS, NULL},
+    {"_set_deterministic", (PyCFunction)array__set_deterministic,
+        METH_VARARGS, NULL},
     /* from umath */
     {"frompyfunc",
         (PyCFunction) ufunc_frompyfunc,
@@ -4277,6 +6415,21 @@ static struct PyMethodDef array_module_methods[] = {
         METH_VARARGS, NULL},
     {"_add_newdoc_ufunc", (PyCFunction)add_newdoc_ufunc,
         METH_VARARGS, NULL},
+    {"_set_ufunc_stats",
+        (PyCFunction)ufunc_stats_set,
+        METH_VARARGS, NULL},
+    {"_get_ufunc_stats",
+        (PyCFunction)ufunc_stats_get,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_get_alloc_stats",
+        (PyCFunction)alloc_stats_get,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_cpu_features",
+        (PyCFunction)cpu_features_get,
+        METH_NOARGS, NULL},
+    {"_simd_dispatch_info",
+        (PyCFunction)simd_dispatch_get,
+        METH_NOARGS, NULL},
     {NULL, NULL, 0, NULL}                /* sentinel */
 };
 
@@ -4574,6 +6727,9 @@ PyMODINIT_FUNC init_multiarray_umath(void) {
         1);
 #endif
 
+    /* On failure the pool stays disabled and parallel regions run inline */
+    npy_workpool_init();
+
     /* Initialize access to the PyDateTime API */
     numpy_pydatetime_import();
 
@@ -4607,6 +6763,7 @@ PyMODINIT_FUNC init_multiarray_umath(void) {
         goto err;
     }
     initialize_casting_tables();
+    initialize_can_cast_table();
     initialize_numeric_types();
     if (initscalarmath(m) < 0) {
         goto err;
@@ -4650,6 +6807,18 @@ PyMODINIT_FUNC init_multiarray_umath(void) {
     if (PyType_Ready(&NpyBusDayCalendar_Type) < 0) {
         goto err;
     }
+    if (PyType_Ready(&PySortIndex_Type) < 0) {
+        goto err;
+    }
+    if (PyType_Ready(&PyInterpTable_Type) < 0) {
+        goto err;
+    }
+    if (PyType_Ready(&PyLazyExpr_Type) < 0) {
+        goto err;
+    }
+    if (PyType_Ready(&PyGrowableArray_Type) < 0) {
+        goto err;
+    }
 
     c_api = NpyCapsule_FromVoidPtr((void *)PyArray_API, NULL);
     if (c_api == NULL) {
@@ -4728,6 +6897,10 @@ PyMODINIT_FUNC init_multiarray_umath(void) {
     /* Business day calendar object */
     PyDict_SetItemString(d, "busdaycalendar",
                             (PyObject *)&NpyBusDayCalendar_Type);
+    PyDict_SetItemString(d, "_SortIndex", (PyObject *)&PySortIndex_Type);
+    PyDict_SetItemString(d, "_InterpTable", (PyObject *)&PyInterpTable_Type);
+    PyDict_SetItemString(d, "_LazyExpr", (PyObject *)&PyLazyExpr_Type);
+    PyDict_SetItemString(d, "_GrowableArray", (PyObject *)&PyGrowableArray_Type);
     set_flaginfo(d);
 
     /* Create the typeinfo types */
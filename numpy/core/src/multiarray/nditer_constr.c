@@ -18,6 +18,7 @@
 #include "arrayobject.h"
 #include "templ_common.h"
 #include "array_assign.h"
+#include "npy_arena.h"
 
 /* Internal helper functions private to this file */
 static int
@@ -88,12 +89,229 @@ npyiter_allocate_arrays(NpyIter *iter,
                         PyArray_Descr **op_dtype, PyTypeObject *subtype,
                         npy_uint32 *op_flags, npyiter_opitflags *op_itflags,
                         int **op_axes);
+static int
+npyiter_elementwise_overlap_is_safe(NpyIter *iter, int iop, int iother);
 static void
 npyiter_get_priority_subtype(int nop, PyArrayObject **op,
                             npyiter_opitflags *op_itflags,
                             double *subtype_priority, PyTypeObject **subtype);
 static int
 npyiter_allocate_transfer_functions(NpyIter *iter);
+static npy_intp
+npyiter_auto_buffersize(NpyIter *iter);
+
+
+/*
+ * Opt-in memoization of iterator construction.
+ *
+ * Loops that construct the same iterator millions of times (same shapes,
+ * strides, dtypes and flags, only the data pointers changing) redo the
+ * axis ordering, coalescing and buffering setup on every call.  With
+ * NPY_ITER_CACHE set to N > 0, up to N constructed iterators are kept as
+ * templates keyed on every input the layout decisions depend on; an
+ * exact metadata match is replayed with NpyIter_Copy plus
+ * NpyIter_ResetBasePointers instead of being rebuilt.
+ *
+ * Only constructions that use the operands exactly as passed qualify:
+ * no op_axes, no allocated outputs and no copied, cast or byteswapped
+ * operands, so a cached template differs from a fresh construction only
+ * in its base pointers.  Data pointer alignment is part of the key
+ * because it feeds the per-operand alignment flags.  The templates hold
+ * references to the operands and dtypes of the call that populated them
+ * until they are evicted.  The cache is protected by the GIL, which
+ * construction holds anyway for the error handling.
+ */
+
+#define NPY_ITER_CACHE_MAXSIZE 16
+#define NPY_ITER_CACHE_MAXOP 4
+#define NPY_ITER_CACHE_MAXDIM 8
+
+typedef struct {
+    npy_uint32 flags;
+    npy_uint32 op_flags[NPY_ITER_CACHE_MAXOP];
+    NPY_ORDER order;
+    NPY_CASTING casting;
+    npy_intp buffersize;
+    int nop;
+    int ndim[NPY_ITER_CACHE_MAXOP];
+    /* borrowed; kept alive by the template through NIT_DTYPES */
+    PyArray_Descr *dtype[NPY_ITER_CACHE_MAXOP];
+    npy_uintp align[NPY_ITER_CACHE_MAXOP];
+    /* WRITEABLE state of the operand itself */
+    int writeable[NPY_ITER_CACHE_MAXOP];
+    npy_intp shape[NPY_ITER_CACHE_MAXOP][NPY_ITER_CACHE_MAXDIM];
+    npy_intp strides[NPY_ITER_CACHE_MAXOP][NPY_ITER_CACHE_MAXDIM];
+} npyiter_cache_key;
+
+typedef struct {
+    npyiter_cache_key key;
+    NpyIter *iter;
+    int used;
+} npyiter_cache_entry;
+
+static npyiter_cache_entry npyiter_cache[NPY_ITER_CACHE_MAXSIZE];
+static int npyiter_cache_next = 0;
+
+static int
+npyiter_cache_size(void)
+{
+    static int size = -1;
+
+    if (size < 0) {
+        char *env = getenv("NPY_ITER_CACHE");
+        size = 0;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > NPY_ITER_CACHE_MAXSIZE) {
+                val = NPY_ITER_CACHE_MAXSIZE;
+            }
+            if (val > 0) {
+                size = (int)val;
+            }
+        }
+    }
+    return size;
+}
+
+/*
+ * Fill in the cache key for a construction call, returning 0 when the
+ * call cannot be cached.  The key must be memcmp-comparable, so it is
+ * zeroed before the fields are set.
+ */
+static int
+npyiter_cache_key_fill(npyiter_cache_key *key, int nop, PyArrayObject **op_in,
+                       npy_uint32 flags, NPY_ORDER order, NPY_CASTING casting,
+                       npy_uint32 *op_flags,
+                       PyArray_Descr **op_request_dtypes, npy_intp buffersize)
+{
+    int iop, idim;
+
+    if (nop > NPY_ITER_CACHE_MAXOP) {
+        return 0;
+    }
+    memset(key, 0, sizeof(*key));
+    key->flags = flags;
+    key->order = order;
+    key->casting = casting;
+    key->buffersize = buffersize;
+    key->nop = nop;
+    for (iop = 0; iop < nop; ++iop) {
+        PyArrayObject *op = op_in[iop];
+
+        if (op == NULL || PyArray_NDIM(op) > NPY_ITER_CACHE_MAXDIM) {
+            return 0;
+        }
+        /*
+         * A requested dtype other than the operand's own would make the
+         * iterator cast or copy, which the replay cannot reproduce.
+         */
+        if (op_request_dtypes != NULL && op_request_dtypes[iop] != NULL &&
+                op_request_dtypes[iop] != PyArray_DESCR(op)) {
+            return 0;
+        }
+        key->op_flags[iop] = op_flags[iop];
+        key->ndim[iop] = PyArray_NDIM(op);
+        key->dtype[iop] = PyArray_DESCR(op);
+        /* 16 covers the strictest alignment of any builtin dtype */
+        key->align[iop] = (npy_uintp)PyArray_BYTES(op) & 0xf;
+        /*
+         * Fresh construction checks write access through
+         * PyArray_FailUnlessWriteable; the replay does not, so a
+         * read-only operand must not match a writable template.
+         */
+        key->writeable[iop] = PyArray_FLAGS(op) & NPY_ARRAY_WRITEABLE;
+        for (idim = 0; idim < PyArray_NDIM(op); ++idim) {
+            key->shape[iop][idim] = PyArray_DIM(op, idim);
+            key->strides[iop][idim] = PyArray_STRIDE(op, idim);
+        }
+    }
+    return 1;
+}
+
+/*
+ * Replay a cached template onto the new operands, or return NULL (with
+ * no error set) to fall back to a fresh construction.
+ */
+static NpyIter *
+npyiter_cache_lookup(const npyiter_cache_key *key, PyArrayObject **op_in)
+{
+    int i, iop;
+
+    for (i = 0; i < npyiter_cache_size(); ++i) {
+        npyiter_cache_entry *entry = &npyiter_cache[i];
+        NpyIter *newiter;
+        int nop;
+        PyArrayObject **objects;
+        char *baseptrs[NPY_ITER_CACHE_MAXOP];
+
+        if (!entry->used ||
+                memcmp(&entry->key, key, sizeof(*key)) != 0) {
+            continue;
+        }
+        newiter = NpyIter_Copy(entry->iter);
+        if (newiter == NULL) {
+            PyErr_Clear();
+            return NULL;
+        }
+        nop = NIT_NOP(newiter);
+        /* swap in the new operands; the layout is pointer-independent */
+        objects = NIT_OPERANDS(newiter);
+        for (iop = 0; iop < nop; ++iop) {
+            Py_INCREF(op_in[iop]);
+            Py_DECREF(objects[iop]);
+            objects[iop] = op_in[iop];
+            baseptrs[iop] = PyArray_BYTES(op_in[iop]);
+        }
+        if (NpyIter_ResetBasePointers(newiter, baseptrs, NULL)
+                                                        != NPY_SUCCEED) {
+            NpyIter_Deallocate(newiter);
+            PyErr_Clear();
+            return NULL;
+        }
+        return newiter;
+    }
+    return NULL;
+}
+
+static void
+npyiter_cache_store(const npyiter_cache_key *key, NpyIter *iter,
+                    PyArrayObject **op_in)
+{
+    /*npy_uint32 itflags = NIT_ITFLAGS(iter);*/
+    /*int ndim = NIT_NDIM(iter);*/
+    int nop = NIT_NOP(iter);
+    PyArrayObject **op = NIT_OPERANDS(iter);
+    PyArray_Descr **dtype = NIT_DTYPES(iter);
+    npyiter_cache_entry *entry;
+    NpyIter *template;
+    int iop;
+
+    /*
+     * Only iterators that used the operands exactly as passed can be
+     * replayed; a copied, cast or byteswapped operand means the base
+     * pointer swap would miss the temporary.
+     */
+    for (iop = 0; iop < nop; ++iop) {
+        if (op[iop] != op_in[iop] ||
+                dtype[iop] != PyArray_DESCR(op_in[iop])) {
+            return;
+        }
+    }
+
+    template = NpyIter_Copy(iter);
+    if (template == NULL) {
+        PyErr_Clear();
+        return;
+    }
+    entry = &npyiter_cache[npyiter_cache_next % npyiter_cache_size()];
+    npyiter_cache_next++;
+    if (entry->used) {
+        NpyIter_Deallocate(entry->iter);
+    }
+    entry->key = *key;
+    entry->iter = template;
+    entry->used = 1;
+}
 
 
 /*NUMPY_API
@@ -129,6 +347,10 @@ NpyIter_AdvancedNew(int nop, PyArrayObject **op_in, npy_uint32 flags,
     double subtype_priority = NPY_PRIORITY;
     PyTypeObject *subtype = &PyArray_Type;
 
+    /* Layout memoization, engaged only when NPY_ITER_CACHE is set */
+    npyiter_cache_key cache_key;
+    int cache_ok = 0;
+
 #if NPY_IT_CONSTRUCTION_TIMING
     npy_intp c_temp,
             c_start,
@@ -179,6 +401,23 @@ NpyIter_AdvancedNew(int nop, PyArrayObject **op_in, npy_uint32 flags,
 
     NPY_IT_TIME_POINT(c_check_op_axes);
 
+    /*
+     * An identical construction may have been cached; equal keys imply
+     * the remaining validation below ran successfully for it, so a hit
+     * can be returned before redoing any of it.
+     */
+    if (oa_ndim == -1 && npyiter_cache_size() > 0) {
+        cache_ok = npyiter_cache_key_fill(&cache_key, nop, op_in, flags,
+                                          order, casting, op_flags,
+                                          op_request_dtypes, buffersize);
+        if (cache_ok) {
+            iter = npyiter_cache_lookup(&cache_key, op_in);
+            if (iter != NULL) {
+                return iter;
+            }
+        }
+    }
+
     /* Check the global iterator flags */
     if (!npyiter_check_global_flags(flags, &itflags)) {
         return NULL;
@@ -253,7 +492,12 @@ NpyIter_AdvancedNew(int nop, PyArrayObject **op_in, npy_uint32 flags,
          * small enough to be cache-friendly.
          */
         if (buffersize <= 0) {
-            buffersize = NPY_BUFSIZE;
+            if (flags & NPY_ITER_AUTO_BUFSIZE) {
+                buffersize = npyiter_auto_buffersize(iter);
+            }
+            else {
+                buffersize = NPY_BUFSIZE;
+            }
         }
         /* No point in a buffer bigger than the iteration size */
         if (buffersize > NIT_ITERSIZE(iter)) {
@@ -501,6 +745,10 @@ NpyIter_AdvancedNew(int nop, PyArrayObject **op_in, npy_uint32 flags,
     printf("\n");
 #endif
 
+    if (cache_ok) {
+        npyiter_cache_store(&cache_key, iter, op_in);
+    }
+
     return iter;
 }
 
@@ -587,7 +835,7 @@ NpyIter_Copy(NpyIter *iter)
                 }
                 else {
                     itemsize = dtypes[iop]->elsize;
-                    buffers[iop] = PyArray_malloc(itemsize*buffersize);
+                    buffers[iop] = npy_scratch_alloc(itemsize*buffersize);
                     if (buffers[iop] == NULL) {
                         out_of_memory = 1;
                     }
@@ -672,7 +920,7 @@ NpyIter_Deallocate(NpyIter *iter)
         /* buffers */
         buffers = NBF_BUFFERS(bufferdata);
         for(iop = 0; iop < nop; ++iop, ++buffers) {
-            PyArray_free(*buffers);
+            npy_scratch_free(*buffers);
         }
         /* read bufferdata */
         transferdata = NBF_READTRANSFERDATA(bufferdata);
@@ -785,6 +1033,64 @@ npyiter_check_global_flags(npy_uint32 flags, npy_uint32* itflags)
     return 1;
 }
 
+/*
+ * Returns the size in bytes of the data cache to target when the buffer
+ * size is chosen automatically.  The fallback when the OS cannot report
+ * the L2 size matches a common 256KB L2.
+ */
+static npy_intp
+npyiter_data_cache_size(void)
+{
+    static npy_intp cache_size = -1;
+
+    if (cache_size < 0) {
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+        long reported = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        cache_size = (reported > 0) ? (npy_intp)reported : 0x40000;
+#else
+        cache_size = 0x40000;
+#endif
+    }
+
+    return cache_size;
+}
+
+/*
+ * Computes an element count for the buffers requested by the flag
+ * NPY_ITER_AUTO_BUFSIZE.  NPY_BUFSIZE is 8192 elements, which for wide
+ * dtypes is too small to amortize the transfer function setup; here the
+ * buffers are instead sized so that together they fill half the data
+ * cache, with the other half left for the operand memory feeding them.
+ *
+ * Returns the buffer size in elements, never below NPY_BUFSIZE.
+ */
+static npy_intp
+npyiter_auto_buffersize(NpyIter *iter)
+{
+    int iop, nop = NIT_NOP(iter);
+    PyArray_Descr **op_dtype = NIT_DTYPES(iter);
+    npy_intp rowsize = 0, buffersize;
+
+    /*
+     * Dtypes that are still unresolved here (allocated outputs without
+     * a requested dtype, pending common-dtype calculation) count as a
+     * single byte, which errs towards bigger buffers.
+     */
+    for (iop = 0; iop < nop; ++iop) {
+        rowsize += (op_dtype[iop] != NULL) ? op_dtype[iop]->elsize : 1;
+    }
+    if (rowsize <= 0) {
+        return NPY_BUFSIZE;
+    }
+
+    buffersize = npyiter_data_cache_size() / 2 / rowsize;
+    if (buffersize < NPY_BUFSIZE) {
+        buffersize = NPY_BUFSIZE;
+    }
+
+    return buffersize;
+}
+
 static int
 npyiter_check_op_axes(int nop, int oa_ndim, int **op_axes,
                         npy_intp *itershape)
@@ -2702,6 +3008,80 @@ npyiter_new_temp_array(NpyIter *iter, PyTypeObject *subtype,
     return ret;
 }
 
+/*
+ * Checks whether a write operand 'iop' which overlaps the read operand
+ * 'iother' can nevertheless skip the temporary copy that
+ * NPY_ITER_COPY_IF_OVERLAP would otherwise force.  The caller has
+ * already verified that both operands have
+ * NPY_ITER_OVERLAP_ASSUME_ELEMENTWISE set, i.e. that element i of
+ * either operand is only accessed while processing element i.
+ *
+ * Beyond the exactly-identical-view case handled inline by the caller,
+ * the elementwise guarantee also makes shifted sliding-window updates
+ * such as a[:-1] += a[1:] safe.  If both operands are traversed with
+ * the same, strictly address-increasing stride pattern, element i of
+ * each operand lives at its base address plus the same offset(i), and
+ * a write to element i can only clobber the read of a later element
+ * j > i when the write base lies above the read base.  So when the
+ * write operand starts at or below the read operand, every shared
+ * address is read before it is written, and the copy can be elided.
+ * This also holds with buffering: a buffered chunk reads all of its
+ * elements before writing any of them back, and later chunks read
+ * from strictly higher addresses.
+ *
+ * The reversed direction (e.g. a[1:] += a[:-1]) would need the
+ * iteration order itself reversed, which has been finalized by this
+ * point, so it still gets a temporary copy.
+ *
+ * Returns 1 if the copy may be elided, 0 if it is needed.
+ */
+static int
+npyiter_elementwise_overlap_is_safe(NpyIter *iter, int iop, int iother)
+{
+    npy_uint32 itflags = NIT_ITFLAGS(iter);
+    int idim, ndim = NIT_NDIM(iter);
+    int nop = NIT_NOP(iter);
+
+    NpyIter_AxisData *axisdata;
+    npy_intp sizeof_axisdata;
+    char **resetdataptr = NIT_RESETDATAPTR(iter);
+    PyArrayObject **op = NIT_OPERANDS(iter);
+    npy_intp span;
+
+    if (PyArray_DESCR(op[iop]) != PyArray_DESCR(op[iother])) {
+        return 0;
+    }
+    /* Every shared address must be read before it is written */
+    if (resetdataptr[iop] > resetdataptr[iother]) {
+        return 0;
+    }
+
+    /*
+     * Walk the axes from innermost to outermost, checking that both
+     * operands use the same strides and that each stride steps past
+     * the full extent of the faster axes, so that the iteration
+     * offsets are strictly increasing in memory.  This also rules out
+     * zero and negative strides, and any internal overlap.
+     */
+    axisdata = NIT_AXISDATA(iter);
+    sizeof_axisdata = NIT_AXISDATA_SIZEOF(itflags, ndim, nop);
+    span = PyArray_DESCR(op[iop])->elsize;
+    for (idim = 0; idim < ndim; ++idim, NIT_ADVANCE_AXISDATA(axisdata, 1)) {
+        npy_intp shape = NAD_SHAPE(axisdata);
+        npy_intp stride = NAD_STRIDES(axisdata)[iop];
+
+        if (shape == 1) {
+            continue;
+        }
+        if (stride != NAD_STRIDES(axisdata)[iother] || stride < span) {
+            return 0;
+        }
+        span += (shape - 1) * stride;
+    }
+
+    return 1;
+}
+
 static int
 npyiter_allocate_arrays(NpyIter *iter,
                         npy_uint32 flags,
@@ -2801,6 +3181,20 @@ npyiter_allocate_arrays(NpyIter *iter,
                                                           op[iother],
                                                           1);
 
+                /*
+                 * Overlapping but shifted elementwise operands can
+                 * still be safe, if the iteration order reads each
+                 * shared address before writing it.
+                 */
+                if (may_share_memory &&
+                        (op_flags[iop] & NPY_ITER_OVERLAP_ASSUME_ELEMENTWISE) &&
+                        (op_flags[iother] &
+                            NPY_ITER_OVERLAP_ASSUME_ELEMENTWISE) &&
+                        npyiter_elementwise_overlap_is_safe(iter, iop,
+                                                            iother)) {
+                    continue;
+                }
+
                 if (may_share_memory) {
                     op_itflags[iop] |= NPY_OP_ITFLAG_FORCECOPY;
                     break;
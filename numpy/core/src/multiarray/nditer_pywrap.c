@@ -143,6 +143,11 @@ NpyIter_GlobalFlagsConverter(PyObject *flags_in, npy_uint32 *flags)
         /* Use switch statements to quickly isolate the right flag */
         flag = 0;
         switch (str[0]) {
+            case 'a':
+                if (strcmp(str, "auto_bufsize") == 0) {
+                    flag = NPY_ITER_AUTO_BUFSIZE;
+                }
+                break;
             case 'b':
                 if (strcmp(str, "buffered") == 0) {
                     flag = NPY_ITER_BUFFERED;
@@ -19,6 +19,48 @@
 static void
 _fillobject(char *optr, PyObject *obj, PyArray_Descr *dtype);
 
+/*
+ * Number of elements from which PyArray_XDECREF releases an aligned
+ * contiguous object array in chunks with a GIL yield in between, so
+ * dropping a huge array does not stall other threads for the whole
+ * refcounting pass.  The chunk size bounds both the yield latency and
+ * the stack buffer holding the collected pointers.
+ */
+#define NPY_DECREF_YIELD_MIN 0x40000
+#define NPY_DECREF_CHUNK 4096
+
+/*
+ * Releases the references of a huge object array chunk by chunk,
+ * yielding the GIL between chunks.  Each chunk's pointers are
+ * collected and their slots cleared before any destructor can run, so
+ * the array holds only released-and-cleared or still-owned references
+ * at every yield point, never a dangling one.
+ */
+static void
+_batched_xdecref(PyObject **data, npy_intp n)
+{
+    PyObject *batch[NPY_DECREF_CHUNK];
+
+    while (n > 0) {
+        npy_intp i, k = (n < NPY_DECREF_CHUNK) ? n : NPY_DECREF_CHUNK;
+
+        for (i = 0; i < k; i++) {
+            batch[i] = data[i];
+            data[i] = NULL;
+        }
+        for (i = 0; i < k; i++) {
+            Py_XDECREF(batch[i]);
+        }
+        data += k;
+        n -= k;
+        if (n > 0) {
+            /* let waiting threads run before the next chunk */
+            NPY_BEGIN_ALLOW_THREADS
+            NPY_END_ALLOW_THREADS
+        }
+    }
+}
+
 
 /*NUMPY_API
  * XINCREF all objects in a single array item. This is complicated for
@@ -232,7 +274,12 @@ PyArray_XDECREF(PyArrayObject *mp)
         data = (PyObject **)PyArray_DATA(mp);
         n = PyArray_SIZE(mp);
         if (PyArray_ISALIGNED(mp)) {
-            for (i = 0; i < n; i++, data++) Py_XDECREF(*data);
+            if (n >= NPY_DECREF_YIELD_MIN) {
+                _batched_xdecref(data, n);
+            }
+            else {
+                for (i = 0; i < n; i++, data++) Py_XDECREF(*data);
+            }
         }
         else {
             for (i = 0; i < n; i++, data++) {
@@ -550,6 +550,26 @@ PyArray_Squeeze(PyArrayObject *self)
         return (PyObject *)self;
     }
 
+    /*
+     * For base class arrays the squeezed geometry can be built
+     * directly with the fast slice-view constructor, skipping the
+     * full view construction and flag re-validation.
+     */
+    if (Py_TYPE(self) == &PyArray_Type) {
+        npy_intp dims[NPY_MAXDIMS], strides[NPY_MAXDIMS];
+        int ndim_out = 0;
+
+        for (idim = 0; idim < ndim; ++idim) {
+            if (!unit_dims[idim]) {
+                dims[ndim_out] = shape[idim];
+                strides[ndim_out] = PyArray_STRIDE(self, idim);
+                ndim_out++;
+            }
+        }
+        return PyArray_NewViewFromBase(self, ndim_out, dims, strides,
+                                       PyArray_DATA(self));
+    }
+
     ret = (PyArrayObject *)PyArray_View(self, NULL, &PyArray_Type);
     if (ret == NULL) {
         return NULL;
@@ -606,6 +626,22 @@ PyArray_SqueezeSelected(PyArrayObject *self, npy_bool *axis_flags)
         return (PyObject *)self;
     }
 
+    /* header-only lane for base class arrays, as in PyArray_Squeeze */
+    if (Py_TYPE(self) == &PyArray_Type) {
+        npy_intp dims[NPY_MAXDIMS], strides[NPY_MAXDIMS];
+        int ndim_out = 0;
+
+        for (idim = 0; idim < ndim; ++idim) {
+            if (!(axis_flags[idim] && shape[idim] == 1)) {
+                dims[ndim_out] = shape[idim];
+                strides[ndim_out] = PyArray_STRIDE(self, idim);
+                ndim_out++;
+            }
+        }
+        return PyArray_NewViewFromBase(self, ndim_out, dims, strides,
+                                       PyArray_DATA(self));
+    }
+
     ret = (PyArrayObject *)PyArray_View(self, NULL, &PyArray_Type);
     if (ret == NULL) {
         return NULL;
@@ -667,7 +703,7 @@ PyArray_Transpose(PyArrayObject *ap, PyArray_Dims *permute)
     int i, n;
     int permutation[NPY_MAXDIMS], reverse_permutation[NPY_MAXDIMS];
     PyArrayObject *ret = NULL;
-    int flags;
+    int flags, is_identity, is_reversal;
 
     if (permute == NULL) {
         n = PyArray_NDIM(ap);
@@ -717,12 +753,52 @@ PyArray_Transpose(PyArrayObject *ap, PyArray_Dims *permute)
     }
 
     /* fix the dimensions and strides of the return-array */
+    is_identity = 1;
+    is_reversal = 1;
     for (i = 0; i < n; i++) {
         PyArray_DIMS(ret)[i] = PyArray_DIMS(ap)[permutation[i]];
         PyArray_STRIDES(ret)[i] = PyArray_STRIDES(ap)[permutation[i]];
+        if (permutation[i] != i) {
+            is_identity = 0;
+        }
+        if (permutation[i] != n - 1 - i) {
+            is_reversal = 0;
+        }
+    }
+
+    /*
+     * The data pointer, itemsize and set of strides are those of the
+     * source, so alignment cannot change, and for the two common
+     * permutations contiguity is known without walking the dimensions:
+     * the identity keeps the layout and a full reversal exchanges the
+     * C and F properties.  Only mixed permutations need the general
+     * recomputation.
+     */
+    if (is_identity || is_reversal) {
+        int contig = 0;
+
+        if (PyArray_CHKFLAGS(ap, NPY_ARRAY_C_CONTIGUOUS)) {
+            contig |= is_identity ? NPY_ARRAY_C_CONTIGUOUS
+                                  : NPY_ARRAY_F_CONTIGUOUS;
+        }
+        if (PyArray_CHKFLAGS(ap, NPY_ARRAY_F_CONTIGUOUS)) {
+            contig |= is_identity ? NPY_ARRAY_F_CONTIGUOUS
+                                  : NPY_ARRAY_C_CONTIGUOUS;
+        }
+        PyArray_CLEARFLAGS(ret, NPY_ARRAY_C_CONTIGUOUS |
+                                NPY_ARRAY_F_CONTIGUOUS);
+        PyArray_ENABLEFLAGS(ret, contig);
+        if (PyArray_CHKFLAGS(ap, NPY_ARRAY_ALIGNED)) {
+            PyArray_ENABLEFLAGS(ret, NPY_ARRAY_ALIGNED);
+        }
+        else {
+            PyArray_CLEARFLAGS(ret, NPY_ARRAY_ALIGNED);
+        }
+    }
+    else {
+        PyArray_UpdateFlags(ret, NPY_ARRAY_C_CONTIGUOUS |
+                            NPY_ARRAY_F_CONTIGUOUS | NPY_ARRAY_ALIGNED);
     }
-    PyArray_UpdateFlags(ret, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_F_CONTIGUOUS |
-                        NPY_ARRAY_ALIGNED);
     return (PyObject *)ret;
 }
 
@@ -902,11 +978,21 @@ PyArray_Ravel(PyArrayObject *arr, NPY_ORDER order)
         order = PyArray_ISFORTRAN(arr) ? NPY_FORTRANORDER : NPY_CORDER;
     }
 
-    if (order == NPY_CORDER && PyArray_IS_C_CONTIGUOUS(arr)) {
-        return PyArray_Newshape(arr, &newdim, NPY_CORDER);
-    }
-    else if (order == NPY_FORTRANORDER && PyArray_IS_F_CONTIGUOUS(arr)) {
-        return PyArray_Newshape(arr, &newdim, NPY_FORTRANORDER);
+    if ((order == NPY_CORDER && PyArray_IS_C_CONTIGUOUS(arr)) ||
+            (order == NPY_FORTRANORDER && PyArray_IS_F_CONTIGUOUS(arr))) {
+        /*
+         * A contiguous buffer flattens to itself; base class arrays
+         * get the header-only view, skipping the reshape machinery.
+         */
+        if (Py_TYPE(arr) == &PyArray_Type) {
+            npy_intp size = PyArray_SIZE(arr);
+            npy_intp stride = PyArray_ITEMSIZE(arr);
+
+            return PyArray_NewViewFromBase(arr, 1, &size, &stride,
+                                           PyArray_BYTES(arr));
+        }
+        return PyArray_Newshape(arr, &newdim,
+                order == NPY_CORDER ? NPY_CORDER : NPY_FORTRANORDER);
     }
     /* For KEEPORDER, check if we can make a flattened view */
     else if (order == NPY_KEEPORDER) {
@@ -1066,6 +1152,11 @@ PyArray_RemoveAxesInPlace(PyArrayObject *arr, npy_bool *flags)
     /* The final number of dimensions */
     fa->nd = idim_out;
 
+    /* Nothing was removed: the layout and hence the flags are unchanged */
+    if (idim_out == ndim) {
+        return;
+    }
+
     /* May not be necessary for NPY_RELAXED_STRIDES_CHECKING (see comment) */
     PyArray_UpdateFlags(arr, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_F_CONTIGUOUS);
 }
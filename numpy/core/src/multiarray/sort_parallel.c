@@ -0,0 +1,496 @@
+/*
+ * Opt-in threaded sorting for large arrays.
+ *
+ * The axis to sort is split into contiguous chunks which are sorted with
+ * the type specific sort function on the shared worker pool (see
+ * npy_workpool.c), then merged with the type specific compare.  The chunk sorts keep whatever algorithm the
+ * caller selected through the sort kind dispatch, so a parallel quicksort
+ * still degrades to heapsort per chunk and a parallel stable sort stays
+ * stable: the merge takes from the left run on ties.
+ *
+ * The same workers also drive a parallel selection for partition: each
+ * step classifies the lane around a sampled pivot on all threads and
+ * recurses into the sides that still contain a requested kth, handing
+ * small remainders to the serial introselect.
+ *
+ * Like the threaded ufunc loops this is enabled by setting
+ * NPY_SORT_THREADS to N > 1 and is only used above a size threshold; the
+ * serial sorts are unchanged for small inputs.  The caller must ensure
+ * the data cannot call back into Python (no object dtypes), since the
+ * GIL is not held here.
+ */
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+
+#include <Python.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "npy_config.h"
+#include "numpy/ndarraytypes.h"
+#include "npy_partition.h"
+#include "npy_workpool.h"
+#include "sort_parallel.h"
+
+/* do not bother threading sorts below this many elements */
+#define NPY_SORT_PARALLEL_THRESHOLD 0x100000
+/* never hand a worker less than this many elements */
+#define NPY_SORT_PARALLEL_MIN_CHUNK 0x40000
+/* upper bound for NPY_SORT_THREADS */
+#define NPY_SORT_MAX_THREADS 128
+/* pivot candidates sampled per parallel partition step */
+#define NPY_PARTITION_MAX_SAMPLES 65
+/* give up on parallel selection and run introselect below this depth */
+#define NPY_PARTITION_MAX_DEPTH 48
+
+static int
+npy_sort_nthreads(void)
+{
+    static int nthreads = -1;
+
+    if (nthreads < 0) {
+        char *env = getenv("NPY_SORT_THREADS");
+        nthreads = 1;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > NPY_SORT_MAX_THREADS) {
+                val = NPY_SORT_MAX_THREADS;
+            }
+            if (val > 1) {
+                nthreads = (int)val;
+            }
+        }
+    }
+    return nthreads;
+}
+
+typedef struct {
+    char *ptr;
+    npy_intp n;
+    PyArray_SortFunc *sort;
+    void *varr;
+    int ret;
+} sort_chunk_task;
+
+static void
+sort_chunk_run(npy_intp t, void *arg)
+{
+    sort_chunk_task *task = (sort_chunk_task *)arg + t;
+
+    task->ret = task->sort(task->ptr, task->n, task->varr);
+}
+
+typedef struct {
+    char *dst;
+    char *a;
+    npy_intp na;
+    char *b;
+    npy_intp nb;
+    npy_intp elsize;
+    PyArray_CompareFunc *cmp;
+    void *varr;
+} sort_merge_task;
+
+static void
+merge_runs(char *dst, char *a, npy_intp na, char *b, npy_intp nb,
+           npy_intp elsize, PyArray_CompareFunc *cmp, void *varr)
+{
+    while (na > 0 && nb > 0) {
+        /* strictly smaller, so equal elements come from the left run */
+        if (cmp(b, a, varr) < 0) {
+            memcpy(dst, b, elsize);
+            b += elsize;
+            nb--;
+        }
+        else {
+            memcpy(dst, a, elsize);
+            a += elsize;
+            na--;
+        }
+        dst += elsize;
+    }
+    if (na > 0) {
+        memcpy(dst, a, na * elsize);
+    }
+    else if (nb > 0) {
+        memcpy(dst, b, nb * elsize);
+    }
+}
+
+static void
+sort_merge_run(npy_intp t, void *arg)
+{
+    sort_merge_task *task = (sort_merge_task *)arg + t;
+
+    merge_runs(task->dst, task->a, task->na, task->b, task->nb,
+               task->elsize, task->cmp, task->varr);
+}
+
+NPY_NO_EXPORT int
+npy_parallel_sort(char *start, npy_intp num, npy_intp elsize,
+                  PyArray_SortFunc *sort, PyArray_CompareFunc *cmp,
+                  void *varr, int *retp)
+{
+    sort_chunk_task chunks[NPY_SORT_MAX_THREADS];
+    npy_intp offset[NPY_SORT_MAX_THREADS + 1];
+    npy_intp chunksize;
+    char *buffer, *src, *dst;
+    int i, nchunks;
+    int nthreads = npy_sort_nthreads();
+
+    if (nthreads <= 1 || num < NPY_SORT_PARALLEL_THRESHOLD ||
+            sort == NULL || cmp == NULL || elsize <= 0) {
+        return 0;
+    }
+
+    /*
+     * In deterministic mode the chunk layout, and with it the merge
+     * tree and the tie placement of the unstable kinds, may depend
+     * only on the length, never on the thread count.
+     */
+    nchunks = npy_workpool_deterministic() ? NPY_SORT_MAX_THREADS
+                                           : nthreads;
+    if (num / nchunks < NPY_SORT_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(num / NPY_SORT_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1) {
+        return 0;
+    }
+
+    /* scratch space for the merges; on failure sort serially */
+    buffer = malloc(num * elsize);
+    if (buffer == NULL) {
+        return 0;
+    }
+
+    chunksize = num / nchunks;
+    for (i = 0; i < nchunks; i++) {
+        offset[i] = i * chunksize;
+    }
+    offset[nchunks] = num;
+
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].ptr = start + offset[i] * elsize;
+        chunks[i].n = offset[i + 1] - offset[i];
+        chunks[i].sort = sort;
+        chunks[i].varr = varr;
+        chunks[i].ret = 0;
+    }
+    npy_parallel_for(nchunks, sort_chunk_run, chunks, nthreads);
+    *retp = 0;
+    for (i = 0; i < nchunks; i++) {
+        if (chunks[i].ret < 0) {
+            *retp = chunks[i].ret;
+        }
+    }
+    if (*retp < 0) {
+        free(buffer);
+        return 1;
+    }
+
+    /*
+     * Merge pairs of sorted runs, ping-ponging between the array and the
+     * scratch buffer.  Each pass halves the number of runs; the merges
+     * within a pass are independent and run on workers.
+     */
+    src = start;
+    dst = buffer;
+    while (nchunks > 1) {
+        sort_merge_task merges[NPY_SORT_MAX_THREADS / 2];
+        int nmerges = 0;
+        int newchunks = 0;
+        char *tmp;
+
+        for (i = 0; i + 1 < nchunks; i += 2) {
+            sort_merge_task *task = &merges[nmerges];
+
+            task->dst = dst + offset[i] * elsize;
+            task->a = src + offset[i] * elsize;
+            task->na = offset[i + 1] - offset[i];
+            task->b = src + offset[i + 1] * elsize;
+            task->nb = offset[i + 2] - offset[i + 1];
+            task->elsize = elsize;
+            task->cmp = cmp;
+            task->varr = varr;
+            nmerges++;
+        }
+        if (nchunks % 2 != 0) {
+            /* odd run out, just carry it over to the other buffer */
+            memcpy(dst + offset[nchunks - 1] * elsize,
+                   src + offset[nchunks - 1] * elsize,
+                   (offset[nchunks] - offset[nchunks - 1]) * elsize);
+        }
+        npy_parallel_for(nmerges, sort_merge_run, merges, nthreads);
+
+        /* collapse the offsets of the merged pairs */
+        for (i = 0; i < nchunks; i += 2) {
+            offset[newchunks++] = offset[i];
+        }
+        offset[newchunks] = num;
+        nchunks = newchunks;
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != start) {
+        memcpy(start, src, num * elsize);
+    }
+    free(buffer);
+
+    return 1;
+}
+
+typedef struct {
+    char *start;
+    char *scratch;
+    npy_intp elsize;
+    PyArray_PartitionFunc *part;
+    PyArray_CompareFunc *cmp;
+    void *varr;
+    /* scratch for one pivot value, shared by all partition steps */
+    char *pivot;
+    int nthreads;
+} part_ctx;
+
+typedef struct {
+    char *ptr;
+    npy_intp n;
+    const part_ctx *ctx;
+    /* counts from the classify pass, destinations for the scatter pass */
+    npy_intp nlt, neq, ngt;
+    char *dlt, *deq, *dgt;
+} part_chunk_task;
+
+static void
+part_classify(part_chunk_task *task)
+{
+    const part_ctx *ctx = task->ctx;
+    const char *p = task->ptr;
+    npy_intp i;
+
+    task->nlt = task->neq = task->ngt = 0;
+    for (i = 0; i < task->n; i++, p += ctx->elsize) {
+        const int c = ctx->cmp(p, ctx->pivot, ctx->varr);
+
+        if (c < 0) {
+            task->nlt++;
+        }
+        else if (c > 0) {
+            task->ngt++;
+        }
+        else {
+            task->neq++;
+        }
+    }
+}
+
+static void
+part_classify_run(npy_intp t, void *arg)
+{
+    part_classify((part_chunk_task *)arg + t);
+}
+
+static void
+part_scatter(part_chunk_task *task)
+{
+    const part_ctx *ctx = task->ctx;
+    const char *p = task->ptr;
+    npy_intp i;
+
+    for (i = 0; i < task->n; i++, p += ctx->elsize) {
+        const int c = ctx->cmp(p, ctx->pivot, ctx->varr);
+
+        if (c < 0) {
+            memcpy(task->dlt, p, ctx->elsize);
+            task->dlt += ctx->elsize;
+        }
+        else if (c > 0) {
+            memcpy(task->dgt, p, ctx->elsize);
+            task->dgt += ctx->elsize;
+        }
+        else {
+            memcpy(task->deq, p, ctx->elsize);
+            task->deq += ctx->elsize;
+        }
+    }
+}
+
+static void
+part_scatter_run(npy_intp t, void *arg)
+{
+    part_scatter((part_chunk_task *)arg + t);
+}
+
+/*
+ * Pick a pivot for [offset, offset + n) as the median of evenly spaced
+ * samples and copy it into the context, so the classify passes are not
+ * reading it from a location the scatter passes overwrite.
+ */
+static void
+part_pick_pivot(part_ctx *ctx, npy_intp offset, npy_intp n)
+{
+    const char *samples[NPY_PARTITION_MAX_SAMPLES];
+    npy_intp nsamples = 2 * ctx->nthreads + 1;
+    npy_intp i, k;
+
+    if (nsamples > NPY_PARTITION_MAX_SAMPLES) {
+        nsamples = NPY_PARTITION_MAX_SAMPLES;
+    }
+    if (nsamples > n) {
+        nsamples = n;
+    }
+    for (i = 0; i < nsamples; i++) {
+        samples[i] = ctx->start + (offset + i * (n / nsamples)) * ctx->elsize;
+    }
+    /* insertion sort; the sample count is small */
+    for (i = 1; i < nsamples; i++) {
+        const char *v = samples[i];
+
+        for (k = i; k > 0 &&
+                ctx->cmp(v, samples[k - 1], ctx->varr) < 0; k--) {
+            samples[k] = samples[k - 1];
+        }
+        samples[k] = v;
+    }
+    memcpy(ctx->pivot, samples[nsamples / 2], ctx->elsize);
+}
+
+/*
+ * Place every kth of the sorted kth[0..nkth) that falls in the region
+ * [offset, offset + n) of the full lane.  One classify/scatter step
+ * around a sampled pivot splits the region into a below, an equal and
+ * an above block; the equal block satisfies any kth inside it and the
+ * two other blocks are recursed into only when they still contain one.
+ */
+static int
+parallel_select(part_ctx *ctx, npy_intp offset, npy_intp n,
+                const npy_intp *kth, npy_intp nkth, int depth)
+{
+    part_chunk_task chunks[NPY_SORT_MAX_THREADS];
+    char *base = ctx->start + offset * ctx->elsize;
+    npy_intp chunksize, nlt, neq;
+    npy_intp i, a, b;
+    /* see npy_parallel_sort on the deterministic chunk layout */
+    int nchunks = npy_workpool_deterministic() ? NPY_SORT_MAX_THREADS
+                                               : ctx->nthreads;
+
+    if (nkth <= 0) {
+        return 0;
+    }
+    if (n / nchunks < NPY_SORT_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(n / NPY_SORT_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1 || depth >= NPY_PARTITION_MAX_DEPTH) {
+        npy_intp pivots[NPY_MAX_PIVOT_STACK];
+        npy_intp npiv = 0;
+
+        for (i = 0; i < nkth; i++) {
+            int ret = ctx->part(base, n, kth[i] - offset,
+                                pivots, &npiv, ctx->varr);
+
+            if (ret < 0) {
+                return ret;
+            }
+        }
+        return 0;
+    }
+
+    part_pick_pivot(ctx, offset, n);
+
+    chunksize = n / nchunks;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].ptr = base + i * chunksize * ctx->elsize;
+        chunks[i].n = (i == nchunks - 1) ? n - i * chunksize : chunksize;
+        chunks[i].ctx = ctx;
+    }
+    npy_parallel_for(nchunks, part_classify_run, chunks, ctx->nthreads);
+
+    /* prefix sums over the chunk counts give the scatter destinations */
+    nlt = neq = 0;
+    for (i = 0; i < nchunks; i++) {
+        nlt += chunks[i].nlt;
+        neq += chunks[i].neq;
+    }
+    {
+        char *dlt = ctx->scratch + offset * ctx->elsize;
+        char *deq = dlt + nlt * ctx->elsize;
+        char *dgt = deq + neq * ctx->elsize;
+
+        for (i = 0; i < nchunks; i++) {
+            chunks[i].dlt = dlt;
+            chunks[i].deq = deq;
+            chunks[i].dgt = dgt;
+            dlt += chunks[i].nlt * ctx->elsize;
+            deq += chunks[i].neq * ctx->elsize;
+            dgt += chunks[i].ngt * ctx->elsize;
+        }
+    }
+    npy_parallel_for(nchunks, part_scatter_run, chunks, ctx->nthreads);
+    memcpy(base, ctx->scratch + offset * ctx->elsize, n * ctx->elsize);
+
+    /*
+     * kth is sorted, so the ones below the equal block form a prefix
+     * and the ones above it a suffix.
+     */
+    a = 0;
+    while (a < nkth && kth[a] < offset + nlt) {
+        a++;
+    }
+    b = a;
+    while (b < nkth && kth[b] < offset + nlt + neq) {
+        b++;
+    }
+    if (a > 0) {
+        int ret = parallel_select(ctx, offset, nlt, kth, a, depth + 1);
+
+        if (ret < 0) {
+            return ret;
+        }
+    }
+    if (b < nkth) {
+        return parallel_select(ctx, offset + nlt + neq, n - nlt - neq,
+                               kth + b, nkth - b, depth + 1);
+    }
+    return 0;
+}
+
+NPY_NO_EXPORT int
+npy_parallel_partition(char *start, npy_intp num, npy_intp elsize,
+                       PyArray_PartitionFunc *part, PyArray_CompareFunc *cmp,
+                       npy_intp *kth, npy_intp nkth, void *varr, int *retp)
+{
+    part_ctx ctx;
+    int nthreads = npy_sort_nthreads();
+
+    if (nthreads <= 1 || num < NPY_SORT_PARALLEL_THRESHOLD ||
+            part == NULL || cmp == NULL || elsize <= 0 || nkth <= 0) {
+        return 0;
+    }
+
+    /* scratch space for the scatter passes; on failure select serially */
+    ctx.scratch = malloc(num * elsize);
+    if (ctx.scratch == NULL) {
+        return 0;
+    }
+    ctx.pivot = malloc(elsize);
+    if (ctx.pivot == NULL) {
+        free(ctx.scratch);
+        return 0;
+    }
+    ctx.start = start;
+    ctx.elsize = elsize;
+    ctx.part = part;
+    ctx.cmp = cmp;
+    ctx.varr = varr;
+    ctx.nthreads = nthreads;
+
+    *retp = parallel_select(&ctx, 0, num, kth, nkth, 0);
+
+    free(ctx.pivot);
+    free(ctx.scratch);
+
+    return 1;
+}
@@ -0,0 +1,27 @@
+#ifndef _NPY_PRIVATE__SORT_PARALLEL_H_
+#define _NPY_PRIVATE__SORT_PARALLEL_H_
+
+/*
+ * Sort num elements of size elsize at start, using the type specific
+ * sort for contiguous chunks and cmp to merge them.  Returns 1 if the
+ * parallel engine ran (with the sort status stored in *retp) and 0 if
+ * the caller should run the serial sort instead.
+ */
+NPY_NO_EXPORT int
+npy_parallel_sort(char *start, npy_intp num, npy_intp elsize,
+                  PyArray_SortFunc *sort, PyArray_CompareFunc *cmp,
+                  void *varr, int *retp);
+
+/*
+ * Partition num elements of size elsize at start around the sorted kth
+ * values, classifying around sampled pivots on multiple threads and
+ * using the type specific part for the small remainders.  Returns 1 if
+ * the parallel engine ran (with the partition status stored in *retp)
+ * and 0 if the caller should run the serial partition instead.
+ */
+NPY_NO_EXPORT int
+npy_parallel_partition(char *start, npy_intp num, npy_intp elsize,
+                       PyArray_PartitionFunc *part, PyArray_CompareFunc *cmp,
+                       npy_intp *kth, npy_intp nkth, void *varr, int *retp);
+
+#endif
@@ -0,0 +1,258 @@
+/*
+ * A reusable argsort of a key array.
+ *
+ * Pipelines that sort one key column and then apply the permutation to
+ * many value columns pay a fresh O(n log n) argsort per batch even when
+ * the keys rarely change.  A _SortIndex caches the stable permutation of
+ * its key array together with a checksum of the key bytes; indices() and
+ * take() revalidate with a single O(n) pass over the keys and only
+ * re-argsort when the checksum no longer matches, so the steady state
+ * cost is one scan plus one gather.
+ *
+ * The checksum cannot see every kind of mutation (a write that leaves
+ * the bytes unchanged is invisible, as it should be), but any change to
+ * the key bytes, the data pointer or the length invalidates the cache.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include "numpy/arrayobject.h"
+
+#include "npy_config.h"
+
+#include "npy_pycompat.h"
+
+#include "common.h"
+#include "conversion_utils.h"
+#include "sortindex.h"
+
+typedef struct {
+    PyObject_HEAD
+    PyArrayObject *keys;
+    PyArrayObject *perm;
+    npy_ulonglong tag;
+    NPY_SORTKIND kind;
+} PySortIndexObject;
+
+/*
+ * FNV-1a over the key bytes, seeded with the data pointer so a resized
+ * or reallocated key array never matches a stale tag.
+ */
+static npy_ulonglong
+sortindex_checksum(PyArrayObject *arr)
+{
+    const char *data = PyArray_DATA(arr);
+    const npy_intp n = PyArray_DIM(arr, 0);
+    const npy_intp stride = PyArray_STRIDE(arr, 0);
+    const npy_intp elsize = PyArray_ITEMSIZE(arr);
+    npy_ulonglong h = 14695981039346656037ULL ^ (npy_ulonglong)(npy_uintp)data;
+    npy_intp i, k;
+
+    NPY_BEGIN_ALLOW_THREADS;
+    for (i = 0; i < n; i++) {
+        const char *p = data + i*stride;
+
+        for (k = 0; k < elsize; k++) {
+            h = (h ^ (npy_ubyte)p[k]) * 1099511628211ULL;
+        }
+    }
+    NPY_END_ALLOW_THREADS;
+
+    return h;
+}
+
+/* recompute the permutation if the keys changed since it was taken */
+static int
+sortindex_refresh(PySortIndexObject *self)
+{
+    const npy_ulonglong tag = sortindex_checksum(self->keys);
+    PyObject *perm;
+
+    if (self->perm != NULL && tag == self->tag) {
+        return 0;
+    }
+    perm = PyArray_ArgSort(self->keys, 0, self->kind);
+    if (perm == NULL) {
+        return -1;
+    }
+    Py_XDECREF(self->perm);
+    self->perm = (PyArrayObject *)perm;
+    self->tag = tag;
+    return 0;
+}
+
+static PyObject *
+sortindex_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    PySortIndexObject *self;
+    PyObject *keys_obj;
+    PyArrayObject *keys;
+    NPY_SORTKIND kind = NPY_STABLESORT;
+    static char *kwlist[] = {"keys", "kind", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&:_SortIndex", kwlist,
+                                     &keys_obj,
+                                     PyArray_SortkindConverter, &kind)) {
+        return NULL;
+    }
+
+    keys = (PyArrayObject *)PyArray_FROM_O(keys_obj);
+    if (keys == NULL) {
+        return NULL;
+    }
+    if (PyArray_NDIM(keys) != 1) {
+        PyErr_SetString(PyExc_ValueError,
+                        "sort index keys must be 1-d");
+        Py_DECREF(keys);
+        return NULL;
+    }
+    if (PyDataType_REFCHK(PyArray_DESCR(keys))) {
+        PyErr_SetString(PyExc_TypeError,
+                        "sort index keys cannot contain objects");
+        Py_DECREF(keys);
+        return NULL;
+    }
+
+    self = (PySortIndexObject *)subtype->tp_alloc(subtype, 0);
+    if (self == NULL) {
+        Py_DECREF(keys);
+        return NULL;
+    }
+    self->keys = keys;
+    self->perm = NULL;
+    self->tag = 0;
+    self->kind = kind;
+
+    if (sortindex_refresh(self) < 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static void
+sortindex_dealloc(PySortIndexObject *self)
+{
+    Py_XDECREF(self->keys);
+    Py_XDECREF(self->perm);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *
+sortindex_indices(PySortIndexObject *self, PyObject *NPY_UNUSED(args))
+{
+    if (sortindex_refresh(self) < 0) {
+        return NULL;
+    }
+    Py_INCREF(self->perm);
+    return (PyObject *)self->perm;
+}
+
+static PyObject *
+sortindex_take(PySortIndexObject *self, PyObject *args, PyObject *kwds)
+{
+    PyArrayObject *values;
+    PyObject *ret;
+    int axis = -1;
+    static char *kwlist[] = {"values", "axis", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|i:take", kwlist,
+                                     PyArray_Converter, &values, &axis)) {
+        return NULL;
+    }
+    if (sortindex_refresh(self) < 0) {
+        Py_DECREF(values);
+        return NULL;
+    }
+    ret = PyArray_TakeFrom(values, (PyObject *)self->perm, axis,
+                           NULL, NPY_RAISE);
+    Py_DECREF(values);
+    return ret;
+}
+
+static PyObject *
+sortindex_keys_get(PySortIndexObject *self)
+{
+    Py_INCREF(self->keys);
+    return (PyObject *)self->keys;
+}
+
+static PyMethodDef sortindex_methods[] = {
+    {"indices",
+        (PyCFunction)sortindex_indices,
+        METH_NOARGS, NULL},
+    {"take",
+        (PyCFunction)sortindex_take,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {NULL, NULL, 0, NULL}           /* sentinel */
+};
+
+static PyGetSetDef sortindex_getsets[] = {
+    {"keys",
+        (getter)sortindex_keys_get,
+        NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* sentinel */
+};
+
+NPY_NO_EXPORT PyTypeObject PySortIndex_Type = {
+#if defined(NPY_PY3K)
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,                                          /* ob_size */
+#endif
+    "numpy.core.multiarray._SortIndex",         /* tp_name */
+    sizeof(PySortIndexObject),                  /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    /* methods */
+    (destructor)sortindex_dealloc,              /* tp_dealloc */
+    0,                                          /* tp_print */
+    0,                                          /* tp_getattr */
+    0,                                          /* tp_setattr */
+#if defined(NPY_PY3K)
+    0,                                          /* tp_reserved */
+#else
+    0,                                          /* tp_compare */
+#endif
+    0,                                          /* tp_repr */
+    0,                                          /* tp_as_number */
+    0,                                          /* tp_as_sequence */
+    0,                                          /* tp_as_mapping */
+    0,                                          /* tp_hash */
+    0,                                          /* tp_call */
+    0,                                          /* tp_str */
+    0,                                          /* tp_getattro */
+    0,                                          /* tp_setattro */
+    0,                                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+    0,                                          /* tp_doc */
+    0,                                          /* tp_traverse */
+    0,                                          /* tp_clear */
+    0,                                          /* tp_richcompare */
+    0,                                          /* tp_weaklistoffset */
+    0,                                          /* tp_iter */
+    0,                                          /* tp_iternext */
+    sortindex_methods,                          /* tp_methods */
+    0,                                          /* tp_members */
+    sortindex_getsets,                          /* tp_getset */
+    0,                                          /* tp_base */
+    0,                                          /* tp_dict */
+    0,                                          /* tp_descr_get */
+    0,                                          /* tp_descr_set */
+    0,                                          /* tp_dictoffset */
+    0,                                          /* tp_init */
+    0,                                          /* tp_alloc */
+    sortindex_new,                              /* tp_new */
+    0,                                          /* tp_free */
+    0,                                          /* tp_is_gc */
+    0,                                          /* tp_bases */
+    0,                                          /* tp_mro */
+    0,                                          /* tp_cache */
+    0,                                          /* tp_subclasses */
+    0,                                          /* tp_weaklist */
+    0,                                          /* tp_del */
+    0,                                          /* tp_version_tag */
+};
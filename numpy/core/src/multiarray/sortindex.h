@@ -0,0 +1,6 @@
+#ifndef _NPY_PRIVATE__SORTINDEX_H_
+#define _NPY_PRIVATE__SORTINDEX_H_
+
+NPY_NO_EXPORT extern PyTypeObject PySortIndex_Type;
+
+#endif
@@ -53,6 +53,12 @@
  * the lefthand side fails it can succeed on the righthand side by swapping the
  * arguments. E.g. b * (a * 2) can be elided by changing it to (2 * a) * b.
  *
+ * Embedding applications which guarantee that these protocols are only
+ * ever reached through the interpreter can set
+ * NPY_ELIDE_TRUSTED_CALLERS=1 to skip the stack walk entirely, making
+ * elision deterministic; NPY_ELIDE_MIN_BYTES can then also lower the
+ * size threshold, since the backtrace overhead it amortizes is gone.
+ *
  * TODO only supports systems with backtrace(), Windows can probably be
  * supported too by using the appropriate Windows APIs.
  */
@@ -87,6 +93,39 @@
 #include <dlfcn.h>
 #include <execinfo.h>
 
+/*
+ * returns non-zero when the embedder guarantees the number protocols
+ * are only reached through the cpython interpreter, so the backtrace
+ * heuristic can be skipped
+ */
+static NPY_INLINE int
+npy_elide_trusted_callers(void)
+{
+    static int trusted = -1;
+
+    if (trusted == -1) {
+        char *env = getenv("NPY_ELIDE_TRUSTED_CALLERS");
+        trusted = (env != NULL && env[0] != '\0' && env[0] != '0');
+    }
+    return trusted;
+}
+
+/* elision size threshold, tunable for trusted-caller setups */
+static NPY_INLINE npy_intp
+npy_elide_min_bytes(void)
+{
+    static npy_intp min_bytes = -1;
+
+    if (min_bytes == -1) {
+        char *env = getenv("NPY_ELIDE_MIN_BYTES");
+        min_bytes = NPY_MIN_ELIDE_BYTES;
+        if (env != NULL && env[0] != '\0') {
+            min_bytes = (npy_intp)strtol(env, NULL, 10);
+        }
+    }
+    return min_bytes;
+}
+
 /*
  * linear search pointer in table
  * number of pointers is usually quite small but if a performance impact can be
@@ -139,6 +178,11 @@ check_callers(int * cannot)
     void *buffer[NPY_MAX_STACKSIZE];
     int i, nptrs;
     int ok = 0;
+    /* the embedder vouches for all callers, no need to look */
+    if (npy_elide_trusted_callers()) {
+        *cannot = 0;
+        return 1;
+    }
     /* cannot determine callers */
     if (init == -1) {
         *cannot = 1;
@@ -290,7 +334,7 @@ can_elide_temp(PyArrayObject * alhs, PyObject * orhs, int * cannot)
             !PyArray_ISWRITEABLE(alhs) ||
             PyArray_CHKFLAGS(alhs, NPY_ARRAY_UPDATEIFCOPY) ||
             PyArray_CHKFLAGS(alhs, NPY_ARRAY_WRITEBACKIFCOPY) ||
-            PyArray_NBYTES(alhs) < NPY_MIN_ELIDE_BYTES) {
+            PyArray_NBYTES(alhs) < npy_elide_min_bytes()) {
         return 0;
     }
     if (PyArray_CheckExact(orhs) ||
@@ -368,7 +412,7 @@ can_elide_temp_unary(PyArrayObject * m1)
             !PyArray_CHKFLAGS(m1, NPY_ARRAY_OWNDATA) ||
             !PyArray_ISWRITEABLE(m1) ||
             PyArray_CHKFLAGS(m1, NPY_ARRAY_UPDATEIFCOPY) ||
-            PyArray_NBYTES(m1) < NPY_MIN_ELIDE_BYTES) {
+            PyArray_NBYTES(m1) < npy_elide_min_bytes()) {
         return 0;
     }
     if (check_callers(&cannot)) {
@@ -0,0 +1,182 @@
+/*
+ * Bulk UCS4 <-> UTF-8 transcoding for unicode arrays.
+ *
+ * The per-element conversions in arraytypes go through PyUnicode objects
+ * one item at a time; serializing a large U column that way is dominated
+ * by object churn.  These kernels run over raw buffers and take a
+ * word-at-a-time fast path through ASCII runs, which dominate typical
+ * columns.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include "numpy/arrayobject.h"
+
+#include "npy_config.h"
+
+#include "unicode_codec.h"
+
+NPY_NO_EXPORT npy_intp
+npy_utf8_encoded_size(const npy_ucs4 *src, npy_intp nchars)
+{
+    npy_intp i = 0, size = 0;
+
+    while (i < nchars) {
+        npy_ucs4 c;
+
+        /* runs of ASCII are one byte each */
+        while (nchars - i >= 4 &&
+                ((src[i] | src[i + 1] | src[i + 2] | src[i + 3]) < 0x80)) {
+            size += 4;
+            i += 4;
+        }
+        if (i >= nchars) {
+            break;
+        }
+        c = src[i++];
+        if (c < 0x80) {
+            size += 1;
+        }
+        else if (c < 0x800) {
+            size += 2;
+        }
+        else if (c < 0x10000) {
+            size += 3;
+        }
+        else if (c <= 0x10FFFF) {
+            size += 4;
+        }
+        else {
+            return -1;
+        }
+    }
+    return size;
+}
+
+NPY_NO_EXPORT npy_intp
+npy_utf8_encode_ucs4(const npy_ucs4 *src, npy_intp nchars, char *dst)
+{
+    char *p = dst;
+    npy_intp i = 0;
+
+    while (i < nchars) {
+        npy_ucs4 c;
+
+        while (nchars - i >= 4 &&
+                ((src[i] | src[i + 1] | src[i + 2] | src[i + 3]) < 0x80)) {
+            p[0] = (char)src[i];
+            p[1] = (char)src[i + 1];
+            p[2] = (char)src[i + 2];
+            p[3] = (char)src[i + 3];
+            p += 4;
+            i += 4;
+        }
+        if (i >= nchars) {
+            break;
+        }
+        c = src[i++];
+        if (c < 0x80) {
+            *p++ = (char)c;
+        }
+        else if (c < 0x800) {
+            *p++ = (char)(0xC0 | (c >> 6));
+            *p++ = (char)(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000) {
+            *p++ = (char)(0xE0 | (c >> 12));
+            *p++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *p++ = (char)(0x80 | (c & 0x3F));
+        }
+        else {
+            *p++ = (char)(0xF0 | (c >> 18));
+            *p++ = (char)(0x80 | ((c >> 12) & 0x3F));
+            *p++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *p++ = (char)(0x80 | (c & 0x3F));
+        }
+    }
+    return p - dst;
+}
+
+NPY_NO_EXPORT npy_intp
+npy_utf8_decode_ucs4(const char *src, npy_intp nbytes,
+                     npy_ucs4 *dst, npy_intp maxchars)
+{
+    const unsigned char *s = (const unsigned char *)src;
+    const unsigned char *end = s + nbytes;
+    npy_intp n = 0;
+
+    while (s < end) {
+        unsigned char b;
+        npy_ucs4 c, cmin;
+        int extra;
+
+        /* a whole word of ASCII decodes to one code point per byte */
+        while (end - s >= 8 && (maxchars < 0 || maxchars - n >= 8)) {
+            npy_uint64 w;
+
+            memcpy(&w, s, 8);
+            if (w & 0x8080808080808080ULL) {
+                break;
+            }
+            if (dst != NULL) {
+                int k;
+
+                for (k = 0; k < 8; k++) {
+                    dst[n + k] = s[k];
+                }
+            }
+            n += 8;
+            s += 8;
+        }
+        if (s >= end) {
+            break;
+        }
+        b = *s++;
+        if (b < 0x80) {
+            c = b;
+            extra = 0;
+            cmin = 0;
+        }
+        else if ((b & 0xE0) == 0xC0) {
+            c = b & 0x1F;
+            extra = 1;
+            cmin = 0x80;
+        }
+        else if ((b & 0xF0) == 0xE0) {
+            c = b & 0x0F;
+            extra = 2;
+            cmin = 0x800;
+        }
+        else if ((b & 0xF8) == 0xF0) {
+            c = b & 0x07;
+            extra = 3;
+            cmin = 0x10000;
+        }
+        else {
+            return -1;
+        }
+        if (end - s < extra) {
+            return -1;
+        }
+        while (extra-- > 0) {
+            if ((*s & 0xC0) != 0x80) {
+                return -1;
+            }
+            c = (c << 6) | (*s++ & 0x3F);
+        }
+        /* reject overlong forms and out-of-range code points */
+        if (c < cmin || c > 0x10FFFF) {
+            return -1;
+        }
+        if (maxchars >= 0 && n >= maxchars) {
+            return -2;
+        }
+        if (dst != NULL) {
+            dst[n] = c;
+        }
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,36 @@
+#ifndef _NPY_UNICODE_CODEC_H_
+#define _NPY_UNICODE_CODEC_H_
+
+/*
+ * Bulk transcoding kernels between the UCS4 storage of unicode arrays
+ * and UTF-8 byte buffers.  Surrogate code points round-trip unchanged
+ * (as with Python's 'surrogatepass'); code points above 0x10FFFF cannot
+ * be represented and are reported as errors.
+ */
+
+/*
+ * Number of UTF-8 bytes needed for nchars UCS4 code points, or -1 if a
+ * code point cannot be encoded.
+ */
+NPY_NO_EXPORT npy_intp
+npy_utf8_encoded_size(const npy_ucs4 *src, npy_intp nchars);
+
+/*
+ * Encode nchars UCS4 code points into dst, which must have room for
+ * npy_utf8_encoded_size(src, nchars) bytes.  Returns the number of
+ * bytes written.
+ */
+NPY_NO_EXPORT npy_intp
+npy_utf8_encode_ucs4(const npy_ucs4 *src, npy_intp nchars, char *dst);
+
+/*
+ * Decode nbytes of UTF-8 into dst.  Returns the number of code points,
+ * -1 for malformed input or -2 when the output would exceed maxchars.
+ * dst may be NULL to validate and count only; maxchars < 0 means no
+ * limit.
+ */
+NPY_NO_EXPORT npy_intp
+npy_utf8_decode_ucs4(const char *src, npy_intp nbytes,
+                     npy_ucs4 *dst, npy_intp maxchars);
+
+#endif
@@ -1,6 +1,7 @@
 #define _UMATHMODULE
 #define _MULTIARRAYMODULE
 #define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define PY_SSIZE_T_CLEAN
 
 #include <Python.h>
 
@@ -66,6 +67,14 @@ npy_cpu_supports(const char * feature)
     else if (strcmp(feature, "avx2") == 0) {
         return __builtin_cpu_supports("avx2") && os_avx_support();
     }
+    else if (strcmp(feature, "f16c") == 0) {
+#if defined(__GNUC__) && (__GNUC__ < 5)
+        return 0;
+#else
+        return __builtin_cpu_supports("f16c") &&
+               __builtin_cpu_supports("avx") && os_avx_support();
+#endif
+    }
     else if (strcmp(feature, "avx") == 0) {
         return __builtin_cpu_supports("avx") && os_avx_support();
     }
@@ -73,3 +82,105 @@ npy_cpu_supports(const char * feature)
 
     return 0;
 }
+
+
+/*
+ * Registry of the vector inner-loop variants installed at module
+ * initialization.  Heterogeneous fleets need a way to see, per
+ * machine, which loops actually run vectorized and which silently
+ * fell back to the default implementation; the generated
+ * InitOperators records every replacement here as it makes it.
+ */
+#define NPY_SIMD_VARIANT_SLOTS 512
+#define NPY_SIMD_VARIANT_NAMELEN 32
+
+typedef struct {
+    char name[NPY_SIMD_VARIANT_NAMELEN];
+    char typechar;
+    char isa[16];
+} npy_simd_variant;
+
+static npy_simd_variant variant_slots[NPY_SIMD_VARIANT_SLOTS];
+static int variant_n = 0;
+
+NPY_NO_EXPORT void
+npy_register_simd_variant(const char *ufunc_name, int typechar,
+                          const char *isa)
+{
+    npy_simd_variant *slot;
+
+    if (variant_n >= NPY_SIMD_VARIANT_SLOTS) {
+        return;
+    }
+    slot = &variant_slots[variant_n++];
+    strncpy(slot->name, ufunc_name, NPY_SIMD_VARIANT_NAMELEN - 1);
+    slot->name[NPY_SIMD_VARIANT_NAMELEN - 1] = '\0';
+    slot->typechar = (char)typechar;
+    strncpy(slot->isa, isa, sizeof(slot->isa) - 1);
+    slot->isa[sizeof(slot->isa) - 1] = '\0';
+}
+
+/* the features a loop variant can currently be conditioned on */
+static const char *npy_cpu_feature_names[] = {
+    "avx512f", "avx2", "avx", "f16c", NULL
+};
+
+NPY_NO_EXPORT PyObject *
+cpu_features_get(PyObject *NPY_UNUSED(dummy), PyObject *NPY_UNUSED(args))
+{
+    PyObject *dict = PyDict_New();
+    const char **name;
+
+    if (dict == NULL) {
+        return NULL;
+    }
+    for (name = npy_cpu_feature_names; *name != NULL; name++) {
+        PyObject *flag = PyBool_FromLong(npy_cpu_supports(*name));
+
+        if (flag == NULL || PyDict_SetItemString(dict, *name, flag) < 0) {
+            Py_XDECREF(flag);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(flag);
+    }
+    {
+        /* the compiled-in baseline, not a runtime probe */
+#ifdef NPY_HAVE_SSE2_INTRINSICS
+        PyObject *flag = PyBool_FromLong(1);
+#else
+        PyObject *flag = PyBool_FromLong(0);
+#endif
+        if (flag == NULL || PyDict_SetItemString(dict, "sse2", flag) < 0) {
+            Py_XDECREF(flag);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(flag);
+    }
+    return dict;
+}
+
+NPY_NO_EXPORT PyObject *
+simd_dispatch_get(PyObject *NPY_UNUSED(dummy), PyObject *NPY_UNUSED(args))
+{
+    PyObject *list = PyList_New(variant_n);
+    int i;
+
+    if (list == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < variant_n; i++) {
+        npy_simd_variant *slot = &variant_slots[i];
+        PyObject *item = Py_BuildValue("(ss#s)", slot->name,
+                                       &slot->typechar, (Py_ssize_t)1,
+                                       slot->isa);
+
+        if (item == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
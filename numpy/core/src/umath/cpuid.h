@@ -6,4 +6,23 @@
 NPY_NO_EXPORT int
 npy_cpu_supports(const char * feature);
 
+/*
+ * Record that the vector variant of a ufunc inner loop was installed
+ * at module initialization, so _simd_dispatch_info can report it.
+ * Called from the generated InitOperators; typechar is the dtype
+ * character of the loop, isa the instruction set of the variant.
+ */
+NPY_NO_EXPORT void
+npy_register_simd_variant(const char *ufunc_name, int typechar,
+                          const char *isa);
+
+/* _cpu_features() -> dict of detected CPU feature flags */
+NPY_NO_EXPORT PyObject *
+cpu_features_get(PyObject *dummy, PyObject *args);
+
+/* _simd_dispatch_info() -> list of (ufunc, typechar, isa) for every
+ * inner loop where a vector variant replaced the default one */
+NPY_NO_EXPORT PyObject *
+simd_dispatch_get(PyObject *dummy, PyObject *args);
+
 #endif
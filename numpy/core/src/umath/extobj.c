@@ -49,6 +49,26 @@ ufunc_update_use_defaults(void)
 }
 #endif
 
+/*
+ * Incremented whenever a thread replaces its ufunc pyvals via seterrobj.
+ * Thread local caches of the extracted values compare against this to
+ * know when they are stale, which lets the scalar math fast paths skip
+ * the thread dict lookup entirely while the errstate is unchanged.
+ */
+static npy_intp ufunc_pyvals_generation = 0;
+
+NPY_NO_EXPORT npy_intp
+npy_ufunc_pyvals_generation(void)
+{
+    return ufunc_pyvals_generation;
+}
+
+NPY_NO_EXPORT void
+npy_ufunc_pyvals_bump_generation(void)
+{
+    ufunc_pyvals_generation++;
+}
+
 /*
  * fpstatus is the ufunc_formatted hardware status
  * errmask is the handling mask specified by the user.
@@ -20,6 +20,12 @@ NPY_NO_EXPORT int
 _get_bufsize_errmask(PyObject * extobj, const char *ufunc_name,
                      int *buffersize, int *errormask);
 
+NPY_NO_EXPORT npy_intp
+npy_ufunc_pyvals_generation(void);
+
+NPY_NO_EXPORT void
+npy_ufunc_pyvals_bump_generation(void);
+
 /********************/
 #define USE_USE_DEFAULTS 1
 /********************/
@@ -114,9 +114,10 @@ typedef int (PyArray_ReduceLoopFunc)(NpyIter *iter,
  *
  * operand     : The array to be reduced.
  * out         : NULL, or the array into which to place the result.
- * wheremask   : NOT YET SUPPORTED, but this parameter is placed here
- *               so that support can be added in the future without breaking
- *               API compatibility. Pass in NULL.
+ * wheremask   : NULL, or a boolean mask specifying which elements to
+ *               include in the reduction. It is added as an extra iterator
+ *               operand, so the loop can reduce unmasked runs in place
+ *               without compressing the operand into a temporary.
  * operand_dtype : The dtype the inner loop expects for the operand.
  * result_dtype : The dtype the inner loop expects for the result.
  * casting     : The casting rule to apply to the operands.
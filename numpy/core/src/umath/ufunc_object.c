@@ -40,8 +40,11 @@
 #include "ufunc_type_resolution.h"
 #include "reduction.h"
 #include "mem_overlap.h"
+#include "array_assign.h"
 
 #include "ufunc_object.h"
+#include "ufunc_parallel.h"
+#include "ufunc_stats.h"
 #include "override.h"
 #include "npy_import.h"
 #include "extobj.h"
@@ -1346,6 +1349,10 @@ trivial_two_operand_loop(PyArrayObject **op,
     NPY_UF_DBG_PRINT1("two operand loop count %d\n", (int)count[0]);
 
     if (!needs_api) {
+        if (npy_ufunc_parallel_run(innerloop, innerloopdata,
+                                   2, data, count, stride)) {
+            return;
+        }
         NPY_BEGIN_THREADS_THRESHOLDED(count[0]);
     }
 
@@ -1377,6 +1384,49 @@ trivial_three_operand_loop(PyArrayObject **op,
     NPY_UF_DBG_PRINT1("three operand loop count %d\n", (int)count[0]);
 
     if (!needs_api) {
+        if (npy_ufunc_parallel_run(innerloop, innerloopdata,
+                                   3, data, count, stride)) {
+            return;
+        }
+        NPY_BEGIN_THREADS_THRESHOLDED(count[0]);
+    }
+
+    innerloop(data, count, stride, innerloopdata);
+
+    NPY_END_THREADS;
+}
+
+static void
+trivial_four_operand_loop(PyArrayObject **op,
+                    PyUFuncGenericFunction innerloop,
+                    void *innerloopdata)
+{
+    char *data[4];
+    npy_intp count[4], stride[4];
+    int needs_api;
+    NPY_BEGIN_THREADS_DEF;
+
+    needs_api = PyDataType_REFCHK(PyArray_DESCR(op[0])) ||
+                PyDataType_REFCHK(PyArray_DESCR(op[1])) ||
+                PyDataType_REFCHK(PyArray_DESCR(op[2])) ||
+                PyDataType_REFCHK(PyArray_DESCR(op[3]));
+
+    PyArray_PREPARE_TRIVIAL_QUAD_ITERATION(op[0], op[1], op[2], op[3],
+                                            count[0],
+                                            data[0], data[1],
+                                            data[2], data[3],
+                                            stride[0], stride[1],
+                                            stride[2], stride[3]);
+    count[1] = count[0];
+    count[2] = count[0];
+    count[3] = count[0];
+    NPY_UF_DBG_PRINT1("four operand loop count %d\n", (int)count[0]);
+
+    if (!needs_api) {
+        if (npy_ufunc_parallel_run(innerloop, innerloopdata,
+                                   4, data, count, stride)) {
+            return;
+        }
         NPY_BEGIN_THREADS_THRESHOLDED(count[0]);
     }
 
@@ -1385,6 +1435,162 @@ trivial_three_operand_loop(PyArrayObject **op,
     NPY_END_THREADS;
 }
 
+/*
+ * Runs a trivial elementwise loop whose only type conversion is on the
+ * provided output: the inner loop computes chunks of 'buffersize'
+ * elements into a small temporary, and a dtype_transfer function
+ * stores them cast into 'out'.  This avoids the full iterator (and
+ * its per-chunk input buffering) for the common 'out=' pattern where
+ * only the output dtype differs, e.g. float64 math stored to a
+ * preallocated float32 array.
+ *
+ * Returns 1 if it handled the operation, 0 if the operands don't
+ * qualify, and -1 (with an exception set) on error.
+ */
+static int
+try_trivial_cast_output_loop(PyUFuncObject *ufunc,
+                    PyArrayObject **op,
+                    PyArray_Descr **dtypes,
+                    npy_intp buffersize,
+                    PyObject **arr_prep,
+                    PyUFuncGenericFunction innerloop,
+                    void *innerloopdata,
+                    int needs_api)
+{
+    int nin = ufunc->nin, i;
+    PyArrayObject *out;
+    PyArray_Descr *out_descr;
+    char *data[3], *dst_data, *castbuf;
+    npy_intp count[3], stride[3], dst_stride;
+    npy_intp n, elsize;
+    PyArray_StridedUnaryOp *stransfer = NULL;
+    NpyAuxData *transferdata = NULL;
+    int needs_api_transfer = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (ufunc->nout != 1 || (nin != 1 && nin != 2) || needs_api) {
+        return 0;
+    }
+    out = op[nin];
+    if (out == NULL || !PyArray_ISALIGNED(out)) {
+        return 0;
+    }
+    out_descr = PyArray_DESCR(out);
+    /* Only the output may need conversion here */
+    if (PyArray_EquivTypes(out_descr, dtypes[nin])) {
+        return 0;
+    }
+    if (PyDataType_REFCHK(out_descr) || PyDataType_REFCHK(dtypes[nin])) {
+        return 0;
+    }
+    /* __array_prepare__ takes the general path */
+    if (arr_prep[0] != NULL && arr_prep[0] != Py_None) {
+        return 0;
+    }
+    for (i = 0; i < nin; ++i) {
+        if (!PyArray_ISALIGNED(op[i]) ||
+                !PyArray_EquivTypes(dtypes[i], PyArray_DESCR(op[i]))) {
+            return 0;
+        }
+        /*
+         * Chunks are stored to 'out' as they are computed, so any
+         * memory sharing with an input needs the copying iterator.
+         */
+        if (arrays_overlap(op[i], out)) {
+            return 0;
+        }
+    }
+
+    if (nin == 1) {
+        if (PyArray_NDIM(out) < PyArray_NDIM(op[0]) ||
+                !PyArray_TRIVIALLY_ITERABLE_PAIR(op[0], out,
+                                    PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                    PyArray_TRIVIALLY_ITERABLE_OP_NOREAD)) {
+            return 0;
+        }
+        PyArray_PREPARE_TRIVIAL_PAIR_ITERATION(op[0], out,
+                                                n,
+                                                data[0], dst_data,
+                                                stride[0], dst_stride);
+    }
+    else {
+        if (PyArray_NDIM(out) < PyArray_NDIM(op[0]) ||
+                PyArray_NDIM(out) < PyArray_NDIM(op[1]) ||
+                !PyArray_TRIVIALLY_ITERABLE_TRIPLE(op[0], op[1], out,
+                                    PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                    PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                    PyArray_TRIVIALLY_ITERABLE_OP_NOREAD)) {
+            return 0;
+        }
+        PyArray_PREPARE_TRIVIAL_TRIPLE_ITERATION(op[0], op[1], out,
+                                                n,
+                                                data[0], data[1], dst_data,
+                                                stride[0], stride[1],
+                                                dst_stride);
+    }
+
+    NPY_UF_DBG_PRINT1("cast-on-store output loop count %d\n", (int)n);
+
+    if (n == 0) {
+        return 1;
+    }
+
+    elsize = dtypes[nin]->elsize;
+    if (PyArray_GetDTypeTransferFunction(1,
+                        elsize, dst_stride,
+                        dtypes[nin], out_descr,
+                        0,
+                        &stransfer, &transferdata,
+                        &needs_api_transfer) != NPY_SUCCEED) {
+        return -1;
+    }
+    if (needs_api_transfer) {
+        NPY_AUXDATA_FREE(transferdata);
+        return 0;
+    }
+
+    castbuf = PyArray_malloc(buffersize * elsize);
+    if (castbuf == NULL) {
+        NPY_AUXDATA_FREE(transferdata);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    NPY_BEGIN_THREADS_THRESHOLDED(n);
+    while (n > 0) {
+        npy_intp chunk = (n < buffersize) ? n : buffersize;
+        char *chunk_data[3];
+        npy_intp chunk_stride[3];
+
+        chunk_data[0] = data[0];
+        chunk_stride[0] = stride[0];
+        if (nin == 2) {
+            chunk_data[1] = data[1];
+            chunk_stride[1] = stride[1];
+        }
+        chunk_data[nin] = castbuf;
+        chunk_stride[nin] = elsize;
+        count[0] = chunk;
+        count[1] = chunk;
+        count[2] = chunk;
+
+        innerloop(chunk_data, count, chunk_stride, innerloopdata);
+        stransfer(dst_data, dst_stride, castbuf, elsize,
+                  chunk, elsize, transferdata);
+
+        for (i = 0; i < nin; ++i) {
+            data[i] += chunk * stride[i];
+        }
+        dst_data += chunk * dst_stride;
+        n -= chunk;
+    }
+    NPY_END_THREADS;
+
+    PyArray_free(castbuf);
+    NPY_AUXDATA_FREE(transferdata);
+    return 1;
+}
+
 /*
  * Calls the given __array_prepare__ function on the operand *op,
  * substituting it in place if a new array is returned and matches
@@ -1728,11 +1934,89 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
                 NPY_UF_DBG_PRINT("trivial 2 input\n");
                 trivial_three_operand_loop(op, innerloop, innerloopdata);
 
+                return 0;
+            }
+        }
+        else if (nin == 3 && nout == 1) {
+            if (op[3] == NULL &&
+                        (order == NPY_ANYORDER || order == NPY_KEEPORDER) &&
+                        PyArray_TRIVIALLY_ITERABLE_TRIPLE(op[0], op[1], op[2],
+                                                        PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                                        PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                                        PyArray_TRIVIALLY_ITERABLE_OP_READ)) {
+                PyArrayObject *tmp;
+                /*
+                 * Have to choose the input with more dimensions to clone, as
+                 * some of them could be scalars.
+                 */
+                tmp = op[0];
+                if (PyArray_NDIM(op[1]) > PyArray_NDIM(tmp)) {
+                    tmp = op[1];
+                }
+                if (PyArray_NDIM(op[2]) > PyArray_NDIM(tmp)) {
+                    tmp = op[2];
+                }
+                Py_INCREF(dtypes[3]);
+                op[3] = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+                                 dtypes[3],
+                                 PyArray_NDIM(tmp),
+                                 PyArray_DIMS(tmp),
+                                 NULL, NULL,
+                                 PyArray_ISFORTRAN(tmp) ?
+                                                NPY_ARRAY_F_CONTIGUOUS : 0,
+                                 NULL);
+                if (op[3] == NULL) {
+                    return -1;
+                }
+
+                /* Call the __prepare_array__ if necessary */
+                if (prepare_ufunc_output(ufunc, &op[3],
+                                    arr_prep[0], full_args, 0) < 0) {
+                    return -1;
+                }
+
+                NPY_UF_DBG_PRINT("trivial 3 input with allocated output\n");
+                trivial_four_operand_loop(op, innerloop, innerloopdata);
+
+                return 0;
+            }
+            else if (op[3] != NULL &&
+                    PyArray_NDIM(op[3]) >= PyArray_NDIM(op[0]) &&
+                    PyArray_NDIM(op[3]) >= PyArray_NDIM(op[1]) &&
+                    PyArray_NDIM(op[3]) >= PyArray_NDIM(op[2]) &&
+                    PyArray_TRIVIALLY_ITERABLE_QUAD(op[0], op[1], op[2], op[3],
+                                                      PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                                      PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                                      PyArray_TRIVIALLY_ITERABLE_OP_READ,
+                                                      PyArray_TRIVIALLY_ITERABLE_OP_NOREAD)) {
+
+                /* Call the __prepare_array__ if necessary */
+                if (prepare_ufunc_output(ufunc, &op[3],
+                                    arr_prep[0], full_args, 0) < 0) {
+                    return -1;
+                }
+
+                NPY_UF_DBG_PRINT("trivial 3 input\n");
+                trivial_four_operand_loop(op, innerloop, innerloopdata);
+
                 return 0;
             }
         }
     }
 
+    /*
+     * If only the provided output needs a dtype conversion, compute
+     * into a small temporary and cast on store, skipping the iterator.
+     */
+    {
+        int res = try_trivial_cast_output_loop(ufunc, op, dtypes,
+                        buffersize, arr_prep, innerloop, innerloopdata,
+                        needs_api);
+        if (res != 0) {
+            return (res < 0) ? -1 : 0;
+        }
+    }
+
     /*
      * If no trivial loop matched, an iterator is required to
      * resolve broadcasting, etc
@@ -2525,6 +2809,7 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     const char *ufunc_name;
     int retval, subok = 1;
     int needs_api = 0;
+    npy_uint64 stats_t0 = 0;
 
     PyArray_Descr *dtypes[NPY_MAXARGS];
 
@@ -2581,6 +2866,10 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
 
     ufunc_name = ufunc_get_name_cstr(ufunc);
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled)) {
+        stats_t0 = npy_ufunc_stats_now();
+    }
+
     NPY_UF_DBG_PRINT1("\nEvaluating ufunc %s\n", ufunc_name);
 
     /* Initialize all dtypes and __array_prepare__ call-backs to NULL */
@@ -3052,6 +3341,17 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
         retval = -1;
     }
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled)) {
+        char stats_sig[NPY_MAXARGS + 8];
+
+        for (i = 0; i < nop; ++i) {
+            stats_sig[i] = (dtypes[i] != NULL) ? dtypes[i]->type : '?';
+        }
+        stats_sig[nop] = '\0';
+        npy_ufunc_stats_record(ufunc_name, stats_sig,
+                               PyArray_SIZE(op[nin]), stats_t0);
+    }
+
     /* The caller takes ownership of all the references in op */
     for (i = 0; i < nop; ++i) {
         Py_XDECREF(dtypes[i]);
@@ -3109,6 +3409,7 @@ PyUFunc_GenericFunction(PyUFuncObject *ufunc,
     int retval = -1, subok = 1;
     npy_uint32 op_flags[NPY_MAXARGS];
     npy_intp default_op_out_flags;
+    npy_uint64 stats_t0 = 0;
 
     PyArray_Descr *dtypes[NPY_MAXARGS];
 
@@ -3148,6 +3449,10 @@ PyUFunc_GenericFunction(PyUFuncObject *ufunc,
 
     ufunc_name = ufunc_get_name_cstr(ufunc);
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled)) {
+        stats_t0 = npy_ufunc_stats_now();
+    }
+
     NPY_UF_DBG_PRINT1("\nEvaluating ufunc %s\n", ufunc_name);
 
     /* Initialize all the dtypes and __array_prepare__ callbacks to NULL */
@@ -3275,6 +3580,17 @@ PyUFunc_GenericFunction(PyUFuncObject *ufunc,
     }
 
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled)) {
+        char stats_sig[NPY_MAXARGS + 8];
+
+        for (i = 0; i < nop; ++i) {
+            stats_sig[i] = (dtypes[i] != NULL) ? dtypes[i]->type : '?';
+        }
+        stats_sig[nop] = '\0';
+        npy_ufunc_stats_record(ufunc_name, stats_sig,
+                               PyArray_SIZE(op[nin]), stats_t0);
+    }
+
     /* The caller takes ownership of all the references in op */
     for (i = 0; i < nop; ++i) {
         Py_XDECREF(dtypes[i]);
@@ -3459,6 +3775,48 @@ reduce_type_resolver(PyUFuncObject *ufunc, PyArrayObject *arr,
     return 0;
 }
 
+/* one accumulator row of the pairwise row panel, in bytes */
+#define NPY_REDUCE_PANEL_ROW_BYTES 65536
+/* rows per panel; folding 8 streams mirrors the pairwise_sum unroll */
+#define NPY_REDUCE_PANEL_ROWS 8
+
+/*
+ * Folds the seeded accumulator rows of a pairwise row panel into the
+ * output row, tree-wise (0+1, 2+3, ... then 0+2, ...) followed by one
+ * strided combine into the accumulator. Each combine reuses the reduce
+ * inner loop, so this works for any reorderable reduction.
+ */
+static void
+reduce_panel_flush(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                   char *panel, npy_intp nrows, npy_intp count,
+                   npy_intp elsize, char *acc, npy_intp acc_stride)
+{
+    char *dataptrs[3];
+    npy_intp strides[3];
+    npy_intp gap, k, n;
+
+    for (gap = 1; gap < nrows; gap *= 2) {
+        for (k = 0; k + gap < nrows; k += 2 * gap) {
+            n = count;
+            dataptrs[0] = panel + k * NPY_REDUCE_PANEL_ROW_BYTES;
+            dataptrs[1] = panel + (k + gap) * NPY_REDUCE_PANEL_ROW_BYTES;
+            dataptrs[2] = dataptrs[0];
+            strides[0] = elsize;
+            strides[1] = elsize;
+            strides[2] = elsize;
+            innerloop(dataptrs, &n, strides, innerloopdata);
+        }
+    }
+    n = count;
+    dataptrs[0] = acc;
+    dataptrs[1] = panel;
+    dataptrs[2] = acc;
+    strides[0] = acc_stride;
+    strides[1] = elsize;
+    strides[2] = acc_stride;
+    innerloop(dataptrs, &n, strides, innerloopdata);
+}
+
 static int
 reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
             npy_intp *countptr, NpyIter_IterNextFunc *iternext,
@@ -3468,7 +3826,24 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
     PyUFuncObject *ufunc = (PyUFuncObject *)data;
     char *dataptrs_copy[3];
     npy_intp strides_copy[3];
-    npy_bool masked;
+    npy_bool masked, reorderable;
+
+    /*
+     * Pairwise row-panel state for axis reductions: up to
+     * NPY_REDUCE_PANEL_ROWS rows are accumulated into independent
+     * output-width streams and folded tree-wise into the output row,
+     * cutting the rounding error of long column sums and keeping the
+     * working set cache-resident.
+     */
+    char *panel = NULL;
+    char *panel_acc = NULL;
+    npy_intp panel_acc_stride = 0;
+    npy_intp panel_count = 0;
+    npy_intp panel_rows = 0;
+    npy_intp panel_next = 0;
+    npy_intp elsize;
+    char *res_data;
+    npy_intp res_nbytes;
 
     /* The normal selected inner loop */
     PyUFuncGenericFunction innerloop = NULL;
@@ -3477,6 +3852,8 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
     NPY_BEGIN_THREADS_DEF;
     /* Get the number of operands, to determine whether "where" is used */
     masked = (NpyIter_GetNOp(iter) == 3);
+    /* Only reorderable reductions may be chunked across threads */
+    reorderable = (ufunc->identity != PyUFunc_None);
 
     /* Get the inner loop */
     iter_dtypes = NpyIter_GetDescrArray(iter);
@@ -3487,6 +3864,15 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
                             &innerloop, &innerloopdata, &needs_api) < 0) {
         return -1;
     }
+    elsize = dtypes[0]->elsize;
+
+    /*
+     * The row panel defers accumulator writes, which is only valid when
+     * the accumulator pointer is the result array itself and not an
+     * iterator buffer that is written back between inner runs.
+     */
+    res_data = PyArray_BYTES(NpyIter_GetOperandArray(iter)[0]);
+    res_nbytes = PyArray_NBYTES(NpyIter_GetOperandArray(iter)[0]);
 
     NPY_BEGIN_THREADS_NDITER(iter);
 
@@ -3538,37 +3924,136 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
         strides_copy[2] = strides[0];
 
         if (!masked) {
-            innerloop(dataptrs_copy, countptr,
-                      strides_copy, innerloopdata);
+            int handled = 0;
+
+            if (!needs_api && reorderable && strides_copy[0] != 0 &&
+                    strides_copy[0] == strides_copy[2] &&
+                    *countptr > 0 &&
+                    *countptr * elsize <= NPY_REDUCE_PANEL_ROW_BYTES &&
+                    dataptrs[0] >= res_data &&
+                    dataptrs[0] < res_data + res_nbytes) {
+                /*
+                 * Axis reduction (moving accumulator): route this row
+                 * into the pairwise row panel for its output row.
+                 */
+                npy_intp count = *countptr;
+
+                if (panel_rows > 0 && (dataptrs[0] != panel_acc ||
+                                       count != panel_count)) {
+                    reduce_panel_flush(innerloop, innerloopdata, panel,
+                                       panel_rows, panel_count, elsize,
+                                       panel_acc, panel_acc_stride);
+                    panel_rows = 0;
+                    panel_next = 0;
+                }
+                if (panel == NULL) {
+                    panel = malloc(NPY_REDUCE_PANEL_ROWS *
+                                   NPY_REDUCE_PANEL_ROW_BYTES);
+                }
+                if (panel != NULL) {
+                    char *slot = panel + panel_next *
+                                 NPY_REDUCE_PANEL_ROW_BYTES;
+
+                    if (panel_rows == 0) {
+                        panel_acc = dataptrs[0];
+                        panel_acc_stride = strides_copy[0];
+                        panel_count = count;
+                    }
+                    if (panel_next < panel_rows) {
+                        /* slot already seeded, accumulate into it */
+                        char *pdata[3];
+                        npy_intp pstrides[3];
+
+                        pdata[0] = slot;
+                        pdata[1] = dataptrs[1];
+                        pdata[2] = slot;
+                        pstrides[0] = elsize;
+                        pstrides[1] = strides_copy[1];
+                        pstrides[2] = elsize;
+                        innerloop(pdata, &count, pstrides, innerloopdata);
+                    }
+                    else {
+                        /* seed the slot with a copy of this row */
+                        npy_intp i;
+
+                        for (i = 0; i < count; i++) {
+                            memcpy(slot + i * elsize,
+                                   dataptrs[1] + i * strides_copy[1],
+                                   elsize);
+                        }
+                        panel_rows++;
+                    }
+                    panel_next = (panel_next + 1) % NPY_REDUCE_PANEL_ROWS;
+                    handled = 1;
+                }
+            }
+            if (!handled) {
+                if (panel_rows > 0) {
+                    reduce_panel_flush(innerloop, innerloopdata, panel,
+                                       panel_rows, panel_count, elsize,
+                                       panel_acc, panel_acc_stride);
+                    panel_rows = 0;
+                    panel_next = 0;
+                }
+                if (needs_api || !reorderable ||
+                        !npy_ufunc_parallel_reduce(innerloop, innerloopdata,
+                                                   dataptrs_copy, *countptr,
+                                                   strides_copy, elsize)) {
+                    innerloop(dataptrs_copy, countptr,
+                              strides_copy, innerloopdata);
+                }
+            }
         }
         else {
             npy_intp count = *countptr;
             char *maskptr = dataptrs[2];
             npy_intp mask_stride = strides[2];
             /* Optimization for when the mask is broadcast */
-            npy_intp n = mask_stride == 0 ? count : 1;
-            while (count) {
-                char mask = *maskptr;
-                maskptr += mask_stride;
-                while (n < count && mask == *maskptr) {
-                    n++;
-                    maskptr += mask_stride;
+            if (mask_stride == 0) {
+                if (*maskptr) {
+                    innerloop(dataptrs_copy, &count,
+                              strides_copy, innerloopdata);
                 }
-                /* If mask set, apply inner loop on this contiguous region */
-                if (mask) {
+            }
+            else {
+                while (count > 0) {
+                    npy_intp n;
+                    /*
+                     * Skip the masked-out run, then measure the unmasked
+                     * run and reduce it with a single inner loop call.
+                     * npy_memchr scans word-at-a-time for contiguous masks.
+                     */
+                    maskptr = npy_memchr(maskptr, 0, mask_stride, count,
+                                         &n, 1);
+                    dataptrs_copy[0] += n * strides[0];
+                    dataptrs_copy[1] += n * strides[1];
+                    dataptrs_copy[2] = dataptrs_copy[0];
+                    count -= n;
+                    if (count <= 0) {
+                        break;
+                    }
+                    maskptr = npy_memchr(maskptr, 0, mask_stride, count,
+                                         &n, 0);
                     innerloop(dataptrs_copy, &n,
                               strides_copy, innerloopdata);
+                    dataptrs_copy[0] += n * strides[0];
+                    dataptrs_copy[1] += n * strides[1];
+                    dataptrs_copy[2] = dataptrs_copy[0];
+                    count -= n;
                 }
-                dataptrs_copy[0] += n * strides[0];
-                dataptrs_copy[1] += n * strides[1];
-                dataptrs_copy[2] = dataptrs_copy[0];
-                count -= n;
-                n = 1;
             }
         }
     } while (iternext(iter));
 
 finish_loop:
+    if (panel_rows > 0) {
+        reduce_panel_flush(innerloop, innerloopdata, panel,
+                           panel_rows, panel_count, elsize,
+                           panel_acc, panel_acc_stride);
+    }
+    if (panel != NULL) {
+        free(panel);
+    }
     NPY_END_THREADS;
 
     return (needs_api && PyErr_Occurred()) ? -1 : 0;
@@ -3605,8 +4090,13 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
     const char *ufunc_name = ufunc_get_name_cstr(ufunc);
     /* These parameters come from a TLS global */
     int buffersize = 0, errormask = 0;
+    npy_uint64 stats_t0 = 0;
     static PyObject *NoValue = NULL;
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled)) {
+        stats_t0 = npy_ufunc_stats_now();
+    }
+
     NPY_UF_DBG_PRINT1("\nEvaluating ufunc %s.reduce\n", ufunc_name);
 
     npy_cache_import("numpy", "_NoValue", &NoValue);
@@ -3668,6 +4158,15 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
                                    reduce_loop,
                                    ufunc, buffersize, ufunc_name, errormask);
 
+    if (NPY_UNLIKELY(npy_ufunc_stats_enabled) && result != NULL) {
+        char stats_sig[16];
+
+        PyOS_snprintf(stats_sig, sizeof(stats_sig), "%c:reduce",
+                      dtype->type);
+        npy_ufunc_stats_record(ufunc_name, stats_sig, PyArray_SIZE(arr),
+                               stats_t0);
+    }
+
     Py_DECREF(dtype);
     Py_DECREF(initial);
     return result;
@@ -4000,8 +4499,13 @@ PyUFunc_Accumulate(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
                 NPY_BEGIN_THREADS_THRESHOLDED(count);
             }
 
-            innerloop(dataptr_copy, &count,
-                        stride_copy, innerloopdata);
+            if (needs_api || ufunc->identity == PyUFunc_None ||
+                    !npy_ufunc_parallel_scan(innerloop, innerloopdata,
+                                             dataptr_copy, count,
+                                             stride_copy, itemsize)) {
+                innerloop(dataptr_copy, &count,
+                            stride_copy, innerloopdata);
+            }
 
             NPY_END_THREADS;
         }
@@ -4849,6 +5353,7 @@ ufunc_seterr(PyObject *NPY_UNUSED(dummy), PyObject *args)
     if (res < 0) {
         return NULL;
     }
+    npy_ufunc_pyvals_bump_generation();
 #if USE_USE_DEFAULTS==1
     if (ufunc_update_use_defaults() < 0) {
         return NULL;
@@ -5063,6 +5568,38 @@ cmp_arg_types(int *arg1, int *arg2, int n)
     return 0;
 }
 
+/*
+ * Payload and trampoline used by PyUFunc_RegisterLoopForTypeTiered.  The
+ * registered PyUFunc_Loop1d stores the trampoline as its inner loop, so the
+ * loop selection machinery treats tiered registrations exactly like plain
+ * ones; the payload kept in funcdata->data then routes each call to the
+ * contiguous kernel when every operand is unit-strided and to the generic
+ * strided kernel otherwise.
+ */
+typedef struct {
+    PyUFuncGenericFunction strided;
+    PyUFuncGenericFunction contig;
+    void *user_data;
+    int nargs;
+    npy_intp elsizes[NPY_MAXARGS];
+} _tiered_loop_data;
+
+static void
+_tiered_loop_trampoline(char **args, npy_intp *dimensions, npy_intp *steps,
+                        void *data)
+{
+    _tiered_loop_data *tiers = (_tiered_loop_data *)data;
+    int i;
+
+    for (i = 0; i < tiers->nargs; i++) {
+        if (steps[i] != tiers->elsizes[i]) {
+            tiers->strided(args, dimensions, steps, tiers->user_data);
+            return;
+        }
+    }
+    tiers->contig(args, dimensions, steps, tiers->user_data);
+}
+
 /*
  * This frees the linked-list structure when the CObject
  * is destroyed (removed from the internal dictionary)
@@ -5083,6 +5620,11 @@ _free_loop1d_list(PyUFunc_Loop1d *data)
             PyArray_free(data->arg_dtypes);
         }
 
+        /* tiered registrations own their dispatch payload */
+        if (data->func == _tiered_loop_trampoline) {
+            PyArray_free(data->data);
+        }
+
         PyArray_free(data);
         data = next;
     }
@@ -5302,6 +5844,9 @@ PyUFunc_RegisterLoopForType(PyUFuncObject *ufunc,
         }
         if (cmp == 0) {
             /* just replace it with new function */
+            if (current->func == _tiered_loop_trampoline) {
+                PyArray_free(current->data);
+            }
             current->func = function;
             current->data = data;
             PyArray_free(newtypes);
@@ -5334,6 +5879,72 @@ PyUFunc_RegisterLoopForType(PyUFuncObject *ufunc,
     return -1;
 }
 
+/*
+ * This function is like RegisterLoopForType except that it registers a
+ * pair of inner loops for the same type signature: a generic strided loop
+ * and a specialization that is only called when every operand is
+ * contiguous (each inner stride equals the operand itemsize).  Builtin
+ * loops hold their fast contiguous/vectorized paths behind exactly this
+ * kind of stride check, and this entry point lets user-defined types do
+ * the same without teaching the loop selection machinery about tiers.
+ *
+ * ufunc            - ufunc object created from call to PyUFunc_FromFuncAndData
+ * usertype         - dtype that ufunc will be registered with
+ * strided_function - 1-d loop called for arbitrary inner strides
+ * contig_function  - 1-d loop called when all operands are unit-strided
+ * arg_types        - array of type numbers describing the ufunc operands
+ * data             - arbitrary data pointer passed in to both loop functions
+ *
+ * returns 0 on success, -1 for failure
+ */
+/*UFUNC_API*/
+NPY_NO_EXPORT int
+PyUFunc_RegisterLoopForTypeTiered(PyUFuncObject *ufunc,
+                                  int usertype,
+                                  PyUFuncGenericFunction strided_function,
+                                  PyUFuncGenericFunction contig_function,
+                                  int *arg_types,
+                                  void *data)
+{
+    _tiered_loop_data *tiers;
+    int i;
+    int result;
+
+    if (strided_function == NULL || contig_function == NULL) {
+        PyErr_SetString(PyExc_ValueError,
+                "both a strided and a contiguous loop are required");
+        return -1;
+    }
+    tiers = PyArray_malloc(sizeof(_tiered_loop_data));
+    if (tiers == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    tiers->strided = strided_function;
+    tiers->contig = contig_function;
+    tiers->user_data = data;
+    tiers->nargs = ufunc->nargs;
+    for (i = 0; i < ufunc->nargs; i++) {
+        int typenum = (arg_types != NULL) ? arg_types[i] : usertype;
+        PyArray_Descr *descr = PyArray_DescrFromType(typenum);
+
+        if (descr == NULL) {
+            PyArray_free(tiers);
+            return -1;
+        }
+        tiers->elsizes[i] = descr->elsize;
+        Py_DECREF(descr);
+    }
+
+    result = PyUFunc_RegisterLoopForType(ufunc, usertype,
+                                         _tiered_loop_trampoline,
+                                         arg_types, tiers);
+    if (result < 0) {
+        PyArray_free(tiers);
+    }
+    return result;
+}
+
 #undef _SETCPTR
 
 
@@ -5341,6 +5952,7 @@ static void
 ufunc_dealloc(PyUFuncObject *ufunc)
 {
     PyObject_GC_UnTrack((PyObject *)ufunc);
+    npy_ufunc_dispatch_cache_clear(ufunc);
     PyArray_free(ufunc->core_num_dims);
     PyArray_free(ufunc->core_dim_ixs);
     PyArray_free(ufunc->core_dim_sizes);
@@ -0,0 +1,461 @@
+/*
+ * Opt-in threaded execution of trivial ufunc inner loops.
+ *
+ * The trivial loops (contiguous operands, no buffering, no Python API)
+ * already release the GIL; for very large arrays they are memory or compute
+ * bound in a single core. When NPY_UFUNC_THREADS is set to N > 1, the
+ * flattened iteration space is split into contiguous chunks which are run
+ * on the shared worker pool (see npy_workpool.c), so the threads are
+ * started once per process and shared with the other parallel engines.
+ *
+ * Only loops that cannot call back into Python are eligible; the caller
+ * checks for object dtypes. One known limitation of the opt-in mode is that
+ * floating point status flags raised in a worker thread are not seen by the
+ * main thread, so np.errstate-based warnings can be missed for the threaded
+ * portion of the work.
+ */
+#define _UMATHMODULE
+#define _MULTIARRAYMODULE
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+
+#include <Python.h>
+
+#include <stdlib.h>
+
+#include "npy_config.h"
+#include "numpy/ndarraytypes.h"
+#include "numpy/ufuncobject.h"
+#include "npy_workpool.h"
+#include "ufunc_parallel.h"
+
+/* do not bother threading loops below this many elements */
+#define NPY_UFUNC_PARALLEL_THRESHOLD 0x100000
+/* never hand a worker less than this many elements */
+#define NPY_UFUNC_PARALLEL_MIN_CHUNK 0x10000
+
+NPY_NO_EXPORT int
+npy_ufunc_nthreads(void)
+{
+    static int nthreads = -1;
+
+    if (nthreads < 0) {
+        char *env = getenv("NPY_UFUNC_THREADS");
+        nthreads = 1;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > NPY_UFUNC_MAX_THREADS) {
+                val = NPY_UFUNC_MAX_THREADS;
+            }
+            if (val > 1) {
+                nthreads = (int)val;
+            }
+        }
+    }
+    return nthreads;
+}
+
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    char *data[NPY_MAXARGS];
+    npy_intp count[NPY_MAXARGS];
+    npy_intp *stride;
+    int nop;
+} ufunc_parallel_chunk;
+
+static void
+parallel_chunk_run(npy_intp t, void *arg)
+{
+    ufunc_parallel_chunk *chunk = (ufunc_parallel_chunk *)arg + t;
+
+    chunk->innerloop(chunk->data, chunk->count, chunk->stride,
+                     chunk->innerloopdata);
+}
+
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    char *partial;      /* elsize-byte accumulator, seeded by the worker */
+    char *data;         /* first element of this worker's chunk */
+    npy_intp count;     /* elements in the chunk, >= 1 */
+    npy_intp stride;
+    npy_intp elsize;
+} ufunc_reduce_chunk;
+
+static void
+reduce_chunk_exec(ufunc_reduce_chunk *chunk)
+{
+    char *dataptrs[3];
+    npy_intp strides[3];
+    npy_intp n = chunk->count - 1;
+
+    /* seed the partial with the first element, reduce the rest into it */
+    memcpy(chunk->partial, chunk->data, chunk->elsize);
+    if (n > 0) {
+        dataptrs[0] = chunk->partial;
+        dataptrs[1] = chunk->data + chunk->stride;
+        dataptrs[2] = chunk->partial;
+        strides[0] = 0;
+        strides[1] = chunk->stride;
+        strides[2] = 0;
+        chunk->innerloop(dataptrs, &n, strides, chunk->innerloopdata);
+    }
+}
+
+typedef struct {
+    ufunc_reduce_chunk *chunks;
+    /* chunk 0 reduces straight into the caller's accumulator */
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    char **dataptrs;
+    npy_intp *strides;
+    npy_intp count0;
+} ufunc_reduce_job;
+
+static void
+reduce_chunk_run(npy_intp t, void *arg)
+{
+    ufunc_reduce_job *job = (ufunc_reduce_job *)arg;
+
+    if (t == 0) {
+        job->innerloop(job->dataptrs, &job->count0, job->strides,
+                       job->innerloopdata);
+    }
+    else {
+        reduce_chunk_exec(&job->chunks[t]);
+    }
+}
+
+NPY_NO_EXPORT int
+npy_ufunc_parallel_reduce(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                          char **dataptrs, npy_intp count,
+                          npy_intp *strides, npy_intp elsize)
+{
+    ufunc_reduce_chunk chunks[NPY_UFUNC_MAX_THREADS];
+    /* partial accumulators, aligned for the largest numeric type */
+    npy_clongdouble partial_store[NPY_UFUNC_MAX_THREADS];
+    char *partials = (char *)partial_store;
+    npy_intp chunksize, start, nfold;
+    char *folddata[3];
+    npy_intp foldstrides[3];
+    int i, nchunks;
+    int nthreads = npy_ufunc_nthreads();
+
+    if (nthreads <= 1 || count < NPY_UFUNC_PARALLEL_THRESHOLD) {
+        return 0;
+    }
+    /*
+     * Only the plain accumulate-into-one-element pattern is handled:
+     * stationary accumulator aliased as first and third operand, moving
+     * second operand, and an element size the partial store can hold.
+     */
+    if (strides[0] != 0 || strides[2] != 0 || strides[1] == 0 ||
+            dataptrs[0] != dataptrs[2] ||
+            elsize <= 0 || (size_t)elsize > sizeof(npy_clongdouble)) {
+        return 0;
+    }
+
+    /*
+     * In deterministic mode the chunk boundaries, and with them the
+     * order the partials combine in, may depend only on the element
+     * count, never on the thread count.
+     */
+    nchunks = npy_workpool_deterministic() ? NPY_UFUNC_MAX_THREADS
+                                           : nthreads;
+    if (count / nchunks < NPY_UFUNC_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(count / NPY_UFUNC_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1) {
+        return 0;
+    }
+    chunksize = count / nchunks;
+
+    /*
+     * Chunk 0 is reduced into the caller's accumulator on this thread,
+     * preserving the ordering of the serial loop across the chunk
+     * boundary; chunks 1..n-1 each reduce into a local partial.
+     */
+    start = chunksize;
+    for (i = 1; i < nchunks; i++) {
+        chunks[i].innerloop = innerloop;
+        chunks[i].innerloopdata = innerloopdata;
+        chunks[i].partial = partials + i * elsize;
+        chunks[i].data = dataptrs[1] + start * strides[1];
+        chunks[i].count = (i == nchunks - 1) ? (count - start) : chunksize;
+        chunks[i].stride = strides[1];
+        chunks[i].elsize = elsize;
+        start += chunksize;
+    }
+
+    /*
+     * Chunks 1..n-1 reduce into their partials; chunk 0 (task 0) is
+     * reduced into the caller's accumulator, preserving the ordering of
+     * the serial loop across its chunk boundary.
+     */
+    {
+        ufunc_reduce_job job;
+
+        job.chunks = chunks;
+        job.innerloop = innerloop;
+        job.innerloopdata = innerloopdata;
+        job.dataptrs = dataptrs;
+        job.strides = strides;
+        job.count0 = chunksize;
+        npy_parallel_for(nchunks, reduce_chunk_run, &job, nthreads);
+    }
+
+    /*
+     * Fold the partials into the accumulator in chunk order with the
+     * same inner loop. The chunk boundaries depend only on the element
+     * count and the configured thread count, so the combination order
+     * is deterministic run-to-run.
+     */
+    nfold = nchunks - 1;
+    folddata[0] = dataptrs[0];
+    folddata[1] = partials + elsize;
+    folddata[2] = dataptrs[0];
+    foldstrides[0] = 0;
+    foldstrides[1] = elsize;
+    foldstrides[2] = 0;
+    innerloop(folddata, &nfold, foldstrides, innerloopdata);
+
+    return 1;
+}
+
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    char *out;          /* first output element of this chunk */
+    char *in;           /* first input element of this chunk */
+    char *carry;        /* exclusive combination of the earlier chunks */
+    npy_intp count;     /* elements in the chunk, >= 1 */
+    npy_intp ostride;
+    npy_intp istride;
+    npy_intp elsize;
+} ufunc_scan_chunk;
+
+static void
+scan_chunk_local(ufunc_scan_chunk *chunk)
+{
+    char *dataptrs[3];
+    npy_intp strides[3];
+    npy_intp n = chunk->count - 1;
+
+    /* seed with the first input element, then scan the rest serially */
+    memmove(chunk->out, chunk->in, chunk->elsize);
+    if (n > 0) {
+        dataptrs[0] = chunk->out;
+        dataptrs[1] = chunk->in + chunk->istride;
+        dataptrs[2] = chunk->out + chunk->ostride;
+        strides[0] = chunk->ostride;
+        strides[1] = chunk->istride;
+        strides[2] = chunk->ostride;
+        chunk->innerloop(dataptrs, &n, strides, chunk->innerloopdata);
+    }
+}
+
+typedef struct {
+    ufunc_scan_chunk *chunks;
+    /* chunk 0 continues from the caller's already seeded first output */
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    char **dataptrs;
+    npy_intp *strides;
+    npy_intp count0;
+} ufunc_scan_job;
+
+static void
+scan_chunk_pass1(npy_intp t, void *arg)
+{
+    ufunc_scan_job *job = (ufunc_scan_job *)arg;
+
+    if (t == 0) {
+        job->innerloop(job->dataptrs, &job->count0, job->strides,
+                       job->innerloopdata);
+    }
+    else {
+        scan_chunk_local(&job->chunks[t]);
+    }
+}
+
+static void
+scan_chunk_fixup(ufunc_scan_chunk *chunk)
+{
+    char *dataptrs[3];
+    npy_intp strides[3];
+    npy_intp n = chunk->count;
+
+    /* out[i] = carry op out[i], carry on the left to keep scan order */
+    dataptrs[0] = chunk->carry;
+    dataptrs[1] = chunk->out;
+    dataptrs[2] = chunk->out;
+    strides[0] = 0;
+    strides[1] = chunk->ostride;
+    strides[2] = chunk->ostride;
+    chunk->innerloop(dataptrs, &n, strides, chunk->innerloopdata);
+}
+
+static void
+scan_chunk_pass2(npy_intp t, void *arg)
+{
+    /* chunk 0 is already final, the fixups cover chunks 1..n-1 */
+    scan_chunk_fixup((ufunc_scan_chunk *)arg + t + 1);
+}
+
+NPY_NO_EXPORT int
+npy_ufunc_parallel_scan(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                        char **dataptrs, npy_intp count,
+                        npy_intp *strides, npy_intp elsize)
+{
+    ufunc_scan_chunk chunks[NPY_UFUNC_MAX_THREADS];
+    /* carry values, aligned for the largest numeric type */
+    npy_clongdouble carry_store[NPY_UFUNC_MAX_THREADS];
+    char *carries = (char *)carry_store;
+    npy_intp chunksize, start, one;
+    char *folddata[3];
+    npy_intp foldstrides[3] = {0, 0, 0};
+    int i, nchunks;
+    int nthreads = npy_ufunc_nthreads();
+
+    if (nthreads <= 1 || count < NPY_UFUNC_PARALLEL_THRESHOLD) {
+        return 0;
+    }
+    /*
+     * Only the plain accumulate pattern is handled: the first operand
+     * trails the third by one output element so the recurrence
+     * out[i] = out[i-1] op in[i] runs through memory, and the element
+     * size fits the carry store.
+     */
+    if (strides[0] != strides[2] || strides[0] == 0 || strides[1] == 0 ||
+            dataptrs[2] != dataptrs[0] + strides[0] ||
+            elsize <= 0 || (size_t)elsize > sizeof(npy_clongdouble)) {
+        return 0;
+    }
+
+    /*
+     * In deterministic mode the chunk boundaries, and with them the
+     * order the partials combine in, may depend only on the element
+     * count, never on the thread count.
+     */
+    nchunks = npy_workpool_deterministic() ? NPY_UFUNC_MAX_THREADS
+                                           : nthreads;
+    if (count / nchunks < NPY_UFUNC_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(count / NPY_UFUNC_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1) {
+        return 0;
+    }
+    chunksize = count / nchunks;
+
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].innerloop = innerloop;
+        chunks[i].innerloopdata = innerloopdata;
+        chunks[i].out = dataptrs[2] + start * strides[0];
+        chunks[i].in = dataptrs[1] + start * strides[1];
+        chunks[i].carry = carries + i * elsize;
+        chunks[i].count = (i == nchunks - 1) ? (count - start) : chunksize;
+        chunks[i].ostride = strides[0];
+        chunks[i].istride = strides[1];
+        chunks[i].elsize = elsize;
+        start += chunksize;
+    }
+
+    /*
+     * Pass 1: independent local scans. Chunks 1..n-1 each seed from
+     * their first input element; chunk 0 (task 0) continues from the
+     * already seeded first output element, so its result is final.
+     */
+    {
+        ufunc_scan_job job;
+
+        job.chunks = chunks;
+        job.innerloop = innerloop;
+        job.innerloopdata = innerloopdata;
+        job.dataptrs = dataptrs;
+        job.strides = strides;
+        job.count0 = chunks[0].count;
+        npy_parallel_for(nchunks, scan_chunk_pass1, &job, nthreads);
+    }
+
+    /*
+     * Exclusive combination of the chunk totals, in chunk order: the
+     * carry for chunk 1 is chunk 0's final (global) value, and each
+     * later carry folds in the previous chunk's local total. The chunk
+     * boundaries depend only on the element count and the configured
+     * thread count, so the combination order is deterministic.
+     */
+    memmove(carries + elsize,
+            chunks[0].out + (chunks[0].count - 1) * strides[0], elsize);
+    for (i = 2; i < nchunks; i++) {
+        one = 1;
+        folddata[0] = carries + (i - 1) * elsize;
+        folddata[1] = chunks[i - 1].out +
+                      (chunks[i - 1].count - 1) * strides[0];
+        folddata[2] = carries + i * elsize;
+        innerloop(folddata, &one, foldstrides, innerloopdata);
+    }
+
+    /* Pass 2: apply the carries to chunks 1..n-1 */
+    npy_parallel_for(nchunks - 1, scan_chunk_pass2, chunks, nthreads);
+
+    return 1;
+}
+
+NPY_NO_EXPORT int
+npy_ufunc_parallel_run(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                       int nop, char **data, npy_intp *count,
+                       npy_intp *stride)
+{
+    ufunc_parallel_chunk chunks[NPY_UFUNC_MAX_THREADS];
+    npy_intp n = count[0];
+    npy_intp chunksize, start;
+    int i, iop, nchunks;
+    int nthreads = npy_ufunc_nthreads();
+    NPY_BEGIN_THREADS_DEF;
+
+    if (nthreads <= 1 || n < NPY_UFUNC_PARALLEL_THRESHOLD) {
+        return 0;
+    }
+    for (iop = 0; iop < nop; iop++) {
+        /*
+         * a zero stride operand of length > 1 is only splittable for
+         * inputs; be conservative and require all strides to move, the
+         * scalar operands have already been handled by this point
+         */
+        if (stride[iop] == 0) {
+            return 0;
+        }
+    }
+
+    nchunks = nthreads;
+    if (n / nchunks < NPY_UFUNC_PARALLEL_MIN_CHUNK) {
+        nchunks = (int)(n / NPY_UFUNC_PARALLEL_MIN_CHUNK);
+    }
+    if (nchunks <= 1) {
+        return 0;
+    }
+    chunksize = n / nchunks;
+
+    start = 0;
+    for (i = 0; i < nchunks; i++) {
+        chunks[i].innerloop = innerloop;
+        chunks[i].innerloopdata = innerloopdata;
+        chunks[i].stride = stride;
+        chunks[i].nop = nop;
+        chunks[i].count[0] = (i == nchunks - 1) ? (n - start) : chunksize;
+        for (iop = 0; iop < nop; iop++) {
+            chunks[i].data[iop] = data[iop] + start * stride[iop];
+            chunks[i].count[iop] = chunks[i].count[0];
+        }
+        start += chunksize;
+    }
+
+    NPY_BEGIN_THREADS;
+
+    npy_parallel_for(nchunks, parallel_chunk_run, chunks, nthreads);
+
+    NPY_END_THREADS;
+
+    return 1;
+}
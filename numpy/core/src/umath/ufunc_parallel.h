@@ -0,0 +1,79 @@
+#ifndef _NPY_UMATH_UFUNC_PARALLEL_H_
+#define _NPY_UMATH_UFUNC_PARALLEL_H_
+
+#include <numpy/ndarraytypes.h>
+#include <numpy/ufuncobject.h>
+
+/*
+ * Opt-in threaded execution of trivial (contiguous, no buffering, no API)
+ * ufunc inner loops. Disabled unless the NPY_UFUNC_THREADS environment
+ * variable is set to a thread count greater than 1.
+ */
+
+/* upper bound for NPY_UFUNC_THREADS */
+#define NPY_UFUNC_MAX_THREADS 128
+
+/*
+ * Number of threads to use for ufunc inner loops, read from the
+ * NPY_UFUNC_THREADS environment variable on first use. Returns 1 when
+ * threading is disabled.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_nthreads(void);
+
+/*
+ * Execute an elementwise inner loop over `count[0]` elements, split across
+ * worker threads. `nop` is the number of operands in `data`/`stride`.
+ *
+ * Returns 1 if the loop was executed, 0 if the caller must run it itself
+ * (threading disabled, problem too small, or the split is not safe).
+ * The caller must ensure the loop does not need the API (no object dtypes);
+ * the GIL is released internally while the workers run.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_parallel_run(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                       int nop, char **data, npy_intp *count,
+                       npy_intp *stride);
+
+/*
+ * Tree reduction of `count` elements into the stationary accumulator
+ * described by `dataptrs`/`strides` (the usual reduce inner-loop layout:
+ * operands 0 and 2 are the accumulator with stride 0, operand 1 moves).
+ * The iteration space is split into chunks; each worker seeds a local
+ * partial with the first element of its chunk and reduces the rest into
+ * it with the same inner loop, then the partials are folded into the
+ * accumulator in chunk order, so the combination order is deterministic
+ * run-to-run for a given thread count.
+ *
+ * Returns 1 if the reduction was executed, 0 if the caller must run the
+ * inner loop itself. Only valid for reorderable reductions; unlike
+ * npy_ufunc_parallel_run the caller is expected to have released the
+ * GIL already.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_parallel_reduce(PyUFuncGenericFunction innerloop,
+                          void *innerloopdata,
+                          char **dataptrs, npy_intp count,
+                          npy_intp *strides, npy_intp elsize);
+
+/*
+ * Blocked parallel prefix scan of `count` elements in the accumulate
+ * inner-loop layout (the first operand trails the third by one output
+ * element, so out[i] = out[i-1] op in[i]; the first output element has
+ * already been seeded by the caller). Each worker scans its chunk from a
+ * local seed, the chunk carries are folded serially in chunk order, and
+ * a second pass applies each carry across its chunk, so the combination
+ * order is deterministic run-to-run for a given thread count.
+ *
+ * Returns 1 if the scan was executed, 0 if the caller must run the
+ * inner loop itself. Only valid for reorderable operations; like
+ * npy_ufunc_parallel_reduce the caller is expected to have released
+ * the GIL already.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_parallel_scan(PyUFuncGenericFunction innerloop,
+                        void *innerloopdata,
+                        char **dataptrs, npy_intp count,
+                        npy_intp *strides, npy_intp elsize);
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Optional ufunc call instrumentation.
+ *
+ * External profilers see the shared inner-loop drivers but cannot
+ * attribute time to dtype-specialized loops.  When enabled, the ufunc
+ * call and reduce paths account each call into a small fixed hash
+ * table keyed by (ufunc name, loop signature), tracking call count,
+ * elements processed and wall time.  The accounting runs at points
+ * where the GIL is held, so the table needs no locking of its own,
+ * and a single flag test is the only hot-path cost while disabled.
+ */
+#define _UMATHMODULE
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+
+#include <Python.h>
+
+#include <string.h>
+
+#include "npy_config.h"
+#include "numpy/ndarraytypes.h"
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#include "ufunc_stats.h"
+
+NPY_NO_EXPORT int npy_ufunc_stats_enabled = 0;
+
+#define NPY_UFUNC_STATS_SLOTS 512
+#define NPY_UFUNC_STATS_NAMELEN 32
+
+typedef struct {
+    char name[NPY_UFUNC_STATS_NAMELEN];
+    char sig[NPY_MAXARGS + 8];
+    npy_uint64 calls;
+    npy_uint64 elements;
+    npy_uint64 ns;
+} npy_ufunc_stat;
+
+static npy_ufunc_stat stat_slots[NPY_UFUNC_STATS_SLOTS];
+/* calls that found the table full; reported under the name "<other>" */
+static npy_uint64 stat_dropped;
+
+NPY_NO_EXPORT npy_uint64
+npy_ufunc_stats_now(void)
+{
+#if !defined(_WIN32) && defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+        return (npy_uint64)ts.tv_sec * 1000000000ull
+               + (npy_uint64)ts.tv_nsec;
+    }
+#endif
+    return 0;
+}
+
+static npy_uint64
+stats_hash(const char *name, const char *sig)
+{
+    /* FNV-1a over both key strings */
+    npy_uint64 h = 0xcbf29ce484222325ull;
+
+    for (; *name != '\0'; name++) {
+        h = (h ^ (unsigned char)*name) * 0x100000001b3ull;
+    }
+    h = (h ^ 0xff) * 0x100000001b3ull;
+    for (; *sig != '\0'; sig++) {
+        h = (h ^ (unsigned char)*sig) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+NPY_NO_EXPORT void
+npy_ufunc_stats_record(const char *name, const char *sig,
+                       npy_intp elements, npy_uint64 t0)
+{
+    npy_uint64 ns = npy_ufunc_stats_now() - t0;
+    npy_uint64 h = stats_hash(name, sig);
+    int i;
+
+    for (i = 0; i < NPY_UFUNC_STATS_SLOTS; i++) {
+        npy_ufunc_stat *slot =
+                &stat_slots[(h + i) % NPY_UFUNC_STATS_SLOTS];
+
+        if (slot->calls == 0) {
+            strncpy(slot->name, name, NPY_UFUNC_STATS_NAMELEN - 1);
+            slot->name[NPY_UFUNC_STATS_NAMELEN - 1] = '\0';
+            strncpy(slot->sig, sig, sizeof(slot->sig) - 1);
+            slot->sig[sizeof(slot->sig) - 1] = '\0';
+        }
+        else if (strncmp(slot->name, name, NPY_UFUNC_STATS_NAMELEN - 1)
+                    != 0 ||
+                 strncmp(slot->sig, sig, sizeof(slot->sig) - 1) != 0) {
+            continue;
+        }
+        slot->calls++;
+        slot->elements += (npy_uint64)elements;
+        slot->ns += ns;
+        return;
+    }
+    stat_dropped++;
+}
+
+NPY_NO_EXPORT PyObject *
+ufunc_stats_set(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    int enable;
+    int prev = npy_ufunc_stats_enabled;
+
+    if (!PyArg_ParseTuple(args, "i:_set_ufunc_stats", &enable)) {
+        return NULL;
+    }
+    npy_ufunc_stats_enabled = (enable != 0);
+    return PyBool_FromLong(prev);
+}
+
+NPY_NO_EXPORT PyObject *
+ufunc_stats_get(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"clear", NULL};
+    int clear = 0;
+    PyObject *list;
+    int i;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i:_get_ufunc_stats",
+                                     kwlist, &clear)) {
+        return NULL;
+    }
+    list = PyList_New(0);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < NPY_UFUNC_STATS_SLOTS; i++) {
+        npy_ufunc_stat *slot = &stat_slots[i];
+        PyObject *item;
+
+        if (slot->calls == 0) {
+            continue;
+        }
+        item = Py_BuildValue("(ssKKK)", slot->name, slot->sig,
+                             (unsigned long long)slot->calls,
+                             (unsigned long long)slot->elements,
+                             (unsigned long long)slot->ns);
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    if (stat_dropped != 0) {
+        PyObject *item = Py_BuildValue("(ssKKK)", "<other>", "",
+                (unsigned long long)stat_dropped,
+                (unsigned long long)0, (unsigned long long)0);
+
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    if (clear) {
+        memset(stat_slots, 0, sizeof(stat_slots));
+        stat_dropped = 0;
+    }
+    return list;
+}
@@ -0,0 +1,35 @@
+#ifndef _NPY_UMATH_UFUNC_STATS_H_
+#define _NPY_UMATH_UFUNC_STATS_H_
+
+/*
+ * Optional instrumentation of the ufunc hot paths: per-(ufunc,
+ * signature) call counts, element counts and wall time, collected when
+ * npy_ufunc_stats_enabled is set.  The flag check is the only cost on
+ * the hot path while disabled.
+ */
+
+NPY_NO_EXPORT extern int npy_ufunc_stats_enabled;
+
+/* Monotonic timestamp in nanoseconds (0 when the platform has none) */
+NPY_NO_EXPORT npy_uint64
+npy_ufunc_stats_now(void);
+
+/*
+ * Account one call of 'name' with loop signature 'sig' processing
+ * 'elements' elements, started at timestamp 't0'.  Must be called with
+ * the GIL held; the table is serialized by it.
+ */
+NPY_NO_EXPORT void
+npy_ufunc_stats_record(const char *name, const char *sig,
+                       npy_intp elements, npy_uint64 t0);
+
+/* _set_ufunc_stats(enable) -> previous flag; enabling clears nothing */
+NPY_NO_EXPORT PyObject *
+ufunc_stats_set(PyObject *dummy, PyObject *args);
+
+/* _get_ufunc_stats(clear=False) -> list of (name, sig, calls,
+ * elements, time_ns) */
+NPY_NO_EXPORT PyObject *
+ufunc_stats_get(PyObject *dummy, PyObject *args, PyObject *kwds);
+
+#endif
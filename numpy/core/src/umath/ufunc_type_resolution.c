@@ -30,6 +30,145 @@
 #include "cblasfuncs.h"
 #endif
 
+/*
+ * A small cache of recent successful default type resolutions, keyed on
+ * the ufunc and the dtype numbers of all operands. For call sites that
+ * apply the same ufunc to the same dtypes over and over (common in
+ * services making millions of small-array calls), this skips the linear
+ * walk over ufunc->types entirely.
+ *
+ * Only non-parametric builtin dtypes participate: their resolution result
+ * is a pure function of the operand dtype numbers, because ufunc->types
+ * is immutable after registration and user loops only apply to user
+ * dtypes. Zero dimensional inputs are excluded since value-based casting
+ * makes their resolution depend on the values, not just the dtypes.
+ *
+ * Direct-mapped table; a colliding insert simply evicts. Entries for a
+ * ufunc are dropped when the ufunc is deallocated so a new ufunc at the
+ * recycled address cannot alias stale entries.
+ */
+#define NPY_DISPATCH_CACHE_SIZE 512  /* power of two */
+
+typedef struct {
+    PyUFuncObject *ufunc;
+    /* dtype numbers of the operands; NULL operands are recorded as 0xff */
+    npy_uint8 key_types[NPY_MAXARGS];
+    /* dtype numbers of the resolved descriptors */
+    npy_uint8 res_types[NPY_MAXARGS];
+} dispatch_cache_entry;
+
+static dispatch_cache_entry dispatch_cache[NPY_DISPATCH_CACHE_SIZE];
+
+#define NPY_DISPATCH_CACHE_NULL_OPERAND 0xff
+
+static NPY_INLINE int
+dispatch_cache_typenum_ok(int type_num)
+{
+    return (type_num >= 0 && type_num < NPY_NTYPES &&
+            !PyTypeNum_ISOBJECT(type_num) &&
+            !PyTypeNum_ISFLEXIBLE(type_num) &&
+            !PyTypeNum_ISDATETIME(type_num));
+}
+
+static int
+dispatch_cache_eligible(PyUFuncObject *ufunc, PyArrayObject **operands)
+{
+    int i, nop = ufunc->nin + ufunc->nout;
+
+    for (i = 0; i < nop; ++i) {
+        if (operands[i] == NULL) {
+            if (i < ufunc->nin) {
+                return 0;
+            }
+            continue;
+        }
+        if (!dispatch_cache_typenum_ok(PyArray_DESCR(operands[i])->type_num)) {
+            return 0;
+        }
+        /* value-based casting applies to 0-d inputs */
+        if (i < ufunc->nin && PyArray_NDIM(operands[i]) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static NPY_INLINE npy_uintp
+dispatch_cache_hash(PyUFuncObject *ufunc, PyArrayObject **operands)
+{
+    npy_uintp hash = (npy_uintp)ufunc >> 4;
+    int i, nop = ufunc->nin + ufunc->nout;
+
+    for (i = 0; i < nop; ++i) {
+        int type_num = (operands[i] == NULL) ? NPY_DISPATCH_CACHE_NULL_OPERAND
+                            : PyArray_DESCR(operands[i])->type_num;
+        hash = hash * 33 + type_num;
+    }
+    return hash & (NPY_DISPATCH_CACHE_SIZE - 1);
+}
+
+static int
+dispatch_cache_lookup(PyUFuncObject *ufunc, PyArrayObject **operands,
+                      PyArray_Descr **out_dtypes)
+{
+    dispatch_cache_entry *entry;
+    int i, nop = ufunc->nin + ufunc->nout;
+
+    entry = &dispatch_cache[dispatch_cache_hash(ufunc, operands)];
+    if (entry->ufunc != ufunc) {
+        return 0;
+    }
+    for (i = 0; i < nop; ++i) {
+        int type_num = (operands[i] == NULL) ? NPY_DISPATCH_CACHE_NULL_OPERAND
+                            : PyArray_DESCR(operands[i])->type_num;
+        if (entry->key_types[i] != type_num) {
+            return 0;
+        }
+    }
+    for (i = 0; i < nop; ++i) {
+        out_dtypes[i] = PyArray_DescrFromType(entry->res_types[i]);
+    }
+    return 1;
+}
+
+static void
+dispatch_cache_insert(PyUFuncObject *ufunc, PyArrayObject **operands,
+                      PyArray_Descr **out_dtypes)
+{
+    dispatch_cache_entry *entry;
+    int i, nop = ufunc->nin + ufunc->nout;
+
+    for (i = 0; i < nop; ++i) {
+        if (!dispatch_cache_typenum_ok(out_dtypes[i]->type_num) ||
+                !PyArray_ISNBO(out_dtypes[i]->byteorder)) {
+            return;
+        }
+    }
+    entry = &dispatch_cache[dispatch_cache_hash(ufunc, operands)];
+    entry->ufunc = ufunc;
+    for (i = 0; i < nop; ++i) {
+        entry->key_types[i] = (operands[i] == NULL)
+                            ? NPY_DISPATCH_CACHE_NULL_OPERAND
+                            : PyArray_DESCR(operands[i])->type_num;
+        entry->res_types[i] = out_dtypes[i]->type_num;
+    }
+}
+
+/*
+ * Drop all cache entries of a ufunc that is being deallocated.
+ */
+NPY_NO_EXPORT void
+npy_ufunc_dispatch_cache_clear(PyUFuncObject *ufunc)
+{
+    int i;
+
+    for (i = 0; i < NPY_DISPATCH_CACHE_SIZE; ++i) {
+        if (dispatch_cache[i].ufunc == ufunc) {
+            dispatch_cache[i].ufunc = NULL;
+        }
+    }
+}
+
 static PyObject *
 npy_casting_to_py_object(NPY_CASTING casting)
 {
@@ -295,10 +434,25 @@ PyUFunc_DefaultTypeResolver(PyUFuncObject *ufunc,
     input_casting = (casting > NPY_SAFE_CASTING) ? NPY_SAFE_CASTING : casting;
 
     if (type_tup == NULL) {
+        /*
+         * The cache key does not include the casting rule, so only the
+         * default rule of normal ufunc calls goes through the cache.
+         */
+        int use_cache = !any_object &&
+                            casting == NPY_SAME_KIND_CASTING &&
+                            dispatch_cache_eligible(ufunc, operands);
+
+        if (use_cache &&
+                dispatch_cache_lookup(ufunc, operands, out_dtypes)) {
+            return 0;
+        }
         /* Find the best ufunc inner loop, and fill in the dtypes */
         retval = linear_search_type_resolver(ufunc, operands,
                         input_casting, casting, any_object,
                         out_dtypes);
+        if (retval == 0 && use_cache) {
+            dispatch_cache_insert(ufunc, operands, out_dtypes);
+        }
     } else {
         /* Find the specified ufunc inner loop, and fill in the dtypes */
         retval = type_tuple_type_resolver(ufunc, type_tup,
@@ -1536,12 +1690,14 @@ unmasked_ufunc_loop_as_masked(
          * mess with the 'args' pointer values)
          */
         mask = npy_memchr(mask, 0, mask_stride, loopsize, &subloopsize, 0);
-        unmasked_innerloop(dataptrs, &subloopsize, strides,
-                                        unmasked_innerloopdata);
-        for (iargs = 0; iargs < nargs; ++iargs) {
-            dataptrs[iargs] += subloopsize * strides[iargs];
+        if (subloopsize > 0) {
+            unmasked_innerloop(dataptrs, &subloopsize, strides,
+                                            unmasked_innerloopdata);
+            for (iargs = 0; iargs < nargs; ++iargs) {
+                dataptrs[iargs] += subloopsize * strides[iargs];
+            }
+            loopsize -= subloopsize;
         }
-        loopsize -= subloopsize;
     } while (loopsize > 0);
 }
 
@@ -152,4 +152,7 @@ PyUFunc_DefaultMaskedInnerLoopSelector(PyUFuncObject *ufunc,
                                       NpyAuxData **out_innerloopdata,
                                       int *out_needs_api);
 
+NPY_NO_EXPORT void
+npy_ufunc_dispatch_cache_clear(PyUFuncObject *ufunc);
+
 #endif
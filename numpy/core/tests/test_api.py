@@ -342,6 +342,33 @@ def test_copyto():
     # 'dst' must be an array
     assert_raises(TypeError, np.copyto, [1, 2, 3], [2, 3, 4])
 
+def test_copyto_where_spans():
+    # same-dtype contiguous masked copies go through a run-scanning
+    # branch that memcpys each True span; compare against np.where
+    rng = np.random.RandomState(1234)
+    for n in [1, 2, 17, 4096, 10007]:
+        src = rng.randint(0, 1000, size=n)
+        # clustered mask: long alternating runs
+        mask = (np.arange(n) // 37) % 2 == 0
+        for m in [mask, ~mask, np.zeros(n, '?'), np.ones(n, '?')]:
+            dst = np.zeros(n, dtype=src.dtype)
+            np.copyto(dst, src, where=m)
+            assert_array_equal(dst, np.where(m, src, 0))
+
+    # 2-d inner-contiguous case
+    src = rng.randint(0, 1000, size=(13, 31))
+    mask = src % 3 != 0
+    dst = np.zeros_like(src)
+    np.copyto(dst, src, where=mask)
+    assert_array_equal(dst, np.where(mask, src, 0))
+
+    # overlapping forward copy within one array
+    a = np.arange(20)
+    expected = a.copy()
+    expected[:10][a[5:15] % 2 == 0] = a[5:15][a[5:15] % 2 == 0]
+    np.copyto(a[:10], a[5:15], where=a[5:15] % 2 == 0)
+    assert_array_equal(a[:10], expected[:10])
+
 def test_copyto_permut():
     # test explicit overflow case
     pad = 500
@@ -453,6 +453,14 @@ class TestMethods(object):
             assert_(issubclass(R.dtype.type, np.unicode_))
             assert_array_equal(R, tgt)
 
+    def test_replace_single_byte(self):
+        # single-byte replacements on bytes arrays run over the packed
+        # buffer; check padded elements and values shorter than the width
+        A = np.array([b'abcabc', b'  a  ', b''], dtype='S8')
+        R = np.char.replace(A, b'a', b'Z')
+        assert_(issubclass(R.dtype.type, np.string_))
+        assert_array_equal(R, [b'ZbcZbc', b'  Z  ', b''])
+
     def test_rjust(self):
         assert_(issubclass(self.A.rjust(10).dtype.type, np.string_))
 
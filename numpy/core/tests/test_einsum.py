@@ -572,6 +572,29 @@ class TestEinsum(object):
     def test_einsum_sums_clongdouble(self):
         self.check_einsum_sums(np.clongdouble)
 
+    def test_einsum_complex_contig(self):
+        # The specialized contiguous complex two- and three-operand loops
+        # must agree with the result computed in a higher precision, over
+        # sizes crossing the unroll boundary and over unaligned views
+        for dtype in ('c8', 'c16'):
+            for n in range(1, 25):
+                a = ((np.arange(n) + 1j*np.arange(1, n + 1))/n).astype(dtype)
+                b = ((np.arange(2, n + 2) - 1j*np.arange(n))/n).astype(dtype)
+                c = ((np.arange(n) - 1j*np.arange(3, n + 3))/n).astype(dtype)
+                ab = a.astype('c16')*b.astype('c16')
+                abc = ab*c.astype('c16')
+                assert_almost_equal(np.einsum("i,i->i", a, b),
+                                    ab.astype(dtype), decimal=5)
+                assert_almost_equal(np.einsum("i,i,i->i", a, b, c),
+                                    abc.astype(dtype), decimal=4)
+                # unaligned views exercise the scalar finish-up loops
+                assert_almost_equal(np.einsum("i,i->i", a[1:], b[:-1]),
+                                    (a[1:].astype('c16') *
+                                     b[:-1].astype('c16')).astype(dtype),
+                                    decimal=5)
+                assert_almost_equal(np.einsum("i,i,i->i", a[1:], b[1:], c[1:]),
+                                    abc[1:].astype(dtype), decimal=4)
+
     def test_einsum_misc(self):
         # This call used to crash because of a bug in
         # PyArray_AssignZero
@@ -968,6 +991,26 @@ class TestEinsumPath(object):
         path, path_str = np.einsum_path(*edge_test4, optimize='optimal')
         self.assert_path_equal(path, ['einsum_path', (0, 1), (0, 1, 2, 3, 4, 5)])
 
+    def test_path_cache(self):
+        # Planning the same contraction again reuses the cached plan, while
+        # the same subscripts over different shapes must be planned anew
+        path_test = self.build_operands('ab,bc,cd->ad')
+
+        path, path_str = np.einsum_path(*path_test, optimize='greedy')
+        repeat, repeat_str = np.einsum_path(*path_test, optimize='greedy')
+        self.assert_path_equal(repeat, path)
+        assert_equal(repeat_str, path_str)
+
+        a = np.random.rand(4, 50)
+        b = np.random.rand(50, 50)
+        c = np.random.rand(50, 4)
+        path, path_str = np.einsum_path('ab,bc,cd->ad', a, b, c,
+                                        optimize='greedy')
+        self.assert_path_equal(path, ['einsum_path', (0, 1), (0, 1)])
+        # and the cached plan still computes the right thing
+        opt = np.einsum('ab,bc,cd->ad', a, b, c, optimize='greedy')
+        assert_almost_equal(opt, a.dot(b).dot(c))
+
     def test_path_type_input(self):
         # Test explicit path handeling
         path_test = self.build_operands('dcc,fce,ea,dbf->ab')
@@ -233,6 +233,17 @@ class TestLinspace(object):
         assert_(y[-1] < 10)
         assert_raises(ValueError, linspace, 0, 10, num=-1)
 
+    def test_scalar_fast_path(self):
+        # plain double scalars fill through the C kernel; 0-d array
+        # inputs keep the general route and must agree bit for bit
+        for num in (0, 1, 2, 7, 50):
+            for endpoint in (True, False):
+                y = linspace(-3.5, 11.25, num, endpoint=endpoint)
+                ref = linspace(array(-3.5), array(11.25), num,
+                               endpoint=endpoint)
+                assert_equal(y.dtype, dtype('float64'))
+                assert_array_equal(y, ref)
+
     def test_corner(self):
         y = list(linspace(0, 1, 1))
         assert_(y == [0.0], y)
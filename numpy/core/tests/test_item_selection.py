@@ -85,3 +85,49 @@ class TestTake(object):
 
             b = np.array([0, 1, 2, 3, 4, 5])
             assert_array_equal(a, b)
+
+
+class TestTopK(object):
+    def test_simple(self):
+        from numpy.core.multiarray import _topk
+        for dt in [np.int8, np.uint16, np.int64, np.float32, np.float64,
+                   object]:
+            a = np.array([7, 1, 5, 3, 9, 0, 2, 8, 4, 6], dtype=dt)
+            a_original = a.copy()
+            assert_array_equal(_topk(a, 3),
+                               np.array([7, 8, 9], dtype=dt))
+            assert_array_equal(_topk(a, 3, largest=False),
+                               np.array([0, 1, 2], dtype=dt))
+            assert_array_equal(_topk(a, a.size), np.sort(a))
+            # the input must not be modified
+            assert_array_equal(a, a_original)
+
+    def test_axis(self):
+        from numpy.core.multiarray import _topk
+        a = np.array([[3, 1, 2], [0, 5, 4]])
+        assert_array_equal(_topk(a, 2, axis=0), np.sort(a, axis=0)[1:])
+        assert_array_equal(_topk(a, 2, axis=1), np.sort(a, axis=1)[:, 1:])
+
+    def test_invalid_k(self):
+        from numpy.core.multiarray import _topk
+        a = np.arange(5)
+        assert_raises(ValueError, _topk, a, 0)
+        assert_raises(ValueError, _topk, a, 6)
+
+
+class TestSortIndex(object):
+    def test_caching(self):
+        from numpy.core.multiarray import _SortIndex
+        keys = np.array([3, 1, 2, 0])
+        idx = _SortIndex(keys)
+        assert_array_equal(idx.indices(), np.argsort(keys, kind='stable'))
+        assert_array_equal(idx.take(np.array([30, 10, 20, 0])),
+                           np.array([0, 10, 20, 30]))
+        # mutating the keys must invalidate the cached permutation
+        keys[0] = -1
+        assert_array_equal(idx.indices(), np.argsort(keys, kind='stable'))
+
+    def test_invalid_keys(self):
+        from numpy.core.multiarray import _SortIndex
+        assert_raises(ValueError, _SortIndex, np.zeros((2, 2)))
+        assert_raises(TypeError, _SortIndex, np.array([None, object()]))
@@ -413,6 +413,33 @@ def test_shares_memory_api():
     assert_raises(np.TooHardError, np.shares_memory, a, b, max_work=long(1))
 
 
+def test_shares_memory_identical_views():
+    # self-pairs and layout-identical views are answered without
+    # running the solver, even when no work budget is given
+    x = np.zeros([4, 5, 6], dtype=np.int8)
+    a = x[:, ::2, ::3]
+    b = x[:, ::2, ::3]
+
+    assert_equal(np.shares_memory(a, a), True)
+    assert_equal(np.shares_memory(a, b), True)
+    assert_equal(np.shares_memory(a, a, max_work=0), True)
+    assert_equal(np.shares_memory(a, b, max_work=0), True)
+    assert_equal(np.may_share_memory(a, b), True)
+
+    # same data pointer but different layout still needs the solver
+    c = x[:, ::2, ::2]
+    assert_equal(np.shares_memory(a, c), True)
+
+    # empty arrays never share
+    e = np.zeros([4, 0, 6], dtype=np.int8)
+    assert_equal(np.shares_memory(e, e), False)
+
+    # disjoint contiguous halves of one buffer
+    y = np.zeros(100)
+    assert_equal(np.shares_memory(y[:50], y[50:]), False)
+    assert_equal(np.may_share_memory(y[:50], y[50:]), False)
+
+
 def test_may_share_memory_bad_max_work():
     x = np.zeros([1])
     assert_raises(OverflowError, np.may_share_memory, x, x, max_work=10**100)
@@ -948,3 +975,31 @@ class TestUFunc(object):
 
         x += x.T
         assert_array_equal(x - x.T, 0)
+
+    def test_inplace_op_shifted_manual(self):
+        # Forward-shifted in-place updates read each shared address
+        # before writing it, so they may run without a temporary copy;
+        # check the result is still the same as with an explicit copy.
+        rng = np.random.RandomState(1234)
+
+        for n in [10, 17000]:  # smaller and bigger than bufsize
+            for shift in [1, 3]:
+                x = rng.rand(n)
+                y = x.copy()
+                x[:-shift] += x[shift:]
+                y[:-shift] += y[shift:].copy()
+                assert_array_equal(x, y)
+
+                # backward shift needs a copy, but must also stay correct
+                x = rng.rand(n)
+                y = x.copy()
+                x[shift:] += x[:-shift]
+                y[shift:] += y[:-shift].copy()
+                assert_array_equal(x, y)
+
+        # 2-D, shifted along the fast axis
+        x = rng.rand(150, 200)
+        y = x.copy()
+        x[:, :-1] += x[:, 1:]
+        y[:, :-1] += y[:, 1:].copy()
+        assert_array_equal(x, y)
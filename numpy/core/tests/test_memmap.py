@@ -214,3 +214,95 @@ class TestMemmap(object):
 
         # ok now the file is not empty
         memmap(self.tmpfp, shape=(0,4), mode='w+')
+
+
+class TestChunkedApply(object):
+    def setup(self):
+        self.tmpfp = NamedTemporaryFile(prefix='mmap')
+        self.data = arange(1000, dtype='float64')
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(1000,))
+        fp[...] = self.data
+        fp.flush()
+        del fp
+        self.fp = memmap(self.tmpfp, dtype='float64', mode='r',
+                         shape=(1000,))
+
+    def teardown(self):
+        del self.fp
+        self.tmpfp.close()
+
+    def test_elementwise(self):
+        from numpy.core.memmap import chunked_apply
+        res = chunked_apply(add, [self.fp, self.data], blocksize=64)
+        assert_array_equal(res, self.data + self.data)
+
+    def test_callable_and_out(self):
+        from numpy.core.memmap import chunked_apply
+        import numpy as np
+        out = np.empty(1000, dtype='float64')
+        res = chunked_apply(lambda a: 2.0*a + 1.0, [self.fp], out=out,
+                            blocksize=100)
+        assert_(res is out)
+        assert_array_equal(out, 2.0*self.data + 1.0)
+
+    def test_reduce(self):
+        from numpy.core.memmap import chunked_reduce
+        import numpy as np
+        assert_equal(chunked_reduce(add, self.fp, blocksize=77),
+                     add.reduce(self.data, axis=None))
+        assert_equal(chunked_reduce(np.maximum, self.fp, blocksize=77),
+                     self.data.max())
+
+    def test_madvise_range_skips_plain_arrays(self):
+        from numpy.core.multiarray import _madvise_range
+        # heap arrays never get hints; dontneed on them would be unsafe
+        assert_(_madvise_range(self.data, 'dontneed') is False)
+        assert_(_madvise_range(self.data, 'willneed') is False)
+
+
+class TestPageResidency(object):
+    def setup(self):
+        self.tmpfp = NamedTemporaryFile(prefix='mmap')
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(65536,))
+        fp[...] = arange(65536, dtype='float64')
+        fp.flush()
+        del fp
+        self.fp = memmap(self.tmpfp, dtype='float64', mode='r',
+                         shape=(65536,))
+
+    def teardown(self):
+        del self.fp
+        self.tmpfp.close()
+
+    def test_regions(self):
+        from numpy.core._multiarray_umath import _page_residency
+        res = _page_residency(self.fp, regions=8)
+        if res is None:
+            # platform without mincore
+            return
+        assert_(len(res) <= 8)
+        for total, resident in res:
+            assert_(total >= 1)
+            assert_(0 <= resident <= total)
+
+    def test_touch_makes_resident(self):
+        from numpy.core._multiarray_umath import _page_residency
+        res = _page_residency(self.fp, regions=1)
+        if res is None:
+            return
+        # the whole file was just written and read back through a page
+        # cache hit, so touching it must leave pages resident
+        self.fp.sum()
+        total, resident = _page_residency(self.fp, regions=1)[0]
+        assert_(resident >= 1)
+        assert_equal(total, sum(t for t, r in res))
+
+    def test_fault_counts(self):
+        from numpy.core._multiarray_umath import _fault_counts
+        before = _fault_counts()
+        if before is None:
+            return
+        arange(1 << 18).sum()
+        after = _fault_counts()
+        assert_(after[0] >= before[0])
+        assert_(after[1] >= before[1])
@@ -763,6 +763,26 @@ class TestCreation(object):
         arr = np.array([], dtype='V')
         assert_equal(arr.dtype.kind, 'V')
 
+    def test_python_scalar_fast_lane(self):
+        # exact Python numbers take a direct 0-d construction path;
+        # it must agree with the generic discovery on dtype and value
+        for value, dtype in [(3.5, np.float64), (True, np.bool_),
+                             (-7, np.dtype(int)), (2 - 3j, np.complex128)]:
+            a = np.asarray(value)
+            assert_equal(a.shape, ())
+            assert_equal(a.dtype, np.dtype(dtype))
+            assert_equal(a.item(), value)
+            assert_(a.flags.writeable)
+        # ints that do not fit a C long keep the general promotion
+        big = 2**64 - 1
+        assert_equal(np.asarray(big).dtype, np.dtype(np.uint64))
+        assert_equal(np.asarray(big).item(), big)
+        assert_equal(np.asarray(2**70).dtype, np.dtype(object))
+        # subclasses of float/int/complex keep the general path too
+        class myfloat(float):
+            pass
+        assert_equal(np.asarray(myfloat(1.5)).item(), 1.5)
+
     def test_too_big_error(self):
         # 45341 is the smallest integer greater than sqrt(2**31 - 1).
         # 3037000500 is the smallest integer greater than sqrt(2**63 - 1).
@@ -1592,6 +1612,29 @@ class TestMethods(object):
         assert_raises(ValueError, lambda: a.transpose(0, 0))
         assert_raises(ValueError, lambda: a.transpose(0, 1, 2))
 
+    def test_transpose_flags(self):
+        # contiguity flags are derived from the permutation without a
+        # full stride walk for the identity and full reversal
+        a = np.arange(24).reshape(2, 3, 4)
+        assert_(a.transpose(2, 1, 0).flags.f_contiguous)
+        assert_(not a.transpose(2, 1, 0).flags.c_contiguous)
+        assert_(a.transpose(0, 1, 2).flags.c_contiguous)
+        assert_(a.T.T.flags.c_contiguous)
+        assert_(np.asfortranarray(a).transpose(2, 1, 0).flags.c_contiguous)
+        # mixed permutations still compute flags from the strides
+        b = a.transpose(1, 0, 2)
+        assert_(not b.flags.c_contiguous)
+        assert_(not b.flags.f_contiguous)
+        # non-contiguous input stays non-contiguous under reversal
+        c = a[:, ::2].T
+        assert_(not c.flags.c_contiguous)
+        assert_(not c.flags.f_contiguous)
+        # 0-d and 1-d transposes keep both flags
+        d = np.arange(5).T
+        assert_(d.flags.c_contiguous and d.flags.f_contiguous)
+        e = np.array(3.0).T
+        assert_(e.flags.c_contiguous and e.flags.f_contiguous)
+
     def test_sort(self):
         # test ordering for floats and complex containing nans. It is only
         # necessary to check the less-than comparison, so sorts that
@@ -1798,6 +1841,30 @@ class TestMethods(object):
             arr = rand.view(dt)
             arr[::-1].sort()
 
+    def test_structured_sort_packed_keys(self):
+        # structured dtypes with small integer fields take a packed-key
+        # fast path; check it against python's tuple ordering
+        dtypes = [
+            [('a', 'i4'), ('b', 'i4')],
+            [('a', 'u1'), ('b', 'i2'), ('c', 'u4')],
+            [('a', 'i8')],
+            [('a', 'u2'), ('b', 'u2')],
+        ]
+        for dt in dtypes:
+            arr = np.zeros(101, dtype=dt)
+            for name in arr.dtype.names:
+                iinfo = np.iinfo(arr.dtype[name])
+                arr[name] = np.random.randint(max(iinfo.min, -50),
+                                              min(iinfo.max, 50) + 1,
+                                              size=arr.size)
+            expected = sorted(arr.tolist())
+            for kind in self.sort_kinds:
+                assert_equal(np.sort(arr, kind=kind).tolist(), expected,
+                             err_msg="kind=%s, dtype=%s" % (kind, dt))
+                assert_equal(arr[np.argsort(arr, kind=kind)].tolist(),
+                             expected,
+                             err_msg="kind=%s, dtype=%s" % (kind, dt))
+
     def test_sort_raises(self):
         #gh-9404
         arr = np.array([0, datetime.now(), 1], dtype=object)
@@ -2937,6 +3004,21 @@ class TestMethods(object):
         assert_equal(b.trace(0, 1, 2), [3, 11])
         assert_equal(b.trace(offset=1, axis1=0, axis2=2), [1, 3])
 
+        # 2-d native types take a C fast path; compare against the
+        # diagonal-view reduction over offsets, orders and dtypes
+        for dt in (np.int_, np.int64, np.float32, np.float64,
+                   np.complex64, np.complex128):
+            c = (np.arange(35) % 11 + 1).reshape(5, 7).astype(dt)
+            if np.issubdtype(dt, np.complexfloating):
+                c = c - 2j*c
+            for m in (c, c.T, c[::-1], c[:, 1:]):
+                for offset in (0, 2, -3, 10, -10):
+                    assert_equal(m.trace(offset),
+                                 np.add.reduce(np.diagonal(m, offset)))
+                    assert_equal(m.trace(offset, 1, 0),
+                                 np.add.reduce(np.diagonal(m, offset, 1, 0)))
+            assert_equal(c.trace().dtype, np.diagonal(c).sum().dtype)
+
     def test_trace_subclass(self):
         # The class would need to overwrite trace to ensure single-element
         # output also has the right subclass.
@@ -4340,6 +4422,36 @@ class TestClip(object):
         expected = np.array([-1., np.nan, 0.5, 1., 0.25, np.nan])
         assert_array_equal(result, expected)
 
+    @pytest.mark.parametrize('dtype', [np.int8, np.uint8, np.int16,
+                                       np.uint16, np.int32, np.uint32,
+                                       np.float32, np.float64])
+    def test_scalar_bounds_blocked(self, dtype):
+        # hit the contiguous vectorized kernels with all vector sizes,
+        # remainders, and in-place output
+        info = (np.iinfo(dtype) if np.issubdtype(dtype, np.integer)
+                else np.finfo(dtype))
+        for size in range(1, 67):
+            x = np.linspace(info.min, info.max, size).astype(dtype)
+            lo = dtype(info.min // 2 if np.issubdtype(dtype, np.integer)
+                       else info.min / 2)
+            hi = dtype(info.max // 2 if np.issubdtype(dtype, np.integer)
+                       else info.max / 2)
+            expected = np.array([min(max(v, lo), hi) for v in x],
+                                dtype=dtype)
+            assert_array_equal(x.clip(lo, hi), expected)
+            # strided input must agree with the contiguous kernel
+            assert_array_equal(x[::2].clip(lo, hi), expected[::2])
+            # in-place, input and output share the data
+            y = x.copy()
+            y.clip(lo, hi, out=y)
+            assert_array_equal(y, expected)
+
+    def test_scalar_bounds_blocked_nan(self):
+        # nan bounds take the scalar path and poison the whole output
+        x = np.linspace(-10, 10, 24)
+        assert_(np.isnan(x.clip(np.nan, 1.0)).all())
+        assert_(np.isnan(x.clip(-1.0, np.nan)).all())
+
 
 class TestCompress(object):
     def test_axis(self):
@@ -4645,6 +4757,20 @@ class TestIO(object):
             d.tofile(f)
         assert_equal(os.path.getsize(self.filename), d.nbytes * 2)
 
+    def test_largish_file_roundtrip(self):
+        # large enough for the chunked I/O path, with contents that would
+        # expose misordered chunks, at an offset the chunks do not start at
+        d = np.arange(3 * 1024 ** 2) + 0.5
+        with open(self.filename, 'wb') as f:
+            f.write(b'xy')
+            d.tofile(f)
+            assert_equal(f.tell(), 2 + d.nbytes)
+        with open(self.filename, 'rb') as f:
+            f.read(2)
+            y = np.fromfile(f, dtype=d.dtype)
+            assert_equal(f.tell(), 2 + d.nbytes)
+        assert_array_equal(y, d)
+
     def test_io_open_buffered_fromfile(self):
         # gh-6632
         self.x.tofile(self.filename)
@@ -4795,6 +4921,21 @@ class TestIO(object):
     def test_malformed(self):
         self._check_from(b'1.234 1,234', [1.234, 1.], sep=' ')
 
+    def test_big_text_file(self):
+        # enough text to span several blocks of the buffered parser, with
+        # values that would expose a token split at a block boundary
+        d = np.arange(100000) + 0.125
+        s = ','.join(repr(x) for x in d).encode('ascii')
+        self._check_from(s, d, sep=',')
+        # a counted read leaves the position just after the parsed text
+        with open(self.filename, 'wb') as f:
+            f.write(b'1.5,2.5,3.5,4.5')
+        with open(self.filename, 'rb') as f:
+            y = np.fromfile(f, count=2, sep=',')
+            assert_array_equal(y, [1.5, 2.5])
+            # the separator after the last element is consumed as well
+            assert_equal(f.tell(), len(b'1.5,2.5,'))
+
     def test_long_sep(self):
         self._check_from(b'1_x_3_x_4_x_5', [1, 3, 4, 5], sep='_x_')
 
@@ -4860,6 +5001,59 @@ class TestFromBuffer(object):
         assert_array_equal(np.frombuffer(b''), np.array([]))
 
 
+class TestFromFd(object):
+    # _from_fd maps shared memory from a file descriptor without copying
+    from_fd = staticmethod(
+            getattr(np.core._multiarray_umath, '_from_fd', None))
+
+    @pytest.mark.skipif(sys.platform == 'win32' or sys.platform == 'cygwin',
+                        reason="needs POSIX shared mappings")
+    def test_roundtrip(self):
+        x = np.arange(24.).reshape(4, 6)
+        with tempfile.TemporaryFile() as f:
+            f.write(b'\x01' * 16)       # unaligned offset
+            f.write(x.tobytes())
+            f.flush()
+            y = self.from_fd(f.fileno(), x.dtype, x.shape, offset=16)
+            assert_array_equal(y, x)
+            assert_(y.flags.writeable)
+            # writes are visible through an independent mapping
+            y[0, 0] = -5.
+            z = self.from_fd(f.fileno(), x.dtype, x.shape, offset=16,
+                             writeable=False)
+            assert_equal(z[0, 0], -5.)
+            assert_raises(ValueError, z.__setitem__, (0, 0), 1.)
+            del y, z
+            # the descriptor may be closed while arrays are alive
+            w = self.from_fd(f.fileno(), x.dtype, x.shape, offset=16)
+        assert_equal(w[0, 0], -5.)
+        del w
+
+    @pytest.mark.skipif(sys.platform == 'win32' or sys.platform == 'cygwin',
+                        reason="needs POSIX shared mappings")
+    def test_errors(self):
+        with tempfile.TemporaryFile() as f:
+            f.write(b'\x00' * 64)
+            f.flush()
+            # empty shapes need no mapping at all
+            assert_equal(self.from_fd(f.fileno(), np.float64, (0, 3)).shape,
+                         (0, 3))
+            # mappings must not run past the end of a regular file
+            assert_raises(ValueError, self.from_fd, f.fileno(),
+                          np.float64, (9,))
+            assert_raises(ValueError, self.from_fd, f.fileno(),
+                          np.float64, (4,), 40)
+            assert_raises(ValueError, self.from_fd, f.fileno(),
+                          np.float64, (-1,))
+            assert_raises(ValueError, self.from_fd, f.fileno(), object, (2,))
+        assert_raises(ValueError, self.from_fd, -1, np.float64, (2,))
+
+    @pytest.mark.skipif(sys.platform != 'win32' and sys.platform != 'cygwin',
+                        reason="POSIX platforms support _from_fd")
+    def test_unsupported(self):
+        assert_raises(RuntimeError, self.from_fd, 0, np.float64, (1,))
+
+
 class TestFlat(object):
     def setup(self):
         a0 = np.arange(20.0)
@@ -5613,6 +5807,101 @@ class TestDot(object):
         assert_equal(zeros[0].array, zeros_test[0].array)
         assert_equal(zeros[1].array, zeros_test[1].array)
 
+    def test_dot_strided_operands(self):
+        # Transposed and column-sliced views are passed to BLAS without
+        # a copy; check all layouts against their contiguous copies.
+        np.random.seed(22)
+        for dt in (np.float32, np.float64, np.complex64, np.complex128):
+            a = np.random.rand(10, 16).astype(dt)
+            b = np.random.rand(16, 12).astype(dt)
+            v = np.random.rand(16).astype(dt)
+            if np.issubdtype(dt, np.complexfloating):
+                a = a + 1j*np.random.rand(10, 16).astype(dt)
+                b = b + 1j*np.random.rand(16, 12).astype(dt)
+            tgt = np.dot(a.copy(), b.copy())
+            assert_allclose(np.dot(a.T.copy().T, b), tgt, atol=1e-5)
+            assert_allclose(np.dot(a, b.T.copy().T), tgt, atol=1e-5)
+            # column-sliced views are strided along the rows only
+            a_s = a[:, :8]
+            b_s = b[::2, :]
+            tgt = np.dot(a_s.copy(), b_s.copy())
+            assert_allclose(np.dot(a_s, b_s), tgt, atol=1e-5)
+            assert_allclose(np.dot(a_s, b_s.copy()), tgt, atol=1e-5)
+            # strided along both axes still has to be copied
+            tgt = np.dot(a[:, ::2].copy(), b_s.copy())
+            assert_allclose(np.dot(a[:, ::2], b_s), tgt, atol=1e-5)
+            # matrix times vector with a strided matrix
+            tgt = np.dot(a_s.copy(), v[::2].copy())
+            assert_allclose(np.dot(a_s, v[::2]), tgt, atol=1e-5)
+            tgt = np.dot(v[::2].copy(), a_s.T.copy())
+            assert_allclose(np.dot(v[::2], a_s.T), tgt, atol=1e-5)
+
+    def test_fused_dot(self):
+        # activation(a @ b + bias) computed with a single pass over the
+        # output; only available when built against CBLAS
+        from numpy.core import _multiarray_umath
+        fused_dot = getattr(_multiarray_umath, '_fused_dot', None)
+        if fused_dot is None:
+            pytest.skip("numpy was not built with CBLAS")
+
+        np.random.seed(5)
+        for dt in (np.float32, np.float64):
+            a = (np.random.rand(130, 17) - 0.5).astype(dt)
+            b = (np.random.rand(17, 9) - 0.5).astype(dt)
+            bias = (np.random.rand(9) - 0.5).astype(dt)
+
+            assert_allclose(fused_dot(a, b), np.dot(a, b), atol=1e-5)
+            assert_allclose(fused_dot(a, b, bias), np.dot(a, b) + bias,
+                            atol=1e-5)
+            tgt = np.maximum(np.dot(a, b) + bias, 0)
+            res = fused_dot(a, b, bias, 'relu')
+            assert_equal(res.dtype, np.dtype(dt))
+            assert_allclose(res, tgt, atol=1e-5)
+            # transposed operands are handled without copies
+            assert_allclose(fused_dot(a.T.copy().T, b, bias, 'relu'), tgt,
+                            atol=1e-5)
+
+        # integer input promotes to double
+        res = fused_dot([[1, 2], [3, 4]], [[1, 0], [0, 1]], [1, -10], 'relu')
+        assert_equal(res, [[2, 0], [4, 0]])
+        assert_equal(res.dtype, np.dtype(np.float64))
+
+        assert_raises(ValueError, fused_dot, np.ones((2, 3)), np.ones((3, 2)),
+                      np.ones(3))
+        assert_raises(ValueError, fused_dot, np.ones((2, 3)), np.ones((3, 2)),
+                      None, 'tanh')
+        assert_raises(TypeError, fused_dot, np.ones((2, 2), dtype=complex),
+                      np.ones((2, 2)))
+
+    def test_dot_compensated_env(self):
+        # NPY_DOT_COMPENSATED=1 switches the vector dot to Neumaier
+        # summation; the switch is latched on first use, so check in a
+        # fresh interpreter
+        import subprocess
+        import textwrap
+        code = textwrap.dedent("""
+            import math
+            import numpy as np
+            # ill-conditioned: naive float64 summation loses the 1.0
+            a = np.array([1e16, 1.0, -1e16, 1.0] * 1000)
+            b = np.ones_like(a)
+            expected = math.fsum(a)
+            assert np.dot(a, b) == expected, np.dot(a, b)
+            # well-conditioned results stay correct, any size and stride
+            for n in (1, 3, 7, 64, 1001):
+                x = np.linspace(0, 1, n)
+                assert abs(np.dot(x, x) - math.fsum(x * x)) < 1e-10
+                assert abs(np.dot(x[::2], x[::2]) -
+                           math.fsum(x[::2] * x[::2])) < 1e-10
+            xf = np.arange(17, dtype=np.float32)
+            assert np.dot(xf, xf) == np.float32(float(np.dot(
+                xf.astype(np.float64), xf.astype(np.float64))))
+            """)
+        env = os.environ.copy()
+        env['NPY_DOT_COMPENSATED'] = '1'
+        p = subprocess.call([sys.executable, '-c', code], env=env)
+        assert_equal(p, 0)
+
     def test_dot_2args(self):
         from numpy.core.multiarray import dot
 
@@ -6060,7 +6349,40 @@ class TestMatmul(MatmulCommon):
 
         r3 = np.matmul(args[0].copy(), args[1].copy())
         assert_equal(r1, r3)
-    
+
+    @pytest.mark.parametrize('dtype', (np.float32, np.float64))
+    def test_blocked_noblas(self, dtype):
+        # sizes above the blocked-kernel threshold; sliced operands
+        # force the non-BLAS path even when BLAS is linked
+        a = np.arange(65 * 2 * 257, dtype=dtype).reshape(65, 2 * 257)
+        a = (a % 17)[:, ::2]
+        b = np.arange(257 * 2 * 67, dtype=dtype).reshape(257, 2 * 67)
+        b = (b % 13)[:, ::2]
+        r = np.matmul(a, b)
+        assert_allclose(r, np.matmul(a.astype(np.float64),
+                                     b.astype(np.float64)),
+                        rtol=1e-5)
+        # output slices must not be touched outside the result window
+        out = np.full((65, 69), -1, dtype=dtype)
+        np.matmul(a, b, out=out[:, 1:68])
+        assert_allclose(out[:, 1:68], r, rtol=1e-5)
+        assert_equal(out[:, 0], -1)
+        assert_equal(out[:, 68], -1)
+
+    @pytest.mark.parametrize('dtype', (np.float32, np.float64))
+    @pytest.mark.parametrize('n', (2, 3, 4))
+    def test_small_fixed(self, dtype, n):
+        # tiny square matrices take the fixed-size kernels
+        a = (np.arange(7 * n * n) % 11).astype(dtype).reshape(7, n, n)
+        b = (np.arange(7 * n * n) % 7).astype(dtype).reshape(7, n, n)
+        r = np.matmul(a, b)
+        for i in range(7):
+            assert_equal(r[i], np.dot(a[i], b[i]))
+        # strided operands go through the same path
+        assert_equal(np.matmul(a[::2], b[:4].transpose(0, 2, 1)),
+                     np.matmul(a[::2].copy(),
+                               b[:4].transpose(0, 2, 1).copy()))
+
     def test_matmul_object(self):
         import fractions
 
@@ -6960,6 +7282,30 @@ class TestNewBufferProtocol(object):
             assert_equal(count_1, count_2)
         del c  # avoid pyflakes unused variable warning.
 
+    def test_repeated_export(self):
+        # repeated exports reuse the cached buffer info, including after
+        # switching back and forth between layouts of the same array
+        a = np.arange(12, dtype=np.int64).reshape(3, 4)
+        views = []
+        for i in range(4):
+            x = a if i % 2 == 0 else a.T
+            m = memoryview(x)
+            assert_equal(m.shape, x.shape)
+            assert_equal(m.strides, x.strides)
+            assert_equal(np.asarray(m), x)
+            views.append(m)
+        # older exports must stay valid while newer ones are taken
+        for i, m in enumerate(views):
+            assert_equal(np.asarray(m), a if i % 2 == 0 else a.T)
+        # in-place shape changes are picked up on the next export
+        b = np.arange(12.)
+        m = memoryview(b)
+        assert_equal(m.shape, (12,))
+        b.shape = (3, 4)
+        m2 = memoryview(b)
+        assert_equal(m2.shape, (3, 4))
+        assert_equal(m.shape, (12,))
+
     def test_padded_struct_array(self):
         dt1 = np.dtype(
                 [('a', 'b'), ('b', 'i'), ('sub', np.dtype('b,i')), ('c', 'i')],
@@ -7245,12 +7591,39 @@ class TestMemEventHook(object):
         # multiarray/_multiarray_tests.c.src
         _multiarray_tests.test_pydatamem_seteventhook_start()
         # force an allocation and free of a numpy array
-        # needs to be larger then limit of small memory cacher in ctors.c
-        a = np.zeros(1000)
+        # needs to be larger than the caches in alloc.c, so that the
+        # block cannot be recycled without reaching malloc/free
+        a = np.zeros(200000)
         del a
         break_cycles()
         _multiarray_tests.test_pydatamem_seteventhook_end()
 
+    def test_mem_sethandler(self):
+        # The actual tests are within the C code in
+        # multiarray/_multiarray_tests.c.src
+        _multiarray_tests.test_pydatamem_sethandler_start()
+        # needs to be larger than the caches in alloc.c, so that the
+        # allocation and free both reach the installed handler
+        a = np.zeros(200000)
+        del a
+        break_cycles()
+        _multiarray_tests.test_pydatamem_sethandler_end()
+
+class TestObjectArrayRefcounts(object):
+    def test_large_object_array_decref(self):
+        # arrays above the chunking threshold in refcount.c are
+        # released chunk by chunk with GIL yields in between; check
+        # that no reference is lost or dropped twice on the way
+        obj = object()
+        rc = sys.getrefcount(obj)
+        a = np.empty(300000, dtype=object)
+        a[:] = obj
+        assert_equal(sys.getrefcount(obj), rc + a.size)
+        del a
+        break_cycles()
+        assert_equal(sys.getrefcount(obj), rc)
+
+
 class TestMapIter(object):
     def test_mapiter(self):
         # The actual tests are within the C code in
@@ -8206,3 +8579,398 @@ def test_getfield():
     pytest.raises(ValueError, a.getfield, 'uint8', -1)
     pytest.raises(ValueError, a.getfield, 'uint8', 16)
     pytest.raises(ValueError, a.getfield, 'uint64', 0)
+
+
+class TestThreadControls(object):
+    # The caps only bound the internal worker pool, so the observable
+    # contract is the get/set round-trip and the thread-locality of the
+    # per-thread limit.
+
+    def teardown(self):
+        np.core.multiarray._set_num_threads(0)
+        np.core.multiarray._set_thread_limit(0)
+
+    def test_set_num_threads_roundtrip(self):
+        from numpy.core.multiarray import _set_num_threads, _get_num_threads
+        old = _set_num_threads(2)
+        try:
+            assert_equal(_set_num_threads(3), 2)
+            assert_(_get_num_threads() <= 3)
+            # <= 0 removes the cap
+            assert_equal(_set_num_threads(0), 3)
+            assert_(_get_num_threads() >= 1)
+        finally:
+            _set_num_threads(old)
+
+    def test_thread_limit_is_thread_local(self):
+        import threading
+        from numpy.core.multiarray import (
+            _set_num_threads, _set_thread_limit, _get_num_threads)
+        results = []
+
+        def other():
+            results.append(_get_num_threads())
+
+        old = _set_thread_limit(1)
+        try:
+            assert_equal(_get_num_threads(), 1)
+            _set_num_threads(0)
+            t = threading.Thread(target=other)
+            t.start()
+            t.join()
+            # the limit pins only the setting thread
+            assert_(results[0] >= 1)
+            assert_equal(_get_num_threads(), 1)
+        finally:
+            _set_thread_limit(old)
+
+    def test_pool_survives_fork(self):
+        # a forked child inherits the pool bookkeeping but none of the
+        # worker threads; it must restart its own instead of deadlocking
+        import multiprocessing
+        try:
+            ctx = multiprocessing.get_context('fork')
+        except ValueError:
+            pytest.skip('fork start method not available')
+        from numpy.core.multiarray import _set_num_threads
+        old = _set_num_threads(2)
+        try:
+            # make sure the parent's workers are running before forking
+            np.sort(np.random.rand(200000))
+
+            def child():
+                np.sort(np.random.rand(200000))
+
+            p = ctx.Process(target=child)
+            p.start()
+            p.join(60)
+            alive = p.is_alive()
+            if alive:
+                p.terminate()
+            assert_(not alive)
+            assert_equal(p.exitcode, 0)
+        finally:
+            _set_num_threads(old)
+
+
+class TestLazyExpr(object):
+    def test_fused_chain(self):
+        from numpy.core.multiarray import _LazyExpr
+        a = np.random.rand(1000) * 10
+        b = np.random.rand(1000) * 10
+        expr = (_LazyExpr(a) - b) / (_LazyExpr(a) + b)
+        res = np.asarray(expr)
+        assert_equal(res.dtype, np.dtype(np.double))
+        assert_array_almost_equal(res, (a - b) / (a + b))
+        # evaluate() is the explicit spelling of the same thing
+        assert_array_equal(expr.evaluate(), res)
+
+    def test_scalars_and_negation(self):
+        from numpy.core.multiarray import _LazyExpr
+        a = np.arange(10.0)
+        assert_array_equal(np.asarray(2.5 * _LazyExpr(a) + 1), 2.5*a + 1)
+        assert_array_equal(np.asarray(-_LazyExpr(a)), -a)
+
+    def test_integer_input_promotes(self):
+        from numpy.core.multiarray import _LazyExpr
+        a = np.arange(10)
+        res = np.asarray(_LazyExpr(a) / 4)
+        assert_equal(res.dtype, np.dtype(np.double))
+        assert_array_equal(res, a / 4.0)
+
+    def test_shape_mismatch(self):
+        from numpy.core.multiarray import _LazyExpr
+        expr = _LazyExpr(np.arange(4.0)) + np.arange(5.0)
+        assert_raises(ValueError, expr.evaluate)
+
+
+class TestGrowableArray(object):
+    def test_append_and_view(self):
+        from numpy.core.multiarray import _GrowableArray
+        g = _GrowableArray(np.intp, 4)
+        assert_equal(len(g), 0)
+        assert_equal(g.dtype, np.dtype(np.intp))
+        for i in range(5):
+            g.append(np.arange(i, i + 3))
+        assert_equal(len(g), 15)
+        assert_(g.capacity >= 15)
+        expected = np.concatenate([np.arange(i, i + 3) for i in range(5)])
+        assert_array_equal(g.view(), expected)
+
+    def test_view_is_zero_copy(self):
+        from numpy.core.multiarray import _GrowableArray
+        g = _GrowableArray(np.double)
+        g.append([1.0, 2.0, 3.0])
+        v = g.view()
+        assert_(v.base is not None)
+        v[0] = 5.0
+        assert_equal(g.view()[0], 5.0)
+
+    def test_view_survives_growth(self):
+        from numpy.core.multiarray import _GrowableArray
+        g = _GrowableArray(np.intp, 2)
+        g.append([1, 2])
+        v = g.view()
+        # force a reallocation while the view is alive
+        g.append(np.arange(100))
+        assert_array_equal(v, [1, 2])
+        assert_equal(len(g), 102)
+        assert_array_equal(g.view()[:2], [1, 2])
+
+    def test_casts_and_flattens(self):
+        from numpy.core.multiarray import _GrowableArray
+        g = _GrowableArray(np.double)
+        batch = np.arange(6, dtype=np.int32).reshape(2, 3).T
+        g.append(batch)
+        assert_array_equal(g.view(), batch.ravel())
+        # a scalar appends a single element
+        g.append(3)
+        assert_equal(len(g), 7)
+        assert_equal(g.view()[-1], 3.0)
+
+    def test_bad_capacity(self):
+        from numpy.core.multiarray import _GrowableArray
+        assert_raises(ValueError, _GrowableArray, np.double, -1)
+
+
+class TestCountNonfinite(object):
+    def test_basic(self):
+        from numpy.core.multiarray import _count_nonfinite
+        a = np.ones(100)
+        assert_equal(_count_nonfinite(a), (0, -1))
+        a[3] = np.nan
+        a[7] = np.inf
+        a[90] = -np.inf
+        assert_equal(_count_nonfinite(a), (3, 3))
+        assert_equal(_count_nonfinite(a.astype(np.float32)), (3, 3))
+
+    def test_alignment_of_first(self):
+        from numpy.core.multiarray import _count_nonfinite
+        # exercise the scalar head and the vector body of the kernels
+        for dt in (np.float32, np.float64):
+            for pos in [0, 1, 2, 3, 30, 63]:
+                a = np.zeros(64, dtype=dt)
+                a[pos] = np.nan
+                assert_equal(_count_nonfinite(a), (1, pos))
+                assert_equal(_count_nonfinite(a[1:]), (1, pos - 1)
+                             if pos else (0, -1))
+
+    def test_strided_and_swapped(self):
+        from numpy.core.multiarray import _count_nonfinite
+        a = np.array([1.0, np.inf, 3.0])
+        # first is a C-order flat index of the operand itself
+        assert_equal(_count_nonfinite(a[::-1]), (1, 1))
+        f = np.zeros((4, 5), order='F')
+        f[1, 3] = np.nan
+        assert_equal(_count_nonfinite(f), (1, 1*5 + 3))
+        sw = a.astype(a.dtype.newbyteorder())
+        assert_equal(_count_nonfinite(sw), (1, 1))
+
+    def test_other_dtypes(self):
+        from numpy.core.multiarray import _count_nonfinite
+        assert_equal(_count_nonfinite(np.arange(10)), (0, -1))
+        assert_equal(_count_nonfinite(np.ones(10, dtype=bool)), (0, -1))
+        h = np.zeros(10, dtype=np.half)
+        h[4] = np.inf
+        assert_equal(_count_nonfinite(h), (1, 4))
+        c = np.zeros(10, dtype=np.complex64)
+        c[2] = complex(0, np.nan)
+        c[5] = complex(np.inf, 0)
+        assert_equal(_count_nonfinite(c), (2, 2))
+        l = np.zeros(10, dtype=np.longdouble)
+        l[6] = np.nan
+        assert_equal(_count_nonfinite(l), (1, 6))
+        assert_raises(TypeError, _count_nonfinite,
+                      np.array(['a', 'b']))
+
+    def test_matches_isfinite(self):
+        from numpy.core.multiarray import _count_nonfinite
+        rng = np.random.RandomState(1234)
+        a = rng.rand(1000)
+        bad = rng.choice(1000, 37, replace=False)
+        a[bad] = np.nan
+        count, first = _count_nonfinite(a)
+        assert_equal(count, np.count_nonzero(~np.isfinite(a)))
+        assert_equal(first, np.flatnonzero(~np.isfinite(a))[0])
+
+
+class TestPyArrayStd(object):
+    # np.std/np.var route through _methods, so the PyArray_Std C-API
+    # entry point is exercised through its _multiarray_tests wrapper.
+
+    def test_full_reduction_returns_scalar(self):
+        from numpy.core._multiarray_tests import run_pyarray_std
+        for dt in (np.float32, np.float64):
+            a = np.arange(10, dtype=dt)
+            res = run_pyarray_std(a)
+            assert_(not isinstance(res, np.ndarray))
+            assert_almost_equal(res, a.std(), decimal=5)
+            # a 1-d input reduced over its only axis collapses too
+            res = run_pyarray_std(a, 0)
+            assert_(not isinstance(res, np.ndarray))
+            assert_almost_equal(res, a.std(), decimal=5)
+
+    def test_axis_values(self):
+        from numpy.core._multiarray_tests import run_pyarray_std
+        rng = np.random.RandomState(42)
+        for dt in (np.float32, np.float64):
+            a = rng.rand(6, 25).astype(dt)
+            # contiguous last axis takes the single-pass kernel
+            res = run_pyarray_std(a, 1)
+            assert_(isinstance(res, np.ndarray))
+            assert_equal(res.shape, (6,))
+            assert_array_almost_equal(res, a.std(axis=1), decimal=5)
+            var = run_pyarray_std(a, 1, 1)
+            assert_array_almost_equal(var, a.var(axis=1), decimal=5)
+            # non-contiguous operands keep the generic path
+            res = run_pyarray_std(a[:, ::2], 1)
+            assert_array_almost_equal(res, a[:, ::2].std(axis=1),
+                                      decimal=5)
+
+
+class TestAllocStats(object):
+    def test_counters_advance(self):
+        from numpy.core._multiarray_umath import _get_alloc_stats
+        before = _get_alloc_stats()
+        arrays = [np.empty(1 << 14) for _ in range(4)]
+        after = _get_alloc_stats()
+        assert_(after['live_bytes'] >= before['live_bytes'] + 4 * (1 << 17))
+        assert_(after['peak_bytes'] >= after['live_bytes'])
+        # each np.empty above lands in the 128KB histogram bin
+        assert_(after['histogram'][17] >= before['histogram'][17] + 4)
+        del arrays
+        freed = _get_alloc_stats()
+        assert_(freed['live_bytes'] <= after['live_bytes'] - 4 * (1 << 17))
+
+    def test_clear(self):
+        from numpy.core._multiarray_umath import _get_alloc_stats
+        stats = _get_alloc_stats(clear=True)
+        cleared = _get_alloc_stats()
+        # live bytes survive a clear, the peak restarts from them
+        assert_equal(cleared['peak_bytes'], cleared['live_bytes'])
+        assert_equal(sum(cleared['histogram']), 0)
+        assert_(stats['peak_bytes'] >= stats['live_bytes'])
+
+    def test_cache_reuse_counted(self):
+        from numpy.core._multiarray_umath import _get_alloc_stats
+        before = _get_alloc_stats()
+        for _ in range(10):
+            # small blocks cycle through the exact-size data cache
+            np.empty(512, dtype=np.uint8)
+        after = _get_alloc_stats()
+        hits = after['data_cache_hits'] - before['data_cache_hits']
+        misses = after['data_cache_misses'] - before['data_cache_misses']
+        assert_(hits + misses >= 10)
+        assert_(hits >= 1)
+
+
+class TestDeterministicMode(object):
+    def test_previous_value_roundtrip(self):
+        from numpy.core.multiarray import _set_deterministic
+        old = _set_deterministic(1)
+        try:
+            assert_(_set_deterministic(1) is True)
+            assert_(_set_deterministic(0) is True)
+            assert_(_set_deterministic(0) is False)
+        finally:
+            _set_deterministic(old)
+
+    def test_results_unchanged(self):
+        from numpy.core.multiarray import _set_deterministic
+        # with the parallel engines at their default (serial) settings
+        # the mode must be a pure no-op for results
+        a = np.random.rand(200000)
+        expected_sum = a.sum()
+        expected_sort = np.sort(a)
+        old = _set_deterministic(1)
+        try:
+            assert_equal(a.sum(), expected_sum)
+            assert_array_equal(np.sort(a), expected_sort)
+        finally:
+            _set_deterministic(old)
+
+
+class TestTransposeCopy(object):
+    # C <-> F order conversion goes through the blocked transpose
+    # engine for trivial power-of-two itemsizes; it must agree with the
+    # generic strided transfer used by every other layout.
+
+    @pytest.mark.parametrize("dtype", ['u1', 'i2', 'f4', 'f8', 'c16'])
+    @pytest.mark.parametrize("shape", [(1, 1), (1, 37), (37, 1), (16, 16),
+                                       (45, 83), (128, 7)])
+    def test_fc_roundtrip(self, dtype, shape):
+        a = np.arange(shape[0] * shape[1]).reshape(shape).astype(dtype)
+        f = np.asfortranarray(a)
+        assert_equal(np.ascontiguousarray(f), a)
+        assert_equal(f.T.copy(), a.T)
+
+    def test_transpose_copy_values(self):
+        a = np.arange(12.).reshape(3, 4)
+        c = a.T.copy()
+        assert_(c.flags.c_contiguous)
+        assert_array_equal(c, [[0., 4., 8.],
+                               [1., 5., 9.],
+                               [2., 6., 10.],
+                               [3., 7., 11.]])
+
+    def test_strided_source_unaffected(self):
+        # a sliced transpose is not a pure permutation and keeps the
+        # generic path; results must still match
+        a = np.arange(100.).reshape(10, 10)
+        assert_equal(a[::2].T.copy(), a.T[:, ::2].copy())
+
+
+class TestHeaderOnlyViews(object):
+    # squeeze, contiguous ravel and the _ravel_view probe build their
+    # views with the header-only constructor for base class arrays
+
+    def test_ravel_view_probe(self):
+        from numpy.core.multiarray import _ravel_view
+
+        a = np.arange(12).reshape(3, 4)
+        v = _ravel_view(a)
+        assert_(v.base is a)
+        assert_array_equal(v, np.arange(12))
+        v[0] = 99
+        assert_equal(a[0, 0], 99)
+
+        # non-contiguous and wrong-order requests give None, not a copy
+        assert_(_ravel_view(a[:, ::2]) is None)
+        assert_(_ravel_view(a, 'F') is None)
+        f = np.asfortranarray(a)
+        assert_(_ravel_view(f, 'F') is not None)
+        assert_(_ravel_view(f, 'A') is not None)
+
+        # subclasses cannot take the header-only lane
+        class MyArr(np.ndarray):
+            pass
+        assert_(_ravel_view(np.arange(3).view(MyArr)) is None)
+
+    def test_squeeze_is_view(self):
+        a = np.zeros((1, 3, 1, 4))
+        s = a.squeeze()
+        assert_equal(s.shape, (3, 4))
+        assert_(s.base is a)
+        s[0, 0] = 5.
+        assert_equal(a[0, 0, 0, 0], 5.)
+        assert_equal(a.squeeze(axis=2).shape, (1, 3, 4))
+
+    def test_ravel_contiguous_is_view(self):
+        a = np.arange(6.).reshape(2, 3)
+        r = a.ravel()
+        assert_(r.base is a)
+        f = np.asfortranarray(a)
+        assert_(f.ravel(order='F').base is f)
+        # non-contiguous still copies
+        assert_(a[:, ::2].ravel().base is None)
+
+    def test_expand_dims_is_view(self):
+        from numpy.lib import expand_dims
+
+        a = np.arange(10.).reshape(2, 5)
+        for axis in range(-3, 3):
+            e = expand_dims(a, axis)
+            assert_equal(e.shape,
+                         a.shape[:axis % 3] + (1,) + a.shape[axis % 3:])
+            assert_(e.base is a)
+            assert_(e.flags.c_contiguous)
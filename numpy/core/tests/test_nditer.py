@@ -1668,6 +1668,29 @@ def test_iter_buffering():
                 i.iternext()
             assert_equal(np.concatenate(vals), a.ravel(order='C'))
 
+def test_iter_buffering_auto_bufsize():
+    # Automatic buffer sizing iterates the same as the default
+
+    a = np.arange(120, dtype='f8').reshape(5, 3, 2, 4).T
+    i = nditer(a, ['buffered', 'external_loop', 'auto_bufsize'],
+                   [['readonly', 'nbo', 'aligned']],
+                   order='C',
+                   casting='equiv')
+    vals = []
+    while not i.finished:
+        vals.append(i[0].copy())
+        i.iternext()
+    assert_equal(np.concatenate(vals), a.ravel(order='C'))
+    # An explicit buffersize takes precedence over the flag
+    i = nditer(a, ['buffered', 'external_loop', 'auto_bufsize'],
+                   [['readonly', 'nbo', 'aligned']],
+                   order='C',
+                   casting='equiv',
+                   buffersize=7)
+    while not i.finished:
+        assert_(i[0].size <= 7)
+        i.iternext()
+
 def test_iter_write_buffering():
     # Test that buffering of writes is working
 
@@ -309,6 +309,44 @@ class TestBoolArray(object):
             e[i] = False
             assert_(not np.all(e), msg="%r" % i)
 
+    def test_all_any_dtypes(self):
+        # the full reduction takes an early-exit path that tests elements
+        # with the dtype's truth test rather than casting to bool
+        for dt in [np.int8, np.uint16, np.int64, np.float16, np.float32,
+                   np.float64, np.longdouble, np.complex64, np.complex128]:
+            ones = np.ones(67, dtype=dt)
+            zeros = np.zeros(67, dtype=dt)
+            assert_(ones.all())
+            assert_(ones.any())
+            assert_(not zeros.all())
+            assert_(not zeros.any())
+            for i in [0, 1, 33, 66]:
+                d = zeros.copy()
+                d[i] = 1
+                assert_(d.any())
+                assert_(not d.all())
+            # strided and multidimensional views
+            assert_(ones[::3].all())
+            assert_(not zeros[::3].any())
+            assert_(ones.reshape(67, 1)[::2, :].all())
+            # empty reductions keep their identities
+            assert_(zeros[:0].all())
+            assert_(not zeros[:0].any())
+
+    def test_all_any_float_specials(self):
+        # negative zero is false despite its nonzero bit pattern, nan and
+        # inf are true
+        for dt in [np.float32, np.float64]:
+            assert_(not np.array([-0.0] * 32, dtype=dt).any())
+            assert_(np.array([np.nan] * 32, dtype=dt).all())
+            assert_(np.array([np.inf] * 32, dtype=dt).all())
+        assert_(not np.array([-0.0 - 0.0j] * 32).any())
+        # byteswapped operands must agree with the native result
+        d = np.array([-0.0, 1.0, -0.0] * 11)
+        swapped = d.astype(d.dtype.newbyteorder())
+        assert_equal(swapped.any(), d.any())
+        assert_equal(swapped.all(), d.all())
+
     def test_logical_not_abs(self):
         assert_array_equal(~self.t, self.f)
         assert_array_equal(np.abs(~self.t), self.f)
@@ -788,6 +826,32 @@ class TestTypes(object):
         assert_equal(np.promote_types('<m8', '<m8'), np.dtype('m8'))
         assert_equal(np.promote_types('>m8', '>m8'), np.dtype('m8'))
 
+    def test_promote_types_repeated(self):
+        # Repeated calls for the same builtin pair are served from an
+        # interned cache and must keep returning the correct singleton.
+        numeric = ['?', 'b', 'h', 'i', 'l', 'B', 'H', 'I', 'L',
+                   'e', 'f', 'd', 'g', 'F', 'D', 'G']
+        for t1 in numeric:
+            for t2 in numeric:
+                first = np.promote_types(t1, t2)
+                second = np.promote_types(t1, t2)
+                assert_(first is second)
+                assert_equal(first, np.result_type(np.dtype(t1),
+                                                   np.dtype(t2)))
+        # flexible pairs are not cached; the size calculation must
+        # still run every time
+        assert_equal(np.promote_types('S5', 'U3'), np.dtype('U5'))
+        assert_equal(np.promote_types('S5', 'U3'), np.dtype('U5'))
+        assert_equal(np.promote_types('i8', 'U2'), np.dtype('U21'))
+        assert_equal(np.promote_types('i8', 'U2'), np.dtype('U21'))
+
+    def test_result_type_many_operands(self):
+        # more operands than NPY_MAXARGS exercises the heap fallback
+        arrs = [np.ones(3, dtype=np.int8) for _ in range(40)]
+        assert_equal(np.result_type(*arrs), np.dtype(np.int8))
+        assert_equal(np.result_type(np.float32(0), *arrs),
+                     np.dtype(np.float32))
+
     def test_promote_types_strings(self):
         assert_equal(np.promote_types('bool', 'S'), np.dtype('S5'))
         assert_equal(np.promote_types('b', 'S'), np.dtype('S4'))
@@ -899,6 +963,28 @@ class TestTypes(object):
         # Also test keyword arguments
         assert_(np.can_cast(from_=np.int32, to=np.int64))
 
+    def test_can_cast_table_consistency(self):
+        # builtin pairs are answered from a precomputed table; check it
+        # against the rule definitions for every numeric pair
+        numeric = ['?', 'b', 'h', 'i', 'l', 'B', 'H', 'I', 'L',
+                   'e', 'f', 'd', 'g', 'F', 'D', 'G']
+        for t1 in numeric:
+            for t2 in numeric:
+                dt1, dt2 = np.dtype(t1), np.dtype(t2)
+                # 'no' and 'equiv' only accept the same type
+                assert_equal(np.can_cast(dt1, dt2, 'no'), dt1 == dt2)
+                assert_equal(np.can_cast(dt1, dt2, 'equiv'), dt1 == dt2)
+                # 'safe' casts must roundtrip through promotion
+                assert_equal(np.can_cast(dt1, dt2, 'safe'),
+                             np.promote_types(dt1, dt2) == dt2)
+                # 'same_kind' is at least as permissive as 'safe'
+                if np.can_cast(dt1, dt2, 'safe'):
+                    assert_(np.can_cast(dt1, dt2, 'same_kind'))
+                assert_(np.can_cast(dt1, dt2, 'unsafe'))
+        # byte order still matters for 'no', and never for 'equiv'
+        assert_(not np.can_cast('<f8', '>f8', 'no'))
+        assert_(np.can_cast('<f8', '>f8', 'equiv'))
+
     def test_can_cast_values(self):
         # gh-5917
         for dt in np.sctypes['int'] + np.sctypes['uint']:
@@ -1274,6 +1360,32 @@ class TestArrayComparisons(object):
         assert_(res)
         assert_(type(res) is bool)
 
+    def test_self_comparison_shortcut(self):
+        # integer/bool arrays compared against themselves (or identical
+        # views) short-circuit; the results must match the elementwise
+        # loop exactly
+        a = np.arange(10, dtype=np.int64)
+        for x, y in [(a, a), (a[::2], a[::2]), (a[2:], a[2:])]:
+            assert_array_equal(x == y, np.ones(len(x), dtype=bool))
+            assert_array_equal(x <= y, np.ones(len(x), dtype=bool))
+            assert_array_equal(x >= y, np.ones(len(x), dtype=bool))
+            assert_array_equal(x != y, np.zeros(len(x), dtype=bool))
+            assert_array_equal(x < y, np.zeros(len(x), dtype=bool))
+            assert_array_equal(x > y, np.zeros(len(x), dtype=bool))
+        res = a == a
+        assert_equal(res.dtype, np.dtype(bool))
+        assert_(res.flags.writeable)
+        # 0-d self-comparison still gives a scalar
+        b = np.array(3)
+        assert_(np.isscalar(b == b))
+        assert_((b == b) is not False)
+        # same values but distinct memory keeps the elementwise path,
+        # as do float arrays, where NaN != NaN
+        assert_array_equal(a == a.copy(), np.ones(10, dtype=bool))
+        f = np.array([1.0, np.nan])
+        assert_array_equal(f == f, [True, False])
+        assert_array_equal(f != f, [False, True])
+
     def test_none_compares_elementwise(self):
         a = np.array([None, 1, None], dtype=object)
         assert_equal(a == None, [True, False, True])
@@ -2442,6 +2554,26 @@ class TestCorrelate(object):
         assert_array_equal(d, np.ones(100))
         assert_array_equal(k, np.ones(3))
 
+    def test_mid_size_kernels(self):
+        # kernels of 12 to 32 taps take the blocked direct path; check
+        # against a per-point dot reference for all modes
+        np.random.seed(5)
+        for dt in [np.float32, np.float64]:
+            d = np.random.randn(100).astype(dt)
+            for nk in [11, 12, 13, 20, 32, 33]:
+                k = np.random.randn(nk).astype(dt)
+                ref = np.array([np.dot(d[i:i + nk].astype(np.float64),
+                                       k.astype(np.float64))
+                                for i in range(100 - nk + 1)])
+                z = np.correlate(d, k, 'valid')
+                assert_array_almost_equal(z, ref, decimal=4,
+                                          err_msg=str((dt, nk)))
+                # strided data uses the same kernel
+                zs = np.correlate(d[::2], k[:12], 'valid')
+                refs = np.array([np.dot(d[::2][i:i + 12], k[:12])
+                                 for i in range(50 - 12 + 1)])
+                assert_array_almost_equal(zs, refs, decimal=4)
+
     def test_complex(self):
         x = np.array([1, 2, 3, 4+1j], dtype=complex)
         y = np.array([-1, -2j, 3+1j], dtype=complex)
@@ -2550,6 +2682,29 @@ class TestRoll(object):
         x = np.array([])
         assert_equal(np.roll(x, 1), np.array([]))
 
+    def test_roll_contiguous_matches_sliced(self):
+        # the contiguous last-axis roll is a two-memcpy C path; it must
+        # agree with the sliced gather that non-contiguous input takes
+        x = np.random.rand(7, 501)
+        for shift in (0, 1, -1, 250, -250, 501, 502, -1003):
+            assert_equal(np.roll(x, shift, axis=1),
+                         np.roll(x[:, ::-1], -shift, axis=1)[:, ::-1])
+        y = np.random.rand(10000)
+        for shift in (3, -3, 9999, 10001):
+            assert_equal(np.roll(y, shift), np.roll(y[::-1], -shift)[::-1])
+
+    def test_roll_returns_copy(self):
+        # a zero shift must still copy
+        x = np.arange(5)
+        r = np.roll(x, 0)
+        r[0] = 99
+        assert_equal(x[0], 0)
+
+    def test_roll_object(self):
+        x = np.array([[1, 'a'], [2.5, None]], dtype=object)
+        assert_equal(np.roll(x, 1, axis=1),
+                     np.array([['a', 1], [None, 2.5]], dtype=object))
+
 
 class TestRollaxis(object):
 
@@ -2687,6 +2842,53 @@ class TestMoveaxis(object):
         assert_(isinstance(result, np.ndarray))
 
 
+class TestIndices(object):
+    def test_simple(self):
+        [x, y] = np.indices((4, 3))
+        assert_array_equal(x, np.array([[0, 0, 0],
+                                        [1, 1, 1],
+                                        [2, 2, 2],
+                                        [3, 3, 3]]))
+        assert_array_equal(y, np.array([[0, 1, 2],
+                                        [0, 1, 2],
+                                        [0, 1, 2],
+                                        [0, 1, 2]]))
+
+    def test_single_input(self):
+        [x] = np.indices((4,))
+        assert_array_equal(x, np.array([0, 1, 2, 3]))
+
+        [x] = np.indices((4,), sparse=True)
+        assert_array_equal(x, np.array([0, 1, 2, 3]))
+
+    def test_scalar_input(self):
+        assert_array_equal([], np.indices(()))
+        assert_array_equal([], np.indices((0,)))
+        assert_array_equal([[]], np.indices((1, 0)))
+
+    def test_sparse(self):
+        [x, y] = np.indices((4, 3), sparse=True)
+        assert_array_equal(x, np.array([[0], [1], [2], [3]]))
+        assert_array_equal(y, np.array([[0, 1, 2]]))
+        # the sparse grid broadcasts to the dense one
+        [xd, yd] = np.indices((4, 3))
+        assert_array_equal(x + 10 * y, xd + 10 * yd)
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.int64, np.float32,
+                                       np.float64])
+    @pytest.mark.parametrize("dims", [(), (0,), (4, 3)])
+    def test_return_type(self, dtype, dims):
+        sz = len(dims)
+        res = np.indices(dims, dtype=dtype)
+        assert_(res.dtype == np.dtype(dtype))
+        assert_equal(res.shape, (sz,) + dims)
+
+        res = np.indices(dims, dtype=dtype, sparse=True)
+        assert_(len(res) == sz)
+        for idx, dim in zip(res, dims):
+            assert_(idx.dtype == np.dtype(dtype))
+
+
 class TestCross(object):
     def test_2x2(self):
         u = [1, 2]
@@ -2776,6 +2978,73 @@ def test_outer_out_param():
     assert_equal(np.outer(arr2, arr3, out2), out2)
 
 
+class TestOuterFastPath(object):
+    # np.outer dispatches contiguous float vectors to a direct rank-1
+    # kernel; these check it matches the broadcasting multiply and that
+    # the unsupported cases still go through the general path.
+
+    def test_matches_multiply(self):
+        for dt in (np.float32, np.float64):
+            a = np.linspace(-3, 3, 137).astype(dt)
+            b = np.linspace(1, 5, 211).astype(dt)
+            expected = np.multiply(a[:, np.newaxis], b[np.newaxis, :])
+            res = np.outer(a, b)
+            assert_equal(res.dtype, np.dtype(dt))
+            assert_array_equal(res, expected)
+
+    def test_large_exact(self):
+        # spans several row blocks of the tiled kernel
+        a = np.random.rand(513)
+        b = np.random.rand(2049)
+        assert_array_equal(np.outer(a, b),
+                           np.multiply(a[:, np.newaxis], b[np.newaxis, :]))
+
+    def test_out_param(self):
+        a = np.random.rand(31).astype(np.float32)
+        b = np.random.rand(17).astype(np.float32)
+        out = np.empty((31, 17), dtype=np.float32)
+        res = np.outer(a, b, out)
+        assert_(res is out)
+        assert_array_equal(out, np.outer(a, b))
+
+    def test_out_overlap(self):
+        # out sharing memory with an operand must still be correct
+        buf = np.random.rand(10 * 10 + 10)
+        a = buf[:10]
+        out = buf[:100].reshape(10, 10)
+        expected = np.outer(a.copy(), a.copy())
+        assert_array_equal(np.outer(a, a, out), expected)
+
+    def test_fallback_cases(self):
+        # mixed dtypes, non-float dtypes and empty operands take the
+        # general broadcasting path but must agree with it
+        a = np.arange(5, dtype=np.float64)
+        b = np.arange(7, dtype=np.float32)
+        assert_array_equal(np.outer(a, b),
+                           np.multiply(a[:, np.newaxis], b[np.newaxis, :]))
+        i = np.arange(4)
+        assert_array_equal(np.outer(i, i), i[:, np.newaxis] * i)
+        assert_equal(np.outer(np.empty(0), np.ones(3)).shape, (0, 3))
+
+    def test_strided_input(self):
+        a = np.linspace(0, 1, 40)[::2]
+        b = np.linspace(0, 1, 21)
+        assert_array_equal(np.outer(a, b),
+                           np.multiply(a[:, np.newaxis], b[np.newaxis, :]))
+
+    def test_subclass(self):
+        # asarray strips subclasses before either path, so the result
+        # stays a base ndarray as before
+        class MyArray(np.ndarray):
+            pass
+
+        a = np.arange(3.).view(MyArray)
+        b = np.arange(4.)
+        res = np.outer(a, b)
+        assert_(type(res) is np.ndarray)
+        assert_array_equal(res, np.outer(np.asarray(a), b))
+
+
 class TestRequire(object):
     flag_names = ['C', 'C_CONTIGUOUS', 'CONTIGUOUS',
                   'F', 'F_CONTIGUOUS', 'FORTRAN',
@@ -2928,3 +3197,30 @@ class TestTensordot(object):
         arr_0d = np.array(1)
         ret = np.tensordot(arr_0d, arr_0d, ([], []))  # contracting no axes is well defined
         assert_array_equal(ret, arr_0d)
+
+    def test_contracted_axis_reorder(self):
+        # the contracted axes may be walked in any order for numeric
+        # dtypes; check every pairing against einsum on several layouts
+        a = np.arange(60).reshape(3, 4, 5)
+        b = np.arange(40).reshape(4, 5, 2)
+        for a_ in [a, np.asfortranarray(a), a[:, ::2], a[::-1]]:
+            for axes in [([1], [0]), ([1, 2], [0, 1]), ([2, 1], [1, 0])]:
+                sub = ''.join('ijk'[ax] for ax in axes[0])
+                spec = 'ijk,{}m->{}m'.format(
+                    sub, ''.join(c for c in 'ijk' if c not in sub))
+                b_ = np.arange(np.multiply.reduce(
+                    [a_.shape[ax] for ax in axes[0]] + [2])).reshape(
+                    [a_.shape[ax] for ax in axes[0]] + [2])
+                # integer dot products are exact, so reordering the
+                # contracted axes must not change anything
+                assert_array_equal(np.tensordot(a_, b_, axes),
+                                   np.einsum(spec, a_, b_))
+
+    def test_object_order_preserved(self):
+        # object addition is not reassociated, the documented term order
+        # must survive (see the tensordot docstring examples)
+        a = np.array(range(1, 9)).reshape(2, 2, 2)
+        A = np.array(('a', 'b', 'c', 'd'), dtype=object).reshape(2, 2)
+        assert_equal(np.tensordot(a, A, ((2, 1), (1, 0))),
+                     np.array(['acccbbdddd', 'aaaaacccccccbbbbbbdddddddd'],
+                              dtype=object))
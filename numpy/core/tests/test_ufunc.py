@@ -449,6 +449,40 @@ class TestUfunc(object):
         np.add(a, 0.5, sig=('i4', 'i4', 'i4'), out=b, casting='unsafe')
         assert_equal(b, [0, 0, 1])
 
+    def test_out_cast_on_store(self):
+        # mismatched-dtype out= stores converted chunks directly; the
+        # result must match computing at full precision and casting
+        a = np.linspace(0, 1, 10007)
+        b = np.linspace(1, 2, 10007)
+        out = np.empty(10007, dtype='f4')
+        np.add(a, b, out=out)
+        assert_equal(out, (a + b).astype('f4'))
+
+        out_i = np.empty(10007, dtype='i4')
+        np.multiply(a, b, out=out_i, casting='unsafe')
+        assert_equal(out_i, (a * b).astype('i4'))
+
+        # unary ufunc, and a byte-swapped output
+        out = np.empty(10007, dtype='>f4')
+        np.sqrt(a, out=out)
+        assert_equal(out, np.sqrt(a).astype('f4'))
+
+        # strided 1-d output is stored through the same transfer
+        out2 = np.empty(2 * 10007, dtype='f4')[::2]
+        np.add(a, b, out=out2)
+        assert_equal(out2, (a + b).astype('f4'))
+
+        # scalar operand broadcast against an array
+        out = np.empty(10007, dtype='f4')
+        np.add(a, 0.5, out=out)
+        assert_equal(out, (a + 0.5).astype('f4'))
+
+        # output overlapping an input view of a different dtype
+        buf = np.arange(16, dtype='f8')
+        expected = (buf[:8] + 1).astype('f4')
+        np.add(buf[:8], 1, out=buf.view('f4')[:8])
+        assert_equal(buf.view('f4')[:8], expected)
+
     def test_true_divide(self):
         a = np.array(10)
         b = np.array(20)
@@ -1608,6 +1642,31 @@ class TestUfunc(object):
             np.multiply(_rational_tests.rational(1), 1,
                         signature=(_rational_tests.rational, int, None))
 
+    def test_custom_ufunc_tiered_loops(self):
+        # test_tiered_add is registered through
+        # PyUFunc_RegisterLoopForTypeTiered; the contiguous kernel may only
+        # run when every operand is unit-strided, and both tiers must agree
+        # with the plain userloop ufunc.
+        a = np.array(
+            [_rational_tests.rational(1, d) for d in range(1, 9)],
+            dtype=_rational_tests.rational)
+        b = np.array(
+            [_rational_tests.rational(2, d) for d in range(1, 9)],
+            dtype=_rational_tests.rational)
+
+        before = _rational_tests.tiered_contig_call_count()
+        result = _rational_tests.test_tiered_add(a, b)
+        after = _rational_tests.tiered_contig_call_count()
+        assert_equal(result, _rational_tests.test_add_rationals(a, b))
+        assert_(after > before)
+
+        before = after
+        result = _rational_tests.test_tiered_add(a[::2], b[::2])
+        after = _rational_tests.tiered_contig_call_count()
+        assert_equal(result,
+                     _rational_tests.test_add_rationals(a[::2], b[::2]))
+        assert_equal(after, before)
+
     def test_custom_array_like(self):
 
         class MyThing(object):
@@ -703,6 +703,34 @@ class TestExpLogFloat32(object):
                 assert_equal(np.exp(x_f32[::jj]), exp_true[::jj])
                 assert_equal(np.log(x_f32[::jj]), log_true[::jj])
 
+class TestFMA(object):
+    def test_fma_values(self):
+        for dt in [np.float16, np.float32, np.float64, np.longdouble]:
+            a = np.array([2, -3, 0.5, 7], dtype=dt)
+            b = np.array([4, 0.25, -8, 1.5], dtype=dt)
+            c = np.array([1, -1, 0.125, -2], dtype=dt)
+            r = np.core.umath.fma(a, b, c)
+            assert_equal(r.dtype, np.dtype(dt))
+            assert_array_almost_equal(r, a*b + c)
+
+    def test_fma_float32(self):
+        # exercise both the vector and the scalar tail code paths
+        np.random.seed(42)
+        for size in [1, 15, 16, 17, 1000003]:
+            a = np.float32(np.random.uniform(low=-10., high=10., size=size))
+            b = np.float32(np.random.uniform(low=-10., high=10., size=size))
+            c = np.float32(np.random.uniform(low=-10., high=10., size=size))
+            expected = np.float32(np.float64(a)*np.float64(b) + np.float64(c))
+            assert_array_max_ulp(np.core.umath.fma(a, b, c), expected, maxulp=1)
+
+    def test_fma_out(self):
+        a = np.arange(10.)
+        out = np.empty(10)
+        r = np.core.umath.fma(a, a, a, out)
+        assert_(r is out)
+        assert_equal(r, a*a + a)
+
+
 class TestLogAddExp(_FilterInvalids):
     def test_logaddexp_values(self):
         x = [1, 2, 3, 4, 5]
@@ -1446,6 +1474,61 @@ class TestAbsoluteNegative(object):
         np.abs(np.ones_like(d), out=d)
 
 
+class TestComplexArithmeticBlocked(object):
+    def test_arithmetic_blocked(self):
+        # vectorized complex add/multiply/conjugate/abs must match the
+        # scalar expressions for all sizes around the vector boundaries
+        for dt in [np.complex64, np.complex128]:
+            for sz in range(1, 12):
+                a = (np.arange(sz) + 1j * np.arange(1, sz + 1)).astype(dt)
+                b = (np.arange(2, sz + 2) - 1j * np.arange(sz)).astype(dt)
+                msg = "dtype %s size %d" % (dt, sz)
+                assert_equal(a + b, [complex(x) + complex(y)
+                                     for x, y in zip(a, b)], err_msg=msg)
+                assert_equal(a - b, [complex(x) - complex(y)
+                                     for x, y in zip(a, b)], err_msg=msg)
+                tgt = [dt(complex(x.real*y.real - x.imag*y.imag,
+                                  x.real*y.imag + x.imag*y.real))
+                       for x, y in zip(a, b)]
+                assert_equal(a * b, tgt, err_msg=msg)
+                # scalar operand paths
+                assert_equal(a * b[0], [dt(complex(x)*complex(b[0]))
+                                        for x in a], err_msg=msg)
+                assert_equal(a[0] + b, [dt(complex(a[0]) + complex(y))
+                                        for y in b], err_msg=msg)
+                assert_equal(np.conj(a), [complex(x.real, -x.imag)
+                                          for x in a], err_msg=msg)
+                assert_almost_equal(np.abs(a), [abs(complex(x)) for x in a],
+                                    err_msg=msg)
+                # in-place
+                c = a.copy()
+                c *= b
+                assert_equal(c, tgt, err_msg=msg)
+
+    def test_abs_specials_blocked(self):
+        # C99 cabs specials must survive the vectorized path at any
+        # position inside the block
+        for dt, rt in [(np.complex64, np.float32), (np.complex128, np.float64)]:
+            for sz in [4, 7, 8]:
+                for i in range(sz):
+                    for z, tgt in [(complex(np.inf, np.nan), np.inf),
+                                   (complex(np.nan, -np.inf), np.inf),
+                                   (complex(np.nan, 1), np.nan),
+                                   (complex(0, 0), 0)]:
+                        a = np.full(sz, 3 + 4j, dtype=dt)
+                        a[i] = z
+                        r = np.full(sz, 5, dtype=rt)
+                        r[i] = tgt
+                        assert_equal(np.abs(a), r,
+                                     err_msg="%s %d %d %r" % (dt, sz, i, z))
+
+    def test_abs_overflow_blocked(self):
+        # the scaled formulation must not overflow the squares
+        for dt, big in [(np.complex64, 3e38), (np.complex128, 1e308)]:
+            a = np.full(8, complex(big, big * 0.5), dtype=dt)
+            assert_(np.isfinite(np.abs(a)).all())
+
+
 class TestPositive(object):
     def test_valid(self):
         valid_dtypes = [int, float, complex, object]
@@ -3024,3 +3107,53 @@ def test_outer_subclass_preserve(arr):
     class foo(np.ndarray): pass
     actual = np.multiply.outer(arr.view(foo), arr.view(foo))
     assert actual.__class__.__name__ == 'foo'
+
+
+class TestUfuncStats(object):
+    def test_counters(self):
+        from numpy.core._multiarray_umath import (
+            _set_ufunc_stats, _get_ufunc_stats)
+        a = np.arange(100.0)
+        assert_(_set_ufunc_stats(1) is False)
+        try:
+            np.add(a, a)
+            np.add(a, a)
+            np.add.reduce(a)
+            stats = {(name, sig): (calls, elements)
+                     for name, sig, calls, elements, ns
+                     in _get_ufunc_stats(clear=True)}
+        finally:
+            _set_ufunc_stats(0)
+        assert_equal(stats[('add', 'ddd')][0], 2)
+        assert_equal(stats[('add', 'ddd')][1], 200)
+        assert_equal(stats[('add', 'd:reduce')], (1, 100))
+        # the dump above cleared the table
+        assert_equal(_get_ufunc_stats(), [])
+
+    def test_disabled_by_default(self):
+        from numpy.core._multiarray_umath import _get_ufunc_stats
+        np.multiply(np.ones(3), 3.0)
+        assert_equal(_get_ufunc_stats(), [])
+
+
+class TestCpuDispatchInfo(object):
+    def test_cpu_features(self):
+        from numpy.core._multiarray_umath import _cpu_features
+        features = _cpu_features()
+        for name in ('sse2', 'avx', 'avx2', 'avx512f', 'f16c'):
+            assert_(name in features)
+            assert_(isinstance(features[name], bool))
+
+    def test_simd_dispatch_info(self):
+        from numpy.core._multiarray_umath import (
+            _cpu_features, _simd_dispatch_info)
+        info = _simd_dispatch_info()
+        features = _cpu_features()
+        for name, typechar, isa in info:
+            # only loops of detected instruction sets get installed
+            assert_(features[isa])
+            assert_(isinstance(getattr(np, name), np.ufunc))
+            assert_equal(len(typechar), 1)
+        if any(isa == 'avx2' for _, _, isa in info):
+            # integer add is among the avx2 variants
+            assert_(('add', 'l', 'avx2') in info)
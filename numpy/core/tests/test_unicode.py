@@ -4,7 +4,8 @@ import sys
 
 import numpy as np
 from numpy.compat import unicode
-from numpy.testing import assert_, assert_equal, assert_array_equal
+from numpy.testing import (
+    assert_, assert_equal, assert_array_equal, assert_raises)
 
 # Guess the UCS length for this python interpreter
 if sys.version_info[:2] >= (3, 3):
@@ -394,3 +395,57 @@ class TestByteorder_1009_UCS4(ByteorderValues):
     """Check the byteorder in unicode (size 1009, UCS4 values)"""
     ulen = 1009
     ucs_value = ucs4_value
+
+
+class TestUTF8BulkCodec(object):
+    """Check the bulk UCS4<->UTF-8 transcoder against Python's codec"""
+    encode = staticmethod(np.core._multiarray_umath._encode_utf8)
+    decode = staticmethod(np.core._multiarray_umath._decode_utf8)
+
+    def test_roundtrip(self):
+        values = [u'', u'ascii', u'ń', u'╅ot ascii',
+                  ucs2_value * 3, ucs4_value + u'tail', u'sp\0lit']
+        arr = np.array(values)
+        data, offsets = self.encode(arr)
+        assert_equal(offsets.dtype, np.int64)
+        assert_equal(offsets[0], 0)
+        assert_equal(offsets[-1], len(data))
+        for i, value in enumerate(values):
+            assert_equal(data[offsets[i]:offsets[i + 1]],
+                         value.encode('utf-8'))
+        back = self.decode(data, offsets)
+        assert_array_equal(back, arr)
+        # an explicit width pads, a too-small one raises
+        wide = self.decode(data, offsets, chars=64)
+        assert_equal(wide.dtype, np.dtype('U64'))
+        assert_array_equal(wide, arr)
+        assert_raises(ValueError, self.decode, data, offsets, chars=2)
+
+    def test_layouts(self):
+        # non-contiguous and byte-swapped inputs are handled via a copy
+        arr = np.array([u'one', u'two', u'three', u'four'])
+        data, offsets = self.encode(arr[::2])
+        assert_equal(data, b'onethree')
+        swapped = arr.astype(arr.dtype.newbyteorder())
+        data2, offsets2 = self.encode(swapped)
+        assert_equal(data2, self.encode(arr)[0])
+        assert_array_equal(offsets2, self.encode(arr)[1])
+
+    def test_empty_and_errors(self):
+        data, offsets = self.encode(np.array([], dtype='U4'))
+        assert_equal(data, b'')
+        assert_equal(len(offsets), 1)
+        assert_equal(self.decode(data, offsets).shape, (0,))
+        # all-empty elements still produce a representable dtype
+        back = self.decode(*self.encode(np.array([u'', u''])))
+        assert_equal(back.dtype, np.dtype('U1'))
+        assert_raises(TypeError, self.encode, np.arange(3))
+        assert_raises(ValueError, self.decode, b'\xff\xff',
+                      np.array([0, 2], dtype=np.int64))
+        assert_raises(ValueError, self.decode, b'ab',
+                      np.array([0, 3], dtype=np.int64))
+        # lone surrogates round-trip like 'surrogatepass'
+        arr = np.array([u'\ud800'])
+        data, offsets = self.encode(arr)
+        assert_equal(data, u'\ud800'.encode('utf-8', 'surrogatepass'))
+        assert_array_equal(self.decode(data, offsets), arr)
@@ -76,6 +76,27 @@ def _raw_fft(a, n, axis, is_real, is_forward, fct):
     return r
 
 
+def _raw_fft2(a, n1, n2, is_forward, fct):
+    # crop or zero-pad the last two axes, as _raw_fft does for one axis
+    for axis, n in ((a.ndim - 2, n1), (a.ndim - 1, n2)):
+        if n < 1:
+            raise ValueError("Invalid number of FFT data points (%d) specified."
+                             % n)
+        if a.shape[axis] != n:
+            s = list(a.shape)
+            index = [slice(None)]*len(s)
+            if s[axis] > n:
+                index[axis] = slice(0, n)
+                a = a[tuple(index)]
+            else:
+                index[axis] = slice(0, s[axis])
+                s[axis] = n
+                z = zeros(s, a.dtype.char)
+                z[tuple(index)] = a
+                a = z
+    return pfi.execute2d(a, is_forward, fct)
+
+
 def _unitary(norm):
     if norm is None:
         return False
@@ -624,6 +645,19 @@ def _cook_nd_args(a, s=None, axes=None, invreal=0):
 def _raw_fftnd(a, s=None, axes=None, function=fft, norm=None):
     a = asarray(a)
     s, axes = _cook_nd_args(a, s, axes)
+    # When the two innermost transforms run over the last two axes of
+    # the array, hand them to the native 2-D engine, which keeps both
+    # passes on contiguous data instead of striding down the columns.
+    if (function in (fft, ifft) and len(axes) >= 2 and a.ndim >= 2 and
+            normalize_axis_index(axes[-1], a.ndim) == a.ndim - 1 and
+            normalize_axis_index(axes[-2], a.ndim) == a.ndim - 2):
+        n1, n2 = s[-2], s[-1]
+        if norm is not None and _unitary(norm):
+            fct = 1 / sqrt(n1 * n2)
+        else:
+            fct = 1 if function is fft else 1 / (n1 * n2)
+        a = _raw_fft2(a, n1, n2, function is fft, fct)
+        s, axes = s[:-2], axes[:-2]
     itl = list(range(len(axes)))
     itl.reverse()
     for ii in itl:
@@ -0,0 +1,50 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ * Single-precision instantiation of the transform machinery, selected
+ * by the module layer in pocketfft.c when the input is float32.  The
+ * machinery itself is static, so only the thin wrappers declared in
+ * pocketfft_sp.h are visible outside this translation unit.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "npy_config.h"
+#define restrict NPY_RESTRICT
+
+#define FTYPE float
+#include "pocketfft_body.inc"
+
+#include "pocketfft_sp.h"
+
+void twstore_enable_f(void (*lock)(void), void (*unlock)(void))
+  { twstore_enable(lock, unlock); }
+
+cfft_plan_f make_cfft_plan_f (size_t length)
+  { return (cfft_plan_f)make_cfft_plan(length); }
+
+void destroy_cfft_plan_f (cfft_plan_f plan)
+  { destroy_cfft_plan((cfft_plan)plan); }
+
+int cfft_forward_f(cfft_plan_f plan, float c[], float fct)
+  { return cfft_forward((cfft_plan)plan, c, fct); }
+
+int cfft_backward_f(cfft_plan_f plan, float c[], float fct)
+  { return cfft_backward((cfft_plan)plan, c, fct); }
+
+rfft_plan_f make_rfft_plan_f (size_t length)
+  { return (rfft_plan_f)make_rfft_plan(length); }
+
+void destroy_rfft_plan_f (rfft_plan_f plan)
+  { destroy_rfft_plan((rfft_plan)plan); }
+
+int rfft_forward_f(rfft_plan_f plan, float c[], float fct)
+  { return rfft_forward((rfft_plan)plan, c, fct); }
+
+int rfft_backward_f(rfft_plan_f plan, float c[], float fct)
+  { return rfft_backward((rfft_plan)plan, c, fct); }
@@ -0,0 +1,36 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ * Entry points of the single-precision instantiation of the transform
+ * machinery (pocketfft_sp.c).  The plan types are opaque; the plans
+ * behind them are unrelated to the double-precision ones and must only
+ * be passed to the _f functions.
+ */
+
+#ifndef POCKETFFT_SP_H
+#define POCKETFFT_SP_H
+
+#include <stddef.h>
+
+/* enables the shared twiddle-table store of this instantiation */
+void twstore_enable_f(void (*lock)(void), void (*unlock)(void));
+
+struct cfft_plan_fi;
+typedef struct cfft_plan_fi * cfft_plan_f;
+struct rfft_plan_fi;
+typedef struct rfft_plan_fi * rfft_plan_f;
+
+cfft_plan_f make_cfft_plan_f (size_t length);
+void destroy_cfft_plan_f (cfft_plan_f plan);
+int cfft_forward_f(cfft_plan_f plan, float c[], float fct);
+int cfft_backward_f(cfft_plan_f plan, float c[], float fct);
+
+rfft_plan_f make_rfft_plan_f (size_t length);
+void destroy_rfft_plan_f (rfft_plan_f plan);
+int rfft_forward_f(rfft_plan_f plan, float c[], float fct);
+int rfft_backward_f(rfft_plan_f plan, float c[], float fct);
+
+#endif
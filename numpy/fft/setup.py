@@ -9,7 +9,7 @@ def configuration(parent_package='',top_path=None):
 
     # Configure pocketfft_internal
     config.add_extension('pocketfft_internal',
-                         sources=['pocketfft.c']
+                         sources=['pocketfft.c', 'pocketfft_sp.c']
                          )
 
     return config
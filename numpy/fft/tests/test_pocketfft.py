@@ -45,6 +45,17 @@ class TestFFT1D(object):
         assert_array_almost_equal(fft1(x) / np.sqrt(30),
                                   np.fft.fft(x, norm="ortho"))
 
+    def test_large_prime(self):
+        # large prime lengths go through the Bluestein engine
+        x = random(211) + 1j*random(211)
+        assert_array_almost_equal(fft1(x), np.fft.fft(x))
+        x = random(9973) + 1j*random(9973)
+        assert_array_almost_equal(np.fft.ifft(np.fft.fft(x)), x,
+                                  decimal=12)
+        xr = random(9973)
+        assert_array_almost_equal(np.fft.irfft(np.fft.rfft(xr), 9973),
+                                  xr, decimal=12)
+
     def test_ifft(self):
         x = random(30) + 1j*random(30)
         assert_array_almost_equal(x, np.fft.ifft(np.fft.fft(x)))
@@ -81,6 +92,24 @@ class TestFFT1D(object):
         assert_array_almost_equal(np.fft.ifftn(x) * np.sqrt(30 * 20 * 10),
                                   np.fft.ifftn(x, norm="ortho"))
 
+    def test_fft2_shapes(self):
+        # the native 2-D engine: shape changes via s, degenerate axes
+        # and float32 must all agree with the axis-by-axis path
+        x = random((30, 20)) + 1j*random((30, 20))
+        for s in [(15, 20), (30, 25), (40, 12)]:
+            assert_array_almost_equal(
+                np.fft.fft(np.fft.fft(x, n=s[1], axis=1), n=s[0], axis=0),
+                np.fft.fft2(x, s=s))
+        x1 = random((1, 20)) + 1j*random((1, 20))
+        assert_array_almost_equal(
+            np.fft.ifft(np.fft.ifft(x1, axis=1), axis=0),
+            np.fft.ifft2(x1))
+        xf = (random((30, 20)) + 1j*random((30, 20))).astype(np.complex64)
+        assert np.fft.fft2(xf).dtype == np.complex64
+        assert_array_almost_equal(np.fft.fft2(xf),
+                                  np.fft.fft2(xf.astype(np.complex128)),
+                                  decimal=4)
+
     def test_rfft(self):
         x = random(30)
         for n in [x.size, 2*x.size]:
@@ -170,12 +199,27 @@ class TestFFT1D(object):
     @pytest.mark.parametrize("dtype", [np.half, np.single, np.double,
                                        np.longdouble])
     def test_dtypes(self, dtype):
-        # make sure that all input precisions are accepted and internally
-        # converted to 64bit
+        # make sure that all input precisions are accepted; float32 runs
+        # in single precision, everything else is converted to 64bit
         x = random(30).astype(dtype)
         assert_array_almost_equal(np.fft.ifft(np.fft.fft(x)), x)
         assert_array_almost_equal(np.fft.irfft(np.fft.rfft(x)), x)
 
+    def test_float32(self):
+        # float32 input selects the single-precision transform path and
+        # keeps the dtype through the round trip
+        x = random(30).astype(np.float32)
+        assert np.fft.fft(x).dtype == np.complex64
+        assert np.fft.rfft(x).dtype == np.complex64
+        assert np.fft.irfft(np.fft.rfft(x)).dtype == np.float32
+        assert np.fft.ifft(np.fft.fft(x)).dtype == np.complex64
+        assert_array_almost_equal(np.fft.irfft(np.fft.rfft(x)), x,
+                                  decimal=5)
+        # agrees with the double-precision path to float32 accuracy
+        assert_array_almost_equal(np.fft.fft(x),
+                                  np.fft.fft(x.astype(np.float64)),
+                                  decimal=4)
+
 
 @pytest.mark.parametrize(
         "dtype",
@@ -214,6 +258,89 @@ def test_fft_with_order(dtype, order, fft):
         raise ValueError
 
 
+class TestPlanHandle(object):
+    # explicit plan handles of the internal module
+    def test_execute_with_plan(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((8, 64)) + 1j*random((8, 64))
+        plan = pfi.plan(64)
+        assert_array_equal(pfi.execute(x, 0, 1, 1.0, plan),
+                           np.fft.fft(x))
+        # a plan is reusable
+        assert_array_equal(pfi.execute(x, 0, 1, 1.0, plan),
+                           np.fft.fft(x))
+
+        xr = random((8, 64))
+        rplan = pfi.plan(64, True)
+        assert_array_equal(pfi.execute(xr, 1, 1, 1.0, rplan),
+                           np.fft.rfft(xr))
+
+    def test_plan_mismatch(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((2, 32)) + 1j*random((2, 32))
+        # wrong length and wrong kind are rejected
+        assert_raises(ValueError, pfi.execute, x, 0, 1, 1.0, pfi.plan(16))
+        assert_raises(ValueError, pfi.execute, x, 0, 1, 1.0,
+                      pfi.plan(32, True))
+        assert_raises(ValueError, pfi.plan, 0)
+
+
+class TestExecuteOut(object):
+    # out= and in-place execution of the internal module
+    def test_out(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((4, 32)) + 1j*random((4, 32))
+        out = np.empty((4, 32), np.complex128)
+        r = pfi.execute(x, 0, 1, 1.0, None, out)
+        assert r is out
+        assert_array_equal(out, np.fft.fft(x))
+
+        xr = random((4, 32))
+        outr = np.empty((4, 17), np.complex128)
+        r = pfi.execute(xr, 1, 1, 1.0, None, outr)
+        assert r is outr
+        assert_array_equal(outr, np.fft.rfft(xr))
+
+    def test_inplace(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((4, 32)) + 1j*random((4, 32))
+        y = x.copy()
+        r = pfi.execute(y, 0, 1, 1.0, None, y)
+        assert r is y
+        assert_array_equal(y, np.fft.fft(x))
+
+    def test_out_errors(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((4, 32)) + 1j*random((4, 32))
+        # wrong shape, dtype, layout and type are all rejected
+        assert_raises(ValueError, pfi.execute, x, 0, 1, 1.0, None,
+                      np.empty((4, 16), np.complex128))
+        assert_raises(ValueError, pfi.execute, x, 0, 1, 1.0, None,
+                      np.empty((4, 32), np.float64))
+        assert_raises(ValueError, pfi.execute, x, 0, 1, 1.0, None,
+                      np.empty((4, 64), np.complex128)[:, ::2])
+        assert_raises(TypeError, pfi.execute, x, 0, 1, 1.0, None, [])
+
+
+class TestRealSpectrum(object):
+    # fused rfft + power/magnitude of the internal module
+    def test_power(self):
+        from numpy.fft import pocketfft_internal as pfi
+        for n in (8, 9, 30):
+            x = random((4, n))
+            assert_array_almost_equal(pfi.real_spectrum(x, 1.0),
+                                      np.abs(np.fft.rfft(x))**2)
+            assert_array_almost_equal(pfi.real_spectrum(x, 1.0, True),
+                                      np.abs(np.fft.rfft(x)))
+
+    def test_float32(self):
+        from numpy.fft import pocketfft_internal as pfi
+        x = random((4, 30)).astype(np.float32)
+        p = pfi.real_spectrum(x, 1.0)
+        assert p.dtype == np.float32
+        assert_array_almost_equal(p, np.abs(np.fft.rfft(x))**2, decimal=4)
+
+
 class TestFFTThreadSafe(object):
     threads = 16
     input_shape = (800, 200)
@@ -6,6 +6,7 @@ of an n-dimensional array.
 from __future__ import division, absolute_import, print_function
 
 import numpy as np
+from numpy.core.multiarray import _pad_engine
 from numpy.core.overrides import array_function_dispatch
 from numpy.lib.index_tricks import ndindex
 
@@ -838,6 +839,28 @@ def pad(array, pad_width, mode='constant', **kwargs):
     stat_functions = {"maximum": np.max, "minimum": np.min,
                       "mean": np.mean, "median": np.median}
 
+    # The C pad engine allocates the destination once and fills the
+    # borders in place; it covers the plain cases of the three most
+    # common modes and the Python machinery below handles the rest.
+    if (type(array) is np.ndarray and array.ndim > 0 and
+            array.flags.carray and not array.dtype.hasobject):
+        widths = tuple(w for pair in pad_width for w in pair)
+        if mode == "constant":
+            values = kwargs.get("constant_values", 0)
+            if np.isscalar(values):
+                return _pad_engine(array, widths, mode, values)
+        elif mode == "edge" and array.size > 0:
+            return _pad_engine(array, widths, mode)
+        elif mode == "reflect" and array.size > 0:
+            # single reflection of an even type only; longer pads and
+            # singleton axes keep the iterative path below
+            if (kwargs.get("reflect_type", "even") == "even" and
+                    all((size > 1 and left < size and right < size) or
+                        (left == 0 and right == 0)
+                        for size, (left, right)
+                        in zip(array.shape, pad_width))):
+                return _pad_engine(array, widths, mode)
+
     # Create array with final shape and original values
     # (padded area is undefined)
     padded, original_area_slice = _pad_simple(array, pad_width)
@@ -31,6 +31,7 @@ import functools
 
 import numpy as np
 from numpy.core import overrides
+from numpy.core.multiarray import _unique_hash, _in1d_hash
 
 
 array_function_dispatch = functools.partial(
@@ -301,6 +302,25 @@ def _unique1d(ar, return_index=False, return_inverse=False,
     """
     ar = np.asanyarray(ar).flatten()
 
+    # Integer and byte-string arrays can be deduplicated in O(n) by the
+    # hash-set engine, leaving only the distinct values to sort. Floats
+    # are excluded (nan and signed-zero bit patterns do not hash like
+    # they compare), as is return_index, which needs the sorting
+    # permutation anyway. Booleans are excluded since the engine hashes
+    # raw bytes and nonzero bytes other than 1 all compare equal to True.
+    if (not return_index and type(ar) is np.ndarray and
+            ar.dtype.kind in 'iuS'):
+        uniq, inv, cnt = _unique_hash(ar, return_inverse, return_counts)
+        perm = uniq.argsort()
+        ret = (uniq[perm],)
+        if return_inverse:
+            rank = np.empty(uniq.shape, dtype=np.intp)
+            rank[perm] = np.arange(uniq.size, dtype=np.intp)
+            ret += (rank[inv],)
+        if return_counts:
+            ret += (cnt[perm],)
+        return ret
+
     optional_indices = return_index or return_inverse
 
     if optional_indices:
@@ -552,6 +572,38 @@ def in1d(ar1, ar2, assume_unique=False, invert=False):
     # Check if one of the arrays may contain arbitrary objects
     contains_object = ar1.dtype.hasobject or ar2.dtype.hasobject
 
+    # Integer arrays whose key range is comparable to the problem size
+    # can use a dense boolean lookup table: one pass over each array and
+    # no sort. 64-bit unsigned values may not fit the int64 offsets used
+    # below and are left to the hash path.
+    integer_arrays = (ar1.dtype.kind in 'iu' and ar2.dtype.kind in 'iu' and
+                      not (ar1.dtype.kind == 'u' and ar1.itemsize == 8) and
+                      not (ar2.dtype.kind == 'u' and ar2.itemsize == 8))
+    if integer_arrays and ar1.size > 0 and ar2.size > 0:
+        ar2_min = int(ar2.min())
+        ar2_max = int(ar2.max())
+        ar2_range = ar2_max - ar2_min
+        if ar2_range <= 6 * (ar1.size + ar2.size):
+            if invert:
+                mask = np.ones(ar1.shape, dtype=bool)
+                table = np.ones(ar2_range + 1, dtype=bool)
+                table[ar2.astype(np.int64) - ar2_min] = False
+            else:
+                mask = np.zeros(ar1.shape, dtype=bool)
+                table = np.zeros(ar2_range + 1, dtype=bool)
+                table[ar2.astype(np.int64) - ar2_min] = True
+            in_range = (ar1 >= ar2_min) & (ar1 <= ar2_max)
+            mask[in_range] = table[ar1[in_range].astype(np.int64) - ar2_min]
+            return mask
+
+    # Integer and byte-string arrays with a common dtype go through the
+    # hash membership kernel: build a table over ar2, stream ar1 past it.
+    if ar1.dtype.kind in 'iuS' and ar2.dtype.kind in 'iuS':
+        common = np.promote_types(ar1.dtype, ar2.dtype)
+        if common.kind in 'iuS':
+            return _in1d_hash(ar1.astype(common, copy=False),
+                              ar2.astype(common, copy=False), invert)
+
     # This code is run when
     # a) the first condition is true, making the code significantly faster
     # b) the second condition is true (i.e. `ar1` or `ar2` may contain
@@ -389,6 +389,18 @@ def _wrap_header_guess_version(header):
     return header
 
 
+def _header_text(d):
+    """
+    Serialize a header dict to the string representation stored on disk.
+    """
+    header = ["{"]
+    for key, value in sorted(d.items()):
+        # Need to use repr here, since we eval these when reading
+        header.append("'%s': %s, " % (key, repr(value)))
+    header.append("}")
+    return _filter_header("".join(header))
+
+
 def _write_array_header(fp, d, version=None):
     """ Write the header for an array and returns the version used
 
@@ -403,13 +415,7 @@ def _write_array_header(fp, d, version=None):
         explicit version will raise a ValueError if the format does not
         allow saving this data.  Default: None
     """
-    header = ["{"]
-    for key, value in sorted(d.items()):
-        # Need to use repr here, since we eval these when reading
-        header.append("'%s': %s, " % (key, repr(value)))
-    header.append("}")
-    header = "".join(header)
-    header = _filter_header(header)
+    header = _header_text(d)
     if version is None:
         header = _wrap_header_guess_version(header)
     else:
@@ -771,6 +777,463 @@ def read_array(fp, allow_pickle=False, pickle_kwargs=None):
     return array
 
 
+CHUNKED_MAGIC_PREFIX = b'\x93NUMPYC'
+CHUNKED_VERSION = (1, 0)
+# default uncompressed bytes per chunk of the chunked format
+CHUNK_SIZE = 2**22
+
+
+def _chunked_thread_count(num_threads):
+    if num_threads is None:
+        import os
+        num_threads = os.cpu_count() or 1
+    return max(int(num_threads), 1)
+
+
+def _raw_byte_view(array):
+    """
+    Return a flat uint8 view of the array data and the fortran_order
+    flag, copying (to C order) only when the array is not contiguous.
+    """
+    if array.itemsize == 0:
+        # zero-width dtypes have no data to expose bytewise
+        return numpy.empty(0, dtype=numpy.uint8), False
+    if array.flags.f_contiguous and not array.flags.c_contiguous:
+        return array.T.reshape(-1).view(numpy.uint8), True
+    array = numpy.ascontiguousarray(array)
+    return array.reshape(-1).view(numpy.uint8), False
+
+
+def write_array_chunked(fp, array, chunk_size=None, compresslevel=1,
+                        num_threads=None):
+    """
+    Write an array to a seekable file in the chunked compressed format.
+
+    The data is split into fixed-size chunks which are compressed
+    independently (with zlib, which releases the GIL) on a thread pool,
+    so both writing and reading scale with the number of cores.  The
+    chunk index is stored in the file so readers can locate and
+    decompress chunks in parallel.
+
+    .. versionadded:: 1.17.0
+
+    Parameters
+    ----------
+    fp : file_like object
+        An open, writable and seekable file object.
+    array : ndarray
+        The array to write to disk.
+    chunk_size : int, optional
+        Uncompressed bytes per chunk.  Default: 4 MiB.
+    compresslevel : int, optional
+        zlib compression level, 0 through 9.  Default: 1
+    num_threads : int, optional
+        Number of compression threads.  Default: the number of CPUs.
+
+    Raises
+    ------
+    ValueError
+        If the array is an object array, which cannot be stored in this
+        format.
+
+    """
+    import struct
+    import zlib
+    from collections import deque
+    from concurrent.futures import ThreadPoolExecutor
+
+    if array.dtype.hasobject:
+        raise ValueError("Object arrays cannot be saved in the chunked "
+                         "format")
+    if chunk_size is None:
+        chunk_size = CHUNK_SIZE
+    chunk_size = int(chunk_size)
+    if chunk_size < 1:
+        raise ValueError("chunk_size must be at least 1 byte")
+
+    data, fortran_order = _raw_byte_view(array)
+    nbytes = data.shape[0]
+    nchunks = int((nbytes + chunk_size - 1) // chunk_size)
+
+    d = dict(
+        descr=dtype_to_descr(array.dtype),
+        fortran_order=fortran_order,
+        shape=array.shape,
+        chunk_size=chunk_size,
+        compression='zlib',
+        nchunks=nchunks,
+    )
+    header = ["{"]
+    for key, value in sorted(d.items()):
+        # Need to use repr here, since we eval these when reading
+        header.append("'%s': %s, " % (key, repr(value)))
+    header.append("}")
+    header = _filter_header("".join(header)).encode('latin1')
+    fp.write(CHUNKED_MAGIC_PREFIX + magic(*CHUNKED_VERSION)[-2:])
+    fp.write(struct.pack('<I', len(header)))
+    fp.write(header)
+
+    # the chunk index is filled in once the compressed sizes are known
+    index_offset = fp.tell()
+    fp.write(b'\0' * (8 * nchunks))
+
+    def compress_chunk(i):
+        start = i * chunk_size
+        stop = min(start + chunk_size, nbytes)
+        return zlib.compress(data[start:stop], compresslevel)
+
+    sizes = [0] * nchunks
+    num_threads = _chunked_thread_count(num_threads)
+    with ThreadPoolExecutor(max_workers=num_threads) as pool:
+        # keep a bounded window of chunks in flight, so peak memory is
+        # proportional to the thread count and not to the array size
+        pending = deque()
+        for i in range(nchunks):
+            pending.append((i, pool.submit(compress_chunk, i)))
+            if len(pending) >= 4 * num_threads:
+                j, future = pending.popleft()
+                payload = future.result()
+                sizes[j] = len(payload)
+                fp.write(payload)
+        while pending:
+            j, future = pending.popleft()
+            payload = future.result()
+            sizes[j] = len(payload)
+            fp.write(payload)
+
+    end_offset = fp.tell()
+    fp.seek(index_offset)
+    fp.write(struct.pack('<%dQ' % nchunks, *sizes))
+    fp.seek(end_offset)
+
+
+def read_array_chunked(fp, num_threads=None):
+    """
+    Read an array written by `write_array_chunked`.
+
+    The compressed chunks are read sequentially and decompressed on a
+    thread pool directly into a preallocated array.
+
+    .. versionadded:: 1.17.0
+
+    Parameters
+    ----------
+    fp : file_like object
+        An open readable file object.
+    num_threads : int, optional
+        Number of decompression threads.  Default: the number of CPUs.
+
+    Returns
+    -------
+    array : ndarray
+        The array from the data on disk.
+
+    Raises
+    ------
+    ValueError
+        If the data is invalid.
+
+    """
+    import struct
+    import zlib
+    from collections import deque
+    from concurrent.futures import ThreadPoolExecutor
+
+    magic_str = _read_bytes(fp, len(CHUNKED_MAGIC_PREFIX) + 2, "magic string")
+    if magic_str[:-2] != CHUNKED_MAGIC_PREFIX:
+        msg = "the magic string is not correct; expected %r, got %r"
+        raise ValueError(msg % (CHUNKED_MAGIC_PREFIX, magic_str[:-2]))
+    if sys.version_info[0] < 3:
+        version = tuple(map(ord, magic_str[-2:]))
+    else:
+        version = tuple(magic_str[-2:])
+    if version != CHUNKED_VERSION:
+        raise ValueError("unsupported chunked format version %s" %
+                         (version,))
+
+    hlen = struct.unpack('<I', _read_bytes(fp, 4, "header length"))[0]
+    header = _read_bytes(fp, hlen, "array header").decode('latin1')
+    try:
+        d = safe_eval(header)
+    except SyntaxError as e:
+        msg = "Cannot parse header: %r\nException: %r"
+        raise ValueError(msg % (header, e))
+    expected_keys = set(['descr', 'fortran_order', 'shape', 'chunk_size',
+                         'compression', 'nchunks'])
+    if not isinstance(d, dict) or set(d.keys()) != expected_keys:
+        raise ValueError("Header does not contain the correct keys: %r" %
+                         (header,))
+    shape = d['shape']
+    if not isinstance(shape, tuple) or not all(isinstance(x, (int, long))
+                                               for x in shape):
+        raise ValueError("shape is not valid: %r" % (shape,))
+    if not isinstance(d['fortran_order'], bool):
+        raise ValueError("fortran_order is not a valid bool: %r" %
+                         (d['fortran_order'],))
+    if d['compression'] != 'zlib':
+        raise ValueError("unsupported compression: %r" %
+                         (d['compression'],))
+    try:
+        dtype = descr_to_dtype(d['descr'])
+    except TypeError:
+        raise ValueError("descr is not a valid dtype descriptor: %r" %
+                         (d['descr'],))
+    chunk_size = int(d['chunk_size'])
+    nchunks = int(d['nchunks'])
+
+    if len(shape) == 0:
+        count = 1
+    else:
+        count = numpy.multiply.reduce(shape, dtype=numpy.int64)
+    nbytes = int(count * dtype.itemsize)
+    if chunk_size < 1 or nchunks != (nbytes + chunk_size - 1) // chunk_size:
+        raise ValueError("chunk accounting does not match the shape: %r" %
+                         (header,))
+    index = struct.unpack('<%dQ' % nchunks,
+                          _read_bytes(fp, 8 * nchunks, "chunk index"))
+
+    # Use np.ndarray instead of np.empty since the latter does
+    # not correctly instantiate zero-width string dtypes; see
+    # https://github.com/numpy/numpy/pull/6430
+    array = numpy.ndarray(count, dtype=dtype)
+    if nbytes > 0:
+        out = array.view(numpy.uint8)
+
+        def store_chunk(i, payload):
+            block = zlib.decompress(payload)
+            start = i * chunk_size
+            stop = min(start + chunk_size, nbytes)
+            if len(block) != stop - start:
+                raise ValueError(
+                        "chunk %d decompressed to %d bytes, expected %d" %
+                        (i, len(block), stop - start))
+            out[start:stop] = numpy.frombuffer(block, dtype=numpy.uint8)
+
+        num_threads = _chunked_thread_count(num_threads)
+        with ThreadPoolExecutor(max_workers=num_threads) as pool:
+            # the file is read sequentially here; only the decompression
+            # runs on the pool, in a bounded window like the writer
+            pending = deque()
+            for i in range(nchunks):
+                payload = _read_bytes(fp, index[i], "chunk data")
+                pending.append(pool.submit(store_chunk, i, payload))
+                if len(pending) >= 4 * num_threads:
+                    pending.popleft().result()
+            while pending:
+                pending.popleft().result()
+
+    if d['fortran_order']:
+        array.shape = shape[::-1]
+        array = array.transpose()
+    else:
+        array.shape = shape
+
+    return array
+
+
+class NpyAppendWriter(object):
+    """
+    Append-only writer for a ``.npy`` file that grows along its first axis.
+
+    The header is written with enough padding reserved in the shape field
+    for any row count, so appending a batch writes only the new data and
+    closing the writer patches the first dimension of the shape in place
+    with a single write.  After every `flush` or `close` the file is an
+    ordinary ``.npy`` file that `read_array`, `numpy.load` or
+    `open_memmap` can read.
+
+    Rows are stored in C order; Fortran-ordered files and object dtypes
+    are not supported.  If a previous writer died between appending and
+    patching the header, reopening the file adopts the complete rows
+    actually present.
+
+    Parameters
+    ----------
+    filename : str or path-like
+        Name of the file.  If it already exists and is non-empty, it must
+        be an uncompressed ``.npy`` file with a matching dtype and row
+        shape, and new rows are appended after those already present.
+    dtype : data-type, optional
+        The dtype of the stored rows.  Required when creating a new file.
+    shape : tuple of int, optional
+        The shape of a single row, i.e. the shape of the file without its
+        first dimension.  ``()`` stores a 1-d file of scalars.  Required
+        when creating a new file.
+
+    Examples
+    --------
+    >>> with NpyAppendWriter('log.npy', '<f8', (4,)) as w:  # doctest: +SKIP
+    ...     w.append(np.zeros((100, 4)))
+    ...     w.append(np.ones((50, 4)))
+    """
+
+    def __init__(self, filename, dtype=None, shape=None):
+        filename = os_fspath(filename)
+        self._fp = None
+        try:
+            fp = open(filename, 'r+b')
+        except IOError:
+            fp = open(filename, 'w+b')
+        try:
+            fp.seek(0, 2)
+            if fp.tell() > 0:
+                fp.seek(0, 0)
+                self._resume(fp, dtype, shape)
+            else:
+                self._create(fp, dtype, shape)
+        except Exception:
+            fp.close()
+            raise
+        self._fp = fp
+
+    def _create(self, fp, dtype, shape):
+        if dtype is None or shape is None:
+            raise ValueError(
+                "dtype and shape are required to create a new file")
+        dtype = numpy.dtype(dtype)
+        if dtype.hasobject:
+            raise ValueError("object arrays cannot be appended to")
+        if dtype.itemsize == 0:
+            raise ValueError("itemsize cannot be zero in dtype")
+        self._dtype = dtype
+        self._row_shape = tuple(int(d) for d in shape)
+        if any(d < 0 for d in self._row_shape):
+            raise ValueError("negative dimensions are not allowed")
+        self._nrows = 0
+        # pick the oldest version whose header has room for any row count
+        biggest = _header_text(self._header_dict(2**63 - 1))
+        for version in [(1, 0), (2, 0), (3, 0)]:
+            try:
+                block = _wrap_header(biggest, version)
+            except (ValueError, UnicodeEncodeError):
+                continue
+            break
+        else:
+            raise ValueError("header too large for any format version")
+        self._version = version
+        self._header_size = len(block)
+        self._fp = fp
+        self._patch_header()
+
+    def _resume(self, fp, dtype, shape):
+        version = read_magic(fp)
+        _check_version(version)
+        file_shape, fortran_order, file_dtype = _read_array_header(fp, version)
+        if fortran_order:
+            raise ValueError("cannot append to a Fortran-ordered file")
+        if file_dtype.hasobject:
+            raise ValueError("object arrays cannot be appended to")
+        if len(file_shape) == 0:
+            raise ValueError("cannot append to a 0-d file")
+        if dtype is not None and numpy.dtype(dtype) != file_dtype:
+            raise ValueError(
+                    "dtype %r does not match the file's %r"
+                    % (numpy.dtype(dtype), file_dtype))
+        if (shape is not None and
+                tuple(int(d) for d in shape) != tuple(file_shape[1:])):
+            raise ValueError(
+                    "row shape %s does not match the file's %s"
+                    % (tuple(shape), tuple(file_shape[1:])))
+        self._dtype = file_dtype
+        self._row_shape = tuple(int(d) for d in file_shape[1:])
+        self._version = version
+        self._header_size = fp.tell()
+        rowsize = file_dtype.itemsize * int(numpy.multiply.reduce(
+                self._row_shape, dtype=numpy.int64))
+        fp.seek(0, 2)
+        databytes = fp.tell() - self._header_size
+        if rowsize == 0:
+            self._nrows = int(file_shape[0])
+        else:
+            if databytes % rowsize != 0:
+                raise ValueError("file ends in a partial row")
+            self._nrows = databytes // rowsize
+            if self._nrows < file_shape[0]:
+                raise ValueError(
+                        "file is missing %d of the %d rows its header "
+                        "records" % (file_shape[0] - self._nrows,
+                                     file_shape[0]))
+        self._fp = fp
+        # fail now, not at close, if the header has no room to grow
+        self._patch_header()
+
+    def _header_dict(self, nrows):
+        return {'descr': dtype_to_descr(self._dtype),
+                'fortran_order': False,
+                'shape': (nrows,) + self._row_shape}
+
+    def _patch_header(self):
+        import struct
+        fmt, encoding = _header_size_info[self._version]
+        text = _header_text(self._header_dict(self._nrows)).encode(encoding)
+        hlen = self._header_size - MAGIC_LEN - struct.calcsize(fmt)
+        if len(text) + 1 > hlen:
+            raise ValueError(
+                    "no room left in the header to record %d rows"
+                    % self._nrows)
+        block = (magic(*self._version) + struct.pack(fmt, hlen) +
+                 text + b' ' * (hlen - len(text) - 1) + b'\n')
+        # one write, so a concurrent reader never sees a partial header
+        self._fp.seek(0, 0)
+        self._fp.write(block)
+        self._fp.seek(0, 2)
+
+    @property
+    def shape(self):
+        """ Shape the file will have after the header is patched. """
+        return (self._nrows,) + self._row_shape
+
+    @property
+    def dtype(self):
+        return self._dtype
+
+    def append(self, array):
+        """
+        Append rows along the first axis.
+
+        `array` must either match the row shape (a single row) or have
+        the row shape as its trailing dimensions (a batch of rows).  The
+        data is written immediately; the header records the new rows at
+        the next `flush` or `close`.
+        """
+        if self._fp is None:
+            raise ValueError("operation on closed writer")
+        array = numpy.asarray(array, dtype=self._dtype)
+        if array.shape == self._row_shape:
+            array = array[numpy.newaxis, ...]
+        if array.shape[1:] != self._row_shape:
+            raise ValueError(
+                    "array of shape %s cannot be appended as rows of "
+                    "shape %s" % (array.shape, self._row_shape))
+        array = numpy.ascontiguousarray(array)
+        self._fp.seek(0, 2)
+        array.tofile(self._fp)
+        self._nrows += array.shape[0]
+
+    def flush(self):
+        """ Patch the header and flush, making all rows visible. """
+        if self._fp is None:
+            raise ValueError("operation on closed writer")
+        self._patch_header()
+        self._fp.flush()
+
+    def close(self):
+        if self._fp is not None:
+            fp = self._fp
+            try:
+                self._patch_header()
+                fp.flush()
+            finally:
+                self._fp = None
+                fp.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+
 def open_memmap(filename, mode='r+', dtype=None, shape=None,
                 fortran_order=False, version=None):
     """
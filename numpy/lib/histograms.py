@@ -10,6 +10,7 @@ import warnings
 import numpy as np
 from numpy.compat.py3k import basestring
 from numpy.core import overrides
+from numpy.core.multiarray import _histogram_uniform
 
 __all__ = ['histogram', 'histogramdd', 'histogram_bin_edges']
 
@@ -806,60 +807,69 @@ def histogram(a, bins=10, range=None, normed=None, weights=None,
         # equal bin widths (which is valid here).
         first_edge, last_edge, n_equal_bins = uniform_bins
 
-        # Initialize empty histogram
-        n = np.zeros(n_equal_bins, ntype)
-
-        # Pre-compute histogram scaling factor
-        norm = n_equal_bins / _unsigned_subtract(last_edge, first_edge)
+        if (weights is None and a.dtype == bin_edges.dtype and
+                a.dtype.type in (np.single, np.double)):
+            # Native counting loop: a single pass over the data with
+            # per-thread private bins for large inputs. Out-of-range
+            # values are dropped there, and values within rounding error
+            # of an edge are resolved against bin_edges exactly as the
+            # block loop below does.
+            n = _histogram_uniform(a, bin_edges, first_edge, last_edge)
+        else:
+            # Initialize empty histogram
+            n = np.zeros(n_equal_bins, ntype)
 
-        # We iterate over blocks here for two reasons: the first is that for
-        # large arrays, it is actually faster (for example for a 10^8 array it
-        # is 2x as fast) and it results in a memory footprint 3x lower in the
-        # limit of large arrays.
-        for i in _range(0, len(a), BLOCK):
-            tmp_a = a[i:i+BLOCK]
-            if weights is None:
-                tmp_w = None
-            else:
-                tmp_w = weights[i:i + BLOCK]
+            # Pre-compute histogram scaling factor
+            norm = n_equal_bins / _unsigned_subtract(last_edge, first_edge)
 
-            # Only include values in the right range
-            keep = (tmp_a >= first_edge)
-            keep &= (tmp_a <= last_edge)
-            if not np.logical_and.reduce(keep):
-                tmp_a = tmp_a[keep]
-                if tmp_w is not None:
-                    tmp_w = tmp_w[keep]
-
-            # This cast ensures no type promotions occur below, which gh-10322
-            # make unpredictable. Getting it wrong leads to precision errors
-            # like gh-8123.
-            tmp_a = tmp_a.astype(bin_edges.dtype, copy=False)
-
-            # Compute the bin indices, and for values that lie exactly on
-            # last_edge we need to subtract one
-            f_indices = _unsigned_subtract(tmp_a, first_edge) * norm
-            indices = f_indices.astype(np.intp)
-            indices[indices == n_equal_bins] -= 1
-
-            # The index computation is not guaranteed to give exactly
-            # consistent results within ~1 ULP of the bin edges.
-            decrement = tmp_a < bin_edges[indices]
-            indices[decrement] -= 1
-            # The last bin includes the right edge. The other bins do not.
-            increment = ((tmp_a >= bin_edges[indices + 1])
-                         & (indices != n_equal_bins - 1))
-            indices[increment] += 1
-
-            # We now compute the histogram using bincount
-            if ntype.kind == 'c':
-                n.real += np.bincount(indices, weights=tmp_w.real,
-                                      minlength=n_equal_bins)
-                n.imag += np.bincount(indices, weights=tmp_w.imag,
-                                      minlength=n_equal_bins)
-            else:
-                n += np.bincount(indices, weights=tmp_w,
-                                 minlength=n_equal_bins).astype(ntype)
+            # We iterate over blocks here for two reasons: the first is that
+            # for large arrays, it is actually faster (for example for a 10^8
+            # array it is 2x as fast) and it results in a memory footprint 3x
+            # lower in the limit of large arrays.
+            for i in _range(0, len(a), BLOCK):
+                tmp_a = a[i:i+BLOCK]
+                if weights is None:
+                    tmp_w = None
+                else:
+                    tmp_w = weights[i:i + BLOCK]
+
+                # Only include values in the right range
+                keep = (tmp_a >= first_edge)
+                keep &= (tmp_a <= last_edge)
+                if not np.logical_and.reduce(keep):
+                    tmp_a = tmp_a[keep]
+                    if tmp_w is not None:
+                        tmp_w = tmp_w[keep]
+
+                # This cast ensures no type promotions occur below, which
+                # gh-10322 make unpredictable. Getting it wrong leads to
+                # precision errors like gh-8123.
+                tmp_a = tmp_a.astype(bin_edges.dtype, copy=False)
+
+                # Compute the bin indices, and for values that lie exactly on
+                # last_edge we need to subtract one
+                f_indices = _unsigned_subtract(tmp_a, first_edge) * norm
+                indices = f_indices.astype(np.intp)
+                indices[indices == n_equal_bins] -= 1
+
+                # The index computation is not guaranteed to give exactly
+                # consistent results within ~1 ULP of the bin edges.
+                decrement = tmp_a < bin_edges[indices]
+                indices[decrement] -= 1
+                # The last bin includes the right edge. The other bins do not.
+                increment = ((tmp_a >= bin_edges[indices + 1])
+                             & (indices != n_equal_bins - 1))
+                indices[increment] += 1
+
+                # We now compute the histogram using bincount
+                if ntype.kind == 'c':
+                    n.real += np.bincount(indices, weights=tmp_w.real,
+                                          minlength=n_equal_bins)
+                    n.imag += np.bincount(indices, weights=tmp_w.imag,
+                                          minlength=n_equal_bins)
+                else:
+                    n += np.bincount(indices, weights=tmp_w,
+                                     minlength=n_equal_bins).astype(ntype)
     else:
         # Compute via cumulative histogram
         cum_n = np.zeros(bin_edges.shape, ntype)
@@ -8,11 +8,13 @@ from numpy.core.numeric import (
     asarray, zeros, outer, concatenate, array, asanyarray
     )
 from numpy.core.fromnumeric import product, reshape, transpose
-from numpy.core.multiarray import normalize_axis_index
+from numpy.core.multiarray import normalize_axis_index, _expand_dims_view
 from numpy.core import overrides
+from numpy.core import _multiarray_umath
 from numpy.core import vstack, atleast_3d
 from numpy.core.shape_base import _arrays_for_stack_dispatcher
 from numpy.lib.index_tricks import ndindex
+from numpy.lib.stride_tricks import broadcast_to
 from numpy.matrixlib.defmatrix import matrix  # this raises all the right alarm bells
 
 
@@ -51,6 +53,26 @@ def _make_along_axis_idx(arr_shape, indices, axis):
     return tuple(fancy_index)
 
 
+def _along_axis_indices(arr, indices, axis):
+    """
+    Return `indices` as an intp array if the native along-axis kernel
+    can handle the operands, else None to fall back to fancy indexing.
+    """
+    if type(arr) is not _nx.ndarray or type(indices) is not _nx.ndarray:
+        return None
+    if arr.dtype.hasobject:
+        return None
+    if not _nx.issubdtype(indices.dtype, _nx.integer):
+        raise IndexError('`indices` must be an integer array')
+    if arr.ndim != indices.ndim:
+        raise ValueError(
+            "`indices` and `arr` must have the same number of dimensions")
+    for dim, (n, m) in enumerate(zip(arr.shape, indices.shape)):
+        if dim != axis and m != n and m != 1:
+            return None
+    return indices.astype(_nx.intp, copy=False)
+
+
 def _take_along_axis_dispatcher(arr, indices, axis):
     return (arr, indices)
 
@@ -168,6 +190,11 @@ def take_along_axis(arr, indices, axis):
         axis = normalize_axis_index(axis, arr.ndim)
         arr_shape = arr.shape
 
+    # use the native gather kernel when the operands allow it
+    idx = _along_axis_indices(arr, indices, axis)
+    if idx is not None:
+        return _multiarray_umath._take_along_axis(arr, idx, axis)
+
     # use the fancy index
     return arr[_make_along_axis_idx(arr_shape, indices, axis)]
 
@@ -258,6 +285,14 @@ def put_along_axis(arr, indices, values, axis):
         axis = normalize_axis_index(axis, arr.ndim)
         arr_shape = arr.shape
 
+    # use the native scatter kernel when the operands allow it
+    idx = _along_axis_indices(arr, indices, axis)
+    if idx is not None:
+        shape = arr_shape[:axis] + (idx.shape[axis],) + arr_shape[axis+1:]
+        values = broadcast_to(asarray(values, dtype=arr.dtype), shape)
+        _multiarray_umath._put_along_axis(arr, idx, values, axis)
+        return
+
     # use the fancy index
     arr[_make_along_axis_idx(arr_shape, indices, axis)] = values
 
@@ -584,6 +619,12 @@ def expand_dims(a, axis):
         axis = axis + a.ndim + 1
     # and uncomment the following line.
     # axis = normalize_axis_index(axis, a.ndim + 1)
+    if type(a) is _nx.ndarray and 0 <= axis <= a.ndim:
+        # header-only view; subclasses and deprecated out-of-range
+        # axes keep the reshape below
+        view = _expand_dims_view(a, axis)
+        if view is not None:
+            return view
     return a.reshape(shape[:axis] + (1,) + shape[axis:])
 
 
@@ -8,9 +8,10 @@ NumPy reference guide.
 from __future__ import division, absolute_import, print_function
 
 import numpy as np
+from numpy.core.multiarray import _sliding_window_view
 from numpy.core.overrides import array_function_dispatch
 
-__all__ = ['broadcast_to', 'broadcast_arrays']
+__all__ = ['broadcast_to', 'broadcast_arrays', 'sliding_window_view']
 
 
 class DummyArray(object):
@@ -113,6 +114,80 @@ def as_strided(x, shape=None, strides=None, subok=False, writeable=True):
     return view
 
 
+def _sliding_window_view_dispatcher(x, window_shape, axis=None, subok=None,
+                                    writeable=None):
+    return (x,)
+
+
+@array_function_dispatch(_sliding_window_view_dispatcher)
+def sliding_window_view(x, window_shape, axis=None, subok=False,
+                        writeable=False):
+    """
+    Create a sliding window view into the array with the given window shape.
+
+    A window of length ``window_shape[i]`` slides over each axis named in
+    `axis` and the window axes are appended, in order, after the axes of
+    `x`.  The result is a zero-copy view: element
+    ``v[i, ..., k, ...]`` is ``x[i + k, ...]`` along each windowed axis.
+
+    Parameters
+    ----------
+    x : array_like
+        Array to create the sliding window view from.
+    window_shape : int or sequence of int
+        Size of window over each axis that takes part in the sliding
+        window.  If `axis` is not present, must match the number of
+        dimensions of `x`.
+    axis : int or sequence of int, optional
+        Axis or axes along which the sliding window is applied.  By
+        default the sliding window is applied to all axes, with
+        `window_shape` giving one window length per axis.  Axes may
+        repeat, in which case the windows apply successively.
+    subok : bool, optional
+        If True, subclasses are preserved.
+    writeable : bool, optional
+        If True the view is writeable; the default read-only view is
+        strongly recommended since the windows overlap in memory, so
+        writes hit several windows at once.
+
+    Returns
+    -------
+    view : ndarray
+        Sliding window view of the array, with shape
+        ``x.shape`` trimmed by ``window_shape - 1`` on the windowed axes
+        followed by ``window_shape``.  No data is copied.
+
+    See Also
+    --------
+    as_strided : Lower-level, unchecked stride manipulation.
+
+    Notes
+    -----
+    Unlike ``as_strided``, the geometry is computed and bounds-checked
+    in C, so the view can never reach outside the memory of `x`.
+
+    Examples
+    --------
+    >>> x = np.arange(6)
+    >>> v = np.sliding_window_view(x, 3)
+    >>> v
+    array([[0, 1, 2],
+           [1, 2, 3],
+           [2, 3, 4],
+           [3, 4, 5]])
+    >>> v.base is not None
+    True
+
+    A rolling mean is then a reduction over the window axis:
+
+    >>> v.mean(axis=-1)
+    array([1., 2., 3., 4.])
+    """
+    x = np.array(x, copy=False, subok=subok)
+    view = _sliding_window_view(x, window_shape, axis, writeable)
+    return _maybe_view_as_subclass(x, view)
+
+
 def _broadcast_to(array, shape, subok, readonly):
     shape = tuple(shape) if np.iterable(shape) else (shape,)
     array = np.array(array, copy=False, subok=subok)
@@ -523,6 +523,28 @@ class TestUnique(object):
         assert_equal(a3_idx.dtype, np.intp)
         assert_equal(a3_inv.dtype, np.intp)
 
+    def test_unique_hash_engine(self):
+        # integer and bytes dtypes take the hash-set path when the index
+        # is not requested; it must agree with the sort-based path
+        rnd = np.random.RandomState(1234)
+        a = rnd.randint(0, 50, 10000)
+        for dt in np.typecodes['AllInteger']:
+            aa = a.astype(dt)
+            v0, j0, c0 = unique(aa, False, True, True)
+            v1, i1, j1, c1 = unique(aa, True, True, True)
+            assert_array_equal(v0, v1)
+            assert_array_equal(j0, j1)
+            assert_array_equal(c0, c1)
+            assert_array_equal(v0[j0], aa)
+
+        aa = np.array([str(x % 17) for x in a], dtype='S5')
+        v0, j0, c0 = unique(aa, False, True, True)
+        v1, i1, j1, c1 = unique(aa, True, True, True)
+        assert_array_equal(v0, v1)
+        assert_array_equal(j0, j1)
+        assert_array_equal(c0, c1)
+        assert_array_equal(v0[j0], aa)
+
     def test_unique_axis_errors(self):
         assert_raises(TypeError, self._run_axis_tests, object)
         assert_raises(TypeError, self._run_axis_tests,
@@ -517,6 +517,51 @@ def test_memmap_roundtrip():
             del ma
 
 
+def test_load_npy_mmap():
+    # the C fast loader maps simple .npy files in a single call
+    load_mmap = getattr(np.core._multiarray_umath, '_load_npy_mmap', None)
+    if sys.platform == 'win32' or sys.platform == 'cygwin':
+        assert_raises(RuntimeError, load_mmap, 'unused.npy')
+        return
+
+    fn = os.path.join(tempdir, 'c_mmap.npy')
+    for arr in [np.arange(24.).reshape(4, 6),
+                np.asfortranarray(np.arange(24.).reshape(4, 6)),
+                np.arange(10, dtype='<i4'),
+                np.arange(6, dtype='>f8').reshape(2, 3),
+                (np.arange(8.) + 1j*np.arange(8.)).astype('c16'),
+                np.float64(5.),
+                np.zeros((0, 3))]:
+        np.save(fn, arr)
+        res = load_mmap(fn)
+        assert_array_equal(res, arr)
+        assert_equal(res.dtype, np.asarray(arr).dtype)
+        assert_(not res.flags.writeable)
+        del res
+
+    # r+ writes back to the file, c does not
+    np.save(fn, np.zeros(5))
+    res = load_mmap(fn, 'c')
+    res[0] = 7.
+    del res
+    assert_equal(np.load(fn)[0], 0.)
+    res = load_mmap(fn, 'r+')
+    res[0] = 7.
+    del res
+    assert_equal(np.load(fn)[0], 7.)
+
+    # object arrays and unsupported headers fall back with ValueError
+    np.save(fn, np.array([None, dict()], dtype=object))
+    assert_raises(ValueError, load_mmap, fn)
+    np.save(fn, np.zeros(3, dtype=[('a', '<f8'), ('b', '<i4')]))
+    assert_raises(ValueError, load_mmap, fn)
+    with open(fn, 'wb') as fp:
+        fp.write(b'not a npy file at all')
+    assert_raises(ValueError, load_mmap, fn)
+    assert_raises(IOError, load_mmap, fn + '.does-not-exist')
+    assert_raises(ValueError, load_mmap, fn, 'w+')
+
+
 def test_compressed_roundtrip():
     arr = np.random.rand(200, 200)
     npz_file = os.path.join(tempdir, 'compressed.npz')
@@ -525,6 +570,95 @@ def test_compressed_roundtrip():
     assert_array_equal(arr, arr1)
 
 
+def test_chunked_roundtrip():
+    path = os.path.join(tempdir, 'chunked.bin')
+    rng = np.random.RandomState(10)
+    arrays = [
+        np.array(3.5),
+        np.zeros((0, 5)),
+        rng.randint(0, 1000, size=(100, 37)).astype(np.int64),
+        np.asfortranarray(rng.rand(63, 29)),
+        rng.rand(300, 200),  # several chunks at the chunk_size below
+        np.array([(1, 2.5), (3, 4.5)], dtype=[('a', '<i4'), ('b', '<f8')]),
+        ]
+    for arr in arrays:
+        for kwargs in ({}, dict(chunk_size=4096, num_threads=4),
+                       dict(chunk_size=1000, compresslevel=6, num_threads=1)):
+            with open(path, 'wb') as f:
+                format.write_array_chunked(f, arr, **kwargs)
+            with open(path, 'rb') as f:
+                arr1 = format.read_array_chunked(f)
+                assert_(f.read() == b'')
+            assert_array_equal(arr, arr1)
+            assert_equal(arr.dtype, arr1.dtype)
+            if arr.ndim > 1 and arr.size > 0:
+                assert_equal(arr.flags.f_contiguous, arr1.flags.f_contiguous)
+
+    # object arrays cannot be stored
+    with open(path, 'wb') as f:
+        assert_raises(ValueError, format.write_array_chunked, f,
+                      np.array([None, dict()], dtype=object))
+
+    # a plain .npy file is not accepted
+    with open(path, 'wb') as f:
+        format.write_array(f, np.arange(3))
+    with open(path, 'rb') as f:
+        assert_raises(ValueError, format.read_array_chunked, f)
+
+    # truncated chunk data is detected
+    with open(path, 'wb') as f:
+        format.write_array_chunked(f, rng.rand(4096))
+    with open(path, 'r+b') as f:
+        f.seek(-7, 2)
+        f.truncate()
+    with open(path, 'rb') as f:
+        assert_raises(ValueError, format.read_array_chunked, f)
+
+
+def test_append_writer():
+    fn = os.path.join(tempdir, 'append.npy')
+    with format.NpyAppendWriter(fn, np.float64, (3,)) as w:
+        assert_equal(w.shape, (0, 3))
+        w.append(np.arange(12.).reshape(4, 3))
+        w.append(np.arange(3.))           # a single row
+        w.flush()
+        # flushed rows are visible while the writer stays open
+        assert_array_equal(np.load(fn),
+                           np.vstack([np.arange(12.).reshape(4, 3),
+                                      np.arange(3.)]))
+        w.append(np.ones((2, 3)))
+    data = np.load(fn)
+    assert_equal(data.shape, (7, 3))
+    assert_array_equal(data[5:], np.ones((2, 3)))
+
+    # resuming appends after the existing rows
+    with format.NpyAppendWriter(fn) as w:
+        assert_equal(w.shape, (7, 3))
+        assert_equal(w.dtype, np.float64)
+        w.append(np.zeros((1, 3)))
+    assert_equal(np.load(fn).shape, (8, 3))
+
+    # complete rows written before a crash are recovered
+    with open(fn, 'ab') as f:
+        f.write(np.ones(3).tobytes())
+    with format.NpyAppendWriter(fn) as w:
+        assert_equal(w.shape, (9, 3))
+    assert_equal(np.load(fn).shape, (9, 3))
+
+    # mismatched dtype or row shape and malformed files are rejected
+    assert_raises(ValueError, format.NpyAppendWriter, fn, np.float32, (3,))
+    assert_raises(ValueError, format.NpyAppendWriter, fn, np.float64, (4,))
+    with format.NpyAppendWriter(fn) as w:
+        assert_raises(ValueError, w.append, np.zeros((2, 4)))
+    with open(fn, 'ab') as f:
+        f.write(b'\x00' * 5)              # a partial row
+    assert_raises(ValueError, format.NpyAppendWriter, fn)
+
+    fn2 = os.path.join(tempdir, 'append_obj.npy')
+    assert_raises(ValueError, format.NpyAppendWriter, fn2, object, ())
+    assert_raises(ValueError, format.NpyAppendWriter, fn2)
+
+
 # aligned
 dt1 = np.dtype('i1, i4, i1', align=True)
 # non-aligned, explicit offsets
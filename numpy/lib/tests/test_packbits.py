@@ -284,6 +284,16 @@ def test_unpackbits_large():
     assert_array_equal(np.packbits(np.unpackbits(d, axis=0), axis=0), d)
 
 
+@pytest.mark.parametrize('bitorder', ('little', 'big'))
+def test_unpackbits_strided_agreement(bitorder):
+    # the contiguous kernel must agree with the strided per-bit loop
+    d = np.arange(277, dtype=np.uint8)
+    contig = np.unpackbits(d, bitorder=bitorder)
+    strided = np.unpackbits(np.tile(d, (2, 1)).T, axis=0,
+                            bitorder=bitorder)[:, 0]
+    assert_array_equal(contig, strided)
+
+
 class TestCount():
     x = np.array([
         [1, 0, 1, 0, 0, 1, 0],
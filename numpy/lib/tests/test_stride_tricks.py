@@ -7,7 +7,8 @@ from numpy.testing import (
     assert_raises_regex
     )
 from numpy.lib.stride_tricks import (
-    as_strided, broadcast_arrays, _broadcast_shape, broadcast_to
+    as_strided, broadcast_arrays, _broadcast_shape, broadcast_to,
+    sliding_window_view
     )
 
 def assert_shapes_correct(input_shapes, expected_shape):
@@ -443,3 +444,65 @@ def test_reference_types():
 
     actual, _ = broadcast_arrays(input_array, np.ones(3))
     assert_array_equal(expected, actual)
+
+
+def test_sliding_window_view_1d():
+    x = np.arange(6)
+    v = sliding_window_view(x, 3)
+    assert_equal(v.shape, (4, 3))
+    assert_array_equal(v, [[0, 1, 2], [1, 2, 3], [2, 3, 4], [3, 4, 5]])
+    # zero copy: a view into x itself
+    assert_(v.base is x)
+    assert_(not v.flags.writeable)
+
+
+def test_sliding_window_view_2d():
+    x = np.arange(12).reshape(3, 4)
+    v = sliding_window_view(x, (2, 2))
+    assert_equal(v.shape, (2, 3, 2, 2))
+    for i in range(2):
+        for j in range(3):
+            assert_array_equal(v[i, j], x[i:i + 2, j:j + 2])
+
+    # single windowed axis, trailing window axis appended
+    v = sliding_window_view(x, 3, axis=1)
+    assert_equal(v.shape, (3, 2, 3))
+    assert_array_equal(v[1, 0], x[1, 0:3])
+
+
+def test_sliding_window_view_repeated_axis():
+    x = np.arange(10)
+    v = sliding_window_view(x, (4, 3), axis=(0, 0))
+    assert_equal(v.shape, (5, 4, 3))
+    assert_array_equal(v[0, 0], [0, 1, 2])
+    assert_array_equal(v[4, 3], [7, 8, 9])
+
+
+def test_sliding_window_view_errors():
+    x = np.arange(5)
+    assert_raises(ValueError, sliding_window_view, x, 6)
+    assert_raises(ValueError, sliding_window_view, x, -1)
+    assert_raises(ValueError, sliding_window_view, x, (2, 2))
+    assert_raises(np.AxisError, sliding_window_view, x, 2, axis=1)
+    assert_raises(ValueError, sliding_window_view, x, (2, 2), axis=0)
+
+
+def test_sliding_window_view_writeable():
+    x = np.arange(6.)
+    v = sliding_window_view(x, 2, writeable=True)
+    assert_(v.flags.writeable)
+    v[0, 0] = 99.
+    assert_equal(x[0], 99.)
+
+    # matches as_strided-built windows
+    s = as_strided(x, shape=(5, 2), strides=(x.strides[0],) * 2,
+                   writeable=False)
+    assert_array_equal(sliding_window_view(x, 2), s)
+
+
+def test_sliding_window_view_subclass():
+    x = SimpleSubClass(np.arange(6.))
+    v = sliding_window_view(x, 3, subok=True)
+    assert_(isinstance(v, SimpleSubClass))
+    assert_equal(v.info, 'simple finalized')
+    assert_(type(sliding_window_view(x, 3)) is np.ndarray)
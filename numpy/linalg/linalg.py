@@ -26,7 +26,7 @@ from numpy.core import (
     add, multiply, sqrt, fastCopyAndTranspose, sum, isfinite,
     finfo, errstate, geterrobj, moveaxis, amin, amax, product, abs,
     atleast_2d, intp, asanyarray, object_, matmul,
-    swapaxes, divide, count_nonzero, isnan, sign
+    swapaxes, divide, count_nonzero, isnan, sign, einsum
 )
 from numpy.core.multiarray import normalize_axis_index
 from numpy.core.overrides import set_module
@@ -2503,7 +2503,20 @@ def norm(x, ord=None, axis=None, keepdims=False):
             # special case for speedup
             return add.reduce(abs(x), axis=axis, keepdims=keepdims)
         elif ord is None or ord == 2:
-            # special case for speedup
+            # special case for speedup: a fused multiply-accumulate over
+            # the reduction axis avoids the abs(x)**2 temporary
+            if x.dtype.type is not object_:
+                ax = normalize_axis_index(axis[0], nd)
+                x_sw = moveaxis(x, ax, -1)
+                if isComplexType(x.dtype.type):
+                    s = (einsum('...i,...i->...', x_sw.real, x_sw.real) +
+                         einsum('...i,...i->...', x_sw.imag, x_sw.imag))
+                else:
+                    s = einsum('...i,...i->...', x_sw, x_sw)
+                ret = sqrt(s)
+                if keepdims:
+                    ret = ret.reshape(ret.shape[:ax] + (1,) + ret.shape[ax:])
+                return ret
             s = (x.conj() * x).real
             return sqrt(add.reduce(s, axis=axis, keepdims=keepdims))
         else:
@@ -46,10 +46,14 @@ def configuration(parent_package='', top_path=None):
     )
 
     # umath_linalg module
+    common_dir = os.path.join('..', 'core', 'src', 'common')
     config.add_extension(
         '_umath_linalg',
-        sources=['umath_linalg.c.src', get_lapack_lite_sources],
-        depends=['lapack_lite/f2c.h'],
+        sources=['umath_linalg.c.src', get_lapack_lite_sources,
+                 os.path.join(common_dir, 'npy_arena.c')],
+        depends=['lapack_lite/f2c.h',
+                 os.path.join(common_dir, 'npy_arena.h')],
+        include_dirs=[common_dir],
         extra_info=lapack_info,
         libraries=['npymath'],
     )
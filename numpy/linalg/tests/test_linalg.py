@@ -501,6 +501,24 @@ class TestSolve(SolveCases):
         assert_raises(ValueError, linalg.solve, a[0:0], b[0:0])
         assert_raises(ValueError, linalg.solve, a[:, 0:0, 0:0], b)
 
+    @pytest.mark.parametrize('dtype', [single, double])
+    @pytest.mark.parametrize('n', [1, 2, 3])
+    def test_stacked_small(self, dtype, n):
+        # Stacks of n <= 3 real matrices take a specialized analytic path
+        # in umath_linalg; check it against the definition and that it
+        # handles non-contiguous inputs and singular matrices.
+        np.random.seed(42)
+        a = np.random.rand(20, n, n).astype(dtype) + 2*identity(n)
+        b = np.random.rand(20, n, 4).astype(dtype)
+        x = linalg.solve(a, b)
+        assert_allclose(dot_generalized(a, x), b,
+                        atol=1000 * np.finfo(dtype).eps)
+        x_t = linalg.solve(a.transpose(0, 2, 1), b)
+        assert_allclose(dot_generalized(a.transpose(0, 2, 1), x_t), b,
+                        atol=1000 * np.finfo(dtype).eps)
+        a[7] = 0
+        assert_raises(linalg.LinAlgError, linalg.solve, a, b)
+
     def test_0_size_k(self):
         # test zero multiple equation (K=0) case.
         class ArraySubclass(np.ndarray):
@@ -535,6 +553,24 @@ class TestInv(InvCases):
         x = np.array([[1, 0.5], [0.5, 1]], dtype=dtype)
         assert_equal(linalg.inv(x).dtype, dtype)
 
+    @pytest.mark.parametrize('dtype', [single, double])
+    @pytest.mark.parametrize('n', [1, 2, 3])
+    def test_stacked_small(self, dtype, n):
+        # Stacks of n <= 3 real matrices take a specialized analytic path
+        # in umath_linalg; check it against the definition and that it
+        # handles non-contiguous inputs and singular matrices.
+        np.random.seed(42)
+        a = np.random.rand(20, n, n).astype(dtype) + 2*identity(n)
+        a_inv = linalg.inv(a)
+        assert_allclose(dot_generalized(a, a_inv),
+                        identity_like_generalized(a),
+                        atol=1000 * np.finfo(dtype).eps)
+        a_inv_t = linalg.inv(a.transpose(0, 2, 1))
+        assert_allclose(a_inv_t, a_inv.transpose(0, 2, 1),
+                        atol=1000 * np.finfo(dtype).eps)
+        a[7] = 0
+        assert_raises(linalg.LinAlgError, linalg.inv, a)
+
     def test_0_size(self):
         # Check that all kinds of 0-sized arrays work
         class ArraySubclass(np.ndarray):
@@ -1727,6 +1763,20 @@ class TestCholesky(object):
                             err_msg="{} {}\n{}\n{}".format(shape, dtype, a, c),
                             atol=500 * a.shape[0] * np.finfo(dtype).eps)
 
+    @pytest.mark.parametrize('dtype', [np.float32, np.float64])
+    @pytest.mark.parametrize('n', [1, 2, 3])
+    def test_stacked_small(self, dtype, n):
+        # Stacks of n <= 3 real matrices take a specialized analytic path
+        # in umath_linalg; check it and its non-positive-definite handling.
+        np.random.seed(42)
+        m = np.random.rand(20, n, n)
+        a = (np.matmul(m, m.transpose(0, 2, 1)) + identity(n)).astype(dtype)
+        c = linalg.cholesky(a)
+        assert_allclose(np.matmul(c, c.transpose(0, 2, 1)), a,
+                        atol=500 * n * np.finfo(dtype).eps)
+        a[7, 0, 0] = -1
+        assert_raises(linalg.LinAlgError, linalg.cholesky, a)
+
     def test_0_size(self):
         class ArraySubclass(np.ndarray):
             pass
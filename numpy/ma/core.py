@@ -5024,7 +5024,18 @@ class MaskedArray(ndarray):
         newmask = _check_mask_axis(_mask, axis, **kwargs)
         # No explicit output
         if out is None:
-            result = self.filled(0).sum(axis, dtype=dtype, **kwargs)
+            if (_mask is not nomask and self._baseclass is ndarray
+                    and self.dtype.kind in 'buifc'):
+                # Sum only the unmasked elements in a single fused pass
+                # through the where= reduction machinery, instead of
+                # materializing a filled copy of the data.  ndarray.sum
+                # forwards to add.reduce, so the dtype handling is the
+                # same on both paths.
+                result = umath.add.reduce(self._data, axis=axis,
+                                          dtype=dtype, where=~_mask,
+                                          **kwargs)
+            else:
+                result = self.filled(0).sum(axis, dtype=dtype, **kwargs)
             rndim = getattr(result, 'ndim', 0)
             if rndim:
                 result = result.view(type(self))
@@ -67,7 +67,7 @@ __all__ = [
 import warnings
 import numpy as np
 import numpy.linalg as la
-from numpy.core.multiarray import normalize_axis_index
+from numpy.core.multiarray import normalize_axis_index, _polyval
 
 from . import polyutils as pu
 from ._polybase import ABCPolyBase
@@ -727,6 +727,12 @@ def polyval(x, c, tensor=True):
         c = c + 0.0
     if isinstance(x, (tuple, list)):
         x = np.asarray(x)
+    # Single C pass for the common real case; the Horner loop below
+    # makes one full array pass per coefficient.  Subclasses and a
+    # 0-sized c keep their current behavior on the general path.
+    if (c.ndim == 1 and c.size > 0 and c.dtype == np.double and
+            type(x) is np.ndarray and x.dtype == np.double):
+        return _polyval(x, c)
     if isinstance(x, np.ndarray) and tensor:
         c = c.reshape(c.shape + (1,)*x.ndim)
 
@@ -160,6 +160,27 @@ class TestEvaluation(object):
         cx = np.array([1, 2, 3]).view(C)
         assert_equal(type(np.polyval([2, 3, 4], cx)), C)
 
+    def test_polyval_compiled_path(self):
+        # the compiled single-pass evaluator must agree with the Horner
+        # iteration used by the general path
+        np.random.seed(123)
+        x = np.random.randn(257)
+        for deg in [0, 1, 2, 3, 4, 5, 7, 8, 20]:
+            c = np.random.randn(deg + 1)
+            res = poly.polyval(x, c)
+            tgt = c[-1] + x*0
+            for i in range(2, len(c) + 1):
+                tgt = c[-i] + tgt*x
+            assert_almost_equal(res, tgt, decimal=12)
+            assert_(res.dtype == np.float64)
+        # strided input and 2-d shapes go through the same kernel
+        x2 = np.random.randn(10, 7)
+        c = np.array([1.0, -2.0, 0.5])
+        assert_almost_equal(poly.polyval(x2, c),
+                            1.0 - 2.0*x2 + 0.5*x2**2)
+        assert_almost_equal(poly.polyval(x[::3], c),
+                            poly.polyval(x[::3].copy(), c))
+
     def test_polyvalfromroots(self):
         # check exception for broadcasting x values over root array with
         # too few dimensions
@@ -9,6 +9,7 @@ Utility functions
 random_sample        Uniformly distributed floats over ``[0, 1)``.
 random               Alias for `random_sample`.
 bytes                Uniformly distributed random bytes.
+fill                 Fill a writable buffer with generator output in place.
 random_integers      Uniformly distributed integers in a given range.
 permutation          Randomly permute a sequence / generate a random sequence.
 shuffle              Randomly permute a sequence in place.
@@ -97,6 +98,7 @@ __all__ = [
     'dirichlet',
     'exponential',
     'f',
+    'fill',
     'gamma',
     'geometric',
     'get_state',
@@ -108,6 +110,7 @@ __all__ = [
     'logseries',
     'multinomial',
     'multivariate_normal',
+    'multivariate_normal_factor',
     'negative_binomial',
     'noncentral_chisquare',
     'noncentral_f',
@@ -18,6 +18,16 @@ cdef extern from "Python.h":
     double PyFloat_AsDouble(object ob) except? -1.0
     long PyInt_AsLong(object ob) except? -1
 
+    # Buffer API
+    ctypedef struct Py_buffer:
+        void *buf
+        Py_ssize_t len
+    int PyObject_GetBuffer(object obj, Py_buffer *view, int flags) except -1
+    void PyBuffer_Release(Py_buffer *view)
+    enum:
+        PyBUF_SIMPLE
+        PyBUF_WRITABLE
+
     # Memory API
     void* PyMem_Malloc(size_t n)
     void* PyMem_Realloc(void* buf, size_t n)
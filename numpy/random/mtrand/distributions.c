@@ -45,6 +45,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 
 #ifndef min
@@ -109,6 +110,9 @@ double rk_normal(rk_state *state, double loc, double scale)
 
 double rk_standard_exponential(rk_state *state)
 {
+    if (state->use_ziggurat) {
+        return rk_ziggurat_exp(state);
+    }
     /* We use -log(1-U) since U is [0, 1) */
     return -log(1.0 - rk_double(state));
 }
@@ -123,6 +127,17 @@ double rk_uniform(rk_state *state, double loc, double scale)
     return loc + scale*rk_double(state);
 }
 
+void rk_fill_uniform(rk_state *state, double loc, double scale, double *out,
+                     npy_intp cnt)
+{
+    npy_intp i;
+
+    rk_fill_double(out, cnt, state);
+    for (i = 0; i < cnt; i++) {
+        out[i] = loc + scale*out[i];
+    }
+}
+
 double rk_standard_gamma(rk_state *state, double shape)
 {
     double b, c;
@@ -261,9 +276,60 @@ double rk_noncentral_f(rk_state *state, double dfnum, double dfden, double nonc)
     return t / (rk_chisquare(state, dfden) * dfnum);
 }
 
+/*
+ * Look up a remembered binomial setup for (n, p, kind) in the state's
+ * cache.  On a hit the entry is moved to the front and returned; the
+ * caller copies it into the working slots of the state.  Returns NULL
+ * on a miss.
+ */
+static rk_binsetup *rk_binsetup_find(rk_state *state, long n, double p,
+                                     int kind)
+{
+    rk_binsetup hit;
+    int i;
+
+    for (i = 0; i < state->binomial_cache_n; i++) {
+        if ((state->binomial_cache[i].nsave == n) &&
+                (state->binomial_cache[i].psave == p) &&
+                (state->binomial_cache[i].kind == kind)) {
+            if (i > 0) {
+                hit = state->binomial_cache[i];
+                memmove(&state->binomial_cache[1], &state->binomial_cache[0],
+                        i * sizeof(rk_binsetup));
+                state->binomial_cache[0] = hit;
+            }
+            return &state->binomial_cache[0];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Make room at the front of the cache for a freshly computed setup,
+ * evicting the least recently used entry when the cache is full.  The
+ * returned entry has its key filled in; the caller stores the setup
+ * values.
+ */
+static rk_binsetup *rk_binsetup_insert(rk_state *state, long n, double p,
+                                       int kind)
+{
+    int used = state->binomial_cache_n;
+
+    if (used == RK_BINOMIAL_CACHE) {
+        used--;
+    }
+    memmove(&state->binomial_cache[1], &state->binomial_cache[0],
+            used * sizeof(rk_binsetup));
+    state->binomial_cache_n = used + 1;
+    state->binomial_cache[0].nsave = n;
+    state->binomial_cache[0].psave = p;
+    state->binomial_cache[0].kind = kind;
+    return &state->binomial_cache[0];
+}
+
 long rk_binomial_btpe(rk_state *state, long n, double p)
 {
-    double r,q,fm,p1,xm,xl,xr,c,laml,lamr,p2,p3,p4;
+    double r,q,p1,xm,xl,xr,c,laml,lamr,p2,p3,p4;
     double a,u,v,s,F,rho,t,A,nrq,x1,x2,f1,f2,z,z2,w,w2,x;
     long m,y,k,i;
 
@@ -271,32 +337,82 @@ long rk_binomial_btpe(rk_state *state, long n, double p)
          (state->nsave != n) ||
          (state->psave != p))
     {
-        /* initialize */
+        rk_binsetup *cached = rk_binsetup_find(state, n, p, 0);
+
         state->nsave = n;
         state->psave = p;
         state->has_binomial = 1;
-        state->r = r = min(p, 1.0-p);
-        state->q = q = 1.0 - r;
-        state->fm = fm = n*r+r;
-        state->m = m = (long)floor(state->fm);
-        state->p1 = p1 = floor(2.195*sqrt(n*r*q)-4.6*q) + 0.5;
-        state->xm = xm = m + 0.5;
-        state->xl = xl = xm - p1;
-        state->xr = xr = xm + p1;
-        state->c = c = 0.134 + 20.5/(15.3 + m);
-        a = (fm - xl)/(fm-xl*r);
-        state->laml = laml = a*(1.0 + a/2.0);
-        a = (xr - fm)/(xr*q);
-        state->lamr = lamr = a*(1.0 + a/2.0);
-        state->p2 = p2 = p1*(1.0 + 2.0*c);
-        state->p3 = p3 = p2 + c/laml;
-        state->p4 = p4 = p3 + c/lamr;
+        if (cached != NULL)
+        {
+            state->r = cached->r;
+            state->q = cached->q;
+            state->fm = cached->fm;
+            state->m = cached->m;
+            state->p1 = cached->p1;
+            state->xm = cached->xm;
+            state->xl = cached->xl;
+            state->xr = cached->xr;
+            state->c = cached->c;
+            state->laml = cached->laml;
+            state->lamr = cached->lamr;
+            state->p2 = cached->p2;
+            state->p3 = cached->p3;
+            state->p4 = cached->p4;
+        }
+        else
+        {
+            /* initialize */
+            state->r = min(p, 1.0-p);
+            state->q = 1.0 - state->r;
+            state->fm = n*state->r+state->r;
+            state->m = (long)floor(state->fm);
+            state->p1 = floor(2.195*sqrt(n*state->r*state->q)-4.6*state->q)
+                        + 0.5;
+            state->xm = state->m + 0.5;
+            state->xl = state->xm - state->p1;
+            state->xr = state->xm + state->p1;
+            state->c = 0.134 + 20.5/(15.3 + state->m);
+            a = (state->fm - state->xl)/(state->fm-state->xl*state->r);
+            state->laml = a*(1.0 + a/2.0);
+            a = (state->xr - state->fm)/(state->xr*state->q);
+            state->lamr = a*(1.0 + a/2.0);
+            state->p2 = state->p1*(1.0 + 2.0*state->c);
+            state->p3 = state->p2 + state->c/state->laml;
+            state->p4 = state->p3 + state->c/state->lamr;
+            cached = rk_binsetup_insert(state, n, p, 0);
+            cached->r = state->r;
+            cached->q = state->q;
+            cached->fm = state->fm;
+            cached->m = state->m;
+            cached->p1 = state->p1;
+            cached->xm = state->xm;
+            cached->xl = state->xl;
+            cached->xr = state->xr;
+            cached->c = state->c;
+            cached->laml = state->laml;
+            cached->lamr = state->lamr;
+            cached->p2 = state->p2;
+            cached->p3 = state->p3;
+            cached->p4 = state->p4;
+        }
+        r = state->r;
+        q = state->q;
+        m = state->m;
+        p1 = state->p1;
+        xm = state->xm;
+        xl = state->xl;
+        xr = state->xr;
+        c = state->c;
+        laml = state->laml;
+        lamr = state->lamr;
+        p2 = state->p2;
+        p3 = state->p3;
+        p4 = state->p4;
     }
     else
     {
         r = state->r;
         q = state->q;
-        fm = state->fm;
         m = state->m;
         p1 = state->p1;
         xm = state->xm;
@@ -402,25 +518,44 @@ long rk_binomial_btpe(rk_state *state, long n, double p)
 
 long rk_binomial_inversion(rk_state *state, long n, double p)
 {
-    double q, qn, np, px, U;
+    double q, qn, px, U;
     long X, bound;
 
     if (!(state->has_binomial) ||
          (state->nsave != n) ||
          (state->psave != p))
     {
+        rk_binsetup *cached = rk_binsetup_find(state, n, p, 1);
+
         state->nsave = n;
         state->psave = p;
         state->has_binomial = 1;
-        state->q = q = 1.0 - p;
-        state->r = qn = exp(n * log(q));
-        state->c = np = n*p;
-        state->m = bound = min(n, np + 10.0*sqrt(np*q + 1));
+        if (cached != NULL)
+        {
+            state->q = cached->q;
+            state->r = cached->r;
+            state->c = cached->c;
+            state->m = cached->m;
+        }
+        else
+        {
+            state->q = 1.0 - p;
+            state->r = exp(n * log(state->q));
+            state->c = n*p;
+            state->m = min(n, state->c + 10.0*sqrt(state->c*state->q + 1));
+            cached = rk_binsetup_insert(state, n, p, 1);
+            cached->q = state->q;
+            cached->r = state->r;
+            cached->c = state->c;
+            cached->m = state->m;
+        }
+        q = state->q;
+        qn = state->r;
+        bound = state->m;
     } else
     {
         q = state->q;
         qn = state->r;
-        np = state->c;
         bound = state->m;
     }
     X = 0;
@@ -473,6 +608,81 @@ long rk_binomial(rk_state *state, long n, double p)
 
 }
 
+void rk_fill_binomial(rk_state *state, long n, double p, long *out,
+                      npy_intp cnt)
+{
+    npy_intp i;
+    double q;
+
+    /*
+     * Same dispatch as rk_binomial, hoisted out of the loop so
+     * constant-parameter fills pick the sampler and its cached setup
+     * once.  The draws are identical to cnt calls of rk_binomial.
+     */
+    if (p <= 0.5)
+    {
+        if (p*n <= 30.0)
+        {
+            for (i = 0; i < cnt; i++)
+            {
+                out[i] = rk_binomial_inversion(state, n, p);
+            }
+        }
+        else
+        {
+            for (i = 0; i < cnt; i++)
+            {
+                out[i] = rk_binomial_btpe(state, n, p);
+            }
+        }
+    }
+    else
+    {
+        q = 1.0-p;
+        if (q*n <= 30.0)
+        {
+            for (i = 0; i < cnt; i++)
+            {
+                out[i] = n - rk_binomial_inversion(state, n, q);
+            }
+        }
+        else
+        {
+            for (i = 0; i < cnt; i++)
+            {
+                out[i] = n - rk_binomial_btpe(state, n, q);
+            }
+        }
+    }
+}
+
+void rk_fill_mvnormal(rk_state *state, npy_intp dim, const double *mean,
+                      const double *factor, double *z, double *out,
+                      npy_intp nsamp)
+{
+    npy_intp s, i, j;
+
+    for (s = 0; s < nsamp; s++)
+    {
+        double *row = out + s*dim;
+
+        rk_fill_gauss(z, dim, state);
+        memcpy(row, mean, dim*sizeof(double));
+        for (i = 0; i < dim; i++)
+        {
+            const double zi = z[i];
+
+            /* factor is upper triangular, so the row tail is all that
+             * contributes; the inner loop is contiguous in both row
+             * and factor. */
+            for (j = i; j < dim; j++)
+            {
+                row[j] += zi * factor[i*dim + j];
+            }
+        }
+    }
+}
+
 long rk_negative_binomial(rk_state *state, double n, double p)
 {
     double Y;
@@ -514,14 +724,23 @@ long rk_poisson_mult(rk_state *state, double lam)
 long rk_poisson_ptrs(rk_state *state, double lam)
 {
     long k;
-    double U, V, slam, loglam, a, b, invalpha, vr, us;
-
-    slam = sqrt(lam);
-    loglam = log(lam);
-    b = 0.931 + 2.53*slam;
-    a = -0.059 + 0.02483*b;
-    invalpha = 1.1239 + 1.1328/(b-3.4);
-    vr = 0.9277 - 3.6224/(b-2);
+    double U, V, loglam, a, b, invalpha, vr, us;
+
+    if (!(state->has_poisson) || (state->lamsave != lam))
+    {
+        state->lamsave = lam;
+        state->has_poisson = 1;
+        state->pois_loglam = log(lam);
+        state->pois_b = 0.931 + 2.53*sqrt(lam);
+        state->pois_a = -0.059 + 0.02483*state->pois_b;
+        state->pois_invalpha = 1.1239 + 1.1328/(state->pois_b-3.4);
+        state->pois_vr = 0.9277 - 3.6224/(state->pois_b-2);
+    }
+    loglam = state->pois_loglam;
+    b = state->pois_b;
+    a = state->pois_a;
+    invalpha = state->pois_invalpha;
+    vr = state->pois_vr;
 
     while (1)
     {
@@ -60,6 +60,11 @@ extern double rk_exponential(rk_state *state, double scale);
 /* Uniform distribution on interval [loc, loc+scale). */
 extern double rk_uniform(rk_state *state, double loc, double scale);
 
+/* Fills an array with cnt deviates uniform on [loc, loc+scale).
+ * Produces the same stream as cnt calls of rk_uniform. */
+extern void rk_fill_uniform(rk_state *state, double loc, double scale,
+                            double *out, npy_intp cnt);
+
 /* Standard gamma distribution with shape parameter.
  * When shape < 1, the algorithm given by (Devroye p. 304) is used.
  * When shape == 1, a Exponential variate is generated.
@@ -101,6 +106,22 @@ extern long rk_binomial_btpe(rk_state *state, long n, double p);
 /* Binomial distribution using inversion and chop-down */
 extern long rk_binomial_inversion(rk_state *state, long n, double p);
 
+/* Fills an array with cnt binomial variates with constant parameters,
+ * choosing the sampler and its cached setup once instead of per draw.
+ * The draws are identical to cnt calls of rk_binomial. */
+extern void rk_fill_binomial(rk_state *state, long n, double p, long *out,
+                             npy_intp cnt);
+
+/* Fills out with nsamp multivariate normal variates of dimension dim,
+ * one sample per row.  factor is a row-major upper triangular (dim, dim)
+ * matrix A with transpose(A)*A == cov, i.e. the transposed Cholesky
+ * factor of the covariance; z is dim doubles of scratch.  Each row is
+ * mean + z*factor with z drawn by rk_fill_gauss, so no standard normal
+ * matrix is materialized. */
+extern void rk_fill_mvnormal(rk_state *state, npy_intp dim,
+                             const double *mean, const double *factor,
+                             double *z, double *out, npy_intp nsamp);
+
 /* Negative binomial distribution computed by generating a Gamma(n, (1-p)/p)
  * variate Y and returning a Poisson(Y) variate (Devroye p. 543). */
 extern long rk_negative_binomial(rk_state *state, double n, double p);
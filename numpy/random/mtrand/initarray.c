@@ -149,4 +149,9 @@ init_by_array(rk_state *self, unsigned long init_key[], npy_intp key_length)
     self->gauss = 0;
     self->has_gauss = 0;
     self->has_binomial = 0;
+    /*
+     * mt[1] and mt[2] are a nonlinear mix of the whole init_key, so
+     * they deterministically seed the optional xoshiro backend too.
+     */
+    rk_xoshiro_seed(self, ((npy_uint64)mt[1] << 32) ^ (npy_uint64)mt[2]);
 }
@@ -67,7 +67,11 @@ cdef extern from "randomkit.h":
     long rk_long(rk_state *state) nogil
     unsigned long rk_ulong(rk_state *state) nogil
     unsigned long rk_interval(unsigned long max, rk_state *state) nogil
+    void rk_shuffle_raw(char *data, npy_intp n, npy_intp itemsize,
+                        npy_intp stride, char *buf, rk_state *state) nogil
     double rk_double(rk_state *state) nogil
+    void rk_fill_double(double *out, npy_intp cnt, rk_state *state) nogil
+    void rk_fill_gauss(double *out, npy_intp cnt, rk_state *state) nogil
     void rk_fill(void *buffer, size_t size, rk_state *state) nogil
     rk_error rk_devfill(void *buffer, size_t size, int strong)
     rk_error rk_altfill(void *buffer, size_t size, int strong,
@@ -92,6 +96,8 @@ cdef extern from "distributions.h":
     double rk_standard_exponential(rk_state *state) nogil
     double rk_exponential(rk_state *state, double scale) nogil
     double rk_uniform(rk_state *state, double loc, double scale) nogil
+    void rk_fill_uniform(rk_state *state, double loc, double scale,
+                         double *out, npy_intp cnt) nogil
     double rk_standard_gamma(rk_state *state, double shape) nogil
     double rk_gamma(rk_state *state, double shape, double scale) nogil
     double rk_beta(rk_state *state, double a, double b) nogil
@@ -116,6 +122,11 @@ cdef extern from "distributions.h":
     long rk_binomial(rk_state *state, long n, double p) nogil
     long rk_binomial_btpe(rk_state *state, long n, double p) nogil
     long rk_binomial_inversion(rk_state *state, long n, double p) nogil
+    void rk_fill_binomial(rk_state *state, long n, double p, long *out,
+                          npy_intp cnt) nogil
+    void rk_fill_mvnormal(rk_state *state, npy_intp dim, double *mean,
+                          double *factor, double *z, double *out,
+                          npy_intp nsamp) nogil
     long rk_negative_binomial(rk_state *state, double n, double p) nogil
     long rk_poisson(rk_state *state, double lam) nogil
     long rk_poisson_mult(rk_state *state, double lam) nogil
@@ -170,8 +181,14 @@ cdef object cont0_array(rk_state *state, rk_cont0 func, object size,
         length = PyArray_SIZE(array)
         array_data = <double *>PyArray_DATA(array)
         with lock, nogil:
-            for i from 0 <= i < length:
-                array_data[i] = func(state)
+            # use the block-fill entry points for the common generators
+            if func == rk_double:
+                rk_fill_double(array_data, length, state)
+            elif func == rk_gauss:
+                rk_fill_gauss(array_data, length, state)
+            else:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state)
         return array
 
 
@@ -245,8 +262,11 @@ cdef object cont2_array_sc(rk_state *state, rk_cont2 func, object size, double a
         length = PyArray_SIZE(array)
         array_data = <double *>PyArray_DATA(array)
         with lock, nogil:
-            for i from 0 <= i < length:
-                array_data[i] = func(state, a, b)
+            if func == rk_uniform:
+                rk_fill_uniform(state, a, b, array_data, length)
+            else:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, a, b)
         return array
 
 
@@ -367,8 +387,11 @@ cdef object discnp_array_sc(rk_state *state, rk_discnp func, object size,
         length = PyArray_SIZE(array)
         array_data = <long *>PyArray_DATA(array)
         with lock, nogil:
-            for i from 0 <= i < length:
-                array_data[i] = func(state, n, p)
+            if func == rk_binomial:
+                rk_fill_binomial(state, n, p, array_data, length)
+            else:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, n, p)
         return array
 
 cdef object discnp_array(rk_state *state, rk_discnp func, object size,
@@ -1029,6 +1052,70 @@ cdef class RandomState:
         return bytestring
 
 
+    def fill(self, object out, dist='bytes'):
+        """
+        fill(out, dist='bytes')
+
+        Fill a writable buffer with generator output, in place.
+
+        Output is written directly into the memory exposed by `out`
+        through the buffer protocol, with no intermediate allocation.
+        This is intended for streaming random payloads into
+        preallocated (e.g. pinned or memory mapped) buffers.
+
+        .. versionadded:: 1.17.0
+
+        Parameters
+        ----------
+        out : buffer-like
+            Writable contiguous object exposing the buffer protocol,
+            such as a `bytearray`, a writable `memoryview` or an
+            ndarray.  The whole buffer is filled.
+        dist : {'bytes', 'uniform', 'normal'}, optional
+            What to write: raw random bytes, double precision floats
+            from the half-open interval [0.0, 1.0), or double precision
+            standard normal deviates.  For 'uniform' and 'normal' the
+            buffer length must be a multiple of ``sizeof(double)``.
+
+        Returns
+        -------
+        None
+
+        Examples
+        --------
+        >>> buf = bytearray(16)
+        >>> np.random.fill(buf)
+
+        """
+        cdef Py_buffer view
+        cdef rk_state *state = self.internal_state
+        cdef void *buf
+        cdef npy_intp n
+
+        if dist not in ('bytes', 'uniform', 'normal'):
+            raise ValueError("dist must be 'bytes', 'uniform' or 'normal'")
+        PyObject_GetBuffer(out, &view, PyBUF_SIMPLE | PyBUF_WRITABLE)
+        try:
+            buf = view.buf
+            n = view.len
+            if dist == 'bytes':
+                with self.lock, nogil:
+                    rk_fill(buf, n, state)
+            else:
+                if n % sizeof(double) != 0:
+                    raise ValueError("buffer length must be a multiple of "
+                                     "%d for dist=%r" % (sizeof(double), dist))
+                n = n // sizeof(double)
+                if dist == 'uniform':
+                    with self.lock, nogil:
+                        rk_fill_double(<double *>buf, n, state)
+                else:
+                    with self.lock, nogil:
+                        rk_fill_gauss(<double *>buf, n, state)
+        finally:
+            PyBuffer_Release(&view)
+
+
     def choice(self, a, size=None, replace=True, p=None):
         """
         choice(a, size=None, replace=True, p=None)
@@ -4591,6 +4678,77 @@ cdef class RandomState:
         x.shape = tuple(final_shape)
         return x
 
+    def multivariate_normal_factor(self, mean, cov):
+        """
+        multivariate_normal_factor(mean, cov)
+
+        Prefactorize a multivariate normal distribution for repeated
+        sampling.
+
+        Returns an object that caches the Cholesky factor of `cov`, so
+        that drawing further samples involves no linear algebra beyond
+        applying the cached triangular factor, and no temporary matrix
+        of standard normals is materialized.
+
+        .. versionadded:: 1.17.0
+
+        Parameters
+        ----------
+        mean : 1-D array_like, of length N
+            Mean of the N-dimensional distribution.
+        cov : 2-D array_like, of shape (N, N)
+            Covariance matrix of the distribution.  It must be symmetric
+            and positive-definite; unlike `multivariate_normal`, merely
+            positive-semidefinite matrices are rejected, as the Cholesky
+            factorization does not exist for them.
+
+        Returns
+        -------
+        out : MultivariateNormalFactor
+            Object with a ``sample(size=None)`` method that draws from
+            this generator.
+
+        See Also
+        --------
+        multivariate_normal
+
+        Notes
+        -----
+        Because the Cholesky factorization differs from the singular
+        value decomposition used by `multivariate_normal`, the two draw
+        different (but identically distributed) samples from the same
+        seed.
+
+        Examples
+        --------
+        >>> factored = np.random.multivariate_normal_factor(
+        ...     [0, 0], [[1, 0], [0, 100]])
+        >>> factored.sample((3, 3)).shape
+        (3, 3, 2)
+
+        """
+        cdef MultivariateNormalFactor dist
+
+        mean = np.array(mean, dtype=np.double)
+        cov = np.array(cov, dtype=np.double)
+        if len(mean.shape) != 1:
+            raise ValueError("mean must be 1 dimensional")
+        if (len(cov.shape) != 2) or (cov.shape[0] != cov.shape[1]):
+            raise ValueError("cov must be 2 dimensional and square")
+        if mean.shape[0] != cov.shape[0]:
+            raise ValueError("mean and cov must have same length")
+        try:
+            factor = np.linalg.cholesky(cov).T
+        except np.linalg.LinAlgError:
+            raise ValueError("covariance is not symmetric "
+                             "positive-definite.")
+        dist = MultivariateNormalFactor.__new__(MultivariateNormalFactor)
+        dist.rstate = self
+        dist.mean = np.ascontiguousarray(mean)
+        dist.factor = np.ascontiguousarray(factor)
+        dist.dim = mean.shape[0]
+        return dist
+
     def multinomial(self, npy_intp n, object pvals, size=None):
         """
         multinomial(n, pvals, size=None)
@@ -4918,13 +5076,11 @@ cdef class RandomState:
 
     cdef inline _shuffle_raw(self, npy_intp n, npy_intp itemsize,
                              npy_intp stride, char* data, char* buf):
-        cdef npy_intp i, j
-        for i in reversed(range(1, n)):
-            j = rk_interval(i, self.internal_state)
-            if i == j : continue # i == j is not needed and memcpy is undefined.
-            string.memcpy(buf, data + j * stride, itemsize)
-            string.memcpy(data + j * stride, data + i * stride, itemsize)
-            string.memcpy(data + i * stride, buf, itemsize)
+        # the swap loop lives in randomkit.c so the bounded draws can be
+        # batched; only raw memory moves happen, so the GIL is not needed
+        cdef rk_state *state = self.internal_state
+        with nogil:
+            rk_shuffle_raw(data, n, itemsize, stride, buf, state)
 
     def permutation(self, object x):
         """
@@ -4983,6 +5139,72 @@ cdef class RandomState:
         return arr[idx]
 
 
+cdef class MultivariateNormalFactor(object):
+    """
+    Prefactorized multivariate normal distribution.
+
+    Created by `RandomState.multivariate_normal_factor`; caches the mean
+    and the transposed Cholesky factor of the covariance so repeated
+    sampling does no linear algebra and allocates nothing beyond the
+    output array.
+    """
+    cdef object rstate
+    cdef object mean
+    cdef object factor
+    cdef npy_intp dim
+
+    def sample(self, size=None):
+        """
+        sample(size=None)
+
+        Draw samples from the prefactorized distribution.
+
+        Parameters
+        ----------
+        size : int or tuple of ints, optional
+            Shape of the batch of samples; as each sample is
+            N-dimensional, the output shape is ``size + (N,)``.  If no
+            shape is specified, a single (`N`-D) sample is returned.
+
+        Returns
+        -------
+        out : ndarray
+            The drawn samples.
+
+        """
+        cdef ndarray marr, farr, zarr, array
+        cdef RandomState rstate = <RandomState>self.rstate
+        cdef rk_state *state = rstate.internal_state
+        cdef double *mean_data
+        cdef double *factor_data
+        cdef double *z_data
+        cdef double *array_data
+        cdef npy_intp nsamp
+        cdef npy_intp dim = self.dim
+
+        if size is None:
+            shape = []
+        elif isinstance(size, (int, long, np.integer)):
+            shape = [size]
+        else:
+            shape = list(size)
+        array = <ndarray>np.empty(shape + [dim], np.float64)
+        if dim == 0:
+            return array
+        nsamp = PyArray_SIZE(array) // dim
+        marr = <ndarray>self.mean
+        farr = <ndarray>self.factor
+        zarr = <ndarray>np.empty(dim, np.float64)
+        mean_data = <double *>PyArray_DATA(marr)
+        factor_data = <double *>PyArray_DATA(farr)
+        z_data = <double *>PyArray_DATA(zarr)
+        array_data = <double *>PyArray_DATA(array)
+        with rstate.lock, nogil:
+            rk_fill_mvnormal(state, dim, mean_data, factor_data, z_data,
+                             array_data, nsamp)
+        return array
+
+
 _rand = RandomState()
 seed = _rand.seed
 get_state = _rand.get_state
@@ -4991,6 +5213,7 @@ random_sample = _rand.random_sample
 choice = _rand.choice
 randint = _rand.randint
 bytes = _rand.bytes
+fill = _rand.fill
 uniform = _rand.uniform
 rand = _rand.rand
 randn = _rand.randn
@@ -5029,6 +5252,7 @@ hypergeometric = _rand.hypergeometric
 logseries = _rand.logseries
 
 multivariate_normal = _rand.multivariate_normal
+multivariate_normal_factor = _rand.multivariate_normal_factor
 multinomial = _rand.multinomial
 dirichlet = _rand.dirichlet
 
@@ -119,11 +119,14 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include <limits.h>
 #include <math.h>
 #include <assert.h>
 
+#include "rk_parallel.h"
+
 #ifndef RK_DEV_URANDOM
 #define RK_DEV_URANDOM "/dev/urandom"
 #endif
@@ -141,6 +144,232 @@ char *rk_strerror[RK_ERR_MAX] =
 /* static functions */
 static unsigned long rk_hash(unsigned long key);
 
+/*
+ * Optional xoshiro256** backend (David Blackman and Sebastiano Vigna,
+ * public domain reference implementation).  A single xoshiro stream is
+ * serially dependent, so RK_XOSHIRO_LANES independent streams are
+ * advanced side by side; the inner lane loop has no cross-lane
+ * dependencies and is vectorized by the compiler.  Lane 0 is seeded
+ * with splitmix64 and every further lane is placed 2^192 steps ahead
+ * of the previous one with the long-jump polynomial, so the lanes
+ * cannot overlap.
+ *
+ * The backend is selected per state at seeding time when
+ * NPY_RANDOM_BACKEND=xoshiro256 is set; the default Mersenne Twister
+ * stream is completely unaffected otherwise.
+ */
+
+static int
+rk_xoshiro_selected(void)
+{
+    char *env = getenv("NPY_RANDOM_BACKEND");
+
+    return env != NULL && strcmp(env, "xoshiro256") == 0;
+}
+
+static npy_uint64
+rk_splitmix64(npy_uint64 *s)
+{
+    npy_uint64 z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* advance lane l by one step, discarding the output */
+static void
+rk_xoshiro_step_lane(rk_state *state, int l)
+{
+    npy_uint64 s0 = state->xs[0][l], s1 = state->xs[1][l],
+               s2 = state->xs[2][l], s3 = state->xs[3][l];
+    npy_uint64 t = s1 << 17;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = (s3 << 45) | (s3 >> 19);
+
+    state->xs[0][l] = s0;
+    state->xs[1][l] = s1;
+    state->xs[2][l] = s2;
+    state->xs[3][l] = s3;
+}
+
+/* move lane l 2^192 steps ahead of its current position */
+static void
+rk_xoshiro_long_jump(rk_state *state, int l)
+{
+    static const npy_uint64 long_jump[4] = {
+        0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+        0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+    };
+    npy_uint64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i, b;
+
+    for (i = 0; i < 4; i++) {
+        for (b = 0; b < 64; b++) {
+            if (long_jump[i] & ((npy_uint64)1 << b)) {
+                s0 ^= state->xs[0][l];
+                s1 ^= state->xs[1][l];
+                s2 ^= state->xs[2][l];
+                s3 ^= state->xs[3][l];
+            }
+            rk_xoshiro_step_lane(state, l);
+        }
+    }
+    state->xs[0][l] = s0;
+    state->xs[1][l] = s1;
+    state->xs[2][l] = s2;
+    state->xs[3][l] = s3;
+}
+
+static int rk_ziggurat_selected(void);
+static void rk_ziggurat_init(void);
+
+void
+rk_xoshiro_seed(rk_state *state, npy_uint64 seed)
+{
+    int l, w;
+
+    state->use_xoshiro = rk_xoshiro_selected();
+    state->xbuf_pos = RK_XOSHIRO_BUF;
+    state->has_x32 = 0;
+    state->no_parallel = 0;
+    /*
+     * This runs on every seeding path, so it is also where the sampler
+     * setup caches of a possibly uninitialized state are emptied.
+     */
+    state->binomial_cache_n = 0;
+    state->has_poisson = 0;
+    state->use_ziggurat = state->use_xoshiro || rk_ziggurat_selected();
+    if (state->use_ziggurat) {
+        rk_ziggurat_init();
+    }
+    if (!state->use_xoshiro) {
+        return;
+    }
+    for (w = 0; w < 4; w++) {
+        state->xs[w][0] = rk_splitmix64(&seed);
+    }
+    for (l = 1; l < RK_XOSHIRO_LANES; l++) {
+        for (w = 0; w < 4; w++) {
+            state->xs[w][l] = state->xs[w][l - 1];
+        }
+        rk_xoshiro_long_jump(state, l);
+    }
+}
+
+void
+rk_xoshiro_jump(rk_state *state, int nstreams)
+{
+    int l, j;
+
+    for (l = 0; l < RK_XOSHIRO_LANES; l++) {
+        for (j = 0; j < nstreams * RK_XOSHIRO_LANES; j++) {
+            rk_xoshiro_long_jump(state, l);
+        }
+    }
+    /* buffered and cached partial outputs belong to the old position */
+    state->xbuf_pos = RK_XOSHIRO_BUF;
+    state->has_x32 = 0;
+    state->has_gauss = 0;
+    state->gauss = 0;
+}
+
+/* refill the output buffer, advancing all lanes in lockstep */
+static void
+rk_xoshiro_refill(rk_state *state)
+{
+    int i, l;
+
+    for (i = 0; i < RK_XOSHIRO_ROUNDS; i++) {
+        /* no cross-lane dependencies: this loop vectorizes */
+        for (l = 0; l < RK_XOSHIRO_LANES; l++) {
+            npy_uint64 s0 = state->xs[0][l], s1 = state->xs[1][l],
+                       s2 = state->xs[2][l], s3 = state->xs[3][l];
+            npy_uint64 t = s1 << 17;
+            npy_uint64 r = s1 * 5;
+
+            /* the ** scrambler */
+            r = ((r << 7) | (r >> 57)) * 9;
+
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = (s3 << 45) | (s3 >> 19);
+
+            state->xs[0][l] = s0;
+            state->xs[1][l] = s1;
+            state->xs[2][l] = s2;
+            state->xs[3][l] = s3;
+            state->xbuf[i * RK_XOSHIRO_LANES + l] = r;
+        }
+    }
+    state->xbuf_pos = 0;
+}
+
+NPY_INLINE static npy_uint64
+rk_xoshiro_next64(rk_state *state)
+{
+    if (state->xbuf_pos == RK_XOSHIRO_BUF) {
+        rk_xoshiro_refill(state);
+    }
+    return state->xbuf[state->xbuf_pos++];
+}
+
+NPY_INLINE static npy_uint32
+rk_xoshiro_next32(rk_state *state)
+{
+    npy_uint64 v;
+
+    if (state->has_x32) {
+        state->has_x32 = 0;
+        return state->x32_carry;
+    }
+    v = rk_xoshiro_next64(state);
+    state->x32_carry = (npy_uint32)(v >> 32);
+    state->has_x32 = 1;
+    return (npy_uint32)v;
+}
+
+/*
+ * Bounded draws for the xoshiro backend use Lemire's multiply-shift
+ * method ("Fast Random Integer Generation in an Interval", ACM TOMACS
+ * 2019): the draw is mapped onto [0, s) by taking the high word of a
+ * widening multiply, and a fresh draw is only needed when the low word
+ * falls below (-s) % s - a less than s / 2^32 (or 2^64) chance - so
+ * the fill loops are effectively rejection-free, with no masking and
+ * at most one division per fill.  t must be precomputed as (-s) % s.
+ */
+NPY_INLINE static npy_uint32
+rk_lemire32(npy_uint32 s, npy_uint32 t, rk_state *state)
+{
+    npy_uint64 m;
+
+    do {
+        m = (npy_uint64)rk_xoshiro_next32(state) * s;
+    } while ((npy_uint32)m < t);
+    return (npy_uint32)(m >> 32);
+}
+
+#ifdef __SIZEOF_INT128__
+#define HAVE_RK_LEMIRE64
+NPY_INLINE static npy_uint64
+rk_lemire64(npy_uint64 s, npy_uint64 t, rk_state *state)
+{
+    __uint128_t m;
+
+    do {
+        m = (__uint128_t)rk_xoshiro_next64(state) * s;
+    } while ((npy_uint64)m < t);
+    return (npy_uint64)(m >> 64);
+}
+#endif
+
 void
 rk_seed(unsigned long seed, rk_state *state)
 {
@@ -156,6 +385,7 @@ rk_seed(unsigned long seed, rk_state *state)
     state->gauss = 0;
     state->has_gauss = 0;
     state->has_binomial = 0;
+    rk_xoshiro_seed(state, (npy_uint64)seed);
 }
 
 /* Thomas Wang 32 bits integer hash function */
@@ -192,6 +422,8 @@ rk_randomseed(rk_state *state)
         for (i = 0; i < 624; i++) {
             state->key[i] &= 0xffffffffUL;
         }
+        rk_xoshiro_seed(state, ((npy_uint64)state->key[0] << 32)
+                               ^ (npy_uint64)state->key[1]);
         return RK_NOERR;
     }
 
@@ -224,6 +456,9 @@ rk_random(rk_state *state)
 {
     unsigned long y;
 
+    if (state->use_xoshiro) {
+        return (unsigned long)rk_xoshiro_next32(state);
+    }
     if (state->pos == RK_STATE_LEN) {
         int i;
 
@@ -258,8 +493,13 @@ rk_random(rk_state *state)
 NPY_INLINE static npy_uint64
 rk_uint64(rk_state *state)
 {
-    npy_uint64 upper = (npy_uint64)rk_random(state) << 32;
-    npy_uint64 lower = (npy_uint64)rk_random(state);
+    npy_uint64 upper, lower;
+
+    if (state->use_xoshiro) {
+        return rk_xoshiro_next64(state);
+    }
+    upper = (npy_uint64)rk_random(state) << 32;
+    lower = (npy_uint64)rk_random(state);
     return upper | lower;
 }
 
@@ -291,6 +531,27 @@ rk_random_uint64(npy_uint64 off, npy_uint64 rng, npy_intp cnt,
         }
         return;
     }
+    if (rk_parallel_random_uint64(off, rng, cnt, out, state)) {
+        return;
+    }
+#ifdef HAVE_RK_LEMIRE64
+    if (state->use_xoshiro) {
+        if (rng == (npy_uint64)-1) {
+            for (i = 0; i < cnt; i++) {
+                out[i] = off + rk_uint64(state);
+            }
+        }
+        else {
+            npy_uint64 s = rng + 1;
+            npy_uint64 t = (npy_uint64)(0 - s) % s;
+
+            for (i = 0; i < cnt; i++) {
+                out[i] = off + rk_lemire64(s, t, state);
+            }
+        }
+        return;
+    }
+#endif
 
     /* Smallest bit mask >= max */
     mask |= mask >> 1;
@@ -329,6 +590,25 @@ rk_random_uint32(npy_uint32 off, npy_uint32 rng, npy_intp cnt,
         }
         return;
     }
+    if (rk_parallel_random_uint32(off, rng, cnt, out, state)) {
+        return;
+    }
+    if (state->use_xoshiro) {
+        if (rng == (npy_uint32)-1) {
+            for (i = 0; i < cnt; i++) {
+                out[i] = off + rk_xoshiro_next32(state);
+            }
+        }
+        else {
+            npy_uint32 s = rng + 1;
+            npy_uint32 t = (npy_uint32)(0 - s) % s;
+
+            for (i = 0; i < cnt; i++) {
+                out[i] = off + rk_lemire32(s, t, state);
+            }
+        }
+        return;
+    }
 
     /* Smallest bit mask >= max */
     mask |= mask >> 1;
@@ -488,6 +768,22 @@ rk_interval(unsigned long max, rk_state *state)
     if (max == 0) {
         return 0;
     }
+    if (state->use_xoshiro) {
+        if (max < 0xffffffffUL) {
+            npy_uint32 s = (npy_uint32)max + 1;
+
+            return rk_lemire32(s, (npy_uint32)(0 - s) % s, state);
+        }
+#ifdef HAVE_RK_LEMIRE64
+        if (max < (unsigned long)-1) {
+            npy_uint64 s = (npy_uint64)max + 1;
+
+            return (unsigned long)rk_lemire64(s, (npy_uint64)(0 - s) % s,
+                                              state);
+        }
+#endif
+        /* max fills the whole word (or no 128 bit multiply): fall through */
+    }
     /* Smallest bit mask >= max */
     mask |= mask >> 1;
     mask |= mask >> 2;
@@ -512,20 +808,131 @@ rk_interval(unsigned long max, rk_state *state)
     return value;
 }
 
+#ifdef HAVE_RK_LEMIRE64
+/*
+ * Nearly divisionless variant of the Lemire draw for loops whose bound
+ * changes every iteration (Fisher-Yates): the (-s) % s threshold is
+ * only computed in the rare case the low word falls below s.
+ */
+NPY_INLINE static npy_uint64
+rk_bounded64(npy_uint64 s, rk_state *state)
+{
+    __uint128_t m = (__uint128_t)rk_xoshiro_next64(state) * s;
+    npy_uint64 l = (npy_uint64)m;
+
+    if (l < s) {
+        npy_uint64 t = (npy_uint64)(0 - s) % s;
+
+        while (l < t) {
+            m = (__uint128_t)rk_xoshiro_next64(state) * s;
+            l = (npy_uint64)m;
+        }
+    }
+    return (npy_uint64)(m >> 64);
+}
+#endif
+
+void
+rk_shuffle_raw(char *data, npy_intp n, npy_intp itemsize, npy_intp stride,
+               char *buf, rk_state *state)
+{
+    npy_intp i, j;
+
+#ifdef HAVE_RK_LEMIRE64
+    if (state->use_xoshiro) {
+        if (itemsize == sizeof(npy_intp) && stride == sizeof(npy_intp)) {
+            /* word-sized elements swap directly, no memcpy */
+            npy_intp *arr = (npy_intp *)data, tmp;
+
+            for (i = n - 1; i > 0; i--) {
+                j = (npy_intp)rk_bounded64((npy_uint64)i + 1, state);
+                tmp = arr[j];
+                arr[j] = arr[i];
+                arr[i] = tmp;
+            }
+            return;
+        }
+        for (i = n - 1; i > 0; i--) {
+            j = (npy_intp)rk_bounded64((npy_uint64)i + 1, state);
+            if (i == j) {
+                /* i == j needs no swap and memcpy would be undefined */
+                continue;
+            }
+            memcpy(buf, data + j * stride, itemsize);
+            memcpy(data + j * stride, data + i * stride, itemsize);
+            memcpy(data + i * stride, buf, itemsize);
+        }
+        return;
+    }
+#endif
+    for (i = n - 1; i > 0; i--) {
+        j = (npy_intp)rk_interval((unsigned long)i, state);
+        if (i == j) {
+            continue;
+        }
+        memcpy(buf, data + j * stride, itemsize);
+        memcpy(data + j * stride, data + i * stride, itemsize);
+        memcpy(data + i * stride, buf, itemsize);
+    }
+}
+
 double
 rk_double(rk_state *state)
 {
+    long a, b;
+
+    if (state->use_xoshiro) {
+        /* one 64 bit draw provides all 53 mantissa bits */
+        return (rk_xoshiro_next64(state) >> 11) * (1.0 / 9007199254740992.0);
+    }
     /* shifts : 67108864 = 0x4000000, 9007199254740992 = 0x20000000000000 */
-    long a = rk_random(state) >> 5, b = rk_random(state) >> 6;
+    a = rk_random(state) >> 5;
+    b = rk_random(state) >> 6;
     return (a * 67108864.0 + b) / 9007199254740992.0;
 }
 
+void
+rk_fill_double(double *out, npy_intp cnt, rk_state *state)
+{
+    npy_intp i;
+
+    if (rk_parallel_fill_double(out, cnt, state)) {
+        return;
+    }
+    if (state->use_xoshiro) {
+        for (i = 0; i < cnt; i++) {
+            out[i] = (rk_xoshiro_next64(state) >> 11)
+                     * (1.0 / 9007199254740992.0);
+        }
+        return;
+    }
+    for (i = 0; i < cnt; i++) {
+        long a = rk_random(state) >> 5, b = rk_random(state) >> 6;
+        out[i] = (a * 67108864.0 + b) / 9007199254740992.0;
+    }
+}
+
 void
 rk_fill(void *buffer, size_t size, rk_state *state)
 {
     unsigned long r;
     unsigned char *buf = buffer;
 
+    if (state->use_xoshiro) {
+        npy_uint64 v;
+
+        for (; size >= 8; size -= 8) {
+            v = rk_xoshiro_next64(state);
+            memcpy(buf, &v, 8);
+            buf += 8;
+        }
+        if (size) {
+            v = rk_xoshiro_next64(state);
+            memcpy(buf, &v, size);
+        }
+        return;
+    }
+
     for (; size >= 4; size -= 4) {
         r = rk_random(state);
         *(buf++) = r & 0xFF;
@@ -597,9 +1004,143 @@ rk_altfill(void *buffer, size_t size, int strong, rk_state *state)
     return err;
 }
 
+/*
+ * Ziggurat samplers for the normal and exponential distributions
+ * (Marsaglia and Tsang, "The Ziggurat Method for Generating Random
+ * Variables", Journal of Statistical Software 2000).  Inside the
+ * rectangles - over 98% of draws - a deviate costs one integer draw,
+ * one compare and one multiply; log and sqrt only appear in the rare
+ * wedge and tail cases.
+ *
+ * The layer tables are computed once at first use.  Concurrent
+ * initialization from two unlocked states is harmless since every
+ * writer stores identical values.
+ */
+#define RK_ZIG_NORM_R 3.442619855899
+#define RK_ZIG_EXP_R 7.697117470131487
+
+static npy_uint32 zig_kn[128], zig_ke[256];
+static double zig_wn[128], zig_fn[128], zig_we[256], zig_fe[256];
+static int zig_initialized = 0;
+
+static int
+rk_ziggurat_selected(void)
+{
+    char *env = getenv("NPY_RANDOM_ZIGGURAT");
+
+    return env != NULL && env[0] != '\0' && strcmp(env, "0") != 0;
+}
+
+static void
+rk_ziggurat_init(void)
+{
+    double dn = RK_ZIG_NORM_R, tn = RK_ZIG_NORM_R, vn = 9.91256303526217e-3;
+    double de = RK_ZIG_EXP_R, te = RK_ZIG_EXP_R, ve = 3.949659822581572e-3;
+    double m1 = 2147483648.0, m2 = 4294967296.0, q;
+    int i;
+
+    if (zig_initialized) {
+        return;
+    }
+
+    /* normal layers */
+    q = vn / exp(-0.5 * dn * dn);
+    zig_kn[0] = (npy_uint32)((dn / q) * m1);
+    zig_kn[1] = 0;
+    zig_wn[0] = q / m1;
+    zig_wn[127] = dn / m1;
+    zig_fn[0] = 1.0;
+    zig_fn[127] = exp(-0.5 * dn * dn);
+    for (i = 126; i >= 1; i--) {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        zig_kn[i + 1] = (npy_uint32)((dn / tn) * m1);
+        tn = dn;
+        zig_fn[i] = exp(-0.5 * dn * dn);
+        zig_wn[i] = dn / m1;
+    }
+
+    /* exponential layers */
+    q = ve / exp(-de);
+    zig_ke[0] = (npy_uint32)((de / q) * m2);
+    zig_ke[1] = 0;
+    zig_we[0] = q / m2;
+    zig_we[255] = de / m2;
+    zig_fe[0] = 1.0;
+    zig_fe[255] = exp(-de);
+    for (i = 254; i >= 1; i--) {
+        de = -log(ve / de + exp(-de));
+        zig_ke[i + 1] = (npy_uint32)((de / te) * m2);
+        te = de;
+        zig_fe[i] = exp(-de);
+        zig_we[i] = de / m2;
+    }
+
+    zig_initialized = 1;
+}
+
+static double
+rk_ziggurat_normal(rk_state *state)
+{
+    for (;;) {
+        npy_int32 hz = (npy_int32)rk_random(state);
+        int iz = hz & 127;
+        npy_uint32 ahz = (npy_uint32)(hz < 0 ? -(npy_int64)hz : hz);
+
+        if (ahz < zig_kn[iz]) {
+            return hz * zig_wn[iz];
+        }
+        if (iz == 0) {
+            /* sample the tail beyond R (Marsaglia 1964) */
+            double x, y;
+
+            do {
+                x = -log(1.0 - rk_double(state)) / RK_ZIG_NORM_R;
+                y = -log(1.0 - rk_double(state));
+            } while (y + y < x * x);
+            return hz > 0 ? RK_ZIG_NORM_R + x : -(RK_ZIG_NORM_R + x);
+        }
+        else {
+            /* wedge between the layer boundary and the density */
+            double x = hz * zig_wn[iz];
+
+            if (zig_fn[iz] + rk_double(state) * (zig_fn[iz - 1] - zig_fn[iz])
+                    < exp(-0.5 * x * x)) {
+                return x;
+            }
+        }
+    }
+}
+
+double
+rk_ziggurat_exp(rk_state *state)
+{
+    for (;;) {
+        npy_uint32 jz = (npy_uint32)rk_random(state);
+        int iz = jz & 255;
+
+        if (jz < zig_ke[iz]) {
+            return jz * zig_we[iz];
+        }
+        if (iz == 0) {
+            return RK_ZIG_EXP_R - log(1.0 - rk_double(state));
+        }
+        else {
+            double x = jz * zig_we[iz];
+
+            if (zig_fe[iz] + rk_double(state) * (zig_fe[iz - 1] - zig_fe[iz])
+                    < exp(-x)) {
+                return x;
+            }
+        }
+    }
+}
+
 double
 rk_gauss(rk_state *state)
 {
+    if (state->use_ziggurat) {
+        return rk_ziggurat_normal(state);
+    }
     if (state->has_gauss) {
         const double tmp = state->gauss;
         state->gauss = 0;
@@ -624,3 +1165,45 @@ rk_gauss(rk_state *state)
         return f*x2;
     }
 }
+
+void
+rk_fill_gauss(double *out, npy_intp cnt, rk_state *state)
+{
+    npy_intp i = 0;
+
+    if (rk_parallel_fill_gauss(out, cnt, state)) {
+        return;
+    }
+    if (state->use_ziggurat) {
+        for (i = 0; i < cnt; i++) {
+            out[i] = rk_ziggurat_normal(state);
+        }
+        return;
+    }
+    if (cnt > 0 && state->has_gauss) {
+        out[i++] = state->gauss;
+        state->gauss = 0;
+        state->has_gauss = 0;
+    }
+    while (i < cnt) {
+        double f, x1, x2, r2;
+
+        do {
+            x1 = 2.0*rk_double(state) - 1.0;
+            x2 = 2.0*rk_double(state) - 1.0;
+            r2 = x1*x1 + x2*x2;
+        }
+        while (r2 >= 1.0 || r2 == 0.0);
+
+        f = sqrt(-2.0*log(r2)/r2);
+        out[i++] = f*x2;
+        if (i < cnt) {
+            out[i++] = f*x1;
+        }
+        else {
+            /* keep for the next call, exactly as rk_gauss would */
+            state->gauss = f*x1;
+            state->has_gauss = 1;
+        }
+    }
+}
@@ -65,6 +65,46 @@
 
 #define RK_STATE_LEN 624
 
+/*
+ * Lane/buffer geometry of the optional xoshiro256** backend (see
+ * NPY_RANDOM_BACKEND in randomkit.c).  Four independent lanes are
+ * advanced together so the refill loop vectorizes.
+ */
+#define RK_XOSHIRO_LANES 4
+#define RK_XOSHIRO_ROUNDS 16
+#define RK_XOSHIRO_BUF (RK_XOSHIRO_LANES * RK_XOSHIRO_ROUNDS)
+
+/* number of binomial sampler setups remembered per state */
+#define RK_BINOMIAL_CACHE 8
+
+/*
+ * One precomputed binomial sampler setup.  The fields mirror the
+ * single-slot cache embedded in rk_state below; kind records which
+ * sampler filled them, since BTPE and the inversion sampler store
+ * different quantities in the shared slots.
+ */
+typedef struct rk_binsetup_
+{
+    double psave;
+    long nsave;
+    int kind; /* 0: BTPE, 1: inversion */
+    double r;
+    double q;
+    double fm;
+    long m;
+    double p1;
+    double xm;
+    double xl;
+    double xr;
+    double c;
+    double laml;
+    double lamr;
+    double p2;
+    double p3;
+    double p4;
+}
+rk_binsetup;
+
 typedef struct rk_state_
 {
     unsigned long key[RK_STATE_LEN];
@@ -96,6 +136,61 @@ typedef struct rk_state_
     double p3;
     double p4;
 
+    /*
+     * Most-recently-used cache of binomial setups behind the single
+     * slot above, consulted before recomputing when (n, p) change.
+     * Only the first binomial_cache_n entries are valid, ordered most
+     * recently used first.  Entries are pure functions of their key,
+     * so they survive reseeding harmlessly; the count is still reset
+     * at seeding time to keep stale slots from outliving the state's
+     * useful life.
+     */
+    rk_binsetup binomial_cache[RK_BINOMIAL_CACHE];
+    int binomial_cache_n;
+
+    /*
+     * Cached setup constants of the transformed rejection Poisson
+     * sampler (rk_poisson_ptrs), recomputed only when lam changes.
+     */
+    int has_poisson;
+    double lamsave;
+    double pois_loglam;
+    double pois_b;
+    double pois_a;
+    double pois_invalpha;
+    double pois_vr;
+
+    /*
+     * Opt-in xoshiro256** backend, enabled per state at seeding time
+     * when NPY_RANDOM_BACKEND=xoshiro256 is set in the environment.
+     * xs holds the four 64 bit state words of RK_XOSHIRO_LANES lanes
+     * in structure-of-arrays order; outputs are produced a block at a
+     * time into xbuf.  Note that this state is not covered by
+     * RandomState.get_state/set_state, so the backend should not be
+     * enabled by code relying on state round-trips.
+     */
+    int use_xoshiro;
+    npy_uint64 xs[4][RK_XOSHIRO_LANES];
+    npy_uint64 xbuf[RK_XOSHIRO_BUF];
+    int xbuf_pos;
+    npy_uint32 x32_carry;
+    int has_x32;
+
+    /*
+     * !=0: rk_gauss and rk_standard_exponential use the ziggurat
+     * samplers instead of the polar method and CDF inversion.  Always
+     * on with the xoshiro backend, opt-in via NPY_RANDOM_ZIGGURAT
+     * otherwise; never enabled by default because it changes the
+     * seeded deviate streams.
+     */
+    int use_ziggurat;
+
+    /*
+     * !=0: this state is a worker substream of a parallel fill and
+     * must never re-enter the parallel engine itself.
+     */
+    int no_parallel;
+
 }
 rk_state;
 
@@ -120,6 +215,23 @@ extern "C" {
  */
 extern void rk_seed(unsigned long seed, rk_state *state);
 
+/*
+ * Initialize the xoshiro256** backend fields of the state from the
+ * given seed, activating the backend when NPY_RANDOM_BACKEND selects
+ * it.  Called by all the seeding entry points; must be called on every
+ * freshly initialized state.
+ */
+extern void rk_xoshiro_seed(rk_state *state, npy_uint64 seed);
+
+/*
+ * Advance every xoshiro lane of the state by nstreams * RK_XOSHIRO_LANES
+ * long jumps, i.e. place the state at the start of substream number
+ * nstreams relative to its current position.  Substreams laid out this
+ * way cannot overlap with each other or with the source state's lanes.
+ * Buffered outputs and the cached gaussian deviate are discarded.
+ */
+extern void rk_xoshiro_jump(rk_state *state, int nstreams);
+
 /*
  * Initialize the RNG state using a random seed.
  * Uses /dev/random or, when unavailable, the clock (see randomkit.c).
@@ -150,6 +262,16 @@ extern unsigned long rk_ulong(rk_state *state);
  */
 extern unsigned long rk_interval(unsigned long max, rk_state *state);
 
+/*
+ * In-place Fisher-Yates shuffle of n elements of itemsize bytes spaced
+ * stride bytes apart; buf must hold at least itemsize bytes of scratch.
+ * Draws one bounded integer per swap from the state; xoshiro-backed
+ * states use batched nearly divisionless bounded draws, MT19937 states
+ * reproduce the rk_interval stream exactly.
+ */
+extern void rk_shuffle_raw(char *data, npy_intp n, npy_intp itemsize,
+                           npy_intp stride, char *buf, rk_state *state);
+
 /*
  * Fills an array with cnt random npy_uint64 between off and off + rng
  * inclusive. The numbers wrap if rng is sufficiently large.
@@ -190,6 +312,20 @@ extern void rk_random_bool(npy_bool off, npy_bool rng, npy_intp cnt,
  */
 extern double rk_double(rk_state *state);
 
+/*
+ * Fills an array with cnt random doubles between 0.0 and 1.0, 1.0
+ * excluded.  Produces the same stream as cnt calls of rk_double, with
+ * the generator dispatch hoisted out of the loop.
+ */
+extern void rk_fill_double(double *out, npy_intp cnt, rk_state *state);
+
+/*
+ * Fills an array with cnt gaussian deviates.  Produces the same stream
+ * as cnt calls of rk_gauss, including the cached second deviate of the
+ * polar method.
+ */
+extern void rk_fill_gauss(double *out, npy_intp cnt, rk_state *state);
+
 /*
  * fill the buffer with size random bytes
  */
@@ -219,6 +355,13 @@ extern rk_error rk_altfill(void *buffer, size_t size, int strong,
  */
 extern double rk_gauss(rk_state *state);
 
+/*
+ * return a standard exponential deviate from the ziggurat sampler.
+ * Only valid on states with use_ziggurat set; rk_standard_exponential
+ * in distributions.c dispatches here.
+ */
+extern double rk_ziggurat_exp(rk_state *state);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,211 @@
+/*
+ * Multi-threaded bulk fills over long-jumped xoshiro substreams.
+ *
+ * Filling a very large array from one rk_state is inherently serial, so
+ * large fills are split into RK_PFILL_STREAMS equal stripes and every
+ * stripe is generated by its own substream, placed 2^192 xoshiro steps
+ * times the stripe number ahead of the source state by rk_xoshiro_jump.
+ * The stripe layout is fixed, so the result only depends on the seed,
+ * never on how many worker threads happened to run; threads merely
+ * divide the stripes among themselves.  Workers are plain pythread
+ * threads joined through locks, the same arrangement as the threaded
+ * ufunc loops in the core.
+ *
+ * Only xoshiro-backed states are eligible: MT19937 has no practical
+ * jump-ahead in this code base.
+ */
+#include <Python.h>
+#include "pythread.h"
+
+#include <stdlib.h>
+
+#include "randomkit.h"
+#include "rk_parallel.h"
+
+/* number of substreams a parallel fill is always split into */
+#define RK_PFILL_STREAMS 16
+/* do not bother threading fills below this many elements */
+#define RK_PFILL_THRESHOLD 0x200000
+/* upper bound for NPY_RANDOM_THREADS */
+#define RK_PFILL_MAX_THREADS 128
+
+static int
+rk_pfill_nthreads(void)
+{
+    static int nthreads = -1;
+
+    if (nthreads < 0) {
+        char *env = getenv("NPY_RANDOM_THREADS");
+        nthreads = 1;
+        if (env != NULL && env[0] != '\0') {
+            long val = strtol(env, NULL, 10);
+            if (val > RK_PFILL_MAX_THREADS) {
+                val = RK_PFILL_MAX_THREADS;
+            }
+            if (val > 1) {
+                nthreads = (int)val;
+            }
+        }
+    }
+    return nthreads;
+}
+
+typedef enum {
+    RK_PFILL_DOUBLE,
+    RK_PFILL_GAUSS,
+    RK_PFILL_UINT32,
+    RK_PFILL_UINT64
+} rk_pfill_kind;
+
+typedef struct {
+    rk_pfill_kind kind;
+    rk_state *subs;
+    void *out;
+    npy_intp cnt;
+    npy_intp stripe_len;
+    npy_uint64 off;
+    npy_uint64 rng;
+    /* stripe range [first, last) handled by this worker */
+    int first;
+    int last;
+    /* released by the worker when its stripes are finished */
+    PyThread_type_lock done;
+} rk_pfill_chunk;
+
+static void
+rk_pfill_run(void *arg)
+{
+    rk_pfill_chunk *chunk = (rk_pfill_chunk *)arg;
+    int s;
+
+    for (s = chunk->first; s < chunk->last; s++) {
+        npy_intp start = s * chunk->stripe_len;
+        npy_intp len = (s == RK_PFILL_STREAMS - 1) ? chunk->cnt - start
+                                                   : chunk->stripe_len;
+        rk_state *sub = &chunk->subs[s];
+
+        switch (chunk->kind) {
+            case RK_PFILL_DOUBLE:
+                rk_fill_double((double *)chunk->out + start, len, sub);
+                break;
+            case RK_PFILL_GAUSS:
+                rk_fill_gauss((double *)chunk->out + start, len, sub);
+                break;
+            case RK_PFILL_UINT32:
+                rk_random_uint32((npy_uint32)chunk->off,
+                                 (npy_uint32)chunk->rng, len,
+                                 (npy_uint32 *)chunk->out + start, sub);
+                break;
+            case RK_PFILL_UINT64:
+                rk_random_uint64(chunk->off, chunk->rng, len,
+                                 (npy_uint64 *)chunk->out + start, sub);
+                break;
+        }
+    }
+    if (chunk->done != NULL) {
+        PyThread_release_lock(chunk->done);
+    }
+}
+
+static int
+rk_pfill(rk_pfill_kind kind, npy_uint64 off, npy_uint64 rng, void *out,
+         npy_intp cnt, rk_state *state)
+{
+    rk_pfill_chunk chunks[RK_PFILL_MAX_THREADS];
+    rk_state *subs;
+    int s, i, nworkers;
+    int nthreads = rk_pfill_nthreads();
+
+    if (nthreads <= 1 || !state->use_xoshiro || state->no_parallel ||
+            cnt < RK_PFILL_THRESHOLD) {
+        return 0;
+    }
+
+    subs = malloc(RK_PFILL_STREAMS * sizeof(rk_state));
+    if (subs == NULL) {
+        return 0;
+    }
+    /* each substream is one stream count further out than the last */
+    for (s = 0; s < RK_PFILL_STREAMS; s++) {
+        subs[s] = (s == 0) ? *state : subs[s - 1];
+        rk_xoshiro_jump(&subs[s], 1);
+        subs[s].no_parallel = 1;
+    }
+    /* skip the source state past every substream */
+    rk_xoshiro_jump(state, RK_PFILL_STREAMS + 1);
+
+    nworkers = (nthreads < RK_PFILL_STREAMS) ? nthreads : RK_PFILL_STREAMS;
+    for (i = 0; i < nworkers; i++) {
+        chunks[i].kind = kind;
+        chunks[i].subs = subs;
+        chunks[i].out = out;
+        chunks[i].cnt = cnt;
+        chunks[i].stripe_len = cnt / RK_PFILL_STREAMS;
+        chunks[i].off = off;
+        chunks[i].rng = rng;
+        chunks[i].first = i * RK_PFILL_STREAMS / nworkers;
+        chunks[i].last = (i + 1) * RK_PFILL_STREAMS / nworkers;
+        chunks[i].done = NULL;
+    }
+
+    /* chunk 0 runs on the calling thread, the rest on workers */
+    for (i = 1; i < nworkers; i++) {
+        chunks[i].done = PyThread_allocate_lock();
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            if (PyThread_start_new_thread(rk_pfill_run, &chunks[i]) == -1) {
+                PyThread_release_lock(chunks[i].done);
+                PyThread_free_lock(chunks[i].done);
+                chunks[i].done = NULL;
+            }
+        }
+        if (chunks[i].done == NULL) {
+            /* could not start a worker, run the stripes inline */
+            rk_pfill_run(&chunks[i]);
+        }
+    }
+
+    rk_pfill_run(&chunks[0]);
+
+    for (i = 1; i < nworkers; i++) {
+        if (chunks[i].done != NULL) {
+            PyThread_acquire_lock(chunks[i].done, 1);
+            PyThread_free_lock(chunks[i].done);
+        }
+    }
+
+    free(subs);
+    return 1;
+}
+
+int
+rk_parallel_fill_double(double *out, npy_intp cnt, rk_state *state)
+{
+    return rk_pfill(RK_PFILL_DOUBLE, 0, 0, out, cnt, state);
+}
+
+int
+rk_parallel_fill_gauss(double *out, npy_intp cnt, rk_state *state)
+{
+    return rk_pfill(RK_PFILL_GAUSS, 0, 0, out, cnt, state);
+}
+
+int
+rk_parallel_random_uint32(npy_uint32 off, npy_uint32 rng, npy_intp cnt,
+                          npy_uint32 *out, rk_state *state)
+{
+    if (rng == 0) {
+        return 0;
+    }
+    return rk_pfill(RK_PFILL_UINT32, off, rng, out, cnt, state);
+}
+
+int
+rk_parallel_random_uint64(npy_uint64 off, npy_uint64 rng, npy_intp cnt,
+                          npy_uint64 *out, rk_state *state)
+{
+    if (rng == 0) {
+        return 0;
+    }
+    return rk_pfill(RK_PFILL_UINT64, off, rng, out, cnt, state);
+}
@@ -0,0 +1,37 @@
+#ifndef _RK_PARALLEL_
+#define _RK_PARALLEL_
+
+#include "randomkit.h"
+
+/*
+ * Opt-in multi-threaded bulk fills for xoshiro-backed states.
+ *
+ * When NPY_RANDOM_THREADS is set to N > 1 and the state uses the
+ * xoshiro backend, large fills are split into a fixed number of
+ * stripes, each generated from its own long-jumped substream on a
+ * worker thread.  The stripe layout does not depend on the thread
+ * count, so the output is a deterministic function of the seed alone.
+ * After a parallel fill the source state is jumped past all the
+ * substreams, so successive fills never reuse a stream.
+ *
+ * Each function returns 1 when it handled the fill and 0 when the
+ * caller must fall back to the serial path (engine disabled, MT19937
+ * state, or output too small).  All of them may be called without the
+ * GIL; the caller must hold the state's lock as usual.
+ */
+
+extern int rk_parallel_fill_double(double *out, npy_intp cnt,
+                                   rk_state *state);
+
+extern int rk_parallel_fill_gauss(double *out, npy_intp cnt,
+                                  rk_state *state);
+
+extern int rk_parallel_random_uint32(npy_uint32 off, npy_uint32 rng,
+                                     npy_intp cnt, npy_uint32 *out,
+                                     rk_state *state);
+
+extern int rk_parallel_random_uint64(npy_uint64 off, npy_uint64 rng,
+                                     npy_intp cnt, npy_uint64 *out,
+                                     rk_state *state);
+
+#endif /* _RK_PARALLEL_ */
@@ -49,6 +49,54 @@ class TestSeed(object):
                                                           [4, 5, 6]])
 
 
+class TestXoshiroBackend(object):
+    # the xoshiro256 backend is selected per state at seeding time from
+    # the environment, so the default stream is untouched while it runs
+    def test_reproducible_and_distinct(self):
+        import os
+        os.environ['NPY_RANDOM_BACKEND'] = 'xoshiro256'
+        try:
+            s1 = np.random.RandomState(12345)
+            s2 = np.random.RandomState(12345)
+            a = s1.random_sample(1000)
+            assert_array_equal(a, s2.random_sample(1000))
+            assert_(np.all(a >= 0) and np.all(a < 1))
+            s3 = np.random.RandomState(54321)
+            assert_(not np.all(a == s3.random_sample(1000)))
+            # array seeding initializes the backend too
+            s4 = np.random.RandomState([1, 2, 3])
+            s5 = np.random.RandomState([1, 2, 3])
+            assert_array_equal(s4.randint(1000, size=20),
+                               s5.randint(1000, size=20))
+        finally:
+            del os.environ['NPY_RANDOM_BACKEND']
+        # states seeded without the variable keep the MT19937 stream
+        s = np.random.RandomState(0)
+        assert_equal(s.randint(1000), 684)
+
+
+class TestZiggurat(object):
+    # NPY_RANDOM_ZIGGURAT switches rk_gauss and
+    # rk_standard_exponential to the ziggurat samplers; it is opt-in
+    # because it changes the seeded deviate streams
+    def test_moments(self):
+        import os
+        os.environ['NPY_RANDOM_ZIGGURAT'] = '1'
+        try:
+            s = np.random.RandomState(1234)
+            x = s.standard_normal(200000)
+            assert_(abs(x.mean()) < 0.02)
+            assert_(abs(x.var() - 1) < 0.02)
+            y = s.standard_exponential(200000)
+            assert_(np.all(y >= 0))
+            assert_(abs(y.mean() - 1) < 0.02)
+            # reproducible for a fixed seed
+            s2 = np.random.RandomState(1234)
+            assert_array_equal(x, s2.standard_normal(200000))
+        finally:
+            del os.environ['NPY_RANDOM_ZIGGURAT']
+
+
 class TestBinomial(object):
     def test_n_zero(self):
         # Tests the corner case of n == 0 for the binomial distribution.
@@ -463,6 +511,31 @@ class TestRandomDist(object):
         desired = b'\x82Ui\x9e\xff\x97+Wf\xa5'
         assert_equal(actual, desired)
 
+    def test_fill(self):
+        # in-place fills draw the same streams as the allocating calls
+        np.random.seed(self.seed)
+        buf = bytearray(10)
+        np.random.fill(buf)
+        np.random.seed(self.seed)
+        assert_equal(bytes(buf), np.random.bytes(10))
+
+        np.random.seed(self.seed)
+        out = np.empty(50)
+        np.random.fill(out, 'uniform')
+        np.random.seed(self.seed)
+        assert_array_equal(out, np.random.random_sample(50))
+
+        np.random.seed(self.seed)
+        np.random.fill(out, 'normal')
+        np.random.seed(self.seed)
+        assert_array_equal(out, np.random.standard_normal(50))
+
+        assert_raises(ValueError, np.random.fill, buf, 'nonsense')
+        # length not a multiple of the item size
+        assert_raises(ValueError, np.random.fill, bytearray(7), 'uniform')
+        # read-only buffers are rejected
+        assert_raises((BufferError, TypeError), np.random.fill, b'01234567')
+
     def test_shuffle(self):
         # Test lists, arrays (of various dtypes), and multidimensional versions
         # of both, c-contiguous or not:
@@ -727,6 +800,36 @@ class TestRandomDist(object):
             w = sup.record(RuntimeWarning)
             assert len(w) == 0
 
+    def test_multivariate_normal_factor(self):
+        # identity covariance: samples are mean plus the standard normal
+        # stream, whatever the factorization
+        np.random.seed(self.seed)
+        mean = (.123456789, 10)
+        cov = [[1, 0], [0, 1]]
+        factored = np.random.multivariate_normal_factor(mean, cov)
+        actual = factored.sample((3, 2))
+        np.random.seed(self.seed)
+        desired = np.random.standard_normal((3, 2, 2)) + mean
+        assert_equal(actual.shape, (3, 2, 2))
+        assert_array_almost_equal(actual, desired, decimal=15)
+
+        assert_equal(factored.sample().shape, (2,))
+
+        # moments of a big batch match a non-trivial covariance
+        cov = [[2.0, 0.5], [0.5, 1.0]]
+        factored = np.random.multivariate_normal_factor(mean, cov)
+        sample = factored.sample(100000)
+        assert_array_almost_equal(sample.mean(axis=0), mean, decimal=1)
+        assert_array_almost_equal(np.cov(sample.T), cov, decimal=1)
+
+        # indefinite, non-square and mismatched inputs are rejected
+        assert_raises(ValueError, np.random.multivariate_normal_factor,
+                      mean, [[1, 2], [2, 1]])
+        assert_raises(ValueError, np.random.multivariate_normal_factor,
+                      mean, [[1, 0], [0, 1], [0, 0]])
+        assert_raises(ValueError, np.random.multivariate_normal_factor,
+                      (0, 0, 0), cov)
+
     def test_negative_binomial(self):
         np.random.seed(self.seed)
         actual = np.random.negative_binomial(n=100, p=.12345, size=(3, 2))
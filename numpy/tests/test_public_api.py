@@ -69,6 +69,29 @@ def test_numpy_namespace():
     assert bad_results == whitelist
 
 
+@pytest.mark.skipif(sys.version_info < (3, 7),
+                    reason="requires module-level __getattr__")
+def test_lazy_submodule_loading():
+    # Rarely used submodules load on first attribute access; check in a
+    # fresh interpreter that they are absent right after `import numpy`
+    # and appear once touched.
+    import subprocess
+    code = (
+        "import sys; import numpy; "
+        "loaded = [m for m in ('numpy.ma', 'numpy.random', 'numpy.fft', "
+        "'numpy.polynomial', 'numpy.ctypeslib', 'numpy.testing') "
+        "if m in sys.modules]; "
+        "assert not loaded, loaded; "
+        "numpy.ma.masked_array; numpy.random.normal; numpy.fft.fft; "
+        "numpy.polynomial.Polynomial; numpy.testing.assert_equal; "
+        "numpy.Tester; "
+        "assert 'numpy.ma' in sys.modules; "
+        "assert 'ma' in dir(numpy)"
+    )
+    p = subprocess.call([sys.executable, '-c', code])
+    assert p == 0
+
+
 def test_numpy_linalg():
     bad_results = check_dir(np.linalg)
     assert bad_results == {}